@@ -0,0 +1,234 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgTstFourier1_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binAlgTst/AlgTstFourier1.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the one dimensional Fourier transforms of sizes
+* 		which are not an integer power of two, including sizes
+* 		with large prime factors and odd sized real transforms.
+* 		The transforms are compared with a direct evaluation of
+* 		the discrete Fourier transform and inverted.
+* \ingroup	binAlgTst
+*/
+#include <stdio.h>
+#include <unistd.h>
+#include <float.h>
+#include <Alc.h>
+#include <Alg.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+int             main(int argc, char **argv)
+{
+  int           idN,
+  		idJ,
+		idK,
+		num,
+		half,
+		option,
+		verbose = 0,
+		ok = 1,
+		usage = 0;
+  double	tol = 1.0e-09;
+  double	*re = NULL,
+  		*im = NULL,
+		*rl = NULL,
+		*dR = NULL,
+		*dI = NULL;
+  AlgError	algErr = ALG_ERR_NONE;
+  static char	optList[] = "hvt:";
+  /* Sizes which are mixed radix, have prime factors greater than the
+   * maximum radix and are odd. */
+  const int	sizes[] = {12, 45, 63, 67, 127, 134, 201, 1021, 2042, 5};
+  const int	nSizes = sizeof(sizes) / sizeof(int);
+
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 't':
+        if((sscanf(optarg, "%lg", &tol) != 1) || (tol <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = usage == 0;
+  for(idN = 0; ok && (idN < nSizes); ++idN)
+  {
+    double	eC = 0.0,
+    		eR = 0.0,
+		eI = 0.0,
+		mx = 0.0;
+
+    num = sizes[idN];
+    half = num / 2;
+    if(((re = (double *)AlcMalloc(sizeof(double) * num)) == NULL) ||
+       ((im = (double *)AlcMalloc(sizeof(double) * num)) == NULL) ||
+       ((rl = (double *)AlcMalloc(sizeof(double) * num)) == NULL) ||
+       ((dR = (double *)AlcMalloc(sizeof(double) * num)) == NULL) ||
+       ((dI = (double *)AlcMalloc(sizeof(double) * num)) == NULL))
+    {
+      algErr = ALG_ERR_MALLOC;
+    }
+    if(algErr == ALG_ERR_NONE)
+    {
+      for(idJ = 0; idJ < num; ++idJ)
+      {
+	re[idJ] = rl[idJ] = sin((1.3 * idJ) + 0.2) + (0.01 * idJ);
+	im[idJ] = 0.5 * cos(0.7 * idJ);
+      }
+      /* Direct evaluation of the transform of the complex data. */
+      for(idK = 0; idK < num; ++idK)
+      {
+	dR[idK] = dI[idK] = 0.0;
+	for(idJ = 0; idJ < num; ++idJ)
+	{
+	  double a;
+
+	  a = (-2.0 * ALG_M_PI * ((idJ * idK) % num)) / num;
+	  dR[idK] += (re[idJ] * cos(a)) - (im[idJ] * sin(a));
+	  dI[idK] += (re[idJ] * sin(a)) + (im[idJ] * cos(a));
+	}
+	mx = ALG_MAX(mx, fabs(dR[idK]));
+	mx = ALG_MAX(mx, fabs(dI[idK]));
+      }
+      algErr = AlgFour1DErr(re, im, num, 1);
+    }
+    if(algErr == ALG_ERR_NONE)
+    {
+      for(idK = 0; idK < num; ++idK)
+      {
+	eC = ALG_MAX(eC, fabs(re[idK] - dR[idK]));
+	eC = ALG_MAX(eC, fabs(im[idK] - dI[idK]));
+      }
+      algErr = AlgFourInv1DErr(re, im, num, 1);
+    }
+    if(algErr == ALG_ERR_NONE)
+    {
+      for(idJ = 0; idJ < num; ++idJ)
+      {
+	eI = ALG_MAX(eI, fabs((re[idJ] / num) - rl[idJ]));
+	eI = ALG_MAX(eI, fabs((im[idJ] / num) - (0.5 * cos(0.7 * idJ))));
+      }
+      algErr = AlgFourReal1DErr(rl, num, 1);
+    }
+    if(algErr == ALG_ERR_NONE)
+    {
+      /* The real transform is that of the real part of the complex data,
+       * which is given by the Hermitian symmetric part of its
+       * transform. */
+      for(idK = 0; idK <= half; ++idK)
+      {
+	int	idM;
+	double	tR,
+		tI;
+
+	idM = (num - idK) % num;
+	tR = 0.5 * (dR[idK] + dR[idM]);
+	tI = 0.5 * (dI[idK] - dI[idM]);
+	eR = ALG_MAX(eR, fabs(rl[idK] - tR));
+	if((idK > 0) && ((idK < half) || (num & 1)))
+	{
+	  eR = ALG_MAX(eR, fabs(rl[half + idK] - tI));
+	}
+      }
+      algErr = AlgFourRealInv1DErr(rl, num, 1);
+    }
+    if(algErr == ALG_ERR_NONE)
+    {
+      for(idJ = 0; idJ < num; ++idJ)
+      {
+	eI = ALG_MAX(eI, fabs((rl[idJ] / num) -
+	                      (sin((1.3 * idJ) + 0.2) + (0.01 * idJ))));
+      }
+      if(verbose)
+      {
+	(void )fprintf(stderr,
+		       "%s: size %d, complex %g, real %g, inverse %g\n",
+		       *argv, num, eC / mx, eR / mx, eI);
+      }
+      if((eC > tol * mx) || (eR > tol * mx) || (eI > tol))
+      {
+	ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Transform of size %d differs from the direct\n"
+		       "evaluation (complex %g, real %g, inverse %g).\n",
+		       *argv, num, eC / mx, eR / mx, eI);
+      }
+    }
+    AlcFree(re);
+    AlcFree(im);
+    AlcFree(rl);
+    AlcFree(dR);
+    AlcFree(dI);
+    re = im = rl = dR = dI = NULL;
+    if(algErr != ALG_ERR_NONE)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to transform size %d (%d).\n",
+		     *argv, num, (int )algErr);
+    }
+  }
+  AlgFourFreePlans();
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-t#]\n"
+    "A test for the one dimensional Fourier transforms of sizes which\n"
+    "are not an integer power of two, including sizes with large prime\n"
+    "factors and odd sized real transforms.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n"
+    "  -t  Tolerance relative to the maximum transformed value\n"
+    "      (default %g).\n",
+    *argv, tol);
+  }
+  return(!ok);
+}
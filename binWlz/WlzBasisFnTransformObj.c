@@ -52,14 +52,20 @@ WlzBasisFnTransformObj - computes and applies Woolz basis function transforms.
 WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
 		       [-m<min mesh dist>] [-M<max mesh dist>]
 		       [-b<basis fn transform>] [-Y<order of polynomial>]
-		       [-D<flags>] [-P<param>]
+		       [-D<flags>] [-P<param>] [-a<tolerance>]
 		       [-e<displacement seed>] [-r<max displacement>]
 		       [-d] [-g] [-h] [-q] [-Q] [-s] [-t] [-y]
 		       [-B] [-C] [-E] [-G] [-L] [-N] [-R] [-S] [-T]
-		       [-U] [<in object>]
+		       [-U] [-W] [<in object>]
 \endverbatim
 \par Options
 <table width="500" border="0">
+  <tr> 
+    <td><b>-a</b></td>
+    <td>Absolute error bound for approximate evaluation of TPS, MQ and
+        IMQ basis functions when computing mesh displacements. If zero
+	(the default) the basis functions are evaluated exactly.</td>
+  </tr>
   <tr> 
     <td><b>-B</b></td>
     <td>Block mesh generation method.</td>
@@ -191,6 +197,12 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
     <td><b>-U</b></td>
     <td>Output a mesh transform instead of a transformed object.</td>
   </tr>
+  <tr> 
+    <td><b>-W</b></td>
+    <td>Use compactly supported (Wendland) basis function if tie points
+        are given, the basis function parameter is the support radius
+	as a fraction of the tie point range.</td>
+  </tr>
   <tr> 
     <td><b>-y</b></td>
     <td>Use polynomianl basis function if tie points are given.</td>
@@ -301,6 +313,7 @@ int             main(int argc, char **argv)
 		ok = 1,
 		usage = 0;
   double	basisFnParam = 0.001,
+		evalTol = 0.0,
   		meshMinDist = 20.0,
   		meshMaxDist = 40.0,
 		maxRandDisp = 0.0;
@@ -326,7 +339,7 @@ int             main(int argc, char **argv)
   struct timeval times[6];
   const int	delOut = 1;
   const char    *errMsg;
-  static char	optList[] = "b:e:m:o:p:r:t:D:M:P:Y:cdghqsyBCEGLNQRSTU",
+  static char	optList[] = "a:b:e:m:o:p:r:t:D:M:P:Y:cdghqsyBCEGLNQRSTUW",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -345,6 +358,12 @@ int             main(int argc, char **argv)
       case 'o':
         outObjFileStr = optarg;
 	break;
+      case 'a':
+	if((1 != sscanf(optarg, "%lg", &evalTol)) || (evalTol < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
       case 'b':
         basisFnTrFileStr = optarg;
         break;
@@ -449,6 +468,9 @@ int             main(int argc, char **argv)
       case 'U':
         outMeshTrFlag = 1;
 	break;
+      case 'W':
+        basisFnType = WLZ_FN_BASIS_2DCS;
+	break;
       case 'Y':
         if(sscanf(optarg, "%d", &basisFnPolyOrder) != 1)
 	{
@@ -701,6 +723,9 @@ int             main(int argc, char **argv)
         case WLZ_FN_BASIS_2DMQ:
           basisFnType = WLZ_FN_BASIS_3DMQ;
 	  break;
+        case WLZ_FN_BASIS_2DCS:
+          basisFnType = WLZ_FN_BASIS_3DCS;
+	  break;
         default:
 	  errNum = WLZ_ERR_DOMAIN_TYPE;
 	  ok = 0;
@@ -815,6 +840,10 @@ int             main(int argc, char **argv)
 				meshGenMth, meshMinDist, meshMaxDist,
 				&errNum);
     }
+    if((errNum == WLZ_ERR_NONE) && basisTr && basisTr->basisFn)
+    {
+      basisTr->basisFn->evalTol = evalTol;
+    }
     gettimeofday(times + 1, NULL);
   }
   if(ok)
@@ -987,15 +1016,18 @@ int             main(int argc, char **argv)
     " [-o<out object>] [-p<tie points file>]\n"
     "                  [-m<min mesh dist>] [-M<max mesh dist>]\n"
     "                  [-b<basis fn transform>] [-Y<order of polynomial>]\n"
-    "                  [-D<flags>] [-P<param>]\n"
+    "                  [-D<flags>] [-P<param>] [-a<tolerance>]\n"
     "                  [-e<displacement seed>] [-r<max displacement>]\n"
     "                  [-d] [-g] [-h] [-q] [-s] [-t] [-y]\n"
     "                  [-B] [-C] [-E] [-G] [-L] [-N] [-Q] [-R] [-S] [-T]\n"
-    "                  [-U] [<in object>]\n"
+    "                  [-U] [-W] [<in object>]\n"
     "Version: ",
     WlzVersion(),
     "\n"
     "Options:\n"
+    "  -a  Absolute error bound for approximate evaluation of TPS, MQ and\n"
+    "      IMQ basis functions, if zero (default) they are evaluated\n"
+    "      exactly.\n"
     "  -b  Basis function transform object.\n"
     "  -B  Block mesh generation method.\n"
     "  -C  Use conforming mesh.\n"
@@ -1040,6 +1072,9 @@ int             main(int argc, char **argv)
     "  -T  Output a basis function transform instead of a transformed\n"
     "      object.\n"
     "  -U  Output a mesh transform instead of a transformed object.\n"
+    "  -W  Use compactly supported (Wendland) basis function if tie points\n"
+    "      are given, the basis function parameter is the support radius\n"
+    "      as a fraction of the tie point range.\n"
     "  -y  Use polynomial basis function if tie points are given.\n"
     "  -Y  Polynomial order for polynomial basis function (default 3).\n"
     "Computes and applies Woolz basis function transforms.\n"
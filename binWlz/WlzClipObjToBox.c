@@ -114,6 +114,7 @@ WlzClipObjToBox -x0, -y0, -o outfile.wlz infile.wlz
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <ctype.h>
 #include <string.h>
 #include <Wlz.h>
@@ -135,8 +136,7 @@ int             main(int argc, char **argv)
 		clipSet;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   FILE		*fP = NULL;
-  WlzObject	*inObj = NULL,
-		*outObj = NULL;
+  WlzObject	*outObj = NULL;
   char 		*outObjFileStr,
   		*inObjFileStr;
   int		clipVal[2];
@@ -270,16 +270,44 @@ int             main(int argc, char **argv)
   }
   if(ok)
   {
+    /* Unset clip box bounds are those of the object, which are found by
+     * clipping with extreme values. */
+    if(clipSet.xMin == 0)
+    {
+      clipBox.xMin = INT_MIN;
+    }
+    if(clipSet.xMax == 0)
+    {
+      clipBox.xMax = INT_MAX;
+    }
+    if(clipSet.yMin == 0)
+    {
+      clipBox.yMin = INT_MIN;
+    }
+    if(clipSet.yMax == 0)
+    {
+      clipBox.yMax = INT_MAX;
+    }
+    if(clipSet.zMin == 0)
+    {
+      clipBox.zMin = INT_MIN;
+    }
+    if(clipSet.zMax == 0)
+    {
+      clipBox.zMax = INT_MAX;
+    }
+    /* The object is clipped as it is read, which avoids reading all of
+     * the values when they have been written in chunks. */
     if((inObjFileStr == NULL) ||
        (*inObjFileStr == '\0') ||
        ((fP = (strcmp(inObjFileStr, "-")?
 	      fopen(inObjFileStr, "r"): stdin)) == NULL) ||
-       ((inObj= WlzReadObj(fP, &errNum)) == NULL) ||
+       ((outObj = WlzReadObjRegion(fP, clipBox, &errNum)) == NULL) ||
        (errNum != WLZ_ERR_NONE))
     {
       ok = 0;
       (void )fprintf(stderr,
-		     "%s: failed to read object from file %s\n",
+		     "%s: failed to read and clip object from file %s\n",
 		     *argv, inObjFileStr);
     }
     if(fP && strcmp(inObjFileStr, "-"))
@@ -288,82 +316,6 @@ int             main(int argc, char **argv)
     }
   }
   if(ok)
-  {
-    switch(inObj->type)
-    {
-      case WLZ_2D_DOMAINOBJ:
-	if(clipSet.xMin == 0)
-	{
-          clipBox.xMin = inObj->domain.i->kol1;
-	}
-	if(clipSet.xMax == 0)
-	{
-          clipBox.xMax = inObj->domain.i->lastkl;
-	}
-	if(clipSet.yMin == 0)
-	{
-          clipBox.yMin = inObj->domain.i->line1;
-	}
-	if(clipSet.yMax == 0)
-	{
-          clipBox.yMax = inObj->domain.i->lastln;
-	}
-        break;
-      case WLZ_3D_DOMAINOBJ:
-	if(clipSet.xMin == 0)
-	{
-          clipBox.xMin = inObj->domain.p->kol1;
-	}
-	if(clipSet.xMax == 0)
-	{
-          clipBox.xMax = inObj->domain.p->lastkl;
-	}
-	if(clipSet.yMin == 0)
-	{
-          clipBox.yMin = inObj->domain.p->line1;
-	}
-	if(clipSet.yMax == 0)
-	{
-          clipBox.yMax = inObj->domain.p->lastln;
-	}
-	if(clipSet.zMin == 0)
-	{
-          clipBox.zMin = inObj->domain.p->plane1;
-	}
-	if(clipSet.zMax == 0)
-	{
-          clipBox.zMax = inObj->domain.p->lastpl;
-	}
-        break;
-      default:
-        ok = 0;
-	(void )fprintf(stderr,
-		       "%s: invalid object type %d\n", 
-		       *argv, inObj->type);
-    }
-  }
-  if(ok)
-  {
-    if(inObj->domain.core == NULL)
-    {
-      ok = 0;
-      (void )fprintf(stderr,
-      		     "%s: invalid object, null domain\n",
-		     *argv);
-    }
-  }
-  if(ok)
-  {
-    if(((outObj = WlzClipObjToBox3D(inObj, clipBox, &errNum)) == NULL) ||
-       (errNum != WLZ_ERR_NONE))
-    {
-      ok = 0;
-      (void )fprintf(stderr,
-      		     "%s: failed to clip object\n",
-		     *argv);
-    }
-  }
-  if(ok)
   {
     if(((fP = (strcmp(outObjFileStr, "-")?
               fopen(outObjFileStr, "w"):
@@ -380,10 +332,6 @@ int             main(int argc, char **argv)
       fclose(fP);
     }
   }
-  if(inObj)
-  {
-    WlzFreeObj(inObj);
-  }
   if(outObj)
   {
     WlzFreeObj(outObj);
@@ -57,7 +57,8 @@ WlzCopyObj - reads an object and writes it out again which can be useful for
              moving to a new file format.
 \par Synopsis
 \verbatim
-WlzCopyObj [-h] [-o<output file>] [<input file> [... <input file>]]
+WlzCopyObj [-h] [-c<codec>] [-l<lines>] [-o<output file>]
+           [<input file> [... <input file>]]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -65,6 +66,16 @@ WlzCopyObj [-h] [-o<output file>] [<input file> [... <input file>]]
     <td><b>-h</b></td>
     <td>Help, prints usage message.</td>
   </tr>
+  <tr> 
+    <td><b>-c</b></td>
+    <td>Write the values of 3D domain objects as a chunked voxel value
+        table, with the chunks compressed using the given codec which
+	must be one of: none, zlib or bzip2.</td>
+  </tr>
+  <tr> 
+    <td><b>-l</b></td>
+    <td>Number of lines in each chunk of a chunked voxel value table.</td>
+  </tr>
   <tr> 
     <td><b>-o</b></td>
     <td>Output object file.</td>
@@ -73,6 +84,9 @@ WlzCopyObj [-h] [-o<output file>] [<input file> [... <input file>]]
 \par Description
 Reads objects and writes them out again which can be useful for
 moving to a new file format.
+If a codec is given then the values of 3D domain objects are written as
+independently compressed chunks which can be decompressed in parallel and
+allow a region of the object to be read without reading all of it.
 \par Examples
 \verbatim
 WlzCopyObj -o new.wlz old.wlz
@@ -82,6 +96,11 @@ WlzCopyObj <old.wlz >old.wlz
 \endverbatim
 Both these examples copy the object(s) from the file old.wlz to the file
 out.wlz.
+\verbatim
+WlzCopyObj -c zlib -o new.wlz old.wlz
+\endverbatim
+Copies the object(s) from the file old.wlz to the file new.wlz with the
+values of any 3D domain objects written as zlib compressed chunks.
 \par File
 \ref WlzCopyObj.c "WlzCopyObj.c"
 \par See Also
@@ -99,11 +118,16 @@ extern char     *optarg;
 
 static WlzErrorNum 		WlzCopyObj(
 				  FILE *outFP,
-				  const char *inFile);
+				  const char *inFile,
+				  int chunked,
+				  WlzChunkCodec codec,
+				  int bandLn);
 
 int		main(int argc, char *argv[])
 {
   int		idx,
+  		bandLn = 0,
+		chunked = 0,
   		ok = 1,
   		option,
   		usage = 0;
@@ -111,8 +135,9 @@ int		main(int argc, char *argv[])
   char		*inFileStr,
   		*outFileStr;
   const char	*errMsgStr;
+  WlzChunkCodec	codec = WLZ_CHUNK_CODEC_NONE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  static char   optList[] = "ho:";
+  static char   optList[] = "hc:l:o:";
   const char    inFileStrDef[] = "-",
   	        outFileStrDef[] = "-";
 
@@ -123,6 +148,23 @@ int		main(int argc, char *argv[])
   {
     switch(option)
     {
+      case 'c':
+	chunked = 1;
+	if(WlzStringMatchValue((int *)&codec, optarg,
+			       "none",  WLZ_CHUNK_CODEC_NONE,
+			       "zlib",  WLZ_CHUNK_CODEC_ZLIB,
+			       "bzip2", WLZ_CHUNK_CODEC_BZIP2,
+			       NULL) == 0)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'l':
+	if((sscanf(optarg, "%d", &bandLn) != 1) || (bandLn < 1))
+	{
+	  usage = 1;
+	}
+	break;
       case 'o':
         outFileStr = optarg;
 	break;
@@ -149,11 +191,11 @@ int		main(int argc, char *argv[])
     for(idx = 0; (errNum == WLZ_ERR_NONE) && (optind + idx < argc); ++idx)
     {
       inFileStr = *(argv + optind + idx);
-      errNum = WlzCopyObj(fP, inFileStr);
+      errNum = WlzCopyObj(fP, inFileStr, chunked, codec, bandLn);
     }
     if((errNum == WLZ_ERR_NONE) && (idx == 0))
     {
-      errNum = WlzCopyObj(fP, inFileStr);
+      errNum = WlzCopyObj(fP, inFileStr, chunked, codec, bandLn);
     }
     if(errNum != WLZ_ERR_NONE)
     {
@@ -171,19 +213,26 @@ int		main(int argc, char *argv[])
   if(usage)
   {
     fprintf(stderr,
-            "Usage: %s [-h] [-o<out file>] [<in file> [... <in file>]]\n"
+            "Usage: %s [-h] [-c<codec>] [-l<lines>] [-o<out file>]\n"
+	    "                  [<in file> [... <in file>]]\n"
             "Reads objects and writes them out again which can be useful for\n"
             "moving to a new file format.\n"
 	    "Version: %s\n"
 	    "Options:\n"
 	    "  -h  Help, prints this usage message.\n"
+	    "  -c  Write the values of 3D domain objects as chunks compressed\n"
+	    "      using the given codec: none, zlib or bzip2.\n"
+	    "  -l  Number of lines in each chunk.\n"
 	    "  -o  Output file.\n"
             "Examples:\n"
 	    "  %s -o new.wlz old.wlz\n"
 	    "  %s <old.wlz >new.wlz\n"
             "Both these examples copy the object(s) from the file old.wlz to\n"
-	    "the file out.wlz.\n",
-	    argv[0], WlzVersion(), argv[0], argv[0]);
+	    "the file out.wlz.\n"
+	    "  %s -c zlib -o new.wlz old.wlz\n"
+	    "Copies the object(s) with the values of 3D domain objects written\n"
+	    "as zlib compressed chunks.\n",
+	    argv[0], WlzVersion(), argv[0], argv[0], argv[0]);
 
   }
   return(!ok);
@@ -197,8 +246,14 @@ int		main(int argc, char *argv[])
 * \param	outFP			Output file pointer.
 * \param	inFile			Input file string, which may use "-"
 * 					to specify the standard input.
+* \param	chunked			Write the values of 3D domain objects
+* 					as chunks if non-zero.
+* \param	codec			Compression codec for chunks.
+* \param	bandLn			Number of lines in each chunk, default
+* 					used if less than one.
 */
-static WlzErrorNum WlzCopyObj(FILE *outFP, const char *inFile)
+static WlzErrorNum WlzCopyObj(FILE *outFP, const char *inFile,
+			      int chunked, WlzChunkCodec codec, int bandLn)
 {
   WlzObject	*obj = NULL;
   FILE		*inFP = NULL;
@@ -216,7 +271,8 @@ static WlzErrorNum WlzCopyObj(FILE *outFP, const char *inFile)
     }
     while((errNum == WLZ_ERR_NONE) && (obj != NULL))
     {
-      errNum = WlzWriteObj(outFP, obj);
+      errNum = (chunked)? WlzWriteObjChunked(outFP, obj, codec, bandLn):
+                          WlzWriteObj(outFP, obj);
       (void )WlzFreeObj(obj); obj = NULL;
       if(errNum == WLZ_ERR_NONE)
       {
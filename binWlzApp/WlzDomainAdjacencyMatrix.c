@@ -203,7 +203,11 @@ int main(
   WlzObjectType	objType;
   int		dim=0;
   WlzObject	**structElements, **refDomains;
-  int		i, j, radius;
+  int		i, j, k, radius;
+  int		numRefDomains;
+  int		*adjVals = NULL, *isctOff = NULL, *isctHit = NULL;
+  WlzLong	*isctVol = NULL;
+  WlzDomainIndex	*idx;
   int		rMin=-10, rMax=100, rStep=1;
   int       	adjVal;
   double	normalisedAdjVal = 0.0;
@@ -415,6 +419,29 @@ int main(
   if( tickFlg ){
     fprintf(stderr, "done\n");
   }
+  numRefDomains = i;
+
+  /* index the domains and find the intersection volumes of every
+     reference domain with all the domains it overlaps, without computing
+     any intersections. If the domains can't be indexed then the
+     intersections are computed pair by pair. */
+  if( (idx = WlzMakeDomainIndex(numDomains, domains, NULL)) ){
+    if( WlzDomainIndexQueryAll(idx, numRefDomains, refDomains, 0.0,
+			       &isctOff, &isctHit, &isctVol) == WLZ_ERR_NONE ){
+      if( (adjVals = (int *) calloc((size_t )numDomains * numRefDomains,
+				    sizeof(int))) ){
+	for( i=0; i < numRefDomains; i++){
+	  for( k=isctOff[i]; k < isctOff[i+1]; k++){
+	    adjVals[(size_t )isctHit[k] * numRefDomains + i] = isctVol[k];
+	  }
+	}
+      }
+      AlcFree(isctOff);
+      AlcFree(isctHit);
+      AlcFree(isctVol);
+    }
+    WlzFreeDomainIndex(idx);
+  }
 
   /* now calculate intersection volume */
   for( j=0; j < numDomains; j++){
@@ -424,7 +451,10 @@ int main(
     for( radius=rMin, i=0; radius <= rMax; radius += rStep, i++){
       adjVal = 0;
       if( refDomains[i] != NULL ){
-	if( (obj1 = WlzIntersect2(refDomains[i], domains[j], &errNum)) ){
+	if( adjVals ){
+	  adjVal = adjVals[(size_t )j * numRefDomains + i];
+	}
+	else if( (obj1 = WlzIntersect2(refDomains[i], domains[j], &errNum)) ){
 	  adjVal = WlzSize(obj1, &errNum);
 	  errNum = WlzFreeObj(obj1);
 	}
@@ -466,6 +496,9 @@ int main(
       fprintf(stderr, "%s: completed row %d\n\n", argv[0], i+1);
     }
   }
+  if( adjVals ){
+    free(adjVals);
+  }
 
   return 0;
 }
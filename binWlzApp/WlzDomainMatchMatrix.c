@@ -259,6 +259,35 @@ static int WlzSize(
   return size;
 }
 
+static double WlzIntersectSize(
+  WlzObject	*obj1,
+  WlzObject	*obj2,
+  double	*isct,
+  double	noIsct,
+  WlzErrorNum	*dstErr)
+{
+  double	size;
+  WlzObject	*obj;
+  WlzErrorNum	errNum=WLZ_ERR_NONE;
+
+  /* use the size found from the domain index if there is one */
+  if( isct ){
+    size = *isct;
+  }
+  else if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
+    size = WlzSize(obj, &errNum);
+    WlzFreeObj(obj);
+  }
+  else {
+    size = noIsct;
+  }
+
+  if( dstErr ){
+    *dstErr = errNum;
+  }
+  return size;
+}
+
 double WlzMixtureValue(
   WlzObject	*obj1,
   WlzObject	*obj2,
@@ -394,6 +423,11 @@ int main(
   int		numRows=0, numCols=0;
   WlzObject	*obj = NULL, *obj1 = NULL, *obj2 = NULL, *obj3 = NULL;
   WlzObject	**rowDoms = NULL, **colDoms = NULL;
+  WlzDomainIndex	*idx = NULL;
+  int		numColDoms;
+  int		*isctOff = NULL, *isctHit = NULL;
+  WlzLong	*isctVol = NULL;
+  double	*isct = NULL, *isct2 = NULL, *isct3 = NULL;
   WlzObjectType	objType = WLZ_NULL;
   double	matchVal=0.0;
   double	s1, s2, s3, s4;
@@ -566,31 +600,61 @@ int main(
     }
   }
 
+  /* index the column domains and find the intersection sizes of every
+     row with all the column domains it overlaps, without computing any
+     intersections. If the domains can't be indexed then the
+     intersections are computed pair by pair. */
+  numColDoms = (type == 5)? numCols * 2: numCols;
+  if((type != 6) && (type != 7)){
+    if((idx = WlzMakeDomainIndex(numColDoms, colDoms, NULL)) != NULL){
+      if(((isct = (double *) AlcMalloc(sizeof(double) * numColDoms))
+	  == NULL) ||
+	 (WlzDomainIndexQueryAll(idx, numRows, rowDoms, 0.0, &isctOff,
+				 &isctHit, &isctVol) != WLZ_ERR_NONE)){
+	WlzFreeDomainIndex(idx);
+	idx = NULL;
+      }
+    }
+  }
+
   /* now calculate the match values */
   for(i=0; i < numRows; i ++){
     if( verboseFlg ){
       fprintf(stderr, "%s: start row %d\n", argv[0], i+1);
     }
     obj1 = rowDoms[i];
+    if( idx ){
+      for(j=0; j < numColDoms; j++){
+	isct[j] = 0.0;
+      }
+      for(k=isctOff[i]; k < isctOff[i+1]; k++){
+	isct[isctHit[k]] = isctVol[k];
+      }
+    }
     for(j=0; j < numCols; j++){
+      isct2 = isct3 = NULL;
       if( type == 5 ){
 	obj2 = colDoms[j*2];
 	obj3 = colDoms[j*2 + 1];
+	if( idx && obj1 ){
+	  isct2 = (obj2)? isct + j*2: NULL;
+	  isct3 = (obj3)? isct + j*2 + 1: NULL;
+	}
       }
       else {
 	obj2 = colDoms[j];
+	if( idx && obj1 && obj2 ){
+	  isct2 = isct + j;
+	}
       }
       
       switch( type ){
       case 1:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = 0;
+	s1 = WlzIntersectSize(obj1, obj2, isct2, 0, &errNum);
+	if( isct2 ){
+	  s2 = WlzSize(obj1, &errNum) + WlzSize(obj2, &errNum) - s1;
 	}
-	if((obj = WlzUnion2(obj1, obj2, &errNum)) != NULL){
+	else if((obj = WlzUnion2(obj1, obj2, &errNum)) != NULL){
 	  s2 = WlzSize(obj, &errNum);
 	  WlzFreeObj(obj);
 	}
@@ -601,14 +665,11 @@ int main(
 	break;
 
       case 2:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = 0;
+	s1 = WlzIntersectSize(obj1, obj2, isct2, 0, &errNum);
+	if( isct2 ){
+	  s2 = WlzSize(obj1, &errNum) + WlzSize(obj2, &errNum) - s1;
 	}
-	if((obj = WlzUnion2(obj1, obj2, &errNum)) != NULL){
+	else if((obj = WlzUnion2(obj1, obj2, &errNum)) != NULL){
 	  s2 = WlzSize(obj, &errNum);
 	  WlzFreeObj(obj);
 	}
@@ -632,13 +693,7 @@ int main(
 	break;
 
       case 3:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = 0;
-	}
+	s1 = WlzIntersectSize(obj1, obj2, isct2, 0, &errNum);
 	s2 = WlzSize(obj1, &errNum);
 	matchVal = 0.0;
 	if( s2 > 0 ){
@@ -647,13 +702,7 @@ int main(
 	break;
 
       case 4:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = 0;
-	}
+	s1 = WlzIntersectSize(obj1, obj2, isct2, 0, &errNum);
 	s2 = WlzSize(obj2, &errNum);
 	matchVal = 0.0;
 	if( s2 > 0 ){
@@ -674,21 +723,9 @@ int main(
 	  return 1;
 	}
 	s1 = WlzSize(obj2, &errNum);
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s2 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s2 = 0.0;
-	}
+	s2 = WlzIntersectSize(obj1, obj2, isct2, 0.0, &errNum);
 	s3 = WlzSize(obj3, &errNum);
-	if((obj = WlzIntersect2(obj1, obj3, &errNum)) != NULL){
-	  s4 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s4 = 0.0;
-	}
+	s4 = WlzIntersectSize(obj1, obj3, isct3, 0.0, &errNum);
 	if((s1 < 0.0) || (s2 < 0.0) || (s3 < 0.0) || (s4 < 0.0)){
 	  /* just fail */
 	  fprintf(stderr, "%s: something gone wrong, negative size.\n",
@@ -739,24 +776,12 @@ int main(
 	break;
 
       case 8:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = -1;
-	}
+	s1 = WlzIntersectSize(obj1, obj2, isct2, -1, &errNum);
 	matchVal = s1;
 	break;
 
       case 9:
-	if((obj = WlzIntersect2(obj1, obj2, &errNum)) != NULL){
-	  s1 = WlzSize(obj, &errNum);
-	  WlzFreeObj(obj);
-	}
-	else {
-	  s1 = 0;
-	}
+	s1 = WlzIntersectSize(obj1, obj2, isct2, 0, &errNum);
 	s2 = WlzSize(obj1, &errNum);
 	s3 = WlzSize(obj2, &errNum);
 	matchVal = 0.0;
@@ -788,6 +813,13 @@ int main(
       fprintf(stderr, "\n%s: completed row %d\n", argv[0], i+1);
     }
   }
+  if( idx ){
+    WlzFreeDomainIndex(idx);
+    AlcFree(isctOff);
+    AlcFree(isctHit);
+    AlcFree(isctVol);
+  }
+  AlcFree(isct);
 
   return 0;
 }
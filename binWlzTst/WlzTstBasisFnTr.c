@@ -0,0 +1,203 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnTr_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnTr.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the solution of basis function transforms with
+* 		more control points than the iterative solver threshold.
+* 		Builds a transform from random control points and checks
+* 		that it was solved and that it interpolates the control
+* 		points to within a given residual.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idN,
+		option,
+		nPts = 1000,
+		seed = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  double	maxRes = 1.0e-03,
+		res = 0.0;
+  const char	*errMsgStr;
+  WlzFnType	type = WLZ_FN_BASIS_2DTPS;
+  WlzDVertex2	*dPts = NULL,
+  		*sPts = NULL;
+  WlzBasisFnTransform *tr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hmvn:r:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'm':
+        type = WLZ_FN_BASIS_2DMQ;
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nPts) != 1) || (nPts < 3))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &maxRes) != 1) || (maxRes <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%d", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if(((dPts = (WlzDVertex2 *)
+                AlcMalloc(sizeof(WlzDVertex2) * nPts)) == NULL) ||
+       ((sPts = (WlzDVertex2 *)
+                AlcMalloc(sizeof(WlzDVertex2) * nPts)) == NULL))
+    {
+      ok = 0;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(ok)
+  {
+    /* Random control points with a smooth displacement plus noise. */
+    AlgRandSeed(seed);
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      dPts[idN].vtX = 1000.0 * AlgRandUniform();
+      dPts[idN].vtY = 1000.0 * AlgRandUniform();
+      sPts[idN].vtX = dPts[idN].vtX +
+		      20.0 * sin(dPts[idN].vtY / 150.0) +
+		      2.0 * (AlgRandUniform() - 0.5);
+      sPts[idN].vtY = dPts[idN].vtY +
+		      20.0 * cos(dPts[idN].vtX / 200.0) +
+		      2.0 * (AlgRandUniform() - 0.5);
+    }
+    tr = WlzBasisFnTrFromCPts2DParam(type, 0, nPts, dPts, nPts, sPts, NULL,
+				     0, NULL, &errNum);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute basis function transform (%s).\n",
+		     argv[0], errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    /* The transform must map the destination control points to the
+     * source control points. */
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nPts); ++idN)
+    {
+      double	d;
+      WlzDVertex2 v;
+
+      v = WlzBasisFnTransformVertexD(tr, dPts[idN], &errNum);
+      WLZ_VTX_2_SUB(v, v, sPts[idN]);
+      d = WLZ_VTX_2_LENGTH(v);
+      res = WLZ_MAX(res, d);
+    }
+    if(verbose)
+    {
+      (void )fprintf(stderr, "%s: nPts = %d, max residual = %g\n",
+		     argv[0], nPts, res);
+    }
+    if((errNum != WLZ_ERR_NONE) || (res > maxRes))
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: Control point residual %g exceeds %g.\n",
+		     argv[0], res, maxRes);
+    }
+  }
+  (void )WlzBasisFnFreeTransform(tr);
+  AlcFree(dPts);
+  AlcFree(sPts);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-m] [-v] [-n#] [-r#] [-s#]\n"
+    "Builds a 2D basis function transform from random control points\n"
+    "and checks that it is solved and interpolates the control points.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -m  Use a multi-quadric rather than a thin-plate spline.\n"
+    "  -v  Verbose output.\n"
+    "  -n  Number of control points (default %d).\n"
+    "  -r  Maximum control point residual (default %g).\n"
+    "  -s  Random number generator seed (default %d).\n",
+    argv[0], nPts, maxRes, seed);
+  }
+  return(!ok);
+}
@@ -0,0 +1,326 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstChunkedValues_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstChunkedValues.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for writing and reading 3D objects with chunked,
+* 		compressed voxel values. An object is written using
+* 		WlzWriteObjChunked() with each of the chunk codecs, read
+* 		back using WlzReadObj() and WlzReadObjRegion() and the
+* 		values read are compared with those written.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static WlzErrorNum		WlzTstChunkedValuesCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIBox3 box,
+				  int *dstNDiff);
+static WlzObject		*WlzTstChunkedValuesRoundTrip(
+				  WlzObject *obj,
+				  WlzChunkCodec codec,
+				  int region,
+				  WlzIBox3 box,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idC,
+		idR,
+		option,
+		nDiff = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzIBox3	box,
+  		rBox;
+  WlzPixelV	bgd;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzChunkCodec	codec[3] = {WLZ_CHUNK_CODEC_NONE,
+			    WLZ_CHUNK_CODEC_ZLIB,
+			    WLZ_CHUNK_CODEC_BZIP2};
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    box.xMin = -3;
+    box.xMax = 60;
+    box.yMin = 2;
+    box.yMax = 50;
+    box.zMin = 1;
+    box.zMax = 12;
+    rBox.xMin = 10;
+    rBox.xMax = 40;
+    rBox.yMin = 20;
+    rBox.yMax = 33;
+    rBox.zMin = 4;
+    rBox.zMax = 7;
+    bgd.type = WLZ_GREY_SHORT;
+    bgd.v.shv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeCuboid(box.zMin, box.zMax, box.yMin, box.yMax,
+			box.xMin, box.xMax, WLZ_GREY_SHORT, bgd,
+			NULL, NULL, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	kl,
+		ln,
+		pl;
+
+      /* Smoothly varying values so that the chunks compress. */
+      for(pl = box.zMin; pl <= box.zMax; ++pl)
+      {
+	for(ln = box.yMin; ln <= box.yMax; ++ln)
+	{
+	  for(kl = box.xMin; kl <= box.xMax; ++kl)
+	  {
+	    WlzGreyValueGet(gVWSp, pl, ln, kl);
+	    *(gVWSp->gPtr[0].shp) = (short )((kl * ln) / 8 + pl);
+	  }
+	}
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+    ok = errNum == WLZ_ERR_NONE;
+  }
+  for(idC = 0; ok && (idC < 3); ++idC)
+  {
+    for(idR = 0; ok && (idR < 2); ++idR)
+    {
+      rObj = WlzTstChunkedValuesRoundTrip(obj, codec[idC], idR, rBox,
+					  &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzTstChunkedValuesCmp(obj, rObj, (idR)? rBox: box,
+					&nDiff);
+      }
+      (void )WlzFreeObj(rObj);
+      rObj = NULL;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(verbose)
+	{
+	  (void )fprintf(stderr, "%s: codec %d, region %d, %d differ.\n",
+			 argv[0], (int )codec[idC], idR, nDiff);
+	}
+	if(nDiff != 0)
+	{
+	  ok = 0;
+	  (void )fprintf(stderr,
+			 "%s: Values read differ from those written "
+			 "(codec %d, region %d).\n",
+			 argv[0], (int )codec[idC], idR);
+	}
+      }
+      else
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	(void )fprintf(stderr,
+		       "%s: Failed to write and read object "
+		       "(codec %d, region %d, %s).\n",
+		       argv[0], (int )codec[idC], idR, errMsgStr);
+      }
+    }
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Checks that 3D objects written with chunked voxel values, using\n"
+    "each of the chunk codecs, are read back with the values written,\n"
+    "both in full and when clipped to a region as they are read.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Object read back, NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Writes the given object to a temporary file using
+* 		WlzWriteObjChunked() and then reads it back.
+* \param	obj			Given object.
+* \param	codec			Chunk codec.
+* \param	region			Read the object using
+* 					WlzReadObjRegion() if non-zero,
+* 					otherwise using WlzReadObj().
+* \param	box			Region for WlzReadObjRegion().
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzTstChunkedValuesRoundTrip(
+				  WlzObject *obj,
+				  WlzChunkCodec codec,
+				  int region,
+				  WlzIBox3 box,
+				  WlzErrorNum *dstErr)
+{
+  FILE		*fP;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP = tmpfile()) == NULL)
+  {
+    errNum = WLZ_ERR_WRITE_EOF;
+  }
+  else
+  {
+    /* A small band size so that the objects have many chunks. */
+    errNum = WlzWriteObjChunked(fP, obj, codec, 5);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rewind(fP);
+      rObj = WlzAssignObject((region)?
+			     WlzReadObjRegion(fP, box, &errNum):
+			     WlzReadObj(fP, &errNum), NULL);
+    }
+    (void )fclose(fP);
+  }
+  *dstErr = errNum;
+  return(rObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Counts the voxels within the given box at which the values
+* 		of the two objects differ, or which are not in the domain
+* 		of the second object. The second object's bounding box
+* 		must also be the given box.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	box			Given box.
+* \param	dstNDiff		Destination pointer for the number
+* 					of differences.
+*/
+static WlzErrorNum		WlzTstChunkedValuesCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIBox3 box,
+				  int *dstNDiff)
+{
+  int		kl,
+		ln,
+		pl,
+		nDiff = 0;
+  WlzIBox3	box1;
+  WlzGreyValueWSpace *gVWSp0 = NULL,
+		*gVWSp1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  box1 = WlzBoundingBox3I(obj1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((box1.xMin != box.xMin) || (box1.xMax != box.xMax) ||
+       (box1.yMin != box.yMin) || (box1.yMax != box.yMax) ||
+       (box1.zMin != box.zMin) || (box1.zMax != box.zMax))
+    {
+      ++nDiff;
+    }
+    gVWSp0 = WlzGreyValueMakeWSp(obj0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp1 = WlzGreyValueMakeWSp(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pl = box.zMin; pl <= box.zMax; ++pl)
+    {
+      for(ln = box.yMin; ln <= box.yMax; ++ln)
+      {
+	for(kl = box.xMin; kl <= box.xMax; ++kl)
+	{
+	  WlzGreyValueGet(gVWSp0, pl, ln, kl);
+	  WlzGreyValueGet(gVWSp1, pl, ln, kl);
+	  if((gVWSp1->bkdFlag != 0) ||
+	     (gVWSp0->gVal[0].shv != gVWSp1->gVal[0].shv))
+	  {
+	    ++nDiff;
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp0);
+  WlzGreyValueFreeWSp(gVWSp1);
+  *dstNDiff = nDiff;
+  return(errNum);
+}
@@ -0,0 +1,386 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGreyPipe_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGreyPipe.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the equivalence of grey value pipelines and the
+* 		operators they replace. Random unsigned byte images are
+* 		passed through scalar and range pipeline stages and the
+* 		results are compared with those of WlzScalarBinaryOp2()
+* 		and WlzGreySetRange() applied in turn.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static int			WlzTstGreyPipeCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idN,
+		idT,
+		option,
+		nDiff,
+		sz = 256,
+		seed = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzUByte	*vals = NULL;
+  WlzPixelV	bgd,
+  		pV,
+		min,
+		max,
+		newMin,
+		newMax;
+  WlzGreyPipe	*pipe = NULL;
+  WlzObject	*iObj = NULL,
+  		*pObj = NULL,
+		*cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hvn:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        if((sscanf(optarg, "%d", &sz) != 1) || (sz < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%d", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if((vals = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) * sz * sz)) == NULL)
+    {
+      ok = 0;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(ok)
+  {
+    AlgRandSeed(seed);
+    for(idN = 0; idN < sz * sz; ++idN)
+    {
+      vals[idN] = (WlzUByte )(256.0 * AlgRandUniform()) & 0xff;
+    }
+    bgd.type = WLZ_GREY_UBYTE;
+    bgd.v.ubv = 0;
+    iObj = WlzAssignObject(
+	   WlzMakeRect(0, sz - 1, 0, sz - 1, WLZ_GREY_UBYTE, (int *)vals,
+		       bgd, NULL, NULL, &errNum), NULL);
+    ok = errNum == WLZ_ERR_NONE;
+  }
+  /* Each test is a pipeline of one or two stages and the same operators
+   * applied in turn:
+   *   0: v * 1.7 (ubyte to short, truncated).
+   *   1: v - 300 (ubyte to short, integral operand).
+   *   2: range [0, 255] to [-100, 300] (ubyte, rounded and wrapped).
+   *   3: v * 1.7 then range [0, 433] to [-1000, 50000] (short, wrapped).
+   *   4: v / 3.0 (ubyte to short) then range [0, 85] to [0.5, 1.0]
+   *      in float. */
+  for(idT = 0; ok && (idT < 5); ++idT)
+  {
+    pipe = WlzMakeGreyPipe(&errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      pV.type = WLZ_GREY_DOUBLE;
+      min.type = max.type = newMin.type = newMax.type = WLZ_GREY_DOUBLE;
+      switch(idT)
+      {
+	case 0:
+	  pV.v.dbv = 1.7;
+	  errNum = WlzGreyPipeAddScalar(pipe, WLZ_BO_MULTIPLY, pV.v.dbv,
+	                                WLZ_GREY_SHORT);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    cObj = WlzScalarBinaryOp2(iObj, pV, WLZ_BO_MULTIPLY, &errNum);
+	  }
+	  break;
+	case 1:
+	  pV.type = WLZ_GREY_INT;
+	  pV.v.inv = 300;
+	  errNum = WlzGreyPipeAddScalar(pipe, WLZ_BO_SUBTRACT, pV.v.inv,
+	                                WLZ_GREY_SHORT);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    cObj = WlzScalarBinaryOp2(iObj, pV, WLZ_BO_SUBTRACT, &errNum);
+	  }
+	  break;
+	case 2:
+	  min.v.dbv = 0.0;
+	  max.v.dbv = 255.0;
+	  newMin.v.dbv = -100.0;
+	  newMax.v.dbv = 300.0;
+	  errNum = WlzGreyPipeAddRange(pipe, min.v.dbv, max.v.dbv,
+				       newMin.v.dbv, newMax.v.dbv,
+				       WLZ_GREY_ERROR);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    cObj = WlzCopyObject(iObj, &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzGreySetRange(cObj, min, max, newMin, newMax, 0);
+	  }
+	  break;
+	case 3:
+	  pV.v.dbv = 1.7;
+	  min.v.dbv = 0.0;
+	  max.v.dbv = 433.0;
+	  newMin.v.dbv = -1000.0;
+	  newMax.v.dbv = 50000.0;
+	  errNum = WlzGreyPipeAddScalar(pipe, WLZ_BO_MULTIPLY, pV.v.dbv,
+	                                WLZ_GREY_SHORT);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzGreyPipeAddRange(pipe, min.v.dbv, max.v.dbv,
+					 newMin.v.dbv, newMax.v.dbv,
+					 WLZ_GREY_ERROR);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    cObj = WlzScalarBinaryOp2(iObj, pV, WLZ_BO_MULTIPLY, &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzGreySetRange(cObj, min, max, newMin, newMax, 0);
+	  }
+	  break;
+	case 4:
+	  {
+	    WlzObject *tObj = NULL;
+
+	    pV.v.dbv = 3.0;
+	    min.v.dbv = 0.0;
+	    max.v.dbv = 85.0;
+	    newMin.v.dbv = 0.5;
+	    newMax.v.dbv = 1.0;
+	    errNum = WlzGreyPipeAddScalar(pipe, WLZ_BO_DIVIDE, pV.v.dbv,
+					  WLZ_GREY_SHORT);
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = WlzGreyPipeAddScalar(pipe, WLZ_BO_ADD, 0.0,
+					    WLZ_GREY_FLOAT);
+	    }
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = WlzGreyPipeAddRange(pipe, min.v.dbv, max.v.dbv,
+					   newMin.v.dbv, newMax.v.dbv,
+					   WLZ_GREY_ERROR);
+	    }
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      tObj = WlzScalarBinaryOp2(iObj, pV, WLZ_BO_DIVIDE, &errNum);
+	    }
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      cObj = WlzConvertPix(tObj, WLZ_GREY_FLOAT, &errNum);
+	    }
+	    (void )WlzFreeObj(tObj);
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = WlzGreySetRange(cObj, min, max, newMin, newMax, 0);
+	    }
+	  }
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      pObj = WlzGreyPipeRun(pipe, iObj, 0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nDiff = WlzTstGreyPipeCmp(pObj, cObj, &errNum);
+      if(verbose)
+      {
+	(void )fprintf(stderr, "%s: test %d, %d values differ.\n",
+		       argv[0], idT, nDiff);
+      }
+      if((errNum == WLZ_ERR_NONE) && (nDiff != 0))
+      {
+	ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Pipeline and operators differ in %d values "
+		       "for test %d.\n",
+		       argv[0], nDiff, idT);
+      }
+    }
+    (void )WlzFreeGreyPipe(pipe);
+    (void )WlzFreeObj(pObj);
+    (void )WlzFreeObj(cObj);
+    pipe = NULL;
+    pObj = cObj = NULL;
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to run test %d (%s).\n",
+		     argv[0], idT, errMsgStr);
+    }
+  }
+  (void )WlzFreeObj(iObj);
+  AlcFree(vals);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-n#] [-s#]\n"
+    "Checks that grey value pipelines give the same values as the\n"
+    "scalar arithmetic and range operators applied in turn.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n"
+    "  -n  Width and height of the test image (default %d).\n"
+    "  -s  Random number generator seed (default %d).\n",
+    argv[0], sz, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Number of values which differ.
+* \ingroup	BinWlzTst
+* \brief	Compares the values of two 2D domain objects which have
+* 		the same domain, including their grey types.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	dstErr			Destination error pointer.
+*/
+static int			WlzTstGreyPipeCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nDiff = 0;
+  WlzIntervalWSpace iWSp[2];
+  WlzGreyWSpace	gWSp[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzInitGreyScan(obj0, iWSp + 0, gWSp + 0);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj1, iWSp + 1, gWSp + 1);
+    if((errNum == WLZ_ERR_NONE) &&
+       (gWSp[0].pixeltype != gWSp[1].pixeltype))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(iWSp + 0)) == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(iWSp + 1)) == WLZ_ERR_NONE))
+    {
+      WlzGreyP	g0,
+		g1;
+
+      g0 = gWSp[0].u_grintptr;
+      g1 = gWSp[1].u_grintptr;
+      for(idx = 0; idx < iWSp[0].colrmn; ++idx)
+      {
+	switch(gWSp[0].pixeltype)
+	{
+	  case WLZ_GREY_INT:
+	    nDiff += g0.inp[idx] != g1.inp[idx];
+	    break;
+	  case WLZ_GREY_SHORT:
+	    nDiff += g0.shp[idx] != g1.shp[idx];
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    nDiff += g0.ubp[idx] != g1.ubp[idx];
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    nDiff += g0.flp[idx] != g1.flp[idx];
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    nDiff += g0.dbp[idx] != g1.dbp[idx];
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    (void )WlzEndGreyScan(iWSp + 0, gWSp + 0);
+    (void )WlzEndGreyScan(iWSp + 1, gWSp + 1);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nDiff);
+}
@@ -0,0 +1,379 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGreyValueBatch_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGreyValueBatch.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for batch grey value lookup in 3D objects. Nearest
+* 		neighbour, linear and cubic values from
+* 		WlzGreyValueGetBatch() are compared with values computed
+* 		directly for random positions in and around a cuboid,
+* 		including positions with planes before the first and
+* 		after the last plane of the object.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstGreyValueBatchVal(
+				  WlzIBox3 box,
+				  int kl,
+				  int ln,
+				  int pl);
+static double			WlzTstGreyValueBatchRef(
+				  WlzIBox3 box,
+				  WlzInterpolationType interp,
+				  WlzDVertex3 p);
+static void			WlzTstGreyValueBatchCubicW(
+				  double t,
+				  double *w);
+
+int		main(int argc, char *argv[])
+{
+  int		idN,
+		idT,
+		option,
+		nDiff,
+		nPos = 5000,
+		seed = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  double	*val = NULL;
+  const char	*errMsgStr;
+  WlzIBox3	box;
+  WlzPixelV	bgd;
+  WlzVertexP	pos;
+  WlzObject	*obj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzInterpolationType interp[3] = {WLZ_INTERPOLATION_NEAREST,
+				    WLZ_INTERPOLATION_LINEAR,
+				    WLZ_INTERPOLATION_CUBIC};
+  static char   optList[] = "hvn:s:";
+
+  pos.v = NULL;
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'n':
+        if((sscanf(optarg, "%d", &nPos) != 1) || (nPos < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%d", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    /* A 23x19x7 cuboid which is offset from the origin, with planes
+     * either side of plane zero. */
+    box.xMin = 5;
+    box.xMax = 27;
+    box.yMin = -4;
+    box.yMax = 14;
+    box.zMin = -2;
+    box.zMax = 4;
+    bgd.type = WLZ_GREY_SHORT;
+    bgd.v.shv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeCuboid(box.zMin, box.zMax, box.yMin, box.yMax,
+			box.xMin, box.xMax, WLZ_GREY_SHORT, bgd,
+			NULL, NULL, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	kl,
+		ln,
+		pl;
+
+      for(pl = box.zMin; pl <= box.zMax; ++pl)
+      {
+	for(ln = box.yMin; ln <= box.yMax; ++ln)
+	{
+	  for(kl = box.xMin; kl <= box.xMax; ++kl)
+	  {
+	    WlzGreyValueGet(gVWSp, pl, ln, kl);
+	    *(gVWSp->gPtr[0].shp) = (short )
+	        WlzTstGreyValueBatchVal(box, kl, ln, pl);
+	  }
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(((pos.d3 = (WlzDVertex3 *)
+		    AlcMalloc(sizeof(WlzDVertex3) * nPos)) == NULL) ||
+	 ((val = (double *)AlcMalloc(sizeof(double) * nPos)) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    ok = errNum == WLZ_ERR_NONE;
+  }
+  if(ok)
+  {
+    /* Random positions within three voxels of the cuboid, so that
+     * neighbouring values are often outside of it. */
+    AlgRandSeed(seed);
+    for(idN = 0; idN < nPos; ++idN)
+    {
+      pos.d3[idN].vtX = box.xMin - 3.0 +
+			(box.xMax - box.xMin + 6.0) * AlgRandUniform();
+      pos.d3[idN].vtY = box.yMin - 3.0 +
+			(box.yMax - box.yMin + 6.0) * AlgRandUniform();
+      pos.d3[idN].vtZ = box.zMin - 3.0 +
+			(box.zMax - box.zMin + 6.0) * AlgRandUniform();
+    }
+  }
+  for(idT = 0; ok && (idT < 3); ++idT)
+  {
+    errNum = WlzGreyValueGetBatch(gVWSp, interp[idT], WLZ_VERTEX_D3,
+				  nPos, pos, val);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nDiff = 0;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	double	r;
+
+	r = WlzTstGreyValueBatchRef(box, interp[idT], pos.d3[idN]);
+	if(fabs(r - val[idN]) > 1.0e-06)
+	{
+	  ++nDiff;
+	}
+      }
+      if(verbose)
+      {
+	(void )fprintf(stderr, "%s: test %d, %d values differ.\n",
+		       argv[0], idT, nDiff);
+      }
+      if(nDiff != 0)
+      {
+	ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Batch and direct values differ in %d of %d "
+		       "positions for test %d.\n",
+		       argv[0], nDiff, nPos, idT);
+      }
+    }
+    else
+    {
+      ok = 0;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+		   "%s: Failed to run test (%s).\n",
+		   argv[0], errMsgStr);
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeObj(obj);
+  AlcFree(pos.v);
+  AlcFree(val);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-n#] [-s#]\n"
+    "Checks that batch grey value lookup in a 3D object gives the same\n"
+    "nearest neighbour, linear and cubic values as direct computation.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n"
+    "  -n  Number of positions (default %d).\n"
+    "  -s  Random number generator seed (default %d).\n",
+    argv[0], nPos, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Test value at the given voxel, zero outside of the box.
+* \ingroup	BinWlzTst
+* \brief	Computes the test value for the given voxel.
+* \param	box			Bounding box of the cuboid.
+* \param	kl			Column.
+* \param	ln			Line.
+* \param	pl			Plane.
+*/
+static double			WlzTstGreyValueBatchVal(
+				  WlzIBox3 box,
+				  int kl,
+				  int ln,
+				  int pl)
+{
+  double	v = 0.0;
+
+  if((kl >= box.xMin) && (kl <= box.xMax) &&
+     (ln >= box.yMin) && (ln <= box.yMax) &&
+     (pl >= box.zMin) && (pl <= box.zMax))
+  {
+    v = 1 + (((3 * (kl - box.xMin)) + (7 * (ln - box.yMin)) +
+              (11 * (pl - box.zMin))) % 50);
+  }
+  return(v);
+}
+
+/*!
+* \return	Interpolated value.
+* \ingroup	BinWlzTst
+* \brief	Computes the nearest neighbour, linear or cubic
+* 		interpolated test value at the given position directly
+* 		from the test values.
+* \param	box			Bounding box of the cuboid.
+* \param	interp			Interpolation method.
+* \param	p			Given position.
+*/
+static double			WlzTstGreyValueBatchRef(
+				  WlzIBox3 box,
+				  WlzInterpolationType interp,
+				  WlzDVertex3 p)
+{
+  int		idX,
+  		idY,
+		idZ;
+  double	v = 0.0;
+  double	wX[4],
+  		wY[4],
+		wZ[4];
+  WlzIVertex3	i;
+
+  i.vtX = (int )floor(p.vtX);
+  i.vtY = (int )floor(p.vtY);
+  i.vtZ = (int )floor(p.vtZ);
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      v = WlzTstGreyValueBatchVal(box, WLZ_NINT(p.vtX), WLZ_NINT(p.vtY),
+				  WLZ_NINT(p.vtZ));
+      break;
+    case WLZ_INTERPOLATION_LINEAR:
+      wX[1] = p.vtX - i.vtX;
+      wY[1] = p.vtY - i.vtY;
+      wZ[1] = p.vtZ - i.vtZ;
+      wX[0] = 1.0 - wX[1];
+      wY[0] = 1.0 - wY[1];
+      wZ[0] = 1.0 - wZ[1];
+      for(idZ = 0; idZ < 2; ++idZ)
+      {
+	for(idY = 0; idY < 2; ++idY)
+	{
+	  for(idX = 0; idX < 2; ++idX)
+	  {
+	    v += wX[idX] * wY[idY] * wZ[idZ] *
+		 WlzTstGreyValueBatchVal(box, i.vtX + idX, i.vtY + idY,
+					 i.vtZ + idZ);
+	  }
+	}
+      }
+      break;
+    case WLZ_INTERPOLATION_CUBIC:
+      WlzTstGreyValueBatchCubicW(p.vtX - i.vtX, wX);
+      WlzTstGreyValueBatchCubicW(p.vtY - i.vtY, wY);
+      WlzTstGreyValueBatchCubicW(p.vtZ - i.vtZ, wZ);
+      for(idZ = 0; idZ < 4; ++idZ)
+      {
+	for(idY = 0; idY < 4; ++idY)
+	{
+	  for(idX = 0; idX < 4; ++idX)
+	  {
+	    v += wX[idX] * wY[idY] * wZ[idZ] *
+		 WlzTstGreyValueBatchVal(box, i.vtX + idX - 1,
+					 i.vtY + idY - 1, i.vtZ + idZ - 1);
+	  }
+	}
+      }
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/*!
+* \ingroup	BinWlzTst
+* \brief	Computes the four Catmull-Rom cubic convolution weights
+* 		for the given fractional offset.
+* \param	t			Offset from the second of the four
+* 					values, in the range [0,1).
+* \param	w			Destination array for the weights.
+*/
+static void			WlzTstGreyValueBatchCubicW(
+				  double t,
+				  double *w)
+{
+  w[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+  w[1] = (1.5 * t - 2.5) * t * t + 1.0;
+  w[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+  w[3] = (0.5 * t - 0.5) * t * t;
+}
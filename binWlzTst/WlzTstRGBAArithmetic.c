@@ -0,0 +1,521 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRGBAArithmetic_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRGBAArithmetic.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the RGBA arithmetic operators which use the
+* 		packed RGBA value kernels. The results of
+* 		WlzRGBAImageArithmetic() and WlzRGBAScalarBinaryOp()
+* 		are compared, for 2D and 3D objects and with each of the
+* 		SIMD instruction sets, with those found by splitting the
+* 		values into channel objects and operating on each channel.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static WlzObject		*WlzTstRGBAArithmeticMakeObj(
+				  WlzObjectType oType,
+				  int sphere,
+				  int seed,
+				  WlzUInt bgd,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstRGBAArithmeticSplit(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstRGBAArithmeticScalarSplit(
+				  WlzObject *obj,
+				  WlzPixelV pval,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstRGBAArithmeticCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  int cmpBgd,
+				  int *dstNDiff);
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		idO,
+		idS,
+		idV,
+		option,
+		nDiff = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzPixelV	pval;
+  WlzObject	*obj[2],
+		*rObj[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObjectType	oType[2] = {WLZ_2D_DOMAINOBJ, WLZ_3D_DOMAINOBJ};
+  WlzSIMDType	simd[3] = {WLZ_SIMD_NONE, WLZ_SIMD_SSE2, WLZ_SIMD_AVX2};
+  WlzBinaryOperatorType	binOp[8] = {WLZ_BO_ADD, WLZ_BO_SUBTRACT,
+				    WLZ_BO_MULTIPLY, WLZ_BO_MIN, WLZ_BO_MAX,
+				    WLZ_BO_AND, WLZ_BO_OR, WLZ_BO_XOR};
+  int		sclVal[4] = {3, 200, -77, 1000};
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  obj[0] = obj[1] = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  for(idD = 0; ok && (idD < 2); ++idD)
+  {
+    obj[0] = WlzTstRGBAArithmeticMakeObj(oType[idD], 1, 1, 0xff0a14c8,
+    					 &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj[1] = WlzTstRGBAArithmeticMakeObj(oType[idD], 0, 2, 0x03ff1464,
+      					   &errNum);
+    }
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < 3); ++idS)
+    {
+      (void )WlzValueKrnSetSIMDType(simd[idS]);
+      for(idO = 0; (errNum == WLZ_ERR_NONE) && (idO < 8); ++idO)
+      {
+	/* Arithmetic on a pair of objects. */
+	rObj[0] = rObj[1] = NULL;
+	rObj[0] = WlzAssignObject(
+		  WlzRGBAImageArithmetic(obj[0], obj[1], binOp[idO], 0,
+					 &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  rObj[1] = WlzAssignObject(
+		    WlzTstRGBAArithmeticSplit(obj[0], obj[1], binOp[idO],
+					      &errNum), NULL);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzTstRGBAArithmeticCmp(rObj[0], rObj[1], idD == 0,
+	  				   &nDiff);
+	}
+	(void )WlzFreeObj(rObj[0]);
+	(void )WlzFreeObj(rObj[1]);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  if(verbose)
+	  {
+	    (void )fprintf(stderr,
+			   "%s: %dD, simd %d, image operator %d, %d differ.\n",
+			   argv[0], idD + 2, (int )simd[idS], (int )binOp[idO],
+			   nDiff);
+	  }
+	  if(nDiff != 0)
+	  {
+	    ok = 0;
+	    (void )fprintf(stderr,
+			   "%s: Image arithmetic values differ "
+			   "(%dD, simd %d, operator %d).\n",
+			   argv[0], idD + 2, (int )simd[idS], (int )binOp[idO]);
+	  }
+	}
+	/* Arithmetic with a constant operand. */
+	for(idV = 0; (errNum == WLZ_ERR_NONE) && (idV < 4); ++idV)
+	{
+	  pval.type = WLZ_GREY_INT;
+	  pval.v.inv = sclVal[idV];
+	  rObj[0] = rObj[1] = NULL;
+	  rObj[0] = WlzAssignObject(
+		    WlzRGBAScalarBinaryOp(obj[0], pval, binOp[idO],
+					  &errNum), NULL);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    rObj[1] = WlzAssignObject(
+		      WlzTstRGBAArithmeticScalarSplit(obj[0], pval, binOp[idO],
+						      &errNum), NULL);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzTstRGBAArithmeticCmp(rObj[0], rObj[1], idD == 0,
+	    				     &nDiff);
+	  }
+	  (void )WlzFreeObj(rObj[0]);
+	  (void )WlzFreeObj(rObj[1]);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    if(verbose)
+	    {
+	      (void )fprintf(stderr,
+			     "%s: %dD, simd %d, scalar operator %d (%d), "
+			     "%d differ.\n",
+			     argv[0], idD + 2, (int )simd[idS],
+			     (int )binOp[idO], sclVal[idV], nDiff);
+	    }
+	    if(nDiff != 0)
+	    {
+	      ok = 0;
+	      (void )fprintf(stderr,
+			     "%s: Scalar arithmetic values differ "
+			     "(%dD, simd %d, operator %d, value %d).\n",
+			     argv[0], idD + 2, (int )simd[idS],
+			     (int )binOp[idO], sclVal[idV]);
+	    }
+	  }
+	}
+      }
+    }
+    (void )WlzFreeObj(obj[0]);
+    (void )WlzFreeObj(obj[1]);
+    obj[0] = obj[1] = NULL;
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute RGBA arithmetic (%dD, %s).\n",
+		     argv[0], idD + 2, errMsgStr);
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Checks that the RGBA arithmetic operators, which use the packed\n"
+    "RGBA value kernels, give the same results as operating on each\n"
+    "channel separately, for 2D and 3D objects and with each of the\n"
+    "SIMD instruction sets.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New object with RGBA values, NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a test object with a spherical or cuboid domain
+* 		and pseudo random RGBA values.
+* \param	oType			Object type, either WLZ_2D_DOMAINOBJ
+* 					or WLZ_3D_DOMAINOBJ.
+* \param	sphere			Spherical domain if non zero,
+* 					otherwise a cuboid domain which
+* 					overlaps the sphere.
+* \param	seed			Seed for the values.
+* \param	bgd			Background value.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzTstRGBAArithmeticMakeObj(
+				  WlzObjectType oType,
+				  int sphere,
+				  int seed,
+				  WlzUInt bgd,
+				  WlzErrorNum *dstErr)
+{
+  WlzUInt	rnd;
+  WlzIBox3	box;
+  WlzObjectType	vType;
+  WlzPixelV	bgdV;
+  WlzObject	*dObj = NULL,
+		*obj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dObj = WlzAssignObject((sphere)?
+	 WlzMakeSphereObject(oType, 30.0, 40.0, 40.0, 10.0, &errNum):
+	 WlzMakeCuboidObject(oType, 35.0, 20.0, 8.0, 60.0, 50.0, 12.0,
+			     &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV.type = WLZ_GREY_RGBA;
+    bgdV.v.rgbv = bgd;
+    vType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_RGBA,
+				  &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzAssignObject(
+	  WlzNewObjectValues(dObj, vType, bgdV, 0, bgdV, &errNum), NULL);
+  }
+  (void )WlzFreeObj(dObj);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    box = WlzBoundingBox3I(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		kl,
+		ln,
+		pl;
+
+    /* Values spread over the whole range of each channel. */
+    rnd = seed;
+    for(pl = box.zMin; pl <= box.zMax; ++pl)
+    {
+      for(ln = box.yMin; ln <= box.yMax; ++ln)
+      {
+	for(kl = box.xMin; kl <= box.xMax; ++kl)
+	{
+	  WlzGreyValueGet(gVWSp, pl, ln, kl);
+	  if(gVWSp->bkdFlag == 0)
+	  {
+	    rnd = (rnd * 1103515245u) + 12345u;
+	    *(gVWSp->gPtr[0].rgbp) = rnd ^ (rnd >> 13);
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  *dstErr = errNum;
+  return(obj);
+}
+
+/*!
+* \return	New object, NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Performs image arithmetic on objects with RGBA values
+* 		by splitting the values into channel objects, combining
+* 		the channels using WlzImageArithmetic() and then packing
+* 		them again.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	op			Binary operator.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzTstRGBAArithmeticSplit(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr)
+{
+  int		idx;
+  WlzObject	*objs[4];
+  WlzObject	*rObj = NULL;
+  WlzCompoundArray *cmp0 = NULL,
+  		*cmp1 = NULL,
+		*rCmp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  objs[0] = objs[1] = objs[2] = objs[3] = NULL;
+  cmp0 = WlzRGBAToCompound(obj0, WLZ_RGBA_SPACE_RGB, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cmp1 = WlzRGBAToCompound(obj1, WLZ_RGBA_SPACE_RGB, &errNum);
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 4); ++idx)
+  {
+    objs[idx] = WlzImageArithmetic(cmp0->o[idx], cmp1->o[idx], op, 0,
+    				   &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rCmp = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 3, 4, objs,
+				obj0->type, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzCompoundToRGBA(rCmp, WLZ_RGBA_SPACE_RGB, &errNum);
+  }
+  (void )WlzFreeObj((WlzObject *)cmp0);
+  (void )WlzFreeObj((WlzObject *)cmp1);
+  (void )WlzFreeObj((WlzObject *)rCmp);
+  *dstErr = errNum;
+  return(rObj);
+}
+
+/*!
+* \return	New object, NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Performs a scalar operation on an object with RGBA
+* 		values by splitting the values into channel objects,
+* 		operating on each channel using WlzScalarBinaryOp() and
+* 		then packing them again.
+* \param	obj			Given object.
+* \param	pval			Operand value.
+* \param	op			Binary operator.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzTstRGBAArithmeticScalarSplit(
+				  WlzObject *obj,
+				  WlzPixelV pval,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr)
+{
+  int		idx;
+  WlzObject	*rObj = NULL;
+  WlzCompoundArray *cmp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  cmp = WlzRGBAToCompound(obj, WLZ_RGBA_SPACE_RGB, &errNum);
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 4); ++idx)
+  {
+    errNum = WlzScalarBinaryOp(cmp->o[idx], pval, cmp->o[idx], op);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzCompoundToRGBA(cmp, WLZ_RGBA_SPACE_RGB, &errNum);
+  }
+  (void )WlzFreeObj((WlzObject *)cmp);
+  *dstErr = errNum;
+  return(rObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Counts the differences between two objects with RGBA
+* 		values. The bounding boxes and (optionally) backgrounds
+* 		are compared and then, over the bounding box, whether
+* 		each voxel is in the domains and if so the values.
+* 		WlzCompoundToRGBA() always gives 3D objects a zero
+* 		background, so the backgrounds of the 3D objects
+* 		split into channels are not compared.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	cmpBgd			Compare the backgrounds if non
+* 					zero.
+* \param	dstNDiff		Destination pointer for the number
+* 					of differences.
+*/
+static WlzErrorNum		WlzTstRGBAArithmeticCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  int cmpBgd,
+				  int *dstNDiff)
+{
+  int		kl,
+		ln,
+		pl,
+		nDiff = 0;
+  WlzIBox3	box0,
+  		box1;
+  WlzPixelV	bgd0,
+  		bgd1;
+  WlzGreyValueWSpace *gVWSp0 = NULL,
+		*gVWSp1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  box0 = WlzBoundingBox3I(obj0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    box1 = WlzBoundingBox3I(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgd0 = WlzGetBackground(obj0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgd1 = WlzGetBackground(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((box0.xMin != box1.xMin) || (box0.xMax != box1.xMax) ||
+       (box0.yMin != box1.yMin) || (box0.yMax != box1.yMax) ||
+       (box0.zMin != box1.zMin) || (box0.zMax != box1.zMax))
+    {
+      ++nDiff;
+    }
+    (void )WlzValueConvertPixel(&bgd0, bgd0, WLZ_GREY_RGBA);
+    (void )WlzValueConvertPixel(&bgd1, bgd1, WLZ_GREY_RGBA);
+    if(cmpBgd && (bgd0.v.rgbv != bgd1.v.rgbv))
+    {
+      ++nDiff;
+    }
+    gVWSp0 = WlzGreyValueMakeWSp(obj0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp1 = WlzGreyValueMakeWSp(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pl = box0.zMin; pl <= box0.zMax; ++pl)
+    {
+      for(ln = box0.yMin; ln <= box0.yMax; ++ln)
+      {
+	for(kl = box0.xMin; kl <= box0.xMax; ++kl)
+	{
+	  WlzGreyValueGet(gVWSp0, pl, ln, kl);
+	  WlzGreyValueGet(gVWSp1, pl, ln, kl);
+	  if((gVWSp0->bkdFlag != gVWSp1->bkdFlag) ||
+	     ((gVWSp0->bkdFlag == 0) &&
+	      (gVWSp0->gVal[0].rgbv != gVWSp1->gVal[0].rgbv)))
+	  {
+	    ++nDiff;
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp0);
+  WlzGreyValueFreeWSp(gVWSp1);
+  *dstNDiff = nDiff;
+  return(errNum);
+}
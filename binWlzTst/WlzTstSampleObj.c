@@ -0,0 +1,361 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstSampleObj_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstSampleObj.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for sampling 2D objects using WlzSampleObj(). Mean,
+* 		minimum and maximum sampled values of int and double
+* 		objects are compared with values computed directly over
+* 		the sampling window of each sampled pixel.
+* \ingroup	BinWlzTst
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+static double			WlzTstSampleObjVal(
+				  int kl,
+				  int ln);
+static WlzObject		*WlzTstSampleObjMake(
+				  WlzIBox2 box,
+				  WlzGreyType gType,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstSampleObjCheck(
+				  WlzObject *obj,
+				  int samFac,
+				  WlzSampleFn samFn,
+				  int *dstNDiff);
+
+int		main(int argc, char *argv[])
+{
+  int		idF,
+		idS,
+		idT,
+		option,
+		nDiff = 0,
+  		ok = 1,
+		verbose = 0,
+  		usage = 0;
+  const char	*errMsgStr;
+  WlzIBox2	box;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzGreyType	gType[2] = {WLZ_GREY_INT, WLZ_GREY_DOUBLE};
+  WlzSampleFn	samFn[3] = {WLZ_SAMPLEFN_MEAN,
+			    WLZ_SAMPLEFN_MIN,
+			    WLZ_SAMPLEFN_MAX};
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  box.xMin = 7;
+  box.xMax = 57;
+  box.yMin = -5;
+  box.yMax = 33;
+  for(idT = 0; ok && (idT < 2); ++idT)
+  {
+    obj = WlzTstSampleObjMake(box, gType[idT], &errNum);
+    for(idS = 2; (errNum == WLZ_ERR_NONE) && (idS <= 3); ++idS)
+    {
+      for(idF = 0; (errNum == WLZ_ERR_NONE) && (idF < 3); ++idF)
+      {
+	errNum = WlzTstSampleObjCheck(obj, idS, samFn[idF], &nDiff);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  if(verbose)
+	  {
+	    (void )fprintf(stderr,
+			   "%s: grey type %d, sampling factor %d, "
+			   "function %d, %d values differ.\n",
+			   argv[0], (int )gType[idT], idS, (int )samFn[idF],
+			   nDiff);
+	  }
+	  if(nDiff != 0)
+	  {
+	    ok = 0;
+	    (void )fprintf(stderr,
+			   "%s: Sampled and direct values differ in %d "
+			   "pixels (grey type %d, sampling factor %d, "
+			   "function %d).\n",
+			   argv[0], nDiff, (int )gType[idT], idS,
+			   (int )samFn[idF]);
+	  }
+	}
+      }
+    }
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to run test (%s).\n",
+		     argv[0], errMsgStr);
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Checks that the mean, minimum and maximum values sampled from 2D\n"
+    "objects by WlzSampleObj() are the same as those computed directly\n"
+    "over the sampling window of each sampled pixel.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Test value at the given pixel.
+* \ingroup	BinWlzTst
+* \brief	Computes the test value for the given pixel. The values
+* 		differ between neighbouring rows and columns so that
+* 		a misplaced sampling window changes the sampled values.
+* \param	kl			Column.
+* \param	ln			Line.
+*/
+static double			WlzTstSampleObjVal(
+				  int kl,
+				  int ln)
+{
+  double	v;
+
+  v = 1 + (((37 * (kl + 100)) + (101 * (ln + 100)) +
+            ((kl + 100) * (ln + 100))) % 251);
+  return(v);
+}
+
+/*!
+* \return	New rectangular object with the test values.
+* \ingroup	BinWlzTst
+* \brief	Makes a rectangular 2D object with the given bounding box
+* 		and grey type, which has the test values.
+* \param	box			Bounding box of the object.
+* \param	gType			Grey type of the object.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzTstSampleObjMake(
+				  WlzIBox2 box,
+				  WlzGreyType gType,
+				  WlzErrorNum *dstErr)
+{
+  int		kl,
+  		ln;
+  WlzObject	*obj = NULL;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPixelV	bgd;
+  WlzObjectType	gTabType;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  bgd.type = WLZ_GREY_INT;
+  bgd.v.inv = 0;
+  dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+				box.yMin, box.yMax, box.xMin, box.xMax,
+				&errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzAssignObject(
+	  WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gTabType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    val.v = WlzNewValueTb(obj, gTabType, bgd, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj->values = WlzAssignValues(val, NULL);
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(ln = box.yMin; ln <= box.yMax; ++ln)
+    {
+      for(kl = box.xMin; kl <= box.xMax; ++kl)
+      {
+	WlzGreyValueGet(gVWSp, 0, ln, kl);
+	if(gType == WLZ_GREY_INT)
+	{
+	  *(gVWSp->gPtr[0].inp) = (int )WlzTstSampleObjVal(kl, ln);
+	}
+	else
+	{
+	  *(gVWSp->gPtr[0].dbp) = WlzTstSampleObjVal(kl, ln);
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  *dstErr = errNum;
+  return(obj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Samples the given object and counts the sampled values
+* 		which differ from the values computed directly over the
+* 		same sampling window as used by WlzSampleObj(), ie
+* 		samFac + 1 or samFac + 2 pixels wide (whichever is odd)
+* 		and centred on the source pixel.
+* \param	obj			Given rectangular object.
+* \param	samFac			Sampling factor for both rows and
+* 					columns.
+* \param	samFn			Sampling function.
+* \param	dstNDiff		Destination pointer for the number
+* 					of differing values.
+*/
+static WlzErrorNum		WlzTstSampleObjCheck(
+				  WlzObject *obj,
+				  int samFac,
+				  WlzSampleFn samFn,
+				  int *dstNDiff)
+{
+  int		idX,
+  		idY,
+		kSz,
+		kl,
+		nDiff = 0;
+  double	v,
+  		r;
+  WlzIVertex3	fac;
+  WlzObject	*samObj = NULL;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  fac.vtX = fac.vtY = fac.vtZ = samFac;
+  kSz = (samFac % 2)? samFac + 2: samFac + 1;
+  samObj = WlzAssignObject(
+	   WlzSampleObj(obj, fac, samFn, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(samObj, &iWSp, &gWSp);
+  }
+  while((errNum == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+  {
+    for(kl = iWSp.lftpos; kl <= iWSp.rgtpos; ++kl)
+    {
+      r = 0.0;
+      for(idY = 0; idY < kSz; ++idY)
+      {
+	for(idX = 0; idX < kSz; ++idX)
+	{
+	  v = WlzTstSampleObjVal((kl * samFac) + idX - (kSz / 2),
+				 (iWSp.linpos * samFac) + idY - (kSz / 2));
+	  if(samFn == WLZ_SAMPLEFN_MEAN)
+	  {
+	    r += v;
+	  }
+	  else if(((idX == 0) && (idY == 0)) ||
+		  ((samFn == WLZ_SAMPLEFN_MIN) && (v < r)) ||
+		  ((samFn == WLZ_SAMPLEFN_MAX) && (v > r)))
+	  {
+	    r = v;
+	  }
+	}
+      }
+      if(gWSp.pixeltype == WLZ_GREY_INT)
+      {
+	if(samFn == WLZ_SAMPLEFN_MEAN)
+	{
+	  r = floor(r / (kSz * kSz));
+	}
+	v = gWSp.u_grintptr.inp[kl - iWSp.lftpos];
+      }
+      else
+      {
+	if(samFn == WLZ_SAMPLEFN_MEAN)
+	{
+	  r /= kSz * kSz;
+	}
+	v = gWSp.u_grintptr.dbp[kl - iWSp.lftpos];
+      }
+      if(fabs(r - v) > 1.0e-06)
+      {
+	++nDiff;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_EOO)
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  (void )WlzFreeObj(samObj);
+  *dstNDiff = nDiff;
+  return(errNum);
+}
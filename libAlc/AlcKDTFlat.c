@@ -0,0 +1,838 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlcKDTFlat_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libAlc/AlcKDTFlat.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A kD-tree with double precision keys which is built in
+* 		bulk, rather than by inserting one key at a time as for
+* 		the AlcKDTTree. The tree is built by recursively
+* 		partitioning the keys about their median in the dimension
+* 		of greatest extent until there are no more than a bucket
+* 		size of keys in a partition. The nodes are held in a
+* 		single array in depth first order and the keys are
+* 		reordered so that those of each leaf are contiguous.
+* 		Queries do not modify the tree, so any number of queries
+* 		may be made concurrently on the same tree.
+* \ingroup	AlcKDTree
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Alc.h>
+
+/*!
+* \def		ALC_KDTFLAT_BUCKETSZ
+* \ingroup	AlcKDTree
+* \brief	Default maximum number of keys in a leaf bucket.
+*/
+#define ALC_KDTFLAT_BUCKETSZ	(8)
+
+/*!
+* \def		ALC_KDTFLAT_MAXSTKDIM
+* \ingroup	AlcKDTree
+* \brief	Maximum dimension (and number of neighbours) for which
+* 		query workspace is held on the stack rather than being
+* 		allocated.
+*/
+#define ALC_KDTFLAT_MAXSTKDIM	(16)
+
+/*!
+* \struct	_AlcKDTFlatQry
+* \ingroup	AlcKDTree
+* \brief	Query state for searches of a flat kD-tree. This is held
+* 		on the stack of the querying function.
+*               Typedef: ::AlcKDTFlatQry
+*/
+typedef struct _AlcKDTFlatQry
+{
+  const double	*key;		/*!< Query key. */
+  double	*off;		/*!< Per dimension offsets of the key from
+  				     the current node's cell. */
+  int		k;		/*!< Maximum number of neighbours, or for a
+  				     range query the maximum number of
+				     indices to return. */
+  int		n;		/*!< Number of neighbours found so far. */
+  double	bndSq;		/*!< Current squared search radius. */
+  int		*idx;		/*!< Indices of neighbours found. */
+  double	*dSq;		/*!< Squared distances of neighbours
+  				     found. */
+} AlcKDTFlatQry;
+
+static void			AlcKDTFlatBuild(
+				  AlcKDTFlatTree *tree,
+				  int lo,
+				  int hi);
+static void			AlcKDTFlatSelect(
+				  AlcKDTFlatTree *tree,
+				  int split,
+				  int lo,
+				  int hi,
+				  int med);
+static void			AlcKDTFlatNodeKNN(
+				  const AlcKDTFlatTree *tree,
+				  int nodIdx,
+				  double offSq,
+				  AlcKDTFlatQry *qry);
+static void			AlcKDTFlatNodeRange(
+				  const AlcKDTFlatTree *tree,
+				  int nodIdx,
+				  double offSq,
+				  AlcKDTFlatQry *qry);
+static double			AlcKDTFlatDistSq(
+				  int dim,
+				  const double *key0,
+				  const double *key1);
+
+/*!
+* \return	New flat kD-tree or NULL on error.
+* \ingroup	AlcKDTree
+* \brief	Creates a new flat kD-tree from the given keys. The keys
+* 		are copied so the given array may be freed once the tree
+* 		has been built. Query functions return the indices of the
+* 		keys as given here.
+* \param	dim			Dimension of the keys (must be >= 1).
+* \param	nKeys			Number of keys, may be zero.
+* \param	keys			Array of nKeys keys each with dim
+* 					contiguous values.
+* \param	bucketSz		Maximum number of keys in a leaf,
+* 					if <= 0 a default value is used.
+* \param	dstErr			Destination pointer for error
+* 					code, may be NULL.
+*/
+AlcKDTFlatTree	*AlcKDTFlatNew(int dim, int nKeys, const double *keys,
+			       int bucketSz, AlcErrno *dstErr)
+{
+  int		maxNodes = 0;
+  AlcKDTFlatTree *tree = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((dim < 1) || (nKeys < 0))
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if((nKeys > 0) && (keys == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else
+  {
+    if(bucketSz <= 0)
+    {
+      bucketSz = ALC_KDTFLAT_BUCKETSZ;
+    }
+    /* Partitions with more than bucketSz keys are split about their
+     * median so every leaf has at least (bucketSz + 1) / 2 keys. */
+    maxNodes = 2 * (nKeys / ((bucketSz + 1) / 2)) + 1;
+    if(((tree = (AlcKDTFlatTree *)
+                AlcCalloc(1, sizeof(AlcKDTFlatTree))) == NULL) ||
+       ((nKeys > 0) &&
+        (((tree->keys = (double *)
+		        AlcMalloc(sizeof(double) * dim * nKeys)) == NULL) ||
+         ((tree->idx = (int *)AlcMalloc(sizeof(int) * nKeys)) == NULL) ||
+         ((tree->nodes = (AlcKDTFlatNode *)
+	                 AlcMalloc(sizeof(AlcKDTFlatNode) *
+			           maxNodes)) == NULL))))
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+  }
+  if((errNum == ALC_ER_NONE) && (nKeys > 0))
+  {
+    int		idK;
+
+    tree->dim = dim;
+    tree->nKeys = nKeys;
+    tree->bucketSz = bucketSz;
+    /* The keys are partitioned in place so that they are contiguous
+     * while building as well as in the built tree. */
+    (void )memcpy(tree->keys, keys, sizeof(double) * dim * nKeys);
+    for(idK = 0; idK < nKeys; ++idK)
+    {
+      tree->idx[idK] = idK;
+    }
+    AlcKDTFlatBuild(tree, 0, nKeys);
+  }
+  else if(tree)
+  {
+    tree->dim = dim;
+    tree->bucketSz = bucketSz;
+  }
+  if(errNum != ALC_ER_NONE)
+  {
+    AlcKDTFlatFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Frees a flat kD-tree.
+* \param	tree			Given tree, may be NULL.
+*/
+void		AlcKDTFlatFree(AlcKDTFlatTree *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->keys);
+    AlcFree(tree->idx);
+    AlcFree(tree->nodes);
+    AlcFree(tree);
+  }
+}
+
+/*!
+* \return	Index of the nearest key as given when the tree was built
+* 		or -1 if there is no key within the given maximum
+* 		distance.
+* \ingroup	AlcKDTree
+* \brief	Finds the nearest key in the tree to the given key.
+* 		This function may be called concurrently.
+* \param	tree			Given tree.
+* \param	key			Query key with the tree's dimension.
+* \param	maxDist			Maximum distance, only keys with a
+* 					distance less than this are found.
+* \param	dstDist			Destination pointer for the distance
+* 					to the nearest key, may be NULL. Not
+* 					set if no key is found.
+*/
+int		AlcKDTFlatGetNN(const AlcKDTFlatTree *tree, const double *key,
+				double maxDist, double *dstDist)
+{
+  int		nIdx = -1;
+  double	dist;
+
+  if(AlcKDTFlatGetKNN(tree, key, 1, maxDist, &nIdx, &dist) > 0)
+  {
+    if(dstDist)
+    {
+      *dstDist = dist;
+    }
+  }
+  else
+  {
+    nIdx = -1;
+  }
+  return(nIdx);
+}
+
+/*!
+* \return	Number of neighbours found which is at most k.
+* \ingroup	AlcKDTree
+* \brief	Finds the k nearest keys in the tree to the given key.
+* 		The neighbours are returned in order of increasing
+* 		distance, with neighbours at the same distance in
+* 		a consistent (tree) order. This function may be called
+* 		concurrently.
+* \param	tree			Given tree.
+* \param	key			Query key with the tree's dimension.
+* \param	k			Maximum number of neighbours.
+* \param	maxDist			Maximum distance, only keys with a
+* 					distance less than this are found.
+* \param	dstIdx			Destination array for the k indices
+* 					of the neighbours as given when the
+* 					tree was built.
+* \param	dstDist			Destination array for the k
+* 					distances of the neighbours, may be
+* 					NULL.
+*/
+int		AlcKDTFlatGetKNN(const AlcKDTFlatTree *tree, const double *key,
+				 int k, double maxDist,
+				 int *dstIdx, double *dstDist)
+{
+  int		idN,
+  		nFnd = 0;
+  double	*off = NULL,
+  		*dSq = NULL;
+  double	offBuf[ALC_KDTFLAT_MAXSTKDIM],
+  		dSqBuf[ALC_KDTFLAT_MAXSTKDIM];
+  AlcKDTFlatQry	qry;
+
+  if(tree && key && dstIdx && (k > 0) && (tree->nNodes > 0))
+  {
+    /* Avoid allocation for the common low dimension or small k cases,
+     * using the distances array for the squared distances if given. */
+    off = (tree->dim <= ALC_KDTFLAT_MAXSTKDIM)?
+	  offBuf: (double *)AlcMalloc(sizeof(double) * tree->dim);
+    dSq = (dstDist)? dstDist:
+          (k <= ALC_KDTFLAT_MAXSTKDIM)?
+	  dSqBuf: (double *)AlcMalloc(sizeof(double) * k);
+  }
+  if(off && dSq)
+  {
+    for(idN = 0; idN < tree->dim; ++idN)
+    {
+      off[idN] = 0.0;
+    }
+    qry.key = key;
+    qry.off = off;
+    qry.k = k;
+    qry.n = 0;
+    qry.bndSq = (maxDist < sqrt(DBL_MAX))? maxDist * maxDist: DBL_MAX;
+    qry.idx = dstIdx;
+    qry.dSq = dSq;
+    AlcKDTFlatNodeKNN(tree, 0, 0.0, &qry);
+    nFnd = qry.n;
+    for(idN = 0; idN < nFnd; ++idN)
+    {
+      dstIdx[idN] = tree->idx[dstIdx[idN]];
+      if(dstDist)
+      {
+	dstDist[idN] = sqrt(dSq[idN]);
+      }
+    }
+  }
+  if(off != offBuf)
+  {
+    AlcFree(off);
+  }
+  if((dSq != dSqBuf) && (dSq != dstDist))
+  {
+    AlcFree(dSq);
+  }
+  return(nFnd);
+}
+
+/*!
+* \return	Number of keys within the given radius of the given key,
+* 		which may be greater than maxN.
+* \ingroup	AlcKDTree
+* \brief	Finds the keys in the tree which are within the given
+* 		distance of the given key. At most maxN indices and
+* 		distances are returned, in tree order rather than
+* 		distance order. This function may be called concurrently.
+* \param	tree			Given tree.
+* \param	key			Query key with the tree's dimension.
+* \param	radius			Search radius, keys with a distance
+* 					less than or equal to this are found.
+* \param	maxN			Maximum number of indices and
+* 					distances to return.
+* \param	dstIdx			Destination array for at most maxN
+* 					indices of the keys as given when
+* 					the tree was built, may be NULL.
+* \param	dstDist			Destination array for at most maxN
+* 					distances of the keys, may be NULL.
+*/
+int		AlcKDTFlatGetRange(const AlcKDTFlatTree *tree,
+				   const double *key, double radius,
+				   int maxN, int *dstIdx, double *dstDist)
+{
+  int		idN,
+  		nFnd = 0;
+  double	*off = NULL;
+  double	offBuf[ALC_KDTFLAT_MAXSTKDIM];
+  AlcKDTFlatQry	qry;
+
+  if(tree && key && (radius >= 0.0) && (tree->nNodes > 0))
+  {
+    off = (tree->dim <= ALC_KDTFLAT_MAXSTKDIM)?
+	  offBuf: (double *)AlcMalloc(sizeof(double) * tree->dim);
+  }
+  if(off)
+  {
+    for(idN = 0; idN < tree->dim; ++idN)
+    {
+      off[idN] = 0.0;
+    }
+    qry.key = key;
+    qry.off = off;
+    qry.k = (dstIdx || dstDist)? maxN: 0;
+    qry.n = 0;
+    qry.bndSq = radius * radius;
+    qry.idx = dstIdx;
+    qry.dSq = dstDist;
+    AlcKDTFlatNodeRange(tree, 0, 0.0, &qry);
+    nFnd = qry.n;
+    for(idN = 0; (idN < nFnd) && (idN < qry.k); ++idN)
+    {
+      if(dstIdx)
+      {
+	dstIdx[idN] = tree->idx[dstIdx[idN]];
+      }
+      if(dstDist)
+      {
+	dstDist[idN] = sqrt(dstDist[idN]);
+      }
+    }
+    if(off != offBuf)
+    {
+      AlcFree(off);
+    }
+  }
+  return(nFnd);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDTree
+* \brief	Finds the k nearest keys in the tree for each of an
+* 		array of query keys, using AlcKDTFlatGetKNN(). The
+* 		queries are made in parallel when OpenMP is available
+* 		and the results do not depend on the number of threads.
+* \param	tree			Given tree.
+* \param	nQry			Number of query keys.
+* \param	qry			Array of nQry query keys each with
+* 					the tree's dimension of contiguous
+* 					values.
+* \param	k			Maximum number of neighbours per
+* 					query.
+* \param	maxDist			Maximum distance, only keys with a
+* 					distance less than this are found.
+* \param	dstIdx			Destination array for nQry * k
+* 					indices, with the neighbours of query
+* 					i at [i * k, (i + 1) * k). Unused
+* 					entries are set to -1.
+* \param	dstDist			Destination array for nQry * k
+* 					distances laid out as for dstIdx,
+* 					may be NULL. Unused entries are set
+* 					to -1.0.
+* \param	dstCnt			Destination array for the number of
+* 					neighbours found for each query, may
+* 					be NULL.
+*/
+AlcErrno	AlcKDTFlatGetKNNBatch(const AlcKDTFlatTree *tree,
+				      int nQry, const double *qry,
+				      int k, double maxDist,
+				      int *dstIdx, double *dstDist,
+				      int *dstCnt)
+{
+  int		idQ;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || ((nQry > 0) && ((qry == NULL) || (dstIdx == NULL))))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if((nQry < 0) || (k < 1))
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for(idQ = 0; idQ < nQry; ++idQ)
+    {
+      int	idN,
+      		nFnd;
+      int	*qIdx;
+      double	*qDist;
+
+      qIdx = dstIdx + ((size_t )idQ * k);
+      qDist = (dstDist)? dstDist + ((size_t )idQ * k): NULL;
+      nFnd = AlcKDTFlatGetKNN(tree, qry + ((size_t )idQ * tree->dim),
+                              k, maxDist, qIdx, qDist);
+      for(idN = nFnd; idN < k; ++idN)
+      {
+	qIdx[idN] = -1;
+	if(qDist)
+	{
+	  qDist[idN] = -1.0;
+	}
+      }
+      if(dstCnt)
+      {
+	dstCnt[idQ] = nFnd;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Recursively builds the nodes of the tree for the keys
+* 		in the range [lo, hi), reordering the keys and their
+* 		indices.
+* \param	tree			Tree being built.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the range.
+*/
+static void	AlcKDTFlatBuild(AlcKDTFlatTree *tree, int lo, int hi)
+{
+  AlcKDTFlatNode *nod;
+
+  nod = tree->nodes + tree->nNodes++;
+  if(hi - lo <= tree->bucketSz)
+  {
+    nod->split = -1;
+    nod->first = lo;
+    nod->count = hi - lo;
+    nod->val = 0.0;
+  }
+  else
+  {
+    int		idD,
+    		idK,
+		med,
+		split = 0;
+    double	maxExt = -1.0;
+    double	*key;
+
+    /* Split in the dimension of greatest extent. */
+    for(idD = 0; idD < tree->dim; ++idD)
+    {
+      double	mn,
+      		mx;
+
+      key = tree->keys + ((size_t )lo * tree->dim) + idD;
+      mn = mx = *key;
+      for(idK = lo + 1; idK < hi; ++idK)
+      {
+	key += tree->dim;
+	if(*key < mn)
+	{
+	  mn = *key;
+	}
+	else if(*key > mx)
+	{
+	  mx = *key;
+	}
+      }
+      if(mx - mn > maxExt)
+      {
+        maxExt = mx - mn;
+	split = idD;
+      }
+    }
+    med = (lo + hi) / 2;
+    AlcKDTFlatSelect(tree, split, lo, hi, med);
+    nod->split = split;
+    nod->count = 0;
+    nod->val = tree->keys[((size_t )med * tree->dim) + split];
+    AlcKDTFlatBuild(tree, lo, med); 			/* Recursive */
+    nod->first = tree->nNodes;
+    AlcKDTFlatBuild(tree, med, hi); 			/* Recursive */
+  }
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Partially sorts the keys (and their indices) in the
+* 		range [lo, hi) so that the key at med has the median
+* 		value in the split dimension, all those before it have
+* 		values less than or equal to the median and all those
+* 		after it have values greater than or equal to it.
+* \param	tree			Tree being built.
+* \param	split			Splitting dimension.
+* \param	lo			First index of the range.
+* \param	hi			One past the last index of the range.
+* \param	med			Index of the median.
+*/
+static void	AlcKDTFlatSelect(AlcKDTFlatTree *tree, int split,
+				 int lo, int hi, int med)
+{
+  int		l,
+  		r,
+		dim;
+  double	*keys;
+
+  l = lo;
+  r = hi - 1;
+  dim = tree->dim;
+  keys = tree->keys + split;
+  while(r > l)
+  {
+    int		i,
+    		j;
+    double	p;
+
+    p = keys[(size_t )((l + r) / 2) * dim];
+    i = l;
+    j = r;
+    do
+    {
+      while(keys[(size_t )i * dim] < p)
+      {
+        ++i;
+      }
+      while(p < keys[(size_t )j * dim])
+      {
+        --j;
+      }
+      if(i <= j)
+      {
+	int	idD,
+		t;
+	double	*k0,
+		*k1;
+
+	k0 = tree->keys + ((size_t )i * dim);
+	k1 = tree->keys + ((size_t )j * dim);
+	for(idD = 0; idD < dim; ++idD)
+	{
+	  double v;
+
+	  v = k0[idD];
+	  k0[idD] = k1[idD];
+	  k1[idD] = v;
+	}
+	t = tree->idx[i];
+	tree->idx[i] = tree->idx[j];
+	tree->idx[j] = t;
+	++i;
+	--j;
+      }
+    } while(i <= j);
+    if(j < med)
+    {
+      l = i;
+    }
+    if(med < i)
+    {
+      r = j;
+    }
+  }
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Recursively searches the given node for the k nearest
+* 		neighbours, visiting the nearer child first and only
+* 		visiting the further child if its cell is closer than
+* 		the current k'th neighbour. The neighbours found are
+* 		kept sorted by increasing distance.
+* \param	tree			Given tree.
+* \param	nodIdx			Index of the node to search.
+* \param	offSq			Squared distance from the query key
+* 					to the node's cell.
+* \param	qry			Query state.
+*/
+static void	AlcKDTFlatNodeKNN(const AlcKDTFlatTree *tree, int nodIdx,
+				  double offSq, AlcKDTFlatQry *qry)
+{
+  const AlcKDTFlatNode *nod;
+
+  nod = tree->nodes + nodIdx;
+  if(nod->split < 0)
+  {
+    int		idK,
+    		lst;
+    const double *key;
+
+    lst = nod->first + nod->count;
+    key = tree->keys + ((size_t )(nod->first) * tree->dim);
+    for(idK = nod->first; idK < lst; ++idK)
+    {
+      double	dSq;
+
+      dSq = AlcKDTFlatDistSq(tree->dim, qry->key, key);
+      if(dSq < qry->bndSq)
+      {
+	int	idN;
+
+	/* Insertion into the sorted list of neighbours. */
+	idN = (qry->n < qry->k)? qry->n++: qry->k - 1;
+	while((idN > 0) && (qry->dSq[idN - 1] > dSq))
+	{
+	  qry->dSq[idN] = qry->dSq[idN - 1];
+	  qry->idx[idN] = qry->idx[idN - 1];
+	  --idN;
+	}
+	qry->dSq[idN] = dSq;
+	qry->idx[idN] = idK;
+	if(qry->n == qry->k)
+	{
+	  qry->bndSq = qry->dSq[qry->k - 1];
+	}
+      }
+      key += tree->dim;
+    }
+  }
+  else
+  {
+    int		near,
+    		far;
+    double	d,
+    		old;
+
+    d = qry->key[nod->split] - nod->val;
+    if(d < 0.0)
+    {
+      near = nodIdx + 1;
+      far = nod->first;
+    }
+    else
+    {
+      near = nod->first;
+      far = nodIdx + 1;
+    }
+    AlcKDTFlatNodeKNN(tree, near, offSq, qry); 		/* Recursive */
+    old = qry->off[nod->split];
+    offSq += (d * d) - (old * old);
+    if(offSq < qry->bndSq)
+    {
+      qry->off[nod->split] = d;
+      AlcKDTFlatNodeKNN(tree, far, offSq, qry); 		/* Recursive */
+      qry->off[nod->split] = old;
+    }
+  }
+}
+
+/*!
+* \ingroup	AlcKDTree
+* \brief	Recursively searches the given node for keys within the
+* 		query radius.
+* \param	tree			Given tree.
+* \param	nodIdx			Index of the node to search.
+* \param	offSq			Squared distance from the query key
+* 					to the node's cell.
+* \param	qry			Query state.
+*/
+static void	AlcKDTFlatNodeRange(const AlcKDTFlatTree *tree, int nodIdx,
+				    double offSq, AlcKDTFlatQry *qry)
+{
+  const AlcKDTFlatNode *nod;
+
+  nod = tree->nodes + nodIdx;
+  if(nod->split < 0)
+  {
+    int		idK,
+    		lst;
+    const double *key;
+
+    lst = nod->first + nod->count;
+    key = tree->keys + ((size_t )(nod->first) * tree->dim);
+    for(idK = nod->first; idK < lst; ++idK)
+    {
+      double	dSq;
+
+      dSq = AlcKDTFlatDistSq(tree->dim, qry->key, key);
+      if(dSq <= qry->bndSq)
+      {
+        if(qry->n < qry->k)
+	{
+	  if(qry->idx)
+	  {
+	    qry->idx[qry->n] = idK;
+	  }
+	  if(qry->dSq)
+	  {
+	    qry->dSq[qry->n] = dSq;
+	  }
+	}
+	++(qry->n);
+      }
+      key += tree->dim;
+    }
+  }
+  else
+  {
+    int		near,
+    		far;
+    double	d,
+    		old;
+
+    d = qry->key[nod->split] - nod->val;
+    if(d < 0.0)
+    {
+      near = nodIdx + 1;
+      far = nod->first;
+    }
+    else
+    {
+      near = nod->first;
+      far = nodIdx + 1;
+    }
+    AlcKDTFlatNodeRange(tree, near, offSq, qry); 		/* Recursive */
+    old = qry->off[nod->split];
+    offSq += (d * d) - (old * old);
+    if(offSq <= qry->bndSq)
+    {
+      qry->off[nod->split] = d;
+      AlcKDTFlatNodeRange(tree, far, offSq, qry); 		/* Recursive */
+      qry->off[nod->split] = old;
+    }
+  }
+}
+
+/*!
+* \return	Square of distance between the two keys.
+* \ingroup	AlcKDTree
+* \brief	Computes the squared distance between the two keys.
+* \param	dim			Dimension of the keys.
+* \param	key0			First key.
+* \param	key1			Second key.
+*/
+static double	AlcKDTFlatDistSq(int dim, const double *key0,
+				 const double *key1)
+{
+  double	distSq;
+
+  switch(dim)
+  {
+    case 2:
+      {
+	double	d[2];
+
+	d[0] = key0[0] - key1[0];
+	d[1] = key0[1] - key1[1];
+	distSq = (d[0] * d[0]) + (d[1] * d[1]);
+      }
+      break;
+    case 3:
+      {
+	double	d[3];
+
+	d[0] = key0[0] - key1[0];
+	d[1] = key0[1] - key1[1];
+	d[2] = key0[2] - key1[2];
+	distSq = (d[0] * d[0]) + (d[1] * d[1]) + (d[2] * d[2]);
+      }
+      break;
+    default:
+      {
+	int	idx;
+
+	distSq = 0.0;
+	for(idx = 0; idx < dim; ++idx)
+	{
+	  double d;
+
+	  d = key0[idx] - key1[idx];
+	  distSq += d * d;
+	}
+      }
+      break;
+  }
+  return(distSq);
+}
@@ -570,6 +570,48 @@ extern AlcKDTNode	       *AlcKDTGetNN(
 				  double *dstNNDist,
 				  AlcErrno *dstErr);
 
+/************************************************************************
+* AlcKDTFlat.c
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern AlcKDTFlatTree		*AlcKDTFlatNew(
+				  int dim,
+				  int nKeys,
+				  const double *keys,
+				  int bucketSz,
+				  AlcErrno *dstErr);
+extern void			AlcKDTFlatFree(
+				  AlcKDTFlatTree *tree);
+extern int			AlcKDTFlatGetNN(
+				  const AlcKDTFlatTree *tree,
+				  const double *key,
+				  double maxDist,
+				  double *dstDist);
+extern int			AlcKDTFlatGetKNN(
+				  const AlcKDTFlatTree *tree,
+				  const double *key,
+				  int k,
+				  double maxDist,
+				  int *dstIdx,
+				  double *dstDist);
+extern int			AlcKDTFlatGetRange(
+				  const AlcKDTFlatTree *tree,
+				  const double *key,
+				  double radius,
+				  int maxN,
+				  int *dstIdx,
+				  double *dstDist);
+extern AlcErrno			AlcKDTFlatGetKNNBatch(
+				  const AlcKDTFlatTree *tree,
+				  int nQry,
+				  const double *qry,
+				  int k,
+				  double maxDist,
+				  int *dstIdx,
+				  double *dstDist,
+				  int *dstCnt);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * AlcLRUCache.c
 ************************************************************************/
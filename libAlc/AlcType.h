@@ -440,6 +440,52 @@ typedef struct _AlcKDTTree
   AlcBlockStack *freeStack;	/*!< Stack of allocated node blocks */
 } AlcKDTTree;
 
+/*!
+* \struct	_AlcKDTFlatNode
+* \ingroup	AlcKDTree
+* \brief	A node in a bulk built, flat kD-tree. Nodes are stored in
+* 		depth first order so the child node with keys less than or
+* 		equal to the splitting value always immediately follows
+* 		its parent.
+*               Typedef: ::AlcKDTFlatNode
+*/
+typedef struct _AlcKDTFlatNode
+{
+  int		split;		/*!< The splitting dimension or -1 if the
+  				     node is a leaf. */
+  int		first;		/*!< For an internal node the index of the
+  				     child node with keys greater than or
+				     equal to the splitting value, for a
+				     leaf the index of the first key in the
+				     leaf's bucket. */
+  int		count;		/*!< Number of keys in a leaf's bucket,
+  				     zero for an internal node. */
+  double	val;		/*!< The splitting value. */
+} AlcKDTFlatNode;
+
+/*!
+* \struct	_AlcKDTFlatTree
+* \ingroup	AlcKDTree
+* \brief	A kD-tree with double precision keys which is built in
+* 		bulk from a given set of keys by median partitioning.
+* 		The nodes are held in a single array and the keys of each
+* 		leaf bucket are contiguous. Once built the tree is not
+* 		modified so it may be queried concurrently.
+*               Typedef: ::AlcKDTFlatTree
+*/
+typedef struct _AlcKDTFlatTree
+{
+  int		dim;		/*!< Dimension of the tree. */
+  int		nKeys;		/*!< Number of keys in the tree. */
+  int		nNodes;		/*!< Number of nodes in the tree. */
+  int		bucketSz;	/*!< Maximum number of keys in a leaf. */
+  double	*keys;		/*!< The keys in bucket order, each key
+  				     being dim contiguous values. */
+  int		*idx;		/*!< Indices of the keys as given when the
+  				     tree was built, in bucket order. */
+  AlcKDTFlatNode *nodes;	/*!< The nodes with the root first. */
+} AlcKDTFlatTree;
+
 /*!
 * \struct       _AlcHeapEntryCore
 * \ingroup      AlcHeap
@@ -45,9 +45,7 @@ static char _AlgAutoCorr_c[] = "University of Edinburgh $Id$";
 
 AlgError	AlgAutoCorrelate2D(double **data, int nX, int nY)
 {
-  int		tI0,
-  		tI1,
-		idX,
+  int		idX,
                 idY,
                 nX2,
                 nY2;
@@ -68,16 +66,18 @@ AlgError	AlgAutoCorrelate2D(double **data, int nX, int nY)
   }
   else
   {
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI0, nX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI1, nY);
-    if((tI0 != nX) || (tI1 != nY))
+    /* Sizes must be even for the real transforms. */
+    if((nX & 1) || (nY & 1))
     {
       errNum = ALG_ERR_FUNC;
     }
   }
   if(errNum == ALG_ERR_NONE)
   {
-    AlgFourReal2D(data, 1, nX, nY);
+    errNum = AlgFourReal2D(data, 1, nX, nY);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
     nX2 = nX / 2;
     nY2 = nY / 2;
     for(idY = 0; idY < nY; ++idY)
@@ -110,7 +110,7 @@ AlgError	AlgAutoCorrelate2D(double **data, int nX, int nY)
     **(data + nY2) *= **(data + nY2);
     *(*data + nX2) *= *(*data + nX2);
     *(*(data + nY2) + nX2) *= *(*(data + nY2) + nX2);
-    AlgFourRealInv2D(data, 1, nX, nY);
+    errNum = AlgFourRealInv2D(data, 1, nX, nY);
   }
   return(errNum);
 }
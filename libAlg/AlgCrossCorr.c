@@ -52,6 +52,8 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 * \brief	Cross correlates the given 2D double arrays leaving
 *		the result in the first of the two arrays.
 *		The cross correlation data are un-normalized.
+*		The array sizes must be even and are best chosen
+*		using AlgFourNextSize().
 * \param	data0			Data for/with obj0's FFT 
 *					(source: AlcDouble2Malloc)
 *					which holds the cross	
@@ -66,9 +68,7 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 			            int nX, int nY)
 {
-  int		tI0,
-		tI1,
-		idX,
+  int		idX,
 		idY,
   		nX2,
 		nY2;
@@ -89,17 +89,22 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
   }
   else
   {
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI0, nX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI1, nY);
-    if((tI0 != nX) || (tI1 != nY))
+    /* Sizes must be even for the real transforms. */
+    if((nX & 1) || (nY & 1))
     {
       errNum = ALG_ERR_FUNC;
     }
   }
   if(errNum == ALG_ERR_NONE)
   {
-    AlgFourReal2D(data0, 1, nX, nY);
-    AlgFourReal2D(data1, 1, nX, nY);
+    errNum = AlgFourReal2D(data0, 1, nX, nY);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourReal2D(data1, 1, nX, nY);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
     nX2 = nX / 2;
     nY2 = nY / 2;
     for(idY = 0; idY < nY; ++idY)
@@ -136,7 +141,7 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
     **(data0 + nY2) *= **(data1 + nY2);
     *(*data0 + nX2) *= *(*data1 + nX2);
     *(*(data0 + nY2) + nX2) *= *(*(data1 + nY2) + nX2);
-    AlgFourRealInv2D(data0, 1, nX, nY);
+    errNum = AlgFourRealInv2D(data0, 1, nX, nY);
   }
   return(errNum);
 }
@@ -67,6 +67,18 @@ static char _AlgFourier_c[] = "University of Edinburgh $Id$";
 				  libAlg for Woolz.</td>
 		  </tr>
 </table>
+* 		Transforms of sizes which are not an integer power of two
+* 		are computed using a mixed radix (2, 3, 4, 5 and other
+* 		primes up to ALG_FOUR_MAX_RADIX) decimation in time
+* 		transform with in place digit reversal, or for sizes with
+* 		larger prime factors using Bluestein's algorithm. The
+* 		twiddle factors and permutations for these transforms are
+* 		held in plans which are created on demand and cached by
+* 		size, see AlgFourFreePlans(). Real transforms of even sizes
+* 		are computed using a complex transform of half the size
+* 		and those of odd sizes (only supported in one dimension)
+* 		using a complex transform of the same size.
+* 		AlgFourNextSize() may be used to choose efficient sizes.
 * 		The multi-dimensional transform routines may be supplied
 *		with a use buffers flag, which if set will allocate
 *		buffers sufficient to hold copies of the data to
@@ -107,6 +119,68 @@ typedef enum _AlgFourAxis
   ALG_FOUR_AXIS_Z = 2
 } AlgFourAxis;
 
+/*!
+* \def		ALG_FOUR_MAX_RADIX
+* \brief	Maximum prime factor of a transform size which can be
+* 		computed using the mixed radix transform.
+*/
+#define ALG_FOUR_MAX_RADIX	(64)
+
+/*!
+* \def		ALG_FOUR_MAX_FACTORS
+* \brief	Maximum number of factors of a mixed radix transform size.
+*/
+#define ALG_FOUR_MAX_FACTORS	(32)
+
+/*!
+* \struct	_AlgFourPlan
+* \brief	A plan for the mixed radix transform of a given size.
+* 		Plans are created on demand, cached by size and are not
+* 		modified once created so they may be shared between
+* 		threads.
+*/
+typedef struct _AlgFourPlan
+{
+  int		num;			/*!< Transform size. */
+  int		real;			/*!< Non-zero for a real transform
+  					     plan in which case the complex
+					     plan of half the size is used. */
+  int		nFac;			/*!< Number of factors. */
+  int		fac[ALG_FOUR_MAX_FACTORS]; /*!< Factors (radices) of the size
+  					     in the order of the passes. */
+  int		nLdr;			/*!< Number of permutation cycle
+  					     leaders. */
+  int		*ldr;			/*!< Permutation cycle leaders. */
+  int		*perm;			/*!< Digit reversal permutation for
+  					     complex plans, NULL for real
+					     plans. */
+  double	*cosT;			/*!< Cosine table cos(2 pi k / num)
+  					     with num entries for complex
+					     plans and num / 2 for real
+					     plans. */
+  double	*sinT;			/*!< Sine table as for cosT. */
+  struct _AlgFourPlan *cPlan;		/*!< Complex plan used by real
+  					     plans, of size num / 2 for even
+					     sizes and num for odd sizes. */
+  struct _AlgFourPlan *bPlan;		/*!< Power of two complex plan used
+  					     by complex plans of sizes with
+					     a prime factor greater than
+					     ALG_FOUR_MAX_RADIX, which are
+					     computed using Bluestein's
+					     algorithm, otherwise NULL. */
+  double	*chR;			/*!< Bluestein chirp
+  					     exp(-i pi k^2 / num), real
+					     part. */
+  double	*chI;			/*!< Bluestein chirp, imaginary
+  					     part. */
+  double	*bR;			/*!< Transform of the conjugate
+  					     chirp, scaled by the reciprocal
+					     of the bPlan size, real part. */
+  double	*bI;			/*!< Transform of the conjugate
+  					     chirp, imaginary part. */
+  struct _AlgFourPlan *next;		/*!< Next plan in the cache. */
+} AlgFourPlan;
+
 static AlgError			AlgFourRepXY1D(
 				  double **real,
 				  double **imag,
@@ -139,6 +213,95 @@ static AlgError			AlgFourRepXYZReal1D(
 				  int numY,
 				  int numZ,
 				  AlgFourDir dir);
+static int			AlgFourMRFactor(
+				  int num,
+				  int *fac);
+static int			AlgFourMRPermIdx(
+				  AlgFourPlan *plan,
+				  int idx,
+				  int inv);
+static void			AlgFourMRPermute(
+				  AlgFourPlan *plan,
+				  double *data,
+				  int step,
+				  int inv);
+static void			AlgFourMRComplex(
+				  AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int step);
+static void			AlgFourMRTransform(
+				  AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int step,
+				  double *wrk);
+static void			AlgFourMRBluestein(
+				  AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int step,
+				  double *wrk);
+static void			AlgFourMRReal(
+				  AlgFourPlan *plan,
+				  double *data,
+				  int step,
+				  double *wrk);
+static void			AlgFourMRRealInv(
+				  AlgFourPlan *plan,
+				  double *data,
+				  int step,
+				  double *wrk);
+static void			AlgFourMRRealOdd(
+				  AlgFourPlan *plan,
+				  double *data,
+				  int step,
+				  double *wrk,
+				  AlgFourDir dir);
+static void			AlgFourMRFreePlan(
+				  AlgFourPlan *plan);
+static AlgFourPlan		*AlgFourMRMakePlan(
+				  int num,
+				  int real,
+				  AlgError *dstErr);
+static AlgError			AlgFourMRMakeBluestein(
+				  AlgFourPlan *plan);
+static AlgFourPlan		*AlgFourMRGetPlan(
+				  int num,
+				  int real,
+				  AlgError *dstErr);
+static AlgError			AlgFourMRCheckSize(
+				  int num,
+				  int real);
+static int			AlgFourMRWrkSz(
+				  AlgFourPlan *plan);
+static AlgError			AlgFourMR1D(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step,
+				  AlgFourDir dir);
+static void			AlgFourPlan1D(
+				  AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step,
+				  AlgFourDir dir,
+				  double *wrk);
+static AlgError			AlgFourRepPlans(
+				  int num,
+				  int cpx,
+				  int real,
+				  AlgFourPlan **dstCPlan,
+				  AlgFourPlan **dstRPlan,
+				  double **dstWrk,
+				  int *dstWrkSz);
+static double			*AlgFourThrWrk(
+				  double *wrk,
+				  int wrkSz);
+
+static AlgFourPlan		*algFourPlanCache = NULL;
 
 /*!
 * \return	void
@@ -759,7 +922,8 @@ AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
 }
 
 /*!
-* \return	void
+* \return	Error code, may be set if the workspace for a size
+* 		with a large prime factor can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given one
 *		dimensional complex data, and does it in place.
@@ -771,7 +935,7 @@ AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFour1D(double *real, double *imag, int num, int step)
+AlgError	AlgFour1DErr(double *real, double *imag, int num, int step)
 {
   double	tD0,
 		tD1,
@@ -783,58 +947,85 @@ void		AlgFour1D(double *real, double *imag, int num, int step)
 		*tIp0,
 		*tIp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFour1D FE %p %p %d %d\n",
+	  ("AlgFour1DErr FE %p %p %d %d\n",
 	   real, imag, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
-  {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 + tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 - tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 - tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 + tD2) * 0.5;
-    tIp1 -= step;
+  if(!AlgBitIsPowerOfTwo(num))
+  {
+    errNum = AlgFourMR1D(real, imag, num, step, ALG_FOUR_DIR_FWD);
   }
+  else
+  {
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
+    {
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 + tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 - tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 - tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 + tD2) * 0.5;
+      tIp1 -= step;
+    }
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+        AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(imag, num, step);
+      {
+        AlgFourHart1D(imag, num, step);
+      }
     }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFour1D FX\n"));
+	  ("AlgFour1DErr FX\n"));
+  return(errNum);
 }
 
 /*!
 * \return	void
 * \ingroup   	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex data, and does it in place.
+*		See AlgFour1DErr().
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+*/
+void		AlgFour1D(double *real, double *imag, int num, int step)
+{
+  (void )AlgFour1DErr(real, imag, num, step);
+}
+
+/*!
+* \return	Error code, may be set if the workspace for a size
+* 		with a large prime factor can not be allocated.
+* \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given
 *		complex one dimensional data, and does it in place.
 *		The transformed values data are scaled by a factor
@@ -845,7 +1036,7 @@ void		AlgFour1D(double *real, double *imag, int num, int step)
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourInv1D(double *real, double *imag, int num, int step)
+AlgError	AlgFourInv1DErr(double *real, double *imag, int num, int step)
 {
   double	tD0,
 		tD1,
@@ -857,59 +1048,86 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 		*tIp0,
 		*tIp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourInv1D FE %p %p %d %d\n",
+	  ("AlgFourInv1DErr FE %p %p %d %d\n",
 	   real, imag, num, step));
+  if(!AlgBitIsPowerOfTwo(num))
+  {
+    errNum = AlgFourMR1D(real, imag, num, step, ALG_FOUR_DIR_INV);
+  }
+  else
+  {
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+        AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
+      {
+        AlgFourHart1D(imag, num, step);
+      }
+    }
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
     {
-      AlgFourHart1D(imag, num, step);
-    }
-  }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
-  {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 - tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 + tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 + tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 - tD2) * 0.5;
-    tIp1 -= step;
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 - tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 + tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 + tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 - tD2) * 0.5;
+      tIp1 -= step;
+    }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourInv1D FX\n"));
+	  ("AlgFourInv1DErr FX\n"));
+  return(errNum);
 }
 
 /*!
 * \return	void
 * \ingroup   	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given
+*		complex one dimensional data, and does it in place.
+*		See AlgFourInv1DErr().
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+*/
+void		AlgFourInv1D(double *real, double *imag, int num, int step)
+{
+  (void )AlgFourInv1DErr(real, imag, num, step);
+}
+
+/*!
+* \return	Error code, may be set if the workspace for a size
+* 		with a large prime factor can not be allocated.
+* \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given one
 *		dimensional real data, and does it in place.
 *	 	Data are returned in the array of size \f$N\f$ as:
@@ -926,7 +1144,9 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 		| ...      |
 		| i(M - 1) |
 *		where the real and imaginary components are indexed as in
-*		the arrays computed with AlgFour1D().
+*		the arrays computed with AlgFour1D(). For odd sizes, with
+*		2M + 1 = N, there is no rM term and the data are returned
+*		as r0, r1, ..., rM, i1, ..., iM.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
 * \param	real			Given real data.
@@ -934,50 +1154,76 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourReal1D(double *real, int num, int step)
+AlgError	AlgFourReal1DErr(double *real, int num, int step)
 {
   double	tD0,
 		tD1;
   double	*tRp0,
 		*tRp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourReal1D FE %p %d %d\n",
+	  ("AlgFourReal1DErr FE %p %d %d\n",
 	   real, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  AlgFourHart1D(real, num, step);
-  while(--count > 0)
-  {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1) * 0.5;
-    *tRp1 = (tD0 - tD1) * 0.5;
-    tRp0 += step;
-    tRp1 -= step;
-  }
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
-  {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
+  if(!AlgBitIsPowerOfTwo(num))
+  {
+    errNum = AlgFourMR1D(real, NULL, num, step, ALG_FOUR_DIR_FWD);
+  }
+  else
+  {
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    count = num / 2;
+    AlgFourHart1D(real, num, step);
+    while(--count > 0)
+    {
+      tD0 = *tRp0;
+      tD1 = *tRp1;
+      *tRp0 = (tD0 + tD1) * 0.5;
+      *tRp1 = (tD0 - tD1) * 0.5;
+      tRp0 += step;
+      tRp1 -= step;
+    }
+    count = (num / 2);
+    tRp0 = real + ((count + 1) * step);
+    tRp1 = real + ((num - 1) * step);
+    while(count > 0)
+    {
+      tD0 = -(*tRp0);
+      tD1 = -(*tRp1);
+      *tRp0 = tD1;
+      *tRp1 = tD0;
+      tRp0 += step;
+      tRp1 -= step;
+      count -= 2;
+    }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourReal1D FX\n"));
+	  ("AlgFourReal1DErr FX\n"));
+  return(errNum);
 }
 
 /*!
 * \return	void
 * \ingroup   	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional real data, and does it in place.
+*		See AlgFourReal1DErr().
+* \param	real			Given real data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+*/
+void		AlgFourReal1D(double *real, int num, int step)
+{
+  (void )AlgFourReal1DErr(real, num, step);
+}
+
+/*!
+* \return	Error code, may be set if the workspace for a size
+* 		with a large prime factor can not be allocated.
+* \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given one
 *		one dimensional real data, and does it in place.
 *		The data should layed out in the array as returned by
@@ -989,49 +1235,75 @@ void		AlgFourReal1D(double *real, int num, int step)
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourRealInv1D(double *real, int num, int step)
+AlgError	AlgFourRealInv1DErr(double *real, int num, int step)
 {
   double	tD0,
 		tD1;
   double	*tRp0,
 		*tRp1;
   int		count;
+  AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourRealInv1D FE %p %d %d\n",
+	  ("AlgFourRealInv1DErr FE %p %d %d\n",
 	   real, num, step));
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
-  {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
-  }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  while(--count > 0)
-  {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1);
-    *tRp1 = (tD0 - tD1);
-    tRp0 += step;
-    tRp1 -= step;
-  }
-  AlgFourHart1D(real, num, step);
+  if(!AlgBitIsPowerOfTwo(num))
+  {
+    errNum = AlgFourMR1D(real, NULL, num, step, ALG_FOUR_DIR_INV);
+  }
+  else
+  {
+    count = (num / 2);
+    tRp0 = real + ((count + 1) * step);
+    tRp1 = real + ((num - 1) * step);
+    while(count > 0)
+    {
+      tD0 = -(*tRp0);
+      tD1 = -(*tRp1);
+      *tRp0 = tD1;
+      *tRp1 = tD0;
+      tRp0 += step;
+      tRp1 -= step;
+      count -= 2;
+    }
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    count = num / 2;
+    while(--count > 0)
+    {
+      tD0 = *tRp0;
+      tD1 = *tRp1;
+      *tRp0 = (tD0 + tD1);
+      *tRp1 = (tD0 - tD1);
+      tRp0 += step;
+      tRp1 -= step;
+    }
+    AlgFourHart1D(real, num, step);
+  }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
-	  ("AlgFourRealInv1D FX\n"));
+	  ("AlgFourRealInv1DErr FX\n"));
+  return(errNum);
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given one
+*		one dimensional real data, and does it in place.
+*		See AlgFourRealInv1DErr().
+* \param	real			Given real/complex data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+*/
+void		AlgFourRealInv1D(double *real, int num, int step)
+{
+  (void )AlgFourRealInv1DErr(real, num, step);
+}
+
+/*!
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
 *		dimensional complex data, and does it in place.
@@ -1052,8 +1324,16 @@ AlgError	AlgFour2D(double **real, double **imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                          numX, numY, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMRCheckSize(numX, 0);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
+                            numX, numY, ALG_FOUR_DIR_FWD);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
@@ -1065,7 +1345,8 @@ AlgError	AlgFour2D(double **real, double **imag,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given two
 *		dimensional complex data, and does it in place.
@@ -1086,8 +1367,16 @@ AlgError	AlgFourInv2D(double **real, double **imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                          numX, numY, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMRCheckSize(numX, 0);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
+                            numX, numY, ALG_FOUR_DIR_INV);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
@@ -1099,7 +1388,8 @@ AlgError	AlgFourInv2D(double **real, double **imag,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
 *		dimensional real data, and does it in place.
@@ -1150,8 +1440,16 @@ AlgError	AlgFourReal2D(double **real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-                              ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMRCheckSize(numX, 1);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
+                                ALG_FOUR_DIR_FWD);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
@@ -1163,7 +1461,8 @@ AlgError	AlgFourReal2D(double **real,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
 *		dimensional data which resulted from a transform using
@@ -1183,8 +1482,16 @@ AlgError	AlgFourRealInv2D(double **real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-                              ALG_FOUR_DIR_INV);
+  errNum = AlgFourMRCheckSize(numX, 1);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
+                                ALG_FOUR_DIR_INV);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
@@ -1196,7 +1503,8 @@ AlgError	AlgFourRealInv2D(double **real,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
 *		dimensional complex data, and does it in place.
@@ -1222,8 +1530,20 @@ AlgError	AlgFour3D(double ***real, double ***imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                           numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMRCheckSize(numX, 0);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numZ, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
+                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
@@ -1240,7 +1560,8 @@ AlgError	AlgFour3D(double ***real, double ***imag,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given three
 *		dimensional complex data, and does it in place.
@@ -1262,8 +1583,20 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                          numX, numY, numZ, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMRCheckSize(numX, 0);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numZ, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
+                            numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
@@ -1280,7 +1613,8 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
 *		dimensional real data, and does it in place.
@@ -1304,8 +1638,20 @@ AlgError	AlgFourReal3D(double ***real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourMRCheckSize(numX, 1);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numZ, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
+                                 numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
@@ -1322,7 +1668,8 @@ AlgError	AlgFourReal3D(double ***real,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
+* \return	Error code, may be set if buffers can not be allocated
+* 		or a size is not supported.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
 *		dimensional data which resulted from a transform using
@@ -1343,8 +1690,20 @@ AlgError	AlgFourRealInv3D(double ***real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_INV);
+  errNum = AlgFourMRCheckSize(numX, 1);
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numY, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourMRCheckSize(numZ, 1);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
+                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
+  }
   if(errNum == ALG_ERR_NONE)
   {
     errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
@@ -1360,6 +1719,79 @@ AlgError	AlgFourRealInv3D(double ***real,
   return(errNum);
 }
 
+/*!
+* \return	Transform size.
+* \ingroup   	AlgFourier
+* \brief	Computes the smallest transform size which is greater
+* 		than or equal to the given size and has no prime factors
+* 		other than 2, 3, 5 and 7. These sizes are efficiently
+* 		computed by the mixed radix transform and are usually much
+* 		closer to the given size than the next power of two.
+* \param	num			Given size.
+* \param	even			If non-zero the size will be even,
+* 					as required for real transforms.
+*/
+int		AlgFourNextSize(int num, int even)
+{
+  int		sz;
+
+  sz = (num < 1)? 1: num;
+  while(1)
+  {
+    int		rem;
+
+    rem = sz;
+    while((rem % 2) == 0)
+    {
+      rem /= 2;
+    }
+    while((rem % 3) == 0)
+    {
+      rem /= 3;
+    }
+    while((rem % 5) == 0)
+    {
+      rem /= 5;
+    }
+    while((rem % 7) == 0)
+    {
+      rem /= 7;
+    }
+    if((rem == 1) && ((even == 0) || ((sz & 1) == 0)))
+    {
+      break;
+    }
+    ++sz;
+  }
+  return(sz);
+}
+
+/*!
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Frees all the cached mixed radix transform plans. Plans
+* 		are created as required by the transform functions and
+* 		kept for reuse, this function need only be called to
+* 		release their memory, it must not be called while any
+* 		transform is being computed.
+*/
+void		AlgFourFreePlans(void)
+{
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlan)
+#endif
+  {
+    while(algFourPlanCache != NULL)
+    {
+      AlgFourPlan *p;
+
+      p = algFourPlanCache;
+      algFourPlanCache = p->next;
+      AlgFourMRFreePlan(p);
+    }
+  }
+}
+
 /*!
 * \return	Error code, may be set if buffers can not be allocated.
 * \brief	Computes repeated Fourier transforms of a 1D complex
@@ -1379,11 +1811,17 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 			       AlgFourAxis axis, int useBuf,
 			       int numX, int numY, AlgFourDir dir)
 {
+  int		wrkSz = 0;
+  double	*wrk = NULL;
+  AlgFourPlan	*cPl = NULL,
+  		*rPl = NULL;
   AlgError	errNum = ALG_ERR_NONE;
 
-  if(axis == ALG_FOUR_AXIS_X)                              /* Transform rows */
+  errNum = AlgFourRepPlans((axis == ALG_FOUR_AXIS_X)? numX: numY, 1, 0,
+			   &cPl, &rPl, &wrk, &wrkSz);
+  if(errNum == ALG_ERR_NONE)
   {
-    if(dir == ALG_FOUR_DIR_FWD)
+    if(axis == ALG_FOUR_AXIS_X)                            /* Transform rows */
     {
       int	idY;
 
@@ -1392,112 +1830,84 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 #endif
       for(idY = 0; idY < numY; ++idY)
       {
-	AlgFour1D(*(real + idY), *(imag + idY), numX, 1);
+	AlgFourPlan1D(cPl, *(real + idY), *(imag + idY), numX, 1, dir,
+	    AlgFourThrWrk(wrk, wrkSz));
       }
     }
-    else
+    else /* axis == ALG_FOUR_AXIS_Y */                  /* Transform columns */
     {
-      int	idY;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourInv1D(*(real + idY), *(imag + idY), numX, 1);
-      }
-    }
-  }
-  else /* axis == ALG_FOUR_AXIS_Y */                    /* Transform columns */
-  {
-    if(useBuf)	                           /* Use column buffers if provided */
-    {
-      int	nThr = 1;
-      double	*bufBase = NULL;
+      if(useBuf)	                         /* Use column buffers if provided */
+      {
+	int	nThr = 1;
+	double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-      {
+	{
 #pragma omp master
-        {
-	  nThr = omp_get_num_threads();
+	  {
+	    nThr = omp_get_num_threads();
+	  }
 	}
-      }
 #endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-      {
-	errNum = ALG_ERR_MALLOC;
-      }
-      if(errNum == ALG_ERR_NONE)
-      {
-        int	idX;
+	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	{
+	  errNum = ALG_ERR_MALLOC;
+	}
+	if(errNum == ALG_ERR_NONE)
+	{
+	  int	idX;
 
 #ifdef _OPENMP
 #pragma omp parallel for private(idX) num_threads(nThr)
 #endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  int	  idY,
-	  	  thrId = 0;
-	  double  *reBuf,
-		  *imBuf;
+	  for(idX = 0; idX < numX; ++idX)
+	  {
+	    int	  idY,
+		  thrId = 0;
+	    double  *reBuf,
+		    *imBuf;
 
 #ifdef _OPENMP
-	  thrId = omp_get_thread_num();
+	    thrId = omp_get_thread_num();
 #endif
-	  reBuf = bufBase + (2 * numY * thrId);
-	  imBuf = reBuf + numY;
-	  /* Copy to buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(reBuf + idY) = *(*(real + idY) + idX);
-	    *(imBuf + idY) = *(*(imag + idY) + idX);
-	  }
-	  /* Transform buffer. */
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(reBuf, imBuf, numY, 1);
-	  }
-	  else
-	  {
-	    AlgFourInv1D(reBuf, imBuf, numY, 1);
-	  }
-	  /* Copy back from buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(*(real + idY) + idX) = *(reBuf + idY);
-	    *(*(imag + idY) + idX) = *(imBuf + idY);
+	    reBuf = bufBase + (2 * numY * thrId);
+	    imBuf = reBuf + numY;
+	    /* Copy to buffer. */
+	    for(idY = 0; idY < numY; ++idY)
+	    {
+	      *(reBuf + idY) = *(*(real + idY) + idX);
+	      *(imBuf + idY) = *(*(imag + idY) + idX);
+	    }
+	    /* Transform buffer. */
+	    AlgFourPlan1D(cPl, reBuf, imBuf, numY, 1, dir,
+		AlgFourThrWrk(wrk, wrkSz));
+	    /* Copy back from buffer. */
+	    for(idY = 0; idY < numY; ++idY)
+	    {
+	      *(*(real + idY) + idX) = *(reBuf + idY);
+	      *(*(imag + idY) + idX) = *(imBuf + idY);
+	    }
 	  }
+	  AlcFree(bufBase);
 	}
-	AlcFree(bufBase);
       }
-    }
-    else              /* If no column buffers transform the columns in place */
-    {
-      int	idX;
-
-      if(dir == ALG_FOUR_DIR_FWD)
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  AlgFour1D(*real + idX, *imag + idX, numY, numX);
-        }
-      }
-      else
+      else            /* If no column buffers transform the columns in place */
       {
+	int	idX;
+
 #ifdef _OPENMP
 #pragma omp parallel for private(idX)
 #endif
 	for(idX = 0; idX < numX; ++idX)
 	{
-	  AlgFourInv1D(*real + idX, *imag + idX, numY, numX);
-        }
+	  AlgFourPlan1D(cPl, *real + idX, *imag + idX, numY, numX, dir,
+	      AlgFourThrWrk(wrk, wrkSz));
+	}
       }
     }
   }
+  AlcFree(wrk);
   return(errNum);
 }
 
@@ -1521,210 +1931,152 @@ static AlgError	AlgFourRepXY1D(double **real, double **imag,
 static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 				   int numX, int numY, AlgFourDir dir)
 {
+  int		wrkSz = 0;
+  double	*wrk = NULL;
+  AlgFourPlan	*cPl = NULL,
+  		*rPl = NULL;
   AlgError	errNum = ALG_ERR_NONE;
 
-  if(axis == ALG_FOUR_AXIS_X)			 	   /* Transform rows */
+  errNum = AlgFourRepPlans((axis == ALG_FOUR_AXIS_X)? numX: numY,
+			   axis != ALG_FOUR_AXIS_X, 1,
+			   &cPl, &rPl, &wrk, &wrkSz);
+  if(errNum == ALG_ERR_NONE)
   {
-    if(dir == ALG_FOUR_DIR_FWD)
+    if(axis == ALG_FOUR_AXIS_X)			 	   /* Transform rows */
     {
-      int 	idY;
+      int	idY;
 
 #ifdef _OPENMP
 #pragma omp parallel for private(idY)
 #endif
       for(idY = 0; idY < numY; ++idY)
       {
-	AlgFourReal1D(*(data + idY), numX, 1);
+	AlgFourPlan1D(rPl, *(data + idY), NULL, numX, 1, dir,
+	    AlgFourThrWrk(wrk, wrkSz));
       }
     }
-    else
+    else /* axis == ALG_FOUR_AXIS_Y */			/* Transform columns */
     {
-      int	idY;
+      int		halfData;
 
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
+      halfData = numX / 2;
+      if(useBuf)
       {
-	AlgFourRealInv1D(*(data + idY), numX, 1);
-      }
-    }
-  }
-  else /* axis == ALG_FOUR_AXIS_Y */			/* Transform columns */
-  {
-    int		halfData;
-
-    halfData = numX / 2;
-    if(useBuf)
-    {
-      int	nThr = 1;
-      double	*bufBase = NULL;
+	int	nThr = 1;
+	double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-      {
+	{
 #pragma omp master
-        {
-          nThr = omp_get_num_threads();
+	  {
+	    nThr = omp_get_num_threads();
+	  }
 	}
-      }
 #endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-      {
-	errNum = ALG_ERR_MALLOC;
-      }
-      if(errNum == ALG_ERR_NONE)
-      {
+	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	{
+	  errNum = ALG_ERR_MALLOC;
+	}
+	if(errNum == ALG_ERR_NONE)
+	{
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-	{
+	  {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
+	    {
+	      int	    idY,
+			    thrId = 0;
+	      double  *reBuf;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(data + idY);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(data + idY) = *(reBuf + idY);
+	      reBuf = bufBase + (numY * thrId);
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		*(reBuf + idY) = **(data + idY);
+	      }
+	      AlgFourPlan1D(rPl, reBuf, NULL, numY, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		**(data + idY) = *(reBuf + idY);
+	      }
 	    }
-	  }
 #ifdef _OPENMP
 #pragma omp section
 #endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
+	    {
+	      int	    idY,
+			    thrId = 0;
+	      double  *reBuf;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + halfData) = *(reBuf + idY);
+	      reBuf = bufBase + (numY * thrId);
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		*(reBuf + idY) = *(*(data + idY) + halfData);
+	      }
+	      AlgFourPlan1D(rPl, reBuf, NULL, numY, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		*(*(data + idY) + halfData) = *(reBuf + idY);
+	      }
 	    }
 	  }
-	}
-	{
-	  int	idX;
+	  {
+	    int	idX;
 
 #ifdef _OPENMP
 #pragma omp parallel for private(idX)
 #endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    int	   idY,
-		   thrId = 0;
-	    double *reBuf,
-		   *imBuf;
+	    for(idX = 1; idX < halfData; ++idX)
+	    {
+	      int	   idY,
+			   thrId = 0;
+	      double *reBuf,
+		     *imBuf;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + idX);
-	      *(imBuf + idY) = *(*(data + idY) + halfData + idX);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(reBuf, imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(reBuf, imBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + idX) = *(reBuf + idY);
-	      *(*(data + idY) + halfData + idX) = *(imBuf + idY);
+	      reBuf = bufBase + (2 * numY * thrId);
+	      imBuf = reBuf + numY;
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		*(reBuf + idY) = *(*(data + idY) + idX);
+		*(imBuf + idY) = *(*(data + idY) + halfData + idX);
+	      }
+	      AlgFourPlan1D(cPl, reBuf, imBuf, numY, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      for(idY = 0; idY < numY; ++idY)
+	      {
+		*(*(data + idY) + idX) = *(reBuf + idY);
+		*(*(data + idY) + halfData + idX) = *(imBuf + idY);
+	      }
 	    }
 	  }
 	}
       }
-    }
-    else
-    {
-      /* If no column buffers then just transform the columns in place this
-       * is done by: transforming column 0, transform column numX/2 and then
-       * transforming the remaining columns. */
-      if(dir == ALG_FOUR_DIR_FWD)
+      else
       {
+	/* If no column buffers then just transform the columns in place this
+	 * is done by: transforming column 0, transform column numX/2 and then
+	 * transforming the remaining columns. */
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
 	{
 	  int	idX;
-#ifdef _OPENMP
-#pragma omp sections
-#endif
-	  {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data, numY, numX);
-	    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data + halfData, numY, numX);
-	    }
-	  }
-#ifdef _OPENMP
-#pragma omp for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    AlgFour1D(*data + idX, *data + halfData + idX, numY, numX);
-	  }
-	}
-      }
-      else
-      {
-        int 	idX;
 
 #ifdef _OPENMP
-#pragma omp parallel
-#endif
-	{
-#ifdef _OPENMP
 #pragma omp sections
 #endif
 	  {
@@ -1732,13 +2084,15 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 #pragma omp section
 #endif
 	    {
-	      AlgFourRealInv1D(*data, numY, numX);
+	      AlgFourPlan1D(rPl, *data, NULL, numY, numX, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
 	    }
 #ifdef _OPENMP
 #pragma omp section
 #endif
 	    {
-	      AlgFourRealInv1D(*data + halfData, numY, numX);
+	      AlgFourPlan1D(rPl, *data + halfData, NULL, numY, numX, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
 	    }
 	  }
 #ifdef _OPENMP
@@ -1746,13 +2100,14 @@ static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
 #endif
 	  for(idX = 1; idX < halfData; ++idX)
 	  {
-	    AlgFourInv1D(*data + idX, *data + halfData + idX, numY,
-		numX);
+	    AlgFourPlan1D(cPl, *data + idX, *data + halfData + idX, numY, numX,
+		dir, AlgFourThrWrk(wrk, wrkSz));
 	  }
 	}
       }
     }
   }
+  AlcFree(wrk);
   return(errNum);
 }
 
@@ -1778,211 +2133,186 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 			        int numX, int numY, int numZ, AlgFourDir dir)
 {
   int		idX,
-  		idY,
+		idY,
 		idZ;
+  int		wrkSz = 0;
+  double	*wrk = NULL;
+  AlgFourPlan	*cPl = NULL,
+  		*rPl = NULL;
   AlgError	errNum = ALG_ERR_NONE;
 
-  switch(axis)
+  errNum = AlgFourRepPlans((axis == ALG_FOUR_AXIS_X)? numX:
+			   (axis == ALG_FOUR_AXIS_Y)? numY: numZ, 1, 0,
+			   &cPl, &rPl, &wrk, &wrkSz);
+  if(errNum == ALG_ERR_NONE)
   {
-    case ALG_FOUR_AXIS_X:
-      /* Transform rows */
+    switch(axis)
+    {
+      case ALG_FOUR_AXIS_X:
+	/* Transform rows */
 #ifdef _OPENMP
 #pragma omp parallel for private(idY,idZ)
 #endif
-      for(idZ = 0; idZ < numZ; ++idZ)
-      {
-	for(idY = 0; idY < numY; ++idY)
+	for(idZ = 0; idZ < numZ; ++idZ)
 	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
-	  }
-	  else
+	  for(idY = 0; idY < numY; ++idY)
 	  {
-	    AlgFourInv1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
+	    AlgFourPlan1D(cPl, *(*(real + idZ) + idY), *(*(imag + idZ) + idY),
+		numX, 1, dir, AlgFourThrWrk(wrk, wrkSz));
 	  }
 	}
-      }
-      break;
-    case ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	break;
+      case ALG_FOUR_AXIS_Y:
+	/* Transform columns */
+	if(useBuf)
+	{
+	  int	nThr = 1;
+	  double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-	{
-#pragma omp master
 	  {
-	    nThr = omp_get_num_threads();
+#pragma omp master
+	    {
+	      nThr = omp_get_num_threads();
+	    }
 	  }
-	}
 #endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
+	  if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	  {
+	    errNum = ALG_ERR_MALLOC;
+	  }
+	  if(errNum == ALG_ERR_NONE)
+	  {
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
 #endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
+	    for(idZ = 0; idZ < numZ; ++idZ)
+	    {
+	      int	    thrId = 0;
+	      double  *reBuf,
+		      *imBuf;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idX = 0; idX < numX; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(reBuf + idY) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idY = 0; idY < numY; ++idY)
+	      reBuf = bufBase + (2 * numY * thrId);
+	      imBuf = reBuf + numY;
+	      for(idX = 0; idX < numX; ++idX)
 	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idY);
+		/* Copy to buffer. */
+		for(idY = 0; idY < numY; ++idY)
+		{
+		  *(reBuf + idY) = *(*(*(real + idZ) + idY) + idX);
+		  *(imBuf + idY) = *(*(*(imag + idZ) + idY) + idX);
+		}
+		/* Transform buffer. */
+		AlgFourPlan1D(cPl, reBuf, imBuf, numY, 1, dir,
+		    AlgFourThrWrk(wrk, wrkSz));
+		/* Copy back from buffer. */
+		for(idY = 0; idY < numY; ++idY)
+		{
+		  *(*(*(real + idZ) + idY) + idX) = *(reBuf + idY);
+		  *(*(*(imag + idZ) + idY) + idX) = *(imBuf + idY);
+		}
 	      }
 	    }
+	    AlcFree(bufBase);
 	  }
-	  AlcFree(bufBase);
 	}
-      }
-      else
-      {
+	else
+	{
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  for(idX = 0; idX < numX; ++idX)
+	  for(idZ = 0; idZ < numZ; ++idZ)
 	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
-	    }
-	    else
+	    for(idX = 0; idX < numX; ++idX)
 	    {
-	      AlgFourInv1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
+	      AlgFourPlan1D(cPl, **(real + idZ) + idX, **(imag + idZ) + idX,
+		  numY, numX, dir, AlgFourThrWrk(wrk, wrkSz));
 	    }
 	  }
 	}
-      }
-      break;
-    case ALG_FOUR_AXIS_Z:
-      /* Transform columns */
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	break;
+      case ALG_FOUR_AXIS_Z:
+	/* Transform columns */
+	if(useBuf)
+	{
+	  int	nThr = 1;
+	  double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-	{
-#pragma omp master
 	  {
-	    nThr = omp_get_num_threads();
+#pragma omp master
+	    {
+	      nThr = omp_get_num_threads();
+	    }
 	  }
-	}
 #endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
+	  if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
+	  {
+	    errNum = ALG_ERR_MALLOC;
+	  }
+	  if(errNum == ALG_ERR_NONE)
+	  {
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
 #endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
+	    for(idY = 0; idY < numY; ++idY)
+	    {
+	      int	    thrId = 0;
+	      double  *reBuf,
+		      *imBuf;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    for(idX = 0; idX < numX; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(reBuf + idZ) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idZ) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
+	      reBuf = bufBase + (2 * numZ * thrId);
+	      imBuf = reBuf + numZ;
+	      for(idX = 0; idX < numX; ++idX)
 	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idZ);
+		/* Copy to buffer. */
+		for(idZ = 0; idZ < numZ; ++idZ)
+		{
+		  *(reBuf + idZ) = *(*(*(real + idZ) + idY) + idX);
+		  *(imBuf + idZ) = *(*(*(imag + idZ) + idY) + idX);
+		}
+		/* Transform buffer. */
+		AlgFourPlan1D(cPl, reBuf, imBuf, numZ, 1, dir,
+		    AlgFourThrWrk(wrk, wrkSz));
+		/* Copy back from buffer. */
+		for(idZ = 0; idZ < numZ; ++idZ)
+		{
+		  *(*(*(real + idZ) + idY) + idX) = *(reBuf + idZ);
+		  *(*(*(imag + idZ) + idY) + idX) = *(imBuf + idZ);
+		}
 	      }
 	    }
+	    AlcFree(bufBase);
 	  }
-	  AlcFree(bufBase);
 	}
-      }
-      else
-      {
+	else
+	{
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY)
 #endif
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  for(idX = 0; idX < numX; ++idX)
+	  for(idY = 0; idY < numY; ++idY)
 	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
-	    }
-	    else
+	    for(idX = 0; idX < numX; ++idX)
 	    {
-	      AlgFourInv1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
+	      AlgFourPlan1D(cPl, *(*real + idY) + idX, *(*imag + idY) + idX,
+		  numZ, numX * numY, dir, AlgFourThrWrk(wrk, wrkSz));
 	    }
 	  }
 	}
-      }
-      break;
-    default:
-      break;
+	break;
+      default:
+	break;
+    }
   }
+  AlcFree(wrk);
   return(errNum);
 }
 
@@ -2007,270 +2337,1385 @@ static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
 */
 static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
 				    int useBuf,
-				    int numX, int numY, int numZ,
+					int numX, int numY, int numZ,
 				    AlgFourDir dir)
 {
   int		idX,
 		idY,
 		idZ,
 		halfData;
+  int		wrkSz = 0;
+  double	*wrk = NULL;
+  AlgFourPlan	*cPl = NULL,
+  		*rPl = NULL;
   AlgError	errNum = ALG_ERR_NONE;
 
-  switch(axis)
+  errNum = AlgFourRepPlans((axis == ALG_FOUR_AXIS_X)? numX:
+			   (axis == ALG_FOUR_AXIS_Y)? numY: numZ,
+			   axis != ALG_FOUR_AXIS_X, 1,
+			   &cPl, &rPl, &wrk, &wrkSz);
+  if(errNum == ALG_ERR_NONE)
   {
-    case  ALG_FOUR_AXIS_X:
-      /* Transform rows */
+    switch(axis)
+    {
+      case  ALG_FOUR_AXIS_X:
+	/* Transform rows */
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-      for(idZ = 0; idZ < numZ; ++idZ)
-      {
-	for(idY = 0; idY < numY; ++idY)
+	for(idZ = 0; idZ < numZ; ++idZ)
 	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*(data + idZ) + idY), numX, 1);
-	  }
-	  else
+	  for(idY = 0; idY < numY; ++idY)
 	  {
-	    AlgFourRealInv1D(*(*(data + idZ) + idY), numX, 1);
+	    AlgFourPlan1D(rPl, *(*(data + idZ) + idY), NULL, numX, 1, dir,
+		AlgFourThrWrk(wrk, wrkSz));
 	  }
 	}
-      }
-      break;
-    case  ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      halfData = numY / 2;
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	break;
+      case  ALG_FOUR_AXIS_Y:
+	/* Transform columns, pairing the columns of the row transforms. */
+	halfData = numX / 2;
+	if(useBuf)
+	{
+	  int	nThr = 1;
+	  double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-	{
-#pragma omp master
 	  {
-	    nThr = omp_get_num_threads();
+#pragma omp master
+	    {
+	      nThr = omp_get_num_threads();
+	    }
 	  }
-	}
 #endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
+	  if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	  {
+	    errNum = ALG_ERR_MALLOC;
+	  }
+	  if(errNum == ALG_ERR_NONE)
+	  {
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
+	    for(idZ = 0; idZ < numZ; ++idZ)
+	    {
+	      int	thrId = 0;
+	      double  *reBuf,
+		      *imBuf;
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    /* Copy to buffer. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(*(data + idZ) + idY);
-	      *(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	      AlgFourReal1D(imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	      AlgFourRealInv1D(imBuf, numY, 1);
-	    }
-	    /* Copy back from buffer again. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idY);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idY);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
+	      reBuf = bufBase + (2 * numY * thrId);
+	      imBuf = reBuf + numY;
 	      /* Copy to buffer. */
 	      for(idY = 0; idY < numY; ++idY)
 	      {
-		*(reBuf + idY) = *(*(*(data + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
+		*(reBuf + idY) = **(*(data + idZ) + idY);
+		*(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData);
 	      }
-	      else
+	      AlgFourPlan1D(rPl, reBuf, NULL, numY, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      AlgFourPlan1D(rPl, imBuf, NULL, numY, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      /* Copy back from buffer again. */
+	      for(idY = 0; idY < numY; ++idY)
 	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
+		**(*(data + idZ) + idY) = *(reBuf + idY);
+		*(*(*(data + idZ) + idY) + halfData) = *(imBuf + idY);
 	      }
-	      /* Copy back. */
-	      for(idY = 0; idY < numY; ++idY)
+	      for(idX = 1; idX < halfData; ++idX)
 	      {
-		*(*(*(data + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idY);
+		/* Copy to buffer. */
+		for(idY = 0; idY < numY; ++idY)
+		{
+		  *(reBuf + idY) = *(*(*(data + idZ) + idY) + idX);
+		  *(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData + idX);
+		}
+		AlgFourPlan1D(cPl, reBuf, imBuf, numY, 1, dir,
+		    AlgFourThrWrk(wrk, wrkSz));
+		/* Copy back. */
+		for(idY = 0; idY < numY; ++idY)
+		{
+		  *(*(*(data + idZ) + idY) + idX) = *(reBuf + idY);
+		  *(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idY);
+		}
 	      }
 	    }
+	    AlcFree(bufBase);
 	  }
-	  AlcFree(bufBase);
-        }
-      }
-      else
-      {
+	}
+	else
+	{
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(**(data + idZ), numY, numX);
-	    AlgFourReal1D(**(data + idZ) + halfData, numY, numX);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
-	    }
-	  }
-	  else
+	  for(idZ = 0; idZ < numZ; ++idZ)
 	  {
-	    AlgFourRealInv1D(**(data + idZ), numY, numX);
-	    AlgFourRealInv1D(**(data + idZ) + halfData, numY, numX);
+	    AlgFourPlan1D(rPl, **(data + idZ), NULL, numY, numX, dir,
+		AlgFourThrWrk(wrk, wrkSz));
+	    AlgFourPlan1D(rPl, **(data + idZ) + halfData, NULL, numY, numX, dir,
+		AlgFourThrWrk(wrk, wrkSz));
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFourInv1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
+	      AlgFourPlan1D(cPl, **(data + idZ) + idX,
+		  **(data + idZ) + halfData + idX, numY, numX, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
 	    }
 	  }
 	}
-      }
-      break;
-    case  ALG_FOUR_AXIS_Z:
-      /* Transform planes */
-      halfData = numX / 2;
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	break;
+      case  ALG_FOUR_AXIS_Z:
+	/* Transform planes */
+	halfData = numX / 2;
+	if(useBuf)
+	{
+	  int	nThr = 1;
+	  double	*bufBase = NULL;
 
 #ifdef _OPENMP
 #pragma omp parallel
-	{
-#pragma omp master
 	  {
-	    nThr = omp_get_num_threads();
+#pragma omp master
+	    {
+	      nThr = omp_get_num_threads();
+	    }
 	  }
-	}
 #endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
+	  if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
+	  {
+	    errNum = ALG_ERR_MALLOC;
+	  }
+	  if(errNum == ALG_ERR_NONE)
+	  {
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
+	    for(idY = 0; idY < numY; ++idY)
+	    {
+	      int	thrId = 0;
+	      double  *reBuf,
+		      *imBuf;
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+	      thrId = omp_get_thread_num();
 #endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    /* Copy to buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      *(reBuf + idZ) = **(*(data + idZ) + idY);
-	      *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numZ, 1);
-	      AlgFourReal1D(imBuf, numZ, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numZ, 1);
-	      AlgFourRealInv1D(imBuf, numZ, 1);
-	    }
-	    /* Copy back from buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idZ);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idZ);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
+	      reBuf = bufBase + (2 * numZ * thrId);
+	      imBuf = reBuf + numZ;
 	      /* Copy to buffer. */
 	      for(idZ = 0; idZ < numZ; ++idZ)
 	      {
-	        *(reBuf + idZ) = *(*(*(data + idZ) + idY) + idX);
-	        *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
+		*(reBuf + idZ) = **(*(data + idZ) + idY);
+		*(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData);
 	      }
+	      AlgFourPlan1D(rPl, reBuf, NULL, numZ, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
+	      AlgFourPlan1D(rPl, imBuf, NULL, numZ, 1, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
 	      /* Copy back from buffer. */
 	      for(idZ = 0; idZ < numZ; ++idZ)
 	      {
-	        *(*(*(data + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idZ);
+		**(*(data + idZ) + idY) = *(reBuf + idZ);
+		*(*(*(data + idZ) + idY) + halfData) = *(imBuf + idZ);
+	      }
+	      for(idX = 1; idX < halfData; ++idX)
+	      {
+		/* Copy to buffer. */
+		for(idZ = 0; idZ < numZ; ++idZ)
+		{
+		  *(reBuf + idZ) = *(*(*(data + idZ) + idY) + idX);
+		  *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData + idX);
+		}
+		AlgFourPlan1D(cPl, reBuf, imBuf, numZ, 1, dir,
+		    AlgFourThrWrk(wrk, wrkSz));
+		/* Copy back from buffer. */
+		for(idZ = 0; idZ < numZ; ++idZ)
+		{
+		  *(*(*(data + idZ) + idY) + idX) = *(reBuf + idZ);
+		  *(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idZ);
+		}
 	      }
-	    }
 
+	    }
+	    AlcFree(bufBase);
 	  }
-	  AlcFree(bufBase);
 	}
-      }
-      else
-      {
+	else
+	{
 #ifdef _OPENMP
 #pragma omp parallel for private(idX,idY,idZ)
 #endif
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourReal1D(*(*data + idY) + halfData, numZ, numX * numY);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
-	    }
-	  }
-	  else
+	  for(idY = 0; idY < numY; ++idY)
 	  {
-	    AlgFourRealInv1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourRealInv1D(*(*data + idY) + halfData, numZ, numX * numY);
+	    AlgFourPlan1D(rPl, *(*data + idY), NULL, numZ, numX * numY, dir,
+		AlgFourThrWrk(wrk, wrkSz));
+	    AlgFourPlan1D(rPl, *(*data + idY) + halfData, NULL, numZ,
+		numX * numY, dir, AlgFourThrWrk(wrk, wrkSz));
 	    for(idX = 1; idX < halfData; ++idX)
 	    {
-	      AlgFourInv1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
+	      AlgFourPlan1D(cPl, *(*data + idY) + idX,
+		  *(*data + idY) + halfData + idX, numZ, numX * numY, dir,
+		  AlgFourThrWrk(wrk, wrkSz));
 	    }
 	  }
 	}
-      }
-      break;
-    default:
-      break;
+	break;
+      default:
+	break;
+    }
   }
+  AlcFree(wrk);
   return(errNum);
 }
+
+/*!
+* \return	Number of factors or zero if the size has a prime factor
+* 		greater than ALG_FOUR_MAX_RADIX.
+* \brief	Factors the given transform size into radices for the
+* 		mixed radix transform. Factors of four are preferred,
+* 		followed by factors of two, three, five, seven and then
+* 		any other primes.
+* \param	num			Transform size.
+* \param	fac			Array for at least ALG_FOUR_MAX_FACTORS
+* 					factors.
+*/
+static int	AlgFourMRFactor(int num, int *fac)
+{
+  int		nFac = 0,
+  		rdx = 4;
+
+  while((num > 1) && (nFac < ALG_FOUR_MAX_FACTORS))
+  {
+    if((num % rdx) == 0)
+    {
+      fac[nFac++] = rdx;
+      num /= rdx;
+    }
+    else
+    {
+      switch(rdx)
+      {
+        case 4:
+	  rdx = 2;
+	  break;
+        case 2:
+	  rdx = 3;
+	  break;
+	default:
+	  rdx += 2;
+	  break;
+      }
+      if(rdx > ALG_FOUR_MAX_RADIX)
+      {
+        break;
+      }
+    }
+  }
+  if(num > 1)
+  {
+    nFac = 0;
+  }
+  return(nFac);
+}
+
+/*!
+* \return	Index of the destination of the given index.
+* \brief	Computes the permutation of an index for the given plan.
+* 		For complex plans this is the mixed radix digit reversal
+* 		permutation. For real plans this is the permutation from
+* 		interleaved complex values (\f$X_0, X_M, \Re X_1, \Im X_1,
+* 		\ldots\f$) to the layout of AlgFourReal1D() or, if inv is
+* 		set, the inverse of this permutation.
+* \param	plan			Given plan.
+* \param	idx			Given index.
+* \param	inv			Inverse permutation if non-zero,
+* 					only used for real plans.
+*/
+static int	AlgFourMRPermIdx(AlgFourPlan *plan, int idx, int inv)
+{
+  int		half;
+
+  if(plan->real == 0)
+  {
+    idx = plan->perm[idx];
+  }
+  else
+  {
+    half = plan->num / 2;
+    if(inv)
+    {
+      if(idx > 0)
+      {
+	idx = (idx < half)? 2 * idx:
+	      (idx == half)? 1: (2 * (idx - half)) + 1;
+      }
+    }
+    else
+    {
+      if(idx > 0)
+      {
+	idx = (idx == 1)? half:
+	      ((idx & 1) == 0)? idx / 2: half + (idx / 2);
+      }
+    }
+  }
+  return(idx);
+}
+
+/*!
+* \return	void
+* \brief	Permutes the data in place by following the cycles of
+* 		the plan's permutation.
+* \param	plan			Given plan.
+* \param	data			Data to permute.
+* \param	step			Offset in data elements between
+*					the data to be permuted.
+* \param	inv			Inverse permutation if non-zero,
+* 					only used for real plans.
+*/
+static void	AlgFourMRPermute(AlgFourPlan *plan, double *data, int step,
+				 int inv)
+{
+  int		idL,
+  		idx,
+		ldr;
+  double	cur,
+  		tmp;
+
+  for(idL = 0; idL < plan->nLdr; ++idL)
+  {
+    ldr = plan->ldr[idL];
+    cur = data[ldr * step];
+    idx = AlgFourMRPermIdx(plan, ldr, inv);
+    while(idx != ldr)
+    {
+      tmp = data[idx * step];
+      data[idx * step] = cur;
+      cur = tmp;
+      idx = AlgFourMRPermIdx(plan, idx, inv);
+    }
+    data[ldr * step] = cur;
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward, unscaled, mixed radix decimation in
+* 		time Fourier transform of the given complex data in place.
+* 		The inverse transform may be computed by swapping the
+* 		real and imaginary data. The plan's size must not have a
+* 		prime factor greater than ALG_FOUR_MAX_RADIX, see
+* 		AlgFourMRTransform().
+* \param	plan			Complex plan for the transform size.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+*/
+static void	AlgFourMRComplex(AlgFourPlan *plan, double *real, double *imag,
+				 int step)
+{
+  int		idF,
+		idJ,
+		idK,
+		idQ,
+		idB,
+		rdx,
+		len = 1,
+		span,
+		tStp;
+  double	wR[ALG_FOUR_MAX_RADIX],
+  		wI[ALG_FOUR_MAX_RADIX],
+		aR[ALG_FOUR_MAX_RADIX],
+		aI[ALG_FOUR_MAX_RADIX];
+  const double	s3 = 0.86602540378443864676,
+  		c51 = 0.30901699437494742410,
+		c52 = -0.80901699437494742410,
+		s51 = 0.95105651629515357212,
+		s52 = 0.58778525229247312917;
+
+  AlgFourMRPermute(plan, real, step, 0);
+  AlgFourMRPermute(plan, imag, step, 0);
+  for(idF = 0; idF < plan->nFac; ++idF)
+  {
+    rdx = plan->fac[idF];
+    span = len * rdx;
+    tStp = plan->num / span;
+    for(idJ = 0; idJ < len; ++idJ)
+    {
+      /* Twiddle factors for this offset within the sub transforms. */
+      for(idK = 0; idK < rdx; ++idK)
+      {
+        int	tIdx;
+
+	tIdx = (idJ * idK * tStp) % plan->num;
+	wR[idK] = plan->cosT[tIdx];
+	wI[idK] = -(plan->sinT[tIdx]);
+      }
+      for(idB = idJ; idB < plan->num; idB += span)
+      {
+	double	*pR,
+		*pI;
+
+	pR = real + (idB * step);
+	pI = imag + (idB * step);
+	/* Gather the twiddled inputs of the butterfly. */
+	aR[0] = pR[0];
+	aI[0] = pI[0];
+	for(idK = 1; idK < rdx; ++idK)
+	{
+	  double tR,
+	  	 tI;
+
+	  tR = pR[idK * len * step];
+	  tI = pI[idK * len * step];
+	  if(idJ == 0)
+	  {
+	    aR[idK] = tR;
+	    aI[idK] = tI;
+	  }
+	  else
+	  {
+	    aR[idK] = (tR * wR[idK]) - (tI * wI[idK]);
+	    aI[idK] = (tR * wI[idK]) + (tI * wR[idK]);
+	  }
+	}
+	/* Butterfly. */
+	switch(rdx)
+	{
+	  case 2:
+	    pR[0] = aR[0] + aR[1];
+	    pI[0] = aI[0] + aI[1];
+	    pR[len * step] = aR[0] - aR[1];
+	    pI[len * step] = aI[0] - aI[1];
+	    break;
+	  case 3:
+	    {
+	      double tR, tI, mR, mI, dR, dI;
+
+	      tR = aR[1] + aR[2];
+	      tI = aI[1] + aI[2];
+	      mR = aR[0] - (0.5 * tR);
+	      mI = aI[0] - (0.5 * tI);
+	      dR = s3 * (aR[1] - aR[2]);
+	      dI = s3 * (aI[1] - aI[2]);
+	      pR[0] = aR[0] + tR;
+	      pI[0] = aI[0] + tI;
+	      pR[len * step] = mR + dI;
+	      pI[len * step] = mI - dR;
+	      pR[2 * len * step] = mR - dI;
+	      pI[2 * len * step] = mI + dR;
+	    }
+	    break;
+	  case 4:
+	    {
+	      double t0R, t0I, t1R, t1I, t2R, t2I, t3R, t3I;
+
+	      t0R = aR[0] + aR[2];
+	      t0I = aI[0] + aI[2];
+	      t1R = aR[0] - aR[2];
+	      t1I = aI[0] - aI[2];
+	      t2R = aR[1] + aR[3];
+	      t2I = aI[1] + aI[3];
+	      t3R = aR[1] - aR[3];
+	      t3I = aI[1] - aI[3];
+	      pR[0] = t0R + t2R;
+	      pI[0] = t0I + t2I;
+	      pR[len * step] = t1R + t3I;
+	      pI[len * step] = t1I - t3R;
+	      pR[2 * len * step] = t0R - t2R;
+	      pI[2 * len * step] = t0I - t2I;
+	      pR[3 * len * step] = t1R - t3I;
+	      pI[3 * len * step] = t1I + t3R;
+	    }
+	    break;
+	  case 5:
+	    {
+	      double t1R, t1I, t2R, t2I, d1R, d1I, d2R, d2I,
+	      	     b1R, b1I, b2R, b2I, e1R, e1I, e2R, e2I;
+
+	      t1R = aR[1] + aR[4];
+	      t1I = aI[1] + aI[4];
+	      t2R = aR[2] + aR[3];
+	      t2I = aI[2] + aI[3];
+	      d1R = aR[1] - aR[4];
+	      d1I = aI[1] - aI[4];
+	      d2R = aR[2] - aR[3];
+	      d2I = aI[2] - aI[3];
+	      b1R = aR[0] + (c51 * t1R) + (c52 * t2R);
+	      b1I = aI[0] + (c51 * t1I) + (c52 * t2I);
+	      b2R = aR[0] + (c52 * t1R) + (c51 * t2R);
+	      b2I = aI[0] + (c52 * t1I) + (c51 * t2I);
+	      e1R = (s51 * d1R) + (s52 * d2R);
+	      e1I = (s51 * d1I) + (s52 * d2I);
+	      e2R = (s52 * d1R) - (s51 * d2R);
+	      e2I = (s52 * d1I) - (s51 * d2I);
+	      pR[0] = aR[0] + t1R + t2R;
+	      pI[0] = aI[0] + t1I + t2I;
+	      pR[len * step] = b1R + e1I;
+	      pI[len * step] = b1I - e1R;
+	      pR[4 * len * step] = b1R - e1I;
+	      pI[4 * len * step] = b1I + e1R;
+	      pR[2 * len * step] = b2R + e2I;
+	      pI[2 * len * step] = b2I - e2R;
+	      pR[3 * len * step] = b2R - e2I;
+	      pI[3 * len * step] = b2I + e2R;
+	    }
+	    break;
+	  default:
+	    /* General odd prime radix, using the symmetry of the
+	     * roots of unity about the real axis. */
+	    {
+	      int    rS,
+	      	     hRdx;
+	      double sR,
+	      	     sI;
+
+	      rS = plan->num / rdx;
+	      hRdx = rdx / 2;
+	      sR = aR[0];
+	      sI = aI[0];
+	      for(idK = 1; idK < rdx; ++idK)
+	      {
+		sR += aR[idK];
+		sI += aI[idK];
+	      }
+	      pR[0] = sR;
+	      pI[0] = sI;
+	      for(idQ = 1; idQ <= hRdx; ++idQ)
+	      {
+		double bR,
+		       bI,
+		       eR,
+		       eI;
+
+		bR = aR[0];
+		bI = aI[0];
+		eR = 0.0;
+		eI = 0.0;
+		for(idK = 1; idK <= hRdx; ++idK)
+		{
+		  int	 tIdx;
+		  double c,
+		  	 s;
+
+		  tIdx = ((idQ * idK) % rdx) * rS;
+		  c = plan->cosT[tIdx];
+		  s = plan->sinT[tIdx];
+		  bR += c * (aR[idK] + aR[rdx - idK]);
+		  bI += c * (aI[idK] + aI[rdx - idK]);
+		  eR += s * (aR[idK] - aR[rdx - idK]);
+		  eI += s * (aI[idK] - aI[rdx - idK]);
+		}
+		pR[idQ * len * step] = bR + eI;
+		pI[idQ * len * step] = bI - eR;
+		pR[(rdx - idQ) * len * step] = bR - eI;
+		pI[(rdx - idQ) * len * step] = bI + eR;
+	      }
+	    }
+	    break;
+	}
+      }
+    }
+    len = span;
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward, unscaled, Fourier transform of the
+* 		given real data in place using a complex transform of half
+* 		the size. The data are returned with the layout of
+* 		AlgFourReal1D().
+* \param	plan			Real plan for the transform size.
+* \param	data			Given real data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+*/
+static void	AlgFourMRReal(AlgFourPlan *plan, double *data, int step,
+			      double *wrk)
+{
+  int		idK,
+		half;
+  double	zR,
+  		zI;
+  double	*pK,
+  		*pM;
+
+  half = plan->num / 2;
+  /* Even and odd data are the real and imaginary parts of a complex
+   * sequence of half the length. */
+  AlgFourMRTransform(plan->cPlan, data, data + step, 2 * step, wrk);
+  zR = data[0];
+  zI = data[step];
+  data[0] = zR + zI;
+  data[step] = zR - zI;
+  for(idK = 1; idK <= half / 2; ++idK)
+  {
+    double	c,
+		s,
+    		eR,
+		eI,
+		oR,
+		oI,
+		wR,
+		wI;
+
+    pK = data + (2 * idK * step);
+    pM = data + (2 * (half - idK) * step);
+    c = plan->cosT[idK];
+    s = plan->sinT[idK];
+    eR = 0.5 * (pK[0] + pM[0]);
+    eI = 0.5 * (pK[step] - pM[step]);
+    oR = 0.5 * (pK[step] + pM[step]);
+    oI = -0.5 * (pK[0] - pM[0]);
+    wR = (c * oR) + (s * oI);
+    wI = (c * oI) - (s * oR);
+    pK[0] = eR + wR;
+    pK[step] = eI + wI;
+    if(pM != pK)
+    {
+      pM[0] = eR - wR;
+      pM[step] = wI - eI;
+    }
+  }
+  AlgFourMRPermute(plan, data, step, 0);
+}
+
+/*!
+* \return	void
+* \brief	Computes the inverse, unscaled, Fourier transform of the
+* 		given data in place using a complex transform of half
+* 		the size. The data should have the layout of
+* 		AlgFourReal1D().
+* \param	plan			Real plan for the transform size.
+* \param	data			Given real/complex data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+*/
+static void	AlgFourMRRealInv(AlgFourPlan *plan, double *data, int step,
+				 double *wrk)
+{
+  int		idK,
+		half;
+  double	xR,
+  		xM;
+  double	*pK,
+  		*pM;
+
+  half = plan->num / 2;
+  AlgFourMRPermute(plan, data, step, 1);
+  xR = data[0];
+  xM = data[step];
+  data[0] = xR + xM;
+  data[step] = xR - xM;
+  for(idK = 1; idK <= half / 2; ++idK)
+  {
+    double	c,
+		s,
+    		sR,
+		sI,
+		dR,
+		dI,
+		tR,
+		tI;
+
+    pK = data + (2 * idK * step);
+    pM = data + (2 * (half - idK) * step);
+    c = plan->cosT[idK];
+    s = plan->sinT[idK];
+    sR = pK[0] + pM[0];
+    sI = pK[step] - pM[step];
+    dR = pK[0] - pM[0];
+    dI = pK[step] + pM[step];
+    tR = (c * dR) - (s * dI);
+    tI = (c * dI) + (s * dR);
+    pK[0] = sR - tI;
+    pK[step] = sI + tR;
+    if(pM != pK)
+    {
+      pM[0] = sR + tI;
+      pM[step] = tR - sI;
+    }
+  }
+  /* Inverse complex transform by swapping the real and imaginary parts. */
+  AlgFourMRTransform(plan->cPlan, data + step, data, 2 * step, wrk);
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward or inverse, unscaled, Fourier
+* 		transform of the given real data of odd size in place
+* 		using a complex transform of the same size. With
+* 		\f$N = 2M + 1\f$ the layout of the transformed data is
+* 		that of AlgFourReal1D(), \f$r_0, r_1, \ldots, r_M, i_1,
+* 		\ldots, i_M\f$, there being no \f$N/2\f$ term.
+* \param	plan			Real plan for the transform size.
+* \param	data			Given real or real/complex data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+* \param	dir			Forward or inverse transform.
+*/
+static void	AlgFourMRRealOdd(AlgFourPlan *plan, double *data, int step,
+				 double *wrk, AlgFourDir dir)
+{
+  int		idK,
+  		num,
+		half;
+  double	*zR,
+  		*zI;
+
+  num = plan->num;
+  half = num / 2;
+  zR = wrk;
+  zI = wrk + num;
+  if(dir == ALG_FOUR_DIR_FWD)
+  {
+    for(idK = 0; idK < num; ++idK)
+    {
+      zR[idK] = data[idK * step];
+      zI[idK] = 0.0;
+    }
+    AlgFourMRTransform(plan->cPlan, zR, zI, 1, wrk + (2 * num));
+    data[0] = zR[0];
+    for(idK = 1; idK <= half; ++idK)
+    {
+      data[idK * step] = zR[idK];
+      data[(half + idK) * step] = zI[idK];
+    }
+  }
+  else
+  {
+    zR[0] = data[0];
+    zI[0] = 0.0;
+    for(idK = 1; idK <= half; ++idK)
+    {
+      zR[idK] = zR[num - idK] = data[idK * step];
+      zI[idK] = data[(half + idK) * step];
+      zI[num - idK] = -(zI[idK]);
+    }
+    AlgFourMRTransform(plan->cPlan, zI, zR, 1, wrk + (2 * num));
+    for(idK = 0; idK < num; ++idK)
+    {
+      data[idK * step] = zR[idK];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward, unscaled, Fourier transform of the
+* 		given complex data in place using Bluestein's algorithm,
+* 		in which the transform is computed as a convolution with
+* 		a chirp using power of two transforms. This is used for
+* 		sizes with a prime factor greater than ALG_FOUR_MAX_RADIX.
+* \param	plan			Complex plan for the transform size
+* 					with a Bluestein plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+*/
+static void	AlgFourMRBluestein(AlgFourPlan *plan, double *real,
+				   double *imag, int step, double *wrk)
+{
+  int		idK,
+  		bNum;
+  double	*aR,
+  		*aI;
+
+  bNum = plan->bPlan->num;
+  aR = wrk;
+  aI = wrk + bNum;
+  for(idK = 0; idK < plan->num; ++idK)
+  {
+    double	xR,
+    		xI;
+
+    xR = real[idK * step];
+    xI = imag[idK * step];
+    aR[idK] = (xR * plan->chR[idK]) - (xI * plan->chI[idK]);
+    aI[idK] = (xR * plan->chI[idK]) + (xI * plan->chR[idK]);
+  }
+  for(idK = plan->num; idK < bNum; ++idK)
+  {
+    aR[idK] = aI[idK] = 0.0;
+  }
+  AlgFourMRComplex(plan->bPlan, aR, aI, 1);
+  for(idK = 0; idK < bNum; ++idK)
+  {
+    double	tR;
+
+    tR = (aR[idK] * plan->bR[idK]) - (aI[idK] * plan->bI[idK]);
+    aI[idK] = (aR[idK] * plan->bI[idK]) + (aI[idK] * plan->bR[idK]);
+    aR[idK] = tR;
+  }
+  /* Inverse transform by swapping the real and imaginary parts. */
+  AlgFourMRComplex(plan->bPlan, aI, aR, 1);
+  for(idK = 0; idK < plan->num; ++idK)
+  {
+    real[idK * step] = (aR[idK] * plan->chR[idK]) -
+                       (aI[idK] * plan->chI[idK]);
+    imag[idK * step] = (aR[idK] * plan->chI[idK]) +
+                       (aI[idK] * plan->chR[idK]);
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward, unscaled, Fourier transform of the
+* 		given complex data in place using either the mixed radix
+* 		transform or, for sizes with a prime factor greater than
+* 		ALG_FOUR_MAX_RADIX, Bluestein's algorithm. The inverse
+* 		transform may be computed by swapping the real and
+* 		imaginary data.
+* \param	plan			Complex plan for the transform size.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+*/
+static void	AlgFourMRTransform(AlgFourPlan *plan, double *real,
+				   double *imag, int step, double *wrk)
+{
+  if(plan->bPlan)
+  {
+    AlgFourMRBluestein(plan, real, imag, step, wrk);
+  }
+  else
+  {
+    AlgFourMRComplex(plan, real, imag, step);
+  }
+}
+
+/*!
+* \return	void
+* \brief	Frees the given plan, including any Bluestein plan which
+* 		it owns, but not the cached complex plan of a real plan.
+* \param	plan			Given plan.
+*/
+static void	AlgFourMRFreePlan(AlgFourPlan *plan)
+{
+  if(plan)
+  {
+    AlgFourMRFreePlan(plan->bPlan);
+    AlcFree(plan->ldr);
+    AlcFree(plan->perm);
+    AlcFree(plan->cosT);
+    AlcFree(plan->sinT);
+    AlcFree(plan->chR);
+    AlcFree(plan->chI);
+    AlcFree(plan->bR);
+    AlcFree(plan->bI);
+    AlcFree(plan);
+  }
+}
+
+/*!
+* \return	New plan or NULL on error.
+* \brief	Makes a new plan for a transform of the given size.
+* 		The complex plan of a real plan is not set.
+* \param	num			Transform size.
+* \param	real			Make a real plan if non-zero.
+* \param	dstErr			Destination error pointer.
+*/
+static AlgFourPlan *AlgFourMRMakePlan(int num, int real, AlgError *dstErr)
+{
+  int		idx,
+  		nTab;
+  unsigned char	*vst = NULL;
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  nTab = (real)? num / 2: num;
+  if(((plan = (AlgFourPlan *)AlcCalloc(1, sizeof(AlgFourPlan))) == NULL) ||
+     ((plan->cosT = (double *)AlcMalloc(sizeof(double) * nTab)) == NULL) ||
+     ((plan->sinT = (double *)AlcMalloc(sizeof(double) * nTab)) == NULL) ||
+     ((plan->ldr = (int *)AlcMalloc(sizeof(int) * num)) == NULL) ||
+     ((vst = (unsigned char *)AlcCalloc(num, sizeof(unsigned char))) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    plan->num = num;
+    plan->real = real;
+    for(idx = 0; idx < nTab; ++idx)
+    {
+      double	a;
+
+      a = (2.0 * ALG_M_PI * idx) / num;
+      plan->cosT[idx] = cos(a);
+      plan->sinT[idx] = sin(a);
+    }
+    if(real == 0)
+    {
+      plan->nFac = AlgFourMRFactor(num, plan->fac);
+      if((num > 1) && (plan->nFac == 0))
+      {
+        errNum = AlgFourMRMakeBluestein(plan);
+      }
+      else if((plan->perm = (int *)AlcMalloc(sizeof(int) * num)) == NULL)
+      {
+        errNum = ALG_ERR_MALLOC;
+      }
+      else
+      {
+        /* Mixed radix digit reversal. */
+	for(idx = 0; idx < num; ++idx)
+	{
+	  int	idF,
+	  	len,
+		pos = 0,
+		quo;
+
+	  quo = idx;
+	  len = num;
+	  for(idF = plan->nFac - 1; idF >= 0; --idF)
+	  {
+	    len /= plan->fac[idF];
+	    pos += (quo % plan->fac[idF]) * len;
+	    quo /= plan->fac[idF];
+	  }
+	  plan->perm[idx] = pos;
+	}
+      }
+    }
+  }
+  if((errNum == ALG_ERR_NONE) && (plan->bPlan == NULL) &&
+     ((real == 0) || ((num & 1) == 0)))
+  {
+    /* Find a leader for each non-trivial cycle of the permutation. */
+    for(idx = 0; idx < num; ++idx)
+    {
+      if(vst[idx] == 0)
+      {
+	int	nxt;
+
+	vst[idx] = 1;
+	nxt = AlgFourMRPermIdx(plan, idx, 0);
+	if(nxt != idx)
+	{
+	  plan->ldr[plan->nLdr++] = idx;
+	  while(nxt != idx)
+	  {
+	    vst[nxt] = 1;
+	    nxt = AlgFourMRPermIdx(plan, nxt, 0);
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(vst);
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFourMRFreePlan(plan);
+    plan = NULL;
+  }
+  *dstErr = errNum;
+  return(plan);
+}
+
+/*!
+* \return	Error code.
+* \brief	Sets up the given complex plan, the size of which has a
+* 		prime factor greater than ALG_FOUR_MAX_RADIX, for
+* 		Bluestein's algorithm. The power of two plan, chirp and
+* 		transformed conjugate chirp are all owned by the plan.
+* \param	plan			Given complex plan with its size set.
+*/
+static AlgError	AlgFourMRMakeBluestein(AlgFourPlan *plan)
+{
+  int		idK,
+  		bNum = 1;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  while(bNum < (2 * plan->num) - 1)
+  {
+    bNum *= 2;
+  }
+  if(((plan->chR = (double *)AlcMalloc(sizeof(double) * plan->num)) == NULL) ||
+     ((plan->chI = (double *)AlcMalloc(sizeof(double) * plan->num)) == NULL) ||
+     ((plan->bR = (double *)AlcCalloc(bNum, sizeof(double))) == NULL) ||
+     ((plan->bI = (double *)AlcCalloc(bNum, sizeof(double))) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    plan->bPlan = AlgFourMRMakePlan(bNum, 0, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    double	scale;
+
+    /* The chirp exp(-i pi k^2 / n), with k^2 reduced modulo 2n to keep
+     * the angle small. */
+    for(idK = 0; idK < plan->num; ++idK)
+    {
+      double	a;
+
+      a = (ALG_M_PI * fmod((double )idK * idK, 2.0 * plan->num)) /
+          plan->num;
+      plan->chR[idK] = cos(a);
+      plan->chI[idK] = -sin(a);
+    }
+    /* The conjugate chirp wrapped around for the cyclic convolution. */
+    for(idK = 0; idK < plan->num; ++idK)
+    {
+      plan->bR[idK] = plan->chR[idK];
+      plan->bI[idK] = -(plan->chI[idK]);
+    }
+    for(idK = 1; idK < plan->num; ++idK)
+    {
+      plan->bR[bNum - idK] = plan->bR[idK];
+      plan->bI[bNum - idK] = plan->bI[idK];
+    }
+    AlgFourMRComplex(plan->bPlan, plan->bR, plan->bI, 1);
+    scale = 1.0 / bNum;
+    for(idK = 0; idK < bNum; ++idK)
+    {
+      plan->bR[idK] *= scale;
+      plan->bI[idK] *= scale;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Plan or NULL on error.
+* \brief	Gets a plan for a transform of the given size from the
+* 		cache, creating it (and for real plans the complex plan
+* 		of half the size, or of the same size for odd sizes) if
+* 		it is not already in the cache.
+* \param	num			Transform size.
+* \param	real			Real plan if non-zero.
+* \param	dstErr			Destination error pointer.
+*/
+static AlgFourPlan *AlgFourMRGetPlan(int num, int real, AlgError *dstErr)
+{
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlan)
+#endif
+  {
+    int		idP;
+    AlgFourPlan	*p,
+    		*newP[2];
+
+    /* Find or make the complex plan first and then, if required, the real
+     * plan which uses it. */
+    newP[0] = newP[1] = NULL;
+    for(idP = 0; (errNum == ALG_ERR_NONE) && (idP <= real); ++idP)
+    {
+      int	pNum;
+
+      pNum = (real && (idP == 0) && ((num & 1) == 0))? num / 2: num;
+      p = algFourPlanCache;
+      while((p != NULL) && ((p->num != pNum) || (p->real != idP)))
+      {
+	p = p->next;
+      }
+      if(p == NULL)
+      {
+	p = newP[idP] = AlgFourMRMakePlan(pNum, idP, &errNum);
+      }
+      if((idP > 0) && (newP[idP] != NULL))
+      {
+	newP[idP]->cPlan = plan;
+      }
+      plan = p;
+    }
+    for(idP = 0; idP <= real; ++idP)
+    {
+      if(newP[idP])
+      {
+        if(errNum == ALG_ERR_NONE)
+	{
+	  newP[idP]->next = algFourPlanCache;
+	  algFourPlanCache = newP[idP];
+	}
+	else
+	{
+	  AlgFourMRFreePlan(newP[idP]);
+	}
+      }
+    }
+    if(errNum != ALG_ERR_NONE)
+    {
+      plan = NULL;
+    }
+  }
+  *dstErr = errNum;
+  return(plan);
+}
+
+/*!
+* \return	Error code.
+* \brief	Checks that the mixed radix transform can be computed
+* 		for the given size and creates the plan if required.
+* 		The multi-dimensional real transforms pair columns and
+* 		so require an even size.
+* \param	num			Transform size.
+* \param	real			Non-zero for a real transform, for
+* 					which the size must be even.
+*/
+static AlgError	AlgFourMRCheckSize(int num, int real)
+{
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((num < 1) || (real && (num & 1)))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(!AlgBitIsPowerOfTwo(num))
+  {
+    (void )AlgFourMRGetPlan(num, real, &errNum);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of doubles of workspace.
+* \brief	Computes the workspace required to compute a transform
+* 		using the given plan. Only the Bluestein and odd size
+* 		real transforms require workspace.
+* \param	plan			Given plan, may be NULL.
+*/
+static int	AlgFourMRWrkSz(AlgFourPlan *plan)
+{
+  int		sz = 0;
+
+  if(plan)
+  {
+    if(plan->real)
+    {
+      sz = AlgFourMRWrkSz(plan->cPlan);
+      if(plan->num & 1)
+      {
+        sz += 2 * plan->num;
+      }
+    }
+    else if(plan->bPlan)
+    {
+      sz = 2 * plan->bPlan->num;
+    }
+  }
+  return(sz);
+}
+
+/*!
+* \return	Error code, set if the plan can not be created or the
+* 		workspace allocated.
+* \brief	Computes a one dimensional Fourier transform in place
+* 		using the mixed radix transform. This is used for sizes
+* 		which are not an integer power of two.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, if NULL the
+* 					data are real with the layout
+* 					of AlgFourReal1D().
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+*/
+static AlgError	AlgFourMR1D(double *real, double *imag, int num, int step,
+			    AlgFourDir dir)
+{
+  int		wrkSz;
+  double	*wrk = NULL;
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if(num < 1)
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    plan = AlgFourMRGetPlan(num, imag == NULL, &errNum);
+  }
+  if((errNum == ALG_ERR_NONE) && ((wrkSz = AlgFourMRWrkSz(plan)) > 0) &&
+     ((wrk = (double *)AlcMalloc(sizeof(double) * wrkSz)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    AlgFourPlan1D(plan, real, imag, num, step, dir, wrk);
+  }
+  AlcFree(wrk);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \brief	Computes a one dimensional Fourier transform in place
+* 		using the given plan, or if the plan is NULL (for sizes
+* 		which are an integer power of two) using the Hartley
+* 		transform.
+* \param	plan			Given plan, must be a real plan if
+* 					the imaginary data are NULL and a
+* 					complex plan otherwise.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, if NULL the
+* 					data are real with the layout
+* 					of AlgFourReal1D().
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+* \param	wrk			Workspace of at least
+* 					AlgFourMRWrkSz() doubles.
+*/
+static void	AlgFourPlan1D(AlgFourPlan *plan, double *real, double *imag,
+			      int num, int step, AlgFourDir dir, double *wrk)
+{
+  if(plan == NULL)
+  {
+    if(imag)
+    {
+      if(dir == ALG_FOUR_DIR_FWD)
+      {
+	(void )AlgFour1DErr(real, imag, num, step);
+      }
+      else
+      {
+	(void )AlgFourInv1DErr(real, imag, num, step);
+      }
+    }
+    else
+    {
+      if(dir == ALG_FOUR_DIR_FWD)
+      {
+	(void )AlgFourReal1DErr(real, num, step);
+      }
+      else
+      {
+	(void )AlgFourRealInv1DErr(real, num, step);
+      }
+    }
+  }
+  else if(imag)
+  {
+    if(dir == ALG_FOUR_DIR_FWD)
+    {
+      AlgFourMRTransform(plan, real, imag, step, wrk);
+    }
+    else
+    {
+      AlgFourMRTransform(plan, imag, real, step, wrk);
+    }
+  }
+  else if(num & 1)
+  {
+    AlgFourMRRealOdd(plan, real, step, wrk, dir);
+  }
+  else
+  {
+    if(dir == ALG_FOUR_DIR_FWD)
+    {
+      AlgFourMRReal(plan, real, step, wrk);
+    }
+    else
+    {
+      AlgFourMRRealInv(plan, real, step, wrk);
+    }
+  }
+}
+
+/*!
+* \return	Error code.
+* \brief	Gets the plans and allocates the per thread workspace
+* 		required for a pass of repeated one dimensional transforms
+* 		of the given size. This is done once for each pass so
+* 		that the plan cache is not searched (within a critical
+* 		section) for each line of the pass. For sizes which are
+* 		an integer power of two no plans are required and the
+* 		plans are set to NULL.
+* \param	num			Transform size.
+* \param	cpx			Get a complex plan if non-zero.
+* \param	real			Get a real plan if non-zero.
+* \param	dstCPlan		Destination pointer for the complex
+* 					plan.
+* \param	dstRPlan		Destination pointer for the real
+* 					plan.
+* \param	dstWrk			Destination pointer for the
+* 					workspace, which must be freed
+* 					using AlcFree().
+* \param	dstWrkSz		Destination pointer for the number of
+* 					doubles of workspace for each
+* 					thread.
+*/
+static AlgError	AlgFourRepPlans(int num, int cpx, int real,
+				AlgFourPlan **dstCPlan,
+				AlgFourPlan **dstRPlan,
+				double **dstWrk, int *dstWrkSz)
+{
+  int		nThr = 1,
+  		wrkSz = 0;
+  double	*wrk = NULL;
+  AlgFourPlan	*cPlan = NULL,
+  		*rPlan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if(!AlgBitIsPowerOfTwo(num))
+  {
+    if(cpx)
+    {
+      cPlan = AlgFourMRGetPlan(num, 0, &errNum);
+    }
+    if(real && (errNum == ALG_ERR_NONE))
+    {
+      rPlan = AlgFourMRGetPlan(num, 1, &errNum);
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      wrkSz = ALG_MAX(AlgFourMRWrkSz(cPlan), AlgFourMRWrkSz(rPlan));
+    }
+    if(wrkSz > 0)
+    {
+#ifdef _OPENMP
+      nThr = omp_get_max_threads();
+#endif
+      if((wrk = (double *)AlcMalloc(sizeof(double) * wrkSz * nThr)) == NULL)
+      {
+        errNum = ALG_ERR_MALLOC;
+      }
+    }
+  }
+  *dstCPlan = cPlan;
+  *dstRPlan = rPlan;
+  *dstWrk = wrk;
+  *dstWrkSz = wrkSz;
+  return(errNum);
+}
+
+/*!
+* \return	Workspace of the calling thread or NULL if there is no
+* 		workspace.
+* \brief	Gets the calling thread's workspace from the per thread
+* 		workspace allocated by AlgFourRepPlans().
+* \param	wrk			Per thread workspace, may be NULL.
+* \param	wrkSz			Workspace size for each thread.
+*/
+static double	*AlgFourThrWrk(double *wrk, int wrkSz)
+{
+  int		thrId = 0;
+
+#ifdef _OPENMP
+  thrId = omp_get_thread_num();
+#endif
+  return((wrk)? wrk + (wrkSz * thrId): NULL);
+}
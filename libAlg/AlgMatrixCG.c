@@ -225,6 +225,207 @@ AlgError	AlgMatrixCGSolve(
   return(errCode);
 }
 
+/*!
+* \return	Error code.
+* \ingroup	AlgMatrix
+* \brief	Matrix free Conjugate Gradient iterative method with
+*		preconditioning for the simultaneous solution of linear
+*		systems with the form
+*		\f$\mathbf{A} \mathbf{x}_i = \mathbf{b}_i\f$
+*		which share the same symmetric positive definite matrix
+*		\f$\mathbf{A}\f$. The matrix is never formed, instead
+*		the matrix vector products are computed by the given
+*		function which is called, passing the matrix data aDat, as:
+*		(*aFn)(void *aDat, double **x, double **y)
+*		to compute \f$\mathbf{y}_i = \mathbf{A} \mathbf{x}_i\f$
+*		for all nV vectors at once. This allows the products to be
+*		computed using fast summation methods or sparse matrices
+*		and allows the cost of the products to be shared between
+*		the systems. Each system has it's own iteration but they
+*		proceed in lock step, with converged systems left
+*		unchanged until all have converged.
+*		If the preconditioning function pFn is non NULL then it is
+*		called, passing the preconditioning data pDat, as:
+*		(*pFn)(void *pDat, double **r, double **z)
+*		to solve \f$\mathbf{M} \mathbf{z}_i = \mathbf{r}_i\f$
+*		for the \f$\mathbf{z}_i\f$.
+*  		Convergence is tested using:
+*		\f$ \frac{\| \mathbf{b}_i - \mathbf{A} \mathbf{x}_i \|}
+                         {\|\mathbf{b}_i\|} < \delta\f$.
+* \param	nN			Number of unknowns in each system.
+* \param	nV			Number of systems.
+* \param	aFn			Matrix vector product function.
+* \param	aDat			Data to be passed to the matrix
+*					vector product function.
+* \param	pFn			Preconditioning function, may be NULL.
+* \param	pDat			Data to be passed to preconditioning
+* 					function.
+* \param	xV			Array of nV vectors \f$\mathbf{x}_i\f$
+*					which should contain initial
+*					estimates although these may be
+*					\f$\mathbf{0}\f$.
+* \param	bV			Array of nV vectors \f$\mathbf{b}_i\f$.
+* \param	tol			Tolerance required, \f$\delta\f$.
+* \param	maxItr			The maximum number of itterations.
+* \param	dstTol			Destination pointer for the greatest
+*					residual after the final iteration,
+*					may be NULL.
+* \param	dstItr			Destination pointer for the actual
+*					number of itterations performed,
+*					may be NULL.
+*/
+AlgError	AlgMatrixCGSolveFn(size_t nN, int nV,
+				   void (*aFn)(void *, double **, double **),
+				   void *aDat,
+				   void (*pFn)(void *, double **, double **),
+				   void *pDat,
+				   double **xV, double **bV,
+				   double tol, int maxItr,
+				   double *dstTol, int *dstItr)
+{
+  int		idV,
+		itr = 0,
+  		nConv = 0;
+  double	resid = 0.0;
+  int		*conv = NULL;
+  double	*buf = NULL,
+  		*nrmB = NULL,
+		*rho = NULL;
+  double	**r = NULL,
+  		**p = NULL,
+		**z = NULL,
+		**q = NULL;
+  AlgError	errCode = ALG_ERR_NONE;
+
+  if((nN < 1) || (nV < 1) || (aFn == NULL) ||
+     (xV == NULL) || (bV == NULL) || (tol < 0.0) || (maxItr < 0))
+  {
+    errCode = ALG_ERR_FUNC;
+  }
+  else if(((conv = (int *)AlcCalloc(nV, sizeof(int))) == NULL) ||
+          ((nrmB = (double *)AlcMalloc(3 * nV * sizeof(double))) == NULL) ||
+          ((r = (double **)AlcMalloc(4 * nV * sizeof(double *))) == NULL) ||
+          ((buf = (double *)AlcMalloc(4 * nV * nN * sizeof(double))) == NULL))
+  {
+    errCode = ALG_ERR_MALLOC;
+  }
+  if(errCode == ALG_ERR_NONE)
+  {
+    rho = nrmB + nV;
+    p = r + nV;
+    z = r + (2 * nV);
+    q = r + (3 * nV);
+    for(idV = 0; idV < nV; ++idV)
+    {
+      r[idV] = buf + (idV * nN);
+      p[idV] = buf + ((nV + idV) * nN);
+      z[idV] = buf + (((2 * nV) + idV) * nN);
+      q[idV] = buf + (((3 * nV) + idV) * nN);
+    }
+    /* r = b - A x */
+    (*aFn)(aDat, xV, r);
+    for(idV = 0; idV < nV; ++idV)
+    {
+      double	res;
+
+      AlgVectorSub(r[idV], bV[idV], r[idV], nN);
+      if((nrmB[idV] = AlgVectorNorm(bV[idV], nN)) < DBL_EPSILON)
+      {
+	nrmB[idV] = 1.0;
+      }
+      res = AlgVectorNorm(r[idV], nN) / nrmB[idV];
+      resid = ALG_MAX(resid, res);
+      if(res <= tol)
+      {
+        conv[idV] = 1;
+	++nConv;
+      }
+    }
+    while((nConv < nV) && (itr < maxItr))
+    {
+      /* Pre-conditioning: Solve M z = r for z. */
+      if(pFn)
+      {
+	(*pFn)(pDat, r, z);
+      }
+      else
+      {
+	for(idV = 0; idV < nV; ++idV)
+	{
+	  AlgVectorCopy(z[idV], r[idV], nN);
+	}
+      }
+      for(idV = 0; idV < nV; ++idV)
+      {
+        double	rho0;
+
+	if(conv[idV])
+	{
+	  AlgVectorZero(p[idV], nN);
+	}
+	else
+	{
+	  rho0 = AlgVectorDot(r[idV], z[idV], nN);
+	  if(itr == 0)
+	  {
+	    AlgVectorCopy(p[idV], z[idV], nN);
+	  }
+	  else
+	  {
+	    /* p = z + beta p */
+	    AlgVectorScaleAdd(p[idV], p[idV], z[idV], rho0 / rho[idV], nN);
+	  }
+	  rho[idV] = rho0;
+	}
+      }
+      /* q = A p */
+      (*aFn)(aDat, p, q);
+      resid = 0.0;
+      for(idV = 0; idV < nV; ++idV)
+      {
+	if(!conv[idV])
+	{
+	  double alpha,
+		 pq,
+		 res;
+
+	  pq = AlgVectorDot(p[idV], q[idV], nN);
+	  alpha = (fabs(pq) > DBL_MIN)? rho[idV] / pq: 0.0;
+	  /* x = x + alpha p */
+	  AlgVectorScaleAdd(xV[idV], p[idV], xV[idV], alpha, nN);
+	  /* r = r - alpha * q */
+	  AlgVectorScaleAdd(r[idV], q[idV], r[idV], -alpha, nN);
+	  res = AlgVectorNorm(r[idV], nN) / nrmB[idV];
+	  resid = ALG_MAX(resid, res);
+	  if((res <= tol) || (alpha == 0.0))
+	  {
+	    conv[idV] = 1;
+	    ++nConv;
+	  }
+	}
+      }
+      ++itr;
+    }
+    if(nConv < nV)
+    {
+      errCode = ALG_ERR_CONVERGENCE;
+    }
+  }
+  AlcFree(conv);
+  AlcFree(nrmB);
+  AlcFree(r);
+  AlcFree(buf);
+  if(dstTol)
+  {
+    *dstTol = resid;
+  }
+  if(dstItr)
+  {
+    *dstItr = itr;
+  }
+  return(errCode);
+}
+
 #ifdef ALG_MATRIXCG_DEBUG
 static void	AlgMatrixCGDebug(FILE *fP, const char *name,
 				 double *dat, int nDat)
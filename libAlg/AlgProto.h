@@ -261,6 +261,24 @@ extern void			AlgFourRealInv1D(
 				  double *real,
 				  int num,
 				  int step);
+extern AlgError			AlgFour1DErr(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+extern AlgError			AlgFourInv1DErr(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+extern AlgError			AlgFourReal1DErr(
+				  double *real,
+				  int num,
+				  int step);
+extern AlgError			AlgFourRealInv1DErr(
+				  double *real,
+				  int num,
+				  int step);
 extern AlgError			AlgFourHart2D(
 				  double **data,
 				  int useBuf,
@@ -314,6 +332,10 @@ extern AlgError        		AlgFourRealInv3D(
 				  int numX,
 				  int numY,
 				  int numZ);
+extern int			AlgFourNextSize(
+				  int num,
+				  int even);
+extern void			AlgFourFreePlans(void);
 
 /* From AlgGamma.c */
 extern double			AlgGammaLog(
@@ -774,6 +796,23 @@ extern AlgError			AlgMatrixCGSolve(
 				  int maxItr,
                                   double *dstTol,
 				  int *dstItr);
+extern AlgError			AlgMatrixCGSolveFn(
+				  size_t nN,
+				  int nV,
+				  void (*aFn)(void *,
+				              double **,
+					      double **),
+				  void *aDat,
+				  void (*pFn)(void *,
+				              double **,
+					      double **),
+				  void *pDat,
+				  double **xV,
+				  double **bV,
+				  double tol,
+				  int maxItr,
+				  double *dstTol,
+				  int *dstItr);
 
 /* From AlgMatrixRSEigen.c */
 extern AlgError        		AlgMatrixRSEigen(
@@ -43,6 +43,24 @@ static char _ReconstructAuto_c[] = "University of Edinburgh $Id$";
 #include <Reconstruct.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Number of section pairs per thread registered in each batch by
+ * RecAutoParallel(). */
+#define REC_AUTO_PAR_BATCH	(4)
+
+typedef struct _RecAutoWorkData
+{
+  RecWorkFunction workFn;
+  void		*workData;
+} RecAutoWorkData;
+
+static void			RecAutoWorkFnSerial(
+				  RecState *state,
+				  void *data);
+
 /*!
 * \return	Non zero if registration fails.
 * \ingroup	Reconstruct
@@ -220,3 +238,377 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
 	   errFlag));
   return(errFlag);
 }
+
+
+/*!
+* \return	Non zero if registration fails.
+* \ingroup	Reconstruct
+* \brief	Performs the automatic registration of serial sections
+*		as for RecAuto() but with the registration of neighbouring
+*		section pairs done concurrently.
+*		The sections are read in batches and the sampled and
+*		pre-processed images, centres of mass and principal angles
+*		of the sections in a batch are found concurrently and
+*		cached, so that each is shared by the registrations of
+*		the section with both of its neighbours. The pairs of
+*		sections in the batch are then registered concurrently.
+*		Because each transform is relative to the previous section
+*		the registrations are independent.
+*		Once a batch has been registered the section update
+*		function is called for its sections in order, for as long
+*		as their registration has been successful, and when all
+*		the sections have been registered the cumulative transforms
+*		of the section list are composed.
+*		The work function is called with the state of each
+*		registration as it progresses, but these calls are
+*		serialised so the work function need not be thread safe.
+*		The cancel flag is checked before each pair of sections
+*		is registered.
+* \param	rCtrl			The registration control data
+* 					structure.
+* \param	ppCtrl			Pre-processing control data
+*					structure.
+* \param	secList			Section list.
+* \param	cancelFlag		Cancel if flag pointed to is non-zero.
+* \param	secFn			application supplied section update
+*					function. This function is responsible
+*					for replacing the section in the list,
+*					it may also display it, etc, ....
+* \param	secData			Application supplied data for section
+* 					update function.
+* \param	workFn			Application supplied work function.
+* \param	workData		Application supplied data for the
+*					work function.
+* \param	eMsg			Pointer for error message strings.
+*/
+RecError	RecAutoParallel(RecControl *rCtrl, RecPPControl *ppCtrl,
+				HGUDlpList *secList, int *cancelFlag,
+				RecSecUpdateFunction secFn, void *secData,
+				RecWorkFunction workFn, void *workData,
+				char **eMsg)
+{
+  int		idS,
+  		idX,
+		idL,
+		idU = 0,
+		nSec = 0,
+		nBatch = REC_AUTO_PAR_BATCH;
+  char		*done = NULL;
+  RecState	rState;
+  RecSection	*oSec = NULL;
+  RecSection	**nSecs = NULL;
+  RecRegCache	*cache = NULL;
+  HGUDlpListItem *item = NULL;
+  HGUDlpListItem **items = NULL;
+  RecWorkFunction regWorkFn = NULL;
+  RecAutoWorkData regWorkData;
+  static char	errMsgInvalidListStr[] =
+	     		"Section list or the registration limits are invalid.",
+	     	errMsgMallocStr[] = "Not enough memory available.";
+  RecError	errFlag = REC_ERR_NONE;
+
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoParallel FE 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx "
+	   "0x%lx 0x%lx\n",
+	   (unsigned long )rCtrl, (unsigned long )ppCtrl,
+	   (unsigned long )secList, (unsigned long )cancelFlag,
+	   (unsigned long )secFn, (unsigned long )secData,
+	   (unsigned long )workFn, (unsigned long )workData,
+	   (unsigned long )eMsg));
+  if((rCtrl == NULL) || (ppCtrl == NULL) || (secList == NULL))
+  {
+    errFlag = REC_ERR_FUNC;
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(((item = RecSecFindItemIndex(secList, NULL, rCtrl->firstIdx,
+     				    HGU_DLPLIST_DIR_TOTAIL)) == NULL) ||
+       ((oSec = (RecSection *)HGUDlpListEntryGet(secList, item)) == NULL))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(RecSecIsEmpty(oSec))
+    {
+      if((oSec = RecSecNext(secList, item, &item, 1)) == NULL)
+      {
+        errFlag = REC_ERR_LIST;
+      }
+    }
+  }
+  /* Count the sections to be registered and check the list. */
+  if(errFlag == REC_ERR_NONE)
+  {
+    HGUDlpListItem *tItem;
+    RecSection	*tSec;
+
+    nSec = 1;
+    tSec = oSec;
+    tItem = item;
+    while((tSec->index < rCtrl->lastIdx) &&
+          ((tSec = RecSecNext(secList, tItem, &tItem, 1)) != NULL) &&
+	  (tSec->index <= rCtrl->lastIdx))
+    {
+      ++nSec;
+    }
+    if((oSec->index != rCtrl->firstIdx) || (nSec < 2) ||
+       (tSec == NULL) || (tSec->index < rCtrl->lastIdx))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(((items = (HGUDlpListItem **)
+    		 AlcMalloc(sizeof(HGUDlpListItem *) * nSec)) == NULL) ||
+       ((nSecs = (RecSection **)
+       		 AlcCalloc(nSec, sizeof(RecSection *))) == NULL) ||
+       ((cache = (RecRegCache *)
+       		 AlcCalloc(nSec, sizeof(RecRegCache))) == NULL) ||
+       ((done = (char *)AlcCalloc(nSec, sizeof(char))) == NULL))
+    {
+      errFlag = REC_ERR_MALLOC;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    items[0] = item;
+    for(idX = 1; idX < nSec; ++idX)
+    {
+      (void )RecSecNext(secList, item, &item, 1);
+      items[idX] = item;
+    }
+    if(workFn)
+    {
+      regWorkFn = RecAutoWorkFnSerial;
+      regWorkData.workFn = workFn;
+      regWorkData.workData = workData;
+    }
+#ifdef _OPENMP
+    nBatch *= omp_get_max_threads();
+#endif
+    done[0] = 1;
+    if((nSecs[0] = RecSecDup(oSec)) == NULL)
+    {
+      errFlag = REC_ERR_MALLOC;
+    }
+    else
+    {
+      errFlag = RecFileSecObjRead(nSecs[0], eMsg);
+    }
+  }
+  if((errFlag == REC_ERR_NONE) && (*cancelFlag == 0) && secFn)
+  {
+    (*secFn)(nSecs[0], secData); /* Replaces oSec with copy of nSecs[0] */
+  }
+  idS = 0;
+  while((errFlag == REC_ERR_NONE) && (*cancelFlag == 0) && (idS < nSec - 1))
+  {
+    idL = WLZ_MIN(idS + nBatch, nSec - 1);
+    /* Read the sections of the batch. */
+    for(idX = idS + 1; (errFlag == REC_ERR_NONE) && (idX <= idL); ++idX)
+    {
+      oSec = (RecSection *)HGUDlpListEntryGet(secList, items[idX]);
+      if((oSec == NULL) || ((nSecs[idX] = RecSecDup(oSec)) == NULL))
+      {
+        errFlag = REC_ERR_MALLOC;
+      }
+      else
+      {
+        errFlag = RecFileSecObjRead(nSecs[idX], eMsg);
+      }
+    }
+    /* Set the registration caches of the sections in the batch. */
+    if(errFlag == REC_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for(idX = idS; idX <= idL; ++idX)
+      {
+	RecError errFlag1,
+		 errFlag2 = REC_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+	errFlag1 = errFlag;
+	if((errFlag1 == REC_ERR_NONE) && (cache[idX].samObj == NULL))
+	{
+	  errFlag2 = RecRegCacheSet(cache + idX, rCtrl, ppCtrl,
+				    nSecs[idX]->obj);
+	  if(errFlag2 != REC_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical (RecAutoParallel)
+#endif
+	    {
+	      if(errFlag == REC_ERR_NONE)
+	      {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+		errFlag = errFlag2;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    /* Register the pairs of sections in the batch. */
+    if(errFlag == REC_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for(idX = idS + 1; idX <= idL; ++idX)
+      {
+	int	cancel;
+	char	*eMsg2 = NULL;
+	RecError errFlag1,
+		 errFlag2 = REC_ERR_NONE;
+
+	/* The error flag is set by other threads and the cancel flag
+	 * may be set by the caller at any time. */
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+	errFlag1 = errFlag;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+	cancel = *cancelFlag;
+	if((errFlag1 == REC_ERR_NONE) && (cancel == 0))
+	{
+	  errFlag2 = RecRegisterPairCached(&(nSecs[idX]->transform),
+				&(nSecs[idX]->correl), &(nSecs[idX]->iterations),
+				rCtrl, ppCtrl,
+				nSecs[idX - 1]->obj, nSecs[idX]->obj,
+				cache + idX - 1, cache + idX,
+				regWorkFn, &regWorkData, &eMsg2);
+	  if(errFlag2 == REC_ERR_NONE)
+	  {
+	    done[idX] = 1;
+	  }
+	  else
+	  {
+#ifdef _OPENMP
+#pragma omp critical (RecAutoParallel)
+#endif
+	    {
+	      if(errFlag == REC_ERR_NONE)
+	      {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+		errFlag = errFlag2;
+		if(*eMsg == NULL)
+		{
+		  *eMsg = eMsg2;
+		  eMsg2 = NULL;
+		}
+	      }
+	    }
+	  }
+	  AlcFree(eMsg2);
+	}
+      }
+    }
+    /* Update the sections in order for as long as they're registered. */
+    while((idU < idL) && done[idU + 1])
+    {
+      ++idU;
+      if(secFn)
+      {
+	(*secFn)(nSecs[idU], secData); /* Replaces oSec with nSecs[idU] */
+      }
+    }
+    /* Free all but the last section of the batch. */
+    for(idX = idS; idX < idL; ++idX)
+    {
+      RecRegCacheClear(cache + idX);
+      if(nSecs[idX])
+      {
+	RecSecFree(nSecs[idX]);
+	nSecs[idX] = NULL;
+      }
+    }
+    idS = idL;
+  }
+  if(nSecs)
+  {
+    for(idX = 0; idX < nSec; ++idX)
+    {
+      RecRegCacheClear(cache + idX);
+      if(nSecs[idX])
+      {
+	RecSecFree(nSecs[idX]);
+      }
+    }
+  }
+  /* Compose the cumulative transforms of the updated sections. */
+  if(secFn && (idU > 0))
+  {
+    (void )RecSecCumTransfClear(secList, items[0]);
+    (void )RecSecCumTransfSet(secList, items[idU]);
+  }
+  AlcFree(items);
+  AlcFree(nSecs);
+  AlcFree(cache);
+  AlcFree(done);
+  if(*cancelFlag && (errFlag == REC_ERR_NONE))
+  {
+    errFlag = REC_ERR_CANCEL;
+  }
+  if((errFlag != REC_ERR_NONE) && (*eMsg == NULL))
+  {
+    switch(errFlag)
+    {
+      case REC_ERR_MALLOC:
+        *eMsg = AlcStrDup(errMsgMallocStr);
+        break;
+      case REC_ERR_LIST:
+        *eMsg = AlcStrDup(errMsgInvalidListStr);
+        break;
+      default:
+        break;
+    }
+  }
+  if(workFn && workData)
+  {
+    rState.approach = 0;
+    rState.iteration = 0;
+    rState.lastMethod = REC_MTHD_NONE;
+    rState.transform = NULL;
+    rState.correl = 0.0;
+    rState.errFlag = errFlag;
+    (*workFn)(&rState, workData);
+  }
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoParallel FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Work function wrapper used by RecAutoParallel() to serialise
+*		calls to the application supplied work function.
+* \param	state			Registration state.
+* \param	data			Application supplied work function and
+*					its data.
+*/
+static void	RecAutoWorkFnSerial(RecState *state, void *data)
+{
+  RecAutoWorkData *wD;
+
+  wD = (RecAutoWorkData *)data;
+#ifdef _OPENMP
+#pragma omp critical (RecAutoWorkFn)
+#endif
+  {
+    (*(wD->workFn))(state, wD->workData);
+  }
+}
@@ -180,6 +180,99 @@ RecError	RecCrossCorrelate(double **data0, double **data1,
   return(errFlag);
 }
 
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct
+* \brief	Ensures that the given Fourier cache holds the pre-processed
+*		Fourier transform of the given object for the given origin
+*		and size, computing it only if the cached data were found
+*		for some other origin or size. The cached data may then be
+*		copied into the first data array passed to
+*		RecCrossCorrelate() with the REC_CCFLAG_DATA0VALID flag set.
+*		It is the caller's responsibility to only use a cache with
+*		a single object and pre-processing control.
+* \param	cache			Given Fourier cache.
+* \param	obj			Given object.
+* \param	org			Origin of data wrt the given woolz
+* 					object.
+* \param	size			The size of data, which must be an
+*					integer power of two in each
+*					dimension.
+* \param	ppCtrl			Pre-processing control data structure.
+*/
+RecError	RecFourCacheSet(RecFourCache *cache, WlzObject *obj,
+				WlzIVertex2 org, WlzIVertex2 size,
+				RecPPControl *ppCtrl)
+{
+  RecError	errFlag = REC_ERR_NONE;
+
+  REC_DBG((REC_DBG_CROSS|REC_DBG_LVL_FN|REC_DBG_LVL_2),
+	  ("RecFourCacheSet FE 0x%lx 0x%lx {%d %d} {%d %d} 0x%lx\n",
+	   (unsigned long )cache, (unsigned long )obj,
+	   org.vtX, org.vtY, size.vtX, size.vtY, (unsigned long )ppCtrl));
+  if((cache == NULL) || (obj == NULL) || (ppCtrl == NULL))
+  {
+    errFlag = REC_ERR_FUNC;
+  }
+  else if((cache->data == NULL) ||
+	  (cache->org.vtX != org.vtX) || (cache->org.vtY != org.vtY) ||
+	  (cache->size.vtX != size.vtX) || (cache->size.vtY != size.vtY))
+  {
+    if(cache->data &&
+       ((cache->size.vtX != size.vtX) || (cache->size.vtY != size.vtY)))
+    {
+      (void )AlcDouble2Free(cache->data);
+      cache->data = NULL;
+    }
+    if(cache->data == NULL)
+    {
+      if((AlcDouble2Malloc(&(cache->data), size.vtY, size.vtX) !=
+          ALC_ER_NONE) || (cache->data == NULL))
+      {
+	errFlag = REC_ERR_MALLOC;
+      }
+    }
+    if(errFlag == REC_ERR_NONE)
+    {
+      errFlag = RecCCorObjToFour(cache->data, &(cache->sSq), obj,
+      				 org, size, ppCtrl);
+    }
+    if(errFlag == REC_ERR_NONE)
+    {
+      cache->org = org;
+      cache->size = size;
+    }
+    else if(cache->data)
+    {
+      (void )AlcDouble2Free(cache->data);
+      cache->data = NULL;
+    }
+  }
+  REC_DBG((REC_DBG_CROSS|REC_DBG_LVL_FN|REC_DBG_LVL_2),
+	  ("RecFourCacheSet FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Frees the data and object held by the given Fourier cache,
+*		leaving the cache empty. The cache itself is not freed.
+* \param	cache			Given Fourier cache.
+*/
+void		RecFourCacheClear(RecFourCache *cache)
+{
+  if(cache)
+  {
+    if(cache->data)
+    {
+      (void )AlcDouble2Free(cache->data);
+    }
+    (void )WlzFreeObj(cache->obj);
+    (void )memset(cache, 0, sizeof(RecFourCache));
+  }
+}
+
 /*!
 * \return	Error code.
 * \ingroup	Reconstruct
@@ -208,7 +208,7 @@ WlzObject	*RecPreProcObj(WlzObject *obj, RecPPControl *ppCtrl,
   if((errFlag == REC_ERR_NONE) && (ppCtrl->method & REC_PP_BACKGROUND))
   {
     tV0.type = WLZ_GREY_INT;
-    tV0.v.ubv = 0;
+    tV0.v.inv = 0;
     wlzErr = WlzSetBackground(ppObj1, tV0);
     errFlag = RecErrorFromWlz(wlzErr);
   }
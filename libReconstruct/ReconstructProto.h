@@ -59,6 +59,16 @@ extern RecError			RecAuto(
 				  RecWorkFunction workFn,
 				  void *workData,
 				  char **eMsg);
+extern RecError			RecAutoParallel(
+				  RecControl *rCtrl,
+				  RecPPControl *ppCtrl,
+				  HGUDlpList *secList,
+				  int *cancelFlag,
+				  RecSecUpdateFunction secFn,
+				  void *secData,
+				  RecWorkFunction workFn,
+				  void *workData,
+				  char **eMsg);
 
 /* From ReconstructConstruct3D.c */
 extern RecError			RecConstruct3DObj(
@@ -98,6 +108,14 @@ extern RecError			RecCrossCorrelateROI(
 				  WlzIVertex2 roiCtr,
 				  WlzIVertex2 roiSz,
 				  RecPPControl *ppCtrl);
+extern RecError			RecFourCacheSet(
+				  RecFourCache *cache,
+				  WlzObject *obj,
+				  WlzIVertex2 org,
+				  WlzIVertex2 size,
+				  RecPPControl *ppCtrl);
+extern void			RecFourCacheClear(
+				  RecFourCache *cache);
 
 /* From ReconstructDebug.c */
 extern RecDbgMask 		recDbgMask;
@@ -195,6 +213,26 @@ extern RecError			RecRegisterPair(
 				  RecWorkFunction workFn,
 				  void *workData,
 				  char **eMsg);
+extern RecError			RecRegisterPairCached(
+				  WlzAffineTransform **dstTrans,
+				  double *dstCrossC,
+				  int *dstIter,
+				  RecControl *rCtrl,
+				  RecPPControl *ppCtrl,
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  RecRegCache *cache0,
+				  RecRegCache *cache1,
+				  RecWorkFunction workFn,
+				  void *workData,
+				  char **eMsg);
+extern RecError			RecRegCacheSet(
+				  RecRegCache *cache,
+				  RecControl *rCtrl,
+				  RecPPControl *ppCtrl,
+				  WlzObject *obj);
+extern void			RecRegCacheClear(
+				  RecRegCache *cache);
 extern RecError			RecRegisterTiePoints(
 				  WlzAffineTransform **dstTr,
 				  double *dstED,
@@ -215,6 +253,17 @@ extern RecError 		RecRotMatch(
 				  double distInc,
 				  int maxRadiusFlag,
 				  RecPPControl *ppCtrl);
+extern RecError 		RecRotMatchCached(
+				  double *angle,
+				  double *value,
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIVertex2 cRot,
+				  double angleInc,
+				  double distInc,
+				  int maxRadiusFlag,
+				  RecPPControl *ppCtrl,
+				  RecFourCache *four0);
 
 /* From ReconstructSection.c */
 extern int			RecSecIsEmpty(
@@ -297,6 +346,14 @@ extern RecError			RecTranMatch(
 				  WlzObject *obj1,
 				  WlzIVertex2 maxShift,
 				  RecPPControl *ppCtrl);
+extern RecError			RecTranMatchCached(
+				  WlzDVertex2 *shift,
+				  double *value,
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzIVertex2 maxShift,
+				  RecPPControl *ppCtrl,
+				  RecFourCache *four0);
 
 extern void			RecTranFindPeak(
 				  WlzDVertex2 *shift,
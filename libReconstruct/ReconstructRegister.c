@@ -57,6 +57,24 @@ static RecError			RecRegRotate(
 				  WlzIVertex2 cMass,
 				  double angle,
 				  WlzObject *secObj);
+static WlzObject		*RecRegSampleObj(
+				  WlzObject *obj,
+				  RecPPControl *ppCtrl,
+				  RecRegCache *cache,
+				  RecError *dstErr);
+static WlzObject		*RecRegPreProcObj(
+				  WlzDVertex2 *dstCMass,
+				  WlzObject *samObj,
+				  RecPPControl *ppCtrl,
+				  RecRegCache *cache,
+				  RecError *dstErr);
+static double			RecRegPrincipalAngle(
+				  WlzObject *ppObj,
+				  WlzDVertex2 cMass,
+				  RecRegCache *cache,
+				  RecError *dstErr);
+static RecPPControl		RecRegSampledPPCtrl(
+				  RecPPControl *ppCtrl);
 static RecError			RecRegTranslate(
 				  WlzAffineTransform **transf,
 				  WlzObject **transfObj,
@@ -92,6 +110,58 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
 			        WlzObject *obj0, WlzObject *obj1,
 				RecWorkFunction workFn, void *workData,
 				char **eMsg)
+{
+  return(RecRegisterPairCached(dstTrans, dstCrossC, dstIter, rCtrl, ppCtrl,
+  			       obj0, obj1, NULL, NULL,
+			       workFn, workData, eMsg));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct
+* \brief	Calculates the affine transform which when applied
+*               to the second object brings it into register with the
+*               first object, as for RecRegisterPair(), but using
+*               registration caches for the two objects. The sampled
+*               and pre-processed objects, centres of mass and principal
+*               angles of the two objects are taken from the caches when
+*               set and are otherwise computed and set in the caches.
+*               The Fourier data of the first (untransformed) object are
+*               also cached so that they are not recomputed on each
+*               iteration. Because the second object is transformed
+*               its Fourier data are never cached. A cache may be shared
+*               by the two registrations of a section with its neighbours
+*               provided that the control data are unchanged, but the
+*               cache must then be set using RecRegCacheSet() before the
+*               registrations if they are to be run concurrently.
+* \param	dstTrans		Destination pointer for transform.
+* \param	dstCrossC		Destination pointer for the
+*					cross-correlation value.
+* \param	dstIter			Destination pointer for the number
+*                                       of iterations.
+* \param	rCtrl			The registration control data
+*                                       structure.
+* \param	ppCtrl			Pre-processing control data
+*                                       structure.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	cache0			Registration cache for the first
+*					object, may be NULL.
+* \param	cache1			Registration cache for the second
+*					object, may be NULL.
+* \param	workFn			Application supplied work
+*                                       function.
+* \param	workData		Application supplied data for
+*                                       the work function.
+* \param	eMsg			Destination pointer for messages.
+*/
+RecError	RecRegisterPairCached(WlzAffineTransform **dstTrans,
+				double *dstCrossC, int *dstIter,
+				RecControl *rCtrl, RecPPControl *ppCtrl,
+			        WlzObject *obj0, WlzObject *obj1,
+				RecRegCache *cache0, RecRegCache *cache1,
+				RecWorkFunction workFn, void *workData,
+				char **eMsg)
 {
   int		approach = 0,
 		approach0 = 0,
@@ -120,11 +190,13 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
   RecPPControl	newPP;
 
   REC_DBG((REC_DBG_REG|REC_DBG_LVL_FN|REC_DBG_LVL_1),
-	  ("RecRegisterPair FE 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx\n",
+	  ("RecRegisterPairCached FE 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx "
+	   "0x%lx 0x%lx 0x%lx 0x%lx\n",
 	   (unsigned long )dstTrans,
 	   (unsigned long )dstCrossC, (unsigned long )dstIter,
 	   (unsigned long )rCtrl, (unsigned long )ppCtrl,
 	   (unsigned long )obj0, (unsigned long )obj1,
+	   (unsigned long )cache0, (unsigned long )cache1,
 	   (unsigned long )eMsg));
   (void )memset(&(states[0]), 0, sizeof(RecState));
   (void )memset(&(states[1]), 0, sizeof(RecState));
@@ -145,7 +217,7 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
   {
     maxShift.vtX = rCtrl->xLim;
     maxShift.vtY = rCtrl->yLim;
-    newPP = *ppCtrl;
+    newPP = RecRegSampledPPCtrl(ppCtrl);
     if(ppCtrl->method & REC_PP_SAMPLE)
     {
       maxShift.vtX = (maxShift.vtX + ppCtrl->sample.factor - 1) /
@@ -155,28 +227,18 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
       samFac.vtX = ppCtrl->sample.factor;
       samFac.vtY = ppCtrl->sample.factor;
       samFac.vtZ = 1;
-      newPP.sample.factor = 1;
-      newPP.sample.function = WLZ_SAMPLEFN_NONE;
-      newPP.method = (RecPPMethod )((unsigned int )newPP.method & 
-      				    ~(unsigned int )(REC_PP_SAMPLE));
-      obj0 = WlzAssignObject(WlzSampleObj(obj0, samFac, ppCtrl->sample.function,
-      				          &wlzErr), NULL);
-      if(obj0 && (wlzErr == WLZ_ERR_NONE))
-      {
-        obj1 = WlzAssignObject(
-	       WlzSampleObj(obj1, samFac, ppCtrl->sample.function,
-	       		    &wlzErr), NULL);
-      }
-      if(obj0 && obj1 && (wlzErr == WLZ_ERR_NONE))
+    }
+    obj0 = RecRegSampleObj(obj0, ppCtrl, cache0, &errFlag);
+    if(errFlag == REC_ERR_NONE)
+    {
+      obj1 = RecRegSampleObj(obj1, ppCtrl, cache1, &errFlag);
+      if(errFlag != REC_ERR_NONE)
       {
-        freeObjFlag = 1;
+        (void )WlzFreeObj(obj0);
       }
-      errFlag = RecErrorFromWlz(wlzErr);
     }
-    else
+    if(errFlag == REC_ERR_NONE)
     {
-      obj0 = WlzAssignObject(obj0, NULL);
-      obj1 = WlzAssignObject(obj1, NULL);
       freeObjFlag = 1;
     }
   }
@@ -184,65 +246,51 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
      ((rCtrl->method & REC_MTHD_PRINC) || (rCtrl->method & REC_MTHD_ROTATE) ||
       (rCtrl->method & REC_MTHD_TRANS)))
   {
-    ppObj0 = RecPreProcObj(obj0, &newPP,
-    			   &errFlag); 	        /* Assigned by RecPreProcObj */
+    ppObj0 = RecRegPreProcObj(&cMass0, obj0, &newPP, cache0, &errFlag);
     if(ppObj0 && (errFlag == REC_ERR_NONE))
     {
-      REC_DBGW((REC_DBG_REG|REC_DBG_LVL_2), obj0, 0);
-      cMass0 = WlzCentreOfMass2D(ppObj0, 0, NULL, &wlzErr);
-      errFlag = RecErrorFromWlz(wlzErr);
-      if(errFlag == REC_ERR_NONE)
+      if(rCtrl->method & REC_MTHD_PRINC)
       {
-	if(rCtrl->method & REC_MTHD_PRINC)
+	ppObj1 = RecRegPreProcObj(&cMass1, obj1, &newPP, cache1, &errFlag);
+	if(ppObj1 && (errFlag == REC_ERR_NONE))
 	{
-	  ppObj1 = RecPreProcObj(obj1, &newPP,
-	  			 &errFlag); 	/* Assigned by RecPreProcObj */
-	  if(ppObj1 && (errFlag == REC_ERR_NONE))
+	  tD0 = RecRegPrincipalAngle(ppObj0, cMass0, cache0, &errFlag);
+	  if(errFlag == REC_ERR_NONE)
 	  {
-	    REC_DBGW((REC_DBG_REG|REC_DBG_LVL_2), obj1, 0);
-	    cMass1 = WlzCentreOfMass2D(ppObj1, 0, NULL, &wlzErr);
-	    if(wlzErr == WLZ_ERR_NONE)
-	    {
-	      tD0 = WlzPrincipalAngle(ppObj0, cMass0, 0, &wlzErr);
-	    }
-	    if(wlzErr == WLZ_ERR_NONE)
-	    {
-	      tD1 = WlzPrincipalAngle(ppObj1, cMass1, 0, &wlzErr);
-	    }
-	    errFlag = RecErrorFromWlz(wlzErr);
-	    if(errFlag == REC_ERR_NONE)
+	    tD1 = RecRegPrincipalAngle(ppObj1, cMass1, cache1, &errFlag);
+	  }
+	  if(errFlag == REC_ERR_NONE)
+	  {
+	    theta[0] = tD0 - tD1;
+	    theta[1] = theta[0] + WLZ_M_PI;
+	    REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
+		    ("RecRegisterPairCached 01 {%g %g} {%g %g} %f %f\n",
+		     cMass0.vtX, cMass0.vtY, cMass1.vtX, cMass1.vtY,
+		     tD0, tD1));
+	    if(WLZ_ABS(rCtrl->rLim) < 90.0) 	 /* Use limit to reduce work */
 	    {
-	      theta[0] = tD0 - tD1;
-	      theta[1] = theta[0] + WLZ_M_PI;
-	      REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
-		      ("RecRegisterPair 01 {%g %g} {%g %g} %f %f\n",
-		       cMass0.vtX, cMass0.vtY, cMass1.vtX, cMass1.vtY,
-		       tD0, tD1));
-	      if(WLZ_ABS(rCtrl->rLim) < 90.0) 	 /* Use limit to reduce work */
+	      if(WLZ_ABS(theta[0]) < WLZ_ABS(theta[1]))
 	      {
-		if(WLZ_ABS(theta[0]) < WLZ_ABS(theta[1]))
-		{
-		  approach0 = 0;
-		}
-		else
-		{
-		  approach0 = 1;
-		}
-		approach1 = approach0;
+		approach0 = 0;
+	      }
+	      else
+	      {
+		approach0 = 1;
 	      }
-	      REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
-		      ("RecRegisterPair 02 %d %d\n",
-		       approach0, approach1));
-	      approach = approach0;
+	      approach1 = approach0;
 	    }
+	    REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
+		    ("RecRegisterPairCached 02 %d %d\n",
+		     approach0, approach1));
+	    approach = approach0;
 	  }
 	}
-	else
-	{
-	  approach = 0;
-	  approach0 = 0;
-	  approach1 = 0;
-	}
+      }
+      else
+      {
+	approach = 0;
+	approach0 = 0;
+	approach1 = 0;
       }
     }
   }
@@ -311,10 +359,11 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
     {
       if(rCtrl->method & REC_MTHD_TRANS)
       {
-	errFlag = RecTranMatch(&tDV0, &correl, obj0, trObj, maxShift,
-			       &newPP);
+	errFlag = RecTranMatchCached(&tDV0, &correl, obj0, trObj, maxShift,
+			             &newPP,
+				     (cache0)? &(cache0->tranFour): NULL);
 	REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
-		("RecRegisterPair 03 %d %f {%f %f} %d\n",
+		("RecRegisterPairCached 03 %d %f {%f %f} %d\n",
 		 approach, correl, tDV0.vtX, tDV0.vtY, errFlag));
 	if((errFlag == REC_ERR_NONE) && (correl > 0.3) &&
 	   ((WLZ_ABS(tDV0.vtX) >= 0.5) || (WLZ_ABS(tDV0.vtY) >= 0.5)))
@@ -347,10 +396,11 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
       {
 	tIV0.vtX = WLZ_NINT(cMass0.vtX);
 	tIV0.vtY = WLZ_NINT(cMass0.vtY);
-	errFlag = RecRotMatch(&tD0, &correl, obj0, trObj,
-			      tIV0, angleInc, distInc, 0, &newPP);
+	errFlag = RecRotMatchCached(&tD0, &correl, obj0, trObj,
+			            tIV0, angleInc, distInc, 0, &newPP,
+				    (cache0)? &(cache0->rotFour): NULL);
 	REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
-		("RecRegisterPair 04 %d %d %f %f %d\n",
+		("RecRegisterPairCached 04 %d %d %f %f %d\n",
 		 approach, states[approach].iteration, correl,
 		 tD0, errFlag));
 	if((errFlag == REC_ERR_NONE) && (correl > 0.3) &&
@@ -375,10 +425,11 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
       {
 	if(errFlag == REC_ERR_NONE)
 	{
-	  errFlag = RecTranMatch(&tDV0, &correl, obj0, trObj,
-				  maxShift, &newPP);
+	  errFlag = RecTranMatchCached(&tDV0, &correl, obj0, trObj,
+				       maxShift, &newPP,
+				       (cache0)? &(cache0->tranFour): NULL);
 	  REC_DBG((REC_DBG_REG|REC_DBG_LVL_1),
-		  ("RecRegisterPair 03 %d %d %f {%f %f} %d\n",
+		  ("RecRegisterPairCached 03 %d %d %f {%f %f} %d\n",
 		   approach, states[approach].iteration,
 		   correl, tDV0.vtX, tDV0.vtY, errFlag));
 	}
@@ -482,11 +533,278 @@ RecError	RecRegisterPair(WlzAffineTransform **dstTrans,
     (void )WlzFreeObj(obj1);
   }
   REC_DBG((REC_DBG_REG|REC_DBG_LVL_FN|REC_DBG_LVL_1),
-	  ("RecRegisterPair FX %d\n",
+	  ("RecRegisterPairCached FX %d\n",
 	   errFlag));
   return(errFlag);
 }
 
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct
+* \brief	Sets the sampled and pre-processed objects, centre of mass
+*		and (if required by the registration method) principal
+*		angle of the given registration cache for the given
+*		section object. Once set the cache is only read by
+*		RecRegisterPairCached(), apart from the Fourier data which
+*		are set when the cache is used for the first object, so a
+*		set cache may be shared by the concurrent registrations of
+*		a section with its two neighbours.
+* \param	cache			Given registration cache, which
+*					should either be empty or have been
+*					set for the same object and control
+*					data.
+* \param	rCtrl			The registration control data
+*                                       structure.
+* \param	ppCtrl			Pre-processing control data
+*                                       structure.
+* \param	obj			Given section object.
+*/
+RecError	RecRegCacheSet(RecRegCache *cache,
+			       RecControl *rCtrl, RecPPControl *ppCtrl,
+			       WlzObject *obj)
+{
+  WlzDVertex2	cMass;
+  WlzObject	*samObj = NULL,
+  		*ppObj = NULL;
+  RecPPControl	newPP;
+  RecError	errFlag = REC_ERR_NONE;
+
+  REC_DBG((REC_DBG_REG|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecRegCacheSet FE 0x%lx 0x%lx 0x%lx 0x%lx\n",
+	   (unsigned long )cache, (unsigned long )rCtrl,
+	   (unsigned long )ppCtrl, (unsigned long )obj));
+  if((cache == NULL) || (rCtrl == NULL) || (ppCtrl == NULL) || (obj == NULL))
+  {
+    errFlag = REC_ERR_FUNC;
+  }
+  else if((obj->type != WLZ_2D_DOMAINOBJ) ||
+          (obj->domain.core == NULL) || (obj->values.core == NULL))
+  {
+    errFlag = REC_ERR_WLZ;
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    samObj = RecRegSampleObj(obj, ppCtrl, cache, &errFlag);
+  }
+  if((errFlag == REC_ERR_NONE) &&
+     ((rCtrl->method & REC_MTHD_PRINC) || (rCtrl->method & REC_MTHD_ROTATE) ||
+      (rCtrl->method & REC_MTHD_TRANS)))
+  {
+    newPP = RecRegSampledPPCtrl(ppCtrl);
+    ppObj = RecRegPreProcObj(&cMass, samObj, &newPP, cache, &errFlag);
+    if(ppObj && (errFlag == REC_ERR_NONE) && (rCtrl->method & REC_MTHD_PRINC))
+    {
+      (void )RecRegPrincipalAngle(ppObj, cMass, cache, &errFlag);
+    }
+  }
+  (void )WlzFreeObj(ppObj);
+  (void )WlzFreeObj(samObj);
+  REC_DBG((REC_DBG_REG|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecRegCacheSet FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Frees the objects and data held by the given registration
+*		cache, leaving the cache empty. The cache itself is not
+*		freed.
+* \param	cache			Given registration cache.
+*/
+void		RecRegCacheClear(RecRegCache *cache)
+{
+  if(cache)
+  {
+    (void )WlzFreeObj(cache->samObj);
+    (void )WlzFreeObj(cache->ppObj);
+    RecFourCacheClear(&(cache->tranFour));
+    RecFourCacheClear(&(cache->rotFour));
+    (void )memset(cache, 0, sizeof(RecRegCache));
+  }
+}
+
+/*!
+* \return	Sampled object which has been assigned, or NULL on error.
+* \ingroup	Reconstruct
+* \brief	Gets the sampled section object from the given cache if
+*		it has been set, otherwise samples the given object as
+*		required by the pre-processing control and then sets it
+*		in the cache.
+* \param	obj			Given section object.
+* \param	ppCtrl			Pre-processing control data
+*                                       structure.
+* \param	cache			Registration cache, may be NULL.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *RecRegSampleObj(WlzObject *obj, RecPPControl *ppCtrl,
+				  RecRegCache *cache, RecError *dstErr)
+{
+  WlzIVertex3	samFac;
+  WlzObject	*samObj = NULL;
+  WlzErrorNum	wlzErr = WLZ_ERR_NONE;
+  RecError	errFlag = REC_ERR_NONE;
+
+  if(cache && cache->samObj)
+  {
+    samObj = WlzAssignObject(cache->samObj, NULL);
+  }
+  else
+  {
+    if(ppCtrl->method & REC_PP_SAMPLE)
+    {
+      samFac.vtX = ppCtrl->sample.factor;
+      samFac.vtY = ppCtrl->sample.factor;
+      samFac.vtZ = 1;
+      samObj = WlzAssignObject(WlzSampleObj(obj, samFac,
+      					    ppCtrl->sample.function,
+					    &wlzErr), NULL);
+      errFlag = RecErrorFromWlz(wlzErr);
+    }
+    else
+    {
+      samObj = WlzAssignObject(obj, NULL);
+    }
+    if(errFlag != REC_ERR_NONE)
+    {
+      (void )WlzFreeObj(samObj);
+      samObj = NULL;
+    }
+    else if(cache)
+    {
+      cache->samObj = WlzAssignObject(samObj, NULL);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errFlag;
+  }
+  return(samObj);
+}
+
+/*!
+* \return	Pre-processed object which has been assigned, may be NULL.
+* \ingroup	Reconstruct
+* \brief	Gets the pre-processed section object and its centre of
+*		mass from the given cache if they have been set, otherwise
+*		pre-processes the given sampled object, computes its centre
+*		of mass and then sets both in the cache.
+* \param	dstCMass		Destination pointer for the centre
+*					of mass.
+* \param	samObj			Given sampled section object.
+* \param	ppCtrl			Pre-processing control data
+*                                       structure without sampling.
+* \param	cache			Registration cache, may be NULL.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *RecRegPreProcObj(WlzDVertex2 *dstCMass, WlzObject *samObj,
+				   RecPPControl *ppCtrl, RecRegCache *cache,
+				   RecError *dstErr)
+{
+  WlzDVertex2	cMass;
+  WlzObject	*ppObj = NULL;
+  WlzErrorNum	wlzErr = WLZ_ERR_NONE;
+  RecError	errFlag = REC_ERR_NONE;
+
+  if(cache && cache->ppObj)
+  {
+    ppObj = WlzAssignObject(cache->ppObj, NULL);
+    *dstCMass = cache->cMass;
+  }
+  else
+  {
+    ppObj = RecPreProcObj(samObj, ppCtrl,
+    			  &errFlag); 		/* Assigned by RecPreProcObj */
+    if(ppObj && (errFlag == REC_ERR_NONE))
+    {
+      REC_DBGW((REC_DBG_REG|REC_DBG_LVL_2), samObj, 0);
+      cMass = WlzCentreOfMass2D(ppObj, 0, NULL, &wlzErr);
+      errFlag = RecErrorFromWlz(wlzErr);
+    }
+    if(errFlag != REC_ERR_NONE)
+    {
+      (void )WlzFreeObj(ppObj);
+      ppObj = NULL;
+    }
+    else if(ppObj)
+    {
+      *dstCMass = cMass;
+      if(cache)
+      {
+	cache->ppObj = WlzAssignObject(ppObj, NULL);
+	cache->cMass = cMass;
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errFlag;
+  }
+  return(ppObj);
+}
+
+/*!
+* \return	Principal angle.
+* \ingroup	Reconstruct
+* \brief	Gets the principal angle of the pre-processed section
+*		object from the given cache if it has been set, otherwise
+*		computes it and then sets it in the cache.
+* \param	ppObj			Given pre-processed section object.
+* \param	cMass			Centre of mass of the pre-processed
+*					object.
+* \param	cache			Registration cache, may be NULL.
+* \param	dstErr			Destination error pointer.
+*/
+static double	RecRegPrincipalAngle(WlzObject *ppObj, WlzDVertex2 cMass,
+				     RecRegCache *cache, RecError *dstErr)
+{
+  double	angle = 0.0;
+  WlzErrorNum	wlzErr = WLZ_ERR_NONE;
+
+  if(cache && cache->pAngleValid)
+  {
+    angle = cache->pAngle;
+  }
+  else
+  {
+    angle = WlzPrincipalAngle(ppObj, cMass, 0, &wlzErr);
+    if(cache && (wlzErr == WLZ_ERR_NONE))
+    {
+      cache->pAngle = angle;
+      cache->pAngleValid = 1;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = RecErrorFromWlz(wlzErr);
+  }
+  return(angle);
+}
+
+/*!
+* \return	Pre-processing control data without sampling.
+* \ingroup	Reconstruct
+* \brief	Returns a copy of the given pre-processing control data
+*		with sampling removed, for use with objects which have
+*		already been sampled.
+* \param	ppCtrl			Given pre-processing control data
+*                                       structure.
+*/
+static RecPPControl RecRegSampledPPCtrl(RecPPControl *ppCtrl)
+{
+  RecPPControl	newPP;
+
+  newPP = *ppCtrl;
+  if(ppCtrl->method & REC_PP_SAMPLE)
+  {
+    newPP.sample.factor = 1;
+    newPP.sample.function = WLZ_SAMPLEFN_NONE;
+    newPP.method = (RecPPMethod )((unsigned int )newPP.method & 
+				  ~(unsigned int )(REC_PP_SAMPLE));
+  }
+  return(newPP);
+}
+
 /*!
 * \return	Error code.
 * \ingroup	Reconstruct
@@ -80,11 +80,54 @@ RecError	RecRotMatch(double *angle, double *value,
 			    WlzIVertex2 cRot,
 			    double angleInc, double distInc, int maxRadiusFlag,
 			    RecPPControl *ppCtrl)
+{
+  return(RecRotMatchCached(angle, value, obj0, obj1, cRot, angleInc, distInc,
+  			   maxRadiusFlag, ppCtrl, NULL));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct.
+* \brief	Performs polar resampling of the given objects and then
+*               uses cross correlation to find the angle of rotation
+*               which gives the best match between the given objects,
+*               as for RecRotMatch(), but using a cache for the polar
+*               resampled first object and its Fourier transform.
+*               The Fourier transform of the first object is only
+*               recomputed when the data origin or size, which depend
+*               on the polar resampled second object, change.
+* \param	angle			Destination pointer for angle of
+*					rotation (in radians).
+* \param	value			Destination pointer for the
+*					cross-correlation peak value.
+* \param	obj0			First of two type 1 objects.
+* \param	obj1			Second of two type 1 objects.
+* \param	cRot			Center of rotation for objects.
+* \param	angleInc		Angle increment (radians).
+* \param	distInc			Distance increment.
+* \param	maxRadiusFlag		Use maximum radius for the
+*                                       polar resampling if non zero.
+* \param	ppCtrl			Pre-processing control.
+* \param	four0			Fourier cache for the first object,
+*					which must only be used with this
+*					object, centre of rotation, angle and
+*					distance increments, radius flag and
+*					pre-processing control. May be NULL
+*					in which case no cache is used.
+*/
+RecError	RecRotMatchCached(double *angle, double *value,
+				  WlzObject *obj0, WlzObject *obj1,
+				  WlzIVertex2 cRot,
+				  double angleInc, double distInc,
+				  int maxRadiusFlag,
+				  RecPPControl *ppCtrl,
+				  RecFourCache *four0)
 {
   int		length,
 		p2Len;
   WlzErrorNum	wlzErr = WLZ_ERR_NONE;
   RecError	errFlag = REC_ERR_NONE;
+  RecCcFlag	ccFlags = REC_CCFLAG_NONE;
   WlzIVertex2	size,
 		origin;
   WlzObject	*pObj0 = NULL,
@@ -95,9 +138,12 @@ RecError	RecRotMatch(double *angle, double *value,
   		**data1 = NULL;
 
   REC_DBG((REC_DBG_ROT|REC_DBG_LVL_1|REC_DBG_LVL_FN),
-	  ("RecRotMatch FE 0x%x 0x%x 0x%x 0x%x {%d %d} %f %f %d 0x%x\n",
-	   angle, value, obj0, obj1, cRot.vtX, cRot.vtY,
-	   angleInc, distInc, maxRadiusFlag, ppCtrl));
+	  ("RecRotMatchCached FE 0x%lx 0x%lx 0x%lx 0x%lx {%d %d} %f %f %d "
+	   "0x%lx 0x%lx\n",
+	   (unsigned long )angle, (unsigned long )value,
+	   (unsigned long )obj0, (unsigned long )obj1, cRot.vtX, cRot.vtY,
+	   angleInc, distInc, maxRadiusFlag, (unsigned long )ppCtrl,
+	   (unsigned long )four0));
   *value = 0.0;
   *angle = 0.0;
   length = WLZ_NINT(2.0 * WLZ_M_PI / angleInc);
@@ -107,11 +153,22 @@ RecError	RecRotMatch(double *angle, double *value,
 	   length, p2Len));
   REC_DBGW((REC_DBG_ROT | REC_DBG_LVL_3), obj0, 0);
   REC_DBGW((REC_DBG_ROT | REC_DBG_LVL_3), obj1, 0);
-  if(((pObj0 = WlzAssignObject(
-               WlzPolarSample(obj0, cRot, angleInc, distInc,
-			     length, maxRadiusFlag,
-			     &wlzErr), NULL)) == NULL) ||
-     (wlzErr != WLZ_ERR_NONE) ||
+  if(four0 && four0->obj)
+  {
+    pObj0 = WlzAssignObject(four0->obj, NULL);
+  }
+  else
+  {
+    pObj0 = WlzAssignObject(
+	    WlzPolarSample(obj0, cRot, angleInc, distInc,
+			   length, maxRadiusFlag,
+			   &wlzErr), NULL);
+    if(four0 && pObj0 && (wlzErr == WLZ_ERR_NONE))
+    {
+      four0->obj = WlzAssignObject(pObj0, NULL);
+    }
+  }
+  if((pObj0 == NULL) || (wlzErr != WLZ_ERR_NONE) ||
      ((pObj1 = WlzAssignObject(
      	       WlzPolarSample(obj1, cRot, angleInc, distInc,
 			      length, maxRadiusFlag,
@@ -153,10 +210,21 @@ RecError	RecRotMatch(double *angle, double *value,
       errFlag = REC_ERR_MALLOC;
     }
   }
+  if((errFlag == REC_ERR_NONE) && four0)
+  {
+    errFlag = RecFourCacheSet(four0, pObj0, origin, size, ppCtrl);
+    if(errFlag == REC_ERR_NONE)
+    {
+      (void )memcpy(*data0, *(four0->data),
+      		    size.vtX * size.vtY * sizeof(double));
+      sSq0 = four0->sSq;
+      ccFlags = REC_CCFLAG_DATA0VALID;
+    }
+  }
   if(errFlag == REC_ERR_NONE)
   {
     errFlag = RecCrossCorrelate(data0, data1, &sSq0, &sSq1,
-    			        REC_CCFLAG_NONE,
+    			        ccFlags,
     			        pObj0, pObj1, origin, size, ppCtrl);
     REC_DBG((REC_DBG_ROT|REC_DBG_LVL_2),
 	    ("RecRotMatch 03 %d %g %g\n",
@@ -185,7 +253,7 @@ RecError	RecRotMatch(double *angle, double *value,
     (void )AlcDouble2Free(data1);
   }
   REC_DBG((REC_DBG_ROT|REC_DBG_LVL_1|REC_DBG_LVL_FN),
-	  ("RecRotMatch FX %d\n",
+	  ("RecRotMatchCached FX %d\n",
 	   errFlag));
   return(errFlag);
 }
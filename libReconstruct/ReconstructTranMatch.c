@@ -67,9 +67,45 @@ RecError	RecTranMatch(WlzDVertex2 *shift, double *value,
 			      WlzObject *obj0, WlzObject *obj1,
 			      WlzIVertex2 maxShift,
 			      RecPPControl *ppCtrl)
+{
+  return(RecTranMatchCached(shift, value, obj0, obj1, maxShift, ppCtrl,
+  			    NULL));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	Reconstruct
+* \brief	Uses the cross correlation of the two given objects to
+*               find the shift (translation) which gives the best match
+*               (cross correlation maximum) between them, as for
+*               RecTranMatch(), but using a cache for the Fourier
+*               transform of the first object. The Fourier transform of
+*               the first object is only recomputed when the data origin
+*               or size, which depend on the bounding box of the second
+*               object, change.
+* \param	shift			Destination pointer for the
+*					cross-correlation peak position.
+* \param	value			Destination pointer for the
+*					cross-correlation peak value.
+* \param	obj0			First of two WLZ_2D_DOMAINOBJ objects.
+* \param	obj1			Second of two WLZ_2D_DOMAINOBJ objects.
+* \param	maxShift		Maximum shift.
+* \param	ppCtrl			Pre-processing control.
+* \param	four0			Fourier cache for the first object,
+*					which must only be used with this
+*					object and pre-processing control.
+*					May be NULL in which case no cache
+*					is used.
+*/
+RecError	RecTranMatchCached(WlzDVertex2 *shift, double *value,
+				   WlzObject *obj0, WlzObject *obj1,
+				   WlzIVertex2 maxShift,
+				   RecPPControl *ppCtrl,
+				   RecFourCache *four0)
 {
   WlzIBox2	objLim;
   RecError	errFlag = REC_ERR_NONE;
+  RecCcFlag	ccFlags = REC_CCFLAG_NONE;
   WlzIVertex2	origin,
 		size;
   double	sSq0,
@@ -79,10 +115,12 @@ RecError	RecTranMatch(WlzDVertex2 *shift, double *value,
   const WlzDVertex2 zeroCoord2D = {0.0, 0.0};
 
   REC_DBG((REC_DBG_LVL_1|REC_DBG_LVL_FN|REC_DBG_TRAN),
-	  ("RecTranMatch FE 0x%lx 0x%lx 0x%lx 0x%lx {%d %d} 0x%lx\n",
+	  ("RecTranMatchCached FE 0x%lx 0x%lx 0x%lx 0x%lx {%d %d} 0x%lx "
+	   "0x%lx\n",
 	   (unsigned long )shift, (unsigned long )value,
 	   (unsigned long )obj0, (unsigned long)obj1,
-	   maxShift.vtX, maxShift.vtY, (unsigned long )ppCtrl));
+	   maxShift.vtX, maxShift.vtY, (unsigned long )ppCtrl,
+	   (unsigned long )four0));
   REC_DBGW((REC_DBG_TRAN|REC_DBG_LVL_2), obj0, 0);
   REC_DBGW((REC_DBG_TRAN|REC_DBG_LVL_2), obj1, 0);
   *value = 0.0;
@@ -116,10 +154,21 @@ RecError	RecTranMatch(WlzDVertex2 *shift, double *value,
       errFlag = REC_ERR_MALLOC;
     }
   }
+  if((errFlag == REC_ERR_NONE) && four0)
+  {
+    errFlag = RecFourCacheSet(four0, obj0, origin, size, ppCtrl);
+    if(errFlag == REC_ERR_NONE)
+    {
+      (void )memcpy(*data0, *(four0->data),
+      		    size.vtX * size.vtY * sizeof(double));
+      sSq0 = four0->sSq;
+      ccFlags = REC_CCFLAG_DATA0VALID;
+    }
+  }
   if(errFlag == REC_ERR_NONE)
   {
     errFlag = RecCrossCorrelate(data0, data1, &sSq0, &sSq1,
-    			        REC_CCFLAG_NONE, obj0, obj1,
+    			        ccFlags, obj0, obj1,
     			        origin, size, ppCtrl);
   }
   if(errFlag == REC_ERR_NONE)
@@ -149,7 +198,7 @@ RecError	RecTranMatch(WlzDVertex2 *shift, double *value,
     (void )AlcDouble2Free(data1);
   }
   REC_DBG((REC_DBG_LVL_1|REC_DBG_LVL_FN|REC_DBG_TRAN),
-	  ("RecTranMatch FX %d\n",
+	  ("RecTranMatchCached FX %d\n",
 	   errFlag));
   return(errFlag);
 }
@@ -290,6 +290,26 @@ typedef struct
   RecReconstruction reconstruction;
 } RecSectionList;
 
+typedef struct
+{
+  WlzIVertex2	org;	      /* Origin of the data wrt the object, the data */
+  WlzIVertex2	size;	  /* and size of the data are only valid if non-NULL */
+  double	sSq;	       /* Sum of squares of the pre-processed object */
+  double	**data;		     /* Fourier transform of the object data */
+  WlzObject	*obj;	/* Object (eg polar sample) the data were found from */
+} RecFourCache;
+
+typedef struct
+{
+  WlzObject	*samObj;	    /* Sampled section image, NULL until set */
+  WlzObject	*ppObj;	      /* Pre-processed sampled image, NULL until set */
+  WlzDVertex2	cMass;		    /* Centre of mass of pre-processed image */
+  int		pAngleValid;	   /* Non-zero if the principal angle is set */
+  double	pAngle;		   /* Principal angle of pre-processed image */
+  RecFourCache	tranFour;	    /* Translation match data of the section */
+  RecFourCache	rotFour;	       /* Rotation match data of the section */
+} RecRegCache;
+
 typedef struct
 {
   RecMethod	method;
@@ -44,14 +44,90 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+#ifdef HAVE_MMAP
+#define WLZ_USE_MMAP
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 #ifndef WLZ_FAST_CODE
 #define WLZ_FAST_CODE
 #endif
 
+/*!
+* \def		WLZ_GETSUBSEC_BLKSZ
+* \ingroup	WlzSectionTransform
+* \brief	Width and height of the blocks in which sections through
+* 		tiled values are computed. The tiles touched by each
+* 		block are requested together.
+*/
+#define WLZ_GETSUBSEC_BLKSZ	(64)
+
+/*!
+* \def		WLZ_GETSUBSEC_TBUFSZ
+* \ingroup	WlzSectionTransform
+* \brief	Maximum number of tile indices gathered before the tiles
+* 		are requested.
+*/
+#define WLZ_GETSUBSEC_TBUFSZ	(1024)
+
+/*!
+* \def		WLZ_GETSUBSEC_NPIN
+* \ingroup	WlzSectionTransform
+* \brief	Number of tiles pinned by each block when the tiles are
+* 		loaded through a tile cache, which must be at least the
+* 		eight tiles that may be used for linear interpolation.
+*/
+#define WLZ_GETSUBSEC_NPIN	(8)
+
+static int		WlzGetSubSectionTileOffset(
+  WlzTiledValues	*tv,
+  WlzIVertex3		ntw,
+  int			px,
+  int			py,
+  int			pz,
+  size_t		*dstIdx,
+  size_t		*dstOff);
+static WlzGreyP		WlzGetSubSectionTiles(
+  WlzTiledValues	*tv,
+  WlzTileCacheEntry	**pin,
+  size_t		idx,
+  size_t		*off);
+static double		WlzGetSubSectionTileValD(
+  WlzTiledValues	*tv,
+  WlzTileCacheEntry	**pin,
+  WlzGreyType		gType,
+  WlzIVertex3		ntw,
+  int			px,
+  int			py,
+  int			pz,
+  double		bgdD);
+static void		WlzGetSubSectionTileVal8D(
+  WlzTiledValues	*tv,
+  WlzGreyP		tP,
+  WlzGreyType		gType,
+  size_t		off,
+  double		*gVal);
+#ifdef WLZ_USE_MMAP
+static void		WlzGetSubSectionTilePrefetch(
+  WlzTiledValues	*tv,
+  WlzThreeDViewStruct	*view,
+  WlzIVertex3		ntw,
+  WlzIBox2		blk,
+  size_t		tBytes,
+  size_t		pgSz);
+static void		WlzGetSubSectionTileAdvise(
+  WlzTiledValues	*tv,
+  int			*tBuf,
+  int			nT,
+  size_t		tBytes,
+  size_t		pgSz);
+#endif /* WLZ_USE_MMAP */
 static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
   WlzObject		*obj,
   WlzObject		*subDomain,
   WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
   WlzErrorNum		*dstErr);
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject 		*obj,
@@ -108,13 +184,14 @@ WlzObject 	*WlzGetSubSectionFromObject(
       case WLZ_3D_DOMAINOBJ:
 	if(obj->values.core &&
 	   (maskRtn == NULL) &&
-	   (interp == WLZ_INTERPOLATION_NEAREST) &&
+	   ((interp == WLZ_INTERPOLATION_NEAREST) ||
+	    (interp == WLZ_INTERPOLATION_LINEAR)) &&
 	   WlzGreyTableIsTiled(obj->values.core->type) &&
 	   (obj->values.t->tileWidth == 16) &&
 	   (obj->values.t->original_table.core == NULL))
 	{
 	  newObj = WlzGetSubSectionFrom3DTiledValueObj(obj, subDomain, view,
-	                                               &errNum);
+	                                               interp, &errNum);
 	}
 	else
 	{
@@ -142,6 +219,17 @@ WlzObject 	*WlzGetSubSectionFromObject(
 * 		values are required. Assumes a tile width of 16 voxels
 * 		and that there is a valid background value in that part
 * 		of each tile which falls outside of the object's domain.
+*
+* 		The section is computed in square blocks of
+* 		WLZ_GETSUBSEC_BLKSZ pixels which are processed in
+* 		parallel. When the tiles are memory mapped the tiles
+* 		touched by the section within each block are found
+* 		first and then requested from the file in tile (and
+* 		so file) order, before any values are read from them.
+* 		This bounds both the memory used and the number of
+* 		random reads required for a section through a very
+* 		large volume, while the tiles themselves remain in
+* 		the system's page cache for subsequent sections.
 * \param	obj			Given 3D object which is known to
 * 					be non-NULL, have non-NULL domain
 * 					and values with the values being
@@ -153,12 +241,16 @@ WlzObject 	*WlzGetSubSectionFromObject(
 * 					for the given object and view
 * 					transform.
 * \param	view			Given view transform.
+* \param	interp			Interpolation, must be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
   WlzObject		*obj,
   WlzObject		*subDomain,
   WlzThreeDViewStruct	*view,
+  WlzInterpolationType	interp,
   WlzErrorNum		*dstErr)
 {
   WlzObject		*dstObj = NULL;
@@ -242,8 +334,13 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
       case WLZ_GREY_SHORT:  /* FALLTHROUGH */
       case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
       case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
-      case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+	break;
       case WLZ_GREY_RGBA:
+	if(interp != WLZ_INTERPOLATION_NEAREST)
+	{
+	  errNum = WLZ_ERR_GREY_TYPE;
+	}
 	break;
       default:
 	errNum = WLZ_ERR_GREY_TYPE;
@@ -251,6 +348,18 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
     }
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST: /* FALLTHROUGH */
+      case WLZ_INTERPOLATION_LINEAR:
+	break;
+      default:
+	errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     if((dstVal.v = WlzNewValueTb(dstObj,
                                  WlzGreyValueTableType(0, WLZ_GREY_TAB_RECT,
@@ -260,16 +369,38 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
       dstObj->values = WlzAssignValues(dstVal, &errNum);
     }
   }
-  /* Set section values from tiles. */
+  /* Set section values from tiles, block by block. */
   if(errNum == WLZ_ERR_NONE)
   {
-    int		ln;
-    size_t	width;
+    int		idB,
+    		nBlk;
+    size_t	width,
+    		tBytes = 0,
+		pgSz = 0;
+    double	bgdD = 0.0;
     WlzGreyP	dstGP;
+    WlzIVertex2	nBlkXY;
     WlzIVertex3	ntw;
+    WlzPixelV	bgdPix;
 
     dstGP = dstObj->values.r->values;
     width = subBox.xMax - subBox.xMin + 1;
+    nBlkXY.vtX = (width + WLZ_GETSUBSEC_BLKSZ - 1) / WLZ_GETSUBSEC_BLKSZ;
+    nBlkXY.vtY = (subBox.yMax - subBox.yMin + WLZ_GETSUBSEC_BLKSZ) /
+                 WLZ_GETSUBSEC_BLKSZ;
+    nBlk = nBlkXY.vtX * nBlkXY.vtY;
+    if(gType != WLZ_GREY_RGBA)
+    {
+      (void )WlzValueConvertPixel(&bgdPix, bgd, WLZ_GREY_DOUBLE);
+      bgdD = bgdPix.v.dbv;
+    }
+#ifdef WLZ_USE_MMAP
+    if((tv->fd >= 0) || (tv->cache != NULL))
+    {
+      tBytes = tv->tileSz * tv->vpe * WlzGreySize(gType);
+      pgSz = sysconf(_SC_PAGESIZE);
+    }
+#endif /* WLZ_USE_MMAP */
 /*
  * Throughout this function WLZ_FAST_CODE assumes that the tiles are
  * 16 x 16 x 16 voxels.
@@ -284,165 +415,557 @@ static WlzObject	*WlzGetSubSectionFrom3DTiledValueObj(
     ntw.vtZ = tv->nIdx[2] * tv->tileWidth;
 #endif
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static, 256)
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
-    for(ln = subBox.yMin; ln <= subBox.yMax; ++ln)
+    for(idB = 0; idB < nBlk; ++idB)
     {
-      int         y,
-                  kl,
-                  lnRel;
-      WlzDVertex3 vty;
-      WlzGreyP	  lnGP;
+      int	ln;
+      WlzIBox2	blk;
+      WlzTileCacheEntry *pin[WLZ_GETSUBSEC_NPIN] = {NULL};
 
-      lnRel = ln - subBox.yMin;
-      switch(gType)
+      blk.xMin = subBox.xMin + (idB % nBlkXY.vtX) * WLZ_GETSUBSEC_BLKSZ;
+      blk.yMin = subBox.yMin + (idB / nBlkXY.vtX) * WLZ_GETSUBSEC_BLKSZ;
+      blk.xMax = ALG_MIN(blk.xMin + WLZ_GETSUBSEC_BLKSZ - 1, subBox.xMax);
+      blk.yMax = ALG_MIN(blk.yMin + WLZ_GETSUBSEC_BLKSZ - 1, subBox.yMax);
+#ifdef WLZ_USE_MMAP
+      if(tBytes > 0)
       {
-	case WLZ_GREY_INT:
-	  lnGP.inp = dstGP.inp + (width * lnRel);
-	  break;
-	case WLZ_GREY_SHORT:
-	  lnGP.shp = dstGP.shp + (width * lnRel);
-	  break;
-	case WLZ_GREY_UBYTE:
-	  lnGP.ubp = dstGP.ubp + (width * lnRel);
-	  break;
-	case WLZ_GREY_FLOAT:
-	  lnGP.flp = dstGP.flp + (width * lnRel);
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  lnGP.dbp = dstGP.dbp + (width * lnRel);
-	  break;
-	case WLZ_GREY_RGBA:
-	  lnGP.rgbp = dstGP.rgbp + (width * lnRel);
-	  break;
-	default:
-	  lnGP.v = NULL; 		    /* Just to keep compilers happy. */
-	  break;
+        WlzGetSubSectionTilePrefetch(tv, view, ntw, blk, tBytes, pgSz);
       }
-      y = ln - WLZ_NINT(view->minvals.vtY);
-      vty.vtX = view->yp_to_x[y];
-      vty.vtY = view->yp_to_y[y];
-      vty.vtZ = view->yp_to_z[y];
-      WlzValueSetGrey(lnGP, 0, bgd.v, gType, width);
-      for(kl = subBox.xMin; kl <= subBox.xMax; ++kl)
+#endif /* WLZ_USE_MMAP */
+      for(ln = blk.yMin; ln <= blk.yMax; ++ln)
       {
-	int   		x,
-			pz,
-			klRel;
-	double	        tz;
-
-	klRel = kl - subBox.xMin;
-	x = kl - WLZ_NINT(view->minvals.vtX);
-	tz = view->xp_to_z[x] + vty.vtZ;
-	pz = WLZ_NINT(tz) - tv->plane1;
-#ifdef WLZ_FAST_CODE
-	if((unsigned int)(pz) < (unsigned int)(ntw.vtZ))
-#else
-	if((pz >= 0) && (pz < ntw.vtZ))
-#endif
+	int	  y,
+		  kl;
+	size_t	  lnOff;
+	WlzDVertex3 vty;
+
+	lnOff = (width * (ln - subBox.yMin)) + (blk.xMin - subBox.xMin);
+	y = ln - WLZ_NINT(view->minvals.vtY);
+	vty.vtX = view->yp_to_x[y];
+	vty.vtY = view->yp_to_y[y];
+	vty.vtZ = view->yp_to_z[y];
+	WlzValueSetGrey(dstGP, lnOff, bgd.v, gType,
+	                blk.xMax - blk.xMin + 1);
+	for(kl = blk.xMin; kl <= blk.xMax; ++kl)
 	{
-	  int		iz,
-	                py;
-	  double	ty;
+	  int		x;
+	  size_t	off,
+	  		idx,
+	  		klOff;
+	  WlzDVertex3	t;
+	  WlzGreyP	tP;
 
-#ifdef WLZ_FAST_CODE
-          iz = pz >> 4;
-#else
-	  iz = pz / tv->tileWidth;
-#endif
-	  ty = view->xp_to_y[x] + vty.vtY;
-	  py = WLZ_NINT(ty) - tv->line1;
-#ifdef WLZ_FAST_CODE
-	  if((unsigned int)(py) < (unsigned int)(ntw.vtY))
-#else
-	  if((py >= 0) && (py < ntw.vtY))
-#endif
+	  klOff = lnOff + kl - blk.xMin;
+	  x = kl - WLZ_NINT(view->minvals.vtX);
+	  t.vtX = view->xp_to_x[x] + vty.vtX;
+	  t.vtY = view->xp_to_y[x] + vty.vtY;
+	  t.vtZ = view->xp_to_z[x] + vty.vtZ;
+	  if(interp == WLZ_INTERPOLATION_NEAREST)
 	  {
-	    int 	iy,
-	                px;
-	    double	tx;
+	    if(WlzGetSubSectionTileOffset(tv, ntw,
+					  WLZ_NINT(t.vtX) - tv->kol1,
+					  WLZ_NINT(t.vtY) - tv->line1,
+					  WLZ_NINT(t.vtZ) - tv->plane1,
+					  &idx, &off) &&
+	       ((tP = WlzGetSubSectionTiles(tv, pin, idx, &off)).v != NULL))
+	    {
+	      switch(gType)
+	      {
+		case WLZ_GREY_INT:
+		  dstGP.inp[klOff] = tP.inp[off];
+		  break;
+		case WLZ_GREY_SHORT:
+		  dstGP.shp[klOff] = tP.shp[off];
+		  break;
+		case WLZ_GREY_UBYTE:
+		  dstGP.ubp[klOff] = tP.ubp[off];
+		  break;
+		case WLZ_GREY_FLOAT:
+		  dstGP.flp[klOff] = tP.flp[off];
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  dstGP.dbp[klOff] = tP.dbp[off];
+		  break;
+		case WLZ_GREY_RGBA:
+		  dstGP.rgbp[klOff] = tP.rgbp[off];
+		  break;
+		default:
+		  break;
+	      }
+	    }
+	  }
+	  else /* interp == WLZ_INTERPOLATION_LINEAR */
+	  {
+	    int		idK,
+			idL,
+			idP;
+	    double	tD0;
+	    double	gVal[8];
+	    WlzIVertex3	p;
+	    WlzDVertex3	f0,
+			f1;
 
+	    p.vtX = (int )floor(t.vtX);
+	    p.vtY = (int )floor(t.vtY);
+	    p.vtZ = (int )floor(t.vtZ);
+	    f0.vtX = t.vtX - p.vtX;
+	    f0.vtY = t.vtY - p.vtY;
+	    f0.vtZ = t.vtZ - p.vtZ;
+	    f1.vtX = 1.0 - f0.vtX;
+	    f1.vtY = 1.0 - f0.vtY;
+	    f1.vtZ = 1.0 - f0.vtZ;
+	    p.vtX -= tv->kol1;
+	    p.vtY -= tv->line1;
+	    p.vtZ -= tv->plane1;
+	    if(WlzGetSubSectionTileOffset(tv, ntw, p.vtX, p.vtY, p.vtZ,
+	                                  &idx, &off) &&
 #ifdef WLZ_FAST_CODE
-	    iy = py >> 4;
-#else
-	    iy = py / tv->tileWidth;
-#endif
-	    tx = view->xp_to_x[x] + vty.vtX;
-	    px = WLZ_NINT(tx) - tv->kol1;
-#ifdef WLZ_FAST_CODE
-	  if((unsigned int)(px) < (unsigned int)(ntw.vtX))
+	       ((p.vtX & 15) < 15) && ((p.vtY & 15) < 15) &&
+	       ((p.vtZ & 15) < 15))
 #else
-	    if((px >= 0) && (px < ntw.vtX))
+	       ((p.vtX % tv->tileWidth) < tv->tileWidth - 1) &&
+	       ((p.vtY % tv->tileWidth) < tv->tileWidth - 1) &&
+	       ((p.vtZ % tv->tileWidth) < tv->tileWidth - 1))
 #endif
 	    {
-	      size_t	ix,
-	      		idx;
+	      /* All eight neighbours are within the same tile. */
+	      if((tP = WlzGetSubSectionTiles(tv, pin, idx, &off)).v != NULL)
+	      {
+	        WlzGetSubSectionTileVal8D(tv, tP, gType, off, gVal);
+	      }
+	      else
+	      {
+	        for(idK = 0; idK < 8; ++idK)
+		{
+		  gVal[idK] = bgdD;
+		}
+	      }
+	    }
+	    else
+	    {
+	      for(idP = 0; idP < 2; ++idP)
+	      {
+		for(idL = 0; idL < 2; ++idL)
+		{
+		  for(idK = 0; idK < 2; ++idK)
+		  {
+		    gVal[(((idP << 1) + idL) << 1) + idK] =
+			WlzGetSubSectionTileValD(tv, pin, gType, ntw,
+						 p.vtX + idK, p.vtY + idL,
+						 p.vtZ + idP, bgdD);
+		  }
+		}
+	      }
+	    }
+	    tD0 = (gVal[0] * f1.vtX * f1.vtY * f1.vtZ) +
+		  (gVal[1] * f0.vtX * f1.vtY * f1.vtZ) +
+		  (gVal[2] * f1.vtX * f0.vtY * f1.vtZ) +
+		  (gVal[3] * f0.vtX * f0.vtY * f1.vtZ) +
+		  (gVal[4] * f1.vtX * f1.vtY * f0.vtZ) +
+		  (gVal[5] * f0.vtX * f1.vtY * f0.vtZ) +
+		  (gVal[6] * f1.vtX * f0.vtY * f0.vtZ) +
+		  (gVal[7] * f0.vtX * f0.vtY * f0.vtZ);
+	    /* Clamp and round as in WlzGetSubSectionFrom3DDomObj(). */
+	    switch(gType)
+	    {
+	      case WLZ_GREY_INT:
+		tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
+		dstGP.inp[klOff] = WLZ_NINT(tD0);
+		break;
+	      case WLZ_GREY_SHORT:
+		tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+		dstGP.shp[klOff] = WLZ_NINT(tD0);
+		break;
+	      case WLZ_GREY_UBYTE:
+		tD0 = WLZ_CLAMP(tD0, 0, 255);
+		dstGP.ubp[klOff] = WLZ_NINT(tD0);
+		break;
+	      case WLZ_GREY_FLOAT:
+		dstGP.flp[klOff] = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
+		break;
+	      case WLZ_GREY_DOUBLE:
+		dstGP.dbp[klOff] = WLZ_NINT(tD0);
+		break;
+	      default:
+		break;
+	    }
+	  }
+	}
+      }
+      WlzTileCacheUnpin(pin, WLZ_GETSUBSEC_NPIN);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \return	Non-zero if the given position is within a tile.
+* \ingroup	WlzSectionTransform
+* \brief	Finds the tile index and value offset of the voxel at the
+* 		given position, which is relative to the first column,
+* 		line and plane of the tiled values.
+* \param	tv			Given tiled values.
+* \param	ntw			Number of voxels covered by the tile
+* 					index along each axis.
+* \param	px			Column relative to the tiled values.
+* \param	py			Line relative to the tiled values.
+* \param	pz			Plane relative to the tiled values.
+* \param	dstIdx			Destination pointer for the tile
+* 					index, must not be NULL.
+* \param	dstOff			Destination pointer for the offset
+* 					of the voxel's value(s) from the
+* 					start of the tiles, may be NULL.
+*/
+static int	WlzGetSubSectionTileOffset(
+  WlzTiledValues	*tv,
+  WlzIVertex3		ntw,
+  int			px,
+  int			py,
+  int			pz,
+  size_t		*dstIdx,
+  size_t		*dstOff)
+{
+  int		inside = 0;
 
 #ifdef WLZ_FAST_CODE
-              ix = px >> 4;
+  if(((unsigned int )(px) < (unsigned int )(ntw.vtX)) &&
+     ((unsigned int )(py) < (unsigned int )(ntw.vtY)) &&
+     ((unsigned int )(pz) < (unsigned int )(ntw.vtZ)))
 #else
-	      ix = px / tv->tileWidth;
+  if((px >= 0) && (px < ntw.vtX) &&
+     (py >= 0) && (py < ntw.vtY) &&
+     (pz >= 0) && (pz < ntw.vtZ))
 #endif
-	      idx = ((iz * tv->nIdx[1] + iy) * tv->nIdx[0]) + ix;
-	      idx = *(tv->indices + idx);
+  {
+    size_t	idx;
+
 #ifdef WLZ_FAST_CODE
-              if((unsigned int)(idx) < (unsigned int)(tv->numTiles))
+    idx = (((pz >> 4) * tv->nIdx[1] + (py >> 4)) * tv->nIdx[0]) + (px >> 4);
 #else
-	      if((idx >= 0) && (idx < tv->numTiles))
+    idx = (((pz / tv->tileWidth) * tv->nIdx[1] + (py / tv->tileWidth)) *
+           tv->nIdx[0]) + (px / tv->tileWidth);
 #endif
-	      {
-		size_t   off;
+    idx = *(tv->indices + idx);
+    if(idx < tv->numTiles)
+    {
+      inside = 1;
+      *dstIdx = idx;
+      if(dstOff)
+      {
+	size_t	off;
 
 #ifdef WLZ_FAST_CODE
-		off = (idx  << 12) +
-		      ((((pz & 15) << 4) + (py & 15)) << 4) + (px & 15);
+	off = (idx  << 12) +
+	      ((((pz & 15) << 4) + (py & 15)) << 4) + (px & 15);
 #else
-		WlzIVertex3 tOff;
-
-		tOff.vtX = px % tv->tileWidth;
-		tOff.vtY = py % tv->tileWidth;
-		tOff.vtZ = pz % tv->tileWidth;
-		off = (idx * tv->tileSz) +
-		      ((tOff.vtZ * tv->tileWidth + tOff.vtY) *
-		       tv->tileWidth) + tOff.vtX;
+	off = (idx * tv->tileSz) +
+	      (((pz % tv->tileWidth) * tv->tileWidth + (py % tv->tileWidth)) *
+	       tv->tileWidth) + (px % tv->tileWidth);
 #endif
-		off *= tv->vpe;
-		switch(gType)
-		{
-	          case WLZ_GREY_INT:
-		    lnGP.inp[klRel] = tv->tiles.inp[off];
-		    break;
-	          case WLZ_GREY_SHORT:
-		    lnGP.shp[klRel] = tv->tiles.shp[off];
-		    break;
-	          case WLZ_GREY_UBYTE:
-		    lnGP.ubp[klRel] = tv->tiles.ubp[off];
-		    break;
-	          case WLZ_GREY_FLOAT:
-		    lnGP.flp[klRel] = tv->tiles.flp[off];
-		    break;
-	          case WLZ_GREY_DOUBLE:
-		    lnGP.dbp[klRel] = tv->tiles.dbp[off];
-		    break;
-	          case WLZ_GREY_RGBA:
-		    lnGP.rgbp[klRel] = tv->tiles.rgbp[off];
-		    break;
-		  default:
-		    break;
-		}
-	      }
-	    }
-	  }
+	*dstOff = off * tv->vpe;
+      }
+    }
+  }
+  return(inside);
+}
+
+/*!
+* \return	Tiles or NULL if the tile could not be loaded.
+* \ingroup	WlzSectionTransform
+* \brief	Gets the tiles to be used with the given tile index and
+* 		offset, as found by WlzGetSubSectionTileOffset(). If the
+* 		tiles are loaded through a cache then the tile is pinned
+* 		and the offset is made relative to the tile.
+* \param	tv			Given tiled values.
+* \param	pin			Tiles pinned by the block.
+* \param	idx			Tile index.
+* \param	off			Offset, which may be modified.
+*/
+static WlzGreyP	WlzGetSubSectionTiles(
+  WlzTiledValues	*tv,
+  WlzTileCacheEntry	**pin,
+  size_t		idx,
+  size_t		*off)
+{
+  WlzGreyP	tP;
+
+  if(tv->cache)
+  {
+    tP = WlzTileCachePin(tv, pin, WLZ_GETSUBSEC_NPIN, idx);
+    *off -= idx * tv->tileSz * tv->vpe;
+  }
+  else
+  {
+    tP = tv->tiles;
+  }
+  return(tP);
+}
+
+/*!
+* \return	Value at the given position or the background value if
+* 		the position is not within a tile.
+* \ingroup	WlzSectionTransform
+* \brief	Gets a (non-RGBA) tiled value as a double.
+* \param	tv			Given tiled values.
+* \param	pin			Tiles pinned by the block if the
+* 					tiles are loaded through a cache.
+* \param	gType			Grey type of the tiled values.
+* \param	ntw			Number of voxels covered by the tile
+* 					index along each axis.
+* \param	px			Column relative to the tiled values.
+* \param	py			Line relative to the tiled values.
+* \param	pz			Plane relative to the tiled values.
+* \param	bgdD			Background value.
+*/
+static double	WlzGetSubSectionTileValD(
+  WlzTiledValues	*tv,
+  WlzTileCacheEntry	**pin,
+  WlzGreyType		gType,
+  WlzIVertex3		ntw,
+  int			px,
+  int			py,
+  int			pz,
+  double		bgdD)
+{
+  size_t	idx,
+  		off;
+  double	val;
+  WlzGreyP	tP;
+
+  val = bgdD;
+  if(WlzGetSubSectionTileOffset(tv, ntw, px, py, pz, &idx, &off) &&
+     ((tP = WlzGetSubSectionTiles(tv, pin, idx, &off)).v != NULL))
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+	val = tP.inp[off];
+	break;
+      case WLZ_GREY_SHORT:
+	val = tP.shp[off];
+	break;
+      case WLZ_GREY_UBYTE:
+	val = tP.ubp[off];
+	break;
+      case WLZ_GREY_FLOAT:
+	val = tP.flp[off];
+	break;
+      case WLZ_GREY_DOUBLE:
+	val = tP.dbp[off];
+	break;
+      default:
+	break;
+    }
+  }
+  return(val);
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Gets the eight (non-RGBA) tiled values of the voxel at
+* 		the given offset and its neighbours with greater column,
+* 		line and plane, which are known to be within the same
+* 		tile, as doubles in the order used for trilinear
+* 		interpolation.
+* \param	tv			Given tiled values.
+* \param	tP			Tiles as given by
+* 					WlzGetSubSectionTiles().
+* \param	gType			Grey type of the tiled values.
+* \param	off			Offset of the first voxel's value
+* 					from the start of the tiles.
+* \param	gVal			Destination for the eight values.
+*/
+static void	WlzGetSubSectionTileVal8D(
+  WlzTiledValues	*tv,
+  WlzGreyP		tP,
+  WlzGreyType		gType,
+  size_t		off,
+  double		*gVal)
+{
+  int		idV;
+  size_t	sX,
+  		sY,
+		sZ;
+  size_t	vOff[8];
+
+  sX = tv->vpe;
+  sY = sX * tv->tileWidth;
+  sZ = sY * tv->tileWidth;
+  for(idV = 0; idV < 8; ++idV)
+  {
+    vOff[idV] = off + ((idV & 1)? sX: 0) + ((idV & 2)? sY: 0) +
+                ((idV & 4)? sZ: 0);
+  }
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(idV = 0; idV < 8; ++idV)
+      {
+        gVal[idV] = tP.inp[vOff[idV]];
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idV = 0; idV < 8; ++idV)
+      {
+        gVal[idV] = tP.shp[vOff[idV]];
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idV = 0; idV < 8; ++idV)
+      {
+        gVal[idV] = tP.ubp[vOff[idV]];
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idV = 0; idV < 8; ++idV)
+      {
+        gVal[idV] = tP.flp[vOff[idV]];
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(idV = 0; idV < 8; ++idV)
+      {
+        gVal[idV] = tP.dbp[vOff[idV]];
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+#ifdef WLZ_USE_MMAP
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Finds the memory mapped or cached tiles which are needed
+* 		for the given block of a section and requests them, so
+* 		that they are read from the file in tile order rather
+* 		than as each is touched.
+* 		Only the tile containing the nearest voxel to each
+* 		pixel is found, any further tiles used for linear
+* 		interpolation are within a voxel of the section and
+* 		are almost always found for a neighbouring pixel.
+* \param	tv			Given tiled values with memory
+* 					mapped or cached tiles.
+* \param	view			Given view transform.
+* \param	ntw			Number of voxels covered by the tile
+* 					index along each axis.
+* \param	blk			Block of the section.
+* \param	tBytes			Number of bytes in each tile.
+* \param	pgSz			System page size.
+*/
+static void	WlzGetSubSectionTilePrefetch(
+  WlzTiledValues	*tv,
+  WlzThreeDViewStruct	*view,
+  WlzIVertex3		ntw,
+  WlzIBox2		blk,
+  size_t		tBytes,
+  size_t		pgSz)
+{
+  int		ln,
+  		nT = 0;
+  size_t	lastIdx;
+  int		tBuf[WLZ_GETSUBSEC_TBUFSZ];
+
+  lastIdx = tv->numTiles;
+  for(ln = blk.yMin; ln <= blk.yMax; ++ln)
+  {
+    int		y,
+    		kl;
+
+    y = ln - WLZ_NINT(view->minvals.vtY);
+    for(kl = blk.xMin; kl <= blk.xMax; ++kl)
+    {
+      int	  x;
+      size_t	  idx;
+      WlzIVertex3 p;
+
+      x = kl - WLZ_NINT(view->minvals.vtX);
+      p.vtX = WLZ_NINT(view->xp_to_x[x] + view->yp_to_x[y]) - tv->kol1;
+      p.vtY = WLZ_NINT(view->xp_to_y[x] + view->yp_to_y[y]) - tv->line1;
+      p.vtZ = WLZ_NINT(view->xp_to_z[x] + view->yp_to_z[y]) - tv->plane1;
+      if(WlzGetSubSectionTileOffset(tv, ntw, p.vtX, p.vtY, p.vtZ,
+				    &idx, NULL) &&
+	 (idx != lastIdx))
+      {
+	if(nT >= WLZ_GETSUBSEC_TBUFSZ)
+	{
+	  WlzGetSubSectionTileAdvise(tv, tBuf, nT, tBytes, pgSz);
+	  nT = 0;
 	}
+	lastIdx = idx;
+	tBuf[nT++] = (int )idx;
       }
     }
   }
-  if(dstErr)
+  if(nT > 0)
   {
-    *dstErr = errNum;
+    WlzGetSubSectionTileAdvise(tv, tBuf, nT, tBytes, pgSz);
+  }
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Sorts the given tile indices and then advises the system
+* 		that each run of contiguous tiles will be needed soon.
+* 		If the tiles are loaded through a tile cache then each
+* 		tile is loaded into the cache instead.
+* \param	tv			Given tiled values with memory
+* 					mapped or cached tiles.
+* \param	tBuf			Buffer of tile indices, which may
+* 					contain duplicates and is sorted
+* 					in place.
+* \param	nT			Number of tile indices in the buffer.
+* \param	tBytes			Number of bytes in each tile.
+* \param	pgSz			System page size.
+*/
+static void	WlzGetSubSectionTileAdvise(
+  WlzTiledValues	*tv,
+  int			*tBuf,
+  int			nT,
+  size_t		tBytes,
+  size_t		pgSz)
+{
+  int		idT = 0;
+
+  (void )AlgHeapSort(tBuf, nT, sizeof(int), AlgHeapSortCmpIFn);
+  while(idT < nT)
+  {
+    int		idR;
+    size_t	first,
+    		last;
+
+    idR = idT;
+    while((idR + 1 < nT) && (tBuf[idR + 1] <= tBuf[idR] + 1))
+    {
+      ++idR;
+    }
+    if(tv->cache)
+    {
+      for(; idT <= idR; ++idT)
+      {
+	if((idT == 0) || (tBuf[idT] != tBuf[idT - 1]))
+	{
+	  WlzTileCacheRelease(WlzTileCacheAcquire(tv, tBuf[idT], NULL));
+	}
+      }
+    }
+    else
+    {
+      first = tBuf[idT] * tBytes;
+      last = (tBuf[idR] + 1) * tBytes;
+      first -= first % pgSz;
+      (void )madvise((char *)(tv->tiles.v) + first, last - first,
+		     MADV_WILLNEED);
+      idT = idR + 1;
+    }
   }
-  return(dstObj);
 }
+#endif /* WLZ_USE_MMAP */
 
 #define WLZ_GETSUBSEC_POS(P,V,X,Y) \
   (P).vtX = (V)->xp_to_x[(X)] + (Y).vtX; \
@@ -1004,6 +1004,77 @@ WlzBSpline	*WlzAffineTransformBSpline(WlzBSpline *srcBS,
   return(dstBS);
 }
 
+/*!
+* \ingroup	WlzTransform
+* \return				Transformed indexed mesh or
+*					NULL on error.
+* \brief	Transforms the vertices of the given indexed mesh, the
+*		elements are unchanged.
+* \param	srcMesh		 	Given indexed mesh.
+* \param	tr			Given 3D affine transform.
+* \param	newMeshFlg		Make a new indexed mesh if non-zero,
+*					otherwise transform the given
+*					mesh in place.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzIdxMesh	*WlzAffineTransformIdxMesh(WlzIdxMesh *srcMesh,
+					   WlzAffineTransform *tr,
+					   int newMeshFlg,
+					   WlzErrorNum *dstErr)
+{
+  WlzIdxMesh 	*dstMesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srcMesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(tr == NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_NULL;
+  }
+  else if(WlzAffineTransformDimension(tr, NULL) != 3)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else
+  {
+    dstMesh = (newMeshFlg)? WlzIdxMeshCopy(srcMesh, &errNum): srcMesh;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idV;
+    double	**m;
+
+    /* The vertices are independent so transform them directly using
+     * the matrix rather than per vertex function calls. */
+    m = tr->mat;
+#ifdef _OPENMP
+#pragma omp parallel for if(dstMesh->nVtx > 65536)
+#endif
+    for(idV = 0; idV < dstMesh->nVtx; ++idV)
+    {
+      double	*v;
+      double	x,
+      		y,
+		z;
+
+      v = dstMesh->vtx + 3 * idV;
+      x = v[0];
+      y = v[1];
+      z = v[2];
+      v[0] = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+      v[1] = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+      v[2] = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstMesh);
+}
+
 /*!
 * \ingroup	WlzTransform
 * \return				Transformed model or
@@ -3470,6 +3541,7 @@ WlzObject	*WlzAffineTransformObjCb(WlzObject *srcObj,
       case WLZ_CMESH_3D:
       case WLZ_POINTS:
       case WLZ_SPLINE:
+      case WLZ_IDXMESH:
       case WLZ_TRANS_OBJ:
       case WLZ_AFFINE_TRANS:
 	if(srcObj->domain.core == NULL)
@@ -3525,6 +3597,10 @@ WlzObject	*WlzAffineTransformObjCb(WlzObject *srcObj,
 	      dstDom.bs = WlzAffineTransformBSpline(srcObj->domain.bs, trans,
 	      					    1, &errNum);
 	      break;
+	    case WLZ_IDXMESH:
+	      dstDom.idm = WlzAffineTransformIdxMesh(srcObj->domain.idm,
+	      					     trans, 1, &errNum);
+	      break;
 	    default:
 	      errNum = WLZ_ERR_OBJECT_TYPE;
 	      break;
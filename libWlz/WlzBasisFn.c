@@ -60,6 +60,172 @@ typedef struct	_WlzBasisFnMapData3D
   WlzCMeshNod3D *nod[4];
 } WlzBasisFnMapData3D;
 
+/*!
+* \def		WLZ_BASISFN_ITR_LGR
+* \ingroup	WlzFunction
+* \brief	Number of control points in each of the local Lagrange
+* 		functions of the preconditioner used when solving the
+* 		basis function design equations iteratively.
+*/
+#define WLZ_BASISFN_ITR_LGR	(30)
+
+/*!
+* \def		WLZ_BASISFN_ITR_CRS
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points in the coarse level of
+* 		the preconditioner used when solving the basis function
+* 		design equations iteratively. This must not be less than
+* 		WLZ_BASISFN_ITR_LGR.
+*/
+#define WLZ_BASISFN_ITR_CRS	(256)
+
+/*!
+* \def		WLZ_BASISFN_ITR_REG
+* \ingroup	WlzFunction
+* \brief	Regularisation of the local design equations of the
+* 		preconditioner, relative to the maximum absolute basis
+* 		function value in them.
+*/
+#define WLZ_BASISFN_ITR_REG	(1.0e-08)
+
+/*!
+* \def		WLZ_BASISFN_BATCH_DEG2
+* \ingroup	WlzFunction
+* \brief	Degree of the Chebyshev interpolants used to approximate the
+* 		far field of a 2D basis function within a box of vertices.
+*/
+#define WLZ_BASISFN_BATCH_DEG2	(9)
+
+/*!
+* \def		WLZ_BASISFN_BATCH_DEG3
+* \ingroup	WlzFunction
+* \brief	Degree of the Chebyshev interpolants used to approximate the
+* 		far field of a 3D basis function within a box of vertices.
+*/
+#define WLZ_BASISFN_BATCH_DEG3	(5)
+
+/*!
+* \def		WLZ_BASISFN_BATCH_BOXQ
+* \ingroup	WlzFunction
+* \brief	Maximum number of vertices in each of the boxes which are
+* 		evaluated in parallel. Boxes may be further sub-divided
+* 		when approximating.
+*/
+#define WLZ_BASISFN_BATCH_BOXQ	(4096)
+
+/*!
+* \def		WLZ_BASISFN_BATCH_SEP
+* \ingroup	WlzFunction
+* \brief	Control points which are closer to a box of vertices than
+* 		this multiple of the box's half diagonal are in the box's
+* 		near field and are always summed directly.
+*/
+#define WLZ_BASISFN_BATCH_SEP	(1.0)
+
+/*!
+* \struct	_WlzBasisFnBatch
+* \ingroup	WlzFunction
+* \brief	Control points and basis function coefficients held as
+* 		separate contiguous arrays so that the inner evaluation
+* 		loops are simple enough to be vectorised by the compiler,
+* 		along with the parameters of the batch evaluation.
+*/
+typedef struct _WlzBasisFnBatch
+{
+  WlzFnType	type;			/*!< Basis function type. */
+  int		dim;			/*!< Dimension, 2 or 3. */
+  int		nPnt;			/*!< Number of control points. */
+  int		deg;			/*!< Degree of the Chebyshev
+  					     interpolants. */
+  int		nPrx;			/*!< Number of proxy points in each
+  					     box, \f$(deg + 1)^{dim}\f$. */
+  double	delta;			/*!< Basis function parameter. */
+  double	tol;			/*!< Absolute error bound, zero for
+  					     exact evaluation. */
+  double	*pos[3];		/*!< Control point coordinates. */
+  double	*co[3];			/*!< Basis function coefficients. */
+  double	*cheb;			/*!< Table of
+  					     \f$\cos(\pi k (j + 1/2) / m)\f$
+					     indexed by \f$k m + j\f$ with
+					     \f$m = deg + 1\f$. */
+} WlzBasisFnBatch;
+
+/*!
+* \struct	_WlzBasisFnBatchWSp
+* \ingroup	WlzFunction
+* \brief	Workspace used to evaluate a box of vertices.
+*/
+typedef struct _WlzBasisFnBatchWSp
+{
+  int		nNear;			/*!< Number of near field control
+  					     points. */
+  int		nFar;			/*!< Number of far field control
+  					     points. */
+  double	*near[6];		/*!< Near field control point
+  					     coordinates then coefficients. */
+  double	*far[6];		/*!< Far field control point
+  					     coordinates then coefficients. */
+  double	*val[3];		/*!< Far field values at the proxy
+  					     points then Chebyshev
+					     coefficients. */
+  double	*tmp;			/*!< Workspace for the Chebyshev
+  					     transforms. */
+} WlzBasisFnBatchWSp;
+
+/*!
+* \struct	_WlzBasisFnItrOp
+* \ingroup	WlzFunction
+* \brief	Operator used by the iterative solution of the basis
+* 		function design equations. The polynomial part of the
+* 		design equations is eliminated by projecting onto the
+* 		orthogonal complement of the polynomial space, leaving a
+* 		definite system for the basis function coefficients.
+*/
+typedef struct _WlzBasisFnItrOp
+{
+  int		n;			/*!< Number of control points. */
+  int		dim;			/*!< Dimension, 2 or 3. */
+  int		nPoly;			/*!< Number of polynomial terms,
+  					     \f$dim + 1\f$. */
+  double	sgn;			/*!< Sign which makes the projected
+  					     system positive definite. */
+  double	scale;			/*!< Scale of the basis function
+  					     sums used by the evaluation
+					     functions. */
+  double	tol;			/*!< Absolute error bound for
+  					     approximate products, zero for
+					     exact products. */
+  double	*q[4];			/*!< Orthonormal basis for the
+  					     polynomial space. */
+  int		*row;			/*!< Sparse matrix row offsets,
+  					     only used for compactly
+					     supported basis functions. */
+  int		*col;			/*!< Sparse matrix column indices. */
+  double	*val;			/*!< Sparse matrix values. */
+  int		nLgr;			/*!< Number of local Lagrange
+  					     functions. */
+  int		*lgrIdx;		/*!< Control point indices of the
+  					     local Lagrange functions, with
+					     WLZ_BASISFN_ITR_LGR for each. */
+  double	*lgrCo;			/*!< Scaled coefficients of the local
+  					     Lagrange functions. */
+  double	*lgrBuf;		/*!< Workspace for the local Lagrange
+  					     functions, with one vector for
+					     each component. */
+  int		nCrs;			/*!< Number of coarse level control
+  					     points. */
+  int		*crsIdx;		/*!< Coarse level control point
+  					     indices. */
+  double	*crsMat;		/*!< Dense coarse level matrix. */
+  double	*crsBuf;		/*!< Workspace for the coarse level,
+  					     with one vector for each
+					     component. */
+  WlzBasisFnBatch *bat;			/*!< Batch evaluation data used for
+  					     the products and to hold the
+					     projected coefficients. */
+  WlzErrorNum	errNum;			/*!< Error from the products. */
+} WlzBasisFnItrOp;
+
 static void			WlzBasisFnEditSV(
 				  int n,
 				  double *vV);
@@ -134,6 +300,91 @@ static WlzDVertex2 		WlzBasisFnValueRedPoly2D(
 static WlzDVertex3      	WlzBasisFnValueRedPoly3D(
                                   WlzDVertex3 *poly,
 				  WlzDVertex3 srcVx);
+static void			WlzBasisFnBatchBox(
+				  WlzBasisFnBatch *bat,
+				  WlzBasisFnBatchWSp *wSp,
+				  int *qIdx,
+				  int cnt,
+				  double **qry,
+				  double **out);
+static void			WlzBasisFnBatchExact(
+				  WlzBasisFnBatch *bat,
+				  int *qIdx,
+				  int cnt,
+				  double **qry,
+				  double **out);
+static void			WlzBasisFnBatchFree(
+				  WlzBasisFnBatch *bat);
+static void			WlzBasisFnBatchSum(
+				  WlzBasisFnBatch *bat,
+				  int n,
+				  double **pc,
+				  const double *p,
+				  double *sum);
+static int			WlzBasisFnBatchSplit(
+				  int *qIdx,
+				  int cnt,
+				  double **qry,
+				  int dim,
+				  int *dstAxis);
+static WlzErrorNum		WlzBasisFnBatchEval(
+				  WlzBasisFnBatch *bat,
+				  int nQ,
+				  double **qry,
+				  double **out);
+static WlzBasisFnBatch		*WlzBasisFnBatchMake(
+				  WlzBasisFn *basisFn,
+				  int dim,
+				  WlzErrorNum *dstErr);
+static void			WlzBasisFnItrKernel(
+				  WlzBasisFnItrOp *op,
+				  double **x,
+				  double **y);
+static void			WlzBasisFnItrProduct(
+				  void *data,
+				  double **x,
+				  double **y);
+static double			WlzBasisFnItrPhi(
+				  WlzFnType type,
+				  double delta,
+				  double s);
+static void			WlzBasisFnItrPrecon(
+				  void *data,
+				  double **r,
+				  double **z);
+static WlzErrorNum		WlzBasisFnItrPreconMake(
+				  WlzBasisFnItrOp *op,
+				  WlzFnType type);
+static WlzErrorNum		WlzBasisFnItrPreconSet(
+				  WlzBasisFnItrOp *op,
+				  WlzFnType type,
+				  int b,
+				  int *bI,
+				  double *m);
+static void			WlzBasisFnItrNearest(
+				  WlzBasisFnItrOp *op,
+				  int *head,
+				  int *next,
+				  int *nCA,
+				  double *pMin,
+				  double cSz,
+				  int p,
+				  int nNbr,
+				  int *nbr);
+static void			WlzBasisFnItrProject(
+				  WlzBasisFnItrOp *op,
+				  double *x);
+static WlzErrorNum		WlzBasisFnItrSolve(
+				  WlzBasisFn *basisFn,
+				  int dim,
+				  double **rhs,
+				  double tol,
+				  int maxItr);
+static WlzErrorNum		WlzBasisFnItrSparse(
+				  WlzBasisFnItrOp *op);
+static int			WlzBasisFnItrKeyCmp(
+				  const void *p0,
+				  const void *p1);
 static WlzHistogramDomain 	*WlzBasisFnScalarMOS3DEvalTb(
 				  int nPts,
 				  WlzDVertex3 *cPts,
@@ -782,6 +1033,377 @@ double          WlzBasisFnValueMOSPhi(double r, double delta, double tau)
   return(phi);
 }
 
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the value for the given vertex using a 2D
+*		compactly supported basis function. This is the Wendland
+*		\f$C^2\f$ function
+*		\f$\phi(r) = (1 - r/\rho)_+^4 (4 r/\rho + 1)\f$
+*		with support radius \f$\rho\f$.
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex2 	WlzBasisFnValueCS2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		rhoSq,
+		rhoInv;
+  WlzDVertex2    *basisCo,
+		*cPts;
+  WlzDVertex2    polyVx,
+  		newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  cPts = basisFn->vertices.d2;
+  basisCo = basisFn->basis.d2;
+  tD0 = *((double *)(basisFn->param));
+  rhoSq = tD0 * tD0;
+  rhoInv = 1.0 / tD0;
+  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  {
+    tD0 = srcVx.vtX - cPts->vtX;
+    tD1 = srcVx.vtY - cPts->vtY;
+    tD0 = (tD0 * tD0) + (tD1 * tD1);
+    if(tD0 < rhoSq)
+    {
+      tD0 = sqrt(tD0) * rhoInv;
+      tD1 = (1.0 - tD0) * (1.0 - tD0);
+      tD0 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+    }
+    ++cPts;
+    ++basisCo;
+  }
+  polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
+  newVx.vtX += polyVx.vtX;
+  newVx.vtY += polyVx.vtY;
+  return(newVx);
+}
+
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the value for the given vertex using a 3D
+*		compactly supported basis function, see
+*		WlzBasisFnValueCS2D().
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex3 	WlzBasisFnValueCS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		tD2,
+		rhoSq,
+		rhoInv;
+  WlzDVertex3    *basisCo,
+		*cPts;
+  WlzDVertex3    polyVx,
+  		newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  newVx.vtZ = 0.0;
+  cPts = basisFn->vertices.d3;
+  basisCo = basisFn->basis.d3;
+  tD0 = *((double *)(basisFn->param));
+  rhoSq = tD0 * tD0;
+  rhoInv = 1.0 / tD0;
+  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  {
+    tD0 = srcVx.vtX - cPts->vtX;
+    tD1 = srcVx.vtY - cPts->vtY;
+    tD2 = srcVx.vtZ - cPts->vtZ;
+    tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+    if(tD0 < rhoSq)
+    {
+      tD0 = sqrt(tD0) * rhoInv;
+      tD1 = (1.0 - tD0) * (1.0 - tD0);
+      tD0 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+    }
+    ++cPts;
+    ++basisCo;
+  }
+  polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
+  newVx.vtX += polyVx.vtX;
+  newVx.vtY += polyVx.vtY;
+  newVx.vtZ += polyVx.vtZ;
+  return(newVx);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Evaluates the given 2D basis function at each of the given
+*		vertices. This is equivalent to calling the appropriate
+*		single vertex evaluation function, eg WlzBasisFnValueTPS2D(),
+*		for each vertex but is much faster for large numbers of
+*		vertices. The control points and vertices are copied into
+*		contiguous arrays and the vertices are evaluated in parallel.
+*		If the basis function's evalTol is greater than zero and
+*		it is a TPS, MQ or IMQ basis function without an
+*		alternative distance function, then the vertices are
+*		recursively divided into boxes. Within each box the
+*		contribution of the control points which are far from the
+*		box is approximated by a Chebyshev interpolant, with the
+*		box being sub-divided until the interpolant's estimated
+*		error is within evalTol. The contribution of the remaining
+*		control points is always computed directly.
+*		Other basis functions are evaluated exactly.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Source vertices.
+* \param	dstVx			Destination for the evaluated
+*					displacements, may be the same
+*					array as the source vertices.
+*/
+WlzErrorNum	WlzBasisFnValueBatch2D(WlzBasisFn *basisFn, int nVx,
+				       WlzDVertex2 *srcVx, WlzDVertex2 *dstVx)
+{
+  int		idx,
+  		fast = 0;
+  double	*qry[2],
+  		*out[2];
+  WlzBasisFnBatch *bat = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  qry[0] = NULL;
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((nVx < 0) || ((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:    /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCS:
+        fast = (basisFn->distFn == NULL);
+	break;
+      case WLZ_FN_BASIS_2DPOLY:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCONF_POLY:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && fast && (nVx > 0))
+  {
+    if((qry[0] = (double *)AlcMalloc(4 * nVx * sizeof(double))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      qry[1] = qry[0] + nVx;
+      out[0] = qry[1] + nVx;
+      out[1] = out[0] + nVx;
+      bat = WlzBasisFnBatchMake(basisFn, 2, &errNum);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    if(fast)
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	qry[0][idx] = srcVx[idx].vtX;
+	qry[1][idx] = srcVx[idx].vtY;
+      }
+      errNum = WlzBasisFnBatchEval(bat, nVx, qry, out);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	const double scale = (basisFn->type == WLZ_FN_BASIS_2DTPS)? 0.5: 1.0;
+
+	for(idx = 0; idx < nVx; ++idx)
+	{
+	  WlzDVertex2 polyVx;
+
+	  polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx[idx]);
+	  dstVx[idx].vtX = (out[0][idx] * scale) + polyVx.vtX;
+	  dstVx[idx].vtY = (out[1][idx] * scale) + polyVx.vtY;
+	}
+      }
+    }
+    else
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	WlzDVertex2 sVx;
+
+	sVx = srcVx[idx];
+	switch(basisFn->type)
+	{
+	  case WLZ_FN_BASIS_2DGAUSS:
+	    dstVx[idx] = WlzBasisFnValueGauss2D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_2DIMQ:
+	    dstVx[idx] = WlzBasisFnValueIMQ2D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_2DMQ:
+	    dstVx[idx] = WlzBasisFnValueMQ2D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_2DTPS:
+	    dstVx[idx] = WlzBasisFnValueTPS2D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_2DPOLY:
+	    dstVx[idx] = WlzBasisFnValuePoly2D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_2DCONF_POLY:
+	    dstVx[idx] = WlzBasisFnValueConf2D(basisFn, sVx);
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+  }
+  WlzBasisFnBatchFree(bat);
+  AlcFree(qry[0]);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Evaluates the given 3D basis function at each of the given
+*		vertices. See WlzBasisFnValueBatch2D() which this function
+*		mirrors. Only MQ and IMQ basis functions may be
+*		approximated.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Source vertices.
+* \param	dstVx			Destination for the evaluated
+*					displacements, may be the same
+*					array as the source vertices.
+*/
+WlzErrorNum	WlzBasisFnValueBatch3D(WlzBasisFn *basisFn, int nVx,
+				       WlzDVertex3 *srcVx, WlzDVertex3 *dstVx)
+{
+  int		idx,
+  		fast = 0;
+  double	*qry[3],
+  		*out[3];
+  WlzBasisFnBatch *bat = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  qry[0] = NULL;
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((nVx < 0) || ((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+        fast = (basisFn->distFn == NULL);
+	break;
+      case WLZ_FN_BASIS_3DMOS:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && fast && (nVx > 0))
+  {
+    if((qry[0] = (double *)AlcMalloc(6 * nVx * sizeof(double))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      qry[1] = qry[0] + nVx;
+      qry[2] = qry[1] + nVx;
+      out[0] = qry[2] + nVx;
+      out[1] = out[0] + nVx;
+      out[2] = out[1] + nVx;
+      bat = WlzBasisFnBatchMake(basisFn, 3, &errNum);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    if(fast)
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	qry[0][idx] = srcVx[idx].vtX;
+	qry[1][idx] = srcVx[idx].vtY;
+	qry[2][idx] = srcVx[idx].vtZ;
+      }
+      errNum = WlzBasisFnBatchEval(bat, nVx, qry, out);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idx = 0; idx < nVx; ++idx)
+	{
+	  WlzDVertex3 polyVx;
+
+	  polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx[idx]);
+	  dstVx[idx].vtX = out[0][idx] + polyVx.vtX;
+	  dstVx[idx].vtY = out[1][idx] + polyVx.vtY;
+	  dstVx[idx].vtZ = out[2][idx] + polyVx.vtZ;
+	}
+      }
+    }
+    else
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	WlzDVertex3 sVx;
+
+	sVx = srcVx[idx];
+	switch(basisFn->type)
+	{
+	  case WLZ_FN_BASIS_3DIMQ:
+	    dstVx[idx] = WlzBasisFnValueIMQ3D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_3DMQ:
+	    dstVx[idx] = WlzBasisFnValueMQ3D(basisFn, sVx);
+	    break;
+	  case WLZ_FN_BASIS_3DMOS:
+	    dstVx[idx] = WlzBasisFnValueMOS3D(basisFn, sVx);
+	    break;
+	  default:
+	    break;
+	}
+      }
+    }
+  }
+  WlzBasisFnBatchFree(bat);
+  AlcFree(qry[0]);
+  return(errNum);
+}
+
 /*!
 * \return	Distance from given position to control point.
 * \ingroup	WlzFunction
@@ -3828,34 +4450,327 @@ WlzBasisFn *WlzBasisFnScalarMOS3DFromCPts(int nPts,
 }
 
 /*!
-* \return	New histogram domain look up table.
+* \return	New basis function.
 * \ingroup	WlzFunction
-* \brief	Computes a look up table for the multiorder spline
-*		over the range of distances between the given vertices.
-* \param	nPts			Number of vertices.
-* \param	cPts			The given vertices.
-* \param	delta			Multiorder spline \f$\delta\f$.
-* \param	tau			Multiorder spline \f$\tau\f$.
+* \brief	Creates a new 2D radial basis function by solving the
+*		design equations iteratively, rather than by the singular
+*		value decomposition used by WlzBasisFnTPS2DFromCPts() and
+*		the similar functions. These need \f$O(n^2)\f$ memory and
+*		\f$O(n^3)\f$ time, which limits them to a few thousand
+*		control points, while this function only needs
+*		\f$O(n)\f$ memory.
+*		The polynomial part of the design equations is eliminated
+*		by projecting the basis function coefficients onto the
+*		orthogonal complement of the linear polynomials, which
+*		leaves a definite system which is solved for all
+*		components at once by AlgMatrixCGSolveFn(). The matrix
+*		vector products use the batch evaluation of
+*		WlzBasisFnValueBatch2D(), approximating the products of
+*		TPS, MQ and IMQ basis functions to within a bound derived
+*		from the tolerance. Compactly supported (Wendland)
+*		basis functions, of type WLZ_FN_BASIS_2DCS, give sparse
+*		design equations and are only available through this
+*		function.
+*		The iterations are preconditioned using local Lagrange
+*		functions, with which TPS, MQ and compactly supported
+*		basis functions typically converge in a few tens of
+*		iterations, independent of the number of control points.
+*		IMQ design equations with the default (large) delta are
+*		so poorly conditioned that they may fail to converge, in
+*		which case WLZ_ERR_ALG_CONVERGENCE is returned.
+*		Distances are always Euclidean.
+* \param	type			Basis function type which must be one
+*					of WLZ_FN_BASIS_2DIMQ, WLZ_FN_BASIS_2DMQ,
+*					WLZ_FN_BASIS_2DTPS or
+*					WLZ_FN_BASIS_2DCS.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	param			Basis function parameter which is
+*					ignored for TPS basis functions, the
+*					normalized delta value for MQ and
+*					IMQ basis functions and the support
+*					radius, as a fraction of the control
+*					point's range, for compactly
+*					supported basis functions.
+* \param	tol			Relative residual tolerance for the
+*					iterative solution, must be greater
+*					than zero.
+* \param	maxItr			Maximum number of iterations, if less
+*					than one the number of control
+*					points is used.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
-static WlzHistogramDomain *WlzBasisFnScalarMOS3DEvalTb(int nPts,
-				WlzDVertex3 *cPts, double delta, double tau,
-				WlzErrorNum *dstErr)
+WlzBasisFn	*WlzBasisFnItr2DFromCPts(WlzFnType type, int nPts,
+				         WlzDVertex2 *dPts, WlzDVertex2 *sPts,
+					 double param, double tol, int maxItr,
+					 WlzErrorNum *dstErr)
 {
-  int		idx,
-  		lutMax;
+  int		idN;
   double	tD0,
-  		tD1,
-		v,
-		w,
-		rv,
-		rw,
-		norm;
-  WlzDVertex3	tV0;
-  WlzDBox3	extentDB;
-  WlzHistogramDomain *lut = NULL;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
-  const double lutStep = 0.1;
+		tD1,
+		range;
+  double	*rhs[2];
+  WlzDBox2	extentDB;
+  WlzBasisFn    *newBasisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rhs[0] = NULL;
+  if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((nPts < 1) || (tol <= 0.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(type)
+    {
+      case WLZ_FN_BASIS_2DTPS:
+        break;
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCS:
+	if(param <= 0.0)
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((newBasisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
+					      1)) == NULL) ||
+       ((newBasisFn->poly.v = AlcCalloc(sizeof(WlzDVertex2), 3)) == NULL) ||
+       ((newBasisFn->basis.v = AlcCalloc(sizeof(WlzDVertex2), nPts)) == NULL) ||
+       ((newBasisFn->vertices.v = AlcMalloc(sizeof(WlzDVertex2) *
+					    nPts)) == NULL) ||
+       ((newBasisFn->param = AlcCalloc(sizeof(double), 1)) == NULL) ||
+       ((rhs[0] = (double *)AlcMalloc(sizeof(double) * 2 * nPts)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzBasisFnVxExtent2D(&extentDB, dPts, sPts, nPts);
+    tD0 = extentDB.xMax - extentDB.xMin;
+    tD1 = extentDB.yMax - extentDB.yMin;
+    range = (tD0 > tD1)? tD0: tD1;
+    if(range <= 1.0)
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    newBasisFn->type = type;
+    newBasisFn->nPoly = 2;
+    newBasisFn->nBasis = nPts;
+    newBasisFn->nVtx = nPts;
+    newBasisFn->maxVx = nPts;
+    WlzValueCopyDVertexToDVertex(newBasisFn->vertices.d2, dPts, nPts);
+    switch(type)
+    {
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:
+	tD0 = param * range;
+	*((double *)(newBasisFn->param)) = tD0 * tD0;
+	break;
+      case WLZ_FN_BASIS_2DCS:
+	*((double *)(newBasisFn->param)) = param * range;
+        break;
+      default:
+        break;
+    }
+    rhs[1] = rhs[0] + nPts;
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      rhs[0][idN] = sPts[idN].vtX - dPts[idN].vtX;
+      rhs[1][idN] = sPts[idN].vtY - dPts[idN].vtY;
+    }
+    errNum = WlzBasisFnItrSolve(newBasisFn, 2, rhs, tol, maxItr);
+  }
+  AlcFree(rhs[0]);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(newBasisFn);
+    newBasisFn = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newBasisFn);
+}
+
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 3D radial basis function by solving the
+*		design equations iteratively, see
+*		WlzBasisFnItr2DFromCPts().
+* \param	type			Basis function type which must be one
+*					of WLZ_FN_BASIS_3DIMQ, WLZ_FN_BASIS_3DMQ
+*					or WLZ_FN_BASIS_3DCS.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	param			Basis function parameter, the
+*					normalized delta value for MQ and
+*					IMQ basis functions and the support
+*					radius, as a fraction of the control
+*					point's range, for compactly
+*					supported basis functions.
+* \param	tol			Relative residual tolerance for the
+*					iterative solution, must be greater
+*					than zero.
+* \param	maxItr			Maximum number of iterations, if less
+*					than one the number of control
+*					points is used.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn	*WlzBasisFnItr3DFromCPts(WlzFnType type, int nPts,
+				         WlzDVertex3 *dPts, WlzDVertex3 *sPts,
+					 double param, double tol, int maxItr,
+					 WlzErrorNum *dstErr)
+{
+  int		idN;
+  double	tD0,
+		range;
+  double	*rhs[3];
+  WlzDBox3	extentDB;
+  WlzBasisFn    *newBasisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rhs[0] = NULL;
+  if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((nPts < 1) || (tol <= 0.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(type)
+    {
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+	if(param <= 0.0)
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((newBasisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
+					      1)) == NULL) ||
+       ((newBasisFn->poly.v = AlcCalloc(sizeof(WlzDVertex3), 4)) == NULL) ||
+       ((newBasisFn->basis.v = AlcCalloc(sizeof(WlzDVertex3), nPts)) == NULL) ||
+       ((newBasisFn->vertices.v = AlcMalloc(sizeof(WlzDVertex3) *
+					    nPts)) == NULL) ||
+       ((newBasisFn->param = AlcCalloc(sizeof(double), 1)) == NULL) ||
+       ((rhs[0] = (double *)AlcMalloc(sizeof(double) * 3 * nPts)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzBasisFnVxExtent3D(&extentDB, dPts, sPts, nPts);
+    range = extentDB.xMax - extentDB.xMin;
+    tD0 = extentDB.yMax - extentDB.yMin;
+    range = (tD0 > range)? tD0: range;
+    tD0 = extentDB.zMax - extentDB.zMin;
+    range = (tD0 > range)? tD0: range;
+    if(range <= 1.0)
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    newBasisFn->type = type;
+    newBasisFn->nPoly = 2;
+    newBasisFn->nBasis = nPts;
+    newBasisFn->nVtx = nPts;
+    newBasisFn->maxVx = nPts;
+    WlzValueCopyDVertexToDVertex3(newBasisFn->vertices.d3, dPts, nPts);
+    if(type == WLZ_FN_BASIS_3DCS)
+    {
+      *((double *)(newBasisFn->param)) = param * range;
+    }
+    else
+    {
+      tD0 = param * range;
+      *((double *)(newBasisFn->param)) = tD0 * tD0;
+    }
+    rhs[1] = rhs[0] + nPts;
+    rhs[2] = rhs[1] + nPts;
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      rhs[0][idN] = sPts[idN].vtX - dPts[idN].vtX;
+      rhs[1][idN] = sPts[idN].vtY - dPts[idN].vtY;
+      rhs[2][idN] = sPts[idN].vtZ - dPts[idN].vtZ;
+    }
+    errNum = WlzBasisFnItrSolve(newBasisFn, 3, rhs, tol, maxItr);
+  }
+  AlcFree(rhs[0]);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(newBasisFn);
+    newBasisFn = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newBasisFn);
+}
+
+/*!
+* \return	New histogram domain look up table.
+* \ingroup	WlzFunction
+* \brief	Computes a look up table for the multiorder spline
+*		over the range of distances between the given vertices.
+* \param	nPts			Number of vertices.
+* \param	cPts			The given vertices.
+* \param	delta			Multiorder spline \f$\delta\f$.
+* \param	tau			Multiorder spline \f$\tau\f$.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzHistogramDomain *WlzBasisFnScalarMOS3DEvalTb(int nPts,
+				WlzDVertex3 *cPts, double delta, double tau,
+				WlzErrorNum *dstErr)
+{
+  int		idx,
+  		lutMax;
+  double	tD0,
+  		tD1,
+		v,
+		w,
+		rv,
+		rw,
+		norm;
+  WlzDVertex3	tV0;
+  WlzDBox3	extentDB;
+  WlzHistogramDomain *lut = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double lutStep = 0.1;
 
   extentDB = WlzBoundingBoxVtx3D(nPts, cPts, NULL);
   tV0.vtX = extentDB.xMax - extentDB.xMin;
@@ -4489,3 +5404,2100 @@ static void	WlzBasisFnEditSV(int n, double *vV)
     }
   }
 }
+
+
+/*!
+* \return	New batch evaluation data structure or NULL on error.
+* \ingroup	WlzFunction
+* \brief	Makes a batch evaluation data structure for the given basis
+*		function, copying the control points and coefficients into
+*		contiguous arrays. The error bound is only set if the basis
+*		function is a TPS, MQ or IMQ and it is doubled for the TPS
+*		since it's sums are halved after evaluation.
+* \param	basisFn			Given basis function.
+* \param	dim			Dimension, 2 or 3.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzBasisFnBatch *WlzBasisFnBatchMake(WlzBasisFn *basisFn, int dim,
+					WlzErrorNum *dstErr)
+{
+  int		idP,
+  		idD,
+		idK,
+		m,
+		nPnt;
+  WlzBasisFnBatch *bat = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPnt = basisFn->nVtx;
+  if((bat = (WlzBasisFnBatch *)
+            AlcCalloc(1, sizeof(WlzBasisFnBatch))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    bat->type = basisFn->type;
+    bat->dim = dim;
+    bat->nPnt = nPnt;
+    bat->delta = (basisFn->param)? *((double *)(basisFn->param)): 0.0;
+    bat->deg = (dim == 2)? WLZ_BASISFN_BATCH_DEG2: WLZ_BASISFN_BATCH_DEG3;
+    m = bat->deg + 1;
+    bat->nPrx = (dim == 2)? m * m: m * m * m;
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+	bat->tol = WLZ_MAX(basisFn->evalTol, 0.0);
+        break;
+      case WLZ_FN_BASIS_2DTPS:
+	bat->tol = 2.0 * WLZ_MAX(basisFn->evalTol, 0.0);
+        break;
+      default:
+        break;
+    }
+    if(((bat->pos[0] = (double *)
+                       AlcMalloc(2 * dim * (nPnt + 1) *
+		                 sizeof(double))) == NULL) ||
+       ((bat->cheb = (double *)AlcMalloc(m * m * sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idD = 0; idD < dim; ++idD)
+    {
+      bat->pos[idD] = bat->pos[0] + (idD * (nPnt + 1));
+      bat->co[idD] = bat->pos[0] + ((dim + idD) * (nPnt + 1));
+    }
+    for(idP = 0; idP < nPnt; ++idP)
+    {
+      if(dim == 2)
+      {
+	bat->pos[0][idP] = basisFn->vertices.d2[idP].vtX;
+	bat->pos[1][idP] = basisFn->vertices.d2[idP].vtY;
+	bat->co[0][idP] = basisFn->basis.d2[idP].vtX;
+	bat->co[1][idP] = basisFn->basis.d2[idP].vtY;
+      }
+      else
+      {
+	bat->pos[0][idP] = basisFn->vertices.d3[idP].vtX;
+	bat->pos[1][idP] = basisFn->vertices.d3[idP].vtY;
+	bat->pos[2][idP] = basisFn->vertices.d3[idP].vtZ;
+	bat->co[0][idP] = basisFn->basis.d3[idP].vtX;
+	bat->co[1][idP] = basisFn->basis.d3[idP].vtY;
+	bat->co[2][idP] = basisFn->basis.d3[idP].vtZ;
+      }
+    }
+    for(idK = 0; idK < m; ++idK)
+    {
+      for(idP = 0; idP < m; ++idP)
+      {
+        bat->cheb[(idK * m) + idP] = cos(ALG_M_PI * idK * (idP + 0.5) / m);
+      }
+    }
+  }
+  else
+  {
+    WlzBasisFnBatchFree(bat);
+    bat = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(bat);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Frees the given batch evaluation data structure.
+* \param	bat			Given data structure, may be NULL.
+*/
+static void	WlzBasisFnBatchFree(WlzBasisFnBatch *bat)
+{
+  if(bat)
+  {
+    AlcFree(bat->pos[0]);
+    AlcFree(bat->cheb);
+    AlcFree(bat);
+  }
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Evaluates the basis function sums, without the polynomial
+*		term, at the given vertices. The vertices are divided
+*		into boxes which are evaluated in parallel. When
+*		approximating the boxes are spatially coherent and are
+*		evaluated by WlzBasisFnBatchBox(), otherwise they are
+*		just consecutive vertices which are evaluated exactly.
+* \param	bat			Batch evaluation data structure.
+* \param	nQ			Number of vertices.
+* \param	qry			Vertex coordinate arrays.
+* \param	out			Destination arrays for the sums.
+*/
+static WlzErrorNum WlzBasisFnBatchEval(WlzBasisFnBatch *bat, int nQ,
+				       double **qry, double **out)
+{
+  int		idQ,
+  		idR,
+		nRng = 0,
+		nStk = 0;
+  int		*qIdx = NULL,
+  		*rng = NULL,
+		*stk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Ranges are pairs of first vertex index and count. The number of boxes
+   * is bounded since boxes are split at the median. */
+  idR = 2 * ((2 * nQ / WLZ_BASISFN_BATCH_BOXQ) + 2);
+  if(((qIdx = (int *)AlcMalloc(nQ * sizeof(int))) == NULL) ||
+     ((rng = (int *)AlcMalloc(idR * sizeof(int))) == NULL) ||
+     ((stk = (int *)AlcMalloc(idR * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idQ = 0; idQ < nQ; ++idQ)
+    {
+      qIdx[idQ] = idQ;
+    }
+    if(bat->tol > 0.0)
+    {
+      stk[nStk++] = 0;
+      stk[nStk++] = nQ;
+      while(nStk > 0)
+      {
+	int	f,
+		c,
+		h = 0;
+
+	c = stk[--nStk];
+	f = stk[--nStk];
+	if(c > WLZ_BASISFN_BATCH_BOXQ)
+	{
+	  h = WlzBasisFnBatchSplit(qIdx + f, c, qry, bat->dim, NULL);
+	}
+	if(h > 0)
+	{
+	  stk[nStk++] = f;
+	  stk[nStk++] = h;
+	  stk[nStk++] = f + h;
+	  stk[nStk++] = c - h;
+	}
+	else
+	{
+	  rng[nRng++] = f;
+	  rng[nRng++] = c;
+	}
+      }
+    }
+    else
+    {
+      for(idQ = 0; idQ < nQ; idQ += WLZ_BASISFN_BATCH_BOXQ)
+      {
+        rng[nRng++] = idQ;
+        rng[nRng++] = WLZ_MIN(WLZ_BASISFN_BATCH_BOXQ, nQ - idQ);
+      }
+    }
+    nRng /= 2;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int		idB;
+      double		*buf = NULL;
+      WlzBasisFnBatchWSp wSp;
+      WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+      if(bat->tol > 0.0)
+      {
+	int	idD,
+		dim;
+
+        dim = bat->dim;
+	if((buf = (double *)
+	          AlcMalloc(((4 * dim * (bat->nPnt + 1)) +
+	                     ((dim + 1) * bat->nPrx)) * sizeof(double))) == NULL)
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  for(idD = 0; idD < 2 * dim; ++idD)
+	  {
+	    wSp.near[idD] = buf + (idD * (bat->nPnt + 1));
+	    wSp.far[idD] = buf + ((2 * dim + idD) * (bat->nPnt + 1));
+	  }
+	  for(idD = 0; idD < dim; ++idD)
+	  {
+	    wSp.val[idD] = buf + (4 * dim * (bat->nPnt + 1)) +
+	                   (idD * bat->nPrx);
+	  }
+	  wSp.tmp = buf + (4 * dim * (bat->nPnt + 1)) + (dim * bat->nPrx);
+	}
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(idB = 0; idB < nRng; ++idB)
+      {
+	int	*qI;
+
+	qI = qIdx + rng[2 * idB];
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  if(bat->tol > 0.0)
+	  {
+	    WlzBasisFnBatchBox(bat, &wSp, qI, rng[2 * idB + 1], qry, out);
+	  }
+	  else
+	  {
+	    WlzBasisFnBatchExact(bat, qI, rng[2 * idB + 1], qry, out);
+	  }
+	}
+      }
+      AlcFree(buf);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzBasisFnBatchEval)
+#endif
+        {
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  AlcFree(qIdx);
+  AlcFree(rng);
+  AlcFree(stk);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Evaluates the basis function sums at the given box of
+*		vertices. The control points are divided into those in
+*		the near field of the box, which are summed directly, and
+*		those in the far field. The far field is evaluated at
+*		Chebyshev points within the box and from these the
+*		coefficients of it's Chebyshev interpolant are computed.
+*		The sum of the magnitudes of the highest degree
+*		coefficients is used as an estimate of the interpolation
+*		error. If this is not within the error bound, or if the
+*		approximation would be no cheaper than direct evaluation,
+*		the box is split at the median of it's longest axis and
+*		each half is evaluated recursively. Small boxes are
+*		evaluated directly.
+* \param	bat			Batch evaluation data structure.
+* \param	wSp			Workspace.
+* \param	qIdx			Indices of the vertices in the box,
+*					these may be reordered.
+* \param	cnt			Number of vertices in the box.
+* \param	qry			Vertex coordinate arrays.
+* \param	out			Destination arrays for the sums.
+*/
+static void	WlzBasisFnBatchBox(WlzBasisFnBatch *bat,
+				   WlzBasisFnBatchWSp *wSp,
+				   int *qIdx, int cnt,
+				   double **qry, double **out)
+{
+  int		idC,
+		idD,
+		idK,
+		idP,
+		idQ,
+		h,
+		m,
+		strd,
+		dim,
+		ok = 0,
+		split = 1;
+  double	r2,
+  		hwMax = 0.0,
+		err = 0.0;
+  double	cen[3],
+  		hw[3],
+		bMin[3],
+		bMax[3];
+
+  dim = bat->dim;
+  m = bat->deg + 1;
+  if(cnt >= 2 * bat->nPrx)
+  {
+    /* Find the box's centre and half widths. */
+    for(idD = 0; idD < dim; ++idD)
+    {
+      bMin[idD] = DBL_MAX;
+      bMax[idD] = -DBL_MAX;
+    }
+    for(idQ = 0; idQ < cnt; ++idQ)
+    {
+      for(idD = 0; idD < dim; ++idD)
+      {
+        double	v;
+
+	v = qry[idD][qIdx[idQ]];
+	bMin[idD] = WLZ_MIN(bMin[idD], v);
+	bMax[idD] = WLZ_MAX(bMax[idD], v);
+      }
+    }
+    r2 = 0.0;
+    for(idD = 0; idD < dim; ++idD)
+    {
+      cen[idD] = 0.5 * (bMin[idD] + bMax[idD]);
+      hw[idD] = 0.5 * (bMax[idD] - bMin[idD]);
+      hwMax = WLZ_MAX(hwMax, hw[idD]);
+      r2 += hw[idD] * hw[idD];
+    }
+    ok = hwMax > DBL_EPSILON;
+  }
+  if(ok)
+  {
+    /* Divide the control points into the near and far fields. */
+    for(idD = 0; idD < dim; ++idD)
+    {
+      hw[idD] = WLZ_MAX(hw[idD], 1.0e-06 * hwMax);
+    }
+    r2 *= WLZ_BASISFN_BATCH_SEP * WLZ_BASISFN_BATCH_SEP;
+    wSp->nNear = wSp->nFar = 0;
+    for(idP = 0; idP < bat->nPnt; ++idP)
+    {
+      int	   i;
+      double	   d2 = 0.0;
+      double	   **dst;
+
+      for(idD = 0; idD < dim; ++idD)
+      {
+        double	d;
+
+	d = fabs(bat->pos[idD][idP] - cen[idD]) - hw[idD];
+	if(d > 0.0)
+	{
+	  d2 += d * d;
+	}
+      }
+      if(d2 < r2)
+      {
+        dst = wSp->near;
+	i = wSp->nNear++;
+      }
+      else
+      {
+        dst = wSp->far;
+	i = wSp->nFar++;
+      }
+      for(idD = 0; idD < dim; ++idD)
+      {
+	dst[idD][i] = bat->pos[idD][idP];
+	dst[dim + idD][i] = bat->co[idD][idP];
+      }
+    }
+    ok = ((double )(bat->nPrx) * wSp->nFar) +
+         ((double )cnt * (wSp->nNear + bat->nPrx)) <
+	 (double )cnt * bat->nPnt;
+  }
+  if(ok)
+  {
+    /* Evaluate the far field at the Chebyshev points of the box, with
+     * the proxy point index being j0 + m (j1 + m j2). */
+    for(idP = 0; idP < bat->nPrx; ++idP)
+    {
+      int	j;
+      double	p[3],
+		sum[3];
+
+      j = idP;
+      for(idD = 0; idD < dim; ++idD)
+      {
+	p[idD] = cen[idD] + (hw[idD] * bat->cheb[m + (j % m)]);
+	j /= m;
+      }
+      WlzBasisFnBatchSum(bat, wSp->nFar, wSp->far, p, sum);
+      for(idC = 0; idC < dim; ++idC)
+      {
+        wSp->val[idC][idP] = sum[idC];
+      }
+    }
+    /* Transform the values to Chebyshev coefficients one axis at a time
+     * and then estimate the error from the highest degree coefficients. */
+    for(idC = 0; idC < dim; ++idC)
+    {
+      double	*v;
+
+      v = wSp->val[idC];
+      strd = 1;
+      for(idD = 0; idD < dim; ++idD)
+      {
+        (void )memcpy(wSp->tmp, v, bat->nPrx * sizeof(double));
+	for(idP = 0; idP < bat->nPrx; ++idP)
+	{
+	  int	j,
+	  	k,
+		b;
+	  double t = 0.0;
+
+	  k = (idP / strd) % m;
+	  b = idP - (k * strd);
+	  for(j = 0; j < m; ++j)
+	  {
+	    t += bat->cheb[(k * m) + j] * wSp->tmp[b + (j * strd)];
+	  }
+	  v[idP] = t * ((k == 0)? 1.0: 2.0) / m;
+	}
+	strd *= m;
+      }
+      for(idP = 0; idP < bat->nPrx; ++idP)
+      {
+        int	j;
+
+	j = idP;
+	for(idD = 0; idD < dim; ++idD)
+	{
+	  if(j % m == bat->deg)
+	  {
+	    err += fabs(v[idP]);
+	    break;
+	  }
+	  j /= m;
+	}
+      }
+    }
+    /* Allow for aliasing of the neglected coefficients. Halving the box
+     * can't be expected to reduce the error by more than a factor of
+     * 2^m, so don't split if it's beyond this. */
+    ok = 2.0 * err <= bat->tol;
+    split = ok || (2.0 * err <= ldexp(bat->tol, m));
+  }
+  if(ok)
+  {
+    for(idQ = 0; idQ < cnt; ++idQ)
+    {
+      int	q;
+      double	p[3],
+      		sum[3];
+      double	tc[3][WLZ_BASISFN_BATCH_DEG2 + 1];
+
+      q = qIdx[idQ];
+      for(idD = 0; idD < dim; ++idD)
+      {
+	double	t;
+
+	p[idD] = qry[idD][q];
+	t = (p[idD] - cen[idD]) / hw[idD];
+	t = WLZ_CLAMP(t, -1.0, 1.0);
+	tc[idD][0] = 1.0;
+	tc[idD][1] = t;
+	for(idK = 2; idK < m; ++idK)
+	{
+	  tc[idD][idK] = (2.0 * t * tc[idD][idK - 1]) - tc[idD][idK - 2];
+	}
+      }
+      WlzBasisFnBatchSum(bat, wSp->nNear, wSp->near, p, sum);
+      for(idP = 0; idP < bat->nPrx; ++idP)
+      {
+        int	j;
+	double	t;
+
+	j = idP;
+	t = tc[0][j % m];
+	for(idD = 1; idD < dim; ++idD)
+	{
+	  j /= m;
+	  t *= tc[idD][j % m];
+	}
+	for(idC = 0; idC < dim; ++idC)
+	{
+	  sum[idC] += wSp->val[idC][idP] * t;
+	}
+      }
+      for(idC = 0; idC < dim; ++idC)
+      {
+        out[idC][q] = sum[idC];
+      }
+    }
+  }
+  else if(split && (cnt >= 4 * bat->nPrx) &&
+          ((h = WlzBasisFnBatchSplit(qIdx, cnt, qry, dim, NULL)) > 0))
+  {
+    WlzBasisFnBatchBox(bat, wSp, qIdx, h, qry, out);
+    WlzBasisFnBatchBox(bat, wSp, qIdx + h, cnt - h, qry, out);
+  }
+  else
+  {
+    WlzBasisFnBatchExact(bat, qIdx, cnt, qry, out);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Evaluates the basis function sums at the given vertices
+*		directly using all the control points.
+* \param	bat			Batch evaluation data structure.
+* \param	qIdx			Indices of the vertices.
+* \param	cnt			Number of vertices.
+* \param	qry			Vertex coordinate arrays.
+* \param	out			Destination arrays for the sums.
+*/
+static void	WlzBasisFnBatchExact(WlzBasisFnBatch *bat, int *qIdx, int cnt,
+				     double **qry, double **out)
+{
+  int		idC,
+  		idD,
+  		idQ;
+  double	*pc[6];
+
+  for(idD = 0; idD < bat->dim; ++idD)
+  {
+    pc[idD] = bat->pos[idD];
+    pc[bat->dim + idD] = bat->co[idD];
+  }
+  for(idQ = 0; idQ < cnt; ++idQ)
+  {
+    int		q;
+    double	p[3],
+    		sum[3];
+
+    q = qIdx[idQ];
+    for(idD = 0; idD < bat->dim; ++idD)
+    {
+      p[idD] = qry[idD][q];
+    }
+    WlzBasisFnBatchSum(bat, bat->nPnt, pc, p, sum);
+    for(idC = 0; idC < bat->dim; ++idC)
+    {
+      out[idC][q] = sum[idC];
+    }
+  }
+}
+
+/*!
+* \return	Number of vertices in the first part, zero if the vertices
+*		could not be split.
+* \ingroup	WlzFunction
+* \brief	Partitions the given vertex indices about the median of
+*		the vertices along the axis on which they have the greatest
+*		extent.
+* \param	qIdx			Vertex indices which are reordered.
+* \param	cnt			Number of vertices.
+* \param	qry			Vertex coordinate arrays.
+* \param	dim			Dimension.
+* \param	dstAxis			Destination for the axis, may be
+*					NULL.
+*/
+static int	WlzBasisFnBatchSplit(int *qIdx, int cnt, double **qry,
+				     int dim, int *dstAxis)
+{
+  int		idD,
+		idQ,
+		axis = 0,
+		lo,
+		hi,
+		h;
+  double	len,
+  		lenMax = 0.0;
+  double	*key;
+
+  for(idD = 0; idD < dim; ++idD)
+  {
+    double	vMin,
+    		vMax;
+
+    vMin = vMax = qry[idD][qIdx[0]];
+    for(idQ = 1; idQ < cnt; ++idQ)
+    {
+      double	v;
+
+      v = qry[idD][qIdx[idQ]];
+      vMin = WLZ_MIN(vMin, v);
+      vMax = WLZ_MAX(vMax, v);
+    }
+    len = vMax - vMin;
+    if(len > lenMax)
+    {
+      axis = idD;
+      lenMax = len;
+    }
+  }
+  h = (lenMax > 0.0)? cnt / 2: 0;
+  if(h > 0)
+  {
+    /* Quick select so that the first h indices have keys no greater than
+     * the rest. */
+    key = qry[axis];
+    lo = 0;
+    hi = cnt - 1;
+    while(lo < hi)
+    {
+      int	i,
+      		j,
+		t;
+      double	piv;
+
+      piv = key[qIdx[(lo + hi) / 2]];
+      i = lo;
+      j = hi;
+      while(i <= j)
+      {
+	while(key[qIdx[i]] < piv)
+	{
+	  ++i;
+	}
+	while(key[qIdx[j]] > piv)
+	{
+	  --j;
+	}
+	if(i <= j)
+	{
+	  t = qIdx[i]; qIdx[i] = qIdx[j]; qIdx[j] = t;
+	  ++i;
+	  --j;
+	}
+      }
+      if(h <= j)
+      {
+        hi = j;
+      }
+      else if(h >= i)
+      {
+        lo = i;
+      }
+      else
+      {
+        break;
+      }
+    }
+  }
+  if(dstAxis)
+  {
+    *dstAxis = axis;
+  }
+  return(h);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Computes the basis function sums, without the polynomial
+*		term, at the given position using the given control
+*		points in the same way as the single vertex evaluation
+*		functions. The loops are over contiguous arrays without
+*		calls to a distance function so that they may be
+*		vectorised. The TPS sums are not scaled by one half.
+* \param	bat			Batch evaluation data structure.
+* \param	n			Number of control points.
+* \param	pc			Control point coordinate arrays
+*					followed by coefficient arrays.
+* \param	p			Given position.
+* \param	sum			Destination for the sums.
+*/
+static void	WlzBasisFnBatchSum(WlzBasisFnBatch *bat, int n, double **pc,
+				   const double *p, double *sum)
+{
+  int		idx;
+  double	s0 = 0.0,
+		s1 = 0.0,
+		s2 = 0.0;
+  const double	delta = bat->delta;
+
+  if(bat->dim == 2)
+  {
+    const double x = p[0],
+    		 y = p[1],
+		 *px = pc[0],
+		 *py = pc[1],
+		 *cx = pc[2],
+		 *cy = pc[3];
+
+    switch(bat->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 t = (dx * dx) + (dy * dy);
+
+	  t = (t > DBL_EPSILON)? exp(t * delta): 1.0;
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_2DIMQ:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 t = 1.0 / sqrt((dx * dx) + (dy * dy) + delta);
+
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_2DMQ:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 t = sqrt((dx * dx) + (dy * dy) + delta);
+
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_2DTPS:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 t = (dx * dx) + (dy * dy);
+
+	  t = (t > DBL_EPSILON)? t * log(t): 0.0;
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_2DCS:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 t = sqrt((dx * dx) + (dy * dy)) / delta,
+		 u = (t < 1.0)? 1.0 - t: 0.0;
+
+	  u *= u;
+	  t = u * u * ((4.0 * t) + 1.0);
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	}
+	break;
+      default:
+	break;
+    }
+  }
+  else
+  {
+    const double x = p[0],
+    		 y = p[1],
+		 z = p[2],
+		 *px = pc[0],
+		 *py = pc[1],
+		 *pz = pc[2],
+		 *cx = pc[3],
+		 *cy = pc[4],
+		 *cz = pc[5];
+
+    switch(bat->type)
+    {
+      case WLZ_FN_BASIS_3DIMQ:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 dz = z - pz[idx],
+		 t = 1.0 / sqrt((dx * dx) + (dy * dy) + (dz * dz) + delta);
+
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	  s2 += cz[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_3DMQ:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 dz = z - pz[idx],
+		 t = sqrt((dx * dx) + (dy * dy) + (dz * dz) + delta);
+
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	  s2 += cz[idx] * t;
+	}
+	break;
+      case WLZ_FN_BASIS_3DCS:
+	for(idx = 0; idx < n; ++idx)
+	{
+	  double dx = x - px[idx],
+	  	 dy = y - py[idx],
+		 dz = z - pz[idx],
+		 t = sqrt((dx * dx) + (dy * dy) + (dz * dz)) / delta,
+		 u = (t < 1.0)? 1.0 - t: 0.0;
+
+	  u *= u;
+	  t = u * u * ((4.0 * t) + 1.0);
+	  s0 += cx[idx] * t;
+	  s1 += cy[idx] * t;
+	  s2 += cz[idx] * t;
+	}
+	break;
+      default:
+	break;
+    }
+  }
+  sum[0] = s0;
+  sum[1] = s1;
+  sum[2] = s2;
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Solves the design equations of the given basis function
+*		iteratively, setting it's basis function and polynomial
+*		coefficients. The basis function must have it's type,
+*		parameter and control points set.
+*		The polynomial part is eliminated by projecting onto the
+*		orthogonal complement of the polynomial space. For
+*		conditionally positive definite basis functions the
+*		projected matrix is definite, with the MQ basis function
+*		giving a negative definite matrix which is negated.
+*		Once the basis function coefficients are known the
+*		polynomial coefficients are found from the residual.
+* \param	basisFn			Given basis function.
+* \param	dim			Dimension, 2 or 3.
+* \param	rhs			Displacements at the control points,
+*					one array for each component.
+* \param	tol			Relative residual tolerance.
+* \param	maxItr			Maximum number of iterations, if less
+*					than one the number of control points
+*					is used.
+*/
+static WlzErrorNum WlzBasisFnItrSolve(WlzBasisFn *basisFn, int dim,
+				      double **rhs, double tol, int maxItr)
+{
+  int		idC,
+		idD,
+		idJ,
+		idK,
+		idN,
+		n,
+		nP;
+  double	rg = 0.0,
+		bMin = DBL_MAX;
+  double	cen[3],
+  		rM[4][4];
+  double	*buf = NULL;
+  double	*x[3],
+  		*b[3];
+  WlzBasisFnItrOp op;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  n = basisFn->nVtx;
+  nP = dim + 1;
+  (void )memset(&op, 0, sizeof(WlzBasisFnItrOp));
+  op.n = n;
+  op.dim = dim;
+  op.nPoly = nP;
+  op.sgn = ((basisFn->type == WLZ_FN_BASIS_2DMQ) ||
+            (basisFn->type == WLZ_FN_BASIS_3DMQ))? -1.0: 1.0;
+  op.scale = (basisFn->type == WLZ_FN_BASIS_2DTPS)? 0.5: 1.0;
+  if((buf = (double *)AlcMalloc(((2 * dim) + nP) * n *
+                                sizeof(double))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idC = 0; idC < dim; ++idC)
+    {
+      x[idC] = buf + (idC * n);
+      b[idC] = buf + ((dim + idC) * n);
+    }
+    for(idK = 0; idK < nP; ++idK)
+    {
+      op.q[idK] = buf + (((2 * dim) + idK) * n);
+    }
+    op.bat = WlzBasisFnBatchMake(basisFn, dim, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Build an orthonormal basis for the polynomials using modified
+     * Gram-Schmidt, keeping R in P = Q R, with the monomials centred
+     * and scaled for stability. */
+    for(idD = 0; idD < dim; ++idD)
+    {
+      double	vMin,
+      		vMax;
+
+      vMin = DBL_MAX;
+      vMax = -DBL_MAX;
+      cen[idD] = 0.0;
+      for(idN = 0; idN < n; ++idN)
+      {
+	double	v;
+
+	v = op.bat->pos[idD][idN];
+	cen[idD] += v;
+	vMin = WLZ_MIN(vMin, v);
+	vMax = WLZ_MAX(vMax, v);
+      }
+      cen[idD] /= n;
+      rg = WLZ_MAX(rg, vMax - vMin);
+    }
+    if(rg < DBL_EPSILON)
+    {
+      rg = 1.0;
+    }
+    for(idK = 0; (errNum == WLZ_ERR_NONE) && (idK < nP); ++idK)
+    {
+      double	*v;
+
+      v = op.q[idK];
+      for(idN = 0; idN < n; ++idN)
+      {
+        v[idN] = (idK == 0)? 1.0: (op.bat->pos[idK - 1][idN] - cen[idK - 1]) /
+	                          rg;
+      }
+      for(idJ = 0; idJ < idK; ++idJ)
+      {
+	double	d;
+
+        d = AlgVectorDot(op.q[idJ], v, n);
+	AlgVectorScaleAdd(v, op.q[idJ], v, -d, n);
+	rM[idJ][idK] = d;
+      }
+      rM[idK][idK] = AlgVectorNorm(v, n);
+      if(rM[idK][idK] < 1.0e-08 * sqrt((double )n))
+      {
+	/* Control points are degenerate, eg all co-linear. */
+        errNum = WLZ_ERR_PARAM_DATA;
+      }
+      else
+      {
+        AlgVectorScale(v, v, 1.0 / rM[idK][idK], n);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idC = 0; idC < dim; ++idC)
+    {
+      double	d;
+
+      AlgVectorCopy(b[idC], rhs[idC], n);
+      WlzBasisFnItrProject(&op, b[idC]);
+      AlgVectorScale(b[idC], b[idC], op.sgn, n);
+      AlgVectorZero(x[idC], n);
+      d = AlgVectorNorm(b[idC], n);
+      if(d > DBL_EPSILON)
+      {
+        bMin = WLZ_MIN(bMin, d);
+      }
+    }
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DCS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+	errNum = WlzBasisFnItrSparse(&op);
+	break;
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+	/* Products may be approximated with an error well within that
+	 * allowed by the tolerance. */
+	if(bMin < DBL_MAX)
+	{
+	  op.tol = 0.1 * tol * bMin / (sqrt((double )n) * op.scale);
+	}
+	break;
+      default:
+        break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzBasisFnItrPreconMake(&op, basisFn->type);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzErrorFromAlg(
+             AlgMatrixCGSolveFn(n, dim, WlzBasisFnItrProduct, &op,
+				WlzBasisFnItrPrecon, &op, x, b, tol,
+				(maxItr > 0)? maxItr: n, NULL, NULL));
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = op.errNum;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Compute the residual r = rhs - K x exactly and then fit the
+     * polynomial to it by solving R a = Q^T r. */
+    op.tol = 0.0;
+    for(idC = 0; idC < dim; ++idC)
+    {
+      WlzBasisFnItrProject(&op, x[idC]);
+      AlgVectorCopy(op.bat->co[idC], x[idC], n);
+    }
+    WlzBasisFnItrKernel(&op, op.bat->co, b);
+    errNum = op.errNum;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idC = 0; idC < dim; ++idC)
+    {
+      double	a[4];
+
+      AlgVectorScaleAdd(b[idC], b[idC], rhs[idC], -op.scale, n);
+      for(idK = nP - 1; idK >= 0; --idK)
+      {
+        a[idK] = AlgVectorDot(op.q[idK], b[idC], n);
+	for(idJ = idK + 1; idJ < nP; ++idJ)
+	{
+	  a[idK] -= rM[idK][idJ] * a[idJ];
+	}
+	a[idK] /= rM[idK][idK];
+      }
+      /* Convert from the centred and scaled monomials. */
+      for(idD = 0; idD < dim; ++idD)
+      {
+        a[idD + 1] /= rg;
+	a[0] -= a[idD + 1] * cen[idD];
+      }
+      for(idK = 0; idK < nP; ++idK)
+      {
+	if(dim == 2)
+	{
+	  if(idC == 0)
+	  {
+	    basisFn->poly.d2[idK].vtX = a[idK];
+	  }
+	  else
+	  {
+	    basisFn->poly.d2[idK].vtY = a[idK];
+	  }
+	}
+	else
+	{
+	  switch(idC)
+	  {
+	    case 0:
+	      basisFn->poly.d3[idK].vtX = a[idK];
+	      break;
+	    case 1:
+	      basisFn->poly.d3[idK].vtY = a[idK];
+	      break;
+	    default:
+	      basisFn->poly.d3[idK].vtZ = a[idK];
+	      break;
+	  }
+	}
+      }
+    }
+    for(idN = 0; idN < n; ++idN)
+    {
+      if(dim == 2)
+      {
+        basisFn->basis.d2[idN].vtX = x[0][idN];
+        basisFn->basis.d2[idN].vtY = x[1][idN];
+      }
+      else
+      {
+        basisFn->basis.d3[idN].vtX = x[0][idN];
+        basisFn->basis.d3[idN].vtY = x[1][idN];
+        basisFn->basis.d3[idN].vtZ = x[2][idN];
+      }
+    }
+  }
+  WlzBasisFnBatchFree(op.bat);
+  AlcFree(op.row);
+  AlcFree(op.col);
+  AlcFree(op.val);
+  AlcFree(op.lgrIdx);
+  AlcFree(op.lgrCo);
+  AlcFree(op.lgrBuf);
+  AlcFree(op.crsIdx);
+  AlcFree(op.crsMat);
+  AlcFree(op.crsBuf);
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Projects the given vector onto the orthogonal complement
+*		of the polynomial space, in place.
+* \param	op			Iterative solution operator.
+* \param	x			Given vector.
+*/
+static void	WlzBasisFnItrProject(WlzBasisFnItrOp *op, double *x)
+{
+  int		idK;
+
+  for(idK = 0; idK < op->nPoly; ++idK)
+  {
+    double	d;
+
+    d = AlgVectorDot(op->q[idK], x, op->n);
+    AlgVectorScaleAdd(x, op->q[idK], x, -d, op->n);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Matrix vector product function used by
+*		AlgMatrixCGSolveFn(), which computes the products of the
+*		projected basis function matrix with each of the given
+*		vectors. The vectors are projected into the batch
+*		evaluation coefficient arrays which are then used for the
+*		products.
+* \param	data			Used to pass the iterative solution
+*					operator.
+* \param	x			Given vectors.
+* \param	y			Destination for the products.
+*/
+static void	WlzBasisFnItrProduct(void *data, double **x, double **y)
+{
+  int		idC;
+  WlzBasisFnItrOp *op;
+
+  op = (WlzBasisFnItrOp *)data;
+  for(idC = 0; idC < op->dim; ++idC)
+  {
+    AlgVectorCopy(op->bat->co[idC], x[idC], op->n);
+    WlzBasisFnItrProject(op, op->bat->co[idC]);
+  }
+  WlzBasisFnItrKernel(op, op->bat->co, y);
+  for(idC = 0; idC < op->dim; ++idC)
+  {
+    WlzBasisFnItrProject(op, y[idC]);
+    AlgVectorScale(y[idC], y[idC], op->sgn * op->scale, op->n);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Computes the unscaled products of the basis function
+*		matrix with the given vectors, which must be the batch
+*		evaluation coefficient arrays. Compactly supported basis
+*		functions use the sparse matrix while all others use
+*		batch evaluation at the control points. Any error is set
+*		in the operator.
+* \param	op			Iterative solution operator.
+* \param	x			Given vectors.
+* \param	y			Destination for the products.
+*/
+static void	WlzBasisFnItrKernel(WlzBasisFnItrOp *op,
+				    double **x, double **y)
+{
+  int		idN;
+  WlzErrorNum	errNum;
+
+  if(op->row)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idN = 0; idN < op->n; ++idN)
+    {
+      int	idC,
+		idK;
+
+      for(idC = 0; idC < op->dim; ++idC)
+      {
+	double	sum = 0.0;
+
+	for(idK = op->row[idN]; idK < op->row[idN + 1]; ++idK)
+	{
+	  sum += op->val[idK] * x[idC][op->col[idK]];
+	}
+	y[idC][idN] = sum;
+      }
+    }
+  }
+  else
+  {
+    op->bat->tol = op->tol;
+    errNum = WlzBasisFnBatchEval(op->bat, op->n, op->bat->pos, y);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      op->errNum = errNum;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Builds the sparse basis function matrix of a compactly
+*		supported basis function in compressed row form. The
+*		control points are sorted into cells with the width of
+*		the support radius so that only the control points in
+*		neighbouring cells need be compared.
+* \param	op			Iterative solution operator with
+*					the batch evaluation data set.
+*/
+static WlzErrorNum WlzBasisFnItrSparse(WlzBasisFnItrOp *op)
+{
+  int		idD,
+		idN,
+		n,
+		dim,
+		pass;
+  long long	nnz = 0;
+  double	rho,
+		cells = 1.0;
+  int		nCell[3];
+  double	pMin[3];
+  long long	*keys = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  n = op->n;
+  dim = op->dim;
+  rho = op->bat->delta;
+  for(idD = 0; idD < dim; ++idD)
+  {
+    double	pMax;
+
+    pMin[idD] = DBL_MAX;
+    pMax = -DBL_MAX;
+    for(idN = 0; idN < n; ++idN)
+    {
+      pMin[idD] = WLZ_MIN(pMin[idD], op->bat->pos[idD][idN]);
+      pMax = WLZ_MAX(pMax, op->bat->pos[idD][idN]);
+    }
+    cells *= nCell[idD] = (int )floor((pMax - pMin[idD]) / rho) + 1;
+  }
+  if((rho <= 0.0) || (cells > 1.0e18))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((keys = (long long *)
+                   AlcMalloc(2 * n * sizeof(long long))) == NULL) ||
+          ((op->row = (int *)AlcCalloc(n + 1, sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Sort the (cell key, index) pairs by cell key. */
+    for(idN = 0; idN < n; ++idN)
+    {
+      long long	k = 0;
+
+      for(idD = dim - 1; idD >= 0; --idD)
+      {
+	k = (k * nCell[idD]) +
+	    (int )floor((op->bat->pos[idD][idN] - pMin[idD]) / rho);
+      }
+      keys[2 * idN] = k;
+      keys[(2 * idN) + 1] = idN;
+    }
+    qsort(keys, n, 2 * sizeof(long long), WlzBasisFnItrKeyCmp);
+  }
+  /* Count the non-zero entries of each row in the first pass and then
+   * fill them in the second. */
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+  {
+    if(pass == 1)
+    {
+      for(idN = 0; idN < n; ++idN)
+      {
+        nnz += op->row[idN + 1];
+	op->row[idN + 1] = (int )nnz;
+      }
+      if(nnz > INT_MAX)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else if(((op->col = (int *)AlcMalloc(nnz * sizeof(int))) == NULL) ||
+              ((op->val = (double *)AlcMalloc(nnz * sizeof(double))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
+        break;
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for(idN = 0; idN < n; ++idN)
+    {
+      int	idE,
+		idO,
+		cnt = 0,
+		nOff;
+      int	c[3],
+      		cc[3];
+      double	p[3];
+
+      nOff = (dim == 2)? 9: 27;
+      for(idE = 0; idE < dim; ++idE)
+      {
+        p[idE] = op->bat->pos[idE][idN];
+	c[idE] = (int )floor((p[idE] - pMin[idE]) / rho);
+      }
+      for(idO = 0; idO < nOff; ++idO)
+      {
+        int	o,
+		lo,
+		hi,
+		ok = 1;
+	long long k = 0;
+
+	o = idO;
+	for(idE = 0; idE < dim; ++idE)
+	{
+	  cc[idE] = c[idE] + (o % 3) - 1;
+	  o /= 3;
+	  ok = ok && (cc[idE] >= 0) && (cc[idE] < nCell[idE]);
+	}
+	if(ok)
+	{
+	  for(idE = dim - 1; idE >= 0; --idE)
+	  {
+	    k = (k * nCell[idE]) + cc[idE];
+	  }
+	  /* Find the first entry with this key. */
+	  lo = 0;
+	  hi = n;
+	  while(lo < hi)
+	  {
+	    int	mid;
+
+	    mid = (lo + hi) / 2;
+	    if(keys[2 * mid] < k)
+	    {
+	      lo = mid + 1;
+	    }
+	    else
+	    {
+	      hi = mid;
+	    }
+	  }
+	  while((lo < n) && (keys[2 * lo] == k))
+	  {
+	    int	j;
+	    double d,
+		   s = 0.0;
+
+	    j = (int )keys[(2 * lo) + 1];
+	    for(idE = 0; idE < dim; ++idE)
+	    {
+	      d = p[idE] - op->bat->pos[idE][j];
+	      s += d * d;
+	    }
+	    d = sqrt(s) / rho;
+	    if(d < 1.0)
+	    {
+	      if(pass == 1)
+	      {
+		s = (1.0 - d) * (1.0 - d);
+		op->col[op->row[idN] + cnt] = j;
+		op->val[op->row[idN] + cnt] = s * s * ((4.0 * d) + 1.0);
+	      }
+	      ++cnt;
+	    }
+	    ++lo;
+	  }
+	}
+      }
+      if(pass == 0)
+      {
+        op->row[idN + 1] = cnt;
+      }
+    }
+  }
+  AlcFree(keys);
+  return(errNum);
+}
+
+/*!
+* \return	Negative, zero or positive as the first key is less than,
+*		equal to or greater than the second.
+* \ingroup	WlzFunction
+* \brief	Compares (cell key, index) pairs for sorting control points
+*		into cells.
+* \param	p0			First pair.
+* \param	p1			Second pair.
+*/
+static int	WlzBasisFnItrKeyCmp(const void *p0, const void *p1)
+{
+  int		cmp;
+  const long long *k0,
+  		  *k1;
+
+  k0 = (const long long *)p0;
+  k1 = (const long long *)p1;
+  cmp = (k0[0] < k1[0])? -1: (k0[0] > k1[0])? 1:
+        (k0[1] < k1[1])? -1: (k0[1] > k1[1])? 1: 0;
+  return(cmp);
+}
+
+/*!
+* \return	Basis function value.
+* \ingroup	WlzFunction
+* \brief	Computes the value of a radial basis function for the given
+*		squared distance, without any scaling, in the same way as
+*		the evaluation functions.
+* \param	type			Basis function type.
+* \param	delta			Basis function parameter.
+* \param	s			Squared distance.
+*/
+static double	WlzBasisFnItrPhi(WlzFnType type, double delta, double s)
+{
+  double	phi = 0.0;
+
+  switch(type)
+  {
+    case WLZ_FN_BASIS_2DTPS:
+      phi = (s > DBL_EPSILON)? s * log(s): 0.0;
+      break;
+    case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DMQ:
+      phi = sqrt(s + delta);
+      break;
+    case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DIMQ:
+      phi = 1.0 / sqrt(s + delta);
+      break;
+    case WLZ_FN_BASIS_2DCS: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DCS:
+      s = sqrt(s) / delta;
+      if(s < 1.0)
+      {
+        phi = (1.0 - s) * (1.0 - s);
+	phi = phi * phi * ((4.0 * s) + 1.0);
+      }
+      break;
+    default:
+      break;
+  }
+  return(phi);
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Makes a preconditioner for the iterative solution of the
+*		basis function design equations from local Lagrange
+*		functions, as in the Krylov subspace method of Faul,
+*		Goodsell and Powell (IMA J. Numer. Anal. 25, 2005).
+*		The control points are put into a pseudo random order and
+*		for each point, other than the last in the order, a
+*		Lagrange function is found on the point together with its
+*		nearest neighbours from those which follow it in the
+*		order. Scaled by the inverse square root of their own
+*		coefficient, these functions are close to orthonormal
+*		with respect to the semi-inner product of the basis
+*		function, so the sum of their coefficient outer products
+*		approximates the inverse of the projected matrix. The
+*		last points in the order, which are spread over the
+*		control points, form a coarse level for which the design
+*		equations are inverted.
+* \param	op			Iterative solution operator.
+* \param	type			Basis function type.
+*/
+static WlzErrorNum WlzBasisFnItrPreconMake(WlzBasisFnItrOp *op,
+					   WlzFnType type)
+{
+  int		idD,
+		idK,
+		idN,
+		n,
+		nL,
+		nCell = 1;
+  unsigned int	rnd = 2463534242u;
+  double	cSz,
+		rg = 0.0;
+  int		nCA[3];
+  double	pMin[3],
+		pExt[3];
+  int		*ord = NULL,
+		*head = NULL,
+		*next = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  n = op->n;
+  nL = WLZ_BASISFN_ITR_LGR;
+  op->nCrs = WLZ_MIN(n, WLZ_BASISFN_ITR_CRS);
+  op->nLgr = n - op->nCrs;
+  if(((ord = (int *)AlcMalloc(n * sizeof(int))) == NULL) ||
+     ((next = (int *)AlcMalloc(n * sizeof(int))) == NULL) ||
+     ((op->crsIdx = (int *)AlcMalloc(op->nCrs * sizeof(int))) == NULL) ||
+     ((op->crsMat = (double *)AlcMalloc((size_t )(op->nCrs) * op->nCrs *
+					sizeof(double))) == NULL) ||
+     ((op->crsBuf = (double *)AlcMalloc(op->dim * op->nCrs *
+					sizeof(double))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((op->nLgr > 0) &&
+	  (((op->lgrIdx = (int *)AlcMalloc((size_t )(op->nLgr) * nL *
+					   sizeof(int))) == NULL) ||
+	   ((op->lgrCo = (double *)AlcMalloc((size_t )(op->nLgr) * nL *
+					     sizeof(double))) == NULL) ||
+	   ((op->lgrBuf = (double *)AlcMalloc(op->dim * op->nLgr *
+					      sizeof(double))) == NULL)))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Pseudo random order using a xorshift generator with a fixed
+     * seed, so that the preconditioner is reproducible. */
+    for(idN = 0; idN < n; ++idN)
+    {
+      ord[idN] = idN;
+    }
+    for(idN = n - 1; idN > 0; --idN)
+    {
+      int	t;
+
+      rnd ^= rnd << 13;
+      rnd ^= rnd >> 17;
+      rnd ^= rnd << 5;
+      idK = rnd % (idN + 1);
+      t = ord[idN];
+      ord[idN] = ord[idK];
+      ord[idK] = t;
+    }
+    for(idK = 0; idK < op->nCrs; ++idK)
+    {
+      op->crsIdx[idK] = ord[op->nLgr + idK];
+    }
+    errNum = WlzBasisFnItrPreconSet(op, type, op->nCrs, op->crsIdx,
+				    op->crsMat);
+  }
+  if((errNum == WLZ_ERR_NONE) && (op->nLgr > 0))
+  {
+    /* Cells for the nearest neighbour search, with on average about
+     * two control points in each. */
+    for(idD = 0; idD < op->dim; ++idD)
+    {
+      double	pMax;
+
+      pMin[idD] = pMax = op->bat->pos[idD][0];
+      for(idN = 1; idN < n; ++idN)
+      {
+	double	p;
+
+	p = op->bat->pos[idD][idN];
+	pMin[idD] = WLZ_MIN(pMin[idD], p);
+	pMax = WLZ_MAX(pMax, p);
+      }
+      pExt[idD] = pMax - pMin[idD];
+      rg = WLZ_MAX(rg, pExt[idD]);
+    }
+    cSz = rg / ceil(pow(0.5 * n, 1.0 / op->dim));
+    if(cSz < DBL_EPSILON)
+    {
+      cSz = 1.0;
+    }
+    for(idD = 0; idD < op->dim; ++idD)
+    {
+      nCA[idD] = (int )floor(pExt[idD] / cSz) + 1;
+      nCell *= nCA[idD];
+    }
+    if((head = (int *)AlcMalloc(nCell * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (op->nLgr > 0))
+  {
+    /* Each point's neighbours are found from the points which follow it
+     * in the order, which are those already in the cells. */
+    for(idK = 0; idK < nCell; ++idK)
+    {
+      head[idK] = -1;
+    }
+    for(idK = n - 1; idK >= 0; --idK)
+    {
+      int	c;
+
+      if(idK < op->nLgr)
+      {
+	op->lgrIdx[idK * nL] = ord[idK];
+	WlzBasisFnItrNearest(op, head, next, nCA, pMin, cSz, ord[idK],
+			     nL - 1, op->lgrIdx + (idK * nL) + 1);
+      }
+      c = 0;
+      for(idD = op->dim - 1; idD >= 0; --idD)
+      {
+	c = (c * nCA[idD]) +
+	    (int )floor((op->bat->pos[idD][ord[idK]] - pMin[idD]) / cSz);
+      }
+      next[ord[idK]] = head[c];
+      head[c] = ord[idK];
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (op->nLgr > 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      double	*m;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if((m = (double *)AlcMalloc(nL * nL * sizeof(double))) == NULL)
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idK = 0; idK < op->nLgr; ++idK)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int	idJ;
+	  double *co;
+
+	  co = op->lgrCo + (idK * nL);
+	  errNum2 = WlzBasisFnItrPreconSet(op, type, nL,
+					   op->lgrIdx + (idK * nL), m);
+	  if((errNum2 == WLZ_ERR_NONE) && (m[0] > DBL_EPSILON))
+	  {
+	    double s;
+
+	    s = 1.0 / sqrt(m[0]);
+	    for(idJ = 0; idJ < nL; ++idJ)
+	    {
+	      co[idJ] = s * m[idJ];
+	    }
+	  }
+	  else
+	  {
+	    /* Singular local system, so no Lagrange function. */
+	    for(idJ = 0; idJ < nL; ++idJ)
+	    {
+	      co[idJ] = 0.0;
+	    }
+	  }
+	}
+      }
+      AlcFree(m);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzBasisFnItrPreconMake)
+#endif
+        {
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  AlcFree(ord);
+  AlcFree(next);
+  AlcFree(head);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Finds the nearest neighbours of a control point from the
+*		control points in the cells used by
+*		WlzBasisFnItrPreconMake(). Cells are searched in shells
+*		of increasing size until no closer control points can be
+*		found. There must be at least the required number of
+*		control points in the cells.
+* \param	op			Iterative solution operator.
+* \param	head			First control point of each cell's
+*					list, -1 for an empty cell.
+* \param	next			Next control point in the lists.
+* \param	nCA			Number of cells along each axis.
+* \param	pMin			Minimum coordinates of the cells.
+* \param	cSz			Cell size.
+* \param	p			Index of the given control point.
+* \param	nNbr			Required number of neighbours.
+* \param	nbr			Destination for the indices of the
+*					neighbours.
+*/
+static void	WlzBasisFnItrNearest(WlzBasisFnItrOp *op,
+				     int *head, int *next,
+				     int *nCA, double *pMin, double cSz,
+				     int p, int nNbr, int *nbr)
+{
+  int		idD,
+		idR,
+		cnt = 0,
+		rMax = 0;
+  int		c[3],
+		o[3],
+		lo[3],
+		hi[3];
+  double	d2[WLZ_BASISFN_ITR_LGR];
+
+  for(idD = 0; idD < 3; ++idD)
+  {
+    c[idD] = lo[idD] = hi[idD] = 0;
+  }
+  for(idD = 0; idD < op->dim; ++idD)
+  {
+    c[idD] = (int )floor((op->bat->pos[idD][p] - pMin[idD]) / cSz);
+    rMax = WLZ_MAX(rMax, WLZ_MAX(c[idD], nCA[idD] - 1 - c[idD]));
+  }
+  for(idR = 0; idR <= rMax; ++idR)
+  {
+    for(idD = 0; idD < op->dim; ++idD)
+    {
+      lo[idD] = WLZ_MAX(c[idD] - idR, 0);
+      hi[idD] = WLZ_MIN(c[idD] + idR, nCA[idD] - 1);
+    }
+    for(o[2] = lo[2]; o[2] <= hi[2]; ++o[2])
+    {
+      for(o[1] = lo[1]; o[1] <= hi[1]; ++o[1])
+      {
+	for(o[0] = lo[0]; o[0] <= hi[0]; ++o[0])
+	{
+	  int	j,
+		cI = 0,
+		shell = 0;
+
+	  /* Only the cells of the current shell. */
+	  for(idD = op->dim - 1; idD >= 0; --idD)
+	  {
+	    shell |= abs(o[idD] - c[idD]) == idR;
+	    cI = (cI * nCA[idD]) + o[idD];
+	  }
+	  if(shell)
+	  {
+	    for(j = head[cI]; j >= 0; j = next[j])
+	    {
+	      int	k;
+	      double	s = 0.0;
+
+	      for(idD = 0; idD < op->dim; ++idD)
+	      {
+		double	t;
+
+		t = op->bat->pos[idD][j] - op->bat->pos[idD][p];
+		s += t * t;
+	      }
+	      if((cnt < nNbr) || (s < d2[nNbr - 1]))
+	      {
+		/* Insertion into the sorted neighbours. */
+		k = (cnt < nNbr)? cnt++: nNbr - 1;
+		while((k > 0) && (d2[k - 1] > s))
+		{
+		  d2[k] = d2[k - 1];
+		  nbr[k] = nbr[k - 1];
+		  --k;
+		}
+		d2[k] = s;
+		nbr[k] = j;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    if((cnt == nNbr) && (d2[nNbr - 1] <= (idR * cSz) * (idR * cSz)))
+    {
+      break;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzFunction
+* \brief	Inverts the (slightly regularised) local design equations,
+*		including a local polynomial, of the given control points
+*		and keeps the basis function part of the inverse. The
+*		rows of this are the coefficients of the Lagrange
+*		functions on the control points and together they
+*		approximate the inverse of the projected matrix for the
+*		control points. If the local system is singular, eg
+*		because of coincident control points, the matrix is set
+*		to zero.
+* \param	op			Iterative solution operator.
+* \param	type			Basis function type.
+* \param	b			Number of control points.
+* \param	bI			Indices of the control points.
+* \param	m			Destination for the b x b matrix.
+*/
+static WlzErrorNum WlzBasisFnItrPreconSet(WlzBasisFnItrOp *op,
+					  WlzFnType type, int b, int *bI,
+					  double *m)
+{
+  int		idI,
+		idJ,
+		idK,
+		nP = 0,
+		nSys;
+  double	aMax = 0.0,
+		rg = 0.0;
+  double	cen[3];
+  double	*qBuf = NULL;
+  double	*q[4];
+  AlgMatrix	aM;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  aM.core = NULL;
+  nSys = b + op->nPoly;
+  if(((qBuf = (double *)AlcMalloc(op->nPoly * b *
+				  sizeof(double))) == NULL) ||
+     ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    double	**a;
+
+    /* Local orthonormal polynomial basis, dropping any degenerate
+     * terms. */
+    for(idK = 0; idK < op->dim; ++idK)
+    {
+      double	vMin,
+		vMax;
+
+      cen[idK] = 0.0;
+      vMin = DBL_MAX;
+      vMax = -DBL_MAX;
+      for(idI = 0; idI < b; ++idI)
+      {
+	double	v;
+
+	v = op->bat->pos[idK][bI[idI]];
+	cen[idK] += v;
+	vMin = WLZ_MIN(vMin, v);
+	vMax = WLZ_MAX(vMax, v);
+      }
+      cen[idK] /= b;
+      rg = WLZ_MAX(rg, vMax - vMin);
+    }
+    if(rg < DBL_EPSILON)
+    {
+      rg = 1.0;
+    }
+    for(idK = 0; idK < op->nPoly; ++idK)
+    {
+      double	nrm;
+      double	*v;
+
+      v = q[nP] = qBuf + (nP * b);
+      for(idI = 0; idI < b; ++idI)
+      {
+	v[idI] = (idK == 0)? 1.0:
+		 (op->bat->pos[idK - 1][bI[idI]] - cen[idK - 1]) / rg;
+      }
+      for(idJ = 0; idJ < nP; ++idJ)
+      {
+	double	d = 0.0;
+
+	for(idI = 0; idI < b; ++idI)
+	{
+	  d += q[idJ][idI] * v[idI];
+	}
+	for(idI = 0; idI < b; ++idI)
+	{
+	  v[idI] -= d * q[idJ][idI];
+	}
+      }
+      nrm = 0.0;
+      for(idI = 0; idI < b; ++idI)
+      {
+	nrm += v[idI] * v[idI];
+      }
+      nrm = sqrt(nrm);
+      if((nrm > 1.0e-06 * sqrt((double )b)) && (nP < b))
+      {
+	for(idI = 0; idI < b; ++idI)
+	{
+	  v[idI] /= nrm;
+	}
+	++nP;
+      }
+    }
+    /* Local design equations. */
+    nSys = b + nP;
+    a = aM.rect->array;
+    AlgMatrixZero(aM);
+    for(idI = 0; idI < b; ++idI)
+    {
+      for(idJ = 0; idJ <= idI; ++idJ)
+      {
+	double	d,
+		s = 0.0;
+
+	for(idK = 0; idK < op->dim; ++idK)
+	{
+	  d = op->bat->pos[idK][bI[idI]] - op->bat->pos[idK][bI[idJ]];
+	  s += d * d;
+	}
+	a[idI][idJ] = a[idJ][idI] = op->sgn * op->scale *
+		      WlzBasisFnItrPhi(type, op->bat->delta, s);
+      }
+      for(idK = 0; idK < nP; ++idK)
+      {
+	a[idI][b + idK] = a[b + idK][idI] = q[idK][idI];
+      }
+    }
+    /* Regularise the basis function block, which may be very poorly
+     * conditioned for flat basis functions, and remove the unused rows
+     * and columns, which are all zero, by making them the identity. */
+    for(idI = 0; idI < b; ++idI)
+    {
+      for(idJ = 0; idJ < b; ++idJ)
+      {
+	aMax = WLZ_MAX(aMax, fabs(a[idI][idJ]));
+      }
+    }
+    for(idI = 0; idI < b; ++idI)
+    {
+      a[idI][idI] += WLZ_BASISFN_ITR_REG * aMax;
+    }
+    for(idK = nSys; idK < b + op->nPoly; ++idK)
+    {
+      a[idK][idK] = 1.0;
+    }
+    if(AlgMatrixLUInvert(aM) != ALG_ERR_NONE)
+    {
+      for(idI = 0; idI < b; ++idI)
+      {
+	for(idJ = 0; idJ < b; ++idJ)
+	{
+	  m[(idI * b) + idJ] = 0.0;
+	}
+      }
+    }
+    else
+    {
+      /* The basis function block of the inverse, which is symmetric
+       * up to rounding errors. */
+      for(idI = 0; idI < b; ++idI)
+      {
+	for(idJ = 0; idJ < b; ++idJ)
+	{
+	  m[(idI * b) + idJ] = 0.5 * (a[idI][idJ] + a[idJ][idI]);
+	}
+      }
+    }
+  }
+  AlcFree(qBuf);
+  AlgMatrixFree(aM);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Preconditioning function used by AlgMatrixCGSolveFn(),
+*		which applies the local Lagrange function and coarse level
+*		preconditioner to each of the given residual vectors and
+*		projects the results.
+* \param	data			Used to pass the iterative solution
+*					operator.
+* \param	r			Given residual vectors.
+* \param	z			Destination vectors.
+*/
+static void	WlzBasisFnItrPrecon(void *data, double **r, double **z)
+{
+  int		idC,
+		idI,
+		idK,
+		nC,
+		nL;
+  WlzBasisFnItrOp *op;
+
+  op = (WlzBasisFnItrOp *)data;
+  nC = op->nCrs;
+  nL = WLZ_BASISFN_ITR_LGR;
+  for(idC = 0; idC < op->dim; ++idC)
+  {
+    AlgVectorZero(z[idC], op->n);
+  }
+  if(op->nLgr > 0)
+  {
+    /* Inner products of the Lagrange functions with the residuals,
+     * which are then scattered. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idK = 0; idK < op->nLgr; ++idK)
+    {
+      int	idC2,
+		idJ;
+      int	*li;
+      double	*co;
+
+      li = op->lgrIdx + ((size_t )idK * nL);
+      co = op->lgrCo + ((size_t )idK * nL);
+      for(idC2 = 0; idC2 < op->dim; ++idC2)
+      {
+	double	s = 0.0;
+
+	for(idJ = 0; idJ < nL; ++idJ)
+	{
+	  s += co[idJ] * r[idC2][li[idJ]];
+	}
+	op->lgrBuf[(idC2 * op->nLgr) + idK] = s;
+      }
+    }
+    for(idC = 0; idC < op->dim; ++idC)
+    {
+      for(idK = 0; idK < op->nLgr; ++idK)
+      {
+	int	idJ;
+	int	*li;
+	double	s;
+	double	*co;
+
+	li = op->lgrIdx + ((size_t )idK * nL);
+	co = op->lgrCo + ((size_t )idK * nL);
+	s = op->lgrBuf[(idC * op->nLgr) + idK];
+	for(idJ = 0; idJ < nL; ++idJ)
+	{
+	  z[idC][li[idJ]] += s * co[idJ];
+	}
+      }
+    }
+  }
+  /* Coarse level. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idI = 0; idI < nC; ++idI)
+  {
+    int		idC2,
+		idJ;
+    double	*m;
+
+    m = op->crsMat + ((size_t )idI * nC);
+    for(idC2 = 0; idC2 < op->dim; ++idC2)
+    {
+      double	s = 0.0;
+
+      for(idJ = 0; idJ < nC; ++idJ)
+      {
+	s += m[idJ] * r[idC2][op->crsIdx[idJ]];
+      }
+      op->crsBuf[(idC2 * nC) + idI] = s;
+    }
+  }
+  for(idC = 0; idC < op->dim; ++idC)
+  {
+    for(idI = 0; idI < nC; ++idI)
+    {
+      z[idC][op->crsIdx[idI]] += op->crsBuf[(idC * nC) + idI];
+    }
+    WlzBasisFnItrProject(op, z[idC]);
+  }
+}
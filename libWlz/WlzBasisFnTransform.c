@@ -49,6 +49,38 @@ static char _WlzBasisFnTransform_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \def		WLZ_BASISFN_TR_ITR_NPTS
+* \ingroup	WlzTransform
+* \brief	Multi-quadric and thin-plate spline basis functions with
+* 		more than this number of control points and Euclidean
+* 		distances have their design equations solved iteratively,
+* 		since a direct solution would be too slow and need too
+* 		much memory. Inverse multi-quadric design equations are
+* 		too poorly conditioned for the iterative solver to
+* 		converge reliably with the default delta, so they are
+* 		always solved directly.
+*/
+#define WLZ_BASISFN_TR_ITR_NPTS	(512)
+
+/*!
+* \def		WLZ_BASISFN_TR_ITR_MAX
+* \ingroup	WlzTransform
+* \brief	Maximum number of iterations for the iterative solution of
+* 		basis function design equations before falling back to a
+* 		direct solution. The preconditioned iterative solution
+* 		usually converges in a few tens of iterations.
+*/
+#define WLZ_BASISFN_TR_ITR_MAX	(200)
+
+/*!
+* \def		WLZ_BASISFN_TR_ITR_TOL
+* \ingroup	WlzTransform
+* \brief	Relative residual tolerance for the iterative solution of
+* 		basis function design equations.
+*/
+#define WLZ_BASISFN_TR_ITR_TOL	(1.0e-06)
+
 /*!
 * \return	New Basis function transform.
 * \ingroup	WlzTransform
@@ -153,6 +185,17 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2D(WlzFnType type,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		For compactly supported basis functions the parameter is
+*		the support radius as a fraction of the control point
+*		range, with default 0.1.
+*		When there are more than WLZ_BASISFN_TR_ITR_NPTS control
+*		points and no mesh is given, the design equations of
+*		multi-quadric and thin-plate spline basis functions are
+*		solved iteratively using WlzBasisFnItr2DFromCPts(), as
+*		they always are for compactly supported basis functions.
+*		If the iterative solution fails to converge then they are
+*		solved directly. Inverse multi-quadric design equations
+*		are always solved directly.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_2DPOLY.
@@ -187,10 +230,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 {
   WlzBasisFnTransform *basisTr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
+  int		itr;
   const double	deltaMQ = 0.001,
 		deltaIMQ = 0.300,
+		deltaCS = 0.100,
   		paramGauss = 0.9;
 
+  itr = (mesh == NULL) && (nDPts > WLZ_BASISFN_TR_ITR_NPTS);
   if((nDPts != nSPts) || (nDPts <= 0))
   {
     errNum = WLZ_ERR_PARAM_DATA;
@@ -238,16 +284,47 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 					NULL, mesh, &errNum);
 	break;
       case WLZ_FN_BASIS_2DMQ:
-	basisTr->basisFn = WlzBasisFnMQ2DFromCPts(nDPts,
+	if(itr)
+	{
+	  basisTr->basisFn = WlzBasisFnItr2DFromCPts(type, nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: deltaMQ,
+					WLZ_BASISFN_TR_ITR_TOL,
+					WLZ_BASISFN_TR_ITR_MAX, &errNum);
+	}
+	if((itr == 0) || (errNum == WLZ_ERR_ALG_CONVERGENCE))
+	{
+	  errNum = WLZ_ERR_NONE;
+	  basisTr->basisFn = WlzBasisFnMQ2DFromCPts(nDPts,
 					dPts, sPts,
 					((nParam > 0) && (param != NULL))?
 					*param: deltaMQ,
 					NULL, mesh, &errNum);
+	}
 	break;
       case WLZ_FN_BASIS_2DTPS:
-	basisTr->basisFn = WlzBasisFnTPS2DFromCPts(nDPts,
+	if(itr)
+	{
+	  basisTr->basisFn = WlzBasisFnItr2DFromCPts(type, nDPts,
+					dPts, sPts, 0.0,
+					WLZ_BASISFN_TR_ITR_TOL,
+					WLZ_BASISFN_TR_ITR_MAX, &errNum);
+	}
+	if((itr == 0) || (errNum == WLZ_ERR_ALG_CONVERGENCE))
+	{
+	  errNum = WLZ_ERR_NONE;
+	  basisTr->basisFn = WlzBasisFnTPS2DFromCPts(nDPts,
 					dPts, sPts, NULL, mesh,
 					&errNum);
+	}
+	break;
+      case WLZ_FN_BASIS_2DCS:
+	basisTr->basisFn = WlzBasisFnItr2DFromCPts(type, nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: deltaCS,
+					WLZ_BASISFN_TR_ITR_TOL, 0, &errNum);
 	break;
       case WLZ_FN_BASIS_2DCONF_POLY:
 	basisTr->basisFn = WlzBasisFnConf2DFromCPts(nDPts,
@@ -286,6 +363,9 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 *		supply the multi-quadric delta or gauss parameter scaling.
 *		The default values of multi-quadric delta = 0.001 and
 *		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		As for WlzBasisFnTrFromCPts2DParam(), multi-quadrics with
+*		large numbers of control points and compactly supported
+*		basis functions use WlzBasisFnItr3DFromCPts().
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_3DPOLY.
@@ -320,9 +400,12 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
 {
   WlzBasisFnTransform *basisTr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
+  int		itr;
   const double	deltaMQ = 0.001,
-		deltaIMQ = 0.100;
+		deltaIMQ = 0.100,
+		deltaCS = 0.100;
 
+  itr = (mesh == NULL) && (nDPts > WLZ_BASISFN_TR_ITR_NPTS);
   if((nDPts != nSPts) || (nDPts <= 0))
   {
     errNum = WLZ_ERR_PARAM_DATA;
@@ -358,11 +441,31 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
 					NULL, mesh, &errNum);
 	break;
       case WLZ_FN_BASIS_3DMQ:
-	basisTr->basisFn = WlzBasisFnMQ3DFromCPts(nDPts,
+	if(itr)
+	{
+	  basisTr->basisFn = WlzBasisFnItr3DFromCPts(type, nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: deltaMQ,
+					WLZ_BASISFN_TR_ITR_TOL,
+					WLZ_BASISFN_TR_ITR_MAX, &errNum);
+	}
+	if((itr == 0) || (errNum == WLZ_ERR_ALG_CONVERGENCE))
+	{
+	  errNum = WLZ_ERR_NONE;
+	  basisTr->basisFn = WlzBasisFnMQ3DFromCPts(nDPts,
 					dPts, sPts,
 					((nParam > 0) && (param != NULL))?
 					*param: deltaMQ,
 					NULL, mesh, &errNum);
+	}
+	break;
+      case WLZ_FN_BASIS_3DCS:
+	basisTr->basisFn = WlzBasisFnItr3DFromCPts(type, nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: deltaCS,
+					WLZ_BASISFN_TR_ITR_TOL, 0, &errNum);
 	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
@@ -581,15 +684,16 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3D(WlzFnType type,
 * \return	Error number.
 * \ingroup	WlzTransform
 * \brief	Sets the displacements of the given mesh transform according
-* 		to the basis function transform.
+* 		to the basis function transform. The displacements are
+* 		evaluated using WlzBasisFnValueBatch2D().
 * \param	mesh			Given mesh transform.
 * \param	basisTr			Given basis function transform.
 */
 WlzErrorNum    	WlzBasisFnSetMesh(WlzMeshTransform *mesh,
 				  WlzBasisFnTransform *basisTr)
 {
-  int		nodCnt;
-  WlzMeshNode	*nod;
+  int		idN;
+  WlzDVertex2	*vx = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((mesh == NULL) || (basisTr == NULL))
@@ -601,64 +705,30 @@ WlzErrorNum    	WlzBasisFnSetMesh(WlzMeshTransform *mesh,
   {
     errNum = WLZ_ERR_TRANSFORM_TYPE;
   }
-  else
+  else if(mesh->nNodes > 0)
   {
-    nod = mesh->nodes;
-    nodCnt = mesh->nNodes;
-    switch(basisTr->basisFn->type)
+    if((vx = (WlzDVertex2 *)
+             AlcMalloc(mesh->nNodes * sizeof(WlzDVertex2))) == NULL)
     {
-      case WLZ_FN_BASIS_2DGAUSS:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueGauss2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DPOLY:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValuePoly2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DIMQ:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueIMQ2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DMQ:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueMQ2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DTPS:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueTPS2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-    case WLZ_FN_BASIS_2DCONF_POLY:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueConf2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      default:
-	errNum = WLZ_ERR_TRANSFORM_TYPE;
-	break;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idN = 0; idN < mesh->nNodes; ++idN)
+      {
+        vx[idN] = mesh->nodes[idN].position;
+      }
+      errNum = WlzBasisFnValueBatch2D(basisTr->basisFn, mesh->nNodes,
+                                      vx, vx);
     }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < mesh->nNodes; ++idN)
+      {
+        mesh->nodes[idN].displacement = vx[idN];
+      }
+    }
+    AlcFree(vx);
   }
   return(errNum);
 }
@@ -721,9 +791,11 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
 {
   int		idN,
+		nVx = 0,
   		maxNodIdx;
+  int		*nodIdx = NULL;
   double	*dsp;
-  WlzDVertex2	dspV;
+  WlzDVertex2	*vx = NULL;
   WlzCMeshNod2D	*nod;
   WlzCMesh2D	*mesh;
   WlzIndexedValues *ixv;
@@ -768,74 +840,52 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
   {
     switch(basisTr->basisFn->type)
     {
-      case WLZ_FN_BASIS_2DGAUSS:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueGauss2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
-        break;
-      case WLZ_FN_BASIS_2DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCS:
         break;
-      case WLZ_FN_BASIS_2DMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
         break;
-      case WLZ_FN_BASIS_2DTPS:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Gather the valid node positions, evaluate them in a batch and then
+     * scatter the displacements back to the indexed values. */
+    if(((nodIdx = (int *)AlcMalloc((maxNodIdx + 1) * sizeof(int))) == NULL) ||
+       ((vx = (WlzDVertex2 *)
+              AlcMalloc((maxNodIdx + 1) * sizeof(WlzDVertex2))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      nVx = 0;
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
 	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueTPS2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
+	  nodIdx[nVx] = idN;
+	  vx[nVx++] = nod->pos;
 	}
-        break;
-      default:
-	errNum = WLZ_ERR_DOMAIN_TYPE;
-        break;
+      }
+      errNum = WlzBasisFnValueBatch2D(basisTr->basisFn, nVx, vx, vx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < nVx; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = vx[idN].vtX;
+	dsp[1] = vx[idN].vtY;
+      }
     }
+    AlcFree(nodIdx);
+    AlcFree(vx);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -885,6 +935,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
           case WLZ_FN_BASIS_2DTPS:
 	    cDspB = WlzBasisFnValueTPS2D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_2DCS:
+	    cDspB = WlzBasisFnValueCS2D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_2_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -918,9 +971,11 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
 {
   int		idN,
+		nVx = 0,
   		maxNodIdx;
+  int		*nodIdx = NULL;
   double	*dsp;
-  WlzDVertex3	dspV;
+  WlzDVertex3	*vx = NULL;
   WlzCMeshNod3D	*nod;
   WlzCMesh3D	*mesh;
   WlzIndexedValues *ixv;
@@ -965,44 +1020,51 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
   {
     switch(basisTr->basisFn->type)
     {
-      case WLZ_FN_BASIS_3DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
-	}
-	break;
-      case WLZ_FN_BASIS_3DMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
-	}
-	break;
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+        break;
       default:
         errNum = WLZ_ERR_VALUES_TYPE;
-	break;
+        break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Gather the valid node positions, evaluate them in a batch and then
+     * scatter the displacements back to the indexed values. */
+    if(((nodIdx = (int *)AlcMalloc((maxNodIdx + 1) * sizeof(int))) == NULL) ||
+       ((vx = (WlzDVertex3 *)
+              AlcMalloc((maxNodIdx + 1) * sizeof(WlzDVertex3))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      nVx = 0;
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
+	{
+	  nodIdx[nVx] = idN;
+	  vx[nVx++] = nod->pos;
+	}
+      }
+      errNum = WlzBasisFnValueBatch3D(basisTr->basisFn, nVx, vx, vx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < nVx; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = vx[idN].vtX;
+	dsp[1] = vx[idN].vtY;
+	dsp[2] = vx[idN].vtZ;
+      }
     }
+    AlcFree(nodIdx);
+    AlcFree(vx);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -1046,6 +1108,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
           case WLZ_FN_BASIS_3DMQ:
 	    cDspB = WlzBasisFnValueMQ3D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_3DCS:
+	    cDspB = WlzBasisFnValueCS3D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_3_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -2170,6 +2235,11 @@ WlzDVertex2	WlzBasisFnTransformVertexD(WlzBasisFnTransform *basisTr,
 	dstVx.vtX += srcVx.vtX;
 	dstVx.vtY += srcVx.vtY;
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	dstVx = WlzBasisFnValueCS2D(basisTr->basisFn, srcVx);
+	dstVx.vtX += srcVx.vtX;
+	dstVx.vtY += srcVx.vtY;
+	break;
       default:
 	errNum = WLZ_ERR_TRANSFORM_TYPE;
 	break;
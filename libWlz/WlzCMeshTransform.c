@@ -51,6 +51,12 @@ static char _WlzCMeshTransform_c[] = "University of Edinburgh $Id$";
 
 #define WLZ_CMESH_POS_DTOI(X) ((int )floor(X))
 
+/* Upper limit on the number of tiles of destination lines that are
+ * rasterised in parallel and the chunk size used when computing the
+ * mesh element transforms in parallel. */
+#define WLZ_CMESH_SCAN_TILES		(256)
+#define WLZ_CMESH_SCAN_ELM_CHUNKSZ	(256)
+
 /*!
 * \enum		_WlzCMeshScanElmFlags
 * \ingroup	WlzTransform
@@ -168,6 +174,21 @@ typedef struct _WlzCMeshScanWSp3D
   					    mesh. */
 } WlzCMeshScanWSp3D;
 
+/*!
+* \struct       _WlzCMeshScanGItv
+* \ingroup      WlzTransform
+* \brief        Destination grey interval for tiled conforming mesh
+* 		scanning.
+*/
+typedef struct _WlzCMeshScanGItv
+{
+  int           line;                   /*! Line of interval. */
+  int           lftI;                   /*! Start of interval. */
+  int           rgtI;                   /*! End of interval. */
+  WlzGreyP	gP;			/*! Destination grey values of the
+  					    interval. */
+} WlzCMeshScanGItv;
+
 static void 			WlzCMeshUpdateScanElm2D(
 				  WlzObject *mObj,
 				  WlzCMeshScanElm2D *sElm,
@@ -304,6 +325,16 @@ static WlzErrorNum 		WlzCMeshTransformValues2D(
 				  WlzObject *srcObj,
 				  WlzObject *mObj,
 				  WlzInterpolationType interp);
+static WlzErrorNum 		WlzCMeshTransformValTile2D(
+				  WlzObject *dstObj,
+				  WlzObject *srcObj,
+				  WlzCMeshScanWSp2D *mSWSp,
+				  WlzCMeshScanGItv *gItvs,
+				  int nGItv,
+				  int bufWidth,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzInterpolationType interp);
 static WlzErrorNum 		WlzCMeshTetElmItv3D(
 				  AlcVector *itvVec,
 				  int *idI,
@@ -329,6 +360,15 @@ static WlzErrorNum 		WlzCMeshScanObjValues3D(
 				  WlzObject *srcObj,
 				  WlzCMeshScanWSp3D *mSWSp,
 				  WlzInterpolationType interp);
+static WlzErrorNum 		WlzCMeshScanObjValuesPln3D(
+				  WlzObject *dstObj,
+				  WlzObject *srcObj,
+				  WlzCMeshScanWSp3D *mSWSp,
+				  int idP,
+				  int bufWidth,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzInterpolationType interp);
 static WlzErrorNum 		WlzCMeshScanFlushOlpBuf(
 				  WlzGreyP dGP,
 				  WlzGreyP olpBuf,
@@ -4014,13 +4054,207 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 					WlzObject *mObj,
 					WlzInterpolationType interp)
 {
-  int		idP,
+  int		nTile = 0,
+		nGItv = 0,
+		maxGItv = 0,
+		bufWidth = 0;
+  int		*tileIdx = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgdV;
+  WlzCMeshScanGItv *gItvs = NULL;
+  WlzCMeshScanWSp2D *mSWSp = NULL;
+  WlzGreyWSpace gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  bgdV = WlzGetBackground(srcObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTableTypeToGreyType(srcObj->values.v->type, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bufWidth = dstObj->domain.i->lastkl - dstObj->domain.i->kol1 + 1;
+    mSWSp = WlzCMeshScanWSpInit2D(mObj, 1, &errNum);
+  }
+  /* Compute the inverse transform coefficients for all the mesh elements
+   * up front so that the tiles only ever read them. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE,
+    		nElm;
+
+    nElm = mObj->domain.cm2->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, WLZ_CMESH_SCAN_ELM_CHUNKSZ)
+#endif
+    for(idE = 0; idE < nElm; ++idE)
+    {
+      WlzCMeshScanElm2D *sElm;
+
+      sElm = mSWSp->dElm + idE;
+      if(sElm->idx >= 0)
+      {
+        WlzCMeshUpdateScanElm2D(mSWSp->mTr, sElm, 0);
+      }
+    }
+  }
+  /* Gather the destination grey intervals, which are in line order. The
+   * new value table is not tiled so the grey pointers remain valid after
+   * the scan has ended. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(dstObj, &iWSp, &gWSp);
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      if(nGItv >= maxGItv)
+      {
+	WlzCMeshScanGItv *newGItvs;
+
+	maxGItv = (maxGItv > 0)? 2 * maxGItv: 1024;
+	if((newGItvs = (WlzCMeshScanGItv *)
+		       AlcRealloc(gItvs, sizeof(WlzCMeshScanGItv) *
+		                         maxGItv)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  gItvs = newGItvs;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzCMeshScanGItv *gItv;
+
+	gItv = gItvs + nGItv++;
+	gItv->line = iWSp.linpos;
+	gItv->lftI = iWSp.lftpos;
+	gItv->rgtI = iWSp.rgtpos;
+	gItv->gP = gWSp.u_grintptr;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  /* Bin the grey intervals into tiles of consecutive lines. */
+  if((errNum == WLZ_ERR_NONE) && (nGItv > 0))
+  {
+    int		nLn,
+    		ln1,
+		tileLn;
+
+    ln1 = gItvs[0].line;
+    nLn = gItvs[nGItv - 1].line - ln1 + 1;
+    tileLn = (nLn + WLZ_CMESH_SCAN_TILES - 1) / WLZ_CMESH_SCAN_TILES;
+    nTile = (nLn + tileLn - 1) / tileLn;
+    if((tileIdx = (int *)AlcMalloc(sizeof(int) * (nTile + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idG,
+      		idT = 0;
+
+      for(idG = 0; idG < nGItv; ++idG)
+      {
+        while(ln1 + (idT * tileLn) <= gItvs[idG].line)
+	{
+	  tileIdx[idT++] = idG;
+	}
+      }
+      while(idT <= nTile)
+      {
+        tileIdx[idT++] = nGItv;
+      }
+    }
+  }
+  /* Rasterise the tiles. Each tile accumulates its own overlaps in the
+   * same order as a single threaded scan so the values are identical. */
+  if((errNum == WLZ_ERR_NONE) && (nTile > 0))
+  {
+    int		idT;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(idT = 0; idT < nTile; ++idT)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzCMeshTransformValTile2D(dstObj, srcObj, mSWSp,
+					     gItvs + tileIdx[idT],
+					     tileIdx[idT + 1] - tileIdx[idT],
+					     bufWidth, gType, bgdV, interp);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshTransformValues)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  AlcFree(tileIdx);
+  AlcFree(gItvs);
+  WlzCMeshScanWSpFree2D(mSWSp);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Sets the values of a tile of destination grey intervals,
+*		which must be on consecutive lines, by transforming those
+*		of the source object using the precomputed element
+*		transforms of the mesh scan workspace.
+* \param	dstObj			2D destination object.
+* \param	srcObj			2D source object.
+* \param	mSWSp			Conforming mesh scan workspace.
+* \param	gItvs			Destination grey intervals of the
+* 					tile in line order.
+* \param	nGItv			Number of grey intervals in the tile.
+* \param	bufWidth		Width for the overlap buffers.
+* \param	gType			Grey type.
+* \param	bgdV			Background value.
+* \param	interp			Level of interpolation.
+*/
+static WlzErrorNum WlzCMeshTransformValTile2D(WlzObject *dstObj,
+					WlzObject *srcObj,
+					WlzCMeshScanWSp2D *mSWSp,
+					WlzCMeshScanGItv *gItvs,
+					int nGItv,
+					int bufWidth,
+					WlzGreyType gType,
+					WlzPixelV bgdV,
+					WlzInterpolationType interp)
+{
+  int		idG,
+  		idP,
   		idX,
 		iLft,
 		iRgt,
 		mItvIdx0,
 		mItvIdx1,
-		bufWidth = 0,
 		itvWidth = 0;
   double	tD0 ,
   		tD1,
@@ -4034,53 +4268,58 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
   int		*olpCnt = NULL;
   WlzGreyP	dGP,
   		olpBuf;
-  WlzGreyType	gType = WLZ_GREY_ERROR;
-  WlzPixelV	bgdV;
   WlzDVertex2	sPosD;
   WlzCMeshScanItv2D *mItv0 = NULL,
   		*mItv1 = NULL,
 		*mItv2 = NULL;
-  WlzCMeshScanWSp2D *mSWSp = NULL;
   WlzCMeshScanElm2D *sElm;
+  WlzCMeshScanGItv *gItv;
   WlzGreyValueWSpace *gVWSp = NULL;
-  WlzGreyWSpace gWSp;
-  WlzIntervalWSpace iWSp;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
   olpBuf.inp = NULL;
-  bgdV = WlzGetBackground(srcObj, &errNum);
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gType = WlzGreyTableTypeToGreyType(srcObj->values.v->type, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
-  }
-  if(errNum == WLZ_ERR_NONE)
+  if(nGItv > 0)
   {
-    bufWidth = dstObj->domain.i->lastkl - dstObj->domain.i->kol1 + 1;
     errNum = WlzCMeshScanMakeOlpBufs(dstObj, gType,
                                      &olpBuf, &olpCnt, bufWidth);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	lo,
+      		hi;
+
+      /* Find the first mesh interval which is not before the first line
+       * of the tile. */
+      lo = 0;
+      hi = mSWSp->nItvs;
+      while(lo < hi)
+      {
+        int	mid;
+
+	mid = (lo + hi) / 2;
+	if((mSWSp->itvs + mid)->line < gItvs->line)
+	{
+	  lo = mid + 1;
+	}
+	else
+	{
+	  hi = mid;
+	}
+      }
+      mItvIdx0 = lo;
+      mItv0 = mSWSp->itvs + mItvIdx0;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    mItvIdx0 = 0;
-    mSWSp = WlzCMeshScanWSpInit2D(mObj, 1, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    mItv0 = mSWSp->itvs;
-    errNum = WlzInitGreyScan(dstObj, &iWSp, &gWSp);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
-    while((errNum == WLZ_ERR_NONE) &&
-	  (WlzNextGreyInterval(&iWSp) == 0))
+    for(idG = 0; (errNum == WLZ_ERR_NONE) && (idG < nGItv); ++idG)
     {
-      dGP = gWSp.u_grintptr;
-      itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
+      gItv = gItvs + idG;
+      dGP = gItv->gP;
+      itvWidth = gItv->rgtI - gItv->lftI + 1;
       switch(gType)
       {
 	case WLZ_GREY_INT:   /* FALLTHROUGH */
@@ -4105,30 +4344,31 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
       WlzValueSetInt(olpCnt, 0, itvWidth);
       /* Update the mesh interval pointer so that it points to the first
        * mesh interval on the which intersects the current grey interval. */
-      while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
+      while((mItvIdx0 < mSWSp->nItvs) && (mItv0->line < gItv->line))
       {
 	++mItvIdx0;
 	++mItv0;
       }
-      while((mItv0->line <= iWSp.linpos) &&
-	    (mItv0->rgtI < iWSp.lftpos) &&
-	    (mItvIdx0 < mSWSp->nItvs))
+      while((mItvIdx0 < mSWSp->nItvs) &&
+	    (mItv0->line <= gItv->line) &&
+	    (mItv0->rgtI < gItv->lftI))
       {
 	++mItvIdx0;
 	++mItv0;
       }
-      if((mItv0->line == iWSp.linpos) &&
-	 (iWSp.lftpos <= mItv0->rgtI) &&
-	 (iWSp.rgtpos >= mItv0->lftI))
+      if((mItvIdx0 < mSWSp->nItvs) &&
+	 (mItv0->line == gItv->line) &&
+	 (gItv->lftI <= mItv0->rgtI) &&
+	 (gItv->rgtI >= mItv0->lftI))
       {
 	/* Mesh interval mItv0 intersects the current grey interval find
 	 * the last mesh interval mItv1 which also intersects the current grey
 	 * interval. */
 	mItv1 = mItv0;
 	mItvIdx1 = mItvIdx0;
-	while((mItv1->line == iWSp.linpos) &&
-	      (mItv1->lftI <= iWSp.rgtpos) &&
-	      (mItvIdx1 < mSWSp->nItvs))
+	while((mItvIdx1 < mSWSp->nItvs) &&
+	      (mItv1->line == gItv->line) &&
+	      (mItv1->lftI <= gItv->rgtI))
 	{
 	  ++mItvIdx1;
 	  ++mItv1;
@@ -4138,21 +4378,20 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 	/* For each mesh interval which intersects the current grey interval. */
 	while(mItv1 <= mItv2)
 	{
-	  /* Update mesh scanning. */
+	  /* Use the precomputed mesh element transform. */
 	  sElm = mSWSp->dElm + mItv1->elmIdx;
-	  WlzCMeshUpdateScanElm2D(mSWSp->mTr, sElm, 0);
 	  trXX = sElm->trX[0];
-	  trXYC = (sElm->trX[1] * iWSp.linpos) + sElm->trX[2];
+	  trXYC = (sElm->trX[1] * gItv->line) + sElm->trX[2];
 	  trYX = sElm->trY[0];
-	  trYYC = (sElm->trY[1] * iWSp.linpos) + sElm->trY[2];
+	  trYYC = (sElm->trY[1] * gItv->line) + sElm->trY[2];
 	  /* Find length of intersection and set the grey pointer. */
-	  iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
-	  iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
+	  iLft = ALG_MAX(mItv1->lftI, gItv->lftI);
+	  iRgt = ALG_MIN(mItv1->rgtI, gItv->rgtI);
 	  idX = iLft;
 	  switch(interp)
 	  {
 	    case WLZ_INTERPOLATION_NEAREST:
-	      switch(gWSp.pixeltype)
+	      switch(gType)
 	      {
 		case WLZ_GREY_INT:
 		  while(idX <= iRgt)
@@ -4163,7 +4402,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += gVWSp->gVal[0].inv;
 		    }
@@ -4179,7 +4418,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += gVWSp->gVal[0].shv;
 		    }
@@ -4195,7 +4434,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += gVWSp->gVal[0].ubv;
 		    }
@@ -4211,7 +4450,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.dbp + idP) += gVWSp->gVal[0].flv;
 		    }
@@ -4227,7 +4466,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.dbp + idP) += gVWSp->gVal[0].dbv;
 		    }
@@ -4243,7 +4482,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				    WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		    if(gVWSp->bkdFlag == 0)
 		    {
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += WLZ_RGBA_RED_GET(
 					     gVWSp->gVal[0].rgbv);
@@ -4263,7 +4502,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 	      }
 	      break;
 	    case WLZ_INTERPOLATION_LINEAR:
-	      switch(gWSp.pixeltype)
+	      switch(gType)
 	      {
 		case WLZ_GREY_INT:
 		  while(idX <= iRgt)
@@ -4282,7 +4521,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 			    ((gVWSp->gVal[2]).inv * tD2 * tD1) +
 			    ((gVWSp->gVal[3]).inv * tD0 * tD1);
 		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += WLZ_NINT(tD0);
 		    }
@@ -4292,7 +4531,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.inp + idP) += gVWSp->gVal[0].inv;
 		      }
@@ -4317,7 +4556,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 			    ((gVWSp->gVal[2]).shv * tD2 * tD1) +
 			    ((gVWSp->gVal[3]).shv * tD0 * tD1);
 		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += WLZ_NINT(tD0);
 		    }
@@ -4327,7 +4566,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.inp + idP) += gVWSp->gVal[0].shv;
 		      }
@@ -4352,7 +4591,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 			    ((gVWSp->gVal[2]).ubv * tD2 * tD1) +
 			    ((gVWSp->gVal[3]).ubv * tD0 * tD1);
 		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.inp + idP) += WLZ_NINT(tD0);
 		    }
@@ -4362,7 +4601,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.inp + idP) += gVWSp->gVal[0].ubv;
 		      }
@@ -4387,7 +4626,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 			    ((gVWSp->gVal[2]).flv * tD2 * tD1) +
 			    ((gVWSp->gVal[3]).flv * tD0 * tD1);
 		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.dbp + idP) += WLZ_NINT(tD0);
 		    }
@@ -4397,7 +4636,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.dbp + idP) += gVWSp->gVal[0].flv;
 		      }
@@ -4422,7 +4661,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 			    ((gVWSp->gVal[2]).dbv * tD2 * tD1) +
 			    ((gVWSp->gVal[3]).dbv * tD0 * tD1);
 		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      idP = idX - iWSp.lftpos;
+		      idP = idX - gItv->lftI;
 		      ++*(olpCnt + idP);
 		      *(olpBuf.dbp + idP) += WLZ_NINT(tD0);
 		    }
@@ -4432,7 +4671,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.dbp + idP) += gVWSp->gVal[0].dbv;
 		      }
@@ -4443,7 +4682,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 		case WLZ_GREY_RGBA:
 		  while(idX <= iRgt)
 		  {
-		    idP = idX - iWSp.lftpos;
+		    idP = idX - gItv->lftI;
 		    sPosD.vtX = (trXX * idX) + trXYC;
 		    sPosD.vtY = (trYX * idX) + trYYC;
 		    WlzGreyValueGetCon(gVWSp, 0, sPosD.vtY, sPosD.vtX);
@@ -4501,7 +4740,7 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
 				      WLZ_NINT(sPosD.vtY), WLZ_NINT(sPosD.vtX));
 		      if(gVWSp->bkdFlag == 0)
 		      {
-			idP = idX - iWSp.lftpos;
+			idP = idX - gItv->lftI;
 			++*(olpCnt + idP);
 			*(olpBuf.inp + idP) +=
 				  WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
@@ -4534,19 +4773,13 @@ static WlzErrorNum WlzCMeshTransformValues2D(WlzObject *dstObj,
       if(errNum == WLZ_ERR_NONE)
       {
 	errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth, bgdV,
-					 iWSp.lftpos, iWSp.rgtpos,
+					 gItv->lftI, gItv->rgtI,
 					 interp, gType);
       }
     }
-    (void )WlzEndGreyScan(&iWSp, &gWSp);
-  }
-  if(errNum == WLZ_ERR_EOO)
-  {
-    errNum = WLZ_ERR_NONE;
   }
   AlcFree(olpBuf.inp);
   AlcFree(olpCnt);
-  WlzCMeshScanWSpFree2D(mSWSp);
   WlzGreyValueFreeWSp(gVWSp);
   return(errNum);
 }
@@ -7298,13 +7531,113 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
 					WlzCMeshScanWSp3D *mSWSp,
 					WlzInterpolationType interp)
 {
-  int		idP,
-  		idI,
+  int		bufWidth = 0;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgdV;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  bgdV = WlzGetBackground(srcObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTypeFromObj(srcObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
+  }
+  /* Compute the inverse transform coefficients for all the mesh elements
+   * up front so that the planes only ever read them. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE,
+    		nElm;
+
+    bufWidth = dstObj->domain.p->lastkl - dstObj->domain.p->kol1 + 1;
+    nElm = mSWSp->mTr->domain.cm3->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, WLZ_CMESH_SCAN_ELM_CHUNKSZ)
+#endif
+    for(idE = 0; idE < nElm; ++idE)
+    {
+      WlzCMeshScanElm3D *sE;
+
+      sE = mSWSp->dElm + idE;
+      if((sE->idx >= 0) && ((sE->flags & WLZ_CMESH_SCANELM_REV) == 0))
+      {
+        WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+      }
+    }
+  }
+  /* Rasterise the planes in parallel, with the last plane excluded as
+   * it always has been. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idP,
+    		nPln;
+
+    nPln = dstObj->domain.p->lastpl - dstObj->domain.p->plane1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzCMeshScanObjValuesPln3D(dstObj, srcObj, mSWSp, idP,
+					     bufWidth, gType, bgdV, interp);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshTransformValues)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Sets the values of a single plane of the destination
+*		object by transforming those of the source object using
+*		the precomputed element transforms of the mesh scan
+*		workspace.
+* \param	dstObj			3D destination object.
+* \param	srcObj			3D source object.
+* \param	mSWSp			Conforming mesh scan workspace.
+* \param	idP			Index of the plane relative to the
+* 					first plane of the destination object.
+* \param	bufWidth		Width for the overlap buffers.
+* \param	gType			Grey type.
+* \param	bgdV			Background value.
+* \param	interp			Level of interpolation.
+*/
+static WlzErrorNum WlzCMeshScanObjValuesPln3D(WlzObject *dstObj,
+					WlzObject *srcObj,
+					WlzCMeshScanWSp3D *mSWSp,
+					int idP,
+					int bufWidth,
+					WlzGreyType gType,
+					WlzPixelV bgdV,
+					WlzInterpolationType interp)
+{
+  int		idI,
   		iLft,
 		iRgt,
 		mItvIdx0,
   		mItvIdx1,
-		bufWidth,
   		itvWidth;
   double	tD0,
   		tD1,
@@ -7314,8 +7647,6 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   int		*olpCnt = NULL;
   WlzGreyP	dGP,
   		olpBuf;
-  WlzGreyType	gType;
-  WlzPixelV	bgdV;
   WlzIVertex3	dPos,
   		sPos;
   WlzDVertex3	tV,
@@ -7324,9 +7655,7 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   WlzCMeshScanItv3D *mItv0,
   		*mItv1,
 		*mItv2;
-  WlzDomain	dom2,
-  		dom3;
-  WlzValues	val3;
+  WlzDomain	dom2;
   WlzObject	*obj2 = NULL;
   WlzGreyWSpace gWSp;
   WlzIntervalWSpace iWSp;
@@ -7334,574 +7663,568 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
   olpBuf.inp = NULL;
-  bgdV = WlzGetBackground(srcObj, &errNum);
-  if(errNum == WLZ_ERR_NONE)
+  dPos.vtZ = dstObj->domain.p->plane1 + idP;
+  dom2 = *(dstObj->domain.p->domains + idP);
+  if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN))
   {
-    gType = WlzGreyTypeFromObj(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bufWidth = dstObj->domain.p->lastkl - dstObj->domain.p->kol1 + 1;
     errNum = WlzCMeshScanMakeOlpBufs(dstObj, gType,
                                      &olpBuf, &olpCnt, bufWidth);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    mItvIdx0 = 0;
-    mItv0 = mSWSp->itvs;
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    idP = 0;
-    dom3.p = dstObj->domain.p;
-    val3.vox = dstObj->values.vox;
-    dPos.vtZ = dom3.p->plane1;
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ < dom3.p->lastpl))
+    if(errNum == WLZ_ERR_NONE)
     {
-      if(((dom2 = *(dom3.p->domains + idP)).core != NULL) &&
-         (dom2.core->type != WLZ_EMPTY_DOMAIN))
+      gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2,
+			 *(dstObj->values.vox->values + idP),
+			 NULL, NULL, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	lo,
+      		hi;
+
+      /* Find the first mesh interval which is not before the plane. */
+      lo = 0;
+      hi = mSWSp->nItvs;
+      while(lo < hi)
       {
-	(void )WlzFreeObj(obj2);
-        obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	                      *(dom3.p->domains + idP),
-			      *(val3.vox->values + idP),
-			      NULL, NULL, &errNum);
-        if(errNum == WLZ_ERR_NONE)
+        int	mid;
+
+	mid = (lo + hi) / 2;
+	if((mSWSp->itvs + mid)->plane < dPos.vtZ)
 	{
-	  errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  lo = mid + 1;
 	}
-	while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
-        {
-          itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
-	  WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
-	  dGP = gWSp.u_grintptr;
-	  /* Update the mesh interval pointer so that it points to the
-	   * first mesh interval on the which intersects the current grey
-	   * interval. */
-	  while((mItv0->plane < dPos.vtZ) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line <= iWSp.linpos) &&
-		(mItv0->rgtI < iWSp.lftpos) &&
-		(mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  if((mItv0->line == iWSp.linpos) &&
-	     (iWSp.lftpos <= mItv0->rgtI) &&
-	     (iWSp.rgtpos >= mItv0->lftI))
-	  {
-	    /* Mesh interval mItv0 intersects the current grey interval find
-	     * the last mesh interval mItv1 which also intersects the current
-	     * grey interval. */
-	    mItv1 = mItv0;
-	    mItvIdx1 = mItvIdx0;
-	    while((mItv1->line == iWSp.linpos) &&
-		  (mItv1->lftI <= iWSp.rgtpos) &&
-		  (mItvIdx1 < mSWSp->nItvs))
-	    {
-	      ++mItvIdx1;
-	      ++mItv1;
-	    }
-	    mItv2 = mItv1 - 1;
-	    mItv1 = mItv0;
-	    dPos.vtY = mItv0->line;
-	    /* For each mesh interval which intersects the current grey
-	       interval. */
-	    while(mItv1 <= mItv2)
-	    {
+	else
+	{
+	  hi = mid;
+	}
+      }
+      mItvIdx0 = lo;
+      mItv0 = mSWSp->itvs + mItvIdx0;
+      errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+    }
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
+      WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
+      dGP = gWSp.u_grintptr;
+      /* Update the mesh interval pointer so that it points to the
+       * first mesh interval on the which intersects the current grey
+       * interval. */
+      while((mItvIdx0 < mSWSp->nItvs) && (mItv0->plane < dPos.vtZ))
+      {
+	++mItvIdx0;
+	++mItv0;
+      }
+      while((mItvIdx0 < mSWSp->nItvs) && (mItv0->line < iWSp.linpos))
+      {
+	++mItvIdx0;
+	++mItv0;
+      }
+      while((mItvIdx0 < mSWSp->nItvs) &&
+	    (mItv0->line <= iWSp.linpos) &&
+	    (mItv0->rgtI < iWSp.lftpos))
+      {
+	++mItvIdx0;
+	++mItv0;
+      }
+      if((mItvIdx0 < mSWSp->nItvs) &&
+	 (mItv0->line == iWSp.linpos) &&
+	 (iWSp.lftpos <= mItv0->rgtI) &&
+	 (iWSp.rgtpos >= mItv0->lftI))
+      {
+	/* Mesh interval mItv0 intersects the current grey interval find
+	 * the last mesh interval mItv1 which also intersects the current
+	 * grey interval. */
+	mItv1 = mItv0;
+	mItvIdx1 = mItvIdx0;
+	while((mItvIdx1 < mSWSp->nItvs) &&
+	      (mItv1->line == iWSp.linpos) &&
+	      (mItv1->lftI <= iWSp.rgtpos))
+	{
+	  ++mItvIdx1;
+	  ++mItv1;
+	}
+	mItv2 = mItv1 - 1;
+	mItv1 = mItv0;
+	dPos.vtY = mItv0->line;
+	/* For each mesh interval which intersects the current grey
+	   interval. */
+	while(mItv1 <= mItv2)
+	{
 #ifdef WLZ_CMESHTRANSFORM_DEBUG
-      (void )fprintf(stderr,
-      		     "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
-		     mItv1->elmIdx,
-		     mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
+  (void )fprintf(stderr,
+		 "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
+		 mItv1->elmIdx,
+		 mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
 #endif
-	      /* Update mesh scanning. */
-	      sE = mSWSp->dElm + mItv1->elmIdx;
-	      if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
+	  /* Use the precomputed mesh element transform. */
+	  sE = mSWSp->dElm + mItv1->elmIdx;
+	  tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
+		   sE->tr[ 3];
+	  tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
+		   sE->tr[ 7];
+	  tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
+		   sE->tr[11];
+	  /* Find length of intersection and set the grey pointer. */
+	  iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
+	  iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
+	  dPos.vtX = iLft;
+	  switch(interp)
+	  {
+	    case WLZ_INTERPOLATION_NEAREST:
+	      switch(gType)
 	      {
-	         WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+		case WLZ_GREY_INT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_SHORT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_UBYTE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_FLOAT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_RGBA:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
+					     gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + bufWidth + idI) +=
+			  WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + (2 * bufWidth) + idI) +=
+			  WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + (3 * bufWidth) + idI) +=
+			  WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		default:
+		  errNum = WLZ_ERR_GREY_TYPE;
+		  break;
 	      }
-	      tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
-		       sE->tr[ 3];
-	      tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
-		       sE->tr[ 7];
-	      tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
-		       sE->tr[11];
-	      /* Find length of intersection and set the grey pointer. */
-	      iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
-	      iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
-	      dPos.vtX = iLft;
-	      switch(interp)
+	      break;
+	    case WLZ_INTERPOLATION_LINEAR:
+	      switch(gType)
 	      {
-		case WLZ_INTERPOLATION_NEAREST:
-		  switch(gType)
+		case WLZ_GREY_INT:
+		  while(dPos.vtX <= iRgt)
 		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).inv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).inv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).inv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
-						 gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + bufWidth + idI) +=
-			      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
 		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    }
+		    ++dPos.vtX;
 		  }
 		  break;
-		case WLZ_INTERPOLATION_LINEAR:
-		  switch(gType)
+		case WLZ_GREY_SHORT:
+		  while(dPos.vtX <= iRgt)
 		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
-				((gVWSp->gVal[1]).inv * tD0 * tD3) +
-				((gVWSp->gVal[2]).inv * tD2 * tD1) +
-				((gVWSp->gVal[3]).inv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).shv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).shv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).shv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
-				((gVWSp->gVal[1]).shv * tD0 * tD3) +
-				((gVWSp->gVal[2]).shv * tD2 * tD1) +
-				((gVWSp->gVal[3]).shv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
 		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_UBYTE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).ubv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).ubv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).ubv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
-				((gVWSp->gVal[1]).ubv * tD0 * tD3) +
-				((gVWSp->gVal[2]).ubv * tD2 * tD1) +
-				((gVWSp->gVal[3]).ubv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
 		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_FLOAT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).flv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).flv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).flv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += tD0;
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
-				((gVWSp->gVal[1]).flv * tD0 * tD3) +
-				((gVWSp->gVal[2]).flv * tD2 * tD1) +
-				((gVWSp->gVal[3]).flv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
 		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).dbv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).dbv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).dbv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += tD0;
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
-				((gVWSp->gVal[1]).dbv * tD0 * tD3) +
-				((gVWSp->gVal[2]).dbv * tD2 * tD1) +
-				((gVWSp->gVal[3]).dbv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
 		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_RGBA:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + (2 * bufWidth) + idI) +=
+			  WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + (3 * bufWidth) + idI) +=
+			  WLZ_NINT(tD4);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) +=
-				      WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + bufWidth + idI) +=
-				      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (2 * bufWidth) + idI) +=
-				      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (3 * bufWidth) + idI) +=
-				      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) +=
+				  WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + bufWidth + idI) +=
+				  WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (2 * bufWidth) + idI) +=
+				  WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (3 * bufWidth) + idI) +=
+				  WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
 		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    }
+		    ++dPos.vtX;
 		  }
 		  break;
-		case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
-		  errNum = WLZ_ERR_UNIMPLEMENTED;
-		  break;
 		default:
-		  errNum = WLZ_ERR_INTERPOLATION_TYPE;
+		  errNum = WLZ_ERR_GREY_TYPE;
 		  break;
 	      }
-	      ++mItv1;
-	    }
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
-					     bgdV, iWSp.lftpos, iWSp.rgtpos,
-					     interp, gType);
+	      break;
+	    case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
+	      errNum = WLZ_ERR_UNIMPLEMENTED;
+	      break;
+	    default:
+	      errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	      break;
 	  }
-        }
-	if(errNum == WLZ_ERR_EOO)
-	{
-	  errNum = WLZ_ERR_NONE;
+	  ++mItv1;
 	}
       }
-      ++idP;
-      ++dPos.vtZ;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
+					 bgdV, iWSp.lftpos, iWSp.rgtpos,
+					 interp, gType);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
     }
   }
   (void )WlzFreeObj(obj2);
@@ -82,6 +82,67 @@ typedef enum _WlzContourBndSamMethod
   WLZ_CONTOUR_BNDPTS_RANDOM
 } WlzContourBndSamMethod;
 
+/*!
+* \struct	_WlzContourIsoPrm3D
+* \ingroup	WlzContour
+* \brief	Parameters shared by all slabs of a parallel iso-surface
+*		extraction, see WlzContourIsoIdxMesh3D().
+*		Typedef: ::WlzContourIsoPrm3D.
+*/
+typedef struct _WlzContourIsoPrm3D
+{
+  WlzObject	*obj;			/*!< Given 3D domain object. */
+  double	isoVal;			/*!< Iso-value. */
+  WlzIBox3	bBox;			/*!< Bounding box of the object. */
+  WlzIVertex2	bufSz;			/*!< Plane buffer size. */
+  WlzDVertex3	vxSz;			/*!< Voxel size. */
+  WlzLong	lnStp;			/*!< Grid vertex index step between
+  					     lines. */
+  WlzLong	pnStp;			/*!< Grid vertex index step between
+  					     planes. */
+  WlzLong	ekOff[8][8];		/*!< Edge key offsets for pairs of
+  					     cube vertices, relative to the
+					     key of the cube origin. */
+  int		ekLo[8][8];		/*!< The cube vertex of each pair
+  					     which has the lowest grid
+					     vertex index. */
+} WlzContourIsoPrm3D;
+
+/*!
+* \struct	_WlzContourIsoSlab3D
+* \ingroup	WlzContour
+* \brief	An indexed triangle buffer for the iso-surface of a slab
+*		of planes. Each vertex is keyed by the voxel grid edge
+*		(or grid vertex) on which it lies so that vertices are
+*		welded within the slab and to those of the previous slab.
+*		Typedef: ::WlzContourIsoSlab3D.
+*/
+typedef struct _WlzContourIsoSlab3D
+{
+  int		pn0;			/*!< First plane of the slab, relative
+  					     to the first plane of the
+					     object. */
+  int		pn1;			/*!< Last plane of the slab. */
+  int		nVtx;			/*!< Number of vertices. */
+  int		maxVtx;			/*!< Space allocated for vertices. */
+  int		nTri;			/*!< Number of triangles. */
+  int		maxTri;			/*!< Space allocated for triangles. */
+  int		htMsk;			/*!< Hash table size - 1, the table
+  					     size is always a power of two. */
+  int		*ht;			/*!< Open addressing hash table of
+  					     vertex indices, -1 if empty. */
+  WlzLong	*key;			/*!< Vertex edge keys. */
+  double	*vtx;			/*!< Vertex positions. */
+  int		*tri;			/*!< Triangle vertex indices. */
+  int		*map;			/*!< Slab to mesh vertex index map. */
+  int		vtxBase;		/*!< Mesh index of the first vertex
+  					     which is not welded to a vertex
+					     of the previous slab. */
+  int		triBase;		/*!< Mesh index of the slab's first
+  					     triangle. */
+  WlzErrorNum	errNum;			/*!< Error code for the slab. */
+} WlzContourIsoSlab3D;
+
 static WlzContour	*WlzContourIsoObj2D(
 			  WlzObject *srcObj,
 			  double isoVal,
@@ -223,6 +284,26 @@ static WlzErrorNum	WlzContourIsoTet3D(
 			  double *tVal,
 			  WlzDVertex3 *tPos,
 			  WlzDVertex3 cbOrg);
+static WlzErrorNum	WlzContourIsoSlabMesh3D(
+			  WlzContourIsoPrm3D *prm,
+			  WlzContourIsoSlab3D *slb);
+static int		WlzContourIsoSlabVtx(
+			  WlzContourIsoSlab3D *slb,
+			  WlzLong key,
+			  WlzDVertex3 pos);
+static int		WlzContourIsoSlabHash(
+			  WlzLong key,
+			  int msk);
+static int		WlzContourIsoSlabFind(
+			  WlzContourIsoSlab3D *slb,
+			  WlzLong key);
+static WlzErrorNum	WlzContourIsoSlabTri(
+			  WlzContourIsoSlab3D *slb,
+			  int i0,
+			  int i1,
+			  int i2);
+static void		WlzContourIsoSlabFree(
+			  WlzContourIsoSlab3D *slb);
 static WlzErrorNum	WlzContourGrdLink2D(
 			  WlzContour *ctr,
 			  WlzUByte **grdDBuf,
@@ -1253,6 +1334,785 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   return(ctr);
 }
 
+/*!
+* \return	New indexed triangle mesh or NULL on error.
+* \ingroup	WlzContour
+* \brief	Creates an iso-value surface from a 3D domain object's
+*		values as a compact indexed triangle mesh.
+*		The cubes of voxels are decomposed into tetrahedra just
+*		as for WlzContourObj() with WLZ_CONTOUR_MTD_ISO, but rather
+*		than building a geometric model the object is split into
+*		slabs of planes which are contoured in parallel, each into
+*		its own indexed triangle buffer. Vertices are keyed by the
+*		voxel grid edge (or grid vertex) on which they lie, which
+*		is used to weld the vertices within each slab and those
+*		on the plane shared by neighbouring slabs.
+*		The slab decomposition does not depend on the number of
+*		threads, so the mesh is always the same for a given object.
+*		The mesh vertex positions are scaled by the voxel size and
+*		a geometric model may be created from the mesh using
+*		WlzIdxMeshToGMModel().
+* \param	srcObj			Given 3D domain object with values.
+* \param	isoVal			Iso-value.
+* \param	dstErr			Destination error pointer, may
+*                                       be NULL.
+*/
+WlzIdxMesh	*WlzContourIsoIdxMesh3D(WlzObject *srcObj, double isoVal,
+					WlzErrorNum *dstErr)
+{
+  int		idS,
+  		nLyr = 0,
+  		nSlb = 0,
+		nVtx = 0,
+		nTri = 0;
+  WlzContourIsoPrm3D prm;
+  WlzContourIsoSlab3D *slb = NULL;
+  WlzIdxMesh	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	maxSlb = 64;
+  const WlzIVertex3 cOff[8] =	 /* Cube offsets, order is {vtX, vtY, vtZ} */
+  {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+    {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}
+  };
+
+  if(srcObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(srcObj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(srcObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(srcObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((srcObj->values.core == NULL) ||
+          (srcObj->values.vox->values == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(srcObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    prm.bBox = WlzBoundingBox3I(srcObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idA,
+    		idB;
+
+    prm.obj = srcObj;
+    prm.isoVal = isoVal;
+    prm.bufSz.vtX = prm.bBox.xMax - prm.bBox.xMin + 1;
+    prm.bufSz.vtY = prm.bBox.yMax - prm.bBox.yMin + 1;
+    prm.vxSz.vtX = srcObj->domain.p->voxel_size[0];
+    prm.vxSz.vtY = srcObj->domain.p->voxel_size[1];
+    prm.vxSz.vtZ = srcObj->domain.p->voxel_size[2];
+    prm.lnStp = prm.bufSz.vtX;
+    prm.pnStp = prm.lnStp * prm.bufSz.vtY;
+    /* Edges are keyed by the index of their lowest grid vertex and the
+     * direction to the other grid vertex, with the direction encoded
+     * in [0-26]. */
+    for(idA = 0; idA < 8; ++idA)
+    {
+      for(idB = 0; idB < 8; ++idB)
+      {
+        int	lo,
+		hi;
+	WlzLong	gA,
+		gB;
+
+	gA = (cOff[idA].vtZ * prm.pnStp) + (cOff[idA].vtY * prm.lnStp) +
+	     cOff[idA].vtX;
+	gB = (cOff[idB].vtZ * prm.pnStp) + (cOff[idB].vtY * prm.lnStp) +
+	     cOff[idB].vtX;
+        if(gA <= gB)
+	{
+	  lo = idA;
+	  hi = idB;
+	}
+	else
+	{
+	  lo = idB;
+	  hi = idA;
+	}
+	prm.ekLo[idA][idB] = lo;
+	prm.ekOff[idA][idB] = (WLZ_MIN(gA, gB) * 27) +
+			      ((cOff[hi].vtZ - cOff[lo].vtZ + 1) * 9) +
+			      ((cOff[hi].vtY - cOff[lo].vtY + 1) * 3) +
+			      (cOff[hi].vtX - cOff[lo].vtX + 1);
+      }
+    }
+    /* Partition the layers of cubes between planes into slabs. */
+    nLyr = srcObj->domain.p->lastpl - srcObj->domain.p->plane1;
+    nSlb = WLZ_MIN(nLyr, maxSlb);
+    if((nSlb > 0) &&
+       ((slb = (WlzContourIsoSlab3D *)
+	       AlcCalloc(nSlb, sizeof(WlzContourIsoSlab3D))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nSlb > 0))
+  {
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      slb[idS].pn0 = (idS * nLyr) / nSlb;
+      slb[idS].pn1 = ((idS + 1) * nLyr) / nSlb;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      slb[idS].errNum = WlzContourIsoSlabMesh3D(&prm, slb + idS);
+    }
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      if(slb[idS].errNum != WLZ_ERR_NONE)
+      {
+        errNum = slb[idS].errNum;
+	break;
+      }
+    }
+  }
+  /* Weld the vertices on the first plane of each slab to those of the
+   * previous slab, building a map from slab to mesh vertex indices. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      int	idV;
+      WlzContourIsoSlab3D *s;
+
+      s = slb + idS;
+      if((s->map = (int *)AlcMalloc(sizeof(int) *
+                                    WLZ_MAX(s->nVtx, 1))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+      s->vtxBase = nVtx;
+      s->triBase = nTri;
+      for(idV = 0; idV < s->nVtx; ++idV)
+      {
+	int	idW = -1;
+	WlzLong	key;
+
+	key = s->key[idV];
+	if((idS > 0) && (((key % 27) / 9) == 1) &&
+	   (((key / 27) / prm.pnStp) == s->pn0))
+	{
+	  idW = WlzContourIsoSlabFind(s - 1, key);
+	}
+	s->map[idV] = (idW >= 0)? (s - 1)->map[idW]: nVtx++;
+      }
+      nTri += s->nTri;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh = WlzMakeIdxMesh(WLZ_IDXMESH_TRI3D, nVtx, nTri, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh->nVtx = nVtx;
+    mesh->nElm = nTri;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      int	idV,
+      		idT;
+      WlzContourIsoSlab3D *s;
+
+      s = slb + idS;
+      for(idV = 0; idV < s->nVtx; ++idV)
+      {
+        int	idM;
+
+	if((idM = s->map[idV]) >= s->vtxBase)
+	{
+	  mesh->vtx[3 * idM + 0] = s->vtx[3 * idV + 0];
+	  mesh->vtx[3 * idM + 1] = s->vtx[3 * idV + 1];
+	  mesh->vtx[3 * idM + 2] = s->vtx[3 * idV + 2];
+	}
+      }
+      for(idT = 0; idT < 3 * s->nTri; ++idT)
+      {
+        mesh->elm[3 * s->triBase + idT] = s->map[s->tri[idT]];
+      }
+    }
+  }
+  if(slb)
+  {
+    for(idS = 0; idS < nSlb; ++idS)
+    {
+      WlzContourIsoSlabFree(slb + idS);
+    }
+    AlcFree(slb);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the iso-value surface between the planes of a
+*		single slab, see WlzContourIsoIdxMesh3D(). Each cube
+*		of values is split into the same six tetrahedra as in
+*		WlzContourIsoCube3D6T() and the intersections with the
+*		tetrahedra are those of WlzContourIsoTet3D(), but the
+*		triangles are added to the slab's indexed buffer.
+* \param	prm			Parameters common to all slabs.
+* \param	slb			The slab with it's first and last
+*					planes set.
+*/
+static WlzErrorNum WlzContourIsoSlabMesh3D(WlzContourIsoPrm3D *prm,
+					   WlzContourIsoSlab3D *slb)
+{
+  int		pnIdx;
+  int		empty[2] = {1, 1};
+  WlzObject	*obj2D = NULL;
+  WlzDomain	dummyDom;
+  WlzValues	dummyValues;
+  WlzIVertex2	bufOrg;
+  WlzPlaneDomain *pDom;
+  WlzUByte	**itvBuf[2] = {NULL, NULL};
+  double	**valBuf[2] = {NULL, NULL};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	tVxLUT[6][4] =  /* Tetrahedron to cube vertex look up table */
+  {
+    {0, 1, 3, 5}, {1, 2, 3, 5}, {2, 3, 5, 6},
+    {3, 5, 6, 7}, {3, 4, 5, 7}, {0, 3, 4, 5}
+  };
+  const WlzDVertex3 cPos[8] =	 /* Cube positions, order is {vtX, vtY, vtZ} */
+  {
+    {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 1.0, 0.0}, {0.0, 1.0, 0.0},
+    {0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {1.0, 1.0, 1.0}, {0.0, 1.0, 1.0}
+  };
+  const struct
+  {
+    int		cnt;
+    int		itm[4][2];
+  } tIsnLUT[81] = /* Tetrahedron intersections indexed by the tetrahedron
+  		   * vertex levels (as in WlzContourIsoTet3D()) in base 3.
+		   * Each intersection is a pair of tetrahedron vertices,
+		   * either a vertex (Vi) or a side (Sij). */
+  {
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0000 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0001 - */
+    {3, {{0, 1}, {0, 3}, {0, 2}, {0, 0}}}, /* 0002 S01S03S02 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0010 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0011 - */
+    {3, {{1, 1}, {0, 3}, {0, 2}, {0, 0}}}, /* 0012 V1S03S02 */
+    {3, {{0, 1}, {1, 2}, {1, 3}, {0, 0}}}, /* 0020 S01S12S13 */
+    {3, {{0, 0}, {1, 2}, {1, 3}, {0, 0}}}, /* 0021 V0S12S13 */
+    {4, {{0, 2}, {1, 2}, {1, 3}, {0, 3}}}, /* 0022 S02S12S13S03 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0100 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0101 - */
+    {3, {{2, 2}, {0, 1}, {0, 3}, {0, 0}}}, /* 0102 V2S01S03 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 0110 - */
+    {3, {{1, 1}, {0, 0}, {2, 2}, {0, 0}}}, /* 0111 V1V0V2 */
+    {3, {{2, 2}, {1, 1}, {0, 3}, {0, 0}}}, /* 0112 V2V1S03 */
+    {3, {{2, 2}, {1, 3}, {0, 1}, {0, 0}}}, /* 0120 V2S13S01 */
+    {3, {{0, 0}, {2, 2}, {1, 3}, {0, 0}}}, /* 0121 V0V2S13 */
+    {3, {{2, 2}, {1, 3}, {0, 3}, {0, 0}}}, /* 0122 V2S13S03 */
+    {3, {{0, 2}, {2, 3}, {1, 2}, {0, 0}}}, /* 0200 S02S23S12 */
+    {3, {{0, 0}, {2, 3}, {1, 2}, {0, 0}}}, /* 0201 V0S23S12 */
+    {4, {{0, 1}, {0, 3}, {2, 3}, {1, 2}}}, /* 0202 S01S03S23S12 */
+    {3, {{1, 1}, {0, 2}, {2, 3}, {0, 0}}}, /* 0210 V1S02S23 */
+    {3, {{1, 1}, {0, 0}, {2, 3}, {0, 0}}}, /* 0211 V1V0S23 */
+    {3, {{1, 1}, {0, 3}, {2, 3}, {0, 0}}}, /* 0212 V1S03S23 */
+    {4, {{0, 1}, {0, 2}, {2, 3}, {1, 3}}}, /* 0220 S01S02S23S13 */
+    {3, {{0, 0}, {2, 3}, {1, 3}, {0, 0}}}, /* 0221 V0S23S13 */
+    {3, {{0, 3}, {2, 3}, {1, 3}, {0, 0}}}, /* 0222 S03S23S13 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1000 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1001 - */
+    {3, {{3, 3}, {0, 2}, {0, 1}, {0, 0}}}, /* 1002 V3S02S01 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1010 - */
+    {3, {{0, 0}, {1, 1}, {3, 3}, {0, 0}}}, /* 1011 V0V1V3 */
+    {3, {{1, 1}, {3, 3}, {0, 2}, {0, 0}}}, /* 1012 V1V3S02 */
+    {3, {{3, 3}, {0, 1}, {1, 2}, {0, 0}}}, /* 1020 V3S01S12 */
+    {3, {{3, 3}, {0, 0}, {1, 2}, {0, 0}}}, /* 1021 V3V0S12 */
+    {3, {{3, 3}, {0, 2}, {1, 2}, {0, 0}}}, /* 1022 V3S02S12 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1100 - */
+    {3, {{0, 0}, {3, 3}, {2, 2}, {0, 0}}}, /* 1101 V0V3V2 */
+    {3, {{3, 3}, {2, 2}, {0, 1}, {0, 0}}}, /* 1102 V3V2S01 */
+    {3, {{1, 1}, {2, 2}, {3, 3}, {0, 0}}}, /* 1110 V1V2V3 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1111 - */
+    {3, {{2, 2}, {1, 1}, {3, 3}, {0, 0}}}, /* 1112 V2V1V3 */
+    {3, {{2, 2}, {3, 3}, {0, 1}, {0, 0}}}, /* 1120 V2V3S01 */
+    {3, {{0, 0}, {2, 2}, {3, 3}, {0, 0}}}, /* 1121 V0V2V3 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1122 - */
+    {3, {{3, 3}, {1, 2}, {0, 2}, {0, 0}}}, /* 1200 V3S12S02 */
+    {3, {{0, 0}, {3, 3}, {1, 2}, {0, 0}}}, /* 1201 V0V3S12 */
+    {3, {{3, 3}, {1, 2}, {0, 1}, {0, 0}}}, /* 1202 V3S12S01 */
+    {3, {{3, 3}, {1, 1}, {0, 2}, {0, 0}}}, /* 1210 V3V1S02 */
+    {3, {{0, 0}, {3, 3}, {1, 1}, {0, 0}}}, /* 1211 V0V3V1 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1212 - */
+    {3, {{3, 3}, {0, 1}, {0, 2}, {0, 0}}}, /* 1220 V3S01S02 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1221 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 1222 - */
+    {3, {{0, 3}, {1, 3}, {2, 3}, {0, 0}}}, /* 2000 S03S13S23 */
+    {3, {{0, 0}, {1, 3}, {2, 3}, {0, 0}}}, /* 2001 V0S13S23 */
+    {4, {{0, 1}, {1, 3}, {2, 3}, {0, 2}}}, /* 2002 S01S13S23S02 */
+    {3, {{1, 1}, {2, 3}, {0, 3}, {0, 0}}}, /* 2010 V1S23S03 */
+    {3, {{0, 0}, {1, 1}, {2, 3}, {0, 0}}}, /* 2011 V0V1S23 */
+    {3, {{1, 1}, {2, 3}, {0, 2}, {0, 0}}}, /* 2012 V1S23S02 */
+    {4, {{0, 1}, {1, 2}, {2, 3}, {0, 3}}}, /* 2020 S01S12S23S03 */
+    {3, {{0, 0}, {1, 2}, {2, 3}, {0, 0}}}, /* 2021 V0S12S23 */
+    {3, {{0, 2}, {1, 2}, {2, 3}, {0, 0}}}, /* 2022 S02S12S23 */
+    {3, {{2, 2}, {0, 3}, {1, 3}, {0, 0}}}, /* 2100 V2S03S13 */
+    {3, {{2, 2}, {0, 0}, {1, 3}, {0, 0}}}, /* 2101 V2V0S13 */
+    {3, {{2, 2}, {0, 1}, {1, 3}, {0, 0}}}, /* 2102 V2S01S13 */
+    {3, {{1, 1}, {2, 2}, {0, 3}, {0, 0}}}, /* 2110 V1V2S03 */
+    {3, {{0, 0}, {1, 1}, {2, 2}, {0, 0}}}, /* 2111 V0V1V2 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2112 - */
+    {3, {{2, 2}, {0, 3}, {0, 1}, {0, 0}}}, /* 2120 V2S03S01 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2121 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2122 - */
+    {4, {{0, 2}, {0, 3}, {1, 3}, {1, 2}}}, /* 2200 S02S03S13S12 */
+    {3, {{0, 0}, {1, 3}, {1, 2}, {0, 0}}}, /* 2201 V0S13S12 */
+    {3, {{0, 1}, {1, 3}, {1, 2}, {0, 0}}}, /* 2202 S01S13S12 */
+    {3, {{1, 1}, {0, 2}, {0, 3}, {0, 0}}}, /* 2210 V1S02S03 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2211 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2212 - */
+    {3, {{0, 1}, {0, 2}, {0, 3}, {0, 0}}}, /* 2220 S01S02S03 */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}, /* 2221 - */
+    {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}  /* 2222 - */
+  };
+
+  pDom = prm->obj->domain.p;
+  dummyDom.core = NULL;
+  dummyValues.core = NULL;
+  bufOrg.vtX = prm->bBox.xMin;
+  bufOrg.vtY = prm->bBox.yMin;
+  slb->htMsk = 1023;
+  if(((slb->ht = (int *)AlcMalloc(sizeof(int) *
+                                  (slb->htMsk + 1))) == NULL) ||
+     (AlcBit2Calloc(&(itvBuf[0]), prm->bufSz.vtY,
+                    prm->bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(itvBuf[1]), prm->bufSz.vtY,
+                    prm->bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[0]), prm->bufSz.vtY,
+                       prm->bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[1]), prm->bufSz.vtY,
+                       prm->bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    (void )memset(slb->ht, -1, sizeof(int) * (slb->htMsk + 1));
+    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
+                        NULL, NULL, &errNum);
+  }
+  /* Sweep down through the slab using a pair of plane buffers. */
+  for(pnIdx = slb->pn0; (errNum == WLZ_ERR_NONE) && (pnIdx <= slb->pn1);
+      ++pnIdx)
+  {
+    int		bufIdx0,
+    		bufIdx1;
+    WlzDomain	dom;
+
+    bufIdx0 = (pnIdx + 1) % 2;
+    bufIdx1 = pnIdx % 2;
+    dom = *(pDom->domains + pnIdx);
+    empty[bufIdx1] = (dom.core == NULL) ||
+                     (dom.core->type == WLZ_EMPTY_DOMAIN);
+    if(!empty[bufIdx1])
+    {
+      obj2D->domain = dom;
+      obj2D->values = *(prm->obj->values.vox->values + pnIdx);
+      errNum = WlzToArray2D((void ***)&(itvBuf[bufIdx1]), obj2D,
+			    prm->bufSz, bufOrg, 0, WLZ_GREY_BIT);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzToArray2D((void ***)&(valBuf[bufIdx1]), obj2D,
+			      prm->bufSz, bufOrg, 0, WLZ_GREY_DOUBLE);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (pnIdx > slb->pn0) &&
+       !empty[bufIdx0] && !empty[bufIdx1])
+    {
+      int	lnIdx;
+      WlzDVertex3 cbOrg;
+
+      cbOrg.vtZ = pDom->plane1 + pnIdx - 1;
+      for(lnIdx = 0; (errNum == WLZ_ERR_NONE) &&
+                     (lnIdx < prm->bufSz.vtY - 1); ++lnIdx)
+      {
+	int	klIdx,
+		lastKlIn,
+		thisKlIn;
+	WlzLong	lnKey;
+	WlzUByte *tUP0,
+		*tUP1,
+		*tUP2,
+		*tUP3;
+	double	*vPn0Ln0,
+		*vPn0Ln1,
+		*vPn1Ln0,
+		*vPn1Ln1;
+
+	cbOrg.vtY = prm->bBox.yMin + lnIdx;
+	lnKey = ((pnIdx - 1) * prm->pnStp) + (lnIdx * prm->lnStp);
+	tUP0 = *(itvBuf[bufIdx0] + lnIdx);
+	tUP1 = *(itvBuf[bufIdx0] + lnIdx + 1);
+	tUP2 = *(itvBuf[bufIdx1] + lnIdx);
+	tUP3 = *(itvBuf[bufIdx1] + lnIdx + 1);
+	vPn0Ln0 = *(valBuf[bufIdx0] + lnIdx);
+	vPn0Ln1 = *(valBuf[bufIdx0] + lnIdx + 1);
+	vPn1Ln0 = *(valBuf[bufIdx1] + lnIdx);
+	vPn1Ln1 = *(valBuf[bufIdx1] + lnIdx + 1);
+	lastKlIn = (WLZ_BIT_GET(tUP0, 0) != 0) &&
+		   (WLZ_BIT_GET(tUP1, 0) != 0) &&
+		   (WLZ_BIT_GET(tUP2, 0) != 0) &&
+		   (WLZ_BIT_GET(tUP3, 0) != 0);
+	for(klIdx = 0; (errNum == WLZ_ERR_NONE) &&
+	               (klIdx < prm->bufSz.vtX - 1); ++klIdx)
+	{
+	  /* Check if cube is within the 3D object's domain. */
+	  thisKlIn = (WLZ_BIT_GET(tUP0, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP1, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP2, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP3, klIdx + 1) != 0);
+	  if(lastKlIn && thisKlIn)
+	  {
+	    int	idC,
+		nPos = 0,
+		nNeg = 0;
+	    double cVal[8];
+	    int	cLev[8];
+
+	    /* Compute values relative to iso-surface. */
+	    cVal[0] = vPn0Ln0[klIdx] - prm->isoVal;
+	    cVal[1] = vPn0Ln0[klIdx + 1] - prm->isoVal;
+	    cVal[2] = vPn0Ln1[klIdx + 1] - prm->isoVal;
+	    cVal[3] = vPn0Ln1[klIdx] - prm->isoVal;
+	    cVal[4] = vPn1Ln0[klIdx] - prm->isoVal;
+	    cVal[5] = vPn1Ln0[klIdx + 1] - prm->isoVal;
+	    cVal[6] = vPn1Ln1[klIdx + 1] - prm->isoVal;
+	    cVal[7] = vPn1Ln1[klIdx] - prm->isoVal;
+	    for(idC = 0; idC < 8; ++idC)
+	    {
+	      nNeg += cVal[idC] < -(WLZ_CTR_TOLERANCE);
+	      nPos += cVal[idC] > WLZ_CTR_TOLERANCE;
+	      cLev[idC] = (cVal[idC] >= DBL_EPSILON) +
+	                  (cVal[idC] > -(DBL_EPSILON));
+	    }
+	    /* Test for an intersection between this cube and the
+	     * iso-surface. */
+	    if((nNeg < 8) && (nPos < 8))
+	    {
+	      int	tIdx;
+	      WlzLong	cbKey;
+
+	      cbKey = (lnKey + klIdx) * 27;
+	      cbOrg.vtX = prm->bBox.xMin + klIdx;
+	      for(tIdx = 0; (errNum == WLZ_ERR_NONE) && (tIdx < 6); ++tIdx)
+	      {
+		int	iCode,
+			isnCnt;
+		const int *tVx;
+
+		tVx = tVxLUT[tIdx];
+		iCode = (cLev[tVx[3]] * 27) + (cLev[tVx[2]] * 9) +
+		        (cLev[tVx[1]] * 3) + cLev[tVx[0]];
+		if((isnCnt = tIsnLUT[iCode].cnt) > 0)
+		{
+		  int	idI;
+		  int	idx[4];
+		  WlzDVertex3 tIsn[4];
+
+		  for(idI = 0; idI < isnCnt; ++idI)
+		  {
+		    int	cA,
+			cB;
+		    WlzDVertex3 pos;
+
+		    cA = tVx[tIsnLUT[iCode].itm[idI][0]];
+		    cB = tVx[tIsnLUT[iCode].itm[idI][1]];
+		    if(cA == cB)
+		    {
+		      tIsn[idI] = cPos[cA];
+		    }
+		    else
+		    {
+		      int	lo,
+				hi;
+
+		      /* Always interpolate from the lowest grid vertex so
+		       * that a shared edge gives the same position. */
+		      lo = prm->ekLo[cA][cB];
+		      hi = (lo == cA)? cB: cA;
+		      tIsn[idI] = WlzContourItpTetSide(cVal[lo], cVal[hi],
+		      				       cPos[lo], cPos[hi]);
+		    }
+		    pos.vtX = (tIsn[idI].vtX + cbOrg.vtX) * prm->vxSz.vtX;
+		    pos.vtY = (tIsn[idI].vtY + cbOrg.vtY) * prm->vxSz.vtY;
+		    pos.vtZ = (tIsn[idI].vtZ + cbOrg.vtZ) * prm->vxSz.vtZ;
+		    if((idx[idI] = WlzContourIsoSlabVtx(slb,
+		    			cbKey + prm->ekOff[cA][cB], pos)) < 0)
+		    {
+		      errNum = WLZ_ERR_MEM_ALLOC;
+		      break;
+		    }
+		  }
+		  if(errNum == WLZ_ERR_NONE)
+		  {
+		    if(isnCnt == 4)
+		    {
+		      double	tD0,
+				tD1;
+		      WlzDVertex3 tV0;
+
+		      /* Split quadrilaterals into triangles along the
+		       * shortest diagonal, as in WlzContourIsoTet3D(). */
+		      WLZ_VTX_3_SUB(tV0, tIsn[0], tIsn[2]);
+		      tD0 = WLZ_VTX_3_SQRLEN(tV0);
+		      WLZ_VTX_3_SUB(tV0, tIsn[1], tIsn[3]);
+		      tD1 = WLZ_VTX_3_SQRLEN(tV0);
+		      if(tD0 < tD1)
+		      {
+			if((errNum = WlzContourIsoSlabTri(slb, idx[0], idx[1],
+			                        idx[2])) == WLZ_ERR_NONE)
+			{
+			  errNum = WlzContourIsoSlabTri(slb, idx[0], idx[2],
+			  				idx[3]);
+			}
+		      }
+		      else
+		      {
+			if((errNum = WlzContourIsoSlabTri(slb, idx[0], idx[1],
+			                        idx[3])) == WLZ_ERR_NONE)
+			{
+			  errNum = WlzContourIsoSlabTri(slb, idx[1], idx[2],
+			  				idx[3]);
+			}
+		      }
+		    }
+		    else
+		    {
+		      errNum = WlzContourIsoSlabTri(slb, idx[0], idx[1],
+		      				    idx[2]);
+		    }
+		  }
+		}
+	      }
+	    }
+	  }
+	  lastKlIn = thisKlIn;
+	}
+      }
+    }
+  }
+  if(obj2D)
+  {
+    obj2D->domain = dummyDom;
+    obj2D->values = dummyValues;
+    (void )WlzFreeObj(obj2D);
+  }
+  for(pnIdx = 0; pnIdx < 2; ++pnIdx)
+  {
+    if(itvBuf[pnIdx])
+    {
+      Alc2Free((void **)itvBuf[pnIdx]);
+    }
+    if(valBuf[pnIdx])
+    {
+      Alc2Free((void **)valBuf[pnIdx]);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Hash table index.
+* \ingroup	WlzContour
+* \brief	Computes the initial hash table index for an edge key.
+* \param	key			Given edge key.
+* \param	msk			Hash table size - 1.
+*/
+static int	WlzContourIsoSlabHash(WlzLong key, int msk)
+{
+  unsigned int	h;
+
+  h = (unsigned int )(key ^ (key >> 29)) * 2654435761U;
+  return((int )((h ^ (h >> 15)) & msk));
+}
+
+/*!
+* \return	Index of the vertex with the given key, or -1 if not found.
+* \ingroup	WlzContour
+* \brief	Finds the vertex of a slab with the given edge key.
+* \param	slb			Given slab.
+* \param	key			Given edge key.
+*/
+static int	WlzContourIsoSlabFind(WlzContourIsoSlab3D *slb, WlzLong key)
+{
+  int		h,
+  		idx;
+
+  h = WlzContourIsoSlabHash(key, slb->htMsk);
+  while(((idx = slb->ht[h]) >= 0) && (slb->key[idx] != key))
+  {
+    h = (h + 1) & slb->htMsk;
+  }
+  return(idx);
+}
+
+/*!
+* \return	Index of the vertex or -1 on memory allocation failure.
+* \ingroup	WlzContour
+* \brief	Finds the vertex of a slab with the given edge key,
+* 		adding a new vertex with the given position if there
+* 		is no vertex with the key.
+* \param	slb			Given slab.
+* \param	key			Given edge key.
+* \param	pos			Position for a new vertex.
+*/
+static int	WlzContourIsoSlabVtx(WlzContourIsoSlab3D *slb, WlzLong key,
+				     WlzDVertex3 pos)
+{
+  int		h,
+  		idx;
+
+  h = WlzContourIsoSlabHash(key, slb->htMsk);
+  while(((idx = slb->ht[h]) >= 0) && (slb->key[idx] != key))
+  {
+    h = (h + 1) & slb->htMsk;
+  }
+  if((idx < 0) && (slb->nVtx >= slb->maxVtx))
+  {
+    int		max;
+    double	*vtx;
+    WlzLong	*keys;
+
+    max = WLZ_MAX(2 * slb->maxVtx, 1024);
+    if((keys = (WlzLong *)AlcRealloc(slb->key,
+    				     sizeof(WlzLong) * max)) != NULL)
+    {
+      slb->key = keys;
+      if((vtx = (double *)AlcRealloc(slb->vtx,
+    				     sizeof(double) * 3 * max)) != NULL)
+      {
+	slb->vtx = vtx;
+	slb->maxVtx = max;
+      }
+    }
+  }
+  if((idx < 0) && (slb->nVtx < slb->maxVtx))
+  {
+    idx = slb->nVtx++;
+    slb->key[idx] = key;
+    slb->vtx[3 * idx + 0] = pos.vtX;
+    slb->vtx[3 * idx + 1] = pos.vtY;
+    slb->vtx[3 * idx + 2] = pos.vtZ;
+    slb->ht[h] = idx;
+    /* Keep the hash table at most half full. */
+    if(2 * slb->nVtx > slb->htMsk)
+    {
+      int	msk;
+      int	*ht;
+
+      msk = (2 * (slb->htMsk + 1)) - 1;
+      if((ht = (int *)AlcMalloc(sizeof(int) * (msk + 1))) == NULL)
+      {
+        idx = -1;
+      }
+      else
+      {
+	int	idV;
+
+	(void )memset(ht, -1, sizeof(int) * (msk + 1));
+	for(idV = 0; idV < slb->nVtx; ++idV)
+	{
+	  h = WlzContourIsoSlabHash(slb->key[idV], msk);
+	  while(ht[h] >= 0)
+	  {
+	    h = (h + 1) & msk;
+	  }
+	  ht[h] = idV;
+	}
+	AlcFree(slb->ht);
+	slb->ht = ht;
+	slb->htMsk = msk;
+      }
+    }
+  }
+  return(idx);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzContour
+* \brief	Appends a triangle to a slab's indexed triangle buffer.
+* \param	slb			Given slab.
+* \param	i0			Index of the first vertex.
+* \param	i1			Index of the second vertex.
+* \param	i2			Index of the third vertex.
+*/
+static WlzErrorNum WlzContourIsoSlabTri(WlzContourIsoSlab3D *slb,
+					int i0, int i1, int i2)
+{
+  int		*t;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(slb->nTri >= slb->maxTri)
+  {
+    int		max;
+
+    max = WLZ_MAX(2 * slb->maxTri, 1024);
+    if((t = (int *)AlcRealloc(slb->tri, sizeof(int) * 3 * max)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      slb->tri = t;
+      slb->maxTri = max;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    t = slb->tri + 3 * slb->nTri++;
+    t[0] = i0;
+    t[1] = i1;
+    t[2] = i2;
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzContour
+* \brief	Frees the buffers of a slab, but not the slab itself.
+* \param	slb			Given slab.
+*/
+static void	WlzContourIsoSlabFree(WlzContourIsoSlab3D *slb)
+{
+  AlcFree(slb->ht);
+  AlcFree(slb->key);
+  AlcFree(slb->vtx);
+  AlcFree(slb->tri);
+  AlcFree(slb->map);
+}
+
 /*!
 * \return				Contour , or NULL on error.
 * \ingroup	WlzContour
@@ -114,6 +114,7 @@ WlzObject	*WlzCopyObject(WlzObject *inObj, WlzErrorNum *dstErr)
       case WLZ_CONTOUR:        /* FALLTHROUGH */
       case WLZ_CONV_HULL:      /* FALLTHROUGH */
       case WLZ_SPLINE:         /* FALLTHROUGH */
+      case WLZ_IDXMESH:        /* FALLTHROUGH */
       case WLZ_LUT:
 	dom = WlzCopyDomain(inObj->type, inObj->domain, &errNum);
 	if(inObj->values.core)
@@ -402,6 +403,9 @@ WlzDomain	 WlzCopyDomain(WlzObjectType inObjType, WlzDomain inDom,
       case WLZ_SPLINE:
 	outDom.bs = WlzBSplineCopy(inDom.bs, &errNum);
         break;
+      case WLZ_IDXMESH:
+	outDom.idm = WlzIdxMeshCopy(inDom.idm, &errNum);
+        break;
       case WLZ_3D_WARP_TRANS:   /* FALLTHROUGH */
       case WLZ_3D_POLYGON:      /* FALLTHROUGH */
       case WLZ_RECTANGLE:       /* FALLTHROUGH */
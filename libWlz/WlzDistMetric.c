@@ -403,12 +403,9 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
 		mDist,
   		sDist,
 		iDist;
-  int		*iWSp = NULL;
+  int		*nnIdx = NULL;
   double	*nnDist = NULL;
-  double	vxD2[2];
-  WlzVertexP	tVP;
-  AlcKDTNode    *tNode;
-  AlcKDTTree    *tTree = NULL;
+  AlcKDTFlatTree *tTree = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((vx0 == NULL) || (vx1 == NULL))
@@ -419,46 +416,39 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
   {
     errNum = WLZ_ERR_PARAM_DATA;
   }
-  else if((iWSp = (int *)AlcMalloc(n1 * sizeof(int))) == NULL)
+  else if(((nnIdx = (int *)AlcMalloc(n0 * sizeof(int))) == NULL) ||
+          ((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else
+  /* The vertices are contiguous doubles so they are used directly as the
+   * tree and query keys. The nearest neighbours are found in parallel
+   * but the distances are accumulated in order below. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    if(dstDistN)
+    if(((tTree = AlcKDTFlatNew(2, n1, (double *)vx1, 0, NULL)) == NULL) ||
+       (AlcKDTFlatGetKNNBatch(tTree, n0, (double *)vx0, 1, DBL_MAX,
+                              nnIdx, nnDist, NULL) != ALC_ER_NONE))
     {
-      if((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
+      errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
-  {
-    tVP.d2 = vx1;
-    tTree = WlzVerticesBuildTree(WLZ_VERTEX_D2, n1, tVP, iWSp, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
   {
     cCnt = 0;
     iDist = DBL_MAX;
     sDist = mDist = 0.0;
     for(id0 = 0; id0 < n0; ++id0)
     {
-      vxD2[0] = (vx0 + id0)->vtX;
-      vxD2[1] = (vx0 + id0)->vtY;
-      tNode = AlcKDTGetNN(tTree, vxD2, DBL_MAX, &cDist, NULL);
-      if(tNode)
+      if(nnIdx[id0] >= 0)
       {
+	cDist = nnDist[id0];
 	sDist += cDist;
 	if(cDist > mDist)
 	{
 	  mDist = cDist;
 	}
-	if(nnDist)
-	{
-	  *(nnDist + cCnt) = cDist;
-	}
+	*(nnDist + cCnt) = cDist;
 	if(cDist < iDist)
 	{
 	  iDist = cDist;
@@ -492,9 +482,9 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
       *dstDistI = iDist;
     }
   }
-  AlcFree(iWSp);
+  AlcFree(nnIdx);
   AlcFree(nnDist);
-  AlcKDTTreeFree(tTree);
+  AlcKDTFlatFree(tTree);
   return(errNum);
 }
 
@@ -536,12 +526,9 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
 		mDist,
   		sDist,
 		iDist;
-  int		*iWSp = NULL;
+  int		*nnIdx = NULL;
   double	*nnDist = NULL;
-  double	vxD3[3];
-  WlzVertexP	tVP;
-  AlcKDTNode    *tNode;
-  AlcKDTTree    *tTree = NULL;
+  AlcKDTFlatTree *tTree = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((vx0 == NULL) || (vx1 == NULL))
@@ -552,47 +539,39 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
   {
     errNum = WLZ_ERR_PARAM_DATA;
   }
-  else if((iWSp = (int *)AlcMalloc(n1 * sizeof(int))) == NULL)
+  else if(((nnIdx = (int *)AlcMalloc(n0 * sizeof(int))) == NULL) ||
+          ((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else
+  /* The vertices are contiguous doubles so they are used directly as the
+   * tree and query keys. The nearest neighbours are found in parallel
+   * but the distances are accumulated in order below. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    if(dstDistN)
+    if(((tTree = AlcKDTFlatNew(3, n1, (double *)vx1, 0, NULL)) == NULL) ||
+       (AlcKDTFlatGetKNNBatch(tTree, n0, (double *)vx0, 1, DBL_MAX,
+                              nnIdx, nnDist, NULL) != ALC_ER_NONE))
     {
-      if((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
+      errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
-  {
-    tVP.d3 = vx1;
-    tTree = WlzVerticesBuildTree(WLZ_VERTEX_D3, n1, tVP, iWSp, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
   {
     cCnt = 0;
     iDist = DBL_MAX;
     sDist = mDist = 0.0;
     for(id0 = 0; id0 < n0; ++id0)
     {
-      vxD3[0] = (vx0 + id0)->vtX;
-      vxD3[1] = (vx0 + id0)->vtY;
-      vxD3[2] = (vx0 + id0)->vtZ;
-      tNode = AlcKDTGetNN(tTree, vxD3, DBL_MAX, &cDist, NULL);
-      if(tNode)
+      if(nnIdx[id0] >= 0)
       {
+	cDist = nnDist[id0];
 	sDist += cDist;
 	if(cDist > mDist)
 	{
 	  mDist = cDist;
 	}
-	if(nnDist)
-	{
-	  *(nnDist + cCnt) = cDist;
-	}
+	*(nnDist + cCnt) = cDist;
 	if(cDist < iDist)
 	{
 	  iDist = cDist;
@@ -626,9 +605,9 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
       *dstDistI = iDist;
     }
   }
-  AlcFree(iWSp);
+  AlcFree(nnIdx);
   AlcFree(nnDist);
-  AlcKDTTreeFree(tTree);
+  AlcKDTFlatFree(tTree);
   return(errNum);
 }
 
@@ -43,18 +43,86 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <float.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_DISTTRANSFORM_EDT_INF
+* \ingroup	WlzMorphologyOps
+* \brief	Value used for infinite squared distance within the
+* 		lower envelope computation of the exact Euclidean
+* 		distance transform.
+*/
+#define WLZ_DISTTRANSFORM_EDT_INF	(1.0e20)
+
+/*!
+* \def		WLZ_DISTTRANSFORM_EDT_SQRT_INT_MAX
+* \ingroup	WlzMorphologyOps
+* \brief	Largest distance which can be squared without integer
+* 		overflow.
+*/
+#define WLZ_DISTTRANSFORM_EDT_SQRT_INT_MAX (46340)
+
+/*!
+* \def		WLZ_DISTTRANSFORM_EDT_BAND_SZ
+* \ingroup	WlzMorphologyOps
+* \brief	Target number of voxels in the squared distance buffer
+* 		when a 3D exact Euclidean distance transform with a
+* 		maximum distance is computed in bands of planes.
+*/
+#define WLZ_DISTTRANSFORM_EDT_BAND_SZ (1 << 26)
+
+static void			WlzDistTransformEDT1D(
+				  double *f,
+				  double *d,
+				  double *z,
+				  int *v,
+				  int n);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
 				  double scale,
     			          WlzErrorNum *dstErr);
+static WlzObject		*WlzDistTransformEDT(
+				  WlzObject *forObj,
+				  WlzObject *refObj,
+				  int dim,
+				  double dMax,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzDistTransformEDTBand(
+				  int *buf,
+				  WlzIBox3 bBox,
+				  WlzObject *refObj,
+				  int dim,
+				  int nThr,
+				  int maxLen,
+				  double *fBuf,
+				  int *vBuf);
+static WlzErrorNum		WlzDistTransformEDTSeedDom(
+				  int *buf,
+				  WlzIBox3 bBox,
+				  WlzObject *obj);
+static WlzErrorNum		WlzDistTransformEDTSeedPts(
+				  int *buf,
+				  WlzIBox3 bBox,
+				  WlzPoints *pts);
+static WlzErrorNum		WlzDistTransformEDTSetValues(
+				  WlzObject *dstObj,
+				  int *buf,
+				  WlzIBox3 bBox,
+				  int pl0,
+				  int pl1,
+				  double dMax);
 
 /*!
 * \return	Distance object which shares the given foreground object's
-*		domain and has integer distance values, null on error.
+*		domain and has integer distance values, or float distance
+*		values for WLZ_EUCLIDEAN_DISTANCE, null on error.
 * \ingroup	WlzMorphologyOps
 * \brief	Computes the distance of every pixel/voxel in the foreground
 * 		object from the reference object.
@@ -62,7 +130,8 @@ static WlzObject 		*WlzDistSample(
 *		A distance transform maps all position within a  forground
 *		domain to their distances from a reference domain.
 *		The distance transforms implemented within this function
-*		use efficient morphological primitives.
+*		use efficient morphological primitives, with the
+*		exception of the exact Euclidean distance transform.
 *		
 *		Given two domains,
 *		\f$\Omega_r\f$ the reference domain and \f$\Omega_f\f$
@@ -90,6 +159,32 @@ static WlzObject 		*WlzDistSample(
 * 		reference domain using a sphere with a radius having the same
 * 		value as the scale parameter and then finaly sampling the
 * 		scaled distances.
+*
+*		An exact Euclidean distance transform may be computed
+*		using WLZ_EUCLIDEAN_DISTANCE. This does not use the
+*		morphological primitives, instead it uses the separable
+*		lower envelope algorithm of Felzenszwalb and Huttenlocher
+*		over the bounding box of the foreground and reference
+*		objects. Its cost is linear in the number of pixels/voxels
+*		in this bounding box and independent of the distances.
+*		The transform needs a buffer of one int per pixel/voxel
+*		in the bounding box. When a maximum distance is given the
+*		bounding box is clipped to the foreground's bounding box
+*		extended by the maximum distance and 3D objects are
+*		processed in bands of planes, so that the buffer is
+*		limited to about WLZ_DISTTRANSFORM_EDT_BAND_SZ voxels
+*		plus the planes within the maximum distance of each band.
+*		Without a maximum distance the buffer covers the whole
+*		bounding box, since every plane may then contribute to
+*		the distance of every other plane.
+*		Unlike the other distance functions the distances are
+*		not constrained to paths within the foreground domain
+*		and the returned object has float rather than integer
+*		values. If the foreground object has a tiled value table
+*		then the returned object will have tiled values too.
+*		See: P. F. Felzenszwalb and D. P. Huttenlocher. "Distance
+*		Transforms of Sampled Functions" Theory of Computing
+*		8:415-428, 2012.
 * \param	forObj			Foreground object.
 * \param	refObj			Reference object.
 * \param	dFn			Distance function which must be
@@ -214,6 +309,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -229,6 +325,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -272,16 +369,22 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
 	break;
     }
   }
+  /* The exact Euclidean distance transform doesn't use the morphological
+   * primitives so compute it directly. */
+  if((errNum == WLZ_ERR_NONE) && (dFn == WLZ_EUCLIDEAN_DISTANCE))
+  {
+    dstObj = WlzDistTransformEDT(forObj, refObj, dim, dMax, &errNum);
+    notDone = 0;
+  }
   /* Create scaled domains and a sphere domain for structual erosion if the
    * distance function is approximate Euclidean. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     if(dFn == WLZ_APX_EUCLIDEAN_DISTANCE)
     {
@@ -352,7 +455,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
     }
   }
   /* Create new values for the computed distances. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     dstGType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_INT, NULL);
     if(dim == 2)
@@ -366,12 +469,12 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
   }
   /* Create a distance object using the foreground object's domain and
    * the new distance values. */
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     dstObj = WlzMakeMain(sForObj->type, sForObj->domain, dstVal,
 			 NULL, NULL, &errNum);
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && notDone)
   {
     bothObj[0] = sForObj;
     errNum = WlzGreySetValue(dstObj, dstV);
@@ -575,3 +678,806 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \return	Distance object which shares the given foreground object's
+*		domain and has float distance values, null on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the exact Euclidean distance of every pixel/voxel
+* 		in the foreground object from the reference object.
+*
+* 		The squared distances are computed in a buffer which
+* 		covers the bounding box of both the foreground and
+* 		reference objects. When a maximum distance is given
+* 		this bounding box is clipped to the foreground object's
+* 		bounding box extended by the maximum distance, since
+* 		the distances are clamped to it and reference
+* 		pixels/voxels further away can not change them.
+* 		For 3D objects with a maximum distance the foreground's
+* 		planes are then processed in bands, with the buffer
+* 		covering each band and the planes within the maximum
+* 		distance of it. The number of planes in a band is chosen
+* 		so that the buffer has about WLZ_DISTTRANSFORM_EDT_BAND_SZ
+* 		voxels, but there is always at least one plane in a band.
+* 		Without a maximum distance the buffer must cover all the
+* 		planes of the bounding box.
+* \param	forObj			Foreground object.
+* \param	refObj			Reference object which must be
+* 					either a domain object or points
+* 					with the same dimension as the
+* 					foreground object.
+* \param	dim			Dimension, either 2 or 3.
+* \param	dMax			Maximum distance, distances greater
+* 					than this are clamped to it, <= 0
+* 					implies an infinite maximum distance.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzDistTransformEDT(WlzObject *forObj, WlzObject *refObj,
+				      int dim, double dMax,
+				      WlzErrorNum *dstErr)
+{
+  int		nThr = 1,
+		maxLen = 0,
+		halo = 0,
+		nBndPl = 1;
+  int		*buf = NULL,
+		*vBuf = NULL;
+  double	*fBuf = NULL;
+  WlzIVertex3	sz;
+  WlzIBox3	bBox,
+		fBox,
+		rBox;
+  WlzPixelV	bgdV;
+  WlzObject	*dstObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_FLOAT;
+  bgdV.v.flv = 0.0f;
+  /* Compute the bounding box of both the foreground and reference. */
+  fBox = WlzBoundingBox3I(forObj, &errNum);
+  bBox = fBox;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(refObj->type == WLZ_POINTS)
+    {
+      int	idP;
+      WlzPoints	*pts;
+      WlzIVertex3 p;
+
+      pts = refObj->domain.pts;
+      switch(pts->type)
+      {
+        case WLZ_POINTS_2I: /* FALLTHROUGH */
+        case WLZ_POINTS_2D:
+	  errNum = (dim == 2)? WLZ_ERR_NONE: WLZ_ERR_DOMAIN_TYPE;
+	  break;
+        case WLZ_POINTS_3I: /* FALLTHROUGH */
+        case WLZ_POINTS_3D:
+	  errNum = (dim == 3)? WLZ_ERR_NONE: WLZ_ERR_DOMAIN_TYPE;
+	  break;
+	default:
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	  break;
+      }
+      for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < pts->nPoints); ++idP)
+      {
+	p.vtZ = 0;
+	switch(pts->type)
+	{
+	  case WLZ_POINTS_2I:
+	    WLZ_VTX_2_COPY(p, pts->points.i2[idP]);
+	    break;
+	  case WLZ_POINTS_2D:
+	    p.vtX = WLZ_NINT(pts->points.d2[idP].vtX);
+	    p.vtY = WLZ_NINT(pts->points.d2[idP].vtY);
+	    break;
+	  case WLZ_POINTS_3I:
+	    p = pts->points.i3[idP];
+	    break;
+	  default: /* WLZ_POINTS_3D */
+	    p.vtX = WLZ_NINT(pts->points.d3[idP].vtX);
+	    p.vtY = WLZ_NINT(pts->points.d3[idP].vtY);
+	    p.vtZ = WLZ_NINT(pts->points.d3[idP].vtZ);
+	    break;
+	}
+	rBox.xMin = rBox.xMax = p.vtX;
+	rBox.yMin = rBox.yMax = p.vtY;
+	rBox.zMin = rBox.zMax = p.vtZ;
+	bBox = WlzBoundingBoxUnion3I(bBox, rBox);
+      }
+    }
+    else
+    {
+      rBox = WlzBoundingBox3I(refObj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	bBox = WlzBoundingBoxUnion3I(bBox, rBox);
+      }
+    }
+  }
+  /* Distances are clamped to the maximum distance, so clip the bounding
+   * box to the foreground's bounding box extended by it. Larger maximum
+   * distances would saturate the squared distances anyway. */
+  if((errNum == WLZ_ERR_NONE) &&
+     (dMax > DBL_EPSILON) && (dMax < WLZ_DISTTRANSFORM_EDT_SQRT_INT_MAX))
+  {
+    halo = (int )ceil(dMax);
+    bBox.xMin = ALG_MAX(bBox.xMin, fBox.xMin - halo);
+    bBox.yMin = ALG_MAX(bBox.yMin, fBox.yMin - halo);
+    bBox.xMax = ALG_MIN(bBox.xMax, fBox.xMax + halo);
+    bBox.yMax = ALG_MIN(bBox.yMax, fBox.yMax + halo);
+    if(dim == 3)
+    {
+      bBox.zMin = ALG_MAX(bBox.zMin, fBox.zMin - halo);
+      bBox.zMax = ALG_MIN(bBox.zMax, fBox.zMax + halo);
+    }
+  }
+  /* Choose the number of foreground planes in each band and allocate the
+   * squared distance buffer for the largest band. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	nPlnBuf;
+
+    sz.vtX = bBox.xMax - bBox.xMin + 1;
+    sz.vtY = bBox.yMax - bBox.yMin + 1;
+    sz.vtZ = bBox.zMax - bBox.zMin + 1;
+    nPlnBuf = (size_t )(sz.vtX) * sz.vtY;
+    nBndPl = fBox.zMax - fBox.zMin + 1;
+    if((dim == 3) && (halo > 0))
+    {
+      size_t	nBndMax;
+
+      nBndMax = WLZ_DISTTRANSFORM_EDT_BAND_SZ / nPlnBuf;
+      if(nBndMax < (size_t )nBndPl + 2 * halo)
+      {
+        nBndPl = (nBndMax > (size_t )(2 * halo + 1))?
+	         (int )nBndMax - 2 * halo: 1;
+      }
+      sz.vtZ = ALG_MIN(sz.vtZ, nBndPl + 2 * halo);
+    }
+    maxLen = ALG_MAX3(sz.vtX, sz.vtY, sz.vtZ);
+    if((buf = (int *)AlcMalloc(nPlnBuf * sz.vtZ * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Allocate per thread buffers for the lower envelope passes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+        nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if(((fBuf = (double *)
+                AlcMalloc(sizeof(double) * 3 * (maxLen + 1) * nThr)) == NULL) ||
+       ((vBuf = (int *)AlcMalloc(sizeof(int) * maxLen * nThr)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Create the distance object with new values. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValues	dstVal;
+    WlzObjectType dstGType;
+
+    dstVal.core = NULL;
+    if((forObj->values.core != NULL) &&
+       WlzGreyTableIsTiled(forObj->values.core->type))
+    {
+      dstObj = WlzMakeTiledValuesFromObj(forObj,
+                                         forObj->values.t->tileSz, 0,
+					 WLZ_GREY_FLOAT, 0, NULL, bgdV,
+					 &errNum);
+    }
+    else
+    {
+      dstGType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_FLOAT,
+				       NULL);
+      if(dim == 2)
+      {
+	dstVal.v = WlzNewValueTb(forObj, dstGType, bgdV, &errNum);
+      }
+      else
+      {
+	dstVal.vox = WlzNewValuesVox(forObj, dstGType, bgdV, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	dstObj = WlzMakeMain(forObj->type, forObj->domain, dstVal,
+			     NULL, NULL, &errNum);
+      }
+      if((dstObj == NULL) && (dstVal.core != NULL))
+      {
+	(void )WlzFreeValues(dstVal);
+      }
+    }
+  }
+  /* Compute the distances for each band of planes and set the values
+   * of the band's foreground planes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		pl0;
+
+    pl0 = fBox.zMin;
+    while((errNum == WLZ_ERR_NONE) && (pl0 <= fBox.zMax))
+    {
+      int	pl1;
+      WlzIBox3	tBox;
+
+      pl1 = ALG_MIN(pl0 + nBndPl - 1, fBox.zMax);
+      tBox = bBox;
+      if((dim == 3) && (halo > 0))
+      {
+	tBox.zMin = ALG_MAX(bBox.zMin, pl0 - halo);
+	tBox.zMax = ALG_MIN(bBox.zMax, pl1 + halo);
+      }
+      errNum = WlzDistTransformEDTBand(buf, tBox, refObj, dim, nThr, maxLen,
+				       fBuf, vBuf);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzDistTransformEDTSetValues(dstObj, buf, tBox, pl0, pl1,
+					      dMax);
+      }
+      pl0 = pl1 + 1;
+    }
+  }
+  AlcFree(fBuf);
+  AlcFree(vBuf);
+  AlcFree(buf);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(dstObj);
+    dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the squared Euclidean distances from the
+* 		reference object for all pixels/voxels of the given
+* 		squared distance buffer. Only reference pixels/voxels
+* 		within the buffer's bounding box are used.
+*
+* 		A two pass transform is first computed along each line,
+* 		this is followed by the lower envelope transform along
+* 		the columns and then (for 3D objects) through the planes.
+* 		Each of these passes is parallelised over the lines or
+* 		columns.
+* 		The squared distances are held as integers and saturate
+* 		at INT_MAX - 1, with INT_MAX used for pixels/voxels which
+* 		have no reference pixel/voxel in any line, column or plane
+* 		so far.
+* \param	buf			Squared distance buffer which must
+* 					have room for all pixels/voxels of
+* 					the bounding box.
+* \param	bBox			Bounding box of the buffer.
+* \param	refObj			Reference domain or points object.
+* \param	dim			Dimension, either 2 or 3.
+* \param	nThr			Number of threads.
+* \param	maxLen			Maximum of the buffer's width, height
+* 					and depth.
+* \param	fBuf			Per thread lower envelope work space
+* 					with room for 3 * (maxLen + 1) * nThr
+* 					doubles.
+* \param	vBuf			Per thread lower envelope work space
+* 					with room for maxLen * nThr ints.
+*/
+static WlzErrorNum WlzDistTransformEDTBand(int *buf, WlzIBox3 bBox,
+					   WlzObject *refObj, int dim,
+					   int nThr, int maxLen,
+					   double *fBuf, int *vBuf)
+{
+  size_t	idx,
+		nBuf;
+  double	*dBuf,
+		*zBuf;
+  WlzIVertex3	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dBuf = fBuf + (maxLen + 1) * nThr;
+  zBuf = dBuf + (maxLen + 1) * nThr;
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  sz.vtZ = bBox.zMax - bBox.zMin + 1;
+  /* Set all values infinite and then the reference pixels/voxels to zero
+   * distance. */
+  nBuf = (size_t )(sz.vtX) * sz.vtY * sz.vtZ;
+  for(idx = 0; idx < nBuf; ++idx)
+  {
+    buf[idx] = INT_MAX;
+  }
+  if(refObj->type == WLZ_POINTS)
+  {
+    errNum = WlzDistTransformEDTSeedPts(buf, bBox, refObj->domain.pts);
+  }
+  else
+  {
+    errNum = WlzDistTransformEDTSeedDom(buf, bBox, refObj);
+  }
+  /* First pass: squared distances along each line within the planes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idR,
+    		nR;
+
+    nR = sz.vtY * sz.vtZ;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+    for(idR = 0; idR < nR; ++idR)
+    {
+      int	idK,
+      		d;
+      int	*ln;
+
+      ln = buf + (size_t )idR * sz.vtX;
+      d = INT_MAX;
+      for(idK = 0; idK < sz.vtX; ++idK)
+      {
+	if(ln[idK] == 0)
+	{
+	  d = 0;
+	}
+	else if(d < INT_MAX)
+	{
+	  ++d;
+	}
+	ln[idK] = d;
+      }
+      d = INT_MAX;
+      for(idK = sz.vtX - 1; idK >= 0; --idK)
+      {
+	if(ln[idK] == 0)
+	{
+	  d = 0;
+	}
+	else if(d < INT_MAX)
+	{
+	  ++d;
+	}
+	if(d < ln[idK])
+	{
+	  ln[idK] = d;
+	}
+	if(ln[idK] < INT_MAX)
+	{
+	  /* Squared distances saturate rather than overflow. */
+	  ln[idK] = (ln[idK] < WLZ_DISTTRANSFORM_EDT_SQRT_INT_MAX)?
+	            ln[idK] * ln[idK]: INT_MAX - 1;
+	}
+      }
+    }
+  }
+  /* Second pass: lower envelope along the columns of each plane, then
+   * a third pass for 3D through the planes. Both passes are done on
+   * the same strided buffer, for the second pass the stride is the
+   * line width and for the third the plane area. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idP,
+    		nPass;
+
+    nPass = (dim == 2)? 1: 2;
+    for(idP = 0; idP < nPass; ++idP)
+    {
+      int	idC,
+		nC,
+		len;
+      size_t	stride;
+
+      if(idP == 0)
+      {
+	nC = sz.vtX * sz.vtZ;
+	len = sz.vtY;
+	stride = sz.vtX;
+      }
+      else
+      {
+	nC = sz.vtX * sz.vtY;
+	len = sz.vtZ;
+	stride = (size_t )(sz.vtX) * sz.vtY;
+      }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+      for(idC = 0; idC < nC; ++idC)
+      {
+	int	idI,
+		thrId = 0;
+	int	*col,
+		*v;
+	double	*f,
+		*d,
+		*z;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	f = fBuf + thrId * (maxLen + 1);
+	d = dBuf + thrId * (maxLen + 1);
+	z = zBuf + thrId * (maxLen + 1);
+	v = vBuf + thrId * maxLen;
+	if(idP == 0)
+	{
+	  /* Column idC % width of plane idC / width. */
+	  col = buf + ((size_t )(idC / sz.vtX) * sz.vtX * sz.vtY) +
+	        (idC % sz.vtX);
+	}
+	else
+	{
+	  col = buf + idC;
+	}
+	for(idI = 0; idI < len; ++idI)
+	{
+	  int	g;
+
+	  g = col[idI * stride];
+	  f[idI] = (g == INT_MAX)? WLZ_DISTTRANSFORM_EDT_INF: g;
+	}
+	WlzDistTransformEDT1D(f, d, z, v, len);
+	for(idI = 0; idI < len; ++idI)
+	{
+	  col[idI * stride] = (d[idI] >= WLZ_DISTTRANSFORM_EDT_INF)? INT_MAX:
+	                      (d[idI] < INT_MAX)? (int )(d[idI]): INT_MAX - 1;
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared distance transform
+* 		of the sampled function f using the lower envelope of
+* 		parabolas algorithm of Felzenszwalb and Huttenlocher.
+* \param	f			Given sampled function.
+* \param	d			Destination for the squared distances.
+* \param	z			Work space for the envelope boundaries,
+* 					must have room for n + 1 values.
+* \param	v			Work space for the envelope parabola
+* 					locations, must have room for n
+* 					values.
+* \param	n			Number of samples.
+*/
+static void	WlzDistTransformEDT1D(double *f, double *d, double *z,
+				      int *v, int n)
+{
+  int		k = 0,
+		q;
+  double	s;
+
+  v[0] = 0;
+  z[0] = -WLZ_DISTTRANSFORM_EDT_INF;
+  z[1] = WLZ_DISTTRANSFORM_EDT_INF;
+  for(q = 1; q < n; ++q)
+  {
+    do
+    {
+      s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+    } while((s <= z[k]) && (--k >= 0));
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = WLZ_DISTTRANSFORM_EDT_INF;
+  }
+  k = 0;
+  for(q = 0; q < n; ++q)
+  {
+    double	t;
+
+    while(z[k + 1] < q)
+    {
+      ++k;
+    }
+    t = q - v[k];
+    d[q] = (t * t) + f[v[k]];
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the squared distance buffer to zero for all
+* 		pixels/voxels within both the given domain object and
+* 		the bounding box of the buffer.
+* \param	buf			Squared distance buffer.
+* \param	bBox			Bounding box of the buffer.
+* \param	obj			Given 2D or 3D domain object.
+*/
+static WlzErrorNum WlzDistTransformEDTSeedDom(int *buf, WlzIBox3 bBox,
+					      WlzObject *obj)
+{
+  int		idP,
+		nP = 1,
+		pl0 = 0,
+		pl1 = 0;
+  WlzIVertex2	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  if(obj->type == WLZ_3D_DOMAINOBJ)
+  {
+    pl0 = obj->domain.p->plane1;
+    pl1 = ALG_MAX(pl0, bBox.zMin);
+    nP = ALG_MIN(obj->domain.p->lastpl, bBox.zMax) - pl1 + 1;
+  }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(idP = 0; idP < nP; ++idP)
+  {
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	*pBuf;
+      WlzDomain	dom2;
+      WlzValues	nulVal;
+      WlzObject	*obj2 = NULL;
+      WlzIntervalWSpace iWSp;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      nulVal.core = NULL;
+      if(obj->type == WLZ_3D_DOMAINOBJ)
+      {
+	dom2 = obj->domain.p->domains[pl1 - pl0 + idP];
+	pBuf = buf + (size_t )(pl1 + idP - bBox.zMin) * sz.vtX * sz.vtY;
+      }
+      else
+      {
+        dom2 = obj->domain;
+	pBuf = buf;
+      }
+      if(dom2.core != NULL)
+      {
+	obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, nulVal, NULL, NULL,
+			   &errNum2);
+      }
+      if(obj2 != NULL)
+      {
+        errNum2 = WlzInitRasterScan(obj2, &iWSp, WLZ_RASTERDIR_ILIC);
+	while((errNum2 == WLZ_ERR_NONE) &&
+	      ((errNum2 = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE))
+	{
+	  if((iWSp.linpos >= bBox.yMin) && (iWSp.linpos <= bBox.yMax))
+	  {
+	    int	idK,
+		  lft,
+		  rgt;
+	    int	*lBuf;
+
+	    lft = ALG_MAX(iWSp.lftpos, bBox.xMin);
+	    rgt = ALG_MIN(iWSp.rgtpos, bBox.xMax);
+	    lBuf = pBuf + (size_t )(iWSp.linpos - bBox.yMin) * sz.vtX -
+		   bBox.xMin;
+	    for(idK = lft; idK <= rgt; ++idK)
+	    {
+	      lBuf[idK] = 0;
+	    }
+	  }
+	}
+	if(errNum2 == WLZ_ERR_EOO)
+	{
+	  errNum2 = WLZ_ERR_NONE;
+	}
+	(void )WlzFreeObj(obj2);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistTransformEDT)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+#else
+	errNum = errNum2;
+#endif
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the squared distance buffer to zero for all
+* 		pixels/voxels nearest to the given points.
+* \param	buf			Squared distance buffer.
+* \param	bBox			Bounding box of the buffer, points
+* 					outside it are ignored.
+* \param	pts			Given points domain.
+*/
+static WlzErrorNum WlzDistTransformEDTSeedPts(int *buf, WlzIBox3 bBox,
+					      WlzPoints *pts)
+{
+  int		idP;
+  size_t	idx;
+  WlzIVertex3	p,
+		sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  for(idP = 0; idP < pts->nPoints; ++idP)
+  {
+    p.vtZ = 0;
+    switch(pts->type)
+    {
+      case WLZ_POINTS_2I:
+	WLZ_VTX_2_COPY(p, pts->points.i2[idP]);
+	break;
+      case WLZ_POINTS_2D:
+	p.vtX = WLZ_NINT(pts->points.d2[idP].vtX);
+	p.vtY = WLZ_NINT(pts->points.d2[idP].vtY);
+	break;
+      case WLZ_POINTS_3I:
+	p = pts->points.i3[idP];
+	break;
+      case WLZ_POINTS_3D:
+	p.vtX = WLZ_NINT(pts->points.d3[idP].vtX);
+	p.vtY = WLZ_NINT(pts->points.d3[idP].vtY);
+	p.vtZ = WLZ_NINT(pts->points.d3[idP].vtZ);
+	break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      break;
+    }
+    if((p.vtX >= bBox.xMin) && (p.vtX <= bBox.xMax) &&
+       (p.vtY >= bBox.yMin) && (p.vtY <= bBox.yMax) &&
+       (p.vtZ >= bBox.zMin) && (p.vtZ <= bBox.zMax))
+    {
+      idx = (((size_t )(p.vtZ - bBox.zMin) * sz.vtY) + p.vtY - bBox.yMin) *
+	    sz.vtX + p.vtX - bBox.xMin;
+      buf[idx] = 0;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the values of the given distance object from the
+* 		squared distance buffer, for 3D objects only the values
+* 		of the given range of planes are set.
+* \param	dstObj			Given distance object with float
+* 					values.
+* \param	buf			Squared distance buffer.
+* \param	bBox			Bounding box of the buffer which
+* 					must include the range of planes.
+* \param	pl0			First plane to set.
+* \param	pl1			Last plane to set.
+* \param	dMax			Maximum distance, <= 0 implies an
+* 					infinite maximum distance.
+*/
+static WlzErrorNum WlzDistTransformEDTSetValues(WlzObject *dstObj, int *buf,
+					        WlzIBox3 bBox,
+						int pl0, int pl1,
+						double dMax)
+{
+  int		idP,
+		nP = 1,
+		pOff = 0,
+		tiled;
+  WlzIVertex2	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  tiled = WlzGreyTableIsTiled(dstObj->values.core->type);
+  if(dstObj->type == WLZ_3D_DOMAINOBJ)
+  {
+    pl0 = ALG_MAX(pl0, dstObj->domain.p->plane1);
+    pl1 = ALG_MIN(pl1, dstObj->domain.p->lastpl);
+    pOff = pl0 - dstObj->domain.p->plane1;
+    nP = pl1 - pl0 + 1;
+  }
+  if(dMax < DBL_EPSILON)
+  {
+    dMax = FLT_MAX;
+  }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(idP = 0; idP < nP; ++idP)
+  {
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	*pBuf;
+      WlzDomain	dom2;
+      WlzValues	val2;
+      WlzObject	*obj2 = NULL;
+      WlzIntervalWSpace iWSp;
+      WlzGreyWSpace gWSp;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(dstObj->type == WLZ_3D_DOMAINOBJ)
+      {
+	dom2 = dstObj->domain.p->domains[pOff + idP];
+	val2 = (tiled)? dstObj->values:
+	                dstObj->values.vox->values[pOff + idP];
+	pBuf = buf + (size_t )(pl0 + idP - bBox.zMin) * sz.vtX * sz.vtY;
+      }
+      else
+      {
+        dom2 = dstObj->domain;
+	val2 = dstObj->values;
+	pBuf = buf;
+      }
+      if((dom2.core != NULL) && (val2.core != NULL))
+      {
+	obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, val2, NULL, NULL,
+			   &errNum2);
+      }
+      if(obj2 != NULL)
+      {
+        errNum2 = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  if(gWSp.tvb)
+	  {
+	    iWSp.plnpos = pl0 + idP;
+	  }
+	  while((errNum2 = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	  {
+	    int	idK;
+	    int	*lBuf;
+	    float *gP;
+
+	    gP = gWSp.u_grintptr.flp;
+	    lBuf = pBuf + (size_t )(iWSp.linpos - bBox.yMin) * sz.vtX -
+		   bBox.xMin;
+	    for(idK = iWSp.lftpos; idK <= iWSp.rgtpos; ++idK)
+	    {
+	      double d;
+
+	      d = (lBuf[idK] == INT_MAX)? dMax: sqrt((double )(lBuf[idK]));
+	      *gP++ = (float )((d < dMax)? d: dMax);
+	    }
+	  }
+	  if(errNum2 == WLZ_ERR_EOO)
+	  {
+	    errNum2 = WLZ_ERR_NONE;
+	  }
+	  (void )WlzEndGreyScan(&iWSp, &gWSp);
+	}
+	(void )WlzFreeObj(obj2);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistTransformEDT)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+#else
+	errNum = errNum2;
+#endif
+      }
+    }
+  }
+  return(errNum);
+}
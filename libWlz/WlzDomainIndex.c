@@ -0,0 +1,1537 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzDomainIndex_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzDomainIndex.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A spatial index over collections of 2D or 3D spatial
+* 		domains for many to many intersection, proximity and
+* 		overlap volume queries.
+*
+* 		The index (see ::WlzDomainIndex) is a uniform grid of
+* 		cells, each of which holds the indices of the domains
+* 		with bounding boxes which intersect it. A query visits
+* 		only the cells within the query domain's bounding box,
+* 		rejects candidates using the tight bounding boxes of
+* 		their planes and then tests the remaining candidates
+* 		directly from the intervals of the two domains, so no
+* 		intersection objects are ever built.
+*
+* 		Distances are Euclidean distances between pixel or voxel
+* 		positions: two domains are within distance \f$d\f$ if
+* 		there is a pixel/voxel in each which are no more than
+* 		\f$d\f$ apart, so with \f$d = 0\f$ they must intersect.
+* \ingroup	WlzBinaryOps
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <Wlz.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Maximum number of cells per non-empty domain in a domain index. */
+#define WLZ_DOMIDX_CELLS_PER_DOM	(4)
+/* Minimum number of cells allowed before the cell size is increased. */
+#define WLZ_DOMIDX_CELLS_MIN		(4096)
+
+/* Sets the cell index box C of the cells of index I which intersect the
+ * bounding box B, clipped to the index's cells. */
+#define WLZ_DOMIDX_CELLBOX(I,B,C) \
+{ \
+  (C).xMin = ALG_MAX(0, ((B).xMin - (I)->org.vtX) / (I)->cellSz); \
+  (C).yMin = ALG_MAX(0, ((B).yMin - (I)->org.vtY) / (I)->cellSz); \
+  (C).zMin = ALG_MAX(0, ((B).zMin - (I)->org.vtZ) / (I)->cellSz); \
+  (C).xMax = ALG_MIN((I)->nCells.vtX - 1, \
+		     ((B).xMax - (I)->org.vtX) / (I)->cellSz); \
+  (C).yMax = ALG_MIN((I)->nCells.vtY - 1, \
+		     ((B).yMax - (I)->org.vtY) / (I)->cellSz); \
+  (C).zMax = ALG_MIN((I)->nCells.vtZ - 1, \
+		     ((B).zMax - (I)->org.vtZ) / (I)->cellSz); \
+}
+
+static int			WlzDomIdxObjDim(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static int			WlzDomIdxSummary(
+				  WlzObject *obj,
+				  WlzIBox3 *dstBox,
+				  WlzIBox2 *plnBox,
+				  WlzLong *dstVol);
+static int			WlzDomIdxPlnNear(
+				  WlzIBox3 *box0,
+				  WlzIBox2 *pBox0,
+				  WlzIBox3 *box1,
+				  WlzIBox2 *pBox1,
+				  double dist);
+static int			WlzDomIdxNear(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  double dist);
+static WlzLong			WlzDomIdxVol(
+				  WlzObject *o0,
+				  WlzObject *o1);
+static int			WlzDomIdxPlaneRange(
+				  WlzObject *obj,
+				  int *dstP0,
+				  int *dstP1);
+static WlzIntervalDomain	*WlzDomIdxPlaneDom(
+				  WlzObject *obj,
+				  int p);
+static int			WlzDomIdxLineItv(
+				  WlzIntervalDomain *iDom,
+				  int l,
+				  WlzInterval *rItv,
+				  WlzInterval **dstItv);
+static int			WlzDomIdxLnIsct(
+				  int n0,
+				  WlzInterval *itv0,
+				  int k0,
+				  int n1,
+				  WlzInterval *itv1,
+				  int k1,
+				  int d);
+static WlzLong			WlzDomIdxLnVol(
+				  int n0,
+				  WlzInterval *itv0,
+				  int k0,
+				  int n1,
+				  WlzInterval *itv1,
+				  int k1);
+static WlzErrorNum		WlzDomIdxQuery(
+				  WlzDomainIndex *idx,
+				  WlzObject *qObj,
+				  double dist,
+				  int *dstNHit,
+				  int **dstHit,
+				  WlzLong **dstVol);
+
+/*!
+* \return	New domain index or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a spatial index over the domains of the given
+* 		objects. The objects must either all be 2D or all be
+* 		3D spatial domain objects, but any of them may be
+* 		empty objects or NULL, in which case they will never be
+* 		found by a query. The objects are assigned by the index
+* 		and so should not be modified while the index exists.
+* 		The index should be freed using WlzFreeDomainIndex().
+* \param	nObj			Number of objects.
+* \param	objs			Array of objects.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzDomainIndex			*WlzMakeDomainIndex(
+				  int nObj,
+				  WlzObject **objs,
+				  WlzErrorNum *dstErr)
+{
+  int		i,
+  		nPln = 0,
+		nNE = 0;
+  WlzIBox3	gBox;
+  WlzDomainIndex *idx = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nObj < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nObj > 0) && (objs == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((idx = (WlzDomainIndex *)
+                  AlcCalloc(1, sizeof(WlzDomainIndex))) == NULL) ||
+          ((idx->dom = (WlzObject **)
+	               AlcCalloc(nObj + 1, sizeof(WlzObject *))) == NULL) ||
+          ((idx->vol = (WlzLong *)
+	               AlcCalloc(nObj + 1, sizeof(WlzLong))) == NULL) ||
+          ((idx->box = (WlzIBox3 *)
+	               AlcCalloc(nObj + 1, sizeof(WlzIBox3))) == NULL) ||
+          ((idx->plnOff = (int *)
+	                  AlcCalloc(nObj + 1, sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Check the objects and find the offsets of their plane boxes. */
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nObj); ++i)
+  {
+    int		dim,
+		p0,
+		p1;
+
+    idx->plnOff[i] = nPln;
+    dim = WlzDomIdxObjDim(objs[i], &errNum);
+    if((errNum == WLZ_ERR_NONE) && (dim > 0))
+    {
+      if((idx->dim > 0) && (idx->dim != dim))
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+      else
+      {
+	idx->dim = dim;
+	(void )WlzDomIdxPlaneRange(objs[i], &p0, &p1);
+	if(p1 - p0 >= INT_MAX - nPln)
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+	else
+	{
+	  nPln += p1 - p0 + 1;
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((idx->plnBox = (WlzIBox2 *)
+                     AlcMalloc((nPln + 1) * sizeof(WlzIBox2))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Compute the domain summaries. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    idx->nDom = nObj;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(i = 0; i < nObj; ++i)
+    {
+      if((objs[i] != NULL) && (objs[i]->type != WLZ_EMPTY_OBJ) &&
+         WlzDomIdxSummary(objs[i], idx->box + i, idx->plnBox + idx->plnOff[i],
+	                  idx->vol + i))
+      {
+        int	p0,
+		p1;
+
+	(void )WlzDomIdxPlaneRange(objs[i], &p0, &p1);
+	idx->plnOff[i] += idx->box[i].zMin - p0;
+	idx->dom[i] = WlzAssignObject(objs[i], NULL);
+      }
+    }
+    for(i = 0; i < nObj; ++i)
+    {
+      if(idx->dom[i] != NULL)
+      {
+	WlzIBox3 *b;
+
+	b = idx->box + i;
+	if(nNE++ == 0)
+	{
+	  gBox = *b;
+	}
+	else
+	{
+	  gBox.xMin = ALG_MIN(gBox.xMin, b->xMin);
+	  gBox.yMin = ALG_MIN(gBox.yMin, b->yMin);
+	  gBox.zMin = ALG_MIN(gBox.zMin, b->zMin);
+	  gBox.xMax = ALG_MAX(gBox.xMax, b->xMax);
+	  gBox.yMax = ALG_MAX(gBox.yMax, b->yMax);
+	  gBox.zMax = ALG_MAX(gBox.zMax, b->zMax);
+	}
+      }
+    }
+  }
+  /* Choose the cell size, starting with the median domain extent and
+   * then increasing it until there are not too many cells. */
+  if((errNum == WLZ_ERR_NONE) && (nNE > 0))
+  {
+    int		*ext = NULL;
+    WlzLong	nC,
+    		maxC;
+
+    if((ext = (int *)AlcMalloc(nNE * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	j = 0;
+
+      for(i = 0; i < nObj; ++i)
+      {
+	if(idx->dom[i] != NULL)
+	{
+	  WlzIBox3 *b;
+
+	  b = idx->box + i;
+	  ext[j] = ALG_MAX(b->xMax - b->xMin, b->yMax - b->yMin);
+	  ext[j] = ALG_MAX(ext[j], b->zMax - b->zMin) + 1;
+	  ++j;
+	}
+      }
+      (void )AlgHeapSort(ext, nNE, sizeof(int), AlgHeapSortCmpIFn);
+      idx->cellSz = ext[nNE / 2];
+      AlcFree(ext);
+      maxC = ALG_MAX(WLZ_DOMIDX_CELLS_MIN, WLZ_DOMIDX_CELLS_PER_DOM * nNE);
+      do
+      {
+	idx->org.vtX = gBox.xMin;
+	idx->org.vtY = gBox.yMin;
+	idx->org.vtZ = gBox.zMin;
+	idx->nCells.vtX = (gBox.xMax - gBox.xMin) / idx->cellSz + 1;
+	idx->nCells.vtY = (gBox.yMax - gBox.yMin) / idx->cellSz + 1;
+	idx->nCells.vtZ = (gBox.zMax - gBox.zMin) / idx->cellSz + 1;
+	nC = (WlzLong )(idx->nCells.vtX) * idx->nCells.vtY * idx->nCells.vtZ;
+	if(nC > maxC)
+	{
+	  idx->cellSz *= 2;
+	}
+      } while(nC > maxC);
+    }
+  }
+  /* Fill the cells with the indices of the domains which have bounding
+   * boxes intersecting them. */
+  if((errNum == WLZ_ERR_NONE) && (nNE > 0))
+  {
+    int		nC;
+    WlzLong	nE = 0;
+    int		*cur = NULL;
+
+    nC = idx->nCells.vtX * idx->nCells.vtY * idx->nCells.vtZ;
+    if(((idx->cellOff = (int *)AlcCalloc(nC + 1, sizeof(int))) == NULL) ||
+       ((cur = (int *)AlcMalloc(nC * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nObj); ++i)
+    {
+      if(idx->dom[i] != NULL)
+      {
+	int	x,
+		y,
+		z;
+	WlzIBox3 c;
+
+	WLZ_DOMIDX_CELLBOX(idx, idx->box[i], c);
+	for(z = c.zMin; z <= c.zMax; ++z)
+	{
+	  for(y = c.yMin; y <= c.yMax; ++y)
+	  {
+	    for(x = c.xMin; x <= c.xMax; ++x)
+	    {
+	      ++(idx->cellOff[((z * idx->nCells.vtY) + y) *
+	                      idx->nCells.vtX + x + 1]);
+	    }
+	  }
+	}
+	nE += (WlzLong )(c.xMax - c.xMin + 1) * (c.yMax - c.yMin + 1) *
+	      (c.zMax - c.zMin + 1);
+	if(nE >= INT_MAX)
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(i = 0; i < nC; ++i)
+      {
+        idx->cellOff[i + 1] += idx->cellOff[i];
+	cur[i] = idx->cellOff[i];
+      }
+      if((idx->cellDom = (int *)AlcMalloc((nE + 1) * sizeof(int))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nObj); ++i)
+    {
+      if(idx->dom[i] != NULL)
+      {
+	int	x,
+		y,
+		z;
+	WlzIBox3 c;
+
+	WLZ_DOMIDX_CELLBOX(idx, idx->box[i], c);
+	for(z = c.zMin; z <= c.zMax; ++z)
+	{
+	  for(y = c.yMin; y <= c.yMax; ++y)
+	  {
+	    for(x = c.xMin; x <= c.xMax; ++x)
+	    {
+	      idx->cellDom[cur[((z * idx->nCells.vtY) + y) *
+	                       idx->nCells.vtX + x]++] = i;
+	    }
+	  }
+	}
+      }
+    }
+    AlcFree(cur);
+  }
+  if((errNum != WLZ_ERR_NONE) && (idx != NULL))
+  {
+    (void )WlzFreeDomainIndex(idx);
+    idx = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idx);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Frees a domain index created by WlzMakeDomainIndex().
+* \param	idx			Given domain index.
+*/
+WlzErrorNum			WlzFreeDomainIndex(
+				  WlzDomainIndex *idx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(idx == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    int		i;
+
+    if(idx->dom != NULL)
+    {
+      for(i = 0; i < idx->nDom; ++i)
+      {
+	(void )WlzFreeObj(idx->dom[i]);
+      }
+    }
+    AlcFree(idx->dom);
+    AlcFree(idx->vol);
+    AlcFree(idx->box);
+    AlcFree(idx->plnOff);
+    AlcFree(idx->plnBox);
+    AlcFree(idx->cellOff);
+    AlcFree(idx->cellDom);
+    AlcFree(idx);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Finds the domains of the index which are within the given
+* 		distance of the domain of the given query object and
+* 		optionally the volume (or area) of their intersection
+* 		with it. The indices of the domains found are returned
+* 		in increasing order. If no domains are found then the
+* 		number of domains found is zero and the arrays are NULL.
+* \param	idx			Given domain index.
+* \param	qObj			Given query object which must be of
+* 					the same dimension as the indexed
+* 					domains, or an empty object or
+* 					NULL in which case nothing is found.
+* \param	dist			Distance, must not be negative. Use
+* 					zero to find intersecting domains.
+* \param	dstNHit			Destination pointer for the number of
+* 					domains found, must not be NULL.
+* \param	dstHit			Destination pointer for an array of
+* 					the indices of the domains found,
+* 					must not be NULL. The array should be
+* 					freed using AlcFree().
+* \param	dstVol			Destination pointer for an array of
+* 					the intersection volumes of the
+* 					domains found, may be NULL. The array
+* 					should be freed using AlcFree().
+*/
+WlzErrorNum			WlzDomainIndexQuery(
+				  WlzDomainIndex *idx,
+				  WlzObject *qObj,
+				  double dist,
+				  int *dstNHit,
+				  int **dstHit,
+				  WlzLong **dstVol)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((idx == NULL) || (dstNHit == NULL) || (dstHit == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(dist < 0.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    errNum = WlzDomIdxQuery(idx, qObj, dist, dstNHit, dstHit, dstVol);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Queries the given domain index with each of the given
+* 		objects as in WlzDomainIndexQuery(). The queries are
+* 		made concurrently when OpenMP is available. The results
+* 		are returned in compressed row form: the indices of the
+* 		domains found for query object i are (*dstHit)[j] and
+* 		their intersection volumes (*dstVol)[j] with
+* 		(*dstOff)[i] \f$\leq\f$ j \f$<\f$ (*dstOff)[i + 1].
+* \param	idx			Given domain index.
+* \param	nObj			Number of query objects.
+* \param	objs			Array of query objects, any of which
+* 					may be empty or NULL.
+* \param	dist			Distance, must not be negative.
+* \param	dstOff			Destination pointer for an array of
+* 					nObj + 1 offsets, must not be NULL.
+* \param	dstHit			Destination pointer for an array of
+* 					the indices of the domains found,
+* 					must not be NULL.
+* \param	dstVol			Destination pointer for an array of
+* 					the intersection volumes of the
+* 					domains found, may be NULL.
+* 					All the returned arrays should be
+* 					freed using AlcFree().
+*/
+WlzErrorNum			WlzDomainIndexQueryAll(
+				  WlzDomainIndex *idx,
+				  int nObj,
+				  WlzObject **objs,
+				  double dist,
+				  int **dstOff,
+				  int **dstHit,
+				  WlzLong **dstVol)
+{
+  int		i;
+  int		*off = NULL,
+  		*hit = NULL,
+		*nHit = NULL;
+  int		**hits = NULL;
+  WlzLong	*vol = NULL;
+  WlzLong	**vols = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((idx == NULL) || (dstOff == NULL) || (dstHit == NULL) ||
+     ((nObj > 0) && (objs == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((nObj < 0) || (dist < 0.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((off = (int *)AlcCalloc(nObj + 1, sizeof(int))) == NULL) ||
+          ((nHit = (int *)AlcCalloc(nObj + 1, sizeof(int))) == NULL) ||
+          ((hits = (int **)AlcCalloc(nObj + 1, sizeof(int *))) == NULL) ||
+	  ((dstVol != NULL) &&
+	   ((vols = (WlzLong **)
+	            AlcCalloc(nObj + 1, sizeof(WlzLong *))) == NULL)))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(i = 0; i < nObj; ++i)
+    {
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum2 = WlzDomIdxQuery(idx, objs[i], dist, nHit + i, hits + i,
+	                         (vols == NULL)? NULL: vols + i);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzDomainIndexQueryAll)
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+#else
+	  errNum = errNum2;
+#endif
+	}
+      }
+    }
+  }
+  /* Gather the results of the queries into compressed rows. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(i = 0; i < nObj; ++i)
+    {
+      off[i + 1] = off[i] + nHit[i];
+    }
+    if(((hit = (int *)AlcMalloc((off[nObj] + 1) * sizeof(int))) == NULL) ||
+       ((vols != NULL) &&
+        ((vol = (WlzLong *)
+	        AlcMalloc((off[nObj] + 1) * sizeof(WlzLong))) == NULL)))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(i = 0; i < nObj; ++i)
+    {
+      if(nHit[i] > 0)
+      {
+	(void )memcpy(hit + off[i], hits[i], nHit[i] * sizeof(int));
+	if(vol != NULL)
+	{
+	  (void )memcpy(vol + off[i], vols[i], nHit[i] * sizeof(WlzLong));
+	}
+      }
+    }
+  }
+  for(i = 0; i < nObj; ++i)
+  {
+    if(hits != NULL)
+    {
+      AlcFree(hits[i]);
+    }
+    if(vols != NULL)
+    {
+      AlcFree(vols[i]);
+    }
+  }
+  AlcFree(hits);
+  AlcFree(vols);
+  AlcFree(nHit);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstOff = off;
+    *dstHit = hit;
+    if(dstVol != NULL)
+    {
+      *dstVol = vol;
+    }
+  }
+  else
+  {
+    AlcFree(off);
+    AlcFree(hit);
+    AlcFree(vol);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Area or volume of the intersection of the two domains.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the area (2D) or volume (3D) of the intersection
+* 		of the domains of the two given objects directly from
+* 		their intervals, ie without computing the intersection.
+* 		This is the same as WlzVolume(WlzIntersect2(obj0, obj1))
+* 		but without creating any objects.
+* \param	obj0			First given object.
+* \param	obj1			Second given object, which must be
+* 					of the same type as the first.
+* 					Either object may be an empty object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzLong				WlzDomainOverlapVolume(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr)
+{
+  int		dim0,
+  		dim1 = 0;
+  WlzLong	vol = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj0 == NULL) || (obj1 == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    dim0 = WlzDomIdxObjDim(obj0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dim1 = WlzDomIdxObjDim(obj1, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (dim0 > 0) && (dim1 > 0))
+    {
+      if(dim0 != dim1)
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+      else
+      {
+        vol = WlzDomIdxVol(obj0, obj1);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(vol);
+}
+
+/*!
+* \return	Non-zero if the domains are within the given distance.
+* \ingroup	WlzBinaryOps
+* \brief	Tests whether the domains of the two given objects are
+* 		within the given Euclidean distance of each other, ie
+* 		whether there is a pixel/voxel in each of the domains
+* 		which are no more than the given distance apart. The
+* 		test is made directly from the intervals of the domains
+* 		and returns as soon as such a pair is found.
+* \param	obj0			First given object.
+* \param	obj1			Second given object, which must be
+* 					of the same type as the first.
+* 					Either object may be an empty object.
+* \param	dist			Given distance, must not be negative.
+* 					With zero distance this is a test for
+* 					the domains intersecting.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+int				WlzDomainWithinDist(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  double dist,
+				  WlzErrorNum *dstErr)
+{
+  int		dim0,
+  		dim1 = 0,
+		near = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj0 == NULL) || (obj1 == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(dist < 0.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    dim0 = WlzDomIdxObjDim(obj0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dim1 = WlzDomIdxObjDim(obj1, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (dim0 > 0) && (dim1 > 0))
+    {
+      if(dim0 != dim1)
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+      else
+      {
+        near = WlzDomIdxNear(obj0, obj1, dist);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(near);
+}
+
+/*!
+* \return	Dimension of the object's domain (2 or 3) or zero for
+* 		NULL and empty objects.
+* \ingroup	WlzBinaryOps
+* \brief	Checks that the given object is a spatial domain object
+* 		with a domain which can be used by a domain index.
+* \param	obj			Given object, may be NULL.
+* \param	dstErr			Destination error pointer, must not
+* 					be NULL.
+*/
+static int			WlzDomIdxObjDim(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr)
+{
+  int		dim = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj != NULL)
+  {
+    switch(obj->type)
+    {
+      case WLZ_EMPTY_OBJ:
+	break;
+      case WLZ_2D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if((obj->domain.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+		(obj->domain.core->type != WLZ_INTERVALDOMAIN_RECT))
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else
+	{
+	  dim = 2;
+	}
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else
+	{
+	  dim = 3;
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  *dstErr = errNum;
+  return(dim);
+}
+
+/*!
+* \return	Non-zero if the domain is not empty.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the tight bounding box of the given object's
+* 		domain, the tight bounding box of each of its planes and
+* 		its area or volume.
+* \param	obj			Given 2D or 3D spatial domain object.
+* \param	dstBox			Destination pointer for the bounding
+* 					box.
+* \param	plnBox			Array for the plane bounding boxes
+* 					with an entry for every plane of the
+* 					object's plane domain (a single entry
+* 					for 2D objects).
+* \param	dstVol			Destination pointer for the area or
+* 					volume.
+*/
+static int			WlzDomIdxSummary(
+				  WlzObject *obj,
+				  WlzIBox3 *dstBox,
+				  WlzIBox2 *plnBox,
+				  WlzLong *dstVol)
+{
+  int		p,
+		p0,
+		p1,
+  		nonEmpty = 0;
+  WlzLong	vol = 0;
+
+  (void )WlzDomIdxPlaneRange(obj, &p0, &p1);
+  for(p = p0; p <= p1; ++p)
+  {
+    int		l;
+    WlzIBox2	*pBox;
+    WlzIntervalDomain *iDom;
+
+    pBox = plnBox + p - p0;
+    pBox->xMin = pBox->yMin = 1;
+    pBox->xMax = pBox->yMax = 0;
+    if((iDom = WlzDomIdxPlaneDom(obj, p)) != NULL)
+    {
+      for(l = iDom->line1; l <= iDom->lastln; ++l)
+      {
+	int	  i,
+		  n;
+	WlzInterval r,
+		  *itv;
+
+	if((n = WlzDomIdxLineItv(iDom, l, &r, &itv)) > 0)
+	{
+	  if(pBox->xMin > pBox->xMax)
+	  {
+	    pBox->yMin = l;
+	    pBox->xMin = itv[0].ileft + iDom->kol1;
+	    pBox->xMax = itv[n - 1].iright + iDom->kol1;
+	  }
+	  else
+	  {
+	    pBox->xMin = ALG_MIN(pBox->xMin, itv[0].ileft + iDom->kol1);
+	    pBox->xMax = ALG_MAX(pBox->xMax, itv[n - 1].iright + iDom->kol1);
+	  }
+	  pBox->yMax = l;
+	  for(i = 0; i < n; ++i)
+	  {
+	    vol += itv[i].iright - itv[i].ileft + 1;
+	  }
+	}
+      }
+    }
+    if(pBox->xMin <= pBox->xMax)
+    {
+      if(nonEmpty == 0)
+      {
+	nonEmpty = 1;
+	dstBox->xMin = pBox->xMin;
+	dstBox->yMin = pBox->yMin;
+	dstBox->xMax = pBox->xMax;
+	dstBox->yMax = pBox->yMax;
+	dstBox->zMin = p;
+      }
+      else
+      {
+	dstBox->xMin = ALG_MIN(dstBox->xMin, pBox->xMin);
+	dstBox->yMin = ALG_MIN(dstBox->yMin, pBox->yMin);
+	dstBox->xMax = ALG_MAX(dstBox->xMax, pBox->xMax);
+	dstBox->yMax = ALG_MAX(dstBox->yMax, pBox->yMax);
+      }
+      dstBox->zMax = p;
+    }
+  }
+  *dstVol = vol;
+  return(nonEmpty);
+}
+
+/*!
+* \return	Non-zero if the plane boxes may be within the distance.
+* \ingroup	WlzBinaryOps
+* \brief	Tests whether any pair of the plane bounding boxes of two
+* 		domains are within the given distance of each other.
+* \param	box0			Bounding box of the first domain.
+* \param	pBox0			Plane bounding boxes of the first
+* 					domain from box0->zMin to box0->zMax.
+* \param	box1			Bounding box of the second domain.
+* \param	pBox1			Plane bounding boxes of the second
+* 					domain from box1->zMin to box1->zMax.
+* \param	dist			Given distance.
+*/
+static int			WlzDomIdxPlnNear(
+				  WlzIBox3 *box0,
+				  WlzIBox2 *pBox0,
+				  WlzIBox3 *box1,
+				  WlzIBox2 *pBox1,
+				  double dist)
+{
+  int		p,
+  		d,
+		near = 0;
+  double	d2;
+
+  d = (int )floor(dist);
+  d2 = dist * dist;
+  for(p = box0->zMin; (near == 0) && (p <= box0->zMax); ++p)
+  {
+    int		q,
+    		q1;
+    WlzIBox2	*b0;
+
+    b0 = pBox0 + p - box0->zMin;
+    if(b0->xMin <= b0->xMax)
+    {
+      q = ALG_MAX(p - d, box1->zMin);
+      q1 = ALG_MIN(p + d, box1->zMax);
+      for(; (near == 0) && (q <= q1); ++q)
+      {
+	WlzIBox2  *b1;
+
+	b1 = pBox1 + q - box1->zMin;
+	if(b1->xMin <= b1->xMax)
+	{
+	  double  gX,
+		  gY,
+		  gZ;
+
+	  gX = ALG_MAX(0, ALG_MAX(b0->xMin - b1->xMax, b1->xMin - b0->xMax));
+	  gY = ALG_MAX(0, ALG_MAX(b0->yMin - b1->yMax, b1->yMin - b0->yMax));
+	  gZ = q - p;
+	  near = (gX * gX) + (gY * gY) + (gZ * gZ) <= d2;
+	}
+      }
+    }
+  }
+  return(near);
+}
+
+/*!
+* \return	Non-zero if the domains are within the given distance.
+* \ingroup	WlzBinaryOps
+* \brief	Tests whether the domains of the two given objects are
+* 		within the given distance of each other, by testing
+* 		whether each line of the first domain, dilated by the
+* 		Euclidean distance remaining after the offset to a
+* 		nearby line of the second domain, intersects that line.
+* \param	o0			First given object.
+* \param	o1			Second given object of the same type
+* 					as the first.
+* \param	dist			Given non-negative distance.
+*/
+static int			WlzDomIdxNear(
+				  WlzObject *o0,
+				  WlzObject *o1,
+				  double dist)
+{
+  int		p,
+  		d,
+		dP,
+		near = 0;
+  int		pL0[2],
+  		pL1[2];
+  double	d2;
+
+  d = (int )floor(dist);
+  d2 = dist * dist;
+  dP = (o0->type == WLZ_3D_DOMAINOBJ)? d: 0;
+  (void )WlzDomIdxPlaneRange(o0, &(pL0[0]), &(pL0[1]));
+  (void )WlzDomIdxPlaneRange(o1, &(pL1[0]), &(pL1[1]));
+  pL0[0] = ALG_MAX(pL0[0], pL1[0] - dP);
+  pL0[1] = ALG_MIN(pL0[1], pL1[1] + dP);
+  for(p = pL0[0]; (near == 0) && (p <= pL0[1]); ++p)
+  {
+    int		q,
+    		q1;
+    WlzIntervalDomain *iDom0;
+
+    if((iDom0 = WlzDomIdxPlaneDom(o0, p)) != NULL)
+    {
+      q = ALG_MAX(p - dP, pL1[0]);
+      q1 = ALG_MIN(p + dP, pL1[1]);
+      for(; (near == 0) && (q <= q1); ++q)
+      {
+        int	l,
+		dY;
+	int	lL[2];
+	double	r2;
+	WlzIntervalDomain *iDom1;
+
+	/* r2 is the square of the distance remaining within the plane. */
+	r2 = d2 - ((q - p) * (q - p));
+	dY = (int )floor(sqrt(r2));
+	if(((iDom1 = WlzDomIdxPlaneDom(o1, q)) == NULL) ||
+	   (iDom0->kol1 - dY > iDom1->lastkl) ||
+	   (iDom0->lastkl + dY < iDom1->kol1))
+	{
+	  continue;
+	}
+	lL[0] = ALG_MAX(iDom0->line1, iDom1->line1 - dY);
+	lL[1] = ALG_MIN(iDom0->lastln, iDom1->lastln + dY);
+	for(l = lL[0]; (near == 0) && (l <= lL[1]); ++l)
+	{
+	  int	  n0;
+	  WlzInterval r0,
+		  *itv0;
+
+	  if((n0 = WlzDomIdxLineItv(iDom0, l, &r0, &itv0)) > 0)
+	  {
+	    int	m,
+	    	m1;
+
+	    m = ALG_MAX(l - dY, iDom1->line1);
+	    m1 = ALG_MIN(l + dY, iDom1->lastln);
+	    for(; (near == 0) && (m <= m1); ++m)
+	    {
+	      int	  n1;
+	      WlzInterval r1,
+			  *itv1;
+
+	      if((n1 = WlzDomIdxLineItv(iDom1, m, &r1, &itv1)) > 0)
+	      {
+		int	w;
+
+		w = (int )floor(sqrt(r2 - ((m - l) * (m - l))));
+		near = WlzDomIdxLnIsct(n0, itv0, iDom0->kol1,
+				       n1, itv1, iDom1->kol1, w);
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(near);
+}
+
+/*!
+* \return	Area or volume of the intersection of the domains.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the area or volume of the intersection of the
+* 		domains of the two given objects from their intervals.
+* \param	o0			First given object.
+* \param	o1			Second given object of the same type
+* 					as the first.
+*/
+static WlzLong			WlzDomIdxVol(
+				  WlzObject *o0,
+				  WlzObject *o1)
+{
+  int		p;
+  int		pL0[2],
+  		pL1[2];
+  WlzLong	vol = 0;
+
+  (void )WlzDomIdxPlaneRange(o0, &(pL0[0]), &(pL0[1]));
+  (void )WlzDomIdxPlaneRange(o1, &(pL1[0]), &(pL1[1]));
+  pL0[0] = ALG_MAX(pL0[0], pL1[0]);
+  pL0[1] = ALG_MIN(pL0[1], pL1[1]);
+  for(p = pL0[0]; p <= pL0[1]; ++p)
+  {
+    int		l;
+    int		lL[2];
+    WlzIntervalDomain *iDom0,
+    		*iDom1;
+
+    if(((iDom0 = WlzDomIdxPlaneDom(o0, p)) != NULL) &&
+       ((iDom1 = WlzDomIdxPlaneDom(o1, p)) != NULL) &&
+       (iDom0->kol1 <= iDom1->lastkl) && (iDom1->kol1 <= iDom0->lastkl))
+    {
+      lL[0] = ALG_MAX(iDom0->line1, iDom1->line1);
+      lL[1] = ALG_MIN(iDom0->lastln, iDom1->lastln);
+      for(l = lL[0]; l <= lL[1]; ++l)
+      {
+	int	  n0,
+		  n1;
+	WlzInterval r0,
+		  r1,
+		  *itv0,
+		  *itv1;
+
+	if(((n0 = WlzDomIdxLineItv(iDom0, l, &r0, &itv0)) > 0) &&
+	   ((n1 = WlzDomIdxLineItv(iDom1, l, &r1, &itv1)) > 0))
+	{
+	  vol += WlzDomIdxLnVol(n0, itv0, iDom0->kol1, n1, itv1, iDom1->kol1);
+	}
+      }
+    }
+  }
+  return(vol);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Queries the given domain index as described for
+* 		WlzDomainIndexQuery(), but without checking the
+* 		parameters.
+* \param	idx			Given domain index.
+* \param	qObj			Given query object, may be NULL.
+* \param	dist			Non-negative distance.
+* \param	dstNHit			Destination pointer for the number of
+* 					domains found.
+* \param	dstHit			Destination pointer for the indices
+* 					of the domains found.
+* \param	dstVol			Destination pointer for the
+* 					intersection volumes, may be NULL.
+*/
+static WlzErrorNum		WlzDomIdxQuery(
+				  WlzDomainIndex *idx,
+				  WlzObject *qObj,
+				  double dist,
+				  int *dstNHit,
+				  int **dstHit,
+				  WlzLong **dstVol)
+{
+  int		dim,
+  		nHit = 0,
+		maxHit = 0,
+		nonEmpty = 0;
+  int		pL[2];
+  int		*hit = NULL;
+  WlzLong	qVol;
+  WlzLong	*vol = NULL;
+  WlzIBox3	qBox;
+  WlzIBox2	*qPlnBox = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dim = WlzDomIdxObjDim(qObj, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (dim > 0) && (idx->dim > 0))
+  {
+    if(dim != idx->dim)
+    {
+      errNum = WLZ_ERR_OBJECT_TYPE;
+    }
+    else
+    {
+      (void )WlzDomIdxPlaneRange(qObj, &(pL[0]), &(pL[1]));
+      if((qPlnBox = (WlzIBox2 *)
+                    AlcMalloc((pL[1] - pL[0] + 1) * sizeof(WlzIBox2))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	nonEmpty = WlzDomIdxSummary(qObj, &qBox, qPlnBox, &qVol);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && nonEmpty)
+  {
+    int		d,
+    		x,
+		y,
+		z;
+    double	d2;
+    WlzIBox3	eBox,
+    		cBox;
+    WlzIBox2	*qPB;
+
+    /* Only visit the cells within the query's bounding box expanded by
+     * the distance. */
+    d = (int )ceil(dist);
+    d2 = dist * dist;
+    qPB = qPlnBox + qBox.zMin - pL[0];
+    eBox.xMin = qBox.xMin - d;
+    eBox.yMin = qBox.yMin - d;
+    eBox.xMax = qBox.xMax + d;
+    eBox.yMax = qBox.yMax + d;
+    eBox.zMin = qBox.zMin - ((dim == 3)? d: 0);
+    eBox.zMax = qBox.zMax + ((dim == 3)? d: 0);
+    WLZ_DOMIDX_CELLBOX(idx, eBox, cBox);
+    for(z = cBox.zMin; (errNum == WLZ_ERR_NONE) && (z <= cBox.zMax); ++z)
+    {
+      for(y = cBox.yMin; (errNum == WLZ_ERR_NONE) && (y <= cBox.yMax); ++y)
+      {
+	for(x = cBox.xMin; (errNum == WLZ_ERR_NONE) && (x <= cBox.xMax); ++x)
+	{
+	  int	c,
+	  	k;
+
+	  c = ((z * idx->nCells.vtY) + y) * idx->nCells.vtX + x;
+	  for(k = idx->cellOff[c]; k < idx->cellOff[c + 1]; ++k)
+	  {
+	    int	      i;
+	    WlzIBox3  *b;
+	    WlzIVertex3 r;
+
+	    i = idx->cellDom[k];
+	    b = idx->box + i;
+	    /* Reject domains with boxes outside of the expanded box and
+	     * those which will be or have been found in another cell, ie
+	     * those for which the first corner of the intersection of
+	     * the boxes is not in this cell. */
+	    if((b->xMin > eBox.xMax) || (b->xMax < eBox.xMin) ||
+	       (b->yMin > eBox.yMax) || (b->yMax < eBox.yMin) ||
+	       (b->zMin > eBox.zMax) || (b->zMax < eBox.zMin))
+	    {
+	      continue;
+	    }
+	    r.vtX = (ALG_MAX(b->xMin, eBox.xMin) - idx->org.vtX) / idx->cellSz;
+	    r.vtY = (ALG_MAX(b->yMin, eBox.yMin) - idx->org.vtY) / idx->cellSz;
+	    r.vtZ = (ALG_MAX(b->zMin, eBox.zMin) - idx->org.vtZ) / idx->cellSz;
+	    if((r.vtX != x) || (r.vtY != y) || (r.vtZ != z))
+	    {
+	      continue;
+	    }
+	    /* Reject using the boxes and then the plane boxes before
+	     * testing the intervals. */
+	    {
+	      double	gX,
+	      		gY,
+			gZ;
+
+	      gX = ALG_MAX(0, ALG_MAX(b->xMin - qBox.xMax, qBox.xMin - b->xMax));
+	      gY = ALG_MAX(0, ALG_MAX(b->yMin - qBox.yMax, qBox.yMin - b->yMax));
+	      gZ = ALG_MAX(0, ALG_MAX(b->zMin - qBox.zMax, qBox.zMin - b->zMax));
+	      if((gX * gX) + (gY * gY) + (gZ * gZ) > d2)
+	      {
+	        continue;
+	      }
+	    }
+	    if(WlzDomIdxPlnNear(&qBox, qPB, b, idx->plnBox + idx->plnOff[i],
+	                        dist) &&
+	       WlzDomIdxNear(qObj, idx->dom[i], dist))
+	    {
+	      if(nHit >= maxHit)
+	      {
+	        maxHit = (maxHit < 64)? 64: 2 * maxHit;
+		if((hit = (int *)
+		          AlcRealloc(hit, maxHit * sizeof(int))) == NULL)
+		{
+		  errNum = WLZ_ERR_MEM_ALLOC;
+		  break;
+		}
+	      }
+	      hit[nHit++] = i;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nHit > 0))
+  {
+    (void )AlgHeapSort(hit, nHit, sizeof(int), AlgHeapSortCmpIFn);
+    if(dstVol != NULL)
+    {
+      if((vol = (WlzLong *)AlcMalloc(nHit * sizeof(WlzLong))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	int	j;
+
+        for(j = 0; j < nHit; ++j)
+	{
+	  vol[j] = WlzDomIdxVol(qObj, idx->dom[hit[j]]);
+	}
+      }
+    }
+  }
+  AlcFree(qPlnBox);
+  if((errNum != WLZ_ERR_NONE) || (nHit == 0))
+  {
+    nHit = 0;
+    AlcFree(hit);
+    AlcFree(vol);
+    hit = NULL;
+    vol = NULL;
+  }
+  *dstNHit = nHit;
+  *dstHit = hit;
+  if(dstVol != NULL)
+  {
+    *dstVol = vol;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Non-zero if the given object has a spatial domain which
+* 		can be accessed using WlzDomIdxPlaneDom().
+* \ingroup	WlzBinaryOps
+* \brief	Gets the range of planes of the given object, for 2D
+* 		objects this is the single plane zero.
+* \param	obj			Given object.
+* \param	dstP0			Destination pointer for the first
+* 					plane.
+* \param	dstP1			Destination pointer for the last
+* 					plane.
+*/
+static int			WlzDomIdxPlaneRange(
+				  WlzObject *obj,
+				  int *dstP0,
+				  int *dstP1)
+{
+  int		valid = 0;
+
+  if((obj != NULL) && (obj->domain.core != NULL))
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+        valid = 1;
+	*dstP0 = *dstP1 = 0;
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	valid = 1;
+	*dstP0 = obj->domain.p->plane1;
+	*dstP1 = obj->domain.p->lastpl;
+	break;
+      default:
+        break;
+    }
+  }
+  return(valid);
+}
+
+/*!
+* \return	Interval domain of the plane or NULL if the plane is
+* 		empty or outside the domain.
+* \ingroup	WlzBinaryOps
+* \brief	Gets the interval domain of the given plane of the given
+* 		object, for 2D objects the only plane is plane zero.
+* \param	obj			Given object.
+* \param	p			Plane coordinate.
+*/
+static WlzIntervalDomain	*WlzDomIdxPlaneDom(
+				  WlzObject *obj,
+				  int p)
+{
+  int		p0,
+  		p1;
+  WlzIntervalDomain *iDom = NULL;
+
+  if(WlzDomIdxPlaneRange(obj, &p0, &p1) && (p >= p0) && (p <= p1))
+  {
+    iDom = (obj->type == WLZ_2D_DOMAINOBJ)?
+           obj->domain.i: obj->domain.p->domains[p - p0].i;
+    if((iDom != NULL) &&
+       (iDom->type != WLZ_INTERVALDOMAIN_INTVL) &&
+       (iDom->type != WLZ_INTERVALDOMAIN_RECT))
+    {
+      iDom = NULL;
+    }
+  }
+  return(iDom);
+}
+
+/*!
+* \return	Number of intervals in the line.
+* \ingroup	WlzBinaryOps
+* \brief	Gets the intervals of the given line of an interval
+* 		domain. The intervals are relative to the first column
+* 		of the domain. For rectangular domains the single
+* 		interval is set in the given interval.
+* \param	iDom			Given interval domain, may be NULL.
+* \param	l			Line coordinate.
+* \param	rItv			Interval used for rectangular domains.
+* \param	dstItv			Destination pointer for the intervals,
+* 					only set if there are intervals.
+*/
+static int			WlzDomIdxLineItv(
+				  WlzIntervalDomain *iDom,
+				  int l,
+				  WlzInterval *rItv,
+				  WlzInterval **dstItv)
+{
+  int		n = 0;
+
+  if((iDom != NULL) && (l >= iDom->line1) && (l <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + l - iDom->line1;
+      if((n = iLn->nintvs) > 0)
+      {
+        *dstItv = iLn->intvs;
+      }
+    }
+    else
+    {
+      n = 1;
+      rItv->ileft = 0;
+      rItv->iright = iDom->lastkl - iDom->kol1;
+      *dstItv = rItv;
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	Non-zero if the lines intersect.
+* \ingroup	WlzBinaryOps
+* \brief	Tests whether the first line of intervals, with each
+* 		interval dilated by d, intersects the second.
+* \param	n0			Number of intervals in first line.
+* \param	itv0			Intervals of the first line.
+* \param	k0			Column origin of the first line.
+* \param	n1			Number of intervals in second line.
+* \param	itv1			Intervals of the second line.
+* \param	k1			Column origin of the second line.
+* \param	d			Dilation of the first line.
+*/
+static int			WlzDomIdxLnIsct(
+				  int n0,
+				  WlzInterval *itv0,
+				  int k0,
+				  int n1,
+				  WlzInterval *itv1,
+				  int k1,
+				  int d)
+{
+  int		i0 = 0,
+  		i1 = 0,
+		isct = 0;
+
+  if((itv0[0].ileft + k0 - d <= itv1[n1 - 1].iright + k1) &&
+     (itv1[0].ileft + k1 <= itv0[n0 - 1].iright + k0 + d))
+  {
+    k0 -= k1;
+    while((isct == 0) && (i0 < n0) && (i1 < n1))
+    {
+      if(itv0[i0].iright + k0 + d < itv1[i1].ileft)
+      {
+	++i0;
+      }
+      else if(itv1[i1].iright < itv0[i0].ileft + k0 - d)
+      {
+	++i1;
+      }
+      else
+      {
+	isct = 1;
+      }
+    }
+  }
+  return(isct);
+}
+
+/*!
+* \return	Number of columns common to both lines.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the number of columns in the intersection of the
+* 		two lines of intervals.
+* \param	n0			Number of intervals in first line.
+* \param	itv0			Intervals of the first line.
+* \param	k0			Column origin of the first line.
+* \param	n1			Number of intervals in second line.
+* \param	itv1			Intervals of the second line.
+* \param	k1			Column origin of the second line.
+*/
+static WlzLong			WlzDomIdxLnVol(
+				  int n0,
+				  WlzInterval *itv0,
+				  int k0,
+				  int n1,
+				  WlzInterval *itv1,
+				  int k1)
+{
+  int		i0 = 0,
+  		i1 = 0;
+  WlzLong	vol = 0;
+
+  k0 -= k1;
+  while((i0 < n0) && (i1 < n1))
+  {
+    int		lft,
+    		rgt;
+
+    lft = ALG_MAX(itv0[i0].ileft + k0, itv1[i1].ileft);
+    rgt = ALG_MIN(itv0[i0].iright + k0, itv1[i1].iright);
+    if(lft <= rgt)
+    {
+      vol += rgt - lft + 1;
+    }
+    if(itv0[i0].iright + k0 < itv1[i1].iright)
+    {
+      ++i0;
+    }
+    else
+    {
+      ++i1;
+    }
+  }
+  return(vol);
+}
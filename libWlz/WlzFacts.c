@@ -161,6 +161,9 @@ static WlzErrorNum 		WlzObjFactsLUTValues(
 static WlzErrorNum 		WlzObjFactsSplineDomain(
 				  WlzObjFactsData *fData,
 				  WlzObject *obj);
+static WlzErrorNum 		WlzObjFactsIdxMeshDomain(
+				  WlzObjFactsData *fData,
+				  WlzObject *obj);
 static WlzErrorNum 		WlzObjFactsPointsDomain(
 				  WlzObjFactsData *fData,
 				  WlzObject *obj);
@@ -504,6 +507,13 @@ static WlzErrorNum WlzObjFactsObject(WlzObjFactsData *fData, WlzObject *obj)
 	    errNum = WlzObjFactsPropList(fData, obj, obj->plist);
 	  }
 	  break;
+	case WLZ_IDXMESH:
+	  errNum = WlzObjFactsIdxMeshDomain(fData, obj);
+          if(errNum == WLZ_ERR_NONE)
+          {
+	    errNum = WlzObjFactsPropList(fData, obj, obj->plist);
+	  }
+	  break;
 	case WLZ_3D_WARP_TRANS:   /* FALLTHROUGH */
 	case WLZ_3D_POLYGON:      /* FALLTHROUGH */
 	case WLZ_RECTANGLE:       /* FALLTHROUGH */
@@ -2936,6 +2946,90 @@ static WlzErrorNum WlzObjFactsSplineDomain(WlzObjFactsData *fData,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzDebug
+* \brief	Produces a text description of an indexed mesh domain.
+* \param	fData			Facts data structure.
+* \param	obj			Object with an indexed mesh domain.
+*/
+static WlzErrorNum WlzObjFactsIdxMeshDomain(WlzObjFactsData *fData,
+				            WlzObject *obj)
+{
+  const char	*tStr;
+  WlzIdxMesh	*mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  ++(fData->indent);
+  tStr = WlzStringFromObjDomainType(obj, &errNum);
+  if((tStr == NULL) || (errNum != WLZ_ERR_NONE))
+  {
+    if(errNum == WLZ_ERR_DOMAIN_NULL)
+    {
+      (void )WlzObjFactsAppend(fData, "Domain NULL.\n");
+      errNum = WLZ_ERR_NONE;
+    }
+    else
+    {
+      (void )WlzObjFactsAppend(fData, "Domain type invalid.\n");
+    }
+  }
+  else
+  {
+    mesh = obj->domain.idm;
+    errNum = WlzObjFactsAppend(fData, "Domain type: %s.\n", tStr);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjFactsAppend(fData, "Linkcount: %d.\n",
+                                 mesh->linkcount);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjFactsAppend(fData, "nVtx: %d.\n", mesh->nVtx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjFactsAppend(fData, "maxVtx: %d.\n", mesh->maxVtx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjFactsAppend(fData, "nElm: %d.\n", mesh->nElm);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjFactsAppend(fData, "maxElm: %d.\n", mesh->maxElm);
+    }
+    if((errNum == WLZ_ERR_NONE) && fData->verbose)
+    {
+      int	i;
+
+      ++(fData->indent);
+      for(i = 0; (errNum == WLZ_ERR_NONE) && (i < mesh->nVtx); ++i)
+      {
+	double	*v;
+
+	v = mesh->vtx + 3 * i;
+	errNum = WlzObjFactsAppend(fData, "vtx %d: %g %g %g\n",
+	                           i, v[0], v[1], v[2]);
+      }
+      for(i = 0; (errNum == WLZ_ERR_NONE) && (i < mesh->nElm); ++i)
+      {
+	int	*e;
+
+	e = mesh->elm + mesh->nElmVtx * i;
+	errNum = (mesh->nElmVtx == 3)?
+	         WlzObjFactsAppend(fData, "elm %d: %d %d %d\n",
+		                   i, e[0], e[1], e[2]):
+	         WlzObjFactsAppend(fData, "elm %d: %d %d %d %d\n",
+		                   i, e[0], e[1], e[2], e[3]);
+      }
+      --(fData->indent);
+    }
+  }
+  --(fData->indent);
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup      WlzDebug
@@ -147,6 +147,13 @@ WlzErrorNum WlzFreeObj(WlzObject *obj)
       errNum = WlzFreeBSpline(obj->domain.bs);
       break;
 
+    case WLZ_IDXMESH:
+      WLZ_DBG((WLZ_DBG_ALLOC|WLZ_DBG_LVL_1),
+      	      ("WlzFreeObj %p WLZ_IDXMESH %p\n",
+	       obj, obj->domain.idm));
+      errNum = WlzFreeIdxMesh(obj->domain.idm);
+      break;
+
     case WLZ_2D_POLYGON:
       WLZ_DBG((WLZ_DBG_ALLOC|WLZ_DBG_LVL_1),
       	      ("WlzFreeObj %p WLZ_2D_POLYGON %p\n",
@@ -441,6 +448,13 @@ WlzErrorNum WlzFreeDomain(WlzDomain domain)
 	case WLZ_3D_VIEW_STRUCT:
 	  errNum = WlzFree3DViewStruct(domain.vs3d);
 	  break;
+	case WLZ_IDXMESH_TRI3D: /* FALLTHROUGH */
+	case WLZ_IDXMESH_TET3D:
+	  /* Already unlinked so free the arrays here. */
+	  AlcFree(domain.idm->vtx);
+	  AlcFree(domain.idm->elm);
+	  AlcFree((void *)domain.core);
+	  break;
 	default:
 	  /* Most domains are are freed in the same way. */
 	  if(domain.core->freeptr != NULL)
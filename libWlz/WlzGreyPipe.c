@@ -0,0 +1,1783 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzGreyPipe_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzGreyPipe.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Grey value pipelines in which a chain of pointwise
+* 		operators (scalar arithmetic, look up tables, range
+* 		mapping, thresholding and masking) is applied to the
+* 		values of a 2D or 3D domain object in a single pass
+* 		over its intervals, with an optional reduction of the
+* 		output values to statistics and/or a histogram.
+*
+* 		Each interval is loaded into a double buffer, passed
+* 		through all the stages and then written out, so a
+* 		chain which would otherwise create and rescan an
+* 		intermediate object for each operator reads and writes
+* 		the values only once. After each value stage the values
+* 		are converted to the grey type of that stage just as
+* 		the corresponding operator converts them: scalar stages
+* 		truncate towards zero (as WlzScalarBinaryOp2()), range
+* 		stages round to the nearest integer (as WlzGreySetRange())
+* 		and in both short and unsigned byte values wrap rather
+* 		than being clamped. The results are then those of
+* 		applying the operators in turn with intermediate objects
+* 		of the stages' grey types, with these exceptions:
+* 		WlzScalarBinaryOp2() promotes unsigned byte values to
+* 		short, so a scalar stage must be given WLZ_GREY_SHORT to
+* 		reproduce it; scalar arithmetic is always done in double
+* 		precision, whereas the operator uses integer arithmetic
+* 		for integral operands (only differing when an integer
+* 		result would overflow); division by zero leaves the
+* 		values unchanged; and WLZ_BO_MIN and WLZ_BO_MAX have no
+* 		scalar operator equivalent.
+* 		Threshold and mask stages reject values rather than
+* 		changing the domain: rejected values are given the
+* 		stage's outside value, are not changed by later stages
+* 		and are excluded from the reduction.
+* 		The planes of 3D objects are processed in parallel.
+* \ingroup	WlzArithmetic
+*/
+
+#include <float.h>
+#include <limits.h>
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzGreyPipeAcc
+* \ingroup	WlzArithmetic
+* \brief	Statistics accumulated over the values of a plane.
+*/
+typedef struct _WlzGreyPipeAcc
+{
+  WlzLong	area;
+  double	min;
+  double	max;
+  double	sum;
+  double	sumSq;
+} WlzGreyPipeAcc;
+
+/*!
+* \struct	_WlzGreyPipeWSp
+* \ingroup	WlzArithmetic
+* \brief	Workspace for a single run of a grey value pipeline.
+*/
+typedef struct _WlzGreyPipeWSp
+{
+  WlzGreyPipe	*pipe;
+  int		write;			/*!< Non-zero if values are to be
+  					     written out. */
+  WlzGreyType	inType;			/*!< Grey type of the input. */
+  WlzGreyType	outType;		/*!< Grey type of the output. */
+  WlzGreyType	*types;			/*!< Grey type after each stage. */
+  double	*outV;			/*!< Rejected value of each stage
+  					     in the output grey type. */
+  int		*hist;			/*!< Histogram bins or NULL. */
+} WlzGreyPipeWSp;
+
+static void			WlzGreyPipeConv(
+				  double *buf,
+				  int n,
+				  WlzGreyType gType);
+static void			WlzGreyPipeCast(
+				  double *buf,
+				  int n,
+				  WlzGreyType gType,
+				  int rnd);
+static void			WlzGreyPipeLoad(
+				  double *buf,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  int n);
+static void			WlzGreyPipeStore(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  double *buf,
+				  int n);
+static void			WlzGreyPipeApply(
+				  WlzGreyPipeWSp *wSp,
+				  double *buf,
+				  int *rej,
+				  int pl,
+				  int ln,
+				  int kl,
+				  int n);
+static void			WlzGreyPipeMaskLn(
+				  WlzObject *mObj,
+				  int *rej,
+				  int id,
+				  int pl,
+				  int ln,
+				  int kl,
+				  int n);
+static void			WlzGreyPipeAccumulate(
+				  WlzGreyPipeWSp *wSp,
+				  WlzGreyPipeAcc *acc,
+				  int *hist,
+				  double *buf,
+				  int *rej,
+				  int n);
+static WlzErrorNum		WlzGreyPipeAddStage(
+				  WlzGreyPipe *pipe,
+				  WlzGreyPipeStage **dstStage);
+static WlzErrorNum		WlzGreyPipeCheckType(
+				  WlzGreyType gType);
+static WlzErrorNum		WlzGreyPipeSetup(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *gObj);
+static WlzErrorNum		WlzGreyPipeRun2D(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *iObj,
+				  WlzObject *oObj,
+				  int pl,
+				  WlzGreyPipeAcc *acc,
+				  int *hist);
+static WlzErrorNum		WlzGreyPipeRun3D(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *iObj,
+				  WlzObject *oObj,
+				  WlzGreyPipeAcc *acc);
+static WlzObject		*WlzGreyPipeRunObj(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj,
+				  int write,
+				  int inPlace,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	New grey value pipeline or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Creates a new grey value pipeline without any stages
+* 		or reduction. The pipeline should be freed using
+* 		WlzFreeGreyPipe().
+* \param	dstErr			Destination error pointer, may
+* 					be NULL.
+*/
+WlzGreyPipe			*WlzMakeGreyPipe(
+				  WlzErrorNum *dstErr)
+{
+  WlzGreyPipe	*pipe;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((pipe = (WlzGreyPipe *)AlcCalloc(1, sizeof(WlzGreyPipe))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pipe);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Frees a grey value pipeline along with its stages and
+* 		any histogram.
+* \param	pipe			Given grey value pipeline.
+*/
+WlzErrorNum			WlzFreeGreyPipe(
+				  WlzGreyPipe *pipe)
+{
+  int		idx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pipe)
+  {
+    for(idx = 0; idx < pipe->nStages; ++idx)
+    {
+      (void )WlzFreeObj(pipe->stages[idx].obj);
+    }
+    (void )WlzFreeObj(pipe->hist);
+    AlcFree(pipe->stages);
+    AlcFree(pipe);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a scalar binary operator stage to the given
+* 		pipeline, which sets each value v to v op val. As with
+* 		WlzScalarBinaryOp2() integral results are truncated
+* 		towards zero and short or unsigned byte results wrap.
+* 		Division by a value with magnitude less than DBL_EPSILON
+* 		leaves the values unchanged.
+* \param	pipe			Given grey value pipeline.
+* \param	op			Binary operator which must be one
+* 					of WLZ_BO_ADD, WLZ_BO_SUBTRACT,
+* 					WLZ_BO_MULTIPLY, WLZ_BO_DIVIDE,
+* 					WLZ_BO_MIN or WLZ_BO_MAX.
+* \param	val			Scalar operand.
+* \param	gType			Grey type of the values after the
+* 					stage, or WLZ_GREY_ERROR to leave
+* 					the grey type unchanged.
+*/
+WlzErrorNum			WlzGreyPipeAddScalar(
+				  WlzGreyPipe *pipe,
+				  WlzBinaryOperatorType op,
+				  double val,
+				  WlzGreyType gType)
+{
+  WlzGreyPipeStage *stage = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(op)
+  {
+    case WLZ_BO_ADD:      /* FALLTHROUGH */
+    case WLZ_BO_SUBTRACT: /* FALLTHROUGH */
+    case WLZ_BO_MULTIPLY: /* FALLTHROUGH */
+    case WLZ_BO_DIVIDE:   /* FALLTHROUGH */
+    case WLZ_BO_MIN:      /* FALLTHROUGH */
+    case WLZ_BO_MAX:
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_DATA;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeCheckType(gType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeAddStage(pipe, &stage);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stage->type = WLZ_GREYPIPE_STAGE_SCALAR;
+    stage->gType = gType;
+    stage->op = op;
+    stage->val[0] = val;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a look up table stage to the given pipeline.
+* 		As with WlzLUTTransformObj() (but without dithering)
+* 		each value indexes the LUT, with values outside the
+* 		LUT's range clamped to its first or last bin, and the
+* 		values after the stage are of type int. The values given
+* 		to this stage must be of type int, short or unsigned
+* 		byte.
+* \param	pipe			Given grey value pipeline.
+* \param	lutObj			Look up table object with int values,
+* 					which is assigned to the pipeline.
+*/
+WlzErrorNum			WlzGreyPipeAddLUT(
+				  WlzGreyPipe *pipe,
+				  WlzObject *lutObj)
+{
+  WlzGreyPipeStage *stage = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(lutObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(lutObj->type != WLZ_LUT)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(lutObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(lutObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(lutObj->domain.lut->lastbin < lutObj->domain.lut->bin1)
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  else if(lutObj->values.lut->vType != WLZ_GREY_INT)
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeAddStage(pipe, &stage);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stage->type = WLZ_GREYPIPE_STAGE_LUT;
+    stage->gType = WLZ_GREY_INT;
+    stage->obj = WlzAssignObject(lutObj, NULL);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a range stage to the given pipeline which, as
+* 		with WlzGreySetRange() (but without dithering), maps
+* 		each value v to
+* 		\f[
+		  v' = \frac{(newMax - newMin)}{(max - min)}(v - min) + newMin
+		\f]
+* 		with integral results rounded to the nearest integer
+* 		and short or unsigned byte results wrapping.
+* \param	pipe			Given grey value pipeline.
+* \param	min			Source range minimum.
+* \param	max			Source range maximum.
+* \param	newMin			Destination range minimum.
+* \param	newMax			Destination range maximum.
+* \param	gType			Grey type of the values after the
+* 					stage, or WLZ_GREY_ERROR to leave
+* 					the grey type unchanged.
+*/
+WlzErrorNum			WlzGreyPipeAddRange(
+				  WlzGreyPipe *pipe,
+				  double min,
+				  double max,
+				  double newMin,
+				  double newMax,
+				  WlzGreyType gType)
+{
+  WlzGreyPipeStage *stage = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fabs(max - min) < DBL_EPSILON)
+  {
+    errNum = WLZ_ERR_FLOAT_DATA;
+  }
+  else
+  {
+    errNum = WlzGreyPipeCheckType(gType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeAddStage(pipe, &stage);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stage->type = WLZ_GREYPIPE_STAGE_RANGE;
+    stage->gType = gType;
+    stage->val[0] = min;
+    stage->val[1] = max;
+    stage->val[2] = newMin;
+    stage->val[3] = newMax;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a threshold stage to the given pipeline. Values
+* 		which fail the threshold (using the same comparisons as
+* 		WlzThreshold()) are rejected: they are given the outside
+* 		value and are excluded from any reduction. Unlike
+* 		WlzThreshold() the domain is not changed.
+* \param	pipe			Given grey value pipeline.
+* \param	thrV			Threshold value.
+* \param	thrType			Threshold type.
+* \param	outV			Value given to rejected values.
+*/
+WlzErrorNum			WlzGreyPipeAddThreshold(
+				  WlzGreyPipe *pipe,
+				  double thrV,
+				  WlzThresholdType thrType,
+				  double outV)
+{
+  WlzGreyPipeStage *stage = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(thrType)
+  {
+    case WLZ_THRESH_LOW:  /* FALLTHROUGH */
+    case WLZ_THRESH_HIGH: /* FALLTHROUGH */
+    case WLZ_THRESH_EQUAL:
+      errNum = WlzGreyPipeAddStage(pipe, &stage);
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_DATA;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stage->type = WLZ_GREYPIPE_STAGE_THRESHOLD;
+    stage->gType = WLZ_GREY_ERROR;
+    stage->thrType = thrType;
+    stage->val[0] = thrV;
+    stage->outV = outV;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a mask stage to the given pipeline. Values
+* 		outside the domain of the mask object are rejected:
+* 		they are given the outside value and are excluded from
+* 		any reduction. The mask object must have the same
+* 		dimension as the objects the pipeline is run on.
+* \param	pipe			Given grey value pipeline.
+* \param	mObj			Mask object which is assigned to
+* 					the pipeline.
+* \param	outV			Value given to rejected values.
+*/
+WlzErrorNum			WlzGreyPipeAddMask(
+				  WlzGreyPipe *pipe,
+				  WlzObject *mObj,
+				  double outV)
+{
+  WlzGreyPipeStage *stage = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(mObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(mObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	switch(mObj->domain.core->type)
+	{
+	  case WLZ_INTERVALDOMAIN_INTVL: /* FALLTHROUGH */
+	  case WLZ_INTERVALDOMAIN_RECT:
+	    break;
+	  default:
+	    errNum = WLZ_ERR_DOMAIN_TYPE;
+	    break;
+	}
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(mObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeAddStage(pipe, &stage);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stage->type = WLZ_GREYPIPE_STAGE_MASK;
+    stage->gType = WLZ_GREY_ERROR;
+    stage->outV = outV;
+    stage->obj = WlzAssignObject(mObj, NULL);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Sets the reductions to be computed from the output values
+* 		of the pipeline. After a run the statistics are available
+* 		in the pipeline's area, min, max, sum, sumSq, mean and
+* 		stdDev fields, computed as by WlzGreyStats(), and the
+* 		histogram in its hist field. Histogram bins are computed
+* 		as by WlzHistogramObj().
+* \param	pipe			Given grey value pipeline.
+* \param	reduce			Bitwise or of the required
+* 					reductions (::WlzGreyPipeReduceFlags).
+* \param	nBins			Number of histogram bins, only used
+* 					for a histogram.
+* \param	binOrigin		Lowest value of the histogram.
+* \param	binSize			Histogram bin size.
+*/
+WlzErrorNum			WlzGreyPipeSetReduce(
+				  WlzGreyPipe *pipe,
+				  unsigned int reduce,
+				  int nBins,
+				  double binOrigin,
+				  double binSize)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pipe == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((reduce & ~(WLZ_GREYPIPE_REDUCE_STATS |
+                      WLZ_GREYPIPE_REDUCE_HISTOGRAM)) != 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((reduce & WLZ_GREYPIPE_REDUCE_HISTOGRAM) != 0) &&
+          ((nBins <= 0) || (binSize < DBL_EPSILON)))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    pipe->reduce = reduce;
+    pipe->histNBins = nBins;
+    pipe->histOrigin = binOrigin;
+    pipe->histBinSize = binSize;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzArithmetic
+* \brief	Runs the given pipeline on the values of the given
+* 		object in a single pass, computing any reductions set
+* 		for the pipeline. The background value of the returned
+* 		object is the given object's background value passed
+* 		through the pipeline's scalar, LUT and range stages.
+* \param	pipe			Given grey value pipeline.
+* \param	gObj			Given 2D or 3D domain object with
+* 					non-tiled int, short, unsigned byte,
+* 					float or double values.
+* \param	inPlace			If non-zero the given object's values
+* 					are overwritten and the returned
+* 					object shares them, in which case the
+* 					pipeline must not change the grey
+* 					type. Otherwise the returned object
+* 					has new values of the pipeline's
+* 					output grey type.
+* \param	dstErr			Destination error pointer, may
+* 					be NULL.
+*/
+WlzObject			*WlzGreyPipeRun(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj,
+				  int inPlace,
+				  WlzErrorNum *dstErr)
+{
+  return(WlzGreyPipeRunObj(pipe, gObj, 1, inPlace, dstErr));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Runs the given pipeline on the values of the given
+* 		object in a single pass, only computing the reductions
+* 		set for the pipeline. The object's values are not
+* 		changed.
+* \param	pipe			Given grey value pipeline.
+* \param	gObj			Given 2D or 3D domain object with
+* 					non-tiled int, short, unsigned byte,
+* 					float or double values.
+*/
+WlzErrorNum			WlzGreyPipeReduce(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )WlzGreyPipeRunObj(pipe, gObj, 0, 0, &errNum);
+  return(errNum);
+}
+
+/*!
+* \return	New object, NULL if the values are not written or on
+* 		error.
+* \ingroup	WlzArithmetic
+* \brief	Runs the given pipeline, see WlzGreyPipeRun() and
+* 		WlzGreyPipeReduce().
+* \param	pipe			Given grey value pipeline.
+* \param	gObj			Given object.
+* \param	write			Non-zero if the values are to be
+* 					written.
+* \param	inPlace			Non-zero if the values are to be
+* 					written in place.
+* \param	dstErr			Destination error pointer, may
+* 					be NULL.
+*/
+static WlzObject		*WlzGreyPipeRunObj(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj,
+				  int write,
+				  int inPlace,
+				  WlzErrorNum *dstErr)
+{
+  int		nPl = 1;
+  WlzGreyPipeAcc *acc = NULL;
+  WlzObject	*rtnObj = NULL;
+  WlzGreyPipeWSp wSp;
+  WlzPixelV	bgdV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&wSp, 0, sizeof(WlzGreyPipeWSp));
+  if(pipe == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(gObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    (void )WlzFreeObj(pipe->hist);
+    pipe->hist = NULL;
+    pipe->area = 0;
+    pipe->min = pipe->max = pipe->sum = pipe->sumSq = 0.0;
+    pipe->mean = 0.0;
+    pipe->stdDev = -1.0;
+    wSp.pipe = pipe;
+    wSp.write = write;
+    switch(gObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(gObj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(gObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_PLANEDOMAIN_TYPE;
+	}
+	else
+	{
+	  nPl = gObj->domain.p->lastpl - gObj->domain.p->plane1 + 1;
+	}
+        break;
+      case WLZ_EMPTY_OBJ:
+	errNum = WLZ_ERR_EOO;
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyPipeSetup(&wSp, gObj);
+  }
+  if((errNum == WLZ_ERR_NONE) && write && inPlace &&
+     (wSp.outType != wSp.inType))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((acc = (WlzGreyPipeAcc *)
+              AlcCalloc(nPl, sizeof(WlzGreyPipeAcc))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Compute the background value and create the returned object. */
+  if((errNum == WLZ_ERR_NONE) && write)
+  {
+    double	bgdD;
+    WlzPixelV	tV;
+
+    bgdV = WlzGetBackground(gObj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzValueConvertPixel(&tV, bgdV, WLZ_GREY_DOUBLE);
+      bgdD = tV.v.dbv;
+      WlzGreyPipeApply(&wSp, &bgdD, NULL, 0, 0, 0, 1);
+      tV.v.dbv = bgdD;
+      errNum = WlzValueConvertPixel(&bgdV, tV, wSp.outType);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(inPlace)
+      {
+	rtnObj = WlzMakeMain(gObj->type, gObj->domain, gObj->values,
+			     NULL, NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzSetBackground(rtnObj, bgdV);
+	}
+      }
+      else
+      {
+	WlzValues	nVal;
+	WlzObjectType	gTT;
+
+	nVal.core = NULL;
+	gTT = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, wSp.outType, NULL);
+	if(gObj->type == WLZ_2D_DOMAINOBJ)
+	{
+	  nVal.v = WlzNewValueTb(gObj, gTT, bgdV, &errNum);
+	}
+	else
+	{
+	  nVal.vox = WlzNewValuesVox(gObj, gTT, bgdV, &errNum);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  rtnObj = WlzMakeMain(gObj->type, gObj->domain, nVal,
+			       NULL, NULL, &errNum);
+	}
+	if((rtnObj == NULL) && (nVal.core != NULL))
+	{
+	  if(gObj->type == WLZ_2D_DOMAINOBJ)
+	  {
+	    (void )WlzFreeValueTb(nVal.v);
+	  }
+	  else
+	  {
+	    (void )WlzFreeVoxelValueTb(nVal.vox);
+	  }
+	}
+      }
+    }
+  }
+  /* Stream the values through the pipeline. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObject	*oObj;
+
+    oObj = (write && !inPlace)? rtnObj: NULL;
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      errNum = WlzGreyPipeRun2D(&wSp, gObj, oObj, 0, acc, wSp.hist);
+    }
+    else
+    {
+      errNum = WlzGreyPipeRun3D(&wSp, gObj, oObj, acc);
+    }
+  }
+  /* Combine the plane reductions in plane order so that the results
+   * do not depend on the number of threads. */
+  if((errNum == WLZ_ERR_NONE) &&
+     ((pipe->reduce & WLZ_GREYPIPE_REDUCE_STATS) != 0))
+  {
+    int		idx;
+
+    for(idx = 0; idx < nPl; ++idx)
+    {
+      WlzGreyPipeAcc *a;
+
+      a = acc + idx;
+      if(a->area > 0)
+      {
+        if(pipe->area == 0)
+	{
+	  pipe->min = a->min;
+	  pipe->max = a->max;
+	}
+	else
+	{
+	  pipe->min = ALG_MIN(pipe->min, a->min);
+	  pipe->max = ALG_MAX(pipe->max, a->max);
+	}
+	pipe->area += a->area;
+	pipe->sum += a->sum;
+	pipe->sumSq += a->sumSq;
+      }
+    }
+    if(pipe->area > 0)
+    {
+      pipe->mean = pipe->sum / pipe->area;
+      if(pipe->area > 1)
+      {
+	pipe->stdDev = sqrt((pipe->sumSq - (pipe->sum * pipe->sum /
+	                                    pipe->area)) / (pipe->area - 1));
+      }
+      else
+      {
+	pipe->stdDev = 0.0;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((pipe->reduce & WLZ_GREYPIPE_REDUCE_HISTOGRAM) != 0))
+  {
+    WlzObject	*hObj;
+
+    hObj = WlzMakeHistogram(WLZ_HISTOGRAMDOMAIN_INT, pipe->histNBins,
+                            &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzHistogramDomain *hDom;
+
+      hDom = hObj->domain.hist;
+      hDom->nBins = pipe->histNBins;
+      hDom->origin = pipe->histOrigin;
+      hDom->binSize = pipe->histBinSize;
+      (void )memcpy(hDom->binValues.inp, wSp.hist,
+                    sizeof(int) * pipe->histNBins);
+      pipe->hist = WlzAssignObject(hObj, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_EOO)
+  {
+    /* Empty object: nothing to do. */
+    errNum = WLZ_ERR_NONE;
+    if(write)
+    {
+      rtnObj = WlzMakeEmpty(&errNum);
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (rtnObj != NULL))
+  {
+    (void )WlzFreeObj(rtnObj);
+    rtnObj = NULL;
+  }
+  AlcFree(acc);
+  AlcFree(wSp.types);
+  AlcFree(wSp.outV);
+  AlcFree(wSp.hist);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rtnObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Checks that the grey type is one that can be used for
+* 		the values between stages.
+* \param	gType			Given grey type, WLZ_GREY_ERROR is
+* 					accepted as meaning unchanged.
+*/
+static WlzErrorNum		WlzGreyPipeCheckType(
+				  WlzGreyType gType)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(gType)
+  {
+    case WLZ_GREY_ERROR: /* FALLTHROUGH */
+    case WLZ_GREY_INT:   /* FALLTHROUGH */
+    case WLZ_GREY_SHORT: /* FALLTHROUGH */
+    case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+    case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+    case WLZ_GREY_DOUBLE:
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Appends a zeroed stage to the given pipeline.
+* \param	pipe			Given grey value pipeline.
+* \param	dstStage		Destination pointer for the new
+* 					stage.
+*/
+static WlzErrorNum		WlzGreyPipeAddStage(
+				  WlzGreyPipe *pipe,
+				  WlzGreyPipeStage **dstStage)
+{
+  const int	stageStep = 16;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pipe == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(pipe->nStages >= pipe->maxStages)
+  {
+    int		maxStages;
+    WlzGreyPipeStage *stages;
+
+    maxStages = pipe->maxStages + stageStep;
+    if((stages = (WlzGreyPipeStage *)
+                 AlcRealloc(pipe->stages,
+		            sizeof(WlzGreyPipeStage) * maxStages)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      pipe->stages = stages;
+      pipe->maxStages = maxStages;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstStage = pipe->stages + pipe->nStages++;
+    (void )memset(*dstStage, 0, sizeof(WlzGreyPipeStage));
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Checks the given object against the stages of the
+* 		pipeline, computes the grey type after each stage and
+* 		allocates the workspace's arrays.
+* \param	wSp			Workspace with the pipeline set.
+* \param	gObj			Given 2D or 3D domain object.
+*/
+static WlzErrorNum		WlzGreyPipeSetup(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *gObj)
+{
+  int		idx,
+  		nSt;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzGreyPipe	*pipe;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pipe = wSp->pipe;
+  nSt = pipe->nStages;
+  if(gObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(gObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(gObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((gObj->type == WLZ_3D_DOMAINOBJ) &&
+          (gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+  {
+    errNum = WLZ_ERR_VOXELVALUES_TYPE;
+  }
+  else
+  {
+    gType = WlzGreyTypeFromObj(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((gType == WLZ_GREY_ERROR) ||
+       (WlzGreyPipeCheckType(gType) != WLZ_ERR_NONE))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((wSp->types = (WlzGreyType *)
+                      AlcMalloc(sizeof(WlzGreyType) * (nSt + 1))) == NULL) ||
+       ((wSp->outV = (double *)
+                     AlcMalloc(sizeof(double) * (nSt + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp->inType = gType;
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nSt); ++idx)
+    {
+      WlzGreyPipeStage *stage;
+
+      stage = pipe->stages + idx;
+      switch(stage->type)
+      {
+        case WLZ_GREYPIPE_STAGE_LUT:
+	  switch(gType)
+	  {
+	    case WLZ_GREY_INT:   /* FALLTHROUGH */
+	    case WLZ_GREY_SHORT: /* FALLTHROUGH */
+	    case WLZ_GREY_UBYTE:
+	      break;
+	    default:
+	      errNum = WLZ_ERR_GREY_TYPE;
+	      break;
+	  }
+	  break;
+        case WLZ_GREYPIPE_STAGE_MASK:
+	  if(stage->obj->type != gObj->type)
+	  {
+	    errNum = WLZ_ERR_OBJECT_TYPE;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      if(stage->gType != WLZ_GREY_ERROR)
+      {
+        gType = stage->gType;
+      }
+      wSp->types[idx] = gType;
+    }
+    wSp->outType = gType;
+  }
+  /* The rejected values are only ever set after the last stage so
+   * they are converted to the output grey type here. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nSt; ++idx)
+    {
+      wSp->outV[idx] = pipe->stages[idx].outV;
+      WlzGreyPipeConv(wSp->outV + idx, 1, wSp->outType);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((pipe->reduce & WLZ_GREYPIPE_REDUCE_HISTOGRAM) != 0))
+  {
+    if((wSp->hist = (int *)AlcCalloc(pipe->histNBins, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  return(errNum);
+}
+
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Runs the pipeline over the planes of a 3D object in
+* 		parallel. The statistics are accumulated per plane and
+* 		each thread accumulates its own histogram, these are
+* 		then summed.
+* \param	wSp			Pipeline workspace.
+* \param	iObj			Given 3D object.
+* \param	oObj			Output object, NULL if the values are
+* 					not written or are written in place.
+* \param	acc			Array of accumulators, one per plane.
+*/
+static WlzErrorNum		WlzGreyPipeRun3D(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *iObj,
+				  WlzObject *oObj,
+				  WlzGreyPipeAcc *acc)
+{
+  int		idx,
+  		nPl,
+  		nBins;
+  WlzPlaneDomain *pDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = iObj->domain.p;
+  nPl = pDom->lastpl - pDom->plane1 + 1;
+  nBins = (wSp->hist)? wSp->pipe->histNBins: 0;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    int		*hist = NULL;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    if((nBins > 0) &&
+       ((hist = (int *)AlcCalloc(nBins, sizeof(int))) == NULL))
+    {
+      errNum2 = WLZ_ERR_MEM_ALLOC;
+    }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for(idx = 0; idx < nPl; ++idx)
+    {
+      WlzDomain	dom;
+      WlzValues	iVal;
+
+      dom = pDom->domains[idx];
+      iVal = iObj->values.vox->values[idx];
+      if((errNum2 == WLZ_ERR_NONE) &&
+         (dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+	 (iVal.core != NULL))
+      {
+	WlzObject *iObj2 = NULL,
+		  *oObj2 = NULL;
+	WlzValues nullVal;
+
+	nullVal.core = NULL;
+	iObj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, iVal, NULL, NULL,
+			    &errNum2);
+	if((errNum2 == WLZ_ERR_NONE) && oObj)
+	{
+	  oObj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom,
+			      (oObj->values.vox->values[idx].core)?
+			      oObj->values.vox->values[idx]: nullVal,
+			      NULL, NULL, &errNum2);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  errNum2 = WlzGreyPipeRun2D(wSp, iObj2, oObj2,
+				     pDom->plane1 + idx, acc + idx, hist);
+	}
+	(void )WlzFreeObj(oObj2);
+	(void )WlzFreeObj(iObj2);
+      }
+    }
+#ifdef _OPENMP
+#pragma omp critical (WlzGreyPipeRun3D)
+#endif
+    {
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+        if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = errNum2;
+	}
+      }
+      else if(hist)
+      {
+	int	bIdx;
+
+	for(bIdx = 0; bIdx < nBins; ++bIdx)
+	{
+	  wSp->hist[bIdx] += hist[bIdx];
+	}
+      }
+    }
+    AlcFree(hist);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Runs the pipeline over the intervals of a 2D object.
+* \param	wSp			Pipeline workspace.
+* \param	iObj			Given 2D object.
+* \param	oObj			Output object with the same domain
+* 					as the given object, NULL if the
+* 					values are not written or are
+* 					written in place.
+* \param	pl			Plane coordinate of the object.
+* \param	acc			Statistics accumulator.
+* \param	hist			Histogram bins, NULL if no
+* 					histogram is required.
+*/
+static WlzErrorNum		WlzGreyPipeRun2D(
+				  WlzGreyPipeWSp *wSp,
+				  WlzObject *iObj,
+				  WlzObject *oObj,
+				  int pl,
+				  WlzGreyPipeAcc *acc,
+				  int *hist)
+{
+  int		width;
+  int		*rej = NULL;
+  double	*buf = NULL;
+  WlzIntervalWSpace iIWSp,
+  		oIWSp;
+  WlzGreyWSpace	iGWSp,
+  		oGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  width = iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1;
+  if(((buf = (double *)AlcMalloc(sizeof(double) * width)) == NULL) ||
+     ((rej = (int *)AlcMalloc(sizeof(int) * width)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(iObj, &iIWSp, &iGWSp);
+  }
+  if((errNum == WLZ_ERR_NONE) && oObj)
+  {
+    errNum = WlzInitGreyScan(oObj, &oIWSp, &oGWSp);
+  }
+  while((errNum == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE))
+  {
+    int		n;
+    WlzGreyP	oP;
+
+    n = iIWSp.rgtpos - iIWSp.lftpos + 1;
+    oP = iGWSp.u_grintptr;
+    if(oObj)
+    {
+      if((errNum = WlzNextGreyInterval(&oIWSp)) == WLZ_ERR_NONE)
+      {
+        oP = oGWSp.u_grintptr;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzGreyPipeLoad(buf, iGWSp.u_grintptr, wSp->inType, n);
+      WlzGreyPipeApply(wSp, buf, rej, pl, iIWSp.linpos, iIWSp.lftpos, n);
+      if(wSp->write)
+      {
+	WlzGreyPipeStore(oP, wSp->outType, buf, n);
+      }
+      WlzGreyPipeAccumulate(wSp, acc, hist, buf, rej, n);
+    }
+  }
+  if(errNum == WLZ_ERR_EOO)
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  if(oObj)
+  {
+    (void )WlzEndGreyScan(&oIWSp, &oGWSp);
+  }
+  (void )WlzEndGreyScan(&iIWSp, &iGWSp);
+  AlcFree(buf);
+  AlcFree(rej);
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Applies the stages of the pipeline to a buffer of values
+* 		from an interval. On return the values are of the
+* 		output grey type and the rejection buffer holds zero for
+* 		values which were not rejected or one more than the
+* 		index of the stage which rejected them. If the rejection
+* 		buffer is NULL then only the value stages are applied,
+* 		this is used for the background value.
+* \param	wSp			Pipeline workspace.
+* \param	buf			Buffer of values.
+* \param	rej			Rejection buffer, may be NULL.
+* \param	pl			Plane coordinate of the interval.
+* \param	ln			Line coordinate of the interval.
+* \param	kl			Column coordinate of the first value.
+* \param	n			Number of values.
+*/
+static void			WlzGreyPipeApply(
+				  WlzGreyPipeWSp *wSp,
+				  double *buf,
+				  int *rej,
+				  int pl,
+				  int ln,
+				  int kl,
+				  int n)
+{
+  int		idx,
+  		sIdx,
+		anyRej = 0;
+  WlzGreyPipe	*pipe;
+
+  pipe = wSp->pipe;
+  if(rej)
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      rej[idx] = 0;
+    }
+  }
+  for(sIdx = 0; sIdx < pipe->nStages; ++sIdx)
+  {
+    WlzGreyPipeStage *stage;
+
+    stage = pipe->stages + sIdx;
+    switch(stage->type)
+    {
+      case WLZ_GREYPIPE_STAGE_SCALAR:
+	{
+	  double v;
+
+	  v = stage->val[0];
+	  switch(stage->op)
+	  {
+	    case WLZ_BO_ADD:
+	      WlzValueKrnMulAddDouble(buf, buf, 1.0, v, n);
+	      break;
+	    case WLZ_BO_SUBTRACT:
+	      WlzValueKrnMulAddDouble(buf, buf, 1.0, -v, n);
+	      break;
+	    case WLZ_BO_MULTIPLY:
+	      WlzValueKrnMulAddDouble(buf, buf, v, 0.0, n);
+	      break;
+	    case WLZ_BO_DIVIDE:
+	      if(fabs(v) > DBL_EPSILON)
+	      {
+		for(idx = 0; idx < n; ++idx)
+		{
+		  buf[idx] /= v;
+		}
+	      }
+	      break;
+	    case WLZ_BO_MIN:
+	      for(idx = 0; idx < n; ++idx)
+	      {
+		buf[idx] = ALG_MIN(buf[idx], v);
+	      }
+	      break;
+	    case WLZ_BO_MAX:
+	      for(idx = 0; idx < n; ++idx)
+	      {
+		buf[idx] = ALG_MAX(buf[idx], v);
+	      }
+	      break;
+	    default:
+	      break;
+	  }
+	  WlzGreyPipeCast(buf, n, wSp->types[sIdx], 0);
+	}
+        break;
+      case WLZ_GREYPIPE_STAGE_LUT:
+	{
+	  int	bin1,
+	  	maxBin;
+	  int	*lut;
+
+	  bin1 = stage->obj->domain.lut->bin1;
+	  maxBin = stage->obj->domain.lut->lastbin - bin1;
+	  lut = stage->obj->values.lut->val.inp;
+	  for(idx = 0; idx < n; ++idx)
+	  {
+	    int	  i;
+
+	    i = (int )(buf[idx]) - bin1;
+	    i = WLZ_CLAMP(i, 0, maxBin);
+	    buf[idx] = lut[i];
+	  }
+	}
+        break;
+      case WLZ_GREYPIPE_STAGE_RANGE:
+	{
+	  double f;
+
+	  f = (stage->val[3] - stage->val[2]) /
+	      (stage->val[1] - stage->val[0]);
+	  for(idx = 0; idx < n; ++idx)
+	  {
+	    buf[idx] = f * (buf[idx] - stage->val[0]) + stage->val[2];
+	  }
+	  WlzGreyPipeCast(buf, n, wSp->types[sIdx], 1);
+	}
+        break;
+      case WLZ_GREYPIPE_STAGE_THRESHOLD:
+	if(rej != NULL)
+	{
+	  double t;
+
+	  t = stage->val[0];
+	  for(idx = 0; idx < n; ++idx)
+	  {
+	    if(rej[idx] == 0)
+	    {
+	      int  pass;
+
+	      switch(stage->thrType)
+	      {
+		case WLZ_THRESH_LOW:
+		  pass = buf[idx] < t;
+		  break;
+		case WLZ_THRESH_HIGH:
+		  pass = buf[idx] >= t;
+		  break;
+		default:
+		  pass = buf[idx] == t;
+		  break;
+	      }
+	      if(!pass)
+	      {
+		rej[idx] = sIdx + 1;
+		anyRej = 1;
+	      }
+	    }
+	  }
+	}
+        break;
+      case WLZ_GREYPIPE_STAGE_MASK:
+	if(rej != NULL)
+	{
+	  WlzGreyPipeMaskLn(stage->obj, rej, sIdx + 1, pl, ln, kl, n);
+	  anyRej = 1;
+	}
+        break;
+    }
+  }
+  if(anyRej)
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      if(rej[idx])
+      {
+	buf[idx] = wSp->outV[rej[idx] - 1];
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Rejects those values of an interval which are outside
+* 		the domain of a mask object and have not already been
+* 		rejected.
+* \param	mObj			Mask object, either a 2D object with
+* 					an interval domain or a 3D object
+* 					with a plane domain.
+* \param	rej			Rejection buffer.
+* \param	id			Value to set in the rejection buffer.
+* \param	pl			Plane coordinate of the interval.
+* \param	ln			Line coordinate of the interval.
+* \param	kl			Column coordinate of the first value.
+* \param	n			Number of values.
+*/
+static void			WlzGreyPipeMaskLn(
+				  WlzObject *mObj,
+				  int *rej,
+				  int id,
+				  int pl,
+				  int ln,
+				  int kl,
+				  int n)
+{
+  int		idx,
+		nItv = 0;
+  WlzInterval	rItv;
+  WlzInterval	*itv = NULL;
+  WlzIntervalDomain *iDom = NULL;
+
+  if(mObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    iDom = mObj->domain.i;
+  }
+  else
+  {
+    WlzPlaneDomain *pDom;
+
+    pDom = mObj->domain.p;
+    if((pl >= pDom->plane1) && (pl <= pDom->lastpl))
+    {
+      iDom = pDom->domains[pl - pDom->plane1].i;
+    }
+  }
+  if((iDom != NULL) && (ln >= iDom->line1) && (ln <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      rItv.ileft = 0;
+      rItv.iright = iDom->lastkl - iDom->kol1;
+      itv = &rItv;
+      nItv = 1;
+    }
+    else if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+    {
+      WlzIntervalLine *itvLn;
+
+      itvLn = iDom->intvlines + ln - iDom->line1;
+      itv = itvLn->intvs;
+      nItv = itvLn->nintvs;
+    }
+  }
+  /* Walk along the interval rejecting values in the gaps between the
+   * mask's intervals. */
+  idx = 0;
+  while((idx < n) && (nItv-- > 0))
+  {
+    int		e;
+
+    e = iDom->kol1 + itv->ileft - kl;
+    e = ALG_MIN(e, n);
+    while(idx < e)
+    {
+      if(rej[idx] == 0)
+      {
+        rej[idx] = id;
+      }
+      ++idx;
+    }
+    e = iDom->kol1 + itv->iright - kl + 1;
+    idx = ALG_MAX(idx, e);
+    ++itv;
+  }
+  while(idx < n)
+  {
+    if(rej[idx] == 0)
+    {
+      rej[idx] = id;
+    }
+    ++idx;
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Accumulates the statistics and histogram of those values
+* 		of an interval which have not been rejected.
+* \param	wSp			Pipeline workspace.
+* \param	acc			Statistics accumulator.
+* \param	hist			Histogram bins, may be NULL.
+* \param	buf			Buffer of values.
+* \param	rej			Rejection buffer.
+* \param	n			Number of values.
+*/
+static void			WlzGreyPipeAccumulate(
+				  WlzGreyPipeWSp *wSp,
+				  WlzGreyPipeAcc *acc,
+				  int *hist,
+				  double *buf,
+				  int *rej,
+				  int n)
+{
+  int		idx;
+  WlzGreyPipe	*pipe;
+
+  pipe = wSp->pipe;
+  if((pipe->reduce & WLZ_GREYPIPE_REDUCE_STATS) != 0)
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      if(rej[idx] == 0)
+      {
+	double	v;
+
+	v = buf[idx];
+	if(acc->area == 0)
+	{
+	  acc->min = acc->max = v;
+	}
+	else if(v < acc->min)
+	{
+	  acc->min = v;
+	}
+	else if(v > acc->max)
+	{
+	  acc->max = v;
+	}
+	++(acc->area);
+	acc->sum += v;
+	acc->sumSq += v * v;
+      }
+    }
+  }
+  if(hist != NULL)
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      if(rej[idx] == 0)
+      {
+	int	bIdx;
+
+	bIdx = (int )floor((buf[idx] - pipe->histOrigin) / pipe->histBinSize);
+	if((bIdx >= 0) && (bIdx < pipe->histNBins))
+	{
+	  ++(hist[bIdx]);
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Clamps and rounds a buffer of values so that they are
+* 		representable in the given grey type.
+* \param	buf			Buffer of values.
+* \param	n			Number of values.
+* \param	gType			Given grey type.
+*/
+static void			WlzGreyPipeConv(
+				  double *buf,
+				  int n,
+				  WlzGreyType gType)
+{
+  int		idx;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	t;
+
+	t = WLZ_CLAMP(buf[idx], INT_MIN, INT_MAX);
+	buf[idx] = WLZ_NINT(t);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	t;
+
+	t = WLZ_CLAMP(buf[idx], SHRT_MIN, SHRT_MAX);
+	buf[idx] = WLZ_NINT(t);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	double	t;
+
+	t = WLZ_CLAMP(buf[idx], 0, UCHAR_MAX);
+	buf[idx] = WLZ_NINT(t);
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	buf[idx] = (float )WLZ_CLAMP(buf[idx], -(FLT_MAX), FLT_MAX);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Converts a buffer of values to the given grey type in
+* 		the same way as the scalar arithmetic operators and
+* 		WlzGreySetRange(). Values are either truncated towards
+* 		zero (as by the casts in WlzScalarBinaryOp()) or rounded
+* 		to the nearest integer (as by WLZ_NINT() in
+* 		WlzGreySetRange()), and then cast to the grey type, so
+* 		that short and unsigned byte values wrap rather than
+* 		being clamped. Only values beyond the range of int are
+* 		clamped, since their conversion to int is undefined.
+* \param	buf			Buffer of values.
+* \param	n			Number of values.
+* \param	gType			Given grey type.
+* \param	rnd			Round to the nearest integer if
+* 					non-zero, otherwise truncate.
+*/
+static void			WlzGreyPipeCast(
+				  double *buf,
+				  int n,
+				  WlzGreyType gType,
+				  int rnd)
+{
+  int		idx;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:   /* FALLTHROUGH */
+    case WLZ_GREY_SHORT: /* FALLTHROUGH */
+    case WLZ_GREY_UBYTE:
+      for(idx = 0; idx < n; ++idx)
+      {
+	int	i;
+	double	t;
+
+	t = WLZ_CLAMP(buf[idx], INT_MIN, INT_MAX);
+	i = (rnd)? WLZ_NINT(t): (int )t;
+	switch(gType)
+	{
+	  case WLZ_GREY_SHORT:
+	    buf[idx] = (short )i;
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    buf[idx] = (WlzUByte )i;
+	    break;
+	  default:
+	    buf[idx] = i;
+	    break;
+	}
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idx = 0; idx < n; ++idx)
+      {
+	buf[idx] = (float )(buf[idx]);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Loads grey values into a double buffer.
+* \param	buf			Destination buffer.
+* \param	gP			Source grey values.
+* \param	gType			Source grey type.
+* \param	n			Number of values.
+*/
+static void			WlzGreyPipeLoad(
+				  double *buf,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  int n)
+{
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      WlzValueKrnCopyIntToDouble(buf, gP.inp, n);
+      break;
+    case WLZ_GREY_SHORT:
+      WlzValueKrnCopyShortToDouble(buf, gP.shp, n);
+      break;
+    case WLZ_GREY_UBYTE:
+      WlzValueKrnCopyUByteToDouble(buf, gP.ubp, n);
+      break;
+    case WLZ_GREY_FLOAT:
+      WlzValueKrnCopyFloatToDouble(buf, gP.flp, n);
+      break;
+    case WLZ_GREY_DOUBLE:
+      (void )memcpy(buf, gP.dbp, sizeof(double) * n);
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzArithmetic
+* \brief	Stores a double buffer of values, which are already
+* 		representable in the destination grey type, as grey
+* 		values.
+* \param	gP			Destination grey values.
+* \param	gType			Destination grey type.
+* \param	buf			Source buffer.
+* \param	n			Number of values.
+*/
+static void			WlzGreyPipeStore(
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  double *buf,
+				  int n)
+{
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      WlzValueKrnClampDoubleToInt(gP.inp, buf, n);
+      break;
+    case WLZ_GREY_SHORT:
+      WlzValueKrnClampDoubleToShort(gP.shp, buf, n);
+      break;
+    case WLZ_GREY_UBYTE:
+      WlzValueKrnClampDoubleToUByte(gP.ubp, buf, n);
+      break;
+    case WLZ_GREY_FLOAT:
+      WlzValueKrnClampDoubleToFloat(gP.flp, buf, n);
+      break;
+    case WLZ_GREY_DOUBLE:
+      (void )memcpy(gP.dbp, buf, sizeof(double) * n);
+      break;
+    default:
+      break;
+  }
+}
@@ -43,10 +43,15 @@ static char _WlzGreySetValue_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 
 
+static WlzErrorNum		WlzGreySetValueScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+
 /*! 
 * \return       Woolz error code.
 * \ingroup      WlzValuesUtils
 * \brief        Set the grey value of every pixel/voxel to the given value.
+* 		The object is scanned in parallel using WlzScanPar().
 * \param    	obj				Input object.
 * \param    	val				New grey value.
 */
@@ -54,13 +59,6 @@ WlzErrorNum WlzGreySetValue(
   WlzObject	*obj,
   WlzPixelV	val)
 {
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  WlzGreyP		gptr;
-  WlzPixelV		tmpVal;
-  WlzDomain		*domains;
-  WlzValues		*values;
-  int			i, nplanes;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   /* check object */
@@ -96,56 +94,7 @@ WlzErrorNum WlzGreySetValue(
       else if( obj->values.core->type != WLZ_VOXELVALUETABLE_GREY ){
 	errNum = WLZ_ERR_VALUES_TYPE;
       }
-      else
-      {
-	/* Set range of each plane if non-empty - indicated by NULL */
-	domains = obj->domain.p->domains;
-	values = obj->values.vox->values;
-	nplanes = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-	for(i = 0; i < nplanes; ++i)
-	{
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    WlzDomain    *doms;
-	    WlzValues    *vals;
-	    WlzErrorNum  errNum2 = WLZ_ERR_NONE;
-
-	    doms = domains + i;
-	    vals = values + i;
-	    if(((*doms).core != NULL) && ((*vals).core != NULL))
-	    {
-	      WlzObject *obj2D;
-
-	      obj2D = WlzAssignObject(
-		      WlzMakeMain(WLZ_2D_DOMAINOBJ, *doms, *vals,
-			NULL, NULL, &errNum2), NULL);
-	      if(errNum2 == WLZ_ERR_NONE)
-	      {
-		errNum2 = WlzGreySetValue(obj2D, val);
-	      }
-	      (void )WlzFreeObj(obj2D);
-	      if(errNum2 != WLZ_ERR_NONE)
-	      {
-#ifdef _OPENMP
-#pragma omp critical (WlzGreySetValue)
-		{
-		  if(errNum == WLZ_ERR_NONE)
-		  {
-		    errNum = errNum2;
-		  }
-		}
-#else
-		errNum = errNum2;
-#endif
-	      }
-	    }
-	  }
-	}
-      }
-      return errNum;
+      break;
 
     case WLZ_TRANS_OBJ:
       return WlzGreySetValue(obj->values.obj, val);
@@ -160,53 +109,73 @@ WlzErrorNum WlzGreySetValue(
   }
 
   if( errNum == WLZ_ERR_NONE ){
-    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
+    errNum = WlzScanPar(obj, NULL, 0, 1, WlzGreySetValueScanFn, &val);
   }
-  if( errNum == WLZ_ERR_NONE ){
-    WlzValueConvertPixel(&tmpVal, val, gwsp.pixeltype);
-    while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
-
-      gptr = gwsp.u_grintptr;
-      switch (gwsp.pixeltype) {
-
-      case WLZ_GREY_INT:
-	for (i=0; i<iwsp.colrmn; i++, gptr.inp++)
-	  *gptr.inp = tmpVal.v.inv;
-	break;
-
-      case WLZ_GREY_SHORT:
-	for (i=0; i<iwsp.colrmn; i++, gptr.shp++)
-	  *gptr.shp = tmpVal.v.shv;
-	break;
-
-      case WLZ_GREY_UBYTE:
-	for (i=0; i<iwsp.colrmn; i++, gptr.ubp++)
-	  *gptr.ubp = tmpVal.v.ubv;
-	break;
-
-      case WLZ_GREY_FLOAT:
-	for (i=0; i<iwsp.colrmn; i++, gptr.flp++)
-	  *gptr.flp = tmpVal.v.flv;
-	break;
-
-      case WLZ_GREY_DOUBLE:
-	for (i=0; i<iwsp.colrmn; i++, gptr.dbp++)
-	  *gptr.dbp = tmpVal.v.dbv;
-	break;
-
-      case WLZ_GREY_RGBA:
-	for (i=0; i<iwsp.colrmn; i++, gptr.rgbp++)
-	  *gptr.rgbp = tmpVal.v.rgbv;
-	break;
-
-      default:
-	errNum = WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }
-    (void )WlzEndGreyScan(&iwsp, &gwsp);
-    if( errNum == WLZ_ERR_EOO ){
-      errNum = WLZ_ERR_NONE;
+
+  return errNum;
+}
+
+/*! 
+* \return       Woolz error code.
+* \ingroup      WlzValuesUtils
+* \brief        Parallel scan callback for WlzGreySetValue() which sets
+* 		the grey values of the current piece of the object.
+* \param    	pWSp				Parallel scan workspace.
+* \param    	data				Pointer to the new grey value.
+*/
+static WlzErrorNum WlzGreySetValueScanFn(
+  WlzScanParWSpace	*pWSp,
+  void			*data)
+{
+  WlzIntervalWSpace	*iwsp;
+  WlzGreyWSpace		*gwsp;
+  WlzGreyP		gptr;
+  WlzPixelV		tmpVal;
+  int			i;
+  WlzErrorNum		errNum=WLZ_ERR_NONE;
+
+  iwsp = &(pWSp->iWSp);
+  gwsp = &(pWSp->gWSp);
+  WlzValueConvertPixel(&tmpVal, *(WlzPixelV *)data, gwsp->pixeltype);
+  while( (errNum == WLZ_ERR_NONE) &&
+	 ((errNum = WlzNextGreyInterval(iwsp)) == WLZ_ERR_NONE) ){
+
+    gptr = gwsp->u_grintptr;
+    switch (gwsp->pixeltype) {
+
+    case WLZ_GREY_INT:
+      for (i=0; i<iwsp->colrmn; i++, gptr.inp++)
+	*gptr.inp = tmpVal.v.inv;
+      break;
+
+    case WLZ_GREY_SHORT:
+      for (i=0; i<iwsp->colrmn; i++, gptr.shp++)
+	*gptr.shp = tmpVal.v.shv;
+      break;
+
+    case WLZ_GREY_UBYTE:
+      for (i=0; i<iwsp->colrmn; i++, gptr.ubp++)
+	*gptr.ubp = tmpVal.v.ubv;
+      break;
+
+    case WLZ_GREY_FLOAT:
+      for (i=0; i<iwsp->colrmn; i++, gptr.flp++)
+	*gptr.flp = tmpVal.v.flv;
+      break;
+
+    case WLZ_GREY_DOUBLE:
+      for (i=0; i<iwsp->colrmn; i++, gptr.dbp++)
+	*gptr.dbp = tmpVal.v.dbv;
+      break;
+
+    case WLZ_GREY_RGBA:
+      for (i=0; i<iwsp->colrmn; i++, gptr.rgbp++)
+	*gptr.rgbp = tmpVal.v.rgbv;
+      break;
+
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
     }
   }
 
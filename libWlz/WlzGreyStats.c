@@ -44,6 +44,25 @@ static char _WlzGreyStats_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzGreyStatsAcc
+* \ingroup	WlzFeatures
+* \brief	Per chunk accumulator for simple quick statistics.
+*/
+typedef struct _WlzGreyStatsAcc
+{
+  int		area;
+  double	min;
+  double	max;
+  double	sum;
+  double	sumSq;
+  WlzGreyType	gType;
+} WlzGreyStatsAcc;
+
+static WlzErrorNum		WlzGreyStatsScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+
 /*!
 * \return	Number of bytes required to store a single grey value or zero
 * 		on error (invalid grey type).
@@ -91,123 +110,80 @@ size_t		WlzGreySize(WlzGreyType gType)
 }
 
 /*!
-* \return	Object area or -1 on error.
+* \return	Woolz error code.
 * \ingroup	WlzFeatures
-* \brief	Calculates simple quick statistics for the given
-*               2D domain object with grey values.
-* \param	srcObj			2D domain object from which to
-*                                       calculate the statistics.
-* \param	pln			Plane coordinate, may be zero if
-* 					the values are 2D and not a 3D
-* 					tiled object.
-* \param	dstGType		Pointer for grey type.
-* \param	dstMin			Pointer for minimum value.
-* \param	dstMax			Pointer for maximum value.
-* \param	dstSum			Pointer for sum of values.
-* \param	dstSumSq		Pointer for sum of squares of
-*                                       values.
-* \param	dstErr			Destination pointer for error, may
-*					be NULL.
+* \brief	Parallel scan callback which accumulates simple quick
+* 		statistics for the current piece of an object into
+* 		the accumulator of the current chunk.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Array of per chunk accumulators.
 */
-static int	WlzGreyStats2D(WlzObject *srcObj, int pln,
-			       WlzGreyType *dstGType,
-			       double *dstMin, double *dstMax,
-			       double *dstSum, double *dstSumSq,
-			       WlzErrorNum *dstErr)
+static WlzErrorNum WlzGreyStatsScanFn(WlzScanParWSpace *pWSp, void *data)
 {
-  WlzIntervalWSpace iWSp;
-  WlzGreyWSpace gWSp;
   WlzGreyP	gPix;
-  int		count,
-  		area = 0;
-  double	gVal = 0.0,
-  		min = 0.0,
-		max = 0.0,
-		sum = 0.0,
-		sumSq = 0.0;
+  int		count;
+  double	gVal = 0.0;
   WlzUInt	rgbVal;
-  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzGreyStatsAcc *acc;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-    
-  if((errNum = WlzInitGreyScan(srcObj, &iWSp, &gWSp)) == WLZ_ERR_NONE)
+
+  acc = (WlzGreyStatsAcc *)data + pWSp->chkIdx;
+  while((errNum == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(&(pWSp->iWSp))) == WLZ_ERR_NONE))
   {
-    if(gWSp.tvb)
-    {
-      iWSp.plnpos = pln;
-    }
-    while((WlzNextGreyInterval(&iWSp) == 0) && (errNum == WLZ_ERR_NONE))
+    gPix = pWSp->gWSp.u_grintptr;
+    acc->gType = pWSp->gWSp.pixeltype;
+    count = pWSp->iWSp.rgtpos - pWSp->iWSp.lftpos + 1;
+    while((errNum == WLZ_ERR_NONE) && (count-- > 0))
     {
-      gPix = gWSp.u_grintptr;
-      gType = gWSp.pixeltype;
-      count = iWSp.rgtpos - iWSp.lftpos + 1;
-      while(count-- > 0)
+      switch(acc->gType)
       {
-	switch(gType)
-	{
-	  case WLZ_GREY_INT:
-	    gVal = *(gPix.inp)++;
-	    break;
-	  case WLZ_GREY_SHORT:
-	    gVal = *(gPix.shp)++;
-	    break;
-	  case WLZ_GREY_UBYTE:
-	    gVal = *(gPix.ubp)++;
-	    break;
-	  case WLZ_GREY_FLOAT:
-	    gVal = *(gPix.flp)++;
-	    break;
-	  case WLZ_GREY_DOUBLE:
-	    gVal = *(gPix.dbp)++;
-	    break;
-	  case WLZ_GREY_RGBA: /* RGBA - make this the modulus
-			         For RGB stats call WlzRGBAGreyStats() */
-	    rgbVal = *(gPix.rgbp)++;
-	    gVal = WLZ_RGBA_MODULUS(rgbVal);
-	    break;
-	  default:
-	    errNum = WLZ_ERR_GREY_TYPE;
-	}
-	if(area == 0)
+	case WLZ_GREY_INT:
+	  gVal = *(gPix.inp)++;
+	  break;
+	case WLZ_GREY_SHORT:
+	  gVal = *(gPix.shp)++;
+	  break;
+	case WLZ_GREY_UBYTE:
+	  gVal = *(gPix.ubp)++;
+	  break;
+	case WLZ_GREY_FLOAT:
+	  gVal = *(gPix.flp)++;
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  gVal = *(gPix.dbp)++;
+	  break;
+	case WLZ_GREY_RGBA: /* RGBA - make this the modulus
+			       For RGB stats call WlzRGBAGreyStats() */
+	  rgbVal = *(gPix.rgbp)++;
+	  gVal = WLZ_RGBA_MODULUS(rgbVal);
+	  break;
+	default:
+	  errNum = WLZ_ERR_GREY_TYPE;
+	  break;
+      }
+      if(acc->area == 0)
+      {
+	acc->min = gVal;
+	acc->max = gVal;
+      }
+      else
+      {
+	if(gVal < acc->min)
 	{
-	  min = gVal;
-	  max = gVal;
+	  acc->min = gVal;
 	}
-	else
+	else if(gVal > acc->max)
 	{
-	  if(gVal < min)
-	  {
-	    min = gVal;
-	  }
-	  else if(gVal > max)
-	  {
-	    max = gVal;
-	  }
+	  acc->max = gVal;
 	}
-	sum += gVal;
-	sumSq += gVal * gVal;
-        ++area;
       }
+      acc->sum += gVal;
+      acc->sumSq += gVal * gVal;
+      ++(acc->area);
     }
-    (void )WlzEndGreyScan(&iWSp, &gWSp);
-    if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
-    {
-      errNum = WLZ_ERR_NONE;
-    }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-      *dstGType = gType;
-      *dstMin = min;
-      *dstMax = max;
-      *dstSum = sum;
-      *dstSumSq = sumSq;
-  }
-  else
-  {
-    area = -1;
   }
-  *dstErr = errNum;
-  return(area);
+  return(errNum);
 }
 
 /*!
@@ -238,19 +214,14 @@ int		WlzGreyStats(WlzObject *srcObj,
 			     double *dstMean, double *dstStdDev,
 			     WlzErrorNum *dstErr)
 {
-  int		area = 0,
-		pIdx,
-		pCnt,
-		tiled = 0;
-  double	min,
-		max,
+  int		area = 0;
+  double	min = 0.0,
+		max = 0.0,
   		mean = -1.0,
 		stdDev = -1.0,
 		sum = 0.0,
 		sumSq = 0.0;
-  WlzGreyType	gType;
-  WlzDomain	*dom;
-  WlzValues	*val = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
     
   WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
@@ -273,113 +244,55 @@ int		WlzGreyStats(WlzObject *srcObj,
   }
   else
   {
-    switch(srcObj->type)
+    int		nChk = 0;
+    WlzScanParChunk *chk = NULL;
+    WlzGreyStatsAcc *acc = NULL;
+
+    chk = WlzScanParChunks(srcObj, 0, &nChk, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      case WLZ_2D_DOMAINOBJ:
-        area = WlzGreyStats2D(srcObj, 0, &gType, &min, &max,
-			      &sum, &sumSq, &errNum);
-        break;
-      case WLZ_3D_DOMAINOBJ:
-	if(srcObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
-	{
-	  errNum = WLZ_ERR_DOMAIN_TYPE;
-	}
-	else if((dom = srcObj->domain.p->domains) == NULL)
-	{
-	  errNum = WLZ_ERR_DOMAIN_DATA;
-	}
-	else
+      if((acc = (WlzGreyStatsAcc *)
+                AlcCalloc(nChk, sizeof(WlzGreyStatsAcc))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzScanPar(srcObj, chk, nChk, 1, WlzGreyStatsScanFn, acc);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idx;
+
+      /* Combine the accumulators in chunk order so that the result
+       * does not depend on the thread scheduling. */
+      for(idx = 0; idx < nChk; ++idx)
+      {
+	WlzGreyStatsAcc *a;
+
+	a = acc + idx;
+	if(a->area > 0)
 	{
-	  if(WlzGreyTableIsTiled(srcObj->values.core->type))
+	  if(area == 0)
 	  {
-	    tiled = 1;
+	    min = a->min;
+	    max = a->max;
 	  }
 	  else
 	  {
-	    if(((val = srcObj->values.vox->values) == NULL))
-	    {
-	      errNum = WLZ_ERR_VALUES_DATA;
-	    }
+	    min = (min < a->min)? min: a->min;
+	    max = (max > a->max)? max: a->max;
 	  }
+	  gType = a->gType;
+	  area += a->area;
+	  sum += a->sum;
+	  sumSq += a->sumSq;
 	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  pCnt = srcObj->domain.p->lastpl - srcObj->domain.p->plane1 + 1;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-	  for(pIdx = 0; pIdx < pCnt; ++pIdx)
-	  {
-	    if((errNum == WLZ_ERR_NONE) && (dom[pIdx].core != NULL))
-	    {
-	      int	pln = 0,
-	      		area2D = 0;
-	      double	min2D,
-			max2D,
-			sum2D,
-			sumSq2D;
-	      WlzObject	*obj2D = NULL;
-	      WlzErrorNum errNum2 = WLZ_ERR_NONE;
-
-	      if(tiled)
-	      {
-	        pln = srcObj->domain.p->plane1 + pIdx;
-		obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom[pIdx],
-				    srcObj->values, NULL, NULL, &errNum2);
-	      }
-	      else
-	      {
-	        obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom[pIdx], val[pIdx],
-				    NULL, NULL, &errNum2);
-	      }
-	      if(errNum2 == WLZ_ERR_NONE)
-	      {
-		area2D = WlzGreyStats2D(obj2D, pln, &gType,
-					&min2D, &max2D, &sum2D, &sumSq2D,
-					&errNum2);
-	      }
-	      WlzFreeObj(obj2D);
-#ifdef _OPENMP
-#pragma omp critical (WlzGreyStats)
-	      {
-#endif
-		if(errNum2 == WLZ_ERR_NONE)
-		{
-		  if(area == 0)
-		  {
-		    min = min2D;
-		    max = max2D;
-		    area = area2D;
-		    sum = sum2D;
-		    sumSq = sumSq2D;
-		  }
-		  else
-		  {
-		    min = (min < min2D)? min: min2D;
-		    max = (max > max2D)? max: max2D;
-		    area += area2D;
-		    sum += sum2D;
-		    sumSq += sumSq2D;
-		  }
-		}
-		else
-		{
-		  if(errNum == WLZ_ERR_NONE)
-		  {
-		    errNum = errNum2;
-		  }
-		}
-#ifdef _OPENMP
-	      }
-#endif
-	    }
-	  }
-	}
-        break;
-      default:
-        errNum = WLZ_ERR_OBJECT_TYPE;
-	break;
+      }
     }
+    AlcFree(acc);
+    AlcFree(chk);
   }
   WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_2),
           ("WlzGreyStats 01 %d %d %g %g %g %g\n",
@@ -41,11 +41,34 @@ static char _WlzGreyValue_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include <Wlz.h>
 #ifndef WLZ_FAST_CODE
 #define WLZ_FAST_CODE
 #endif
+#if defined WLZ_FAST_CODE && defined __AVX2__
+#include <immintrin.h>
+#endif
+
+/*!
+* \def		WLZ_GREYVALUE_BATCH_SORTMIN
+* \ingroup	WlzAccess
+* \brief	Minimum number of positions for which the positions given
+* 		to WlzGreyValueGetBatch() are visited in storage order
+* 		rather than the given order.
+*/
+#define WLZ_GREYVALUE_BATCH_SORTMIN	(256)
+
+/*!
+* \def		WLZ_GREYVALUE_BATCH_SORTVOL
+* \ingroup	WlzAccess
+* \brief	Minimum bounding box volume (in voxels) of untiled values
+* 		for which the positions given to WlzGreyValueGetBatch()
+* 		are sorted. Below this the values are likely to be cache
+* 		resident and sorting costs more than it saves.
+*/
+#define WLZ_GREYVALUE_BATCH_SORTVOL	(1<<22)
 
 static void			WlzGreyValueSetBkdP(
 				  WlzGreyV *gVP,
@@ -74,12 +97,14 @@ static void			WlzGreyValueComputeGreyPTiled2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
 				  WlzTiledValues *tVal,
+				  WlzTileCacheEntry **tPin,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled3D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
 				  WlzTiledValues *tVal,
+				  WlzTileCacheEntry **tPin,
 				  int plane,
 				  int line,
 				  int kol);
@@ -116,6 +141,35 @@ static void			WlzGreyValueGetTransCon(
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueBatchGet(
+				  WlzGreyValueWSpace *gVWSp,
+				  int plane,
+				  int line,
+				  int kol);
+static void			WlzGreyValueBatchGetCon(
+				  WlzGreyValueWSpace *gVWSp,
+				  int plane,
+				  int line,
+				  int kol);
+static void			WlzGreyValueBatchValD(
+				  WlzGreyValueWSpace *gVWSp,
+				  int n,
+				  double *dst);
+static void			WlzGreyValueBatchCubicW(
+				  double t,
+				  double *w);
+static double			WlzGreyValueBatchDot4(
+				  const double *g,
+				  const double *w);
+static WlzLong			WlzGreyValueBatchKey(
+				  WlzIVertex3 org,
+				  WlzIVertex3 sz,
+				  int tw,
+				  WlzDVertex3 pos);
+static int			*WlzGreyValueBatchSort(
+				  int n,
+				  WlzLong *key,
+				  int *idx);
 /*!
 * \return	Grey value work space or NULL on error.
 * \ingroup	WlzAccess
@@ -452,6 +506,7 @@ void		WlzGreyValueFreeWSp(WlzGreyValueWSpace *gVWSp)
 	    gVWSp));
   if(gVWSp)
   {
+    WlzTileCacheUnpin(gVWSp->tPin, 8);
     (void )WlzFreeAffineTransform(gVWSp->invTrans);
     AlcFree((void *)(gVWSp->gTabTypes3D));
     AlcFree(gVWSp);
@@ -709,6 +764,353 @@ double		WlzGreyValueGetD(WlzGreyValueWSpace *gVWSp,
   return(val);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Gets interpolated grey values for a batch of positions
+* 		from the object with which the given work space was
+* 		initialised. Apart from the rounding of positions given
+* 		below, this is equivalent to calling WlzGreyValueGetD()
+* 		(nearest neighbour) or WlzGreyValueGetCon() (linear and
+* 		cubic) for each position and interpolating, but the
+* 		access method is chosen once for the batch and, for
+* 		large batches of positions in tiled or large values, the
+* 		positions are visited in the order in which the values
+* 		are stored (tile by tile for tiled values) rather than
+* 		the given order. Neighbouring values which are outside
+* 		of the object's domain take the background value.
+*
+* 		Nearest neighbour positions are rounded as by
+* 		WlzGreyValueGet(), linear and cubic interpolation use the
+* 		floor of the positions, both for the neighbouring values
+* 		and for the weights. This differs from WlzGreyValueGetCon()
+* 		which truncates the positions towards zero, so for
+* 		non-integer negative coordinates its neighbouring values
+* 		start one greater than those used here. Cubic
+* 		interpolation is by Catmull-Rom cubic convolution using
+* 		4x4 (2D) or 4x4x4 (3D) neighbouring values. Only nearest
+* 		neighbour interpolation is allowed for RGBA values, in
+* 		which case the packed value is returned.
+* 		If the work space's object has a transform then the
+* 		positions are transformed and interpolation is done in the
+* 		object's own coordinates.
+* \param	gVWSp			Grey value work space.
+* \param	interp			Interpolation method, which must be
+* 					WLZ_INTERPOLATION_NEAREST,
+* 					WLZ_INTERPOLATION_LINEAR or
+* 					WLZ_INTERPOLATION_CUBIC.
+* \param	vType			Vertex type of the positions which
+* 					must be WLZ_VERTEX_D2 for 2D objects
+* 					or WLZ_VERTEX_D3 for 3D objects.
+* \param	nPos			Number of positions.
+* \param	pos			Array of positions.
+* \param	dst			Destination array for the nPos
+* 					values.
+*/
+WlzErrorNum	WlzGreyValueGetBatch(WlzGreyValueWSpace *gVWSp,
+				     WlzInterpolationType interp,
+				     WlzVertexType vType, int nPos,
+				     WlzVertexP pos, double *dst)
+{
+  int		idP,
+  		srt = 0,
+  		tw = 0;
+  int		*idx = NULL,
+  		*ord = NULL;
+  WlzLong	*key = NULL;
+  WlzDVertex3	*tPos = NULL;
+  WlzIVertex3	org,
+  		sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(nPos < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nPos > 0) && ((pos.v == NULL) || (dst == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((gVWSp->objType == WLZ_2D_DOMAINOBJ) &&
+           (vType != WLZ_VERTEX_D2)) ||
+          ((gVWSp->objType == WLZ_3D_DOMAINOBJ) &&
+	   (vType != WLZ_VERTEX_D3)))
+  {
+    errNum = WLZ_ERR_PARAM_TYPE;
+  }
+  else
+  {
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST:
+        break;
+      case WLZ_INTERPOLATION_LINEAR: /* FALLTHROUGH */
+      case WLZ_INTERPOLATION_CUBIC:
+	if(gVWSp->gType == WLZ_GREY_RGBA)
+	{
+	  errNum = WLZ_ERR_GREY_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	break;
+    }
+  }
+  /* Decide whether to sort the positions. Sorting only pays where
+   * values are tiled or where there are several accesses per position
+   * into values which are unlikely to be cache resident. */
+  if((errNum == WLZ_ERR_NONE) && (nPos >= WLZ_GREYVALUE_BATCH_SORTMIN))
+  {
+    if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+    {
+      WlzIntervalDomain *iDom;
+
+      iDom = gVWSp->domain.i;
+      WLZ_VTX_3_SET(org, iDom->kol1, iDom->line1, 0);
+      WLZ_VTX_3_SET(sz, iDom->lastkl - iDom->kol1 + 1,
+                    iDom->lastln - iDom->line1 + 1, 1);
+    }
+    else
+    {
+      WlzPlaneDomain *pDom;
+
+      pDom = gVWSp->domain.p;
+      WLZ_VTX_3_SET(org, pDom->kol1, pDom->line1, pDom->plane1);
+      WLZ_VTX_3_SET(sz, pDom->lastkl - pDom->kol1 + 1,
+                    pDom->lastln - pDom->line1 + 1,
+		    pDom->lastpl - pDom->plane1 + 1);
+    }
+    if(gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+    {
+      tw = gVWSp->values.t->tileWidth;
+      srt = 1;
+    }
+    else
+    {
+      srt = (interp != WLZ_INTERPOLATION_NEAREST) &&
+            ((double )(sz.vtX) * sz.vtY * sz.vtZ >=
+	     WLZ_GREYVALUE_BATCH_SORTVOL);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nPos > 0))
+  {
+    if((tPos = (WlzDVertex3 *)
+               AlcMalloc(nPos * sizeof(WlzDVertex3))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(srt)
+    {
+      /* Twice the number of indices and keys for sorting. */
+      if(((idx = (int *)AlcMalloc(2 * nPos * sizeof(int))) == NULL) ||
+         ((key = (WlzLong *)AlcMalloc(2 * nPos * sizeof(WlzLong))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  /* Gather the positions, transformed if required, as 3D positions in
+   * the object's coordinates. */
+  if((errNum == WLZ_ERR_NONE) && (nPos > 0))
+  {
+    if(vType == WLZ_VERTEX_D2)
+    {
+      for(idP = 0; idP < nPos; ++idP)
+      {
+	WlzDVertex2 p;
+
+	p = pos.d2[idP];
+	if(gVWSp->invTrans)
+	{
+	  p = WlzAffineTransformVertexD2(gVWSp->invTrans, p, NULL);
+	}
+	tPos[idP].vtX = p.vtX;
+	tPos[idP].vtY = p.vtY;
+	tPos[idP].vtZ = 0.0;
+      }
+    }
+    else
+    {
+      for(idP = 0; idP < nPos; ++idP)
+      {
+	tPos[idP] = pos.d3[idP];
+	if(gVWSp->invTrans)
+	{
+	  tPos[idP] = WlzAffineTransformVertexD3(gVWSp->invTrans, tPos[idP],
+	                                         NULL);
+	}
+      }
+    }
+  }
+  /* Sort the positions into storage order. */
+  if((errNum == WLZ_ERR_NONE) && (idx != NULL))
+  {
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      idx[idP] = idP;
+      key[idP] = WlzGreyValueBatchKey(org, sz, tw, tPos[idP]);
+    }
+    ord = WlzGreyValueBatchSort(nPos, key, idx);
+  }
+  if((errNum == WLZ_ERR_NONE) && (nPos > 0))
+  {
+    int		dim;
+
+    dim = (gVWSp->objType == WLZ_2D_DOMAINOBJ)? 2: 3;
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST:
+	for(idP = 0; idP < nPos; ++idP)
+	{
+	  int		id;
+	  WlzDVertex3	p;
+
+	  id = (ord)? ord[idP]: idP;
+	  p = tPos[id];
+	  WlzGreyValueBatchGet(gVWSp, WLZ_NINT(p.vtZ), WLZ_NINT(p.vtY),
+	                       WLZ_NINT(p.vtX));
+	  WlzGreyValueBatchValD(gVWSp, 1, dst + id);
+	}
+        break;
+      case WLZ_INTERPOLATION_LINEAR:
+	for(idP = 0; idP < nPos; ++idP)
+	{
+	  int		id;
+	  double	g[8],
+	  		w[8];
+	  WlzIVertex3	i;
+	  WlzDVertex3	f0,
+	  		f1,
+			p;
+
+	  id = (ord)? ord[idP]: idP;
+	  p = tPos[id];
+	  i.vtX = (int )floor(p.vtX);
+	  i.vtY = (int )floor(p.vtY);
+	  i.vtZ = (int )floor(p.vtZ);
+	  f0.vtX = p.vtX - i.vtX;
+	  f0.vtY = p.vtY - i.vtY;
+	  f1.vtX = 1.0 - f0.vtX;
+	  f1.vtY = 1.0 - f0.vtY;
+	  w[0] = f1.vtX * f1.vtY;
+	  w[1] = f0.vtX * f1.vtY;
+	  w[2] = f1.vtX * f0.vtY;
+	  w[3] = f0.vtX * f0.vtY;
+	  WlzGreyValueBatchGetCon(gVWSp, i.vtZ, i.vtY, i.vtX);
+	  if(dim == 2)
+	  {
+	    WlzGreyValueBatchValD(gVWSp, 4, g);
+	    dst[id] = WlzGreyValueBatchDot4(g, w);
+	  }
+	  else
+	  {
+	    int		idW;
+
+	    f0.vtZ = p.vtZ - i.vtZ;
+	    f1.vtZ = 1.0 - f0.vtZ;
+	    for(idW = 0; idW < 4; ++idW)
+	    {
+	      w[idW + 4] = w[idW] * f0.vtZ;
+	      w[idW] *= f1.vtZ;
+	    }
+	    WlzGreyValueBatchValD(gVWSp, 8, g);
+	    dst[id] = WlzGreyValueBatchDot4(g, w) +
+	              WlzGreyValueBatchDot4(g + 4, w + 4);
+	  }
+	}
+        break;
+      case WLZ_INTERPOLATION_CUBIC:
+	for(idP = 0; idP < nPos; ++idP)
+	{
+	  int		id,
+	  		idA,
+			idB,
+			idC,
+			idN,
+	  		nP;
+	  double	c[8],
+	  		r[16],
+			s[4];
+	  double	g[64],
+	  		wX[4],
+			wY[4],
+			wZ[4];
+	  WlzIVertex3	i;
+	  WlzDVertex3	p;
+
+	  id = (ord)? ord[idP]: idP;
+	  p = tPos[id];
+	  i.vtX = (int )floor(p.vtX);
+	  i.vtY = (int )floor(p.vtY);
+	  i.vtZ = (int )floor(p.vtZ);
+	  WlzGreyValueBatchCubicW(p.vtX - i.vtX, wX);
+	  WlzGreyValueBatchCubicW(p.vtY - i.vtY, wY);
+	  /* Gather the 4x4(x4) neighbourhood as 2x2(x2) blocks of four
+	   * (eight) connected values, with g indexed by plane, line and
+	   * then column. */
+	  nP = (dim == 2)? 1: 2;
+	  for(idA = 0; idA < nP; ++idA)
+	  {
+	    for(idB = 0; idB < 2; ++idB)
+	    {
+	      for(idC = 0; idC < 2; ++idC)
+	      {
+		WlzGreyValueBatchGetCon(gVWSp, i.vtZ - 1 + (2 * idA),
+					i.vtY - 1 + (2 * idB),
+					i.vtX - 1 + (2 * idC));
+		WlzGreyValueBatchValD(gVWSp, 4 * dim - 4, c);
+		for(idN = 0; idN < 4 * dim - 4; ++idN)
+		{
+		  int	pn,
+		  	ln,
+			kl;
+
+		  kl = (2 * idC) + (idN & 1);
+		  ln = (2 * idB) + ((idN >> 1) & 1);
+		  pn = (2 * idA) + (idN >> 2);
+		  g[(((pn << 2) + ln) << 2) + kl] = c[idN];
+		}
+	      }
+	    }
+	  }
+	  if(dim == 2)
+	  {
+	    for(idN = 0; idN < 4; ++idN)
+	    {
+	      r[idN] = WlzGreyValueBatchDot4(g + (idN << 2), wX);
+	    }
+	    dst[id] = WlzGreyValueBatchDot4(r, wY);
+	  }
+	  else
+	  {
+	    WlzGreyValueBatchCubicW(p.vtZ - i.vtZ, wZ);
+	    for(idA = 0; idA < 4; ++idA)
+	    {
+	      for(idB = 0; idB < 4; ++idB)
+	      {
+		idN = (idA << 2) + idB;
+		r[idN] = WlzGreyValueBatchDot4(g + (idN << 2), wX);
+	      }
+	      s[idA] = WlzGreyValueBatchDot4(r + (idA << 2), wY);
+	    }
+	    dst[id] = WlzGreyValueBatchDot4(s, wZ);
+	  }
+	}
+        break;
+      default:
+        break;
+    }
+  }
+  AlcFree(tPos);
+  AlcFree(idx);
+  AlcFree(key);
+  return(errNum);
+}
+
 /*! 
 * \ingroup      WlzValuesUtils
 * \brief        Gets a single grey value/pointer for the given point
@@ -1022,7 +1424,7 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
       break;
     case WLZ_GREY_TAB_TILED:
       WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp->values.t,
-                                      line, kol);
+                                      gVWSp->tPin, line, kol);
       break;
     default:
       break;
@@ -1034,17 +1436,21 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 * \ingroup	WlzAccess
 * \brief	Knowing that the given point is within the value table
 *               computes the base pointer and offset for the point
-*               for a 2D tiled value table.
+*               for a 2D tiled value table. If the tiles are loaded
+*               through a tile cache then the base pointer is that
+*               of the pinned tile.
 * \param	baseGVP			Destination pointer for the
 *                                       base pointer.
 * \param	offset			Destination pointer for the
 *                                       offset from base pointer.
-* \param	gVWSp			Grey value work space.
+* \param	tVal			Tiled values.
+* \param	tPin			Tiles pinned by the work space.
 * \param	line			Line coordinate of point.
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 				size_t *offset, WlzTiledValues *tVal,
+				WlzTileCacheEntry **tPin,
 				int line, int kol)
 {
   WlzIVertex2 	rPos,
@@ -1084,8 +1490,16 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 	tOff.vtX = rPos.vtX % tVal->tileWidth;
 	tOff.vtY = rPos.vtY % tVal->tileWidth;
 	off = (tOff.vtY * tVal->tileWidth) + tOff.vtX;
-	(*baseGVP).v = tVal->tiles.v;
-	*offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	if(tVal->cache)
+	{
+	  *baseGVP = WlzTileCachePin(tVal, tPin, 8, idx);
+	  *offset = off * tVal->vpe;
+	}
+	else
+	{
+	  (*baseGVP).v = tVal->tiles.v;
+	  *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	}
       }
     }
   }
@@ -1096,18 +1510,22 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 * \ingroup	WlzAccess
 * \brief	Knowing that the given point is within the value table
 *               computes the base pointer and offset for the point
-*               for a 3D tiled value table.
+*               for a 3D tiled value table. If the tiles are loaded
+*               through a tile cache then the base pointer is that
+*               of the pinned tile.
 * \param	baseGVP			Destination pointer for the
 *                                       base pointer.
 * \param	offset			Destination pointer for the
 *                                       offset from base pointer.
-* \param	gVWSp			Grey value work space.
+* \param	tVal			Tiled values.
+* \param	tPin			Tiles pinned by the work space.
 * \param	plane			Plane coordinate of point.
 * \param	line			Line coordinate of point.
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 				size_t *offset, WlzTiledValues *tVal,
+				WlzTileCacheEntry **tPin,
 				int plane, int line, int kol)
 {
   WlzIVertex3 	rPos,
@@ -1158,8 +1576,16 @@ static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 	  tOff.vtZ = rPos.vtZ % tVal->tileWidth;
 	  off = ((tOff.vtZ * tVal->tileWidth + tOff.vtY) * tVal->tileWidth) +
 	        tOff.vtX;
-	  (*baseGVP).v = tVal->tiles.v;
-	  *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	  if(tVal->cache)
+	  {
+	    *baseGVP = WlzTileCachePin(tVal, tPin, 8, idx);
+	    *offset = off * tVal->vpe;
+	  }
+	  else
+	  {
+	    (*baseGVP).v = tVal->tiles.v;
+	    *offset = ((idx * tVal->tileSz) + off) * tVal->vpe;
+	  }
 	}
       }
     }
@@ -1332,7 +1758,7 @@ static void	WlzGreyValueGet3DTiled(WlzGreyValueWSpace *gVWSp,
 	    WlzGreyP 	baseGVP;
 
 	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset,
-					    gVWSp->values.t,
+					    gVWSp->values.t, gVWSp->tPin,
 					    plane, line, kol);
 	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 				 baseGVP, offset);
@@ -1529,16 +1955,23 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 		pln,
   		planeOff,
 		planeRel,
-		savePlane = 0;
+		savePlane,
+		planeSwitched = 0;
   WlzDomain	*domP;
   WlzValues	*valP;
-  WlzObjectType	saveGTabType2D = WLZ_NULL;
-  WlzIntervalDomain *saveIDom2D = NULL;
+  WlzObjectType	saveGTabType2D;
+  WlzIntervalDomain *saveIDom2D;
   WlzValues	saveValues2D;
   int		planeSet[2];
   WlzGreyP	saveGPtr[4];
   WlzGreyV	saveGVal[4];
 
+  /* Save the work space's current plane so that it can be restored if
+   * either of the planes needs a switch. */
+  savePlane = gVWSp->plane;
+  saveIDom2D = gVWSp->iDom2D;
+  saveValues2D = gVWSp->values2D;
+  saveGTabType2D = gVWSp->gTabType2D;
   for(planeOff = 0; planeOff < 2; ++planeOff)
   {
     pln = plane + planeOff;
@@ -1548,7 +1981,7 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
     if((unsigned int )planeRel <=
        (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
 #else
-    if((pln > gVWSp->domain.p->plane1) && (pln < gVWSp->domain.p->lastpl))
+    if((pln >= gVWSp->domain.p->plane1) && (pln <= gVWSp->domain.p->lastpl))
 #endif
     {
       if(pln == gVWSp->plane)
@@ -1562,13 +1995,7 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 	valP = gVWSp->values.vox->values + planeRel;
 	if((*domP).core && (*valP).core)
 	{
-          if(planeSet[0])
-	  {
-	    savePlane = gVWSp->plane;
-	    saveIDom2D = gVWSp->iDom2D;
-	    saveValues2D = gVWSp->values2D;
-	    saveGTabType2D = gVWSp->gTabType2D;
-	  }
+	  planeSwitched = 1;
 	  gVWSp->plane = pln;
 	  gVWSp->iDom2D = (*domP).i;
 	  gVWSp->values2D = (*valP);
@@ -1600,12 +2027,15 @@ static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
     WlzGreyValueSetBkdPN(&(gVWSp->gVal[4]), &(gVWSp->gPtr[4]),
                          gVWSp->gType, gVWSp->gBkd, 4);
   }
-  if(planeSet[0])
+  if(planeSwitched)
   {
     gVWSp->plane = savePlane;
     gVWSp->iDom2D = saveIDom2D;
     gVWSp->values2D = saveValues2D;
     gVWSp->gTabType2D = saveGTabType2D;
+  }
+  if(planeSet[0])
+  {
     for(tI0 = 0; tI0 < 4; ++tI0)
     {
       gVWSp->gPtr[tI0] = saveGPtr[tI0];
@@ -1710,6 +2140,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 		    valMsk |= ((klRel >= itv->ileft) |
 		               ((klRel < itv->iright) << 1)) << idV;
 		  }
+		  ++itv;
 		}
 	      }
 	    }
@@ -1731,6 +2162,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
     		tIdx,
 		tOff;
     size_t 	offset;
+    WlzGreyP	tiles;
     WlzTiledValues *tVal;
 
     idV = 0;
@@ -1757,10 +2189,31 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
             rPos.vtX = kol - tVal->kol1 + idK;
 	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
             tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
-            offset = (*(tVal->indices + tIdx.vtX) * tVal->tileSz +
-	              tOff.vtX) * tVal->vpe;
-	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
-	                         gVWSp->gType, tVal->tiles, offset);
+	    if(tVal->cache)
+	    {
+	      /* All eight tiles remain pinned since the work space has
+	       * eight pins. */
+	      tiles = WlzTileCachePin(tVal, gVWSp->tPin, 8,
+	                              *(tVal->indices + tIdx.vtX));
+	      offset = tOff.vtX * tVal->vpe;
+	    }
+	    else
+	    {
+	      tiles = tVal->tiles;
+	      offset = (*(tVal->indices + tIdx.vtX) * tVal->tileSz +
+			tOff.vtX) * tVal->vpe;
+	    }
+	    if(tiles.v == NULL)
+	    {
+	      valMsk &= ~(1 << idV);
+	      WlzGreyValueSetBkdPN(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, gVWSp->gBkd, 1);
+	    }
+	    else
+	    {
+	      WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, tiles, offset);
+	    }
 	  }
 	  ++idV;
 	}
@@ -1854,3 +2307,281 @@ static void	WlzGreyValueGetTransCon(WlzGreyValueWSpace *gVWSp,
       break;
   }
 }
+
+/*!
+* \ingroup	WlzAccess
+* \brief	Gets a single grey value for WlzGreyValueGetBatch()
+* 		using the access function for the work space's object.
+* \param	gVWSp			Grey value work space.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+*/
+static void	WlzGreyValueBatchGet(WlzGreyValueWSpace *gVWSp,
+				     int plane, int line, int kol)
+{
+  if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    WlzGreyValueGet2D1(gVWSp, line, kol);
+  }
+  else if(gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+  {
+    WlzGreyValueGet3DTiled(gVWSp, plane, line, kol);
+  }
+  else
+  {
+    WlzGreyValueGet3D1(gVWSp, plane, line, kol);
+  }
+}
+
+/*!
+* \ingroup	WlzAccess
+* \brief	Gets the four or eight connected grey values for
+* 		WlzGreyValueGetBatch() using the access function for
+* 		the work space's object.
+* \param	gVWSp			Grey value work space.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+*/
+static void	WlzGreyValueBatchGetCon(WlzGreyValueWSpace *gVWSp,
+				        int plane, int line, int kol)
+{
+  if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    WlzGreyValueGet2DCon(gVWSp, line, kol);
+  }
+  else if(gVWSp->gTabType == (WlzObjectType )WLZ_GREY_TAB_TILED)
+  {
+    WlzGreyValueGet3DConTiled(gVWSp, plane, line, kol);
+  }
+  else
+  {
+    WlzGreyValueGet3DCon(gVWSp, plane, line, kol);
+  }
+}
+
+/*!
+* \ingroup	WlzAccess
+* \brief	Copies the first n grey values of the work space to the
+* 		given array of doubles.
+* \param	gVWSp			Grey value work space.
+* \param	n			Number of values.
+* \param	dst			Destination array.
+*/
+static void	WlzGreyValueBatchValD(WlzGreyValueWSpace *gVWSp,
+				      int n, double *dst)
+{
+  int		idN;
+
+  switch(gVWSp->gType)
+  {
+    case WLZ_GREY_LONG:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].lnv;
+      }
+      break;
+    case WLZ_GREY_INT:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].inv;
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].shv;
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].ubv;
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].flv;
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].dbv;
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = gVWSp->gVal[idN].rgbv;
+      }
+      break;
+    default:
+      for(idN = 0; idN < n; ++idN)
+      {
+	dst[idN] = 0.0;
+      }
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzAccess
+* \brief	Computes the four Catmull-Rom cubic convolution weights
+* 		for the given fractional offset.
+* \param	t			Offset from the second of the four
+* 					values, in the range [0,1).
+* \param	w			Destination array for the weights.
+*/
+static void	WlzGreyValueBatchCubicW(double t, double *w)
+{
+  w[0] = ((-0.5 * t + 1.0) * t - 0.5) * t;
+  w[1] = (1.5 * t - 2.5) * t * t + 1.0;
+  w[2] = ((-1.5 * t + 2.0) * t + 0.5) * t;
+  w[3] = (0.5 * t - 0.5) * t * t;
+}
+
+/*!
+* \return	Dot product.
+* \ingroup	WlzAccess
+* \brief	Computes the dot product of two arrays of four doubles,
+* 		using AVX2 when available.
+* \param	g			First array.
+* \param	w			Second array.
+*/
+static double	WlzGreyValueBatchDot4(const double *g, const double *w)
+{
+  double	d;
+#if defined WLZ_FAST_CODE && defined __AVX2__
+  __m256d	s;
+  __m128d	s0,
+  		s1;
+
+  s = _mm256_mul_pd(_mm256_loadu_pd(g), _mm256_loadu_pd(w));
+  s0 = _mm256_castpd256_pd128(s);
+  s1 = _mm256_extractf128_pd(s, 1);
+  s0 = _mm_add_pd(s0, s1);
+  s0 = _mm_add_sd(s0, _mm_unpackhi_pd(s0, s0));
+  d = _mm_cvtsd_f64(s0);
+#else
+  d = (g[0] * w[0]) + (g[1] * w[1]) + (g[2] * w[2]) + (g[3] * w[3]);
+#endif
+  return(d);
+}
+
+/*!
+* \return	Sort key.
+* \ingroup	WlzAccess
+* \brief	Computes a key for the given position which orders
+* 		positions by storage order, ie by plane, line and then
+* 		column or, for tiled values, by tile and then by plane,
+* 		line and column within the tile. Positions outside of
+* 		the given bounding box are clamped to just outside it.
+* \param	org			Origin of the bounding box.
+* \param	sz			Size of the bounding box.
+* \param	tw			Tile width or zero if the values
+* 					are not tiled.
+* \param	pos			Given position.
+*/
+static WlzLong	WlzGreyValueBatchKey(WlzIVertex3 org, WlzIVertex3 sz,
+				     int tw, WlzDVertex3 pos)
+{
+  WlzLong	key;
+  WlzIVertex3	i,
+  		n;
+
+  i.vtX = WLZ_CLAMP((int )floor(pos.vtX) - org.vtX, -1, sz.vtX) + 1;
+  i.vtY = WLZ_CLAMP((int )floor(pos.vtY) - org.vtY, -1, sz.vtY) + 1;
+  i.vtZ = WLZ_CLAMP((int )floor(pos.vtZ) - org.vtZ, -1, sz.vtZ) + 1;
+  n.vtX = sz.vtX + 2;
+  n.vtY = sz.vtY + 2;
+  if(tw > 0)
+  {
+    WlzLong	t;
+
+    n.vtX = (n.vtX + tw - 1) / tw;
+    n.vtY = (n.vtY + tw - 1) / tw;
+    t = ((WlzLong )(i.vtZ / tw) * n.vtY + (i.vtY / tw)) * n.vtX +
+        (i.vtX / tw);
+    key = ((t * tw + (i.vtZ % tw)) * tw + (i.vtY % tw)) * tw + (i.vtX % tw);
+  }
+  else
+  {
+    key = ((WlzLong )(i.vtZ) * n.vtY + i.vtY) * n.vtX + i.vtX;
+  }
+  return(key);
+}
+
+/*!
+* \return	Sorted indices, which are either the given indices or the
+* 		second half of the given index array.
+* \ingroup	WlzAccess
+* \brief	Sorts indices by their keys, as computed by
+* 		WlzGreyValueBatchKey(), using a least significant digit
+* 		radix sort.
+* \param	n			Number of keys.
+* \param	key			Array of 2n keys, the first n of
+* 					which are the keys to sort with the
+* 					rest used as workspace.
+* \param	idx			Array of 2n indices, with the first
+* 					n being the indices of the keys and
+* 					the rest used as workspace.
+*/
+static int	*WlzGreyValueBatchSort(int n, WlzLong *key, int *idx)
+{
+  int		idN,
+  		sft;
+  WlzLong	maxKey = 0;
+  int		*idx0,
+  		*idx1;
+  WlzLong	*key0,
+  		*key1;
+  int		cnt[2048];
+
+  idx0 = idx;
+  idx1 = idx + n;
+  key0 = key;
+  key1 = key + n;
+  for(idN = 0; idN < n; ++idN)
+  {
+    maxKey = ALG_MAX(maxKey, key[idN]);
+  }
+  for(sft = 0; (maxKey >> sft) > 0; sft += 11)
+  {
+    int		idC,
+    		sum = 0;
+    int		*tI;
+    WlzLong	*tK;
+
+    (void )memset(cnt, 0, 2048 * sizeof(int));
+    for(idN = 0; idN < n; ++idN)
+    {
+      ++cnt[(key0[idN] >> sft) & 2047];
+    }
+    for(idC = 0; idC < 2048; ++idC)
+    {
+      int	c;
+
+      c = cnt[idC];
+      cnt[idC] = sum;
+      sum += c;
+    }
+    for(idN = 0; idN < n; ++idN)
+    {
+      int	d;
+
+      d = cnt[(key0[idN] >> sft) & 2047]++;
+      key1[d] = key0[idN];
+      idx1[d] = idx0[idN];
+    }
+    tI = idx0;
+    idx0 = idx1;
+    idx1 = tI;
+    tK = key0;
+    key0 = key1;
+    key1 = tK;
+  }
+  return(idx0);
+}
@@ -0,0 +1,568 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzIdxMesh_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzIdxMesh.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Functions for compact indexed meshes, which are flat
+* 		arrays of vertex positions and element vertex indices
+* 		without any topology.
+* \ingroup	WlzMesh
+*/
+
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \return	New indexed mesh or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Creates a new indexed mesh with space allocated for
+* 		the given number of vertices and elements. The mesh
+* 		can be freed using WlzFreeIdxMesh().
+* \param	type		Type of mesh, which must be either
+* 				WLZ_IDXMESH_TRI3D or WLZ_IDXMESH_TET3D.
+* \param	maxVtx		Number of vertices to allocate space for.
+* \param	maxElm		Number of elements to allocate space for.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzIdxMesh			*WlzMakeIdxMesh(
+				  WlzObjectType type,
+				  int maxVtx,
+				  int maxElm,
+				  WlzErrorNum *dstErr)
+{
+  int		nElmVtx = 0;
+  WlzIdxMesh	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(type)
+  {
+    case WLZ_IDXMESH_TRI3D:
+      nElmVtx = 3;
+      break;
+    case WLZ_IDXMESH_TET3D:
+      nElmVtx = 4;
+      break;
+    default:
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+      break;
+  }
+  if((errNum == WLZ_ERR_NONE) && ((maxVtx < 0) || (maxElm < 0)))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((mesh = (WlzIdxMesh *)AlcCalloc(1, sizeof(WlzIdxMesh))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      mesh->type = type;
+      mesh->nElmVtx = nElmVtx;
+      errNum = WlzIdxMeshReserve(mesh, maxVtx, maxElm);
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzFreeIdxMesh(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Frees an indexed mesh.
+* \param	mesh		Given indexed mesh.
+*/
+WlzErrorNum			WlzFreeIdxMesh(
+				  WlzIdxMesh *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh)
+  {
+    if(WlzUnlink(&(mesh->linkcount), &errNum))
+    {
+      AlcFree(mesh->vtx);
+      AlcFree(mesh->elm);
+      AlcFree(mesh);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Makes sure that the given indexed mesh has space for at
+* 		least the given numbers of vertices and elements. The
+* 		mesh's arrays are only ever grown, existing vertices and
+* 		elements are preserved.
+* \param	mesh		Given indexed mesh.
+* \param	maxVtx		Required number of vertices.
+* \param	maxElm		Required number of elements.
+*/
+WlzErrorNum			WlzIdxMeshReserve(
+				  WlzIdxMesh *mesh,
+				  int maxVtx,
+				  int maxElm)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((maxVtx < 0) || (maxElm < 0))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if((errNum == WLZ_ERR_NONE) && (maxVtx > mesh->maxVtx))
+  {
+    double	*vtx;
+
+    if((vtx = (double *)AlcRealloc(mesh->vtx,
+                                   sizeof(double) * 3 * maxVtx)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      mesh->vtx = vtx;
+      mesh->maxVtx = maxVtx;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (maxElm > mesh->maxElm))
+  {
+    int		*elm;
+
+    if((elm = (int *)AlcRealloc(mesh->elm,
+                                sizeof(int) * mesh->nElmVtx * maxElm)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      mesh->elm = elm;
+      mesh->maxElm = maxElm;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New geometric model or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Creates a new 3D geometric model from the given triangular
+* 		indexed mesh. The faces of the model are constructed in
+* 		the order of the mesh elements and preserve their vertex
+* 		ordering.
+* \param	mesh		Given indexed mesh which must be of type
+* 				WLZ_IDXMESH_TRI3D.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzGMModel			*WlzIdxMeshToGMModel(
+				  WlzIdxMesh *mesh,
+				  WlzErrorNum *dstErr)
+{
+  WlzGMModel	*model = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_IDXMESH_TRI3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    /* Size the vertex matching hash table using the number of vertices. */
+    model = WlzGMModelNew(WLZ_GMMOD_3D, 0,
+                          WLZ_MAX(mesh->nVtx, 1024), &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE;
+
+    for(idE = 0; idE < mesh->nElm; ++idE)
+    {
+      int	idV;
+      WlzDVertex3 pos[3];
+
+      for(idV = 0; idV < 3; ++idV)
+      {
+        double	*v;
+
+	v = mesh->vtx + 3 * mesh->elm[3 * idE + idV];
+	pos[idV].vtX = v[0];
+	pos[idV].vtY = v[1];
+	pos[idV].vtZ = v[2];
+      }
+      if((errNum = WlzGMModelConstructSimplex3D(model,
+                                                pos)) != WLZ_ERR_NONE)
+      {
+        break;
+      }
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (model != NULL))
+  {
+    (void )WlzGMModelFree(model);
+    model = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(model);
+}
+
+/*!
+* \return	New indexed mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Creates a copy of the given indexed mesh. Only the used
+* 		vertices and elements are allocated in the copy.
+* \param	mesh		Given indexed mesh.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzIdxMesh			*WlzIdxMeshCopy(
+				  WlzIdxMesh *mesh,
+				  WlzErrorNum *dstErr)
+{
+  WlzIdxMesh	*newMesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    newMesh = WlzMakeIdxMesh(mesh->type, mesh->nVtx, mesh->nElm, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    newMesh->nVtx = mesh->nVtx;
+    newMesh->nElm = mesh->nElm;
+    if(mesh->nVtx > 0)
+    {
+      (void )memcpy(newMesh->vtx, mesh->vtx,
+		    sizeof(double) * 3 * mesh->nVtx);
+    }
+    if(mesh->nElm > 0)
+    {
+      (void )memcpy(newMesh->elm, mesh->elm,
+		    sizeof(int) * mesh->nElmVtx * mesh->nElm);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newMesh);
+}
+
+/*!
+* \return	New indexed mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Creates a new triangular indexed mesh from the given 3D
+* 		geometric model. Vertices are indexed in the order of
+* 		the model's vertex resources and each face loop gives a
+* 		triangle with the same vertex ordering as the loop.
+* \param	model		Given 3D geometric model.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzIdxMesh			*WlzIdxMeshFromGMModel(
+				  WlzGMModel *model,
+				  WlzErrorNum *dstErr)
+{
+  WlzIdxMesh	*mesh = NULL;
+  WlzGMResIdxTb *resIdxTb = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(model == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(model->type)
+    {
+      case WLZ_GMMOD_3I: /* FALLTHROUGH */
+      case WLZ_GMMOD_3D: /* FALLTHROUGH */
+      case WLZ_GMMOD_3N:
+        break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    resIdxTb = WlzGMModelResIdx(model, WLZ_GMELMFLG_VERTEX, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh = WlzMakeIdxMesh(WLZ_IDXMESH_TRI3D, resIdxTb->vertex.idxCnt,
+                          model->res.face.numElm, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idV;
+    AlcVector	*vec;
+
+    vec = model->res.vertex.vec;
+    for(idV = 0; idV < model->res.vertex.numIdx; ++idV)
+    {
+      WlzGMVertex *vtx;
+
+      vtx = (WlzGMVertex *)AlcVectorItemGet(vec, idV);
+      if(vtx->idx >= 0)
+      {
+	double	*v;
+	WlzDVertex3 pos;
+
+	(void )WlzGMVertexGetG3D(vtx, &pos);
+	v = mesh->vtx + 3 * resIdxTb->vertex.idxLut[vtx->idx];
+	v[0] = pos.vtX;
+	v[1] = pos.vtY;
+	v[2] = pos.vtZ;
+      }
+    }
+    mesh->nVtx = resIdxTb->vertex.idxCnt;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idF;
+    int		*lut;
+    AlcVector	*vec;
+
+    vec = model->res.face.vec;
+    lut = resIdxTb->vertex.idxLut;
+    for(idF = 0; idF < model->res.face.numIdx; ++idF)
+    {
+      WlzGMFace	*fce;
+
+      fce = (WlzGMFace *)AlcVectorItemGet(vec, idF);
+      if(fce->idx >= 0)
+      {
+	int	*e;
+        WlzGMEdgeT *tET;
+
+	tET = fce->loopT->edgeT;
+	e = mesh->elm + 3 * mesh->nElm++;
+	e[0] = lut[tET->vertexT->diskT->vertex->idx];
+	e[1] = lut[tET->next->vertexT->diskT->vertex->idx];
+	e[2] = lut[tET->prev->vertexT->diskT->vertex->idx];
+      }
+    }
+  }
+  WlzGMModelResIdxFree(resIdxTb);
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzFreeIdxMesh(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
+/*!
+* \return	New indexed mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Creates a new indexed mesh from the given conforming
+* 		mesh. A 2D5 conforming mesh gives a triangular indexed
+* 		mesh and a 3D conforming mesh gives a tetrahedral
+* 		indexed mesh. Deleted nodes and elements are skipped
+* 		with the remaining nodes being indexed in order.
+* \param	cMesh		Given conforming mesh.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzIdxMesh			*WlzIdxMeshFromCMesh(
+				  WlzCMeshP cMesh,
+				  WlzErrorNum *dstErr)
+{
+  int		*nodTbl = NULL;
+  WlzIdxMesh	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cMesh.v == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(cMesh.m2->type)
+    {
+      case WLZ_CMESH_2D5:
+	if((nodTbl = (int *)AlcMalloc(sizeof(int) *
+	                    (cMesh.m2d5->res.nod.maxEnt + 1))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  mesh = WlzMakeIdxMesh(WLZ_IDXMESH_TRI3D,
+	                        cMesh.m2d5->res.nod.numEnt,
+				cMesh.m2d5->res.elm.numEnt, &errNum);
+	}
+        break;
+      case WLZ_CMESH_3D:
+	if((nodTbl = (int *)AlcMalloc(sizeof(int) *
+	                    (cMesh.m3->res.nod.maxEnt + 1))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  mesh = WlzMakeIdxMesh(WLZ_IDXMESH_TET3D,
+	                        cMesh.m3->res.nod.numEnt,
+				cMesh.m3->res.elm.numEnt, &errNum);
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idN,
+    		idE;
+
+    if(cMesh.m2->type == WLZ_CMESH_2D5)
+    {
+      WlzCMesh2D5 *m;
+
+      m = cMesh.m2d5;
+      for(idN = 0; idN < m->res.nod.maxEnt; ++idN)
+      {
+	WlzCMeshNod2D5 *nod;
+
+	nod = (WlzCMeshNod2D5 *)AlcVectorItemGet(m->res.nod.vec, idN);
+	if(nod->idx >= 0)
+	{
+	  double *v;
+
+	  nodTbl[idN] = mesh->nVtx;
+	  v = mesh->vtx + 3 * mesh->nVtx++;
+	  v[0] = nod->pos.vtX;
+	  v[1] = nod->pos.vtY;
+	  v[2] = nod->pos.vtZ;
+	}
+      }
+      for(idE = 0; idE < m->res.elm.maxEnt; ++idE)
+      {
+	WlzCMeshElm2D5 *elm;
+
+	elm = (WlzCMeshElm2D5 *)AlcVectorItemGet(m->res.elm.vec, idE);
+	if(elm->idx >= 0)
+	{
+	  int	*e;
+	  WlzCMeshNod2D5 *nod[3];
+
+	  WlzCMeshElmGetNodes2D5(elm, nod + 0, nod + 1, nod + 2);
+	  e = mesh->elm + 3 * mesh->nElm++;
+	  e[0] = nodTbl[nod[0]->idx];
+	  e[1] = nodTbl[nod[1]->idx];
+	  e[2] = nodTbl[nod[2]->idx];
+	}
+      }
+    }
+    else
+    {
+      WlzCMesh3D *m;
+
+      m = cMesh.m3;
+      for(idN = 0; idN < m->res.nod.maxEnt; ++idN)
+      {
+	WlzCMeshNod3D *nod;
+
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(m->res.nod.vec, idN);
+	if(nod->idx >= 0)
+	{
+	  double *v;
+
+	  nodTbl[idN] = mesh->nVtx;
+	  v = mesh->vtx + 3 * mesh->nVtx++;
+	  v[0] = nod->pos.vtX;
+	  v[1] = nod->pos.vtY;
+	  v[2] = nod->pos.vtZ;
+	}
+      }
+      for(idE = 0; idE < m->res.elm.maxEnt; ++idE)
+      {
+	WlzCMeshElm3D *elm;
+
+	elm = (WlzCMeshElm3D *)AlcVectorItemGet(m->res.elm.vec, idE);
+	if(elm->idx >= 0)
+	{
+	  int	*e;
+	  WlzCMeshNod3D *nod[4];
+
+	  WlzCMeshElmGetNodes3D(elm, nod + 0, nod + 1, nod + 2, nod + 3);
+	  e = mesh->elm + 4 * mesh->nElm++;
+	  e[0] = nodTbl[nod[0]->idx];
+	  e[1] = nodTbl[nod[1]->idx];
+	  e[2] = nodTbl[nod[2]->idx];
+	  e[3] = nodTbl[nod[3]->idx];
+	}
+      }
+    }
+  }
+  AlcFree(nodTbl);
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzFreeIdxMesh(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
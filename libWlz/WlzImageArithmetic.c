@@ -62,108 +62,42 @@ static WlzErrorNum		WlzImageArithmeticPromoteGTypes(
 */
 static void	WlzBufAddI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = *iP0++ + *iP1;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_ADD);
 }
 
 static void	WlzBufAddD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = *dP1 + *dP0++;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_ADD);
 }
 
 static void	WlzBufSubI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = *iP0++ - *iP1;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_SUBTRACT);
 }
 
 static void	WlzBufSubD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = *dP0++ - *dP1;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_SUBTRACT);
 }
 
 static void	WlzBufMulI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = *iP0++ * *iP1;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_MULTIPLY);
 }
 
 static void	WlzBufMulD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = *dP0++ * *dP1;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_MULTIPLY);
 }
 
 static void	WlzBufDivI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = (*iP1)? (*iP0 / *iP1): (*iP0);
-    ++iP0;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_DIVIDE);
 }
 
 static void	WlzBufDivD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = (fabs(*dP1) > DBL_EPSILON)? (*dP0 / *dP1): (*dP0);
-    ++dP0;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_DIVIDE);
 }
 
 static void	WlzBufModI(WlzGreyP gP1, WlzGreyP gP0, int count)
@@ -424,56 +358,20 @@ static void	WlzBufXOrD(WlzGreyP gP1, WlzGreyP gP0, int count)
 
 static void	WlzBufMaxI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = (*iP0 > *iP1)? *iP0: *iP1;
-    ++iP0;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_MAX);
 }
 static void	WlzBufMaxD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = (*dP0 > *dP1)? *dP0: *dP1;
-    ++dP0;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_MAX);
 }
 
 static void	WlzBufMinI(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  int		*iP0,
-  		*iP1;
-  iP0 = gP0.inp;
-  iP1 = gP1.inp;
-  while(count-- > 0)
-  {
-    *iP1 = (*iP0 < *iP1)? *iP0: *iP1;
-    ++iP0;
-    ++iP1;
-  }
+  (void )WlzValueKrnBinOpInt(gP1.inp, gP0.inp, count, WLZ_BO_MIN);
 }
 static void	WlzBufMinD(WlzGreyP gP1, WlzGreyP gP0, int count)
 {
-  double	*dP0,
-  		*dP1;
-  dP0 = gP0.dbp;
-  dP1 = gP1.dbp;
-  while(count-- > 0)
-  {
-    *dP1 = (*dP0 < *dP1)? *dP0: *dP1;
-    ++dP0;
-    ++dP1;
-  }
+  (void )WlzValueKrnBinOpDouble(gP1.dbp, gP0.dbp, count, WLZ_BO_MIN);
 }
 
 static void	WlzBufMagI(WlzGreyP gP1, WlzGreyP gP0, int count)
@@ -925,14 +823,11 @@ static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
 {
   int		tI0,
 		oIdx,
-		nPlanes,
-		bgdFlag = 0;
+		nPlanes;
   int		pIdx[3],
   		vIdx[3];
   WlzGreyType	gType[4];
-  WlzObject	*tObj;
-  WlzObject	*obj[3],
-  		*obj2D[3];
+  WlzObject	*obj[3];
   WlzPixelV	bgd[3];
   WlzPlaneDomain *pDom[3];
   WlzVoxelValues *vVal[3];
@@ -1000,76 +895,98 @@ static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
       }
       if(errNum == WLZ_ERR_NONE)
       {
+	int	idP;
+
+	/* The planes are independent so they are processed in parallel,
+	 * with the per interval kernels left single threaded. */
 	nPlanes = pDom[2]->lastpl - pDom[2]->plane1 + 1;
-	pIdx[2] = 0;
-	while((pIdx[2] < nPlanes) && (errNum == WLZ_ERR_NONE))
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for(idP = 0; idP < nPlanes; ++idP)
 	{
-	  switch(overwrite)
+	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    case 0: 					/* No values shared. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = nullValues;
-	      tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	      			 *(pDom[2]->domains + pIdx[2]),
-				 nullValues, NULL, NULL, &errNum);
-	      if(errNum == WLZ_ERR_NONE)
+	    int		oI;
+	    int		pI[3],
+	    		vI[3];
+	    WlzObject	*tObj;
+	    WlzObject	*obj2D[3];
+	    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	    for(oI = 0; oI < 3; ++oI)
+	    {
+	      pI[oI] = pIdx[oI] + idP;
+	      vI[oI] = vIdx[oI] + idP;
+	    }
+	    switch(overwrite)
+	    {
+	      case 0: 					/* No values shared. */
+		(void )WlzFreeValues(*(vVal[2]->values + pI[2]));
+		*(vVal[2]->values + pI[2]) = nullValues;
+		tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+				    *(pDom[2]->domains + pI[2]),
+				    nullValues, NULL, NULL, &errNum2);
+		if(errNum2 == WLZ_ERR_NONE)
+		{
+		  *(vVal[2]->values + pI[2]) =
+		      WlzAssignValues(tObj->values, NULL);
+		}
+		(void )WlzFreeObj(tObj);
+		break;
+	      case 1: 				 /* Values shared with obj0. */
+		(void )WlzFreeValues(*(vVal[2]->values + pI[2]));
+		*(vVal[2]->values + pI[2]) = WlzAssignValues(
+		  *(vVal[0]->values + vI[0]), NULL);
+		break;
+	      case 2: 				 /* Values shared with obj1. */
+		(void )WlzFreeValues(*(vVal[2]->values + pI[2]));
+		*(vVal[2]->values + pI[2]) = WlzAssignValues(
+		  *(vVal[1]->values + vI[1]), NULL);
+		break;
+	    }
+	    obj2D[2] = obj2D[1] = obj2D[0] = NULL;
+	    for(oI = 0; (oI < 3) && (errNum2 == WLZ_ERR_NONE); ++oI)
+	    {
+	      obj2D[oI] = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+					 *(pDom[oI]->domains + pI[oI]),
+					 *(vVal[oI]->values + vI[oI]),
+					 NULL, NULL, &errNum2);
+	    }
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      if((obj2D[2] != NULL) &&
+		 (obj2D[2]->type == WLZ_2D_DOMAINOBJ) &&
+		 (obj2D[2]->domain.core != NULL))
 	      {
-	        *(vVal[2]->values + pIdx[2]) = WlzAssignValues(tObj->values,
-							       NULL);
+		errNum2 = WlzImageArithmetic2D(obj2D[0], obj2D[1], obj2D[2],
+					       op, overwrite);
 	      }
-	      WlzFreeObj(tObj);
-	      break;
-	    case 1: 				 /* Values shared with obj0. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = WlzAssignValues(
-	        *(vVal[0]->values + vIdx[0]), NULL);
-	      break;
-	    case 2: 				 /* Values shared with obj1. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = WlzAssignValues(
-	        *(vVal[1]->values + vIdx[1]), NULL);
-	      break;
-	  }
-	  obj2D[2] = obj2D[1] = obj2D[0] = NULL;
-	  for(oIdx = 0; (oIdx < 3) && (errNum == WLZ_ERR_NONE); ++oIdx)
-	  {
-	    obj2D[oIdx] = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    			      *(pDom[oIdx]->domains + pIdx[oIdx]),
-	    			      *(vVal[oIdx]->values + vIdx[oIdx]),
-				      NULL, NULL, &errNum);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    if((obj2D[2] != NULL) &&
-	       (obj2D[2]->type == WLZ_2D_DOMAINOBJ) &&
-	       (obj2D[2]->domain.core != NULL))
+	    }
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      (void )WlzFreeValues(*(vVal[2]->values + pI[2]));
+	      *(vVal[2]->values + pI[2]) = WlzAssignValues(obj2D[2]->values,
+							      NULL);
+	    }
+	    (void )WlzFreeObj(obj2D[0]);
+	    (void )WlzFreeObj(obj2D[1]);
+	    (void )WlzFreeObj(obj2D[2]);
+	    if(errNum2 != WLZ_ERR_NONE)
 	    {
-	      errNum = WlzImageArithmetic2D(obj2D[0], obj2D[1], obj2D[2],
-					    op, overwrite);
-	      if(errNum == WLZ_ERR_NONE)
+#ifdef _OPENMP
+#pragma omp critical (WlzImageArithmetic3D)
 	      {
-		if((bgdFlag == 0) && (obj2D[2]->type == WLZ_2D_DOMAINOBJ))
+		if(errNum == WLZ_ERR_NONE)
 		{
-		  bgd[2] = WlzGetBackground(obj0, &errNum);
-		  bgdFlag = 1;
+		  errNum = errNum2;
 		}
 	      }
+#else
+	      errNum = errNum2;
+#endif
 	    }
 	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	    *(vVal[2]->values + pIdx[2]) = WlzAssignValues(obj2D[2]->values,
-	    						   NULL);
-	  }
-	  (void )WlzFreeObj(obj2D[0]);
-	  (void )WlzFreeObj(obj2D[1]);
-	  (void )WlzFreeObj(obj2D[2]);
-	  ++pIdx[0];
-	  ++vIdx[0];
-	  ++pIdx[1];
-	  ++vIdx[1];
-	  ++pIdx[2];
 	}
       }
     }
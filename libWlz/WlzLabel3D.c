@@ -45,6 +45,77 @@ static char _WlzLabel3D_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzLabel3DRun
+* \ingroup	WlzBinaryOps
+* \brief	A run of adjacent voxels within a line of a plane, used by
+* 		WlzLabel3DRuns(). All coordinates are absolute apart from
+* 		the plane which is relative to the first plane of the given
+* 		object.
+*/
+typedef struct _WlzLabel3DRun
+{
+  int		pl;			/*!< Plane index. */
+  int		ln;			/*!< Line. */
+  int		kl;			/*!< First column. */
+  int		kr;			/*!< Last column. */
+} WlzLabel3DRun;
+
+/*!
+* \struct	_WlzLabel3DPln
+* \ingroup	WlzBinaryOps
+* \brief	The runs of a single plane, used by WlzLabel3DRuns().
+*/
+typedef struct _WlzLabel3DPln
+{
+  int		line1;			/*!< First line of the plane. */
+  int		lastln;			/*!< Last line of the plane, less
+  					     than line1 if the plane is
+					     empty. */
+  int		runOff;			/*!< Index of the first run of the
+  					     plane in the run array. */
+  int		nRun;			/*!< Number of runs in the plane. */
+  int		*lnOff;			/*!< Index of the first run of each
+  					     line, relative to runOff, with
+					     an extra final entry. */
+} WlzLabel3DPln;
+
+static int			WlzLabel3DRunsFind(
+				  int *pr,
+				  int i);
+static int			WlzLabel3DRunsCount(
+				  WlzDomain dom);
+static void			WlzLabel3DRunsUnion(
+				  int *pr,
+				  int i,
+				  int j);
+static void			WlzLabel3DRunsJoin(
+				  int *pr,
+				  WlzLabel3DRun *run,
+				  int a0,
+				  int a1,
+				  int b0,
+				  int b1,
+				  int w);
+static void			WlzLabel3DRunsFill(
+				  WlzDomain dom,
+				  int pl,
+				  WlzLabel3DPln *pln,
+				  WlzLabel3DRun *run);
+static WlzObject		*WlzLabel3DRunsCompound(
+				  WlzObject *gObj,
+				  int nLbl,
+				  int nRun,
+				  int *lbl,
+				  WlzLabel3DRun *run,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzLabel3DRunsValues(
+				  WlzObject *gObj,
+				  int nPln,
+				  WlzLabel3DPln *pln,
+				  int *lbl,
+				  WlzErrorNum *dstErr);
+
 /*!
 * \return	A compund array object containing the labeled object
 * 		components of the given object.
@@ -616,3 +687,802 @@ WlzObject			*WlzLabel3D(
   return(lObj);
 }
 
+
+/*!
+* \return	A compound array object containing the labeled object
+* 		components of the given object, or a single 3D domain
+* 		object with integer label values.
+* \ingroup	WlzBinaryOps
+* \brief	Labels (segments) a 3D domain object into connected
+* 		components using the runs (intervals) of its domain
+* 		directly, without forming 2D objects for the components
+* 		of each plane.
+*
+* 		The runs of each plane are found and joined within the
+* 		plane in parallel, using a union-find forest over all
+* 		the runs in which each component is represented by its
+* 		first run. The runs of adjacent planes are then joined
+* 		and the components are labeled in raster scan order of
+* 		their first voxel, so the labels do not depend on the
+* 		number of threads.
+*
+* 		4 and 6-connectivity give 6-connected components,
+* 		18-connectivity 18-connected components and
+* 		8 and 26-connectivity 26-connected components.
+*
+* 		If label values are requested the returned object has
+* 		the domain of the given object and WLZ_GREY_INT values
+* 		with the component labels \f$1, \ldots, n\f$ (the
+* 		background is zero). Otherwise a compound array of 3D
+* 		domain objects is returned, which share the values of
+* 		the given object if it has values.
+* \param	gObj		Given object to be labeled.
+* \param	con		The connectivity to use in 3D.
+* \param	lblVal		Return a single object with label values if
+* 				non-zero, otherwise return a compound array
+* 				object.
+* \param	dstNLbl		Destination for the number of labeled
+* 				components, may be NULL.
+* \param	dstErr		Destination error pointer, may be NULL.
+*/
+WlzObject			*WlzLabel3DRuns(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int lblVal,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr)
+{
+  int		p,
+		nPln = 0,
+		nRun = 0,
+		nLbl = 0,
+		wP = 0,
+		wQ = 0,
+		wA = 0,
+		dLn = 0;
+  int		*pr = NULL,
+		*lbl = NULL;
+  WlzLabel3DPln	*pln = NULL;
+  WlzLabel3DRun	*run = NULL;
+  WlzDomain	*doms = NULL;
+  WlzObject	*lObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(gObj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(gObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(gObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((gObj->values.core != NULL) &&
+         (gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    /* Run overlap within a plane (wP), between the same lines (wQ) and
+     * adjacent lines (wA) of adjacent planes and the range of lines to
+     * check in the previous plane (dLn). */
+    switch(con)
+    {
+      case WLZ_4_CONNECTED:  /* FALLTHROUGH */
+      case WLZ_6_CONNECTED:
+        break;
+      case WLZ_18_CONNECTED:
+        wP = 1;
+	wQ = 1;
+	dLn = 1;
+        break;
+      case WLZ_8_CONNECTED:  /* FALLTHROUGH */
+      case WLZ_26_CONNECTED:
+        wP = 1;
+	wQ = 1;
+	wA = 1;
+	dLn = 1;
+	break;
+      default:
+        errNum = WLZ_ERR_PARAM_DATA;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPln = gObj->domain.p->lastpl - gObj->domain.p->plane1 + 1;
+    doms = gObj->domain.p->domains;
+    if((pln = (WlzLabel3DPln *)
+              AlcCalloc(nPln, sizeof(WlzLabel3DPln))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Count the runs of each plane. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < nPln; ++p)
+    {
+      pln[p].nRun = WlzLabel3DRunsCount(doms[p]);
+    }
+    for(p = 0; p < nPln; ++p)
+    {
+      pln[p].runOff = nRun;
+      if(pln[p].nRun > INT_MAX - nRun)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+      nRun += pln[p].nRun;
+    }
+    if((errNum == WLZ_ERR_NONE) && (nRun < 1))
+    {
+      /* No runs but given a domain object. */
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((run = (WlzLabel3DRun *)
+               AlcMalloc(nRun * sizeof(WlzLabel3DRun))) == NULL) ||
+       ((pr = (int *)AlcMalloc(nRun * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Fill in the runs of each plane and join those within the plane. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < nPln; ++p)
+    {
+      if(pln[p].nRun > 0)
+      {
+	WlzLabel3DPln *pP;
+
+	pP = pln + p;
+	pP->lnOff = (int *)AlcMalloc((doms[p].i->lastln -
+	                              doms[p].i->line1 + 2) * sizeof(int));
+	if(pP->lnOff == NULL)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabel3DRuns)
+#endif
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	}
+	else
+	{
+	  int	l,
+		r;
+
+	  WlzLabel3DRunsFill(doms[p], p, pP, run);
+	  for(r = pP->runOff; r < pP->runOff + pP->nRun; ++r)
+	  {
+	    pr[r] = r;
+	  }
+	  for(l = pP->line1 + 1; l <= pP->lastln; ++l)
+	  {
+	    int	i;
+
+	    i = l - pP->line1;
+	    WlzLabel3DRunsJoin(pr, run,
+			       pP->runOff + pP->lnOff[i - 1],
+			       pP->runOff + pP->lnOff[i],
+			       pP->runOff + pP->lnOff[i],
+			       pP->runOff + pP->lnOff[i + 1], wP);
+	  }
+	}
+      }
+      else
+      {
+        pln[p].lastln = pln[p].line1 - 1;
+      }
+    }
+  }
+  /* Join the runs of adjacent planes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(p = 1; p < nPln; ++p)
+    {
+      int	l;
+      WlzLabel3DPln *pP,
+      		*pQ;
+
+      pP = pln + p;
+      pQ = pln + p - 1;
+      if((pP->nRun > 0) && (pQ->nRun > 0))
+      {
+	for(l = pP->line1; l <= pP->lastln; ++l)
+	{
+	  int	m,
+		i;
+
+	  i = l - pP->line1;
+	  for(m = l - dLn; m <= l + dLn; ++m)
+	  {
+	    if((m >= pQ->line1) && (m <= pQ->lastln))
+	    {
+	      int	j;
+
+	      j = m - pQ->line1;
+	      WlzLabel3DRunsJoin(pr, run,
+				 pQ->runOff + pQ->lnOff[j],
+				 pQ->runOff + pQ->lnOff[j + 1],
+				 pP->runOff + pP->lnOff[i],
+				 pP->runOff + pP->lnOff[i + 1],
+				 (m == l)? wQ: wA);
+	    }
+	  }
+	}
+      }
+    }
+  }
+  /* Label the components. A run's parent always precedes it, so in
+   * order the forest is first flattened and then the labels replace the
+   * parents in place, each component's label being that of its first
+   * run. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		r;
+
+    for(r = 0; r < nRun; ++r)
+    {
+      pr[r] = pr[pr[r]];
+    }
+    lbl = pr;
+    for(r = 0; r < nRun; ++r)
+    {
+      lbl[r] = (pr[r] == r)? nLbl++: lbl[pr[r]];
+    }
+    pr = NULL;
+    if(lblVal)
+    {
+      lObj = WlzLabel3DRunsValues(gObj, nPln, pln, lbl, &errNum);
+    }
+    else
+    {
+      lObj = WlzLabel3DRunsCompound(gObj, nLbl, nRun, lbl, run, &errNum);
+    }
+  }
+  if(pln)
+  {
+    for(p = 0; p < nPln; ++p)
+    {
+      AlcFree(pln[p].lnOff);
+    }
+    AlcFree(pln);
+  }
+  AlcFree(run);
+  AlcFree(pr);
+  AlcFree(lbl);
+  if(dstNLbl)
+  {
+    *dstNLbl = (errNum == WLZ_ERR_NONE)? nLbl: 0;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lObj);
+}
+
+/*!
+* \return	Root of the given run's component.
+* \ingroup	WlzBinaryOps
+* \brief	Finds the root of a run's component in the union-find
+* 		forest used by WlzLabel3DRuns(), halving the path to it.
+* \param	pr		Parent of each run.
+* \param	i		Given run.
+*/
+static int	WlzLabel3DRunsFind(int *pr, int i)
+{
+  while(pr[i] != i)
+  {
+    pr[i] = pr[pr[i]];
+    i = pr[i];
+  }
+  return(i);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzBinaryOps
+* \brief	Joins the components of two runs in the union-find forest
+* 		used by WlzLabel3DRuns(), keeping the lower indexed root.
+* \param	pr		Parent of each run.
+* \param	i		First run.
+* \param	j		Second run.
+*/
+static void	WlzLabel3DRunsUnion(int *pr, int i, int j)
+{
+  i = WlzLabel3DRunsFind(pr, i);
+  j = WlzLabel3DRunsFind(pr, j);
+  if(i < j)
+  {
+    pr[j] = i;
+  }
+  else if(j < i)
+  {
+    pr[i] = j;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzBinaryOps
+* \brief	Joins the overlapping runs of two ordered sets of runs,
+* 		each of which is within a single line. Runs overlap if
+* 		their column ranges, extended by the given overlap,
+* 		intersect.
+* \param	pr		Parent of each run.
+* \param	run		All runs.
+* \param	a0		First run of the first set.
+* \param	a1		One past the last run of the first set.
+* \param	b0		First run of the second set.
+* \param	b1		One past the last run of the second set.
+* \param	w		Overlap, 0 or 1.
+*/
+static void	WlzLabel3DRunsJoin(int *pr, WlzLabel3DRun *run,
+				   int a0, int a1, int b0, int b1, int w)
+{
+  while((a0 < a1) && (b0 < b1))
+  {
+    WlzLabel3DRun *rA,
+    		*rB;
+
+    rA = run + a0;
+    rB = run + b0;
+    if((rA->kl <= rB->kr + w) && (rB->kl <= rA->kr + w))
+    {
+      WlzLabel3DRunsUnion(pr, a0, b0);
+    }
+    if(rA->kr < rB->kr)
+    {
+      ++a0;
+    }
+    else
+    {
+      ++b0;
+    }
+  }
+}
+
+/*!
+* \return	Number of runs.
+* \ingroup	WlzBinaryOps
+* \brief	Counts the runs (intervals) of a plane's domain.
+* \param	dom		Given plane domain, may be NULL or empty.
+*/
+static int	WlzLabel3DRunsCount(WlzDomain dom)
+{
+  int		l,
+		n = 0;
+
+  if(dom.core != NULL)
+  {
+    switch(dom.core->type)
+    {
+      case WLZ_INTERVALDOMAIN_INTVL:
+        for(l = 0; l <= dom.i->lastln - dom.i->line1; ++l)
+	{
+	  n += dom.i->intvlines[l].nintvs;
+	}
+	break;
+      case WLZ_INTERVALDOMAIN_RECT:
+        n = dom.i->lastln - dom.i->line1 + 1;
+	break;
+      default:
+        break;
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzBinaryOps
+* \brief	Fills in the runs of a plane in raster scan order, along
+* 		with the offsets of the runs of each line.
+* \param	dom		Given plane domain which must have runs.
+* \param	pl		Plane index.
+* \param	pln		Plane with it's run offset set and line
+* 				offset array allocated.
+* \param	run		All runs.
+*/
+static void	WlzLabel3DRunsFill(WlzDomain dom, int pl, WlzLabel3DPln *pln,
+				   WlzLabel3DRun *run)
+{
+  int		l,
+		n = 0;
+  WlzLabel3DRun	*rP;
+
+  pln->line1 = dom.i->line1;
+  pln->lastln = dom.i->lastln;
+  rP = run + pln->runOff;
+  for(l = dom.i->line1; l <= dom.i->lastln; ++l)
+  {
+    pln->lnOff[l - dom.i->line1] = n;
+    if(dom.core->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      rP->pl = pl;
+      rP->ln = l;
+      rP->kl = dom.i->kol1;
+      rP->kr = dom.i->lastkl;
+      ++rP;
+      ++n;
+    }
+    else
+    {
+      int	i;
+      WlzIntervalLine *iLn;
+
+      iLn = dom.i->intvlines + l - dom.i->line1;
+      for(i = 0; i < iLn->nintvs; ++i)
+      {
+	rP->pl = pl;
+	rP->ln = l;
+	rP->kl = dom.i->kol1 + iLn->intvs[i].ileft;
+	rP->kr = dom.i->kol1 + iLn->intvs[i].iright;
+	++rP;
+	++n;
+      }
+    }
+  }
+  pln->lnOff[dom.i->lastln - dom.i->line1 + 1] = n;
+}
+
+/*!
+* \return	New compound array object.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a compound array object with a 3D domain object for
+* 		each of the labeled components. The domains are built
+* 		directly from the runs, which are first sorted by label
+* 		keeping their raster scan order.
+* \param	gObj		Given object.
+* \param	nLbl		Number of labels.
+* \param	nRun		Number of runs.
+* \param	lbl		Label of each run.
+* \param	run		All runs.
+* \param	dstErr		Destination error pointer.
+*/
+static WlzObject *WlzLabel3DRunsCompound(WlzObject *gObj, int nLbl,
+				         int nRun, int *lbl,
+					 WlzLabel3DRun *run,
+					 WlzErrorNum *dstErr)
+{
+  int		i,
+  		r;
+  int		*idx = NULL,
+		*lblOff = NULL;
+  WlzPlaneDomain *gPDom;
+  WlzCompoundArray *objs = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gPDom = gObj->domain.p;
+  if(((idx = (int *)AlcMalloc(nRun * sizeof(int))) == NULL) ||
+     ((lblOff = (int *)AlcCalloc(nLbl + 1, sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, nLbl, NULL,
+				WLZ_3D_DOMAINOBJ, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Counting sort of the runs by label. */
+    for(r = 0; r < nRun; ++r)
+    {
+      ++(lblOff[lbl[r] + 1]);
+    }
+    for(i = 0; i < nLbl; ++i)
+    {
+      lblOff[i + 1] += lblOff[i];
+    }
+    for(r = 0; r < nRun; ++r)
+    {
+      idx[lblOff[lbl[r]]++] = r;
+    }
+    for(i = nLbl; i > 0; --i)
+    {
+      lblOff[i] = lblOff[i - 1];
+    }
+    lblOff[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(i = 0; i < nLbl; ++i)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	  r0,
+		  r1,
+		  s,
+		  line1,
+		  lastln,
+		  kol1,
+		  lastkl;
+	WlzDomain dom;
+	WlzValues nulVal;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	nulVal.core = NULL;
+	r0 = lblOff[i];
+	r1 = lblOff[i + 1];
+	line1 = lastln = run[idx[r0]].ln;
+	kol1 = run[idx[r0]].kl;
+	lastkl = run[idx[r0]].kr;
+	for(s = r0 + 1; s < r1; ++s)
+	{
+	  WlzLabel3DRun *rP;
+
+	  rP = run + idx[s];
+	  line1 = WLZ_MIN(line1, rP->ln);
+	  lastln = WLZ_MAX(lastln, rP->ln);
+	  kol1 = WLZ_MIN(kol1, rP->kl);
+	  lastkl = WLZ_MAX(lastkl, rP->kr);
+	}
+	dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+				   gPDom->plane1 + run[idx[r0]].pl,
+				   gPDom->plane1 + run[idx[r1 - 1]].pl,
+				   line1, lastln, kol1, lastkl, &errNum2);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dom.p->voxel_size[0] = gPDom->voxel_size[0];
+	  dom.p->voxel_size[1] = gPDom->voxel_size[1];
+	  dom.p->voxel_size[2] = gPDom->voxel_size[2];
+	  objs->o[i] = WlzAssignObject(
+	               WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nulVal, NULL, NULL,
+		                   &errNum2), NULL);
+	  if(objs->o[i] == NULL)
+	  {
+	    (void )WlzFreePlaneDomain(dom.p);
+	  }
+	}
+	/* Make an interval domain for each plane of the component. */
+	while((errNum2 == WLZ_ERR_NONE) && (r0 < r1))
+	{
+	  int	  p;
+	  WlzDomain dom2;
+	  WlzInterval *itv = NULL;
+
+	  p = run[idx[r0]].pl;
+	  line1 = lastln = run[idx[r0]].ln;
+	  kol1 = run[idx[r0]].kl;
+	  lastkl = run[idx[r0]].kr;
+	  for(s = r0 + 1; (s < r1) && (run[idx[s]].pl == p); ++s)
+	  {
+	    WlzLabel3DRun *rP;
+
+	    rP = run + idx[s];
+	    lastln = rP->ln;
+	    kol1 = WLZ_MIN(kol1, rP->kl);
+	    lastkl = WLZ_MAX(lastkl, rP->kr);
+	  }
+	  dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+					 line1, lastln, kol1, lastkl,
+					 &errNum2);
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    if((itv = (WlzInterval *)
+	              AlcMalloc((s - r0) * sizeof(WlzInterval))) == NULL)
+	    {
+	      (void )WlzFreeIntervalDomain(dom2.i);
+	      errNum2 = WLZ_ERR_MEM_ALLOC;
+	    }
+	    else
+	    {
+	      dom2.i->freeptr = AlcFreeStackPush(dom2.i->freeptr,
+						 (void *)itv, NULL);
+	      dom.p->domains[p + gPDom->plane1 - dom.p->plane1] =
+	          WlzAssignDomain(dom2, NULL);
+	    }
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    int	  t;
+
+	    for(t = r0; t < s; )
+	    {
+	      int	  u,
+			  l;
+
+	      l = run[idx[t]].ln;
+	      for(u = t; (u < s) && (run[idx[u]].ln == l); ++u)
+	      {
+		itv[u - r0].ileft = run[idx[u]].kl - kol1;
+		itv[u - r0].iright = run[idx[u]].kr - kol1;
+	      }
+	      (void )WlzMakeInterval(l, dom2.i, u - t, itv + t - r0);
+	      t = u;
+	    }
+	  }
+	  r0 = s;
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabel3DRuns)
+#endif
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  /* The components share the value tables of the given object's planes,
+   * which is done serialy because of their link counts. */
+  if((errNum == WLZ_ERR_NONE) && (gObj->values.core != NULL))
+  {
+    WlzPixelV	bgdV;
+
+    bgdV = WlzGetBackground(gObj, &errNum);
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < nLbl); ++i)
+    {
+      int	p;
+      WlzValues	nVal;
+      WlzPlaneDomain *nPDom;
+
+      nPDom = objs->o[i]->domain.p;
+      nVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				     nPDom->plane1, nPDom->lastpl,
+				     bgdV, NULL, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	objs->o[i]->values = WlzAssignValues(nVal, NULL);
+	for(p = nPDom->plane1; p <= nPDom->lastpl; ++p)
+	{
+	  nVal.vox->values[p - nPDom->plane1] = WlzAssignValues(
+		gObj->values.vox->values[p - gPDom->plane1], NULL);
+	}
+      }
+    }
+  }
+  AlcFree(idx);
+  AlcFree(lblOff);
+  if((errNum != WLZ_ERR_NONE) && (objs != NULL))
+  {
+    (void )WlzFreeObj((WlzObject *)objs);
+    objs = NULL;
+  }
+  *dstErr = errNum;
+  return((WlzObject *)objs);
+}
+
+/*!
+* \return	New 3D domain object with label values.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a 3D domain object with the domain of the given
+* 		object and WLZ_GREY_INT values which are the labels of the
+* 		runs, offset by one so that the background is zero.
+* \param	gObj		Given object.
+* \param	nPln		Number of planes.
+* \param	pln		Planes of runs.
+* \param	lbl		Label of each run.
+* \param	dstErr		Destination error pointer.
+*/
+static WlzObject *WlzLabel3DRunsValues(WlzObject *gObj, int nPln,
+				       WlzLabel3DPln *pln, int *lbl,
+				       WlzErrorNum *dstErr)
+{
+  int		p;
+  WlzPixelV	bgdV;
+  WlzValues	val;
+  WlzObject	*lObj = NULL;
+  WlzObject	**pObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  bgdV.type = WLZ_GREY_INT;
+  bgdV.v.inv = 0;
+  val.vox = WlzNewValuesVox(gObj,
+  			    WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
+			                          WLZ_GREY_INT, NULL),
+			    bgdV, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    lObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, gObj->domain, val, NULL, NULL,
+                       &errNum);
+    if(lObj == NULL)
+    {
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+  }
+  /* Make the plane objects serialy because of the link counts, then set
+   * their values in parallel. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((pObj = (WlzObject **)AlcCalloc(nPln, sizeof(WlzObject *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+    {
+      if(pln[p].nRun > 0)
+      {
+	pObj[p] = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+			      gObj->domain.p->domains[p],
+			      val.vox->values[p], NULL, NULL, &errNum);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < nPln; ++p)
+    {
+      if(pObj[p] != NULL)
+      {
+	int	r;
+	WlzIntervalWSpace iWSp;
+	WlzGreyWSpace gWSp;
+	WlzErrorNum errNum2;
+
+	r = pln[p].runOff;
+	errNum2 = WlzInitGreyScan(pObj[p], &iWSp, &gWSp);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  while((errNum2 = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	  {
+	    int	k,
+		v;
+
+	    v = lbl[r++] + 1;
+	    for(k = 0; k < iWSp.colrmn; ++k)
+	    {
+	      gWSp.u_grintptr.inp[k] = v;
+	    }
+	  }
+	  (void )WlzEndGreyScan(&iWSp, &gWSp);
+	  if(errNum2 == WLZ_ERR_EOO)
+	  {
+	    errNum2 = WLZ_ERR_NONE;
+	  }
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabel3DRuns)
+#endif
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  if(pObj)
+  {
+    for(p = 0; p < nPln; ++p)
+    {
+      (void )WlzFreeObj(pObj[p]);
+    }
+    AlcFree(pObj);
+  }
+  if((errNum != WLZ_ERR_NONE) && (lObj != NULL))
+  {
+    (void )WlzFreeObj(lObj);
+    lObj = NULL;
+  }
+  *dstErr = errNum;
+  return(lObj);
+}
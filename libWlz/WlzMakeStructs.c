@@ -441,6 +441,7 @@ WlzMakeMain(WlzObjectType 	type,
     case WLZ_RECTANGLE:
     case WLZ_TRANS_OBJ:
     case WLZ_SPLINE:
+    case WLZ_IDXMESH:
       obj->type = type;
 #ifdef _OPENMP
 #pragma omp critical (WlzLinkcount)
@@ -148,7 +148,8 @@ static WlzErrorNum		WlzMatchICPRegShellLst(
 				  WlzRegICPUsrWgtFn usrWgtFn,
 				  void *usrWgtData,
 				  double delta,
-				  double minDistWgt);
+				  double minDistWgt,
+				  WlzRegICPCtl *ctl);
 static WlzAffineTransform 	*WlzMatchICPRegModel(
 				  AlcKDTTree *tTree,
 				  WlzTransformType trType,
@@ -171,6 +172,7 @@ static WlzAffineTransform 	*WlzMatchICPRegModel(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  WlzRegICPCtl *ctl,
 				  WlzErrorNum *dstErr);
 static WlzAffineTransform 	*WlzMatchICPRegShell(
 				  AlcKDTTree *tTree,
@@ -200,6 +202,7 @@ static WlzAffineTransform 	*WlzMatchICPRegShell(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  WlzRegICPCtl *ctl,
 				  WlzErrorNum *dstErr);
 static int			WlzMatchICPGetPoints(
 				  WlzGMModel *tGM,
@@ -325,6 +328,8 @@ static int			WlzMatchICPDblSortFnD(
 				  int *idx,
 				  int id0,
 				  int id1);
+static double			WlzMatchICPRand(
+				  unsigned int *state);
 static double			WlzMatchICPWeightMatches2D(
 				  WlzAffineTransform *curTr,
 				  AlcKDTTree *tree,
@@ -381,6 +386,8 @@ static void			WlzMatchICPShellListElmUnlink(
 *		then it's model is modified in place. If this isn't
 *		wanted then use WlzCopyObj() to copy the contours
 *		before calling this function.
+*		This function is equivalent to WlzMatchICPObjsCtl()
+*		with a NULL control.
 * \param	tObj			The target object.
 * \param	sObj			The source object to be
 *					matched with target object.
@@ -453,6 +460,104 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 				double maxDeform,
 				int matchImpNN, double matchImpThr,
 				double delta)
+{
+  WlzErrorNum	errNum;
+
+  errNum = WlzMatchICPObjsCtl(tObj, sObj, initTr,
+			      dstNMatch, dstTMatch, dstSMatch, maxItr,
+			      minSpx, minSegSpx, brkFlg,
+			      maxDisp, maxAng, maxDeform,
+			      matchImpNN, matchImpThr, delta, NULL);
+  return(errNum);
+}
+
+/*!
+* \return				Error code.
+* \ingroup	WlzTransform
+* \brief	Finds matching points in two objects using an ICP
+*		based matching algorithm.
+*		On return the match points are ranked by plausibility
+*		with the most plausible matches first.
+*		If either the target or source object is a contour
+*		then it's model is modified in place. If this isn't
+*		wanted then use WlzCopyObj() to copy the contours
+*		before calling this function.
+*		This function is WlzMatchICPObjs() with optional ICP
+*		control parameters and statistics.
+* \param	tObj			The target object.
+* \param	sObj			The source object to be
+*					matched with target object.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to matching. May
+*					be NULL.
+* \param	dstNMatch		Destination pointer for the number
+*					of match points found. Required.
+* \param	dstTMatch		Destination pointer for the target
+*					match points found. Required.
+* \param	dstSMatch		Destination pointer for the source
+*					match points found. Required.
+* \param	maxItr			Maximum number of iterations.
+* \param	minSpx			Minimum number of simplicies in
+*					a contour shell for matching.
+* \param	minSegSpx		Minimum number of simplices per
+*					matched shell segment, with a tie
+*					point pair possibly being generated
+*					for each matched shell segment.
+* \param	brkFlg			Controls the breaking of the source
+*					shells. Possible values are:
+*					  - 0
+*					    Whole model registration, source
+*					    shells are never broken.
+*					  - 1
+*					    Whole source shells are
+*					    registered to the target model.
+*					    Source shells are never broken.
+*					  - 2
+*					    Source shells are only ever
+*					    broken by connectivity.
+*					  - > 2
+*					    Source shells are broken by
+*					    connectivity and then near
+*					    there midpoints brkFlg - 1
+*					    times.
+* \param	maxDisp			The maximum displacement to the
+* 					geometry of a shell, from the global
+*					affine transformed position for
+*					an acceptable registration.
+*					distance, for a registered shell
+*					to be used for correspondence
+*					computation.
+* \param	maxAng			The maximum angle of rotation of a
+* 					shell geometry with respect to the
+* 					global affine transformed geometry for
+* 					an acceptable registration.
+* \param	maxDeform		The maximum deformation to the geometry
+* 					of a shell, from the global affine
+* 					transformed geometry, for an acceptable
+* 					registration.
+* \param	matchImpNN		Number match points in neighbourhood
+*					when removing implausible match
+*					points, must be \f$> 2\f$.
+* \param	matchImpThr		Implausibility threshold which should
+*					be \f$> 0\f$ but the useful range
+*					is probably \f$[0.5-2.5]\f$. Higher
+*					values allow more implausible matches
+*					to be returned.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	ctl			Optional ICP control parameters and
+*					statistics, may be NULL.
+*/
+WlzErrorNum	WlzMatchICPObjsCtl(WlzObject *tObj, WlzObject *sObj,
+				   WlzAffineTransform *initTr,
+				   int *dstNMatch, WlzVertexP *dstTMatch,
+				   WlzVertexP *dstSMatch, int maxItr,
+				   int minSpx, int minSegSpx, int brkFlg,
+				   double maxDisp, double maxAng, 
+				   double maxDeform,
+				   int matchImpNN, double matchImpThr,
+				   double delta, WlzRegICPCtl *ctl)
 {
   WlzMatchICPWeightCbData cbData;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -504,13 +609,13 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 	      cbData.sGM = sObj->domain.ctr->model;
 	      cbData.maxDisp = maxDisp;
 	      cbData.nScatter = nScatter;
-	      errNum = WlzMatchICPCtr(tObj->domain.ctr, sObj->domain.ctr,
-	      			      initTr, maxItr, minSpx, minSegSpx,
-				      dstNMatch, dstTMatch, dstSMatch, brkFlg,
-				      maxDisp, maxAng, maxDeform,
-    				      matchImpNN, matchImpThr,
-				      WlzMatchICPWeightMatches, &cbData,
-				      delta);
+	      errNum = WlzMatchICPCtrCtl(tObj->domain.ctr, sObj->domain.ctr,
+					 initTr, maxItr, minSpx, minSegSpx,
+					 dstNMatch, dstTMatch, dstSMatch,
+					 brkFlg, maxDisp, maxAng, maxDeform,
+					 matchImpNN, matchImpThr,
+					 WlzMatchICPWeightMatches, &cbData,
+					 delta, ctl);
 	      break;
 	    default:
 	      errNum = WLZ_ERR_DOMAIN_TYPE;
@@ -533,6 +638,8 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 *		checked so that their models are neither NULL or
 *		of different types.
 *		The source contour's model is modified in place.
+*		This function is equivalent to WlzMatchICPCtrCtl()
+*		with a NULL control.
 * \param	tCtr			The target contour.
 * \param	sCtr			The source contour to be
 *					matched with target contour.
@@ -591,7 +698,8 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 *					is probably \f$[0.5-2.5]\f$. Higher
 *					values allow more implausible matches
 *					to be returned.
-* \param	usrWgtFn		User supplied weighting function.
+* \param	usrWgtFn		User supplied weighting function,
+*					which may be called concurrently.
 * \param	usrWgtData		User supplied weighting data.
 * \param	delta			Tolerance for mean value of
 *					registration metric.
@@ -606,6 +714,108 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 			       int matchImpNN, double matchImpThr,
 			       WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 			       double delta)
+{
+  WlzErrorNum	errNum;
+
+  errNum = WlzMatchICPCtrCtl(tCtr, sCtr, initTr, maxItr, minSpx, minSegSpx,
+			     dstNMatch, dstTMatch, dstSMatch, brkFlg,
+			     maxDisp, maxAng, maxDeform,
+			     matchImpNN, matchImpThr, usrWgtFn, usrWgtData,
+			     delta, NULL);
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	WlzTransform
+* \brief	Establishes matching points in two 2D contours using ICP
+*		based registration algorithm. The contours have been
+*		checked so that their models are neither NULL or
+*		of different types.
+*		The source contour's model is modified in place.
+*		This function is WlzMatchICPCtr() with optional ICP
+*		control parameters and statistics.
+* \param	tCtr			The target contour.
+* \param	sCtr			The source contour to be
+*					matched with target contour.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to matching. May
+*					be NULL.
+* \param	maxItr			Maximum number of iterations.
+* \param	minSpx			Minimum number of simplicies in
+*					a contour shell for matching.
+* \param	minSegSpx		Minimum number of simplices per
+*					matched shell segment, with a tie
+*					point pair possibly being generated
+*					for each matched shell segment.
+* \param	dstNMatch		Destination pointer for the number
+*					of match points found.
+* \param	dstTMatch		Destination pointer for the target
+*					match points found.
+* \param	dstSMatch		Destination pointer for the source
+*					match points found.
+* \param	brkFlg			Controls the breaking of the source
+*					shells. Possible values are:
+*					  - 0
+*					    Whole model registration, source
+*					    shells are never broken.
+*					  - 1
+*					    Whole source shells are
+*					    registered to the target model.
+*					    Source shells are never broken.
+*					  - 2
+*					    Source shells are only ever
+*					    broken by connectivity.
+*					  - > 2
+*					    Source shells are broken by
+*					    connectivity and then near
+*					    there midpoints brkFlg - 1
+*					    times.
+* \param	maxDisp			The maximum displacement to the
+* 					geometry of a shell for an acceptable
+* 					registration.
+*					distance for a registered shell
+*					to be used for correspondence
+*					computation.
+* \param	maxAng			The maximum angle of rotation of a
+* 					shell geometry with respect to the
+* 					global affine transformed geometry for
+* 					an acceptable registration.
+* \param	maxDeform		The maximum deformation to the geometry
+* 					of a shell for an acceptable
+* 					registration.
+* \param	matchImpNN		Number match points in neighbourhood
+*					when removing implausible match
+*					points, must be \f$> 2\f$.
+* \param	matchImpThr		Implausibility threshold which should
+*					be \f$> 0\f$ but the useful range
+*					is probably \f$[0.5-2.5]\f$. Higher
+*					values allow more implausible matches
+*					to be returned.
+* \param	usrWgtFn		User supplied weighting function,
+*					which may be called concurrently.
+* \param	usrWgtData		User supplied weighting data.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	ctl			Optional ICP control parameters and
+*					statistics, may be NULL. A flat
+*					kD-tree is built from the target
+*					vertices for the correspondence
+*					search, while the multi-resolution
+*					schedule is only used for the
+*					registration of the whole model.
+*/
+WlzErrorNum  	WlzMatchICPCtrCtl(WlzContour *tCtr, WlzContour *sCtr,
+				  WlzAffineTransform *initTr,
+				  int maxItr, int minSpx, int minSegSpx,
+				  int *dstNMatch, WlzVertexP *dstTMatch,
+				  WlzVertexP *dstSMatch, int brkFlg,
+				  double  maxDisp, double maxAng,
+				  double maxDeform,
+				  int matchImpNN, double matchImpThr,
+				  WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
+				  double delta, WlzRegICPCtl *ctl)
 {
   int		idS,
 		n0,
@@ -636,6 +846,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   		tVType;
   WlzTransformType trType = WLZ_TRANSFORM_EMPTY;
   AlcKDTTree	*tTree = NULL;
+  WlzRegICPCtl	lCtl;
   WlzAffineTransform *tTr,
   		*globTr = NULL;
   WlzGMShell 	*cSS,
@@ -654,6 +865,15 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 
   tVBuf.v = sVBuf.v = NULL;
   tVx.v = tNr.v = sVx.v = sNr.v = NULL;
+  if(ctl)
+  {
+    lCtl = *ctl;
+  }
+  else
+  {
+    (void )memset(&lCtl, 0, sizeof(WlzRegICPCtl));
+  }
+  lCtl.fTree = NULL;
   if((tCtr == NULL) || (sCtr == NULL) ||
      ((tGM = tCtr->model) == NULL) || ((sGM = sCtr->model) == NULL))
   {
@@ -756,6 +976,19 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   {
     tTree = WlzVerticesBuildTree(vType, nTV, tVx, vIBuf, &errNum);
   }
+  /* Build a flat kD-tree from the same vertices for the correspondence
+   * search, which unlike the kD-tree above is used concurrently. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlcErrno	alcErr = ALC_ER_NONE;
+
+    lCtl.fTree = AlcKDTFlatNew((vType == WLZ_VERTEX_D2)? 2: 3, nTV,
+			       (double *)(tVx.v), 0, &alcErr);
+    if(alcErr != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   /* Register the vertices of the source model to those of the target. */
   if(errNum == WLZ_ERR_NONE)
   {
@@ -765,13 +998,16 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 				 vIBuf, tVBuf, sVBuf, wBuf,
 				 maxItr, initTr, &convFlg,
 				 usrWgtFn, usrWgtData,
-				 delta, 0.25,
+				 delta, 0.25, &lCtl,
 				 &errNum), NULL);
     if((errNum == WLZ_ERR_NONE) && (convFlg == 0))
     {
       errNum = WLZ_ERR_ALG_CONVERGENCE;
     }
   }
+  /* Shells are small compared to the model, so they are registered
+   * without the multi-resolution schedule. */
+  lCtl.nLevels = 0;
   /* If only registering whole source model to whole target model
    * then transform the source model using the computed global
    * transform. */
@@ -797,7 +1033,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 			        maxItr, maxDisp, maxAng, maxDeform,
 				globTr, &convFlg,
 				usrWgtFn, usrWgtData,
-				delta, 0.0, &errNum), NULL);
+				delta, 0.0, &lCtl, &errNum), NULL);
       nSS = cSS->next;
       if((errNum == WLZ_ERR_NONE) && (convFlg == 1))
       {
@@ -890,7 +1126,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 		trType, vType, sgnNrm, nTV, tVx, tNr, nSV, sVx, sNr,
 		vIBuf, tVBuf, sVBuf, wBuf, maxItr,
 		maxDisp, maxAng, maxDeform, minSpx, tTr,
-		usrWgtFn, usrWgtData, delta, 0.0);
+		usrWgtFn, usrWgtData, delta, 0.0, &lCtl);
 	  }
 	}
       }
@@ -954,7 +1190,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 	      trType, vType, sgnNrm, nTV, tVx, tNr, nSV, sVx, sNr,
 	      vIBuf, tVBuf, sVBuf, wBuf, maxItr,
 	      maxDisp, maxAng, maxDeform, minSpx, tTr,
-	      usrWgtFn, usrWgtData, delta, 0.0);
+	      usrWgtFn, usrWgtData, delta, 0.0, &lCtl);
 	}
       }
       if(errNum == WLZ_ERR_NONE)
@@ -1057,7 +1293,11 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   AlcFree(sNr.v);
   (void )WlzFreeAffineTransform(globTr);
   (void )AlcKDTTreeFree(tTree);
-
+  AlcKDTFlatFree(lCtl.fTree);
+  if(ctl)
+  {
+    ctl->nStats = lCtl.nStats;
+  }
   return(errNum);
 }
 
@@ -1203,6 +1443,7 @@ double		WlzMatchICPWeightMatches(WlzVertexType vType,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	ctl			ICP control parameters, may be NULL.
 */
 static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 				WlzGMModel *tGM,
@@ -1219,7 +1460,8 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 				double maxDeform, int minSpx,
 				WlzAffineTransform *gInitTr,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
-				double delta, double minDistWgt)
+				double delta, double minDistWgt,
+				WlzRegICPCtl *ctl)
 {
   int		convFlg,
   		remFlg;
@@ -1248,7 +1490,7 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 			        maxItr, maxDisp, maxAng, maxDeform,
 				initTr, &convFlg,
 				usrWgtFn, usrWgtData,
-				delta, minDistWgt, &errNum),
+				delta, minDistWgt, ctl, &errNum),
 	    NULL);
       remFlg = !convFlg;
       if(errNum == WLZ_ERR_ALG_CONVERGENCE)
@@ -1325,6 +1567,7 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	ctl			ICP control parameters, may be NULL.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -1338,7 +1581,7 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
 				WlzAffineTransform *initTr, int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
-				WlzErrorNum *dstErr)
+				WlzRegICPCtl *ctl, WlzErrorNum *dstErr)
 {
   int		idV,
   		conv = 0;
@@ -1349,11 +1592,11 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
   {
     *(iBuf + idV) = idV;
   }
-  tr = WlzRegICPTreeAndVertices(tTree, trType, vType, sgnNrm,
+  tr = WlzRegICPTreeAndVerticesCtl(tTree, trType, vType, sgnNrm,
   			     nTV, tVx, tNr, nSV, iBuf, sVx, sNr,
 			     tVBuf, sVBuf, wBuf, maxItr, initTr,
 			     &conv, usrWgtFn, usrWgtData,
-			     delta, minDistWgt, &errNum);
+			     delta, minDistWgt, ctl, &errNum);
   if(dstConv)
   {
     *dstConv = conv;
@@ -1412,6 +1655,7 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	ctl			ICP control parameters, may be NULL.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -1430,7 +1674,7 @@ static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
 				WlzAffineTransform *initTr, int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
-				WlzErrorNum *dstErr)
+				WlzRegICPCtl *ctl, WlzErrorNum *dstErr)
 {
   int		nSSV,
   		conv = 0;
@@ -1490,12 +1734,12 @@ static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
 #endif /* WLZ_MATCHICP_DEBUG */
   /* Register the source shell's vertices with the target model using the
    * existing kD-tree. */
-  tr = WlzRegICPTreeAndVertices(tTree, trType, vType, sgnNrm,
+  tr = WlzRegICPTreeAndVerticesCtl(tTree, trType, vType, sgnNrm,
   			  nTV, tVx, tNr, nSSV, iBuf, sVx, sNr,
 			  tVBuf, sVBuf, wBuf,
 			  maxItr, initTr, &conv,
 			  usrWgtFn, usrWgtData,
-			  delta, minDistWgt, &errNum);
+			  delta, minDistWgt, ctl, &errNum);
   if((errNum == WLZ_ERR_ALG_CONVERGENCE) && (conv == 0))
   {
     /* Failure to register a shell is not an error if the shell is
@@ -2853,6 +3097,10 @@ static WlzErrorNum WlzMatchICPRemoveVertices(WlzMatchICPCbData *cbData,
 *				 distances between the vertices.
 *		</ul>
 *		The weight is finally normalized to the range [0-1.0].
+*		The perturbations are generated from a seed computed
+*		from the source vertex, so that the weight does not
+*		depend on the order in which matches are weighted and
+*		this function may be called concurrently.
 *		TODO This code doesn't work when optimized, why?
 * \param	curTr			Current affine transform.
 * \param	tree			Given kD-tree populated by the
@@ -2891,12 +3139,15 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
   WlzGMVertex	*tMV,
   		*tMV0;
   AlcKDTNode	*tNode;
+  unsigned int	rState;
   double	vxD[2];
   const double	delta = 5.0; /* TODO Make delta a parameter. */
 
   if(nScatter > 0)
   {
     wgt = 0.0;
+    rState = ((unsigned int )WLZ_NINT(sMVx.vtX * 16.0) * 73856093u) ^
+             ((unsigned int )WLZ_NINT(sMVx.vtY * 16.0) * 19349663u);
     tMV = WlzGMModelMatchVertexG2D(tGM, tMVx);
     tMLT = tMV->diskT->vertexT->parent->parent;
     tMS = tMLT->parent;
@@ -2904,8 +3155,8 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
     {
       /* Compute a new source vertex with a random displacement
       * (distance < maxDist) from the source vertex. */
-      disp.vtX = ((AlgRandUniform() * 2.0) - 1.0) * delta;
-      disp.vtY = ((AlgRandUniform() * 2.0) - 1.0) * delta;
+      disp.vtX = ((WlzMatchICPRand(&rState) * 2.0) - 1.0) * delta;
+      disp.vtY = ((WlzMatchICPRand(&rState) * 2.0) - 1.0) * delta;
       sMVx0.vtX = sMVx.vtX + disp.vtX;
       sMVx0.vtY = sMVx.vtY + disp.vtY;
       /* Transfrom the source vertex using the current affine transform. */
@@ -2945,6 +3196,28 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
   return(wgt);
 }
 
+/*!
+* \return	Pseudo random value in the range [0.0-1.0).
+* \ingroup	WlzTransform
+* \brief	A small xorshift pseudo random number generator with
+*		the state held by the caller, so unlike AlgRandUniform()
+*		it may be used concurrently and gives repeatable
+*		sequences.
+* \param	state			State of the generator, which is
+*					updated.
+*/
+static double	WlzMatchICPRand(unsigned int *state)
+{
+  unsigned int	x;
+
+  x = (*state != 0)? *state: 0x9e3779b9u;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return((double )(x) / 4294967296.0);
+}
+
 /*!
 * \return	Weight value in the range [0.0-1.0].
 * \ingroup      WlzTransform
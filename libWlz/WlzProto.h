@@ -541,6 +541,11 @@ extern WlzBSpline		*WlzAffineTransformBSpline(
 				  int newBSFlg,
 				  WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
+extern WlzIdxMesh		*WlzAffineTransformIdxMesh(
+				  WlzIdxMesh *srcMesh,
+				  WlzAffineTransform *tr,
+				  int newMeshFlg,
+				  WlzErrorNum *dstErr);
 extern WlzErrorNum	     	WlzAffineTransformPrimGet(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim *prim);
@@ -1113,6 +1118,22 @@ extern double          		WlzBasisFnValueMOSPhi(
 				  double r,
 				  double delta,
 				  double tau);
+extern WlzDVertex2		WlzBasisFnValueCS2D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex2 srcVx);
+extern WlzDVertex3		WlzBasisFnValueCS3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
+extern WlzErrorNum		WlzBasisFnValueBatch2D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx);
+extern WlzErrorNum		WlzBasisFnValueBatch3D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex3 *srcVx,
+				  WlzDVertex3 *dstVx);
 #ifndef WLZ_EXT_BIND
 extern WlzBasisFn		*WlzBasisFnGauss2DFromCPts(
 				  int nPts,
@@ -1187,6 +1208,24 @@ extern WlzBasisFn 		*WlzBasisFnScalarMOS3DFromCPts(
 				  double *alpha,
 				  double *param,
 				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnItr2DFromCPts(
+				  WlzFnType type,
+				  int nPts,
+				  WlzDVertex2 *dPts,
+				  WlzDVertex2 *sPts,
+				  double param,
+				  double tol,
+				  int maxItr,
+				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnItr3DFromCPts(
+				  WlzFnType type,
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  double param,
+				  double tol,
+				  int maxItr,
+				  WlzErrorNum *dstErr);
 #endif
 
 /************************************************************************
@@ -2357,6 +2396,10 @@ extern WlzContour		*WlzContourFromPoints(
 				  double tau,
 				  double samFac,
 				  WlzErrorNum *dstErr);
+extern WlzIdxMesh		*WlzContourIsoIdxMesh3D(
+				  WlzObject *srcObj,
+				  double isoVal,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -2661,6 +2704,40 @@ extern WlzObject 		*WlzDomainFill3D(
 				  WlzObject *obj,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzDomainIndex.c							*
+************************************************************************/
+extern WlzDomainIndex		*WlzMakeDomainIndex(
+				  int nObj,
+				  WlzObject **objs,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeDomainIndex(
+				  WlzDomainIndex *idx);
+extern WlzErrorNum		WlzDomainIndexQuery(
+				  WlzDomainIndex *idx,
+				  WlzObject *qObj,
+				  double dist,
+				  int *dstNHit,
+				  int **dstHit,
+				  WlzLong **dstVol);
+extern WlzErrorNum		WlzDomainIndexQueryAll(
+				  WlzDomainIndex *idx,
+				  int nObj,
+				  WlzObject **objs,
+				  double dist,
+				  int **dstOff,
+				  int **dstHit,
+				  WlzLong **dstVol);
+extern WlzLong			WlzDomainOverlapVolume(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr);
+extern int			WlzDomainWithinDist(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  double dist,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzDomainNearby.c							*
 ************************************************************************/
@@ -3795,6 +3872,54 @@ extern WlzErrorNum 		WlzGreyNormalise(
 				  WlzObject *obj,
 				  int dither);
 
+/************************************************************************
+* WlzGreyPipe.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzGreyPipe		*WlzMakeGreyPipe(
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeGreyPipe(
+				  WlzGreyPipe *pipe);
+extern WlzErrorNum		WlzGreyPipeAddScalar(
+				  WlzGreyPipe *pipe,
+				  WlzBinaryOperatorType op,
+				  double val,
+				  WlzGreyType gType);
+extern WlzErrorNum		WlzGreyPipeAddLUT(
+				  WlzGreyPipe *pipe,
+				  WlzObject *lutObj);
+extern WlzErrorNum		WlzGreyPipeAddRange(
+				  WlzGreyPipe *pipe,
+				  double min,
+				  double max,
+				  double newMin,
+				  double newMax,
+				  WlzGreyType gType);
+extern WlzErrorNum		WlzGreyPipeAddThreshold(
+				  WlzGreyPipe *pipe,
+				  double thrV,
+				  WlzThresholdType thrType,
+				  double outV);
+extern WlzErrorNum		WlzGreyPipeAddMask(
+				  WlzGreyPipe *pipe,
+				  WlzObject *mObj,
+				  double outV);
+extern WlzErrorNum		WlzGreyPipeSetReduce(
+				  WlzGreyPipe *pipe,
+				  unsigned int reduce,
+				  int nBins,
+				  double binOrigin,
+				  double binSize);
+extern WlzObject		*WlzGreyPipeRun(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj,
+				  int inPlace,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzGreyPipeReduce(
+				  WlzGreyPipe *pipe,
+				  WlzObject *gObj);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzGreyRange.c							*
 ************************************************************************/
@@ -3950,6 +4075,15 @@ extern double			WlzGreyValueGetD(
 				  double plane,
 				  double line,
 				  double kol);
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzGreyValueGetBatch(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzInterpolationType interp,
+				  WlzVertexType vType,
+				  int nPos,
+				  WlzVertexP pos,
+				  double *dst);
+#endif /* WLZ_EXT_BIND */
 extern void	                WlzGreyValueGetDir(
 				  WlzGreyValueWSpace *gVWSp,
 				  int plane,
@@ -4072,6 +4206,35 @@ extern WlzObject		*WlzHyThreshold(
 				  WlzConnectType con,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzIdxMesh.c								*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzIdxMesh		*WlzMakeIdxMesh(
+				  WlzObjectType type,
+				  int maxVtx,
+				  int maxElm,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeIdxMesh(
+				  WlzIdxMesh *mesh);
+extern WlzErrorNum		WlzIdxMeshReserve(
+				  WlzIdxMesh *mesh,
+				  int maxVtx,
+				  int maxElm);
+extern WlzGMModel		*WlzIdxMeshToGMModel(
+				  WlzIdxMesh *mesh,
+				  WlzErrorNum *dstErr);
+extern WlzIdxMesh		*WlzIdxMeshCopy(
+				  WlzIdxMesh *mesh,
+				  WlzErrorNum *dstErr);
+extern WlzIdxMesh		*WlzIdxMeshFromGMModel(
+				  WlzGMModel *model,
+				  WlzErrorNum *dstErr);
+extern WlzIdxMesh		*WlzIdxMeshFromCMesh(
+				  WlzCMeshP cMesh,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzImageArithmetic.c							*
 ************************************************************************/
@@ -4462,6 +4625,12 @@ extern WlzObject		*WlzLabel3D(
 				  int ignLn,
 				  WlzConnectType con,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzLabel3DRuns(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int lblVal,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzLaplacian.c							*
@@ -4866,6 +5035,24 @@ extern WlzErrorNum		WlzMatchICPObjs(
 				  int matchImpNN,
 				  double matchImpThr,
 				  double delta);
+extern WlzErrorNum		WlzMatchICPObjsCtl(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  int *dstNMatch,
+				  WlzVertexP *dstTMatch,
+				  WlzVertexP *dstSMatch,
+				  int maxItr,
+				  int minSpx,
+				  int minSegSpx,
+				  int brkFlg,
+				  double maxDisp,
+				  double maxAng,
+				  double maxDeform,
+				  int matchImpNN,
+				  double matchImpThr,
+				  double delta,
+				  WlzRegICPCtl *ctl);
 extern WlzErrorNum  		WlzMatchICPCtr(
 				  WlzContour *tCtr,
 				  WlzContour *sCtr,
@@ -4885,6 +5072,26 @@ extern WlzErrorNum  		WlzMatchICPCtr(
                                   WlzRegICPUsrWgtFn usrWgtFn,
                                   void *usrWgtData,
 				  double delta);
+extern WlzErrorNum  		WlzMatchICPCtrCtl(
+				  WlzContour *tCtr,
+				  WlzContour *sCtr,
+                                  WlzAffineTransform *initTr,
+                                  int maxItr,
+				  int minSpx,
+				  int minSegSpx,
+                                  int *dstNMatch,
+				  WlzVertexP *dstTMatch,
+                                  WlzVertexP *dstSMatch,
+				  int brkFlg,
+                                  double  maxDisp,
+				  double maxAng,
+                                  double maxDeform,
+                                  int matchImpNN,
+				  double matchImpThr,
+                                  WlzRegICPUsrWgtFn usrWgtFn,
+                                  void *usrWgtData,
+				  double delta,
+				  WlzRegICPCtl *ctl);
 extern double          		WlzMatchICPWeightMatches(
 				  WlzVertexType vType,
 				  WlzAffineTransform *curTr,
@@ -5740,7 +5947,15 @@ extern WlzObjectType		WlzReadObjType(
 extern WlzObject		*WlzReadObj(
 				  FILE *fP,
 			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjRegion(
+				  FILE *fP,
+				  WlzIBox3 box,
+			          WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
+extern WlzObject		*WlzReadObjTileCached(
+				  FILE *fP,
+				  WlzTileCache *cache,
+			          WlzErrorNum *dstErr);
 extern WlzMeshTransform3D 	*WlzReadMeshTransform3D(
 				  FILE *fP,
 				  WlzErrorNum *dstErr);
@@ -5869,6 +6084,30 @@ extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr); 
+extern WlzAffineTransform	*WlzRegICPTreeAndVerticesCtl(
+				  AlcKDTTree *tree,
+				  WlzTransformType trType,
+				  WlzVertexType vType,
+				  int sgnNrm,
+				  int nT,
+				  WlzVertexP tVx,
+				  WlzVertexP tNr,
+				  int nS,
+				  int *sIdx,
+				  WlzVertexP sVx,
+				  WlzVertexP sNr,
+				  WlzVertexP tVxBuf,
+				  WlzVertexP sVxBuf,
+				  double *wgtBuf,
+				  int maxItr,
+				  WlzAffineTransform *initTr,
+				  int *dstConv,
+				  WlzRegICPUsrWgtFn usrWgtFn,
+				  void *usrWgtData,
+				  double delta,
+				  double minDistWgt,
+				  WlzRegICPCtl *ctl,
+				  WlzErrorNum *dstErr); 
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -5884,6 +6123,15 @@ extern WlzRCCClass		WlzRegConCalcRCC(
 				  int *dstSizeArrayStats,
 				  double **dstArrayStats,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzRegConCalcRCCBatch(
+				  WlzObject *obj0,
+				  int nObj,
+				  WlzObject **objs,
+				  int noEnc,
+				  int noOst,
+				  int maxOstDist,
+				  WlzRCCClass *dstCls,
+				  double *dstStats);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6005,6 +6253,24 @@ extern WlzObject 		*WlzScalarFn(
 				  WlzFnType fn,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzScanPar.c								*
+************************************************************************/
+extern WlzScanParChunk		*WlzScanParChunks(
+				  WlzObject *obj,
+				  int nChk,
+				  int *dstNChk,
+				  WlzErrorNum *dstErr);
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzScanPar(
+				  WlzObject *obj,
+				  WlzScanParChunk *chk,
+				  int nChk,
+				  int grey,
+				  WlzScanParFn fn,
+				  void *data);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzSepFilter.c
 ************************************************************************/
@@ -6028,6 +6294,16 @@ extern WlzObject		*WlzGaussFilter(
 				  double padVal,
 				  int sep,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzSepFilterWindowed(
+				  WlzObject *inObj,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  WlzGreyType iType,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6597,6 +6873,40 @@ extern WlzObject 		*WlzThreshold(
 				  WlzThresholdType highlow,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzTileCache.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzTileCache		*WlzMakeTileCache(
+				  size_t maxSz,
+				  WlzErrorNum *dstErr);
+extern WlzTileCache		*WlzAssignTileCache(
+				  WlzTileCache *cache,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeTileCache(
+				  WlzTileCache *cache);
+extern WlzErrorNum		WlzTiledValuesSetTileCache(
+				  WlzTiledValues *tv,
+				  WlzTileCache *cache,
+				  int fd);
+extern void			WlzTiledValuesClearTileCache(
+				  WlzTiledValues *tv);
+extern WlzTileCacheEntry	*WlzTileCacheAcquire(
+				  WlzTiledValues *tv,
+				  size_t idx,
+				  WlzErrorNum *dstErr);
+extern void			WlzTileCacheRelease(
+				  WlzTileCacheEntry *ent);
+extern WlzGreyP			WlzTileCachePin(
+				  WlzTiledValues *tv,
+				  WlzTileCacheEntry **pin,
+				  int nPin,
+				  size_t idx);
+extern void			WlzTileCacheUnpin(
+				  WlzTileCacheEntry **pin,
+				  int nPin);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzTiledValues.c							*
 ************************************************************************/
@@ -6640,6 +6950,14 @@ extern WlzObject		*WlzMakeTiledValuesObj3D(
 				  unsigned int *vDim,
 				  WlzPixelV bgdV,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzMakeTiledValuesObj3DNoTiles(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  WlzGreyType gType,
+				  unsigned int vRank,
+				  unsigned int *vDim,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr);
 extern WlzTiledValueBuffer	*WlzMakeTiledValueBuffer(
 				  WlzTiledValues *tVal,
 				  WlzErrorNum *dstErr);
@@ -6760,6 +7078,118 @@ extern size_t			WlzValueSqueeze(
 				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
+/************************************************************************
+* WlzValueKernel.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzSIMDType		WlzValueKrnSIMDType(void);
+extern WlzSIMDType		WlzValueKrnSetSIMDType(
+				  WlzSIMDType simd);
+extern void			WlzValueKrnSetInt(
+				  int *dst,
+				  int value,
+				  size_t count);
+extern void			WlzValueKrnSetFloat(
+				  float *dst,
+				  float value,
+				  size_t count);
+extern void			WlzValueKrnSetDouble(
+				  double *dst,
+				  double value,
+				  size_t count);
+extern void			WlzValueKrnSetRGBA(
+				  WlzUInt *dst,
+				  WlzUInt value,
+				  size_t count);
+extern void			WlzValueKrnCopyUByteToInt(
+				  int *dst,
+				  WlzUByte *src,
+				  size_t count);
+extern void			WlzValueKrnCopyUByteToDouble(
+				  double *dst,
+				  WlzUByte *src,
+				  size_t count);
+extern void			WlzValueKrnCopyUByteToRGBA(
+				  WlzUInt *dst,
+				  WlzUByte *src,
+				  size_t count);
+extern void			WlzValueKrnCopyShortToInt(
+				  int *dst,
+				  short *src,
+				  size_t count);
+extern void			WlzValueKrnCopyShortToDouble(
+				  double *dst,
+				  short *src,
+				  size_t count);
+extern void			WlzValueKrnCopyIntToDouble(
+				  double *dst,
+				  int *src,
+				  size_t count);
+extern void			WlzValueKrnCopyFloatToDouble(
+				  double *dst,
+				  float *src,
+				  size_t count);
+extern void			WlzValueKrnClampIntToShort(
+				  short *dst,
+				  int *src,
+				  size_t count);
+extern void			WlzValueKrnClampIntToUByte(
+				  WlzUByte *dst,
+				  int *src,
+				  size_t count);
+extern void			WlzValueKrnClampShortToUByte(
+				  WlzUByte *dst,
+				  short *src,
+				  size_t count);
+extern void			WlzValueKrnClampIntToRGBA(
+				  WlzUInt *dst,
+				  int *src,
+				  size_t count);
+extern void			WlzValueKrnClampDoubleToInt(
+				  int *dst,
+				  double *src,
+				  size_t count);
+extern void			WlzValueKrnClampDoubleToShort(
+				  short *dst,
+				  double *src,
+				  size_t count);
+extern void			WlzValueKrnClampDoubleToUByte(
+				  WlzUByte *dst,
+				  double *src,
+				  size_t count);
+extern void			WlzValueKrnClampDoubleToFloat(
+				  float *dst,
+				  double *src,
+				  size_t count);
+extern WlzErrorNum		WlzValueKrnBinOpInt(
+				  int *dst,
+				  int *src,
+				  size_t count,
+				  WlzBinaryOperatorType op);
+extern WlzErrorNum		WlzValueKrnBinOpDouble(
+				  double *dst,
+				  double *src,
+				  size_t count,
+				  WlzBinaryOperatorType op);
+extern void			WlzValueKrnMulAddDouble(
+				  double *dst,
+				  double *src,
+				  double m,
+				  double a,
+				  size_t count);
+extern WlzErrorNum		WlzValueKrnBinOpRGBA(
+				  WlzUInt *dst,
+				  WlzUInt *src,
+				  size_t count,
+				  WlzBinaryOperatorType op);
+extern WlzErrorNum		WlzValueKrnScalarOpRGBA(
+				  WlzUInt *dst,
+				  WlzUInt *src,
+				  int value,
+				  size_t count,
+				  WlzBinaryOperatorType op);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzValueUtils.c							*
 ************************************************************************/
@@ -7317,6 +7747,11 @@ extern const char 		*WlzWindowFnName(
 extern WlzErrorNum 		WlzWriteObj(
 				  FILE *fp,
 			          WlzObject *obj);
+extern WlzErrorNum 		WlzWriteObjChunked(
+				  FILE *fP,
+			          WlzObject *obj,
+				  WlzChunkCodec codec,
+				  int bandLn);
 
 #ifndef WLZ_EXT_BIND
 extern WlzErrorNum  		WlzWriteMeshTransform3D(
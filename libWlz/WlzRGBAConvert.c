@@ -307,7 +307,7 @@ static WlzCompoundArray *WlzRGBAToCompound3D(
 	else {nvoxtab->bckgrnd.v.ubv = WLZ_RGBA_ALPHA_GET(voxtab->bckgrnd.v.rgbv);}
 
 	vals.vox = nvoxtab;
-	objs[i] = WlzMakeMain(WLZ_3D_DOMAINOBJ, obj->domain, vals, NULL, obj, &errNum);
+	objs[i] = WlzMakeMain(WLZ_3D_DOMAINOBJ, obj->domain, vals, NULL, NULL, &errNum);
       }
       else {
 	objs[i] = NULL;
@@ -42,11 +42,42 @@ static char _WlzRGBAImageArithmetic_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzRGBAImageArithmeticScanData
+* \ingroup	WlzArithmetic
+* \brief	Data passed to the parallel scan callback used by
+* 		WlzRGBAImageArithmetic().
+*/
+typedef struct _WlzRGBAImageArithmeticScanData
+{
+  WlzObject		*obj[2];	/*!< The given objects. */
+  WlzBinaryOperatorType	op;		/*!< Binary operator. */
+} WlzRGBAImageArithmeticScanData;
+
+static int			WlzRGBAImageArithmeticHasKrn(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzBinaryOperatorType op);
+static WlzObject		*WlzRGBAImageArithmeticKrn(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzRGBAImageArithmeticScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+
 /*!
 * \return	New object.
 * \ingroup	WlzArithmetic
 * \brief	Performs image arithmetic on objects with RGBA values.
-* 		See WlzImageArithmetic().
+* 		See WlzImageArithmetic(). Each channel is computed as
+* 		by WlzImageArithmetic() and clamped to the range
+* 		[0-255]. Where there are packed RGBA value kernels for
+* 		the operator (see WlzValueKrnBinOpRGBA()) the values are
+* 		combined directly, otherwise they are split into channel
+* 		objects which are combined by WlzImageArithmetic() and
+* 		then packed again.
 * \param	obj0			First object.
 * \param	obj1			Second object.
 * \param	op			Binary operator.
@@ -82,6 +113,10 @@ WlzObject *WlzRGBAImageArithmetic(
 	  (WlzGreyTypeFromObj(obj1, NULL) != WLZ_GREY_RGBA) ){
     errNum = WLZ_ERR_OBJECT_TYPE;
   }
+  else if( WlzRGBAImageArithmeticHasKrn(obj0, obj1, op) ){
+    /* combine the packed values */
+    rtnObj = WlzRGBAImageArithmeticKrn(obj0, obj1, op, &errNum);
+  }
   else {
     /* convert to compound */
     cmpnd0 = WlzRGBAToCompound(obj0, WLZ_RGBA_SPACE_RGB, &errNum);
@@ -105,14 +140,14 @@ WlzObject *WlzRGBAImageArithmetic(
     /* free temporary objects */
     WlzFreeObj((WlzObject *) cmpnd0);
     WlzFreeObj((WlzObject *) cmpnd1);
-  }
 
-  /* convert back to RGBA  */
-  if( errNum == WLZ_ERR_NONE ){
-    rtnObj = WlzCompoundToRGBA(rtnCmpnd, WLZ_RGBA_SPACE_RGB, &errNum);
-  }
-  if( rtnCmpnd ){
-    WlzFreeObj((WlzObject *)rtnCmpnd);
+    /* convert back to RGBA  */
+    if( errNum == WLZ_ERR_NONE ){
+      rtnObj = WlzCompoundToRGBA(rtnCmpnd, WLZ_RGBA_SPACE_RGB, &errNum);
+    }
+    if( rtnCmpnd ){
+      WlzFreeObj((WlzObject *)rtnCmpnd);
+    }
   }
 
   if( dstErr ){
@@ -120,3 +155,198 @@ WlzObject *WlzRGBAImageArithmetic(
   }
   return rtnObj;
 }
+
+/*!
+* \return	Non zero if the packed RGBA value kernels can be used.
+* \ingroup	WlzArithmetic
+* \brief	Checks whether there is a packed RGBA value kernel for
+* 		the operator and whether the values of both the given
+* 		objects can be scanned directly.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	op			Binary operator.
+*/
+static int	WlzRGBAImageArithmeticHasKrn(WlzObject *obj0,
+					     WlzObject *obj1,
+					     WlzBinaryOperatorType op)
+{
+  int		krn = 0;
+
+  switch(op)
+  {
+    case WLZ_BO_ADD:		/* FALLTHROUGH */
+    case WLZ_BO_SUBTRACT:	/* FALLTHROUGH */
+    case WLZ_BO_MULTIPLY:	/* FALLTHROUGH */
+    case WLZ_BO_MIN:		/* FALLTHROUGH */
+    case WLZ_BO_MAX:		/* FALLTHROUGH */
+    case WLZ_BO_AND:		/* FALLTHROUGH */
+    case WLZ_BO_OR:		/* FALLTHROUGH */
+    case WLZ_BO_XOR:
+      krn = ((obj0->type == WLZ_2D_DOMAINOBJ) ||
+             (obj0->type == WLZ_3D_DOMAINOBJ)) &&
+	    (WlzGreyTableIsTiled(obj0->values.core->type) == 0) &&
+	    (WlzGreyTableIsTiled(obj1->values.core->type) == 0);
+      break;
+    default:
+      break;
+  }
+  return(krn);
+}
+
+/*!
+* \return	New object with the intersection domain of the given
+* 		objects.
+* \ingroup	WlzArithmetic
+* \brief	Performs image arithmetic on objects with RGBA values
+* 		using the packed RGBA value kernels. The objects are
+* 		scanned in parallel using WlzScanPar().
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	op			Binary operator which must have
+* 					a packed RGBA value kernel.
+* \param	dstErr			Destination error pointer, may
+* 					be NULL.
+*/
+static WlzObject *WlzRGBAImageArithmeticKrn(WlzObject *obj0,
+					    WlzObject *obj1,
+					    WlzBinaryOperatorType op,
+					    WlzErrorNum *dstErr)
+{
+  WlzObjectType	vType;
+  WlzPixelV	bgd[2];
+  WlzObject	*iObj = NULL,
+  		*rtnObj = NULL;
+  WlzRGBAImageArithmeticScanData scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  iObj = WlzIntersect2(obj0, obj1, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (iObj->type == WLZ_EMPTY_OBJ))
+  {
+    rtnObj = WlzMakeEmpty(&errNum);
+  }
+  else
+  {
+    /* The background is the operator applied to the backgrounds. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bgd[0] = WlzGetBackground(obj0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bgd[1] = WlzGetBackground(obj1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzValueConvertPixel(bgd + 0, bgd[0], WLZ_GREY_RGBA);
+      (void )WlzValueConvertPixel(bgd + 1, bgd[1], WLZ_GREY_RGBA);
+      errNum = WlzValueKrnBinOpRGBA(&(bgd[1].v.rgbv), &(bgd[0].v.rgbv), 1,
+      				    op);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      vType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_RGBA,
+				    &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rtnObj = WlzNewObjectValues(iObj, vType, bgd[1], 0, bgd[1], &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      scan.obj[0] = obj0;
+      scan.obj[1] = obj1;
+      scan.op = op;
+      errNum = WlzScanPar(rtnObj, NULL, 0, 1, WlzRGBAImageArithmeticScanFn,
+      			  &scan);
+    }
+  }
+  (void )WlzFreeObj(iObj);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rtnObj);
+    rtnObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rtnObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Parallel scan callback for WlzRGBAImageArithmeticKrn()
+* 		which combines the values of the given objects for the
+* 		current piece of the return object. The return object
+* 		has the intersection domain of the given objects, so
+* 		the given objects are scanned in step with it through
+* 		its domain.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzRGBAImageArithmeticScanFn(WlzScanParWSpace *pWSp,
+						void *data)
+{
+  int		idx;
+  WlzObject	*obj2D[2];
+  WlzIntervalWSpace iWSp[2];
+  WlzGreyWSpace	gWSp[2];
+  WlzRGBAImageArithmeticScanData *scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  scan = (WlzRGBAImageArithmeticScanData *)data;
+  obj2D[0] = obj2D[1] = NULL;
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+  {
+    WlzValues	val;
+    WlzObject	*obj;
+
+    obj = scan->obj[idx];
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      val = obj->values;
+    }
+    else
+    {
+      val = obj->values.vox->values[pWSp->plane - obj->values.vox->plane1];
+    }
+    obj2D[idx] = WlzMakeMain(WLZ_2D_DOMAINOBJ, pWSp->obj2D->domain, val,
+    			     NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitGreyScan(obj2D[idx], iWSp + idx, gWSp + idx);
+      if(errNum != WLZ_ERR_NONE)
+      {
+        (void )WlzFreeObj(obj2D[idx]);
+	obj2D[idx] = NULL;
+      }
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(&(pWSp->iWSp))) == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(iWSp + 0)) == WLZ_ERR_NONE) &&
+        ((errNum = WlzNextGreyInterval(iWSp + 1)) == WLZ_ERR_NONE))
+  {
+    size_t	n;
+
+    n = pWSp->iWSp.rgtpos - pWSp->iWSp.lftpos + 1;
+    WlzValueCopyRGBAToRGBA(pWSp->gWSp.u_grintptr.rgbp,
+    			   gWSp[1].u_grintptr.rgbp, n);
+    errNum = WlzValueKrnBinOpRGBA(pWSp->gWSp.u_grintptr.rgbp,
+    				  gWSp[0].u_grintptr.rgbp, n, scan->op);
+  }
+  if(errNum == WLZ_ERR_EOO)
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  for(idx = 0; idx < 2; ++idx)
+  {
+    if(obj2D[idx])
+    {
+      (void )WlzEndGreyScan(iWSp + idx, gWSp + idx);
+      (void )WlzFreeObj(obj2D[idx]);
+    }
+  }
+  return(errNum);
+}
@@ -41,10 +41,43 @@ static char _WlzRGBAScalarBinaryOp_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzRGBAScalarBinaryOpScanData
+* \ingroup	WlzArithmetic
+* \brief	Data passed to the parallel scan callback used by
+* 		WlzRGBAScalarBinaryOp().
+*/
+typedef struct _WlzRGBAScalarBinaryOpScanData
+{
+  WlzObject		*o3;		/*!< Object for the return values. */
+  int			val;		/*!< Operand value. */
+  WlzBinaryOperatorType	op;		/*!< Operator to be applied. */
+} WlzRGBAScalarBinaryOpScanData;
+
+static int			WlzRGBAScalarBinaryOpHasKrn(
+				  WlzObject *o1,
+				  WlzPixelV pval,
+				  WlzBinaryOperatorType op);
+static WlzObject		*WlzRGBAScalarBinaryOpKrn(
+				  WlzObject *o1,
+				  WlzPixelV pval,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzRGBAScalarBinaryOpScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzAritmetic
 * \brief	Performs scalar operation on objects with RGBA values.
+* 		Each channel is computed as by WlzScalarBinaryOp().
+* 		Where the operand is an integer and there is a packed
+* 		RGBA value kernel for the operator (see
+* 		WlzValueKrnScalarOpRGBA()) the values are operated on
+* 		directly, otherwise they are split into channel objects
+* 		which are operated on by WlzScalarBinaryOp() and then
+* 		packed again.
 * \param	o1			Input object.
 * \param	pval			Operand value.
 * \param	op			Opertor to be applied.
@@ -68,6 +101,10 @@ WlzObject *WlzRGBAScalarBinaryOp(
   else if((WlzGreyTypeFromObj(o1, NULL) != WLZ_GREY_RGBA) ){
     errNum = WLZ_ERR_OBJECT_TYPE;
   }
+  else if( WlzRGBAScalarBinaryOpHasKrn(o1, pval, op) ){
+    /* operate on the packed values */
+    rtnObj = WlzRGBAScalarBinaryOpKrn(o1, pval, op, &errNum);
+  }
   else {
     /* convert to compound */
     cmpnd0 = WlzRGBAToCompound(o1, WLZ_RGBA_SPACE_RGB, &errNum);
@@ -77,20 +114,168 @@ WlzObject *WlzRGBAScalarBinaryOp(
       WlzScalarBinaryOp(cmpnd0->o[i], pval, cmpnd0->o[i], op);
     }
 
+    /* convert back to RGBA  */
+    if( errNum == WLZ_ERR_NONE ){
+      rtnObj = WlzCompoundToRGBA(cmpnd0, WLZ_RGBA_SPACE_RGB, &errNum);
+    }
+    if( cmpnd0 ){
+      WlzFreeObj((WlzObject *) cmpnd0);
+    }
   }
 
-
-  /* convert back to RGBA  */
-  if( errNum == WLZ_ERR_NONE ){
-    rtnObj = WlzCompoundToRGBA(cmpnd0, WLZ_RGBA_SPACE_RGB, &errNum);
+  if( dstErr ){
+    *dstErr = errNum;
   }
-  if( cmpnd0 ){
-    WlzFreeObj((WlzObject *) cmpnd0);
+  return(rtnObj);
+}
+
+/*!
+* \return	Non zero if the packed RGBA value kernels can be used.
+* \ingroup	WlzArithmetic
+* \brief	Checks whether there is a packed RGBA value kernel for
+* 		the operator and operand and whether the values of the
+* 		given object can be scanned directly.
+* \param	o1			Input object.
+* \param	pval			Operand value.
+* \param	op			Opertor to be applied.
+*/
+static int	WlzRGBAScalarBinaryOpHasKrn(WlzObject *o1, WlzPixelV pval,
+					    WlzBinaryOperatorType op)
+{
+  int		krn = 0;
+
+  switch(op)
+  {
+    case WLZ_BO_ADD:		/* FALLTHROUGH */
+    case WLZ_BO_SUBTRACT:	/* FALLTHROUGH */
+    case WLZ_BO_MULTIPLY:	/* FALLTHROUGH */
+    case WLZ_BO_AND:		/* FALLTHROUGH */
+    case WLZ_BO_OR:		/* FALLTHROUGH */
+    case WLZ_BO_XOR:
+      krn = ((pval.type == WLZ_GREY_INT) ||
+             (pval.type == WLZ_GREY_SHORT) ||
+	     (pval.type == WLZ_GREY_UBYTE)) &&
+	    ((o1->type == WLZ_2D_DOMAINOBJ) ||
+	     (o1->type == WLZ_3D_DOMAINOBJ)) &&
+	    (WlzGreyTableIsTiled(o1->values.core->type) == 0);
+      break;
+    default:
+      break;
   }
+  return(krn);
+}
 
+/*!
+* \return	New object with the domain of the given object.
+* \ingroup	WlzArithmetic
+* \brief	Performs scalar operation on objects with RGBA values
+* 		using the packed RGBA value kernels. The object is
+* 		scanned in parallel using WlzScanPar().
+* \param	o1			Input object.
+* \param	pval			Integer operand value.
+* \param	op			Opertor to be applied which must
+* 					have a packed RGBA value kernel.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzRGBAScalarBinaryOpKrn(WlzObject *o1, WlzPixelV pval,
+					   WlzBinaryOperatorType op,
+					   WlzErrorNum *dstErr)
+{
+  WlzObjectType	vType;
+  WlzPixelV	bgd;
+  WlzObject	*rtnObj = NULL;
+  WlzRGBAScalarBinaryOpScanData scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if( dstErr ){
+  /* The background is unchanged, as for WlzScalarBinaryOp(). */
+  bgd = WlzGetBackground(o1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )WlzValueConvertPixel(&bgd, bgd, WLZ_GREY_RGBA);
+    vType = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, WLZ_GREY_RGBA,
+				  &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rtnObj = WlzNewObjectValues(o1, vType, bgd, 0, bgd, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )WlzValueConvertPixel(&pval, pval, WLZ_GREY_INT);
+    scan.o3 = rtnObj;
+    scan.val = pval.v.inv;
+    scan.op = op;
+    errNum = WlzScanPar(o1, NULL, 0, 1, WlzRGBAScalarBinaryOpScanFn, &scan);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rtnObj);
+    rtnObj = NULL;
+  }
+  if(dstErr)
+  {
     *dstErr = errNum;
   }
   return(rtnObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Parallel scan callback for WlzRGBAScalarBinaryOpKrn()
+* 		which applies the operator to the current piece of the
+* 		input object putting the result in the matching piece of
+* 		the return object. The return object has the same domain
+* 		so its intervals are scanned in step with those of the
+* 		input object.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzRGBAScalarBinaryOpScanFn(WlzScanParWSpace *pWSp,
+					       void *data)
+{
+  WlzValues	val;
+  WlzObject	*obj2D = NULL;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzRGBAScalarBinaryOpScanData *scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  scan = (WlzRGBAScalarBinaryOpScanData *)data;
+  if(scan->o3->type == WLZ_2D_DOMAINOBJ)
+  {
+    val = scan->o3->values;
+  }
+  else
+  {
+    val = scan->o3->values.vox->values[pWSp->plane -
+    				       scan->o3->values.vox->plane1];
+  }
+  obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, pWSp->obj2D->domain, val,
+  		      NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while(((errNum = WlzNextGreyInterval(&(pWSp->iWSp))) == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      errNum = WlzValueKrnScalarOpRGBA(gWSp.u_grintptr.rgbp,
+				       pWSp->gWSp.u_grintptr.rgbp, scan->val,
+				       pWSp->iWSp.colrmn, scan->op);
+      if(errNum != WLZ_ERR_NONE)
+      {
+        break;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_EOO)
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  (void )WlzFreeObj(obj2D);
+  return(errNum);
+}
@@ -47,42 +47,123 @@ static char _WlzRank_c[] = "University of Edinburgh $Id$";
 #include <string.h>
 #include <Wlz.h>
 
-static WlzErrorNum 		WlzRankFilterDomObj2D(
-				  WlzObject *gObj,
-				  int fSz,
-				  double rank);
-static WlzErrorNum 		WlzRankFilterDomObj3D(
-				  WlzObject *gObj,
-				  int fSz,
-				  double rank);
-static void     		WlzRankFilterValLn(WlzObject *gObj,
-				  WlzGreyValueWSpace *gVWSp,
-				  void **vBuf,
-				  WlzUByte **iBuf,
-				  void *rBuf,
-				  int lnPos,
-				  WlzGreyType vType,
-				  WlzIVertex2 bufSz,
-				  double rank);
-static void			WlzRankFilterValPl(
+/*!
+* \def		WLZ_RANKFILTER_CHUNK
+* \ingroup	WlzValuesFilters
+* \brief	Number of adjacent columns which are gathered and filtered
+* 		together in the line and plane passes of the minimum and
+* 		maximum filters.
+*/
+#define WLZ_RANKFILTER_CHUNK	(16)
+
+/*!
+* \def		WLZ_RANKFILTER_HIST_MAX
+* \ingroup	WlzValuesFilters
+* \brief	Maximum number of bins in the sliding histogram used to
+* 		rank integer values. Objects with a wider range of values
+* 		are ranked by selection.
+*/
+#define WLZ_RANKFILTER_HIST_MAX	(1<<16)
+
+/*!
+* \struct	_WlzRankFilterItv
+* \ingroup	WlzValuesFilters
+* \brief	An interval of the object being filtered along with it's
+* 		position in the dense buffer.
+*/
+typedef struct _WlzRankFilterItv
+{
+  int		row;		/*!< Buffer row, plane offset times the
+  				     number of lines plus line offset. */
+  int		kl;		/*!< Buffer column of the first value. */
+  int		len;		/*!< Number of values in the interval. */
+  WlzGreyP	gP;		/*!< The object's values for the interval. */
+} WlzRankFilterItv;
+
+/*!
+* \struct	_WlzRankFilterWSp
+* \ingroup	WlzValuesFilters
+* \brief	Work space for the rank filters. The object's values are
+* 		copied into a dense buffer which covers the bounding box
+* 		of the object, so that the filtered values may be written
+* 		back in place while the rows and planes are filtered in
+* 		parallel.
+*/
+typedef struct _WlzRankFilterWSp
+{
+  int		fSz;		/*!< Filter size within planes. */
+  int		fSz2;		/*!< Offset to the start of the filter
+  				     within planes. */
+  int		fSzZ;		/*!< Filter size through planes, 1 for 2D. */
+  int		fSz2Z;		/*!< Offset to the start of the filter
+  				     through planes. */
+  double	rank;		/*!< Required rank. */
+  WlzGreyType	vType;		/*!< Grey type of the object's values. */
+  WlzIVertex3	bufSz;		/*!< Size of the dense buffer. */
+  WlzGreyP	buf;		/*!< Dense buffer of values. */
+  WlzUByte	*msk;		/*!< Dense buffer which is non-zero within
+  				     the domain, may be NULL if not used. */
+  int		nItv;		/*!< Number of intervals. */
+  WlzRankFilterItv *itv;	/*!< Intervals of the object in row order. */
+  int		*rowItv;	/*!< Index of the first interval of each
+  				     buffer row, with an extra entry for the
+				     end of the last row. */
+} WlzRankFilterWSp;
+
+static void			WlzRankFilterFreeWSp(
+				  WlzRankFilterWSp *wSp);
+static void			WlzRankFilterVHGW(
+				  double *ln,
+				  double *wrk,
+				  int n,
+				  int nC,
+				  int k,
+				  int k2,
+				  int isMax);
+static void			WlzRankFilterRowHist(
+				  WlzRankFilterWSp *wSp,
+				  int row,
+				  int nW,
+				  size_t *winOff,
+				  int vMin,
+				  int nBin,
+				  int *bin,
+				  int *hist,
+				  double *res);
+static void			WlzRankFilterRowSel(
+				  WlzRankFilterWSp *wSp,
+				  int row,
+				  int nW,
+				  size_t *winOff,
+				  double *val,
+				  double *rBuf,
+				  double *res);
+static int			WlzRankFilterRowWin(
+				  WlzRankFilterWSp *wSp,
+				  int row,
+				  size_t *winOff);
+static WlzErrorNum		WlzRankFilterItvs(
 				  WlzObject *gObj,
-				  WlzGreyValueWSpace *gVWSp,
-				  void ***vBuf,
-				  WlzUByte ***iBuf,
-				  void *rBuf,
-				  int plane,
-				  WlzGreyType vType,
-				  WlzIVertex3 bufSz,
-				  double rank);
-static void			WlzRankFilterValues(
-				  WlzGreyValueWSpace *gVWSp,
-				  int posZ,
-				  int posY,
-				  int posX,
-				  WlzGreyType vType,
-				  void *values,
-				  int nValues,
-				  double rank);
+				  WlzRankFilterWSp *wSp);
+static WlzErrorNum		WlzRankFilterItvs2D(
+				  WlzObject *obj,
+				  WlzRankFilterWSp *wSp,
+				  int pln,
+				  WlzIVertex2 org,
+				  int *maxItv);
+static WlzErrorNum		WlzRankFilterToBuf(
+				  WlzRankFilterWSp *wSp,
+				  int useMsk,
+				  WlzGreyV bgdV);
+static WlzErrorNum		WlzRankFilterMinMax(
+				  WlzRankFilterWSp *wSp,
+				  int isMax);
+static WlzErrorNum		WlzRankFilterMinMaxPass(
+				  WlzRankFilterWSp *wSp,
+				  int dir,
+				  int isMax);
+static WlzErrorNum		WlzRankFilterRows(
+				  WlzRankFilterWSp *wSp);
 
 /*!
 * \return	Woolz error code.
@@ -90,8 +171,18 @@ static void			WlzRankFilterValues(
 * \brief	Applies a rank filter in place to the given Woolz object.
 *		Each value of the given object is replaced by the n'th
 *		ranked value of the values in it's immediate neighborhood,
-*		where the neighborhood is a simple axis aligned cuboid
-*		with the size.
+*		where the neighborhood is a simple axis aligned square
+*		(2D) or cube (3D) of the given size clipped to the
+*		object's domain.
+*
+*		The filter used depends on the rank and grey type:
+*		minimum and maximum filters use a seperable van Herk /
+*		Gil-Werman filter which has a constant cost per value
+*		independent of the filter size; other ranks of integer
+*		values use a sliding histogram with a cost per value
+*		which is proportional to the size of the filter's
+*		face and all other ranks are found by selection.
+*		Rows and planes of the object are filtered in parallel.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
@@ -100,8 +191,12 @@ static void			WlzRankFilterValues(
 */
 WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
 {
+  int		fSzZ = 1;
+  WlzGreyType	vType = WLZ_GREY_ERROR;
+  WlzRankFilterWSp wSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  (void )memset(&wSp, 0, sizeof(WlzRankFilterWSp));
   if(gObj == NULL)
   {
     errNum = WLZ_ERR_OBJECT_NULL;
@@ -135,855 +230,1099 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
     switch(gObj->type)
     {
       case WLZ_2D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
 	break;
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+	fSzZ = fSz;
 	break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
     }
   }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    vType = WlzGreyTypeFromObj(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(vType)
+    {
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+        break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  /* Filters of size 0 or 1 leave the values unchanged. */
+  if((errNum == WLZ_ERR_NONE) && (fSz > 1))
+  {
+    int		nMax,
+    		rankI;
+
+    wSp.fSz = fSz;
+    wSp.fSz2 = fSz / 2;
+    wSp.fSzZ = fSzZ;
+    wSp.fSz2Z = fSzZ / 2;
+    wSp.rank = rank;
+    wSp.vType = vType;
+    errNum = WlzRankFilterItvs(gObj, &wSp);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      /* The rank of the n'th value is floor(n * rank), so if this is
+       * the first or last value for the largest neighbourhood it is
+       * for all smaller (clipped) neighbourhoods too. */
+      nMax = fSz * fSz * fSzZ;
+      rankI = (int )floor(nMax * rank);
+      if((rankI == 0) || (rankI == nMax - 1))
+      {
+	errNum = WlzRankFilterMinMax(&wSp, rankI != 0);
+      }
+      else
+      {
+	errNum = WlzRankFilterRows(&wSp);
+      }
+    }
+  }
+  WlzRankFilterFreeWSp(&wSp);
   return(errNum);
 }
 
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Frees the buffers of a rank filter work space, but not
+* 		the work space itself.
+* \param	wSp			Given work space.
+*/
+static void	WlzRankFilterFreeWSp(WlzRankFilterWSp *wSp)
+{
+  AlcFree(wSp->buf.v);
+  AlcFree(wSp->msk);
+  AlcFree(wSp->itv);
+  AlcFree(wSp->rowItv);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Applies a van Herk / Gil-Werman minimum or maximum filter
+* 		to one or more interleaved lines of values, using
+* 		three comparisons per value regardless of the filter
+* 		size. The lines are padded with the identity value
+* 		of the filter and the output value at i is the minimum
+* 		or maximum of the input values from i - k2 to
+* 		i - k2 + k - 1.
+* \param	ln			Interleaved lines of values, with
+* 					value i of line c at (i * nC) + c,
+* 					filtered in place.
+* \param	wrk			Work buffer of at least
+* 					3 * nC * (n + 2 * k) values.
+* \param	n			Number of values in each line.
+* \param	nC			Number of interleaved lines.
+* \param	k			Filter size.
+* \param	k2			Offset to the start of the filter.
+* \param	isMax			Maximum filter if non-zero, otherwise
+* 					minimum filter.
+*/
+static void	WlzRankFilterVHGW(double *ln, double *wrk, int n, int nC,
+				  int k, int k2, int isMax)
+{
+  int		idC,
+		idI,
+		idJ,
+		m;
+  double	ident;
+  double	*p,
+  		*g,
+		*h;
+
+  /* Padded length rounded up to a multiple of the filter size. */
+  m = (((n + k - 1) + k - 1) / k) * k;
+  p = wrk;
+  g = p + (m * nC);
+  h = g + (m * nC);
+  ident = (isMax)? -DBL_MAX: DBL_MAX;
+  for(idJ = 0; idJ < m; ++idJ)
+  {
+    idI = idJ - k2;
+    if((idI >= 0) && (idI < n))
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+        p[(idJ * nC) + idC] = ln[(idI * nC) + idC];
+      }
+    }
+    else
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+        p[(idJ * nC) + idC] = ident;
+      }
+    }
+  }
+  /* Running minima or maxima forward (g) and backward (h) within each
+   * block of k values. */
+  for(idJ = 0; idJ < m; ++idJ)
+  {
+    double	*pJ,
+    		*gJ;
+
+    pJ = p + (idJ * nC);
+    gJ = g + (idJ * nC);
+    if((idJ % k) == 0)
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	gJ[idC] = pJ[idC];
+      }
+    }
+    else if(isMax)
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	gJ[idC] = WLZ_MAX(gJ[idC - nC], pJ[idC]);
+      }
+    }
+    else
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	gJ[idC] = WLZ_MIN(gJ[idC - nC], pJ[idC]);
+      }
+    }
+  }
+  for(idJ = m - 1; idJ >= 0; --idJ)
+  {
+    double	*pJ,
+    		*hJ;
+
+    pJ = p + (idJ * nC);
+    hJ = h + (idJ * nC);
+    if(((idJ + 1) % k) == 0)
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	hJ[idC] = pJ[idC];
+      }
+    }
+    else if(isMax)
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	hJ[idC] = WLZ_MAX(hJ[idC + nC], pJ[idC]);
+      }
+    }
+    else
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	hJ[idC] = WLZ_MIN(hJ[idC + nC], pJ[idC]);
+      }
+    }
+  }
+  /* The window i to i + k - 1 spans at most two blocks. */
+  for(idI = 0; idI < n; ++idI)
+  {
+    double	*gI,
+    		*hI,
+		*lI;
+
+    lI = ln + (idI * nC);
+    hI = h + (idI * nC);
+    gI = g + ((idI + k - 1) * nC);
+    if(isMax)
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	lI[idC] = WLZ_MAX(hI[idC], gI[idC]);
+      }
+    }
+    else
+    {
+      for(idC = 0; idC < nC; ++idC)
+      {
+	lI[idC] = WLZ_MIN(hI[idC], gI[idC]);
+      }
+    }
+  }
+}
+
 /*!
 * \return	Woolz error code.
-* \ingroup      WlzValuesFilters
-* \brief	Applies a rank filter in place to the given Woolz object.
-*		Each value of the given object is replaced by the n'th
-*		ranked value of the values in it's immediate neighborhood,
-*		where the neighborhood is a simple axis aligned cube
-*		with the given size.
+* \ingroup	WlzValuesFilters
+* \brief	Finds the intervals of the given 2D or 3D object and the
+* 		size of the dense buffer which covers it's bounding box.
 * \param	gObj			Given object.
-* \param	fSz			Rank filter size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \param	wSp			Work space for the intervals.
 */
-static WlzErrorNum WlzRankFilterDomObj2D(WlzObject *gObj, int fSz,
-				         double rank)
+static WlzErrorNum WlzRankFilterItvs(WlzObject *gObj,
+				     WlzRankFilterWSp *wSp)
 {
-  int		bufLft,
-		bufRgt,
-		inLn,
-		fSz2,
-		itvWidth,
-		iBufWidth, 	      /* No of bytes in interval buffer line */
-		bufLn = 0,
-		outLn = 0;
-  void		*rBuf = NULL;
-  void		**vBuf = NULL;
-  WlzUByte	**iBuf = NULL;
-  WlzIVertex2	bufSz;
-  WlzGreyType	vType;
+  int		idR,
+		nRow = 0,
+  		maxItv = 0;
+  WlzIVertex2	org;
   WlzDomain	gDom;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if(gObj->values.core == NULL)
+  gDom = gObj->domain;
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
   {
-    errNum = WLZ_ERR_VALUES_NULL;
+    org.vtX = gDom.i->kol1;
+    org.vtY = gDom.i->line1;
+    wSp->bufSz.vtX = gDom.i->lastkl - gDom.i->kol1 + 1;
+    wSp->bufSz.vtY = gDom.i->lastln - gDom.i->line1 + 1;
+    wSp->bufSz.vtZ = 1;
+    errNum = WlzRankFilterItvs2D(gObj, wSp, 0, org, &maxItv);
+  }
+  else if(gDom.p->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
   }
   else
   {
-    fSz2 = fSz / 2;
-    gDom = gObj->domain;
-    bufSz.vtX = gDom.i->lastkl - gDom.i->kol1 + (2 * fSz2) + 1;
-    bufSz.vtY = fSz;
-    iBufWidth = (bufSz.vtX + 7) / 8;
-    vType = WlzGreyTypeFromObj(gObj, &errNum);
-    switch(vType)
+    int		idP;
+    WlzValues	*vals;
+    WlzDomain	*doms;
+
+    org.vtX = gDom.p->kol1;
+    org.vtY = gDom.p->line1;
+    wSp->bufSz.vtX = gDom.p->lastkl - gDom.p->kol1 + 1;
+    wSp->bufSz.vtY = gDom.p->lastln - gDom.p->line1 + 1;
+    wSp->bufSz.vtZ = gDom.p->lastpl - gDom.p->plane1 + 1;
+    doms = gDom.p->domains;
+    vals = gObj->values.vox->values;
+    for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < wSp->bufSz.vtZ); ++idP)
     {
-      case WLZ_GREY_UBYTE:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(WlzUByte))) == NULL) ||
-	   (AlcUnchar2Malloc((WlzUByte ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_SHORT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(short))) == NULL) ||
-	   (AlcShort2Malloc((short ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_INT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(int))) == NULL) ||
-	   (AlcInt2Malloc((int ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_FLOAT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(float))) == NULL) ||
-	   (AlcFloat2Malloc((float ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_DOUBLE:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(double))) == NULL) ||
-	   (AlcDouble2Malloc((double ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+      if(doms[idP].core != NULL)
+      {
+        if(vals[idP].core == NULL)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  errNum = WLZ_ERR_VALUES_NULL;
 	}
-	break;
-      case WLZ_GREY_RGBA:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(WlzUInt))) == NULL) ||
-	   (AlcInt2Malloc((int ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+	else
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  WlzObject *obj2D;
+
+	  obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, doms[idP], vals[idP],
+			      NULL, NULL, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzRankFilterItvs2D(obj2D, wSp, idP, org, &maxItv);
+	  }
+	  (void )WlzFreeObj(obj2D);
 	}
-	break;
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
+      }
     }
   }
+  /* Index the intervals by buffer row, the intervals being in row
+   * order. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if(AlcBit2Calloc(&iBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    nRow = wSp->bufSz.vtY * wSp->bufSz.vtZ;
+    if((wSp->rowItv = (int *)AlcCalloc(nRow + 1, sizeof(int))) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
-  }
-  /* Work down through the object. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzInitGreyScan(gObj, &iWSp, &gWSp);
+    int		idI;
+
+    for(idI = 0; idI < wSp->nItv; ++idI)
+    {
+      ++(wSp->rowItv[wSp->itv[idI].row + 1]);
+    }
+    for(idR = 0; idR < nRow; ++idR)
+    {
+      wSp->rowItv[idR + 1] += wSp->rowItv[idR];
+    }
   }
-  if(errNum == WLZ_ERR_NONE)
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Appends the intervals of the given 2D object to those
+* 		of the work space.
+* \param	obj			Given 2D object.
+* \param	wSp			Work space for the intervals.
+* \param	pln			Plane offset of the 2D object within
+* 					the dense buffer.
+* \param	org			Origin of the dense buffer.
+* \param	maxItv			Number of intervals allocated, may
+* 					be modified.
+*/
+static WlzErrorNum WlzRankFilterItvs2D(WlzObject *obj,
+				       WlzRankFilterWSp *wSp,
+				       int pln, WlzIVertex2 org,
+				       int *maxItv)
+{
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((errNum = WlzInitGreyScan(obj, &iWSp, &gWSp)) == WLZ_ERR_NONE)
   {
-    inLn = gDom.i->line1 - 1;
     while((errNum == WLZ_ERR_NONE) &&
 	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
     {
-      if(iWSp.nwlpos)
+      WlzRankFilterItv *itv;
+
+      if(wSp->nItv >= *maxItv)
       {
-	while(inLn < iWSp.linpos)
+	int	max;
+
+	max = (2 * *maxItv) + 1024;
+	if((itv = (WlzRankFilterItv *)
+		  AlcRealloc(wSp->itv,
+			     sizeof(WlzRankFilterItv) * max)) == NULL)
 	{
-	  outLn = inLn - fSz2 - 1; 	         /* -1 because previous line */
-	  if(outLn >= gDom.i->line1)
-	  {
-	    WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf,
-			       outLn, vType, bufSz, rank);
-	  }
-	  ++inLn;
-	  bufLn = (inLn + bufSz.vtY - gDom.i->line1) % bufSz.vtY;
-	  WlzValueSetUByte(iBuf[bufLn], 0, iBufWidth);
-	}
-      }
-      bufLft = iWSp.lftpos + fSz2 - gDom.i->kol1;
-      bufRgt = iWSp.rgtpos + fSz2 - gDom.i->kol1;
-      itvWidth = bufRgt - bufLft + 1;
-      /* Set bits in the interval buffer */
-      WlzBitLnSetItv(iBuf[bufLn], bufLft, bufRgt, bufSz.vtX);
-      /* Copy values to value buffer. */
-      switch(vType)
-      {
-        case WLZ_GREY_UBYTE:
-	  (void )memcpy(*(((WlzUByte **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.ubp, itvWidth);
-          break;
-        case WLZ_GREY_SHORT:
-	  (void )memcpy(*(((short **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.shp, itvWidth * sizeof(short));
-          break;
-        case WLZ_GREY_INT:
-	  (void )memcpy(*(((int **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.inp, itvWidth * sizeof(int));
-          break;
-        case WLZ_GREY_FLOAT:
-	  (void )memcpy(*(((float **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.flp, itvWidth * sizeof(float));
-          break;
-        case WLZ_GREY_DOUBLE:
-	  (void )memcpy(*(((double **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.dbp, itvWidth * sizeof(double));
-          break;
-        case WLZ_GREY_RGBA:
-	  (void )memcpy(*(((WlzUInt **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.rgbp, itvWidth * sizeof(WlzUInt));
-          break;
-        default:
-	  errNum = WLZ_ERR_GREY_TYPE;
+	  errNum = WLZ_ERR_MEM_ALLOC;
 	  break;
+	}
+	wSp->itv = itv;
+	*maxItv = max;
       }
+      itv = wSp->itv + wSp->nItv++;
+      itv->row = (pln * wSp->bufSz.vtY) + iWSp.linpos - org.vtY;
+      itv->kl = iWSp.lftpos - org.vtX;
+      itv->len = iWSp.rgtpos - iWSp.lftpos + 1;
+      itv->gP = gWSp.u_grintptr;
     }
     if(errNum == WLZ_ERR_EOO)
     {
       errNum = WLZ_ERR_NONE;
     }
-    if(errNum == WLZ_ERR_NONE)
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Allocates the dense buffer and copies the object's values
+* 		into it.
+* \param	wSp			Work space with intervals.
+* \param	useMsk			If non-zero a mask of the domain is
+* 					created and the buffer values outside
+* 					the domain are undefined, otherwise
+* 					they are set to the given value.
+* \param	bgdV			Value for the buffer outside of the
+* 					domain when no mask is used.
+*/
+static WlzErrorNum WlzRankFilterToBuf(WlzRankFilterWSp *wSp, int useMsk,
+				      WlzGreyV bgdV)
+{
+  size_t	nVx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nVx = (size_t )(wSp->bufSz.vtX) * wSp->bufSz.vtY * wSp->bufSz.vtZ;
+  if((wSp->buf.v = AlcMalloc(nVx * WlzGreySize(wSp->vType))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if(useMsk)
+  {
+    if((wSp->msk = (WlzUByte *)AlcCalloc(nVx, sizeof(WlzUByte))) == NULL)
     {
-      while(++outLn <= gDom.i->lastln)
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  else
+  {
+    WlzValueSetGrey(wSp->buf, 0, bgdV, wSp->vType, nVx);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idI = 0; idI < wSp->nItv; ++idI)
+    {
+      size_t	off;
+      WlzRankFilterItv *itv;
+
+      itv = wSp->itv + idI;
+      off = ((size_t )(itv->row) * wSp->bufSz.vtX) + itv->kl;
+      WlzValueCopyGreyToGrey(wSp->buf, off, wSp->vType,
+      			     itv->gP, 0, wSp->vType, itv->len);
+      if(wSp->msk)
       {
-	WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf, 
-			   outLn, vType, bufSz, rank);
-	bufLn = (++inLn + bufSz.vtY - gDom.i->line1) % bufSz.vtY;
-        WlzValueSetUByte(iBuf[bufLn], 0, iBufWidth);
+        (void )memset(wSp->msk + off, 1, itv->len);
       }
     }
-    WlzEndGreyScan(&iWSp, &gWSp);
   }
-  AlcFree(rBuf);
-  Alc2Free((void **)iBuf);
-  Alc2Free(vBuf);
-  WlzGreyValueFreeWSp(gVWSp);
   return(errNum);
 }
 
 /*!
 * \return	Woolz error code.
-* \ingroup      WlzValuesFilters
-* \brief	Applies a rank filter in place to the given Woolz object.
-*		Each value of the given object is replaced by the n'th
-*		ranked value of the values in it's immediate neighborhood,
-*		where the neighborhood is a simple axis aligned cuboid
-*		with the given width.
-* \param	gObj			Given object.
-* \param	fSz			Rank filter size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a minimum or maximum filter to the object of the
+* 		work space using seperable van Herk / Gil-Werman passes
+* 		through the dense buffer. Values outside of the domain
+* 		are set to the identity of the filter so that they never
+* 		contribute to the filtered values.
+* \param	wSp			Work space with intervals.
+* \param	isMax			Maximum filter if non-zero, otherwise
+* 					minimum filter.
 */
-static WlzErrorNum WlzRankFilterDomObj3D(WlzObject *gObj, int fSz,
-				         double rank)
+static WlzErrorNum WlzRankFilterMinMax(WlzRankFilterWSp *wSp, int isMax)
 {
-  int		bufPl,
-		plIdx,
-		pnCnt,
-		outPl,
-		fSz2;
-  void		*rBuf = NULL;
-  void		***vBuf = NULL;
-  WlzUByte	***iBuf = NULL;
-  WlzObject	*obj2D = NULL;
-  WlzValues	dummyValues;
-  WlzDomain	dummyDom,
-  		gDom;
-  WlzIVertex3	bufSz;
-  WlzIVertex2	bufOrg2D,
-  		bufSz2D;
-  WlzGreyType	vType;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzGreyV	bgdV;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  dummyDom.core = NULL;
-  dummyValues.core = NULL;
-  if(gObj->values.core == NULL)
+  switch(wSp->vType)
   {
-    errNum = WLZ_ERR_VALUES_NULL;
+    case WLZ_GREY_UBYTE:
+      bgdV.ubv = (isMax)? 0: 255;
+      break;
+    case WLZ_GREY_SHORT:
+      bgdV.shv = (isMax)? SHRT_MIN: SHRT_MAX;
+      break;
+    case WLZ_GREY_INT:
+      bgdV.inv = (isMax)? INT_MIN: INT_MAX;
+      break;
+    case WLZ_GREY_FLOAT:
+      bgdV.flv = (isMax)? -FLT_MAX: FLT_MAX;
+      break;
+    case WLZ_GREY_DOUBLE:
+      bgdV.dbv = (isMax)? -DBL_MAX: DBL_MAX;
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    fSz2 = fSz / 2;
-    gDom = gObj->domain;
-    bufSz2D.vtX = bufSz.vtX = gDom.p->lastkl - gDom.p->kol1 + (2 * fSz2) + 1;
-    bufSz2D.vtY = bufSz.vtY = gDom.p->lastln - gDom.p->line1 + (2 * fSz2) + 1;
-    bufSz.vtZ = fSz;
-    vType = WlzGreyTypeFromObj(gObj, &errNum);
-    switch(vType)
+    errNum = WlzRankFilterToBuf(wSp, 0, bgdV);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzRankFilterMinMaxPass(wSp, 0, isMax);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzRankFilterMinMaxPass(wSp, 1, isMax);
+  }
+  if((errNum == WLZ_ERR_NONE) && (wSp->fSzZ > 1))
+  {
+    errNum = WlzRankFilterMinMaxPass(wSp, 2, isMax);
+  }
+  /* Copy the filtered values back into the object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idI = 0; idI < wSp->nItv; ++idI)
     {
-      case WLZ_GREY_UBYTE:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(WlzUByte))) == NULL) ||
-	   (AlcUnchar3Malloc((WlzUByte ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+      WlzRankFilterItv *itv;
+
+      itv = wSp->itv + idI;
+      WlzValueCopyGreyToGrey(itv->gP, 0, wSp->vType,
+			     wSp->buf,
+			     ((size_t )(itv->row) * wSp->bufSz.vtX) + itv->kl,
+			     wSp->vType, itv->len);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a single pass of a minimum or maximum filter
+* 		to the dense buffer. Passes through lines and planes
+* 		gather chunks of adjacent columns so that the buffer
+* 		is read in contiguous runs. The lines or chunks are
+* 		filtered in parallel.
+* \param	wSp			Work space with the dense buffer.
+* \param	dir			Pass direction: 0 along lines,
+* 					1 through lines and 2 through
+* 					planes.
+* \param	isMax			Maximum filter if non-zero, otherwise
+* 					minimum filter.
+*/
+static WlzErrorNum WlzRankFilterMinMaxPass(WlzRankFilterWSp *wSp, int dir,
+					   int isMax)
+{
+  int		idI,
+  		k,
+		k2,
+		n,
+		nC,
+		nChk,
+  		nItm;
+  size_t	stride;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nChk = (wSp->bufSz.vtX + WLZ_RANKFILTER_CHUNK - 1) / WLZ_RANKFILTER_CHUNK;
+  switch(dir)
+  {
+    case 0:
+      k = wSp->fSz;
+      k2 = wSp->fSz2;
+      n = wSp->bufSz.vtX;
+      nC = 1;
+      stride = 1;
+      nItm = wSp->bufSz.vtY * wSp->bufSz.vtZ;
+      break;
+    case 1:
+      k = wSp->fSz;
+      k2 = wSp->fSz2;
+      n = wSp->bufSz.vtY;
+      nC = WLZ_RANKFILTER_CHUNK;
+      stride = wSp->bufSz.vtX;
+      nItm = wSp->bufSz.vtZ * nChk;
+      break;
+    default:
+      k = wSp->fSzZ;
+      k2 = wSp->fSz2Z;
+      n = wSp->bufSz.vtZ;
+      nC = WLZ_RANKFILTER_CHUNK;
+      stride = (size_t )(wSp->bufSz.vtX) * wSp->bufSz.vtY;
+      nItm = wSp->bufSz.vtY * nChk;
+      break;
+  }
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    double	*lnBuf;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    if((lnBuf = (double *)AlcMalloc(sizeof(double) * nC *
+				    (n + (3 * (n + (2 * k)))))) == NULL)
+    {
+      errNum2 = WLZ_ERR_MEM_ALLOC;
+    }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for(idI = 0; idI < nItm; ++idI)
+    {
+      if(errNum2 == WLZ_ERR_NONE)
+      {
+	int	  idN,
+		  nCI;
+	size_t	  off;
+	WlzGreyP  lnGP;
+
+	lnGP.dbp = lnBuf;
+	if(dir == 0)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  nCI = 1;
+	  off = (size_t )idI * wSp->bufSz.vtX;
+	  WlzValueCopyGreyToGrey(lnGP, 0, WLZ_GREY_DOUBLE,
+	  			 wSp->buf, off, wSp->vType, n);
 	}
-	break;
-      case WLZ_GREY_SHORT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(short))) == NULL) ||
-	   (AlcShort3Malloc((short ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+	else
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  int	  c0;
+
+	  c0 = (idI % nChk) * WLZ_RANKFILTER_CHUNK;
+	  nCI = WLZ_MIN(WLZ_RANKFILTER_CHUNK, wSp->bufSz.vtX - c0);
+	  off = (dir == 1)?
+	        ((size_t )(idI / nChk) * wSp->bufSz.vtY * wSp->bufSz.vtX) + c0:
+	        ((size_t )(idI / nChk) * wSp->bufSz.vtX) + c0;
+	  for(idN = 0; idN < n; ++idN)
+	  {
+	    WlzValueCopyGreyToGrey(lnGP, idN * nCI, WLZ_GREY_DOUBLE,
+				   wSp->buf, off + (idN * stride), wSp->vType,
+				   nCI);
+	  }
 	}
-	break;
-      case WLZ_GREY_INT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(int))) == NULL) ||
-	   (AlcInt3Malloc((int ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+	WlzRankFilterVHGW(lnBuf, lnBuf + (n * nCI), n, nCI, k, k2, isMax);
+	if(dir == 0)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  WlzValueCopyGreyToGrey(wSp->buf, off, wSp->vType,
+	  			 lnGP, 0, WLZ_GREY_DOUBLE, n);
 	}
-	break;
-      case WLZ_GREY_FLOAT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(float))) == NULL) ||
-	   (AlcFloat3Malloc((float ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+	else
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  for(idN = 0; idN < n; ++idN)
+	  {
+	    WlzValueCopyGreyToGrey(wSp->buf, off + (idN * stride), wSp->vType,
+				   lnGP, idN * nCI, WLZ_GREY_DOUBLE, nCI);
+	  }
 	}
+      }
+    }
+#ifdef _OPENMP
+#pragma omp critical (WlzRankFilterMinMaxPass)
+#endif
+    {
+      if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+      {
+	errNum = errNum2;
+      }
+    }
+    AlcFree(lnBuf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a general rank filter to the object of the work
+* 		space, with the rows of the dense buffer filtered in
+* 		parallel. Integer values with a limited range are ranked
+* 		using a sliding histogram, all other values are ranked
+* 		by selection.
+* \param	wSp			Work space with intervals.
+*/
+static WlzErrorNum WlzRankFilterRows(WlzRankFilterWSp *wSp)
+{
+  int		idR,
+		nRow,
+		nWin,
+		vMin = 0,
+  		nBin = 0;
+  WlzGreyV	bgdV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.dbv = 0.0;
+  errNum = WlzRankFilterToBuf(wSp, 1, bgdV);
+  /* Find the range of integer values for the histogram. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idI,
+		idV,
+    		vMax;
+
+    vMin = INT_MAX;
+    vMax = INT_MIN;
+    switch(wSp->vType)
+    {
+      case WLZ_GREY_UBYTE:
+        vMin = 0;
+	vMax = 255;
 	break;
-      case WLZ_GREY_DOUBLE:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(double))) == NULL) ||
-	   (AlcDouble3Malloc((double ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+      case WLZ_GREY_SHORT:
+	for(idI = 0; idI < wSp->nItv; ++idI)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  short	*vP;
+
+	  vP = wSp->itv[idI].gP.shp;
+	  for(idV = 0; idV < wSp->itv[idI].len; ++idV)
+	  {
+	    vMin = WLZ_MIN(vMin, vP[idV]);
+	    vMax = WLZ_MAX(vMax, vP[idV]);
+	  }
 	}
-	break;
-      case WLZ_GREY_RGBA:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(WlzUInt))) == NULL) ||
-	   (AlcInt3Malloc((int ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+        break;
+      case WLZ_GREY_INT:
+	for(idI = 0; idI < wSp->nItv; ++idI)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  int	*vP;
+
+	  vP = wSp->itv[idI].gP.inp;
+	  for(idV = 0; idV < wSp->itv[idI].len; ++idV)
+	  {
+	    vMin = WLZ_MIN(vMin, vP[idV]);
+	    vMax = WLZ_MAX(vMax, vP[idV]);
+	  }
 	}
-	break;
+        break;
       default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
+        break;
     }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    if(AlcBit3Calloc(&iBuf, bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    if((vMax >= vMin) &&
+       ((double )vMax - (double )vMin < WLZ_RANKFILTER_HIST_MAX))
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      nBin = vMax - vMin + 1;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
-    			NULL, NULL, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
-  }
-  /* Work down through the object. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    plIdx = 0;
-    outPl = gDom.p->plane1 + plIdx - fSz2;
-    pnCnt = gDom.p->lastpl - gDom.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    nRow = wSp->bufSz.vtY * wSp->bufSz.vtZ;
+    nWin = wSp->fSz * wSp->fSzZ;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      if((errNum == WLZ_ERR_NONE) && (outPl >= gDom.p->plane1))
+      int	*bin = NULL,
+		*hist = NULL;
+      double	*val = NULL,
+		*rBuf = NULL,
+      		*res = NULL;
+      size_t	*winOff = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(((winOff = (size_t *)AlcMalloc(sizeof(size_t) * nWin)) == NULL) ||
+         ((res = (double *)
+	         AlcMalloc(sizeof(double) * wSp->bufSz.vtX)) == NULL))
       {
-        WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			   outPl, vType, bufSz, rank);
+        errNum2 = WLZ_ERR_MEM_ALLOC;
       }
-      bufPl = (gDom.p->plane1 + plIdx) % bufSz.vtZ;
-      obj2D->domain = *(gObj->domain.p->domains + plIdx);
-      obj2D->values = *(gObj->values.vox->values + plIdx);
-      if(errNum == WLZ_ERR_NONE)
+      else if(nBin > 0)
       {
-        bufOrg2D.vtX = obj2D->domain.i->kol1 - fSz2;
-	bufOrg2D.vtY = obj2D->domain.i->line1 - fSz2;
-	errNum = WlzToArray2D((void ***)(iBuf + bufPl), obj2D,
-			      bufSz2D, bufOrg2D, 0, WLZ_GREY_BIT);
+	if(((bin = (int *)
+	           AlcMalloc(sizeof(int) * nWin * wSp->bufSz.vtX)) == NULL) ||
+	   ((hist = (int *)AlcCalloc(2 * nBin, sizeof(int))) == NULL))
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
       }
-      if(errNum == WLZ_ERR_NONE)
+      else
       {
-        errNum = WlzToArray2D((void ***)(vBuf + bufPl), obj2D,
-			      bufSz2D, bufOrg2D, 0, vType);
+	if(((val = (double *)AlcMalloc(sizeof(double) *
+				       nWin * wSp->bufSz.vtX)) == NULL) ||
+	   ((rBuf = (double *)AlcMalloc(sizeof(double) *
+					nWin * wSp->fSz)) == NULL))
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
       }
-      ++plIdx;
-      ++outPl;
-    }
-    while((errNum == WLZ_ERR_NONE) && (outPl <= gDom.p->lastpl))
-    {
-      WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			 outPl, vType, bufSz, rank);
-      ++outPl;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idR = 0; idR < nRow; ++idR)
+      {
+	if((errNum2 == WLZ_ERR_NONE) &&
+	   (wSp->rowItv[idR] < wSp->rowItv[idR + 1]))
+	{
+	  int	  idI,
+	  	  nW;
+	  WlzGreyP resGP;
+
+	  nW = WlzRankFilterRowWin(wSp, idR, winOff);
+	  if(nBin > 0)
+	  {
+	    WlzRankFilterRowHist(wSp, idR, nW, winOff, vMin, nBin,
+	    			 bin, hist, res);
+	  }
+	  else
+	  {
+	    WlzRankFilterRowSel(wSp, idR, nW, winOff, val, rBuf, res);
+	  }
+	  /* The values of the row are only read from the dense buffer,
+	   * so the filtered values can be written straight back. */
+	  resGP.dbp = res;
+	  for(idI = wSp->rowItv[idR]; idI < wSp->rowItv[idR + 1]; ++idI)
+	  {
+	    WlzRankFilterItv *itv;
+
+	    itv = wSp->itv + idI;
+	    WlzValueCopyGreyToGrey(itv->gP, 0, wSp->vType,
+	    			   resGP, itv->kl, WLZ_GREY_DOUBLE, itv->len);
+	  }
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzRankFilterRows)
+#endif
+      {
+	if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(winOff);
+      AlcFree(res);
+      AlcFree(bin);
+      AlcFree(hist);
+      AlcFree(val);
+      AlcFree(rBuf);
     }
   }
-  if(obj2D)
+  return(errNum);
+}
+
+/*!
+* \return	Number of rows in the neighbourhood.
+* \ingroup	WlzValuesFilters
+* \brief	Computes the dense buffer offsets of the rows which are
+* 		within the filter neighbourhood of the given row.
+* \param	wSp			Work space with the dense buffer.
+* \param	row			Given buffer row.
+* \param	winOff			Destination for the offsets, with
+* 					room for the filter size squared
+* 					(3D) or filter size (2D) offsets.
+*/
+static int	WlzRankFilterRowWin(WlzRankFilterWSp *wSp, int row,
+				    size_t *winOff)
+{
+  int		idY,
+		idZ,
+		ln,
+		pl,
+		nW = 0;
+
+  pl = row / wSp->bufSz.vtY;
+  ln = row % wSp->bufSz.vtY;
+  for(idZ = 0; idZ < wSp->fSzZ; ++idZ)
   {
-    obj2D->domain = dummyDom;
-    obj2D->values = dummyValues;
-    WlzFreeObj(obj2D);
+    int		p;
+
+    p = pl - wSp->fSz2Z + idZ;
+    if((p >= 0) && (p < wSp->bufSz.vtZ))
+    {
+      for(idY = 0; idY < wSp->fSz; ++idY)
+      {
+	int	l;
+
+	l = ln - wSp->fSz2 + idY;
+	if((l >= 0) && (l < wSp->bufSz.vtY))
+	{
+	  winOff[nW++] = (((size_t )p * wSp->bufSz.vtY) + l) *
+	                 wSp->bufSz.vtX;
+	}
+      }
+    }
   }
-  AlcFree(rBuf);
-  Alc3Free((void ***)iBuf);
-  Alc3Free(vBuf);
-  WlzGreyValueFreeWSp(gVWSp);
-  return(errNum);
+  return(nW);
 }
 
 /*!
 * \return	void
-* \ingroup      WlzValuesFilters
-* \brief	Rank filter the buffer values for a single line.
-*		If possible the buffer of values to be ranked just has
-*		the values no longer used replaced by new values, rather
-*		than all the values in the buffer being re-entered.
-* \param	gObj			The object being filtered, needed 
-*					for random pixel access.
-* \param	gVWSp			Grey value workspace, needed for
-*					random pixel access.
-* \param	vBuf			Circular buffer of lines of grey
-*					values.
-* \param	iBuf			Circular buffer of lines of bits
-*					used to encode intervals.
-* \param	rBuf			A buffer used to rank pixels.
-* \param	line			The current line, with both past
-*					and future lines valid.
-* \param	vType			The grey value type.
-* \param	bufSz			The buffer size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \ingroup	WlzValuesFilters
+* \brief	Rank filters the values of a single row using a sliding
+* 		histogram. Columns of the neighbourhood are added to and
+* 		removed from the histogram as it slides along the row,
+* 		with the histogram having coarse and fine bins so that
+* 		the ranked value is found in a time proportional to the
+* 		square root of the number of bins. The histogram is
+* 		left empty on return.
+* \param	wSp			Work space with the dense buffer.
+* \param	row			Given buffer row.
+* \param	nW			Number of rows in the neighbourhood.
+* \param	winOff			Offsets of the neighbourhood rows.
+* \param	vMin			Value of the first histogram bin.
+* \param	nBin			Number of fine histogram bins.
+* \param	bin			Work buffer for the bin indices of
+* 					the neighbourhood rows.
+* \param	hist			Empty histogram with 2 * nBin bins.
+* \param	res			Destination for the filtered values
+* 					of the row.
 */
-static void	WlzRankFilterValLn(WlzObject *gObj, WlzGreyValueWSpace *gVWSp,
-				   void **vBuf, WlzUByte **iBuf, void *rBuf,
-				   int line, WlzGreyType vType,
-				   WlzIVertex2 bufSz, double rank)
+static void	WlzRankFilterRowHist(WlzRankFilterWSp *wSp, int row,
+				     int nW, size_t *winOff,
+				     int vMin, int nBin, int *bin, int *hist,
+				     double *res)
 {
-  int		idK,
+  int		c,
+		c0,
+		c1,
+		idB,
+  		idC,
+		idW,
 		idX,
-		idY,
-		fSz2,
-		sameRCnt,
-		rCnt = 0;
-  WlzGreyV	gV0,
-  		gV1;
-  WlzGreyP	gP0,
-  		gP1;
-  WlzDomain	gDom;
-  WlzIVertex2	bufPos0,
-		bufPos1,
-  		objPos;
+		nV = 0,
+		sft = 0,
+		x0,
+		x1;
+  int		*crs;
+  WlzUByte	*msk;
+  WlzGreyP	binGP;
+  WlzRankFilterItv *itv;
 
-  gP0.v = gP1.v = NULL;
-  gDom = gObj->domain;
-  fSz2 = bufSz.vtY / 2;
-  bufPos1.vtY = line - gDom.i->line1 - fSz2 + bufSz.vtY;
-  for(idK = fSz2; idK < bufSz.vtX - fSz2; ++idK)
+  itv = wSp->itv + wSp->rowItv[row];
+  x0 = itv->kl;
+  itv = wSp->itv + wSp->rowItv[row + 1] - 1;
+  x1 = itv->kl + itv->len - 1;
+  c0 = WLZ_MAX(0, x0 - wSp->fSz2);
+  c1 = WLZ_MIN(wSp->bufSz.vtX - 1, x1 - wSp->fSz2 + wSp->fSz - 1);
+  /* Bin indices of the neighbourhood rows, -1 outside the domain. */
+  binGP.inp = bin;
+  for(idW = 0; idW < nW; ++idW)
+  {
+    int		*bP;
+
+    bP = bin + (idW * wSp->bufSz.vtX);
+    msk = wSp->msk + winOff[idW];
+    WlzValueCopyGreyToGrey(binGP, (idW * wSp->bufSz.vtX) + c0, WLZ_GREY_INT,
+    			   wSp->buf, winOff[idW] + c0, wSp->vType,
+			   c1 - c0 + 1);
+    for(idC = c0; idC <= c1; ++idC)
+    {
+      bP[idC] = (msk[idC])? bP[idC] - vMin: -1;
+    }
+  }
+  while((1 << (2 * sft)) < nBin)
+  {
+    ++sft;
+  }
+  crs = hist + nBin;
+  msk = wSp->msk + ((size_t )row * wSp->bufSz.vtX);
+  for(c = x0 - wSp->fSz2; c < x0 - wSp->fSz2 + wSp->fSz; ++c)
   {
-    objPos.vtX = gDom.i->kol1 + idK - fSz2;
-    objPos.vtY = line;
-    bufPos0.vtX = idK;
-    bufPos0.vtY = (line - gDom.i->line1 + bufSz.vtY) % bufSz.vtY;
-    if(WLZ_BIT_GET(iBuf[bufPos0.vtY], bufPos0.vtX) != 0)
+    if((c >= c0) && (c <= c1))
     {
-      bufPos0.vtX = idK - fSz2 - 1;
-      sameRCnt = bufPos0.vtX > 0;
-      if(sameRCnt)
+      for(idW = 0; idW < nW; ++idW)
       {
-	idY = 0;
-	bufPos1.vtX = bufPos0.vtX + bufSz.vtY;
-	while((idY < bufSz.vtY) && sameRCnt)
+	if((idB = bin[(idW * wSp->bufSz.vtX) + c]) >= 0)
 	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  gP1.ubp = *(iBuf + bufPos0.vtY); 
-	  sameRCnt = WLZ_BIT_GET(gP1.ubp, bufPos0.vtX) &&
-		     WLZ_BIT_GET(gP1.ubp, bufPos1.vtX);
-	  ++idY;
+	  ++(hist[idB]);
+	  ++(crs[idB >> sft]);
+	  ++nV;
 	}
       }
-      if(sameRCnt)
+    }
+  }
+  for(idX = x0; idX <= x1; ++idX)
+  {
+    /* Histogram holds the neighbourhood of idX. */
+    if(msk[idX])
+    {
+      int	acc = 0,
+		rnk;
+
+      rnk = (int )floor(nV * wSp->rank);
+      idC = 0;
+      while(acc + crs[idC] <= rnk)
+      {
+        acc += crs[idC++];
+      }
+      idB = idC << sft;
+      while(acc + hist[idB] <= rnk)
+      {
+        acc += hist[idB++];
+      }
+      res[idX] = vMin + idB;
+    }
+    /* Slide the histogram on to the next column. */
+    c = idX - wSp->fSz2;
+    if((c >= c0) && (c <= c1))
+    {
+      for(idW = 0; idW < nW; ++idW)
       {
-	for(idY = 0; idY < bufSz.vtY; ++idY)
+	if((idB = bin[(idW * wSp->bufSz.vtX) + c]) >= 0)
 	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      gP0.ubp = (WlzUByte *)rBuf;
-	      gP1.ubp = *((WlzUByte **)vBuf + bufPos0.vtY);
-	      gV0.ubv = *(gP1.ubp + bufPos0.vtX);
-	      gV1.ubv = *(gP1.ubp + bufPos1.vtX);
-	      while(*(gP0.ubp) != gV0.ubv)
-	      {
-	        ++(gP0.ubp);
-	      }
-	      *(gP0.ubp) = gV1.ubv;
-	      break;
-	    case WLZ_GREY_SHORT:
-	      gP0.shp = (short *)rBuf;
-	      gP1.shp = *((short **)vBuf + bufPos0.vtY);
-	      gV0.shv = *(gP1.shp + bufPos0.vtX);
-	      gV1.shv = *(gP1.shp + bufPos1.vtX);
-	      while(*(gP0.shp) != gV0.shv)
-	      {
-	        ++(gP0.shp);
-	      }
-	      *(gP0.shp) = gV1.shv;
-	      break;
-	    case WLZ_GREY_INT:
-	      gP0.inp = (int *)rBuf;
-	      gP1.inp = *((int **)vBuf + bufPos0.vtY);
-	      gV0.inv = *(gP1.inp + bufPos0.vtX);
-	      gV1.inv = *(gP1.inp + bufPos1.vtX);
-	      while(*(gP0.inp) != gV0.inv)
-	      {
-	        ++(gP0.inp);
-	      }
-	      *(gP0.inp) = gV1.inv;
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      gP0.flp = (float *)rBuf;
-	      gP1.flp = *((float **)vBuf + bufPos0.vtY);
-	      gV0.flv = *(gP1.flp + bufPos0.vtX);
-	      gV1.flv = *(gP1.flp + bufPos1.vtX);
-	      while(*(gP0.flp) != gV0.flv)
-	      {
-	        ++(gP0.flp);
-	      }
-	      *(gP0.flp) = gV1.flv;
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      gP0.dbp = (double *)rBuf;
-	      gP1.dbp = *((double **)vBuf + bufPos0.vtY);
-	      gV0.dbv = *(gP1.dbp + bufPos0.vtX);
-	      gV1.dbv = *(gP1.dbp + bufPos1.vtX);
-	      while(*(gP0.dbp) != gV0.dbv)
-	      {
-	        ++(gP0.dbp);
-	      }
-	      *(gP0.dbp) = gV1.dbv;
-	      break;
-	    case WLZ_GREY_RGBA:
-	      gP0.rgbp = (WlzUInt *)rBuf;
-	      gP1.rgbp = *((WlzUInt **)vBuf + bufPos0.vtY);
-	      gV0.rgbv = *(gP1.rgbp + bufPos0.vtX);
-	      gV1.rgbv = *(gP1.rgbp + bufPos1.vtX);
-	      while(*(gP0.rgbp) != gV0.rgbv)
-	      {
-	        ++(gP0.rgbp);
-	      }
-	      *(gP0.rgbp) = gV1.rgbv;
-	      break;
-	    default:
-	      break;
-	  }
+	  --(hist[idB]);
+	  --(crs[idB >> sft]);
+	  --nV;
 	}
       }
-      else
+    }
+    c += wSp->fSz;
+    if((c >= c0) && (c <= c1))
+    {
+      for(idW = 0; idW < nW; ++idW)
       {
-        rCnt = 0;
-	for(idY = 0; idY < bufSz.vtY; ++idY)
+	if((idB = bin[(idW * wSp->bufSz.vtX) + c]) >= 0)
 	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      gP0.ubp = *((WlzUByte **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      gP0.shp = *((short **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_INT:
-	      gP0.inp = *((int **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      gP0.flp = *((float **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      gP0.dbp = *((double **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      gP0.rgbp = *((WlzUInt **)vBuf + bufPos0.vtY);
-	      break;
-	    default:
-	      break;
-	  }
-	  bufPos0.vtX = idK - fSz2;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((WlzUByte *)rBuf + rCnt++) = *(gP0.ubp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_SHORT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((short *)rBuf + rCnt++) = *(gP0.shp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_INT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((int *)rBuf + rCnt++) = *(gP0.inp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((float *)rBuf + rCnt++) = *(gP0.flp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((double *)rBuf + rCnt++) = *(gP0.dbp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	  case WLZ_GREY_RGBA: /* RGBA to be done - what to do? RAB */
-	    return;
-	  default:
-	    break;
-	  }
+	  ++(hist[idB]);
+	  ++(crs[idB >> sft]);
+	  ++nV;
 	}
       }
     }
-    /* Do the rank filtering. */
-    if(rCnt > 1)
+  }
+  /* Empty the histogram ready for the next row. */
+  for(c = x1 + 1 - wSp->fSz2; c < x1 + 1 - wSp->fSz2 + wSp->fSz; ++c)
+  {
+    if((c >= c0) && (c <= c1))
     {
-      WlzRankFilterValues(gVWSp, 0, objPos.vtY, objPos.vtX,
-      			  vType, rBuf, rCnt, rank);
+      for(idW = 0; idW < nW; ++idW)
+      {
+	if((idB = bin[(idW * wSp->bufSz.vtX) + c]) >= 0)
+	{
+	  --(hist[idB]);
+	  --(crs[idB >> sft]);
+	}
+      }
     }
   }
 }
 
 /*!
 * \return	void
-* \ingroup      WlzValuesFilters
-* \brief	Rank filter the buffer values for a single plane.
-*		always popolate the rank buffer afresh, as quick experiments
-*		have shown that trying to replace values does not speed up
-*		the computation for a 3D buffer.
-* \param	gObj			The object being filtered, needed 
-*					for random pixel access.
-* \param	gVWSp			Grey value workspace, needed for
-*					random pixel access.
-* \param	vBuf			Circular buffer of planes of grey
-*					values.
-* \param	iBuf			Circular buffer of planes of bits
-*					used to encode intervals.
-* \param	rBuf			A buffer used to rank pixels.
-* \param	plane			The current plane, with both past
-*					and future planes valid.
-* \param	vType			The grey value type.
-* \param	bufSz			The buffer size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \ingroup	WlzValuesFilters
+* \brief	Rank filters the values of a single row by selection
+* 		from the values of each neighbourhood.
+* \param	wSp			Work space with the dense buffer.
+* \param	row			Given buffer row.
+* \param	nW			Number of rows in the neighbourhood.
+* \param	winOff			Offsets of the neighbourhood rows.
+* \param	val			Work buffer for the values of the
+* 					neighbourhood rows.
+* \param	rBuf			Work buffer for the values to be
+* 					ranked.
+* \param	res			Destination for the filtered values
+* 					of the row.
 */
-static void	WlzRankFilterValPl(WlzObject *gObj, WlzGreyValueWSpace *gVWSp,
-				   void ***vBuf, WlzUByte ***iBuf, void *rBuf,
-				   int plane, WlzGreyType vType,
-				   WlzIVertex3 bufSz, double rank)
+static void	WlzRankFilterRowSel(WlzRankFilterWSp *wSp, int row,
+				    int nW, size_t *winOff,
+				    double *val, double *rBuf, double *res)
 {
-  int		idK,
-		idL,
+  int		c0,
+		c1,
+  		idW,
 		idX,
-		idY,
-		idZ,
-		rCnt,
-		fSz2;
-  WlzUByte	*iP0;
-  WlzGreyP	gP0;
-  WlzDomain	gDom;
-  WlzIVertex3	bufPos0,
-		bufPos1,
-  		objPos;
+		x0,
+		x1;
+  WlzUByte	*msk;
+  WlzGreyP	valGP;
+  WlzRankFilterItv *itv;
 
-  gP0.v = NULL;
-  gDom = gObj->domain;
-  fSz2 = bufSz.vtZ / 2;
-  bufPos1.vtZ = plane - gDom.p->plane1 - fSz2 + bufSz.vtZ;
-  for(idL = fSz2; idL < bufSz.vtY - fSz2; ++idL)
+  itv = wSp->itv + wSp->rowItv[row];
+  x0 = itv->kl;
+  itv = wSp->itv + wSp->rowItv[row + 1] - 1;
+  x1 = itv->kl + itv->len - 1;
+  c0 = WLZ_MAX(0, x0 - wSp->fSz2);
+  c1 = WLZ_MIN(wSp->bufSz.vtX - 1, x1 - wSp->fSz2 + wSp->fSz - 1);
+  valGP.dbp = val;
+  for(idW = 0; idW < nW; ++idW)
+  {
+    WlzValueCopyGreyToGrey(valGP, (idW * wSp->bufSz.vtX) + c0,
+    			   WLZ_GREY_DOUBLE,
+    			   wSp->buf, winOff[idW] + c0, wSp->vType,
+			   c1 - c0 + 1);
+  }
+  msk = wSp->msk + ((size_t )row * wSp->bufSz.vtX);
+  for(idX = x0; idX <= x1; ++idX)
   {
-    for(idK = fSz2; idK < bufSz.vtX - fSz2; ++idK)
+    if(msk[idX])
     {
-      rCnt = 0;
-      objPos.vtX = gDom.p->kol1 + idK - fSz2;
-      objPos.vtY = gDom.p->line1 + idL - fSz2;
-      objPos.vtZ = plane;
-      bufPos0.vtX = idK;
-      bufPos0.vtY = idL;
-      bufPos0.vtZ = (plane - gDom.p->plane1 + bufSz.vtZ) % bufSz.vtZ;
-      if(WLZ_BIT_GET(*(*(iBuf + bufPos0.vtZ) + bufPos0.vtY), bufPos0.vtX) != 0)
+      int	cA,
+		cB,
+		idC,
+      		rnk,
+		nV = 0;
+
+      cA = WLZ_MAX(c0, idX - wSp->fSz2);
+      cB = WLZ_MIN(c1, idX - wSp->fSz2 + wSp->fSz - 1);
+      for(idW = 0; idW < nW; ++idW)
       {
-	for(idZ = 0; idZ < bufSz.vtZ; ++idZ)
+	double	*vP;
+	WlzUByte *mP;
+
+	vP = val + (idW * wSp->bufSz.vtX);
+	mP = wSp->msk + winOff[idW];
+        for(idC = cA; idC <= cB; ++idC)
 	{
-	  bufPos0.vtZ = (bufPos1.vtZ + idZ) % bufSz.vtZ;
-	  for(idY = 0; idY < bufSz.vtZ; ++idY)
+	  if(mP[idC])
 	  {
-	    bufPos0.vtY = idL + idY - fSz2;
-	    switch(vType)
-	    {
-	      case WLZ_GREY_UBYTE:
-		gP0.ubp = *(*((WlzUByte ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_SHORT:
-		gP0.shp = *(*((short ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_INT:
-		gP0.inp = *(*((int ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_FLOAT:
-		gP0.flp = *(*((float ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_DOUBLE:
-		gP0.dbp = *(*((double ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_RGBA:
-		gP0.rgbp = *(*((WlzUInt ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      default:
-	        break;
-	    }
-	    iP0 = *(*(iBuf + bufPos0.vtZ) + bufPos0.vtY);
-	    bufPos0.vtX = idK - fSz2;
-	    switch(vType)
-	    {
-	      case WLZ_GREY_UBYTE:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((WlzUByte *)rBuf + rCnt) = *(gP0.ubp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((short *)rBuf + rCnt) = *(gP0.shp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_INT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((int *)rBuf + rCnt) = *(gP0.inp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((float *)rBuf + rCnt) = *(gP0.flp + bufPos0.vtX);
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((double *)rBuf + rCnt) = *(gP0.dbp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        /* TODO RGBA to be done - what to do? RAB */
-		return;
-	      default:
-	        break;
-	    }
+	    rBuf[nV++] = vP[idC];
 	  }
 	}
       }
-      /* Do the rank filtering. */
-      if(rCnt > 1)
-      {
-	WlzRankFilterValues(gVWSp, objPos.vtZ, objPos.vtY, objPos.vtX,
-	    		    vType, rBuf, rCnt, rank);
-      }
+      rnk = (int )floor(nV * wSp->rank);
+      AlgRankSelectD(rBuf, nV, rnk);
+      res[idX] = rBuf[rnk];
     }
   }
 }
 
-/*!
-* \return	void
-* \ingroup      WlzValuesFilters
-* \brief	Replace the single pixel/voxel in the object used to
-*		initialize the given grey value work space with the
-*		rank filtered value.
-* \param	gVWSp			Given grey value work space.
-* \param	posZ			Plane position.
-* \param	posY			Line position.
-* \param	posX			Column position.
-* \param	vType			Grey value type.
-* \param	values			Buffer of values to be ranked.
-* \param	nValues			Number of values in buffer.
-* \param	rank			Required rank.
-*/
-static void	WlzRankFilterValues(WlzGreyValueWSpace *gVWSp,
-				    int posZ, int posY, int posX,
-				    WlzGreyType vType, void *values,
-				    int nValues, double rank)
-{
-  int		rankI;
-
-  rankI = (int )floor(nValues * rank);
-  WlzGreyValueGet(gVWSp, posZ, posY, posX);
-  switch(vType)
-  {
-    case WLZ_GREY_UBYTE:
-      AlgRankSelectUB((WlzUByte *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].ubp) = *((WlzUByte *)values + rankI);
-      break;
-    case WLZ_GREY_SHORT:
-      AlgRankSelectS((short *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].shp) = *((short *)values + rankI);
-      break;
-    case WLZ_GREY_INT:
-      AlgRankSelectI((int *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].inp) = *((int *)values + rankI);
-      break;
-    case WLZ_GREY_FLOAT:
-      AlgRankSelectF((float *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].flp) = *((float *)values + rankI);
-      break;
-    case WLZ_GREY_DOUBLE:
-      AlgRankSelectD((double *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].dbp) = *((double *)values + rankI);
-      break;
-    default:
-      break;
-  }
-}
 
 /* #define WLZ_RANK_TEST */
 #ifdef WLZ_RANK_TEST
@@ -42,6 +42,12 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <string.h>
 #include <Wlz.h>
+#if HAVE_ZLIB != 0
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
+#if HAVE_BZLIB != 0
+#include <bzlib.h>
+#endif /* HAVE_BZLIB */
 
 #ifdef HAVE_MMAP
 #define WLZ_USE_MMAP
@@ -73,19 +79,49 @@ static WlzErrorNum		WlzReadRectVtb(
 				  WlzObjectType type);
 static WlzErrorNum 		WlzReadDomObjValues2D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzTileCache *cache);
 static WlzErrorNum 		WlzReadDomObjValues3D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzTileCache *cache);
 static WlzErrorNum 		WlzReadTiledValues(
 				  FILE *fP,
 				  WlzObject *obj,
 				  int dim,
 				  WlzObjectType type,
-				  int map);
+				  int map,
+				  WlzTileCache *cache);
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
 				  WlzObject *obj);
+static WlzErrorNum		WlzReadChunkedValues(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzPlaneDomain *fPDom);
+static WlzErrorNum		WlzReadChunkPlane(
+				  WlzDomain dDom,
+				  WlzValues dVal,
+				  WlzDomain fDom,
+				  int line1,
+				  int bandLn,
+				  WlzGreyType gType,
+				  WlzChunkCodec codec,
+				  int *rawSz,
+				  int *cmpSz,
+				  WlzUByte **cmpBuf);
+static WlzErrorNum		WlzReadChunkDecompress(
+				  WlzChunkCodec codec,
+				  WlzUByte *src,
+				  size_t srcSz,
+				  WlzUByte *dst,
+				  size_t dstSz);
+static WlzErrorNum		WlzReadSkip(
+				  FILE *fP,
+				  size_t n);
+static int			WlzReadChunkLnWidth(
+				  WlzIntervalDomain *iDom,
+				  int ln);
 static WlzProperty	 	WlzReadProperty(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -98,6 +134,9 @@ static WlzPolygonDomain 	*WlzReadPolygon(
 static WlzBSpline 		*WlzReadSpline(
 				  FILE *fP,
 				  WlzErrorNum *dstErr);
+static WlzIdxMesh 		*WlzReadIdxMesh(
+				  FILE *fP,
+				  WlzErrorNum *dstErr);
 static WlzBoundList 		*WlzReadBoundList(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -451,7 +490,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL))
 	{
-	  if((errNum = WlzReadDomObjValues2D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues2D(fp, obj, NULL)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -466,7 +505,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL ))
 	{
-	  if((errNum = WlzReadDomObjValues3D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues3D(fp, obj, NULL)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -532,6 +571,15 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	}
 	break;
 
+      case WLZ_IDXMESH:
+	if(((domain.idm = WlzReadIdxMesh(fp, &errNum)) != NULL) &&
+	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
+			       &errNum)) != NULL)){
+	  obj->plist = WlzAssignPropertyList(
+		       WlzReadPropertyList(fp, NULL), NULL);
+	}
+	break;
+
       case WLZ_CMESH_2D:
 	if(((domain.cm2 = WlzReadCMesh2D(fp, &errNum)) != NULL) &&
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
@@ -659,6 +707,196 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
   return(obj);
 }
 
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream, clipping
+* 		it to the given bounding box as it is read.
+* 		When the object is a 3D domain object with values that
+* 		were written as a chunked voxel value table (see
+* 		WlzWriteObjChunked()) then only the chunks which intersect
+* 		the bounding box are read and decompressed, with chunks
+* 		being skipped by seeking the stream when possible. Other
+* 		objects are read in full and then clipped using
+* 		WlzClipObjToBox3D().
+* 		A range of planes can be read by giving a bounding box
+* 		with the full range of lines and columns.
+* \param	fP			Input file.
+* \param	box			Bounding box to clip the object to.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzReadObjRegion(FILE *fP, WlzIBox3 box, WlzErrorNum *dstErr)
+{
+  int		c;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*fObj = NULL,
+  		*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((c = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_EOF;
+  }
+  else if(c != WLZ_3D_DOMAINOBJ)
+  {
+    (void )ungetc(c, fP);
+    fObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+  }
+  else
+  {
+    if((dom.p = WlzReadPlaneDomain(fP, &errNum)) != NULL)
+    {
+      if((fObj = WlzAssignObject(
+                 WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL,
+			     &errNum), NULL)) == NULL)
+      {
+        (void )WlzFreePlaneDomain(dom.p);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((c = getc(fP)) == WLZ_VOXELVALUETABLE_CHUNKED)
+      {
+	/* Clip the domain and then read only the chunks of the values
+	 * that are needed. */
+	rObj = WlzClipObjToBox3D(fObj, box, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzReadChunkedValues(fP,
+	                   (rObj->type == WLZ_3D_DOMAINOBJ)? rObj: NULL,
+	                   fObj->domain.p);
+	}
+      }
+      else
+      {
+	(void )ungetc(c, fP);
+	errNum = WlzReadDomObjValues3D(fP, fObj, NULL);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzPropertyList *pList;
+
+      pList = WlzReadPropertyList(fP, NULL);
+      if(rObj && (rObj->type == WLZ_3D_DOMAINOBJ))
+      {
+        rObj->plist = WlzAssignPropertyList(pList, NULL);
+      }
+      else
+      {
+        fObj->plist = WlzAssignPropertyList(pList, NULL);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (rObj == NULL) && (fObj != NULL))
+  {
+    rObj = WlzClipObjToBox3D(fObj, box, &errNum);
+    if((errNum == WLZ_ERR_NONE) &&
+       ((rObj->type == WLZ_2D_DOMAINOBJ) || (rObj->type == WLZ_3D_DOMAINOBJ)))
+    {
+      rObj->plist = WlzAssignPropertyList(fObj->plist, NULL);
+    }
+  }
+  (void )WlzFreeObj(fObj);
+  if((errNum != WLZ_ERR_NONE) && (rObj != NULL))
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream, as
+* 		WlzReadObj(), but with the tiles of any tiled values
+* 		being loaded on demand through the given tile cache
+* 		rather than being memory mapped or read into memory.
+* 		This allows many large tiled objects to be served
+* 		within the fixed memory budget of the cache.
+* 		The tiles are read using a duplicate of the stream's
+* 		file descriptor, so the stream may be closed once the
+* 		object has been read. If the stream is not seekable
+* 		(eg it is a pipe) then the tiles are read into memory.
+* 		Tiled values which load their tiles through a cache
+* 		can only be read, not modified.
+* \param	fP			Input file.
+* \param	cache			Tile cache.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzReadObjTileCached(FILE *fP, WlzTileCache *cache,
+				      WlzErrorNum *dstErr)
+{
+  int		c;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if((fP == NULL) || (cache == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((c = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_EOF;
+  }
+  else if(c == WLZ_2D_DOMAINOBJ)
+  {
+    if((dom.i = WlzReadIntervalDomain(fP, &errNum)) != NULL)
+    {
+      obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+    }
+    if(obj)
+    {
+      if((errNum = WlzReadDomObjValues2D(fP, obj, cache)) == WLZ_ERR_NONE)
+      {
+	obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fP, NULL),
+					   NULL);
+      }
+    }
+  }
+  else if(c == WLZ_3D_DOMAINOBJ)
+  {
+    if((dom.p = WlzReadPlaneDomain(fP, &errNum)) != NULL)
+    {
+      obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+    }
+    if(obj)
+    {
+      if((errNum = WlzReadDomObjValues3D(fP, obj, cache)) == WLZ_ERR_NONE)
+      {
+	obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fP, NULL),
+					   NULL);
+      }
+    }
+  }
+  else
+  {
+    (void )ungetc(c, fP);
+    obj = WlzReadObj(fP, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -2061,8 +2299,12 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
 * \param	obj			Object defining the domain of the
 *					grey values. The domain is known to
 *					be non NULL.
+* \param	cache			Tile cache through which the tiles
+* 					of tiled values are to be loaded on
+* 					demand, may be NULL.
 */
-static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj,
+					 WlzTileCache *cache)
 {
   WlzObjectType	type;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2086,7 +2328,7 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
       case WLZ_VALUETABLE_TILED_FLOAT:  /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_DOUBLE: /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_RGBA:
-	errNum = WlzReadTiledValues(fP, obj, 2, type, 1);
+	errNum = WlzReadTiledValues(fP, obj, 2, type, 1, cache);
 	break;
       default:
         errNum = WlzReadGreyValues(fP, type, obj);
@@ -2106,8 +2348,12 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
 * \param	obj			Object defining the domain of the
 *					grey values. The domain is known to
 *					be non NULL.
+* \param	cache			Tile cache through which the tiles
+* 					of tiled values are to be loaded on
+* 					demand, may be NULL.
 */
-static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj,
+					 WlzTileCache *cache)
 {
   WlzObjectType	type;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2128,6 +2374,9 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
       case WLZ_VOXELVALUETABLE_GREY:
         errNum = WlzReadVoxelValues(fP, obj);
 	break;
+      case WLZ_VOXELVALUETABLE_CHUNKED:
+        errNum = WlzReadChunkedValues(fP, obj, obj->domain.p);
+	break;
       case WLZ_VALUETABLE_TILED_INT:        /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_SHORT:      /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_UBYTE:      /* FALLTHROUGH */
@@ -2140,7 +2389,7 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
       case WLZ_VALUETABLE_TILED_ARY_FLOAT:  /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_ARY_DOUBLE: /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_ARY_RGBA:
-        errNum = WlzReadTiledValues(fP, obj, 3, type, 1);
+        errNum = WlzReadTiledValues(fP, obj, 3, type, 1, cache);
 	break;
       default:
         errNum = WLZ_ERR_VALUES_TYPE;
@@ -2165,10 +2414,15 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
 * 					value table type.
 * \param	map			If non zero the tiles are memory
 * 					mapped rather than read.
+* \param	cache			If non NULL the tiles are loaded on
+* 					demand through this tile cache
+* 					rather than being memory mapped or
+* 					read. If the file can not be used
+* 					for this the tiles are read.
 */
 static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 				      int dim, WlzObjectType type,
-				      int map)
+				      int map, WlzTileCache *cache)
 {
   int		vRank,
   		kol1,
@@ -2297,7 +2551,30 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(map)
+    if(cache)
+    {
+#ifdef WLZ_USE_MMAP
+      int	cFd;
+
+      /* The tiles are read using pread() with a duplicate file
+       * descriptor, which leaves the file offset unchanged, but this
+       * is only possible if the file is seekable. */
+      if((cFd = dup(fileno(fP))) >= 0)
+      {
+	if((lseek(cFd, 0, SEEK_CUR) < 0) ||
+	   (WlzTiledValuesSetTileCache(tVal, cache, cFd) != WLZ_ERR_NONE))
+	{
+	  (void )close(cFd);
+	}
+	else if(fseek(fP, tVal->tileOffset + (gSz * tSz * vSz),
+	              SEEK_SET) != 0)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+#endif /* WLZ_USE_MMAP */
+    }
+    else if(map)
     {
 #ifdef WLZ_USE_MMAP
       /* For mmap to work the file must have been opened either with
@@ -2338,7 +2615,7 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
       tVal->tiles.v = NULL;
 #endif /* WLZ_USE_MMAP */
     }
-    if((errNum == WLZ_ERR_NONE) && (tVal->fd < 0))
+    if((errNum == WLZ_ERR_NONE) && (tVal->fd < 0) && (tVal->cache == NULL))
     {
       /* Have either failed to mmap the tiles or we're not using mmap
        * so just malloc space and read them. */
@@ -2534,6 +2811,577 @@ static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
   return errNum;
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads a chunked voxel value table (see
+* 		WlzWriteObjChunked()) from the input file. The table type
+* 		has already been read and verified. The values are only
+* 		decompressed for the chunks which intersect the domain of
+* 		the given object, which must be a sub-domain of the plane
+* 		domain with which the values were written. The chunks are
+* 		decompressed in parallel. On return the file is positioned
+* 		after the chunked values, whether or not all chunks were
+* 		needed.
+* \param	fP			Input file.
+* \param	obj			Object with the domain for which values
+* 					are required, may be NULL in which
+* 					case the values are skipped.
+* \param	fPDom			Plane domain with which the values
+* 					were written.
+*/
+static WlzErrorNum WlzReadChunkedValues(FILE *fP, WlzObject *obj,
+					WlzPlaneDomain *fPDom)
+{
+  int		idx,
+		bandLn,
+  		nBnd = 0,
+		nChk = 0,
+		nPln = 0;
+  size_t	skip = 0;
+  int		*rawSz = NULL,
+  		*cmpSz = NULL;
+  char		*need = NULL;
+  WlzUByte	**cmpBuf = NULL;
+  WlzGreyType	gType;
+  WlzChunkCodec	codec;
+  WlzPixelV	bgd;
+  WlzValues	val;
+  WlzPlaneDomain *pDom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  gType = (WlzGreyType )getc(fP);
+  codec = (WlzChunkCodec )getc(fP);
+  bandLn = getword(fP);
+  errNum = WlzReadPixelV(fP, &bgd, 1);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPln = getword(fP);
+    nBnd = getword(fP);
+    if(feof(fP) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if((bandLn < 1) ||
+	    (nPln != fPDom->lastpl - fPDom->plane1 + 1) ||
+	    (nBnd != (fPDom->lastln - fPDom->line1 + bandLn) / bandLn))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+        break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  /* Read the chunk index. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nChk = nPln * nBnd;
+    if(((rawSz = (int *)AlcMalloc(nChk * sizeof(int))) == NULL) ||
+       ((cmpSz = (int *)AlcMalloc(nChk * sizeof(int))) == NULL) ||
+       ((need = (char *)AlcCalloc(nChk, sizeof(char))) == NULL) ||
+       ((cmpBuf = (WlzUByte **)AlcCalloc(nChk, sizeof(WlzUByte *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nChk); ++idx)
+  {
+    rawSz[idx] = getword(fP);
+    cmpSz[idx] = getword(fP);
+    if((rawSz[idx] < 0) || (cmpSz[idx] < 0) || (cmpSz[idx] > rawSz[idx]))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (feof(fP) != 0))
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  /* Find the chunks needed for the domain of the given object. */
+  if((errNum == WLZ_ERR_NONE) && (obj != NULL))
+  {
+    int		p;
+
+    pDom = obj->domain.p;
+    if((pDom->plane1 < fPDom->plane1) || (pDom->lastpl > fPDom->lastpl))
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    for(p = 0; (errNum == WLZ_ERR_NONE) &&
+               (p <= pDom->lastpl - pDom->plane1); ++p)
+    {
+      WlzDomain	dom;
+
+      dom = pDom->domains[p];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	int	b,
+		b0,
+		b1;
+
+        idx = (p + pDom->plane1 - fPDom->plane1) * nBnd;
+	b0 = (dom.i->line1 - fPDom->line1) / bandLn;
+	b1 = (dom.i->lastln - fPDom->line1) / bandLn;
+	if((dom.i->line1 < fPDom->line1) || (b1 >= nBnd))
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
+	else
+	{
+	  for(b = b0; b <= b1; ++b)
+	  {
+	    need[idx + b] = 1;
+	  }
+	}
+      }
+    }
+  }
+  /* Read the chunks that are needed, skipping the rest. */
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nChk); ++idx)
+  {
+    if(need[idx] && (cmpSz[idx] > 0))
+    {
+      if(skip > 0)
+      {
+        errNum = WlzReadSkip(fP, skip);
+	skip = 0;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        if((cmpBuf[idx] = (WlzUByte *)AlcMalloc(cmpSz[idx])) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else if(fread(cmpBuf[idx], sizeof(WlzUByte), cmpSz[idx],
+	              fP) != (size_t )(cmpSz[idx]))
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+    }
+    else
+    {
+      skip += cmpSz[idx];
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (skip > 0))
+  {
+    errNum = WlzReadSkip(fP, skip);
+  }
+  /* Make the new voxel value table and decompress the chunks into it
+   * in parallel. */
+  if((errNum == WLZ_ERR_NONE) && (obj != NULL))
+  {
+    errNum = WlzValueConvertPixel(&bgd, bgd, gType);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      val.vox = WlzNewValuesVox(obj,
+                                WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR,
+				                      gType, NULL),
+				bgd, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->values = WlzAssignValues(val, NULL);
+    }
+    else if(val.vox != NULL)
+    {
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj != NULL))
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p <= pDom->lastpl - pDom->plane1; ++p)
+    {
+      WlzDomain	dom;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      dom = pDom->domains[p];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	int	fp;
+
+	fp = p + pDom->plane1 - fPDom->plane1;
+        errNum2 = WlzReadChunkPlane(dom, val.vox->values[p],
+				    fPDom->domains[fp], fPDom->line1,
+				    bandLn, gType, codec,
+				    rawSz + fp * nBnd, cmpSz + fp * nBnd,
+				    cmpBuf + fp * nBnd);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzReadChunkedValues)
+#endif
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  if(cmpBuf)
+  {
+    for(idx = 0; idx < nChk; ++idx)
+    {
+      AlcFree(cmpBuf[idx]);
+    }
+    AlcFree(cmpBuf);
+  }
+  AlcFree(need);
+  AlcFree(rawSz);
+  AlcFree(cmpSz);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Decompresses the chunks of a single plane which are needed
+* 		for the given domain and copies their values into the
+* 		given value table.
+* \param	dDom			Domain of the plane for which values
+* 					are required, this must be within
+* 					the domain with which the values were
+* 					written.
+* \param	dVal			Value table to set.
+* \param	fDom			Domain of the plane with which the
+* 					values were written.
+* \param	line1			First line of the plane domain with
+* 					which the values were written.
+* \param	bandLn			Number of lines in each chunk.
+* \param	gType			Grey type of the chunks.
+* \param	codec			Compression used for the chunks.
+* \param	rawSz			Uncompressed sizes of the plane's
+* 					chunks.
+* \param	cmpSz			Compressed sizes of the plane's
+* 					chunks.
+* \param	cmpBuf			Compressed chunks of the plane.
+*/
+static WlzErrorNum WlzReadChunkPlane(WlzDomain dDom, WlzValues dVal,
+				     WlzDomain fDom, int line1,
+				     int bandLn, WlzGreyType gType,
+				     WlzChunkCodec codec, int *rawSz,
+				     int *cmpSz, WlzUByte **cmpBuf)
+{
+  int		b,
+  		b0,
+		b1,
+		ln;
+  size_t	gSz,
+  		tot = 0;
+  WlzUByte	*bP,
+  		*rawBuf = NULL;
+  WlzUByte	**lnP = NULL;
+  WlzObject	obj2D;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fDom.core == NULL) || (fDom.core->type == WLZ_EMPTY_DOMAIN))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  else
+  {
+    gSz = WlzGreySize(gType);
+    b0 = (dDom.i->line1 - line1) / bandLn;
+    b1 = (dDom.i->lastln - line1) / bandLn;
+    for(b = b0; b <= b1; ++b)
+    {
+      tot += rawSz[b];
+    }
+    if(((rawBuf = (WlzUByte *)AlcMalloc(tot + 1)) == NULL) ||
+       ((lnP = (WlzUByte **)AlcMalloc(sizeof(WlzUByte *) *
+				      (dDom.i->lastln - dDom.i->line1 + 1)))
+				      == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Decompress the chunks. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bP = rawBuf;
+    for(b = b0; (errNum == WLZ_ERR_NONE) && (b <= b1); ++b)
+    {
+      if(rawSz[b] > 0)
+      {
+	errNum = WlzReadChunkDecompress(codec, cmpBuf[b], cmpSz[b],
+					bP, rawSz[b]);
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+	if((errNum == WLZ_ERR_NONE) && (gSz > 1))
+	{
+	  size_t i,
+	  	 j;
+
+	  for(i = 0; i < (size_t )(rawSz[b]); i += gSz)
+	  {
+	    for(j = 0; j < gSz / 2; ++j)
+	    {
+	      WlzUByte t;
+
+	      t = bP[i + j];
+	      bP[i + j] = bP[i + gSz - 1 - j];
+	      bP[i + gSz - 1 - j] = t;
+	    }
+	  }
+	}
+#endif /* __sparc || __mips || __ppc */
+	bP += rawSz[b];
+      }
+    }
+  }
+  /* Find the start of each of the required lines within the chunks. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bP = rawBuf;
+    for(ln = line1 + (b0 * bandLn); ln <= dDom.i->lastln; ++ln)
+    {
+      if(ln >= dDom.i->line1)
+      {
+        lnP[ln - dDom.i->line1] = bP;
+      }
+      bP += gSz * WlzReadChunkLnWidth(fDom.i, ln);
+    }
+    if(bP > rawBuf + tot)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  /* Copy the values into the value table, finding the offset of each
+   * interval within the line in which it was written. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj2D.type = WLZ_2D_DOMAINOBJ;
+    obj2D.linkcount = 0;
+    obj2D.domain = dDom;
+    obj2D.values = dVal;
+    obj2D.plist = NULL;
+    obj2D.assoc = NULL;
+    if((errNum = WlzInitGreyScan(&obj2D, &iWSp, &gWSp)) == WLZ_ERR_NONE)
+    {
+      int	fItv = 0,
+		fOff = 0;
+      WlzIntervalDomain *fIDom;
+
+      ln = dDom.i->line1 - 1;
+      fIDom = fDom.i;
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	kl,
+		kr;
+	WlzGreyP srcP;
+
+	if(iWSp.linpos != ln)
+	{
+	  ln = iWSp.linpos;
+	  fItv = 0;
+	  fOff = 0;
+	}
+	kl = iWSp.lftpos - fIDom->kol1;
+	kr = iWSp.rgtpos - fIDom->kol1;
+	if(fIDom->type == WLZ_INTERVALDOMAIN_RECT)
+	{
+	  fOff = kl;
+	  if((kl < 0) || (kr > fIDom->lastkl - fIDom->kol1) ||
+	     (ln < fIDom->line1) || (ln > fIDom->lastln))
+	  {
+	    errNum = WLZ_ERR_DOMAIN_DATA;
+	  }
+	}
+	else if((ln < fIDom->line1) || (ln > fIDom->lastln))
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
+	else
+	{
+	  WlzIntervalLine *itvLn;
+
+	  itvLn = fIDom->intvlines + ln - fIDom->line1;
+	  while((fItv < itvLn->nintvs) && (itvLn->intvs[fItv].iright < kl))
+	  {
+	    fOff += itvLn->intvs[fItv].iright - itvLn->intvs[fItv].ileft + 1;
+	    ++fItv;
+	  }
+	  if((fItv >= itvLn->nintvs) ||
+	     (itvLn->intvs[fItv].ileft > kl) ||
+	     (itvLn->intvs[fItv].iright < kr))
+	  {
+	    errNum = WLZ_ERR_DOMAIN_DATA;
+	  }
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
+	  break;
+	}
+	srcP.ubp = lnP[ln - dDom.i->line1] + gSz *
+	           ((fIDom->type == WLZ_INTERVALDOMAIN_RECT)?
+		    fOff: fOff + kl -
+		    fIDom->intvlines[ln - fIDom->line1].intvs[fItv].ileft);
+	WlzValueCopyGreyToGrey(gWSp.u_grintptr, 0, gWSp.pixeltype,
+			       srcP, 0, gType, iWSp.colrmn);
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+  }
+  AlcFree(lnP);
+  AlcFree(rawBuf);
+  return(errNum);
+}
+
+/*!
+* \return	Number of values in the given line of the interval domain.
+* \ingroup	WlzIO
+* \brief	Computes the number of values in a line of an interval
+* 		domain, which is zero for lines outside of the domain.
+* \param	iDom			Given interval domain.
+* \param	ln			Given line.
+*/
+static int	WlzReadChunkLnWidth(WlzIntervalDomain *iDom, int ln)
+{
+  int		wd = 0;
+
+  if((ln >= iDom->line1) && (ln <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      wd = iDom->lastkl - iDom->kol1 + 1;
+    }
+    else
+    {
+      int	i;
+      WlzIntervalLine *itvLn;
+
+      itvLn = iDom->intvlines + ln - iDom->line1;
+      for(i = 0; i < itvLn->nintvs; ++i)
+      {
+        wd += itvLn->intvs[i].iright - itvLn->intvs[i].ileft + 1;
+      }
+    }
+  }
+  return(wd);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Decompresses a single chunk that was compressed using the
+* 		given codec. Chunks with equal compressed and uncompressed
+* 		sizes were not compressed and are just copied.
+* \param	codec			Compression codec.
+* \param	src			Compressed data.
+* \param	srcSz			Number of bytes of compressed data.
+* \param	dst			Buffer for the uncompressed data.
+* \param	dstSz			Number of bytes of uncompressed data.
+*/
+static WlzErrorNum WlzReadChunkDecompress(WlzChunkCodec codec,
+					  WlzUByte *src, size_t srcSz,
+					  WlzUByte *dst, size_t dstSz)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(srcSz == dstSz)
+  {
+    (void )memcpy(dst, src, dstSz);
+  }
+  else
+  {
+    switch(codec)
+    {
+      case WLZ_CHUNK_CODEC_ZLIB:
+#if HAVE_ZLIB != 0
+	{
+	  uLongf zSz;
+
+	  zSz = dstSz;
+	  if((uncompress(dst, &zSz, src, srcSz) != Z_OK) || (zSz != dstSz))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+#else
+	errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_ZLIB */
+	break;
+      case WLZ_CHUNK_CODEC_BZIP2:
+#if HAVE_BZLIB != 0
+	{
+	  unsigned int bSz;
+
+	  bSz = dstSz;
+	  if((BZ2_bzBuffToBuffDecompress((char *)dst, &bSz, (char *)src,
+					 srcSz, 0, 0) != BZ_OK) ||
+	     (bSz != dstSz))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+#else
+	errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_BZLIB */
+	break;
+      default:
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Skips the given number of bytes of the input file, seeking
+* 		when possible and otherwise reading and discarding them.
+* \param	fP			Input file.
+* \param	n			Number of bytes to skip.
+*/
+static WlzErrorNum WlzReadSkip(FILE *fP, size_t n)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fseek(fP, (long )n, SEEK_CUR) != 0)
+  {
+    char	buf[4096];
+
+    while((errNum == WLZ_ERR_NONE) && (n > 0))
+    {
+      size_t	m;
+
+      m = (n < sizeof(buf))? n: sizeof(buf);
+      if(fread(buf, sizeof(char), m, fP) != m)
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      n -= m;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	New Woolz property.
 * \ingroup	WlzIO
@@ -2894,6 +3742,87 @@ static WlzBSpline *WlzReadSpline(FILE *fP, WlzErrorNum *dstErr)
   return(bs);
 }
 
+/*!
+* \return	New indexed mesh domain.
+* \ingroup	WlzIO
+* \brief	Reads a Woolz indexed mesh domain from the input file.
+* 		The element vertex indices are checked to be within the
+* 		range of the mesh vertices.
+* \param	fP			Input file.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzIdxMesh *WlzReadIdxMesh(FILE *fP, WlzErrorNum *dstErr)
+{
+  int		nVtx = 0,
+  		nElm = 0,
+		version = 0;
+  WlzObjectType	type;
+  WlzIdxMesh	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((type = (WlzObjectType )getc(fP)) == (WlzObjectType )EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if(type == WLZ_NULL)
+  {
+    errNum = WLZ_ERR_EOO;
+  }
+  else
+  {
+    version = getc(fP);
+    nVtx = getword(fP);
+    nElm = getword(fP);
+    if(feof(fP) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if((version != 1) || (nVtx < 0) || (nElm < 0))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh = WlzMakeIdxMesh(type, nVtx, nElm, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh->nVtx = nVtx;
+    mesh->nElm = nElm;
+    errNum = WlzReadDouble(fP, mesh->vtx, 3 * nVtx);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzReadInt(fP, mesh->elm, mesh->nElmVtx * nElm);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idx,
+    		nIdx;
+
+    nIdx = mesh->nElmVtx * nElm;
+    for(idx = 0; idx < nIdx; ++idx)
+    {
+      if((mesh->elm[idx] < 0) || (mesh->elm[idx] >= nVtx))
+      {
+        errNum = WLZ_ERR_DOMAIN_DATA;
+	break;
+      }
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzFreeIdxMesh(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
 /*!
 * \return	New polygon domain.
 * \ingroup	WlzIO
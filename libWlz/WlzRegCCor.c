@@ -110,8 +110,8 @@ static double			WlzRegCCorObjs2DRot(
 *               which when applied to the source object takes it into
 *		register with the target object.
 *		Because frequency domain cross correlation (which relies on
-*		the FFT) is used the objects are padded out to arrays which
-*		are an integer power of two in size. This padding introduces
+*		the FFT) is used the objects are padded out to arrays with
+*		sizes chosen by AlgFourNextSize(). This padding introduces
 *		significant influence of the objects boundaries and in many
 *		cases the registration will be dominated by the boundaries.
 *		To avoid the boundary problem, two methods are available -
@@ -846,8 +846,8 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourNextSize(aSz.vtX, 1);
+    aSz.vtY = AlgFourNextSize(aSz.vtY, 1);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -1107,8 +1107,8 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourNextSize(aSz.vtX, 1);
+    aSz.vtY = AlgFourNextSize(aSz.vtY, 1);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -50,6 +50,7 @@ static char _WlzRegICP_c[] = "University of Edinburgh $Id$";
 */
 
 #include <float.h>
+#include <sys/time.h>
 #include <Wlz.h>
 
 /*!
@@ -66,7 +67,7 @@ typedef struct _WlzRegICPWSp
   double	prvMetric;	/*!< Last sum of distances between NN */
   /* Nearest neighbour search. */
   double	maxDist;	/*!< Maximum distance to consider for a NN */
-  AlcKDTTree	*tTree;		/*!< kD-tree */
+  AlcKDTFlatTree *tTree;	/*!< kD-tree */
   int		*sNN;		/*!< Indicies of NN to source vertices */
   double	*dist;		/*!< NN distances */
   /* Vericies and normals. */
@@ -113,6 +114,13 @@ static WlzErrorNum 		WlzRegICPCheckVertices(
 				  WlzVertexType *vType);
 static WlzErrorNum 		WlzRegICPBuildTree(
 				  WlzRegICPWSp *wSp);
+static double			WlzRegICPTime(void);
+static void			WlzRegICPStatsAdd(
+				  WlzRegICPCtl *ctl,
+				  int lvl,
+				  int nMatch,
+				  double metric,
+				  double *t);
 static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
 				  AlcKDTTree *tree,
 				  WlzTransformType trType,
@@ -137,6 +145,8 @@ static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  int nLevels,
+				  WlzRegICPCtl *ctl,
 				  WlzErrorNum *dstErr);
 
 /*!
@@ -885,6 +895,7 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
+  AlcKDTFlatFree(wSp.tTree);
   (void )WlzFreeAffineTransform(wSp.prvTr);
   if(wSp.curTr)
   {
@@ -1089,6 +1100,7 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
+  AlcKDTFlatFree(wSp.tTree);
   (void )WlzFreeAffineTransform(wSp.curTr);
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1111,20 +1123,79 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
 /*!
 * \return				Woolz error code
 * \ingroup	WlzTransform
-* \brief	Allocates and populates a k-D tree from the given vertices.
-* 		The vertices are either WlzDVertex2 orWlzDVertex3
+* \brief	Allocates and populates a flat k-D tree from the given
+*		vertices. The vertices are either WlzDVertex2 or
+*		WlzDVertex3, both of which are contiguous arrays of
+*		doubles, so they are used directly as the tree keys.
 * \param	wSp			ICP registration workspace.
 */
 static WlzErrorNum WlzRegICPBuildTree(WlzRegICPWSp *wSp)
 {
+  AlcErrno	alcErr = ALC_ER_NONE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  /* Use wSp->sNN as a temporay buffer of shuffling indcies. */
-  wSp->tTree = WlzVerticesBuildTree(wSp->vType, wSp->nT, wSp->gTVx,
-  				     wSp->sNN, &errNum);
+  wSp->tTree = AlcKDTFlatNew((wSp->vType == WLZ_VERTEX_D2)? 2: 3,
+  			     wSp->nT, (double *)(wSp->gTVx.v), 0, &alcErr);
+  if(alcErr != ALC_ER_NONE)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
   return(errNum);
 }
 
+/*!
+* \return	Wall clock time in seconds.
+* \ingroup	WlzTransform
+* \brief	Gets the current wall clock time for the ICP iteration
+*		statistics.
+*/
+static double	WlzRegICPTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return((double )(tv.tv_sec) + (1.0e-06 * (double )(tv.tv_usec)));
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Records the statistics of a single ICP iteration in the
+*		given control data structure. The iteration count is
+*		always incremented, but statistics are only set while
+*		there is room for them.
+* \param	ctl			ICP control data structure, may
+*					be NULL.
+* \param	lvl			Multi-resolution level.
+* \param	nMatch			Number of matches used.
+* \param	metric			Registration metric.
+* \param	t			Array of four times taken at the
+*					start of the iteration, after the
+*					correspondence search, after the
+*					weighting and after the transform
+*					update.
+*/
+static void	WlzRegICPStatsAdd(WlzRegICPCtl *ctl, int lvl, int nMatch,
+				  double metric, double *t)
+{
+  WlzRegICPItrStats *st;
+
+  if(ctl)
+  {
+    if(ctl->stats && (ctl->nStats >= 0) && (ctl->nStats < ctl->maxStats))
+    {
+      st = ctl->stats + ctl->nStats;
+      st->level = lvl;
+      st->nMatch = nMatch;
+      st->metric = metric;
+      st->tCor = t[1] - t[0];
+      st->tWgt = t[2] - t[1];
+      st->tTr = t[3] - t[2];
+    }
+    ++(ctl->nStats);
+  }
+}
+
 /*!
 * \return				Nonzero if the iteration has
 * 					converged.
@@ -1198,6 +1269,9 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 
   if(wSp->vType == WLZ_VERTEX_D2)
   {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d2 + idx) = WlzAffineTransformVertexD2(wSp->curTr,
@@ -1205,6 +1279,9 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
     }
     if(wSp->gSNr.v)
     {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
       for(idx = 0; idx < wSp->nS; ++idx)
       {
         *(wSp->tSNr.d2 + idx) = WlzAffineTransformNormalD2(wSp->curTr,
@@ -1214,6 +1291,9 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
   }
   else /* wSp->vType == WLZ_VERTEX_D3 */
   {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d3 + idx) = WlzAffineTransformVertexD3(wSp->curTr,
@@ -1221,6 +1301,9 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
     }
     if(wSp->gSNr.v)
     {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
       for(idx = 0; idx < wSp->nS; ++idx)
       {
         *(wSp->tSNr.d3 + idx) = WlzAffineTransformNormalD3(wSp->curTr,
@@ -1236,41 +1319,36 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 * \brief	Finds nearest neighbour matches in the target tree for
 *		the source vertices, sets the nearest neighbour
 *		indicies and permutes the NN ordered target vertices in
-*		the workspace.
+*		the workspace. The searches are independent and so are
+*		done in parallel.
 * \param	wSp			ICP registration workspace.
 */
 static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 {
   int		idx;
-  WlzDVertex2	tVD2;
-  WlzDVertex3	tVD3;
-  double	datD[3];
-  AlcKDTNode	*node;
 
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    int		idT;
+
+    /* WlzDVertex2 and WlzDVertex3 are arrays of doubles. */
+    idT = AlcKDTFlatGetNN(wSp->tTree,
+    			  (wSp->vType == WLZ_VERTEX_D2)?
+			  (double *)(wSp->tSVx.d2 + idx):
+			  (double *)(wSp->tSVx.d3 + idx),
+			  wSp->maxDist, wSp->dist + idx);
+    idT = WLZ_MAX(idT, 0);
+    *(wSp->sNN + idx) = idT;
     if(wSp->vType == WLZ_VERTEX_D2)
     {
-      tVD2 = *(wSp->tSVx.d2 + idx);
-      datD[0] = tVD2.vtX;
-      datD[1] = tVD2.vtY;
-    }
-    else /* wSp->vType == WLZ_VERTEX_D3 */
-    {
-      tVD3 = *(wSp->tSVx.d3 + idx);
-      datD[0] = tVD3.vtX;
-      datD[1] = tVD3.vtY;
-      datD[2] = tVD3.vtZ;
-    }
-    node = AlcKDTGetNN(wSp->tTree, datD, wSp->maxDist, wSp->dist + idx, NULL);
-    *(wSp->sNN + idx) = node->idx;
-    if(wSp->vType == WLZ_VERTEX_D2)
-    {
-      *(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + node->idx);
+      *(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + idT);
     }
     else /* wSp->vType == WLZ_VERTEX_D3 */
     {
-      *(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + node->idx);
+      *(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + idT);
     }
   }
 }
@@ -1310,6 +1388,9 @@ static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 *		registration, with \f$W_{min} = 0\f$ giving good
 *		localisation and \f$W_{min} = 0.25\f$ giving a more
 *		global registration.
+*
+*		The weights are computed in parallel but their sum is
+*		always accumulated in the same order.
 * \param	wSp			ICP registration workspace.
 * \param	minVxWgt		Minimum distance weighting
 * 					\f$W_{min}\f$, range [0-1].
@@ -1321,13 +1402,9 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 		w0,
 		w1,
 		w2,
-  		wVx,
 		minDist,
 		maxDist,
-		wNr = 0.0,
 		meanSumWgt = 0.0;
-  WlzVertex	sV,
-  		tV;
 
   /* Find the maximum and minimum distances. */
   minDist = maxDist = *(wSp->dist + 0);
@@ -1346,8 +1423,16 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
   w0 = maxDist - minDist;
   w1 = 1.0 - minVxWgt;
   w2 = (w0 > DBL_EPSILON)? w1 / w0: 1.0;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    double	wVx,
+    		wNr = 0.0;
+    WlzVertex	sV,
+    		tV;
+
     /* Use linear weighting for distance such that:
      *   w = minVxWgt, d = maxDist
      * and
@@ -1382,14 +1467,16 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
     }
     if(wSp->sgnNrm)
     {
-      tD0 = wVx * wNr;
+      *(wSp->wgt + idx) = wVx * wNr;
     }
     else
     {
-      tD0 = wVx * wNr * wNr;
+      *(wSp->wgt + idx) = wVx * wNr * wNr;
     }
-    meanSumWgt += tD0 * *(wSp->dist + idx);
-    *(wSp->wgt + idx) = tD0;
+  }
+  for(idx = 0; idx < wSp->nMatch; ++idx)
+  {
+    meanSumWgt += *(wSp->wgt + idx) * *(wSp->dist + idx);
   }
   meanSumWgt /= wSp->nMatch;
   return(meanSumWgt);
@@ -1503,6 +1590,13 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
 *		kD-tree and the given buffers.
 *		This function will attempt to find a rigid body registration
 *		before attempting a general affine registration.
+*		On each iteration the correspondence search and match
+*		weighting are done in parallel, while all sums are
+*		accumulated serially so that the result does not depend
+*		on the number of threads. As the user weight function may
+*		be called concurrently it must be thread safe.
+*		This function is equivalent to
+*		WlzRegICPTreeAndVerticesCtl() with a NULL control.
 * \param	tree			Given kD-tree populated by the
 *					target vertices such that the
 *					nodes of the tree have the same
@@ -1555,6 +1649,87 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
 				WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *tr;
+
+  tr = WlzRegICPTreeAndVerticesCtl(tree, trType, vType, sgnNrm,
+				   nT, tVx, tNr, nS, sIdx, sVx, sNr,
+				   tVxBuf, sVxBuf, wgtBuf, maxItr,
+				   initTr, dstConv, usrWgtFn, usrWgtData,
+				   delta, minDistWgt, NULL, dstErr);
+  return(tr);
+}
+
+/*!
+* \return	Affine transform found.
+* \ingroup	WlzTransform
+* \brief	Registers the given vertices using the already built
+*		kD-tree and the given buffers.
+*		This function will attempt to find a rigid body registration
+*		before attempting a general affine registration.
+*		On each iteration the correspondence search and match
+*		weighting are done in parallel, while all sums are
+*		accumulated serially so that the result does not depend
+*		on the number of threads. As the user weight function may
+*		be called concurrently it must be thread safe.
+*		This function is WlzRegICPTreeAndVertices() with
+*		optional control parameters and statistics.
+* \param	tree			Given kD-tree populated by the
+*					target vertices such that the
+*					nodes of the tree have the same
+*					indicies as the given target vertices
+*					and normals.
+* \param	trType			The required type of transform,
+*					must be either WLZ_TRANSFORM_2D_REG,
+*					or WLZ_TRANSFORM_2D_AFFINE.
+* \param	vType			Vertex type.
+* \param	sgnNrm			Non zero if sign of normal components
+* 					is meaningful.
+* \param	nT			Number of target vertices.
+* \param	tVx			The target vertices.
+* \param	tNr			The target normals.
+* \param        nS			Number of source vertices.
+* \param	sIdx			Indicies of the source
+*					vertices/normals.
+* \param        sVx 			The source vertices.
+* \param	sNr			The source normals.
+* \param	tVxBuf			A buffer with room for at least
+*					nS vertices.
+* \param	sVxBuf			A buffer with room for at least
+*					nS vertices.
+* \param	wgtBuf			A buffer with room for at least
+*					nS doubles.
+* \param	maxItr			Maximum number of iterations.
+* \param	initTr			Initial affine transform.
+* \param	dstConv			Destination pointer for a
+*					convergence flag which is set to
+*					a non zero value if the registration
+*					converges.
+* \param	usrWgtFn		User supplied weight function, may be
+* 					NULL.
+* \param	usrWgtData		User supplied weight data, may be NULL.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	ctl			Optional control parameters for a
+*					flat kD-tree, a multi-resolution
+*					schedule and per iteration
+*					statistics, may be NULL.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform *WlzRegICPTreeAndVerticesCtl(AlcKDTTree *tree,
+				WlzTransformType trType,
+				WlzVertexType vType, int sgnNrm,
+				int nT, WlzVertexP tVx, WlzVertexP tNr,
+				int nS, int *sIdx,
+				WlzVertexP sVx, WlzVertexP sNr,
+				WlzVertexP tVxBuf, WlzVertexP sVxBuf,
+				double *wgtBuf, int maxItr,
+				WlzAffineTransform *initTr, int *dstConv,
+				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
+				double delta, double minDistWgt,
+				WlzRegICPCtl *ctl, WlzErrorNum *dstErr)
 {
   int		conv = 0;
   double	prvMetric = DBL_MAX,
@@ -1587,6 +1762,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
 					 delta, minDistWgt,
+					 (ctl)? ctl->nLevels: 0, ctl,
 					 &errNum);
 #ifdef WLZ_REGICP_DEBUG
     (void )fprintf(stderr, "WlzRegICP newTr0->mat = \n");
@@ -1602,6 +1778,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
 					 delta, minDistWgt,
+					 0, ctl,
 					 &errNum);
     (void )WlzFreeAffineTransform(newTr0);
     newTr0 = newTr1;
@@ -1669,6 +1846,15 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	nLevels			Number of multi-resolution levels,
+*					with only every \f$2^l\f$'th source
+*					vertex used at level \f$l\f$.
+* \param	ctl			Optional control parameters, may be
+*					NULL. If the flat kD-tree is set
+*					it is used in place of the given
+*					tree for the correspondence search
+*					and iteration statistics are
+*					recorded.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -1685,43 +1871,47 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 				int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				int nLevels, WlzRegICPCtl *ctl,
 				WlzErrorNum *dstErr)
 {
   int		idS,
   		idM,
-		idV,
+		lvl,
+		stp,
+		rst = 0,
 		itr = 0,
 		conv = 0;
-  AlcKDTNode	*tNode;
+  AlcKDTFlatTree *fTree;
   WlzAffineTransform *invTr = NULL,
 		*prvTr = NULL,
   		*curTr = NULL,
   		*newTr = NULL;
-  WlzVertex	dV,
-  		sV,
-		sN,
-		sTV,
-		sTN,
-  		tV,
-		tN;
   double	wgt0,
 		wgt1,
 		wgt2,
 		wMaxDist,
 		wMinDist,
-		dist,
-  		wNr,
-		wVx,
 		prvMetric = 0.0,
 		curMetric = 0.0;
-  double	vxD[3];
+  double	*dstBuf = NULL;
+  double	tm[4];
   WlzErrorNum	errNum = WLZ_ERR_NONE;
  
+  fTree = (ctl)? ctl->fTree: NULL;
+  lvl = (nLevels > 1)? nLevels - 1: 0;
   curTr = (initTr == NULL)?
   	  WlzMakeAffineTransform(WLZ_TRANSFORM_2D_AFFINE, &errNum):
 	  WlzAffineTransformCopy(initTr, &errNum);
   curMetric = *gCurMetric;
   if(errNum == WLZ_ERR_NONE)
+  {
+    if((dstBuf = (double *)
+                 AlcMalloc(sizeof(double) * WLZ_MAX(nS, 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     invTr = WlzAffineTransformInverse(curTr, &errNum);
   }
@@ -1729,95 +1919,113 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
   {
     do
     {
-      idM = 0;
-      wMinDist = DBL_MAX;
-      wMaxDist = 0.0;
-      prvMetric = curMetric;
+      tm[0] = WlzRegICPTime();
+      /* On coarse levels only every stp'th source vertex is used. */
+      stp = 1 << lvl;
+      idM = (nT > 0)? (nS + stp - 1) / stp: 0;
+      prvMetric = (rst)? DBL_MAX: curMetric;
+      rst = 0;
       curMetric = 0.0;
-      /* Populate the buffers with source vertices, nearest neighbours
-       * in the target tree and scalar product of vertex normals. While
-       * doinf this also find maximum and minimum source - target vertex
-       * distances */
-      for(idS = 0; idS < nS; ++idS)
+      /* Populate the buffers with transformed source vertices, nearest
+       * neighbours in the target tree, scalar product of vertex normals
+       * and source - target vertex distances. Each match is independent
+       * of the others and so they are found in parallel. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for(idS = 0; idS < idM; ++idS)
       {
-	idV = *(sIdx + idS);
+        int	idT,
+		idV;
+	double	dist = 0.0;
+	double	vxD[3];
+	WlzVertex sTV,
+		sTN;
+
+	idV = *(sIdx + (idS * stp));
 	if(vType == WLZ_VERTEX_D2)
 	{
-	  sV.d2 = *(sVx.d2 + idV);
-	  sN.d2 = *(sNr.d2 + idV);
-	  sTV.d2 = WlzAffineTransformVertexD2(curTr, sV.d2, NULL);
-	  sTN.d2 = WlzAffineTransformNormalD2(curTr, sN.d2, NULL);
-	  *(sTVxBuf.d2 + idM) = sTV.d2;
+	  sTV.d2 = WlzAffineTransformVertexD2(curTr, *(sVx.d2 + idV), NULL);
+	  sTN.d2 = WlzAffineTransformNormalD2(curTr, *(sNr.d2 + idV), NULL);
+	  *(sTVxBuf.d2 + idS) = sTV.d2;
 	  vxD[0] = sTV.d2.vtX;
 	  vxD[1] = sTV.d2.vtY;
 	}
 	else /* vType == WLZ_VERTEX_D3 */
 	{
-	  sV.d3 = *(sVx.d3 + idV);
-	  sN.d3 = *(sNr.d3 + idV);
-	  sTV.d3 = WlzAffineTransformVertexD3(curTr, sV.d3, NULL);
-	  sTN.d3 = WlzAffineTransformNormalD3(curTr, sN.d3, NULL);
-	  *(sTVxBuf.d3 + idM) = sTV.d3;
+	  sTV.d3 = WlzAffineTransformVertexD3(curTr, *(sVx.d3 + idV), NULL);
+	  sTN.d3 = WlzAffineTransformNormalD3(curTr, *(sNr.d3 + idV), NULL);
+	  *(sTVxBuf.d3 + idS) = sTV.d3;
 	  vxD[0] = sTV.d3.vtX;
 	  vxD[1] = sTV.d3.vtY;
 	  vxD[2] = sTV.d3.vtZ;
 	}
-	if((tNode = AlcKDTGetNN(tree, vxD, DBL_MAX, &dist, NULL)) != NULL)
+	if(fTree)
 	{
-	  if(wMinDist > dist)
-	  {
-	    wMinDist = dist;
-	  }
-	  else if(wMaxDist < dist)
-	  {
-	    wMaxDist = dist;
-	  }
-	  if(vType == WLZ_VERTEX_D2)
-	  {
-	    tV.d2 = *(tVx.d2 + tNode->idx);
-	    tN.d2 = *(tNr.d2 + tNode->idx);
-	    *(tVxBuf.d2 + idM) = tV.d2;
-	    *(wgtBuf + idM) = WLZ_VTX_2_DOT(sTN.d2, tN.d2);
-	  }
-	  else /* vType == WLZ_VERTEX_D3 */
-	  {
-	    tV.d3 = *(tVx.d3 + tNode->idx);
-	    tN.d3 = *(tNr.d3 + tNode->idx);
-	    *(tVxBuf.d3 + idM) = tV.d3;
-	    *(wgtBuf + idM) = WLZ_VTX_3_DOT(sTN.d3, tN.d3);
-	  }
-	  ++idM;
+	  /* The keys of the flat tree are the vertices themselves. */
+	  idT = AlcKDTFlatGetNN(fTree, (vType == WLZ_VERTEX_D2)?
+	  			(double *)&(sTV.d2): (double *)&(sTV.d3),
+				DBL_MAX, &dist);
+	}
+	else
+	{
+	  AlcKDTNode *tNode;
+
+	  tNode = AlcKDTGetNN(tree, vxD, DBL_MAX, &dist, NULL);
+	  idT = (tNode)? tNode->idx: -1;
+	}
+	/* With a non-empty tree and no distance limit a match is always
+	 * found. */
+	idT = WLZ_MAX(idT, 0);
+	if(vType == WLZ_VERTEX_D2)
+	{
+	  *(tVxBuf.d2 + idS) = *(tVx.d2 + idT);
+	  *(wgtBuf + idS) = WLZ_VTX_2_DOT(sTN.d2, *(tNr.d2 + idT));
+	}
+	else /* vType == WLZ_VERTEX_D3 */
+	{
+	  *(tVxBuf.d3 + idS) = *(tVx.d3 + idT);
+	  *(wgtBuf + idS) = WLZ_VTX_3_DOT(sTN.d3, *(tNr.d3 + idT));
 	}
+	*(dstBuf + idS) = dist;
       }
+      tm[1] = WlzRegICPTime();
       if(idM == 0)
       {
         errNum = WLZ_ERR_ALG_CONVERGENCE;
       }
       if(errNum == WLZ_ERR_NONE)
       {
-	/* Compute weightings. */
-	wgt0 = wMaxDist - wMinDist;
-	wgt1 = 1.0 - minDistWgt;
-	wgt2 = (wgt0 > DBL_EPSILON)? wgt1 / wgt0: 1.0;
-	for(idS = 0; idS < idM; ++idS)
+        /* Find maximum and minimum source - target vertex distances. */
+	wMinDist = wMaxDist = *dstBuf;
+	for(idS = 1; idS < idM; ++idS)
 	{
-	  if(vType == WLZ_VERTEX_D2)
+	  if(wMinDist > *(dstBuf + idS))
 	  {
-	    sTV.d2 = *(sTVxBuf.d2 + idS);
-	    tV.d2 = *(tVxBuf.d2 + idS);
-	    WLZ_VTX_2_SUB(dV.d2, tV.d2, sTV.d2);
-	    dist = WLZ_VTX_2_LENGTH(dV.d2);
+	    wMinDist = *(dstBuf + idS);
 	  }
-	  else /* vType == WLZ_VERTEX_D3 */
+	  if(wMaxDist < *(dstBuf + idS))
 	  {
-	    sTV.d3 = *(sTVxBuf.d3 + idS);
-	    tV.d3 = *(tVxBuf.d3 + idS);
-	    WLZ_VTX_3_SUB(dV.d3, tV.d3, sTV.d3);
-	    dist = WLZ_VTX_3_LENGTH(dV.d3);
+	    wMaxDist = *(dstBuf + idS);
 	  }
+	}
+	/* Compute weightings, in parallel. */
+	wgt0 = wMaxDist - wMinDist;
+	wgt1 = 1.0 - minDistWgt;
+	wgt2 = (wgt0 > DBL_EPSILON)? wgt1 / wgt0: 1.0;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for(idS = 0; idS < idM; ++idS)
+	{
+	  double wNr,
+	  	 wVx;
+	  WlzVertex sV,
+	  	 tV;
+
 	  if(wgt0 > DBL_EPSILON)
 	  {
-	    wVx = 1.0 - wgt2 * (dist - wMinDist);
+	    wVx = 1.0 - wgt2 * (*(dstBuf + idS) - wMinDist);
 	  }
 	  else
 	  {
@@ -1832,11 +2040,15 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  {
 	    if(vType == WLZ_VERTEX_D2)
 	    {
-	      sV.d2 = WlzAffineTransformVertexD2(invTr, sTV.d2, NULL);
+	      tV.d2 = *(tVxBuf.d2 + idS);
+	      sV.d2 = WlzAffineTransformVertexD2(invTr, *(sTVxBuf.d2 + idS),
+	      					 NULL);
 	    }
 	    else /* vType == WLZ_VERTEX_D3 */
 	    {
-	      sV.d3 = WlzAffineTransformVertexD3(invTr, sTV.d3, NULL);
+	      tV.d3 = *(tVxBuf.d3 + idS);
+	      sV.d3 = WlzAffineTransformVertexD3(invTr, *(sTVxBuf.d3 + idS),
+	      					 NULL);
 	    }
 	    *(wgtBuf + idS) = (*usrWgtFn)(vType, curTr, tree, tVx, sVx,
 	    				  tV, sV, wVx, wNr, usrWgtData);
@@ -1845,10 +2057,16 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  {
 	    *(wgtBuf + idS) = wVx * wNr;
 	  }
-	  curMetric += dist * *(wgtBuf + idS);
+	}
+	/* Sum the metric serially so that it does not depend on the
+	 * number of threads. */
+	for(idS = 0; idS < idM; ++idS)
+	{
+	  curMetric += *(dstBuf + idS) * *(wgtBuf + idS);
 	}
 	curMetric /= idM;
       }
+      tm[2] = WlzRegICPTime();
       if(errNum == WLZ_ERR_NONE)
       {
         /* Test for convergence. */
@@ -1860,6 +2078,16 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	    (void )WlzFreeAffineTransform(curTr);
 	    curTr = prvTr;
 	    prvTr = NULL;
+	    (void )WlzFreeAffineTransform(invTr);
+	    invTr = WlzAffineTransformInverse(curTr, &errNum);
+	  }
+	  if(lvl > 0)
+	  {
+	    /* Converged at a coarse level, so continue at the next
+	     * finer level. */
+	    --lvl;
+	    conv = 0;
+	    rst = 1;
 	  }
 	}
 	else
@@ -1898,6 +2126,8 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  (void )WlzFreeAffineTransform(newTr);
 	}
       }
+      tm[3] = WlzRegICPTime();
+      WlzRegICPStatsAdd(ctl, lvl + rst, idM, curMetric, tm);
     } while((errNum == WLZ_ERR_NONE) && (itr++ < maxItr) && (conv == 0));
   }
   if(itr >= maxItr)
@@ -1914,6 +2144,7 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
     errNum = WLZ_ERR_NONE;
     conv = 0;
   }
+  AlcFree(dstBuf);
   (void )WlzFreeAffineTransform(invTr);
   (void )WlzFreeAffineTransform(prvTr);
   *gPrvMetric = prvMetric;
@@ -44,6 +44,26 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzRsvFilterItv
+* \ingroup	WlzValueFilters
+* \brief	An interval of a 2D object with pointers to its source and
+* 		destination values, so that intervals may be filtered in
+* 		parallel.
+*/
+typedef struct _WlzRsvFilterItv
+{
+  int		ln;		/*!< Line of the interval. */
+  int		kl;		/*!< First column of the interval. */
+  int		len;		/*!< Length of the interval. */
+  WlzGreyP	sGP;		/*!< Source values of the interval. */
+  WlzGreyP	dGP;		/*!< Destination values of the interval. */
+} WlzRsvFilterItv;
+
 /* These tests are for debuging only. */
 /* #define WLZ_RSVFILTER_TEST_1D */
 /* #define WLZ_RSVFILTER_TEST_2D */
@@ -57,6 +77,16 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *, WlzRsvFilter *,
 			              int, WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
 				     WlzErrorNum *);
+static WlzErrorNum WlzRsvFilterObj2DYStrip(WlzObject *srcObj,
+				     WlzObject *dstObj,
+				     WlzRsvFilter *ftr,
+				     int col0,
+				     int col1);
+static WlzErrorNum WlzRsvFilterItvs(WlzObject *srcObj,
+				     WlzObject *dstObj,
+				     WlzRsvFilterItv **dstItv,
+				     int *dstMaxItv,
+				     int *dstNItv);
 static void	WlzRsvFilterFilterBufXF(WlzRsvFilter *,
 				      double *, double *, double *,
 				      int);
@@ -606,6 +636,7 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
 	  *fP2++ = c * (f0 + *fP0++);
 	}
+	dP0 += 8;
 	kol += 8;
 	cnt0 -= 8;
       }
@@ -790,6 +821,7 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
 	  *fP2++ = c * (f0 + *fP0++);
 	}
+	dP0 += 8;
 	kol += 8;
 	cnt0 -= 8;
       }
@@ -888,24 +920,16 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 				     WlzErrorNum *dstErr)
 {
   int		bufSz,
-		bufSpace,
-		itvLen;
-  WlzGreyType	bufType,
-  		srcGType,
+		nItv = 0,
+		maxItv = 0;
+  WlzGreyType	srcGType,
   		dstGType;
   WlzObjectType	vType;
-  WlzGreyP	bufGP;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		*lnBuf0 = NULL,
-  		*lnBuf1 = NULL,
-  		*datBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  WlzRsvFilterItv *itv = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -962,66 +986,65 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the working buffers. */
+  /* Find the intervals and then filter them in parallel, each thread
+   * having it's own working buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
     bufSz = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSpace = sizeof(double) * bufSz;
-    if(((datBuf = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf0 = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf1 = AlcMalloc(bufSpace)) ==  NULL))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    errNum = WlzRsvFilterItvs(srcObj, dstObj, &itv, &maxItv, &nItv);
   }
-  /* Work down through the object from the first line to last. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufType = WLZ_GREY_DOUBLE;
-    bufGP.dbp = (double *)datBuf;
-    if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp,
-    					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE) &&
-       ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp,
-       					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE))
+    int		idI;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      while((errNum == WLZ_ERR_NONE) &&
-            ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+      double	*datBuf;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if((datBuf = (double *)AlcMalloc(sizeof(double) * 3 * bufSz)) == NULL)
       {
-	/* Copy interval to working buffer. */
-	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
-			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-			       itvLen);
-	/* Apply filter. */
-	WlzRsvFilterFilterBufXF(ftr, (double *)datBuf,
-			        (double *)lnBuf0, (double *)lnBuf1,
-				itvLen);
-	/* Clamp data from buffer into the dst interval. */
-	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-			          bufGP, 0, bufType, itvLen);
+        errNum2 = WLZ_ERR_MEM_ALLOC;
       }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+      for(idI = 0; idI < nItv; ++idI)
+      {
+        if(errNum2 == WLZ_ERR_NONE)
+	{
+	  WlzGreyP bufGP;
+	  WlzRsvFilterItv *it;
+
+	  it = itv + idI;
+	  bufGP.dbp = datBuf;
+	  /* Copy interval to working buffer. */
+	  WlzValueCopyGreyToGrey(bufGP, 0, WLZ_GREY_DOUBLE,
+				 it->sGP, 0, srcGType, it->len);
+	  /* Apply filter. */
+	  WlzRsvFilterFilterBufXF(ftr, datBuf,
+				  datBuf + bufSz, datBuf + (2 * bufSz),
+				  it->len);
+	  /* Clamp data from buffer into the dst interval. */
+	  WlzValueClampGreyIntoGrey(it->dGP, 0, dstGType,
+				    bufGP, 0, WLZ_GREY_DOUBLE, it->len);
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DX)
+#endif
+      {
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(datBuf);
     }
-    if(errNum == WLZ_ERR_EOO)
-    {
-      errNum = WLZ_ERR_NONE;
-    }
-  }
-  /* Free buffers. */
-  if(datBuf)
-  {
-    AlcFree(datBuf);
-  }
-  if(lnBuf0)
-  {
-    AlcFree(lnBuf0);
-  }
-  if(lnBuf1)
-  {
-    AlcFree(lnBuf1);
   }
+  AlcFree(itv);
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
@@ -1054,33 +1077,13 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			             WlzErrorNum *dstErr)
 {
-  int		idD,
-  		idN,
-		bufLnIdx,
-		dstLnIdx,
-  		itvLen,
-		itvBufWidth;
-  WlzRasterDir	rasDir;
-  WlzGreyType	bufType,
-  		srcGType,
+  WlzGreyType	srcGType,
 		dstGType;
-  WlzIVertex2	bufPos,
-  		bufSz;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
   WlzObjectType	vType;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		**srcBuf = NULL,
-  		**wrkBuf = NULL;
-  WlzUByte	**itvBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -1137,16 +1140,116 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the buffers. */
+  /* Split the columns into strips, each of which is filtered by a single
+   * thread. The strips are a multiple of 8 columns wide so that the
+   * filtering of each column is not changed by the split. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSz.vtY = 3;
-    if(AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      int	nStrip = 1,
+      		idS = 0,
+		width,
+		stripW,
+		col0;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+      nStrip = omp_get_num_threads();
+      idS = omp_get_thread_num();
+#endif
+      width = srcDom.i->lastkl - srcDom.i->kol1 + 1;
+      stripW = (((width + nStrip - 1) / nStrip) + 7) & ~7;
+      stripW = WLZ_MAX(stripW, 64);
+      col0 = idS * stripW;
+      if(col0 < width)
+      {
+	errNum2 = WlzRsvFilterObj2DYStrip(srcObj, dstObj, ftr, col0,
+					  WLZ_MIN(col0 + stripW, width) - 1);
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DY)
+#endif
+      {
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
     }
   }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(dstObj)
+    {
+      (void )WlzFreeObj(dstObj);
+    }
+    dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter through the columns of the
+*               given 2D domain object, but only for the given strip
+*               of columns. The values within the strip are set in the
+*               given destination object which must share the domain
+*               of the source object.
+* \param	srcObj			Given 2D domain object.
+* \param	dstObj			Destination object.
+* \param	ftr			Recursive filter.
+* \param	col0			First column of the strip relative to
+* 					the first column of the domain, must
+* 					be a multiple of 8.
+* \param	col1			Last column of the strip relative to
+* 					the first column of the domain.
+*/
+static WlzErrorNum WlzRsvFilterObj2DYStrip(WlzObject *srcObj,
+				     WlzObject *dstObj,
+				     WlzRsvFilter *ftr,
+				     int col0,
+				     int col1)
+{
+  int		idD,
+  		idN,
+		bufLnIdx,
+		dstLnIdx,
+  		itvLen,
+		itvOff,
+		itvBufWidth;
+  WlzRasterDir	rasDir;
+  WlzGreyType	bufType;
+  WlzIVertex2	bufPos,
+  		bufSz;
+  WlzGreyP	dstBufGP,
+  		srcBufGP,
+  		wrkBufGP;
+  WlzDomain	srcDom;
+  void		**srcBuf = NULL,
+  		**wrkBuf = NULL;
+  WlzUByte	**itvBuf = NULL;
+  WlzIntervalWSpace srcIWSp,
+  		dstIWSp;
+  WlzGreyWSpace srcGWSp,
+  		dstGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Make the buffers. */
+  srcDom = srcObj->domain;
+  bufSz.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
+  bufSz.vtY = 3;
+  if(AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     bufType = WLZ_GREY_DOUBLE;
@@ -1184,6 +1287,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 	{
 	  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
 	  bufPos.vtX = srcIWSp.lftpos - srcDom.i->kol1;
+	  itvOff = 0;
 	  /* Process any lines between this and the last. */
 	  if(srcIWSp.nwlpos > 0)
 	  {
@@ -1196,34 +1300,50 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 	    }
 	    dstLnIdx = (bufPos.vtY + 3 + ((idD)? 2: - 2)) % 3;
 	  }
-	  /* Copy interval to buffer. */
-	  srcBufGP.dbp = *((double **)srcBuf + bufLnIdx);
-	  wrkBufGP.dbp = *((double **)wrkBuf + bufLnIdx);
-	  dstBufGP.dbp = *((double **)wrkBuf + dstLnIdx);
-	  WlzBitLnSetItv(*(itvBuf + bufLnIdx),
-	  		 bufPos.vtX, bufPos.vtX + itvLen - 1, bufSz.vtX);
-	  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-				 srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-				 itvLen);
-	  if(rasDir == WLZ_RASTERDIR_DLIC)
+	  /* Clip the interval to the strip of columns. */
+	  if(bufPos.vtX < col0)
 	  {
-	    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-	    			   dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				   itvLen);
+	    itvOff = col0 - bufPos.vtX;
+	    bufPos.vtX = col0;
+	    itvLen -= itvOff;
 	  }
-	  /* Apply filter to this interval. */
-	  WlzRsvFilterFilterBufYF(ftr, (double **)wrkBuf, (double **)srcBuf,
-				itvBuf, bufPos, itvLen, idD);
-	  /* Clamp data buffer into the dst interval. */
-	  if(rasDir == WLZ_RASTERDIR_ILIC)
+	  if(bufPos.vtX + itvLen - 1 > col1)
 	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      wrkBufGP, bufPos.vtX, bufType, itvLen);
+	    itvLen = col1 - bufPos.vtX + 1;
 	  }
-	  else
+	  if(itvLen > 0)
 	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      dstBufGP, bufPos.vtX, bufType, itvLen);
+	    /* Copy interval to buffer. */
+	    srcBufGP.dbp = *((double **)srcBuf + bufLnIdx);
+	    wrkBufGP.dbp = *((double **)wrkBuf + bufLnIdx);
+	    dstBufGP.dbp = *((double **)wrkBuf + dstLnIdx);
+	    WlzBitLnSetItv(*(itvBuf + bufLnIdx),
+			   bufPos.vtX, bufPos.vtX + itvLen - 1, bufSz.vtX);
+	    WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
+				   srcGWSp.u_grintptr, itvOff, srcGWSp.pixeltype,
+				   itvLen);
+	    if(rasDir == WLZ_RASTERDIR_DLIC)
+	    {
+	      WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
+				     dstGWSp.u_grintptr, itvOff,
+				     dstGWSp.pixeltype, itvLen);
+	    }
+	    /* Apply filter to this interval. */
+	    WlzRsvFilterFilterBufYF(ftr, (double **)wrkBuf, (double **)srcBuf,
+				  itvBuf, bufPos, itvLen, idD);
+	    /* Clamp data buffer into the dst interval. */
+	    if(rasDir == WLZ_RASTERDIR_ILIC)
+	    {
+	      WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, itvOff,
+					dstGWSp.pixeltype,
+					wrkBufGP, bufPos.vtX, bufType, itvLen);
+	    }
+	    else
+	    {
+	      WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, itvOff,
+					dstGWSp.pixeltype,
+					dstBufGP, bufPos.vtX, bufType, itvLen);
+	    }
 	  }
 	}
       }
@@ -1246,19 +1366,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
   {
     Alc2Free(wrkBuf);
   }
-  if(errNum != WLZ_ERR_NONE)
-  {
-    if(dstObj)
-    {
-      (void )WlzFreeObj(dstObj);
-    }
-    dstObj = NULL;
-  }
-  if(dstErr)
-  {
-    *dstErr = errNum;
-  }
-  return(dstObj);
+  return(errNum);
 }
 
 /*!
@@ -1271,6 +1379,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               point arithmetic.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
+*               The planes are filtered in parallel.
 * \param	srcObj			Given object.
 * \param	ftr			Recursive filter.
 * \param	actionMsk		Action mask.
@@ -1280,15 +1389,14 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			              int actionMsk, WlzErrorNum *dstErr)
 {
-  int		nPlanes;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
+  int		idP,
+  		nPlanes;
   WlzDomain 	*srcDom2D;
   WlzValues	*srcVal2D,
-  		*dstVal2D;
+  		*dstVal2D = NULL;
   WlzDomain	srcDom;
   WlzValues	dstVal;
+  WlzObject	*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
@@ -1305,40 +1413,49 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstVal2D = dstVal.vox->values;
     dstObj = WlzMakeMain(srcObj->type, srcDom, dstVal, NULL, NULL, &errNum);
   }
-  while((errNum == WLZ_ERR_NONE) &&
-        (nPlanes-- > 0))
+  /* The planes are independent so filter them in parallel. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    srcObj2D = NULL;
-    dstObj2D = NULL;
-    if(srcDom2D->core)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(idP = 0; idP < nPlanes; ++idP)
     {
-      dstObj2D = NULL;
-      srcObj2D = WlzAssignObject(
-      		 WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D++, *srcVal2D++,
-			     NULL, NULL, &errNum), NULL);
-      if(errNum == WLZ_ERR_NONE)
-      {
-	dstObj2D = WlzAssignObject(
-		   WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	*dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
-      }
-      if(srcObj2D)
+      WlzObject	*srcObj2D = NULL,
+      		*dstObj2D = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      dstVal2D[idP].core = NULL;
+      if(srcDom2D[idP].core)
       {
-        WlzFreeObj(srcObj2D);
+	srcObj2D = WlzAssignObject(
+		   WlzMakeMain(WLZ_2D_DOMAINOBJ, srcDom2D[idP], srcVal2D[idP],
+			       NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstObj2D = WlzAssignObject(
+		     WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum2), NULL);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstVal2D[idP] = WlzAssignValues(dstObj2D->values, NULL);
+	}
+	(void )WlzFreeObj(srcObj2D);
+	(void )WlzFreeObj(dstObj2D);
       }
-      if(dstObj2D)
+      if(errNum2 != WLZ_ERR_NONE)
       {
-        WlzFreeObj(dstObj2D);
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DXY)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
       }
     }
-    else
-    {
-      dstVal2D->core = NULL;
-    }
-    ++dstVal2D;
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1350,6 +1467,7 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
     {
       WlzFreeVoxelValueTb(dstVal.vox);
     }
+    dstObj = NULL;
   }
   if(dstErr)
   {
@@ -1379,10 +1497,11 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   		idD,
 		idN,
   		idP,
-		itvLen,
 		dstPnIdx,
 		bufPlIdx,
   		nPlanes,
+		nItv = 0,
+		maxItv = 0,
 		itvBufArea;
   WlzIVertex3	bufPos,
   		bufSz;
@@ -1395,9 +1514,6 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 		bufType,
   		srcGType = WLZ_GREY_ERROR,
   		dstGType = WLZ_GREY_ERROR;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
   void		***srcBuf = NULL,
   		***wrkBuf = NULL;
   void		**srcBuf2D,
@@ -1412,10 +1528,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   		*dstObj2D,
 		*dstObj = NULL;
   WlzPixelV	bgdPix;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  WlzRsvFilterItv *itv = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
@@ -1587,62 +1700,59 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	      /* Make a 2D object from destination plane. */
 	      dstObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *dstVal2D,
 				     NULL, NULL, &errNum);
-	      /* Process each interval of this plane. */
-	      if(((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
-	      				    &srcGWSp)) == WLZ_ERR_NONE) &&
-	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
-	      				    &dstGWSp)) == WLZ_ERR_NONE))
+	      /* Find the intervals of this plane and set them in the
+	       * plane's interval bit mask. Then filter the intervals in
+	       * parallel, which is possible as the filter only reads the
+	       * bit masks of the previous planes. */
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+	        errNum = WlzRsvFilterItvs(srcObj2D, dstObj2D,
+					  &itv, &maxItv, &nItv);
+	      }
+	      if(errNum == WLZ_ERR_NONE)
 	      {
-		while((errNum == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&srcIWSp)) == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&dstIWSp)) == WLZ_ERR_NONE))
+		int	idI;
+
+		for(idI = 0; idI < nItv; ++idI)
+		{
+		  tI0 = itv[idI].kl - srcDom.p->kol1;
+		  WlzBitLnSetItv(*(itvBuf2D + itv[idI].ln - srcDom.p->line1),
+				 tI0, tI0 + itv[idI].len - 1, bufSz.vtX);
+		}
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+		for(idI = 0; idI < nItv; ++idI)
 		{
-		  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-		  bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
-		  bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
+		  WlzIVertex3 itvPos;
+		  WlzGreyP dstBufGP,
+			   srcBufGP,
+			   wrkBufGP;
+		  WlzRsvFilterItv *it;
+
+		  it = itv + idI;
+		  itvPos.vtX = it->kl - srcDom.p->kol1;
+		  itvPos.vtY = it->ln - srcDom.p->line1;
+		  itvPos.vtZ = bufPos.vtZ;
 		  /* Copy interval to buffer. */
-		  srcBufGP.dbp = *((double **)srcBuf2D + bufPos.vtY);
-		  wrkBufGP.dbp = *((double **)wrkBuf2D + bufPos.vtY);
-		  dstBufGP.dbp = *((double **)dstBuf2D + bufPos.vtY);
-		  WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
-		  		 bufPos.vtX, bufPos.vtX + itvLen - 1,
-				 bufSz.vtX);
-		  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-		  			 srcGWSp.u_grintptr, 0,
-					 srcGWSp.pixeltype,
-					 itvLen);
+		  srcBufGP.dbp = *((double **)srcBuf2D + itvPos.vtY);
+		  wrkBufGP.dbp = *((double **)wrkBuf2D + itvPos.vtY);
+		  dstBufGP.dbp = *((double **)dstBuf2D + itvPos.vtY);
+		  WlzValueCopyGreyToGrey(srcBufGP, itvPos.vtX, bufType,
+					 it->sGP, 0, srcGType, it->len);
 		  if(idD)
 		  {
-		    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-					   dstGWSp.u_grintptr, 0,
-					   dstGWSp.pixeltype,
-					   itvLen);
+		    WlzValueCopyGreyToGrey(wrkBufGP, itvPos.vtX, bufType,
+					   it->dGP, 0, dstGType, it->len);
 		  }
 		  /* Apply filter to this interval. */
 		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
 					  (double ***)srcBuf, itvBuf,
-					  bufPos, itvLen, idD);
+					  itvPos, it->len, idD);
 		  /* Clamp data buffer back into the destination plane. */
-		  if(idD == 0)
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      wrkBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		  else
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      dstBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		}
-		if(errNum == WLZ_ERR_EOO)
-		{
-		  errNum = WLZ_ERR_NONE;
+		  WlzValueClampGreyIntoGrey(it->dGP, 0, dstGType,
+					    (idD)? dstBufGP: wrkBufGP,
+					    itvPos.vtX, bufType, it->len);
 		}
 	      }
 	      if(srcObj2D)
@@ -1662,6 +1772,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
       }
     }
   }
+  AlcFree(itv);
   if(itvBuf)
   {
     Alc3Free((void ***)itvBuf);
@@ -1693,6 +1804,78 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   return(dstObj);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValueFilters
+* \brief	Makes an array of the intervals of the given 2D source
+*               object with pointers to the values of each interval in
+*               both the source and destination objects, which must
+*               share the same domain.
+* \param	srcObj			Given 2D source object.
+* \param	dstObj			Given 2D destination object.
+* \param	dstItv			Destination pointer for the array
+*                                       of intervals, which may be
+*                                       reallocated.
+* \param	dstMaxItv		Destination pointer for the number of
+*                                       intervals allocated.
+* \param	dstNItv			Destination pointer for the number of
+*                                       intervals.
+*/
+static WlzErrorNum WlzRsvFilterItvs(WlzObject *srcObj,
+				     WlzObject *dstObj,
+				     WlzRsvFilterItv **dstItv,
+				     int *dstMaxItv,
+				     int *dstNItv)
+{
+  int		nItv = 0;
+  WlzIntervalWSpace srcIWSp,
+  		dstIWSp;
+  WlzGreyWSpace srcGWSp,
+  		dstGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(((errNum = WlzInitGreyScan(srcObj, &srcIWSp,
+				&srcGWSp)) == WLZ_ERR_NONE) &&
+     ((errNum = WlzInitGreyScan(dstObj, &dstIWSp,
+				&dstGWSp)) == WLZ_ERR_NONE))
+  {
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+    {
+      WlzRsvFilterItv *itv;
+
+      if(nItv >= *dstMaxItv)
+      {
+	int	maxItv;
+
+	maxItv = (2 * *dstMaxItv) + 1024;
+	if((itv = (WlzRsvFilterItv *)
+		  AlcRealloc(*dstItv,
+			     sizeof(WlzRsvFilterItv) * maxItv)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	*dstItv = itv;
+	*dstMaxItv = maxItv;
+      }
+      itv = *dstItv + nItv++;
+      itv->ln = srcIWSp.linpos;
+      itv->kl = srcIWSp.lftpos;
+      itv->len = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
+      itv->sGP = srcGWSp.u_grintptr;
+      itv->dGP = dstGWSp.u_grintptr;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  *dstNItv = nItv;
+  return(errNum);
+}
+
 #ifdef WLZ_RSVFILTER_TEST_1D
 int		main(int argc, char *argv[])
 {
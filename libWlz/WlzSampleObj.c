@@ -1247,7 +1247,7 @@ static WlzObject *WlzSampleObjConvI(WlzObject *srcObj, int **kernel,
 		  }
 		  bufIwspFlag = WlzNextGreyInterval(&bufIWsp);
 		}
-		if((tI1 = srcDom.i->lastkl - bufPos.vtX) > 0)
+		if((tI1 = srcDom.i->lastkl - bufPos.vtX + 1) > 0)
 		{
 		  tIP0 = *(bufData + idB) + bufPos.vtX - srcDom.i->kol1;
 		  WlzValueSetInt(tIP0, backgroundVal, tI1);
@@ -1256,8 +1256,8 @@ static WlzObject *WlzSampleObjConvI(WlzObject *srcObj, int **kernel,
 	    }
 	    ++(bufPos.vtY);
 	  }
-	  bufPos.vtX = dstInvLeftPos *
-		       samFac.vtX;   /* Sample and convolve through interval */
+	  bufPos.vtX = (dstInvLeftPos * samFac.vtX) -
+		       (kernelSz.vtX / 2); /* Sample and convolve through itv */
 	  bufPos.vtY = srcIWsp.linpos - (kernelSz.vtY / 2);
 	  switch(greyType)
 	  {
@@ -1620,7 +1620,7 @@ static WlzObject *WlzSampleObjConvD(WlzObject *srcObj, double **kernel,
 		  }
 		  bufIwspFlag = WlzNextGreyInterval(&bufIWsp);
 		}
-		if((tI1 = srcDom.i->lastkl - bufPos.vtX) > 0)
+		if((tI1 = srcDom.i->lastkl - bufPos.vtX + 1) > 0)
 		{
 		  tDP0 = *(bufData + idB) + bufPos.vtX - srcDom.i->kol1;
 		  WlzValueSetDouble(tDP0, backgroundVal, tI1);
@@ -1629,8 +1629,8 @@ static WlzObject *WlzSampleObjConvD(WlzObject *srcObj, double **kernel,
 	    }
 	    ++(bufPos.vtY);
 	  }
-	  bufPos.vtX = dstInvLeftPos *
-		       samFac.vtX;   /* Sample and convolve through interval */
+	  bufPos.vtX = (dstInvLeftPos * samFac.vtX) -
+		       (kernelSz.vtX / 2); /* Sample and convolve through itv */
 	  bufPos.vtY = srcIWsp.linpos - (kernelSz.vtY / 2);
 	  switch(greyType)
 	  {
@@ -1991,7 +1991,7 @@ static WlzObject *WlzSampleObjRankI(WlzObject *srcObj, WlzIVertex2 samFac,
 		  }
 		  bufIwspFlag = WlzNextGreyInterval(&bufIWsp);
 		}
-		if((tI1 = srcDom.i->lastkl - bufPos.vtX) > 0)
+		if((tI1 = srcDom.i->lastkl - bufPos.vtX + 1) > 0)
 		{
 		  tIP0 = *(bufData + idB) + bufPos.vtX - srcDom.i->kol1;
 		  WlzValueSetInt(tIP0, backgroundVal, tI1);
@@ -2001,7 +2001,7 @@ static WlzObject *WlzSampleObjRankI(WlzObject *srcObj, WlzIVertex2 samFac,
 	    ++(bufPos.vtY);
 	  }
 	  /* Sample by rank through the interval */
-	  bufPos.vtX = dstInvLeftPos * samFac.vtX;
+	  bufPos.vtX = (dstInvLeftPos * samFac.vtX) - (kernelSz.vtX / 2);
 	  bufPos.vtY = srcIWsp.linpos - (kernelSz.vtY / 2);
 	  switch(greyType)
 	  {
@@ -2440,7 +2440,7 @@ static WlzObject *WlzSampleObjRankD(WlzObject *srcObj, WlzIVertex2 samFac,
 		  }
 		  bufIwspFlag = WlzNextGreyInterval(&bufIWsp);
 		}
-		if((tI1 = srcDom.i->lastkl - bufPos.vtX) > 0)
+		if((tI1 = srcDom.i->lastkl - bufPos.vtX + 1) > 0)
 		{
 		  tDP0 = *(bufData + idB) + bufPos.vtX - srcDom.i->kol1;
 		  WlzValueSetDouble(tDP0, backgroundVal, tI1);
@@ -2450,7 +2450,7 @@ static WlzObject *WlzSampleObjRankD(WlzObject *srcObj, WlzIVertex2 samFac,
 	    ++(bufPos.vtY);
 	  }
 	  /* Sample by rank through the interval */
-	  bufPos.vtX = dstInvLeftPos * samFac.vtX;
+	  bufPos.vtX = (dstInvLeftPos * samFac.vtX) - (kernelSz.vtX / 2);
 	  bufPos.vtY = srcIWsp.linpos - (kernelSz.vtY / 2);
 	  switch(greyType)
 	  {
@@ -45,6 +45,20 @@ static char _WlzScalarArithmeticOp_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzScalarMulAddScanData
+* \ingroup	WlzArithmetic
+* \brief	Data passed to the parallel scan callback used by
+* 		WlzScalarMulAdd().
+*/
+typedef struct _WlzScalarMulAddScanData
+{
+  WlzObject	*rObj;			/*!< Return object with values of
+  					     the required grey type. */
+  double	m;			/*!< Value to multiply by. */
+  double	a;			/*!< Value to add to product. */
+} WlzScalarMulAddScanData;
+
 static WlzObject 		*WlzScalarMulAdd2D(
 				  WlzObject *iObj,
 				  WlzPixelV m,
@@ -57,29 +71,32 @@ static WlzObject 		*WlzScalarMulAdd3D(
 				  WlzPixelV a,
 				  WlzGreyType rGType,
 				  WlzErrorNum *dstErr);
-static WlzErrorNum 		WlzScalarMulAddSet2D(
+static WlzErrorNum 		WlzScalarMulAddSet(
 				  WlzObject *rObj,
 				  WlzObject *iObj,
-				  double m,
-				  double a);
-static WlzErrorNum 		WlzGreyIncValuesInDomain2D(
-				  WlzObject *gObj,
-				  WlzObject *dObj);
-static WlzErrorNum 		WlzGreyIncValuesInDomain3D(
-				  WlzObject *gObj,
-				  WlzObject *dObj);
+				  WlzPixelV m,
+				  WlzPixelV a,
+				  WlzGreyType rGType);
+static WlzErrorNum 		WlzScalarMulAddScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+static WlzErrorNum 		WlzGreyIncValuesScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
 
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzArithmetic
 * \brief	Increments all valus of the firstobjct which are within
 * 		the domain of the second object. The domain of the first
-* 		object must cover that of the second.
+* 		object must cover that of the second. The values are
+* 		incremented in parallel using WlzScanPar().
 * \param	gObj		First object.
 * \param	dObj		Second object.
 */
 WlzErrorNum	WlzGreyIncValuesInDomain(WlzObject *gObj, WlzObject *dObj)
 {
+  WlzObject	*tObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((gObj == NULL) || (dObj == NULL))
@@ -107,120 +124,56 @@ WlzErrorNum	WlzGreyIncValuesInDomain(WlzObject *gObj, WlzObject *dObj)
     switch(gObj->type)
     {
       case WLZ_2D_DOMAINOBJ:
-	errNum = WlzGreyIncValuesInDomain2D(gObj, dObj);
         break;
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzGreyIncValuesInDomain3D(gObj, dObj);
+	if((dObj->domain.p->plane1 < gObj->domain.p->plane1) ||
+	   (dObj->domain.p->lastpl > gObj->domain.p->lastpl))
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
         break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
         break;
     }
   }
-  return(errNum);
-}
-
-/*!
-* \return	Woolz error code.
-* \ingroup	WlzArithmetic
-* \brief	Increments all valus of the firstobjct which are within
-* 		the domain of the second object. The domain of the first
-* 		object must cover that of the second.
-*		Because this is a static object it is assumed that the
-*		two 3D objects are known to be valid.
-* \param	gObj		First object.
-* \param	dObj		Second object.
-*/
-static WlzErrorNum WlzGreyIncValuesInDomain3D(WlzObject *gObj, WlzObject *dObj)
-{
-  WlzPlaneDomain *gPD,
-  		 *dPD;
-  WlzVoxelValues *gVV;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
-
-  gPD = gObj->domain.p;
-  gVV = gObj->values.vox;
-  dPD = dObj->domain.p;
-  if((dPD->plane1 < gPD->plane1) || (dPD->lastpl > gPD->lastpl))
+  if(errNum == WLZ_ERR_NONE)
   {
-    errNum = WLZ_ERR_DOMAIN_DATA;
+    /* Scan the domain of the second object using the values of the
+     * first. */
+    tObj = WlzAssignObject(
+	   WlzMakeMain(gObj->type, dObj->domain, gObj->values, NULL, NULL,
+		       &errNum), NULL);
   }
-  else
+  if(errNum == WLZ_ERR_NONE)
   {
-    int		p,
-		p0,
-		p1;
-
-    p0 = ALG_MAX(dPD->plane1, gPD->plane1);
-    p1 = ALG_MIN(dPD->lastpl, gPD->lastpl);
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(p = p0; p <= p1; ++p)
-    {
-      if(errNum == WLZ_ERR_NONE)
-      {
-	WlzDomain    *doms;
-	WlzValues    *vals;
-	WlzErrorNum  errNum2 = WLZ_ERR_NONE;
-
-	doms = dPD->domains + p - dPD->plane1;
-	vals = gVV->values + p - gPD->plane1;;
-	if(((*doms).core != NULL) && ((*vals).core != NULL))
-	{
-	  WlzObject    *obj2D = NULL;
-
-	  if((obj2D = WlzAssignObject(
-		      WlzMakeMain(WLZ_2D_DOMAINOBJ, *doms, *vals, NULL, NULL,
-		                  &errNum2), NULL)) != NULL)
-	  {
-	    errNum2 = WlzGreyIncValues2D(obj2D);
-	    (void )WlzFreeObj(obj2D);
-	  }
-	  if(errNum2 != WLZ_ERR_NONE)
-	  {
-#ifdef _OPENMP
-#pragma omp critical (WlzGreyIncValuesInDomain3D)
-	    {
-	      if(errNum == WLZ_ERR_NONE)
-	      {
-		errNum = errNum2;
-	      }
-	    }
-#else
-	    errNum = errNum2;
-#endif
-	  }
-	}
-      }
-    }
+    errNum = WlzScanPar(tObj, NULL, 0, 1, WlzGreyIncValuesScanFn, NULL);
   }
+  (void )WlzFreeObj(tObj);
   return(errNum);
 }
 
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzArithmetic
-* \brief	Increments all values of the firstobject which are within
-* 		the domain of the second object. The domain of the first
-* 		object must cover that of the second.
-*		Because this is a static object it is assumed that the
-*		two 2D objects are known to be valid.
-* \param	gObj		First object.
-* \param	dObj		Second object.
+* \brief	Increments all values within the given object.
+* \param	obj		Given object.
 */
-static WlzErrorNum WlzGreyIncValuesInDomain2D(WlzObject *gObj, WlzObject *dObj)
+WlzErrorNum 	WlzGreyIncValues2D(WlzObject *obj)
 {
-  WlzObject	*tObj;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
 
-  tObj = WlzAssignObject(
-         WlzMakeMain(WLZ_2D_DOMAINOBJ, dObj->domain, gObj->values, NULL, NULL,
-	             &errNum), NULL);
-  if(errNum == WLZ_ERR_NONE)
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->type != WLZ_2D_DOMAINOBJ)
   {
-    errNum = WlzGreyIncValues2D(tObj);
-    (void )WlzFreeObj(tObj);
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else
+  {
+    errNum = WlzScanPar(obj, NULL, 0, 1, WlzGreyIncValuesScanFn, NULL);
   }
   return(errNum);
 }
@@ -228,67 +181,62 @@ static WlzErrorNum WlzGreyIncValuesInDomain2D(WlzObject *gObj, WlzObject *dObj)
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzArithmetic
-* \brief	Increments all values within the given object.
-* \param	obj		Given object.
+* \brief	Parallel scan callback which increments all values of the
+* 		current piece of the object.
+* \param	pWSp		Parallel scan workspace.
+* \param	data		Unused callback data.
 */
-WlzErrorNum 	WlzGreyIncValues2D(WlzObject *obj)
+static WlzErrorNum WlzGreyIncValuesScanFn(WlzScanParWSpace *pWSp, void *data)
 {
-  WlzGreyWSpace gWSp;
-  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace *gWSp;
+  WlzIntervalWSpace *iWSp;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
-  errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
-  if(errNum == WLZ_ERR_NONE)
+  iWSp = &(pWSp->iWSp);
+  gWSp = &(pWSp->gWSp);
+  while((errNum == WLZ_ERR_NONE) &&
+	((errNum = WlzNextGreyInterval(iWSp)) == WLZ_ERR_NONE))
   {
-    while((errNum == WLZ_ERR_NONE) &&
-	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    int	     i,
+	     len;
+    WlzGreyP gP;
+    
+    gP = gWSp->u_grintptr;
+    len = iWSp->rgtpos - iWSp->lftpos + 1;
+    switch(gWSp->pixeltype)
     {
-      int	     i,
-	       len;
-      WlzGreyP gP;
-      
-      gP = gWSp.u_grintptr;
-      len = iWSp.rgtpos - iWSp.lftpos + 1;
-      switch(gWSp.pixeltype)
-      {
-	case WLZ_GREY_INT:
-	  for(i = 0; i < len; ++i)
-	  {
-	    *(gP.inp)++ += 1;
-	  }
-	  break;
-	case WLZ_GREY_SHORT:
-	  for(i = 0; i < len; ++i)
-	  {
-	    *(gP.shp)++ += 1;
-	  }
-	  break;
-	case WLZ_GREY_UBYTE:
-	  for(i = 0; i < len; ++i)
-	  {
-	    *(gP.ubp)++ += 1;
-	  }
-	  break;
-	case WLZ_GREY_FLOAT:
-	  for(i = 0; i < len; ++i)
-	  {
-	    *(gP.flp)++ += 1.0f;
-	  }
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  for(i = 0; i < len; ++i)
-	  {
-	    *(gP.dbp)++ += 1.0;
-	  }
-	  break;
-	default:
-	  break;
-      }
-    }
-    (void )WlzEndGreyScan(&iWSp, &gWSp);
-    if(errNum == WLZ_ERR_EOO)
-    {
-      errNum = WLZ_ERR_NONE;
+      case WLZ_GREY_INT:
+	for(i = 0; i < len; ++i)
+	{
+	  *(gP.inp)++ += 1;
+	}
+	break;
+      case WLZ_GREY_SHORT:
+	for(i = 0; i < len; ++i)
+	{
+	  *(gP.shp)++ += 1;
+	}
+	break;
+      case WLZ_GREY_UBYTE:
+	for(i = 0; i < len; ++i)
+	{
+	  *(gP.ubp)++ += 1;
+	}
+	break;
+      case WLZ_GREY_FLOAT:
+	for(i = 0; i < len; ++i)
+	{
+	  *(gP.flp)++ += 1.0f;
+	}
+	break;
+      case WLZ_GREY_DOUBLE:
+	for(i = 0; i < len; ++i)
+	{
+	  *(gP.dbp)++ += 1.0;
+	}
+	break;
+      default:
+	break;
     }
   }
   return(errNum);
@@ -712,22 +660,7 @@ static WlzObject *WlzScalarMulAdd2D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    switch(rGType)
-    {
-      case WLZ_GREY_INT:   /* FALLTHROUGH */
-      case WLZ_GREY_SHORT: /* FALLTHROUGH */
-      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
-      case WLZ_GREY_RGBA:  /* FALLTHROUGH */
-      case WLZ_GREY_FLOAT: /* FALLTHROUGH */
-      case WLZ_GREY_DOUBLE:
-	WlzValueConvertPixel(&m, m, WLZ_GREY_DOUBLE);
-	WlzValueConvertPixel(&a, a, WLZ_GREY_DOUBLE);
-	errNum = WlzScalarMulAddSet2D(rObj, iObj, m.v.dbv, a.v.dbv);
-	break;
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
-    }
+    errNum = WlzScalarMulAddSet(rObj, iObj, m, a, rGType);
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -781,75 +714,12 @@ static WlzObject *WlzScalarMulAdd3D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    int		idP,
-    		plMin,
-    		plMax;
-    WlzPlaneDomain *iPDom;
-    WlzVoxelValues *iVox,
-    		*rVox;
-
-    iPDom = iObj->domain.p;
-    iVox = iObj->values.vox;
-    rVox = rValues.vox;
-    plMin = iPDom->plane1;
-    plMax = iPDom->lastpl;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(idP = plMin; idP <= plMax; ++idP)
-    {
-      WlzErrorNum errNum2 = WLZ_ERR_NONE;
-
-      if(errNum == WLZ_ERR_NONE)
-      {
-	int	      idO;
-	WlzDomain *iDom2D;
-	WlzValues *iVal2D,
-		  *rVal2D;
-
-	idO = idP - iPDom->plane1;
-	iDom2D = iPDom->domains + idO;
-	iVal2D = iVox->values + idO;
-	rVal2D = rVox->values + idO;
-	if(((*iDom2D).core != NULL) && ((*iVal2D).core != NULL) &&
-	   ((*rVal2D).core != NULL))
-	{
-	  WlzObject *iObj2D = NULL,
-		    *rObj2D = NULL;
-	  
-	  if((iObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *iDom2D, *iVal2D,
-				   NULL, NULL, &errNum2)) != NULL)
-	  {
-	    rObj2D = WlzScalarMulAdd2D(iObj2D, m, a, rGType, &errNum2);
-	  }
-	  if(errNum2 == WLZ_ERR_NONE)
-	  {
-	    *rVal2D = WlzAssignValues(rObj2D->values, NULL);
-	  }
-	  (void )WlzFreeObj(iObj2D);
-	  (void )WlzFreeObj(rObj2D);
-	}
-      }
-      if(errNum2 != WLZ_ERR_NONE)
-      {
-#ifdef _OPENMP
-#pragma omp critical (WlzScalarMulAdd3D)
-	{
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    errNum = errNum2;
-	  }
-	}
-#else
-	errNum = errNum2;
-#endif
-      }
-    }
+    rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, iObj->domain, rValues,
+    		       iObj->plist, iObj->assoc, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, iObj->domain, rValues,
-    		       iObj->plist, iObj->assoc, &errNum);
+    errNum = WlzScalarMulAddSet(rObj, iObj, m, a, rGType);
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -875,146 +745,182 @@ static WlzObject *WlzScalarMulAdd3D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
 * \ingroup	WlzArithmetic
 * \brief	Sets the values of the return object from the input object
 * 		using simple linear scaling, see WlzScalarMulAdd(). The
-* 		objects are known to be 2D, have the same domain.
-* \param	rObj
-* \param	iObj
-* \param	m
-* \param	a
+* 		objects are known to be both 2D or both 3D and have the
+* 		same domain. The input object is scanned in parallel
+* 		using WlzScanPar() with the return object's values
+* 		scanned in step with it.
+* \param	rObj			Return object.
+* \param	iObj			Input object.
+* \param	m			Value to multiply object values by.
+* \param	a			Value to add to product.
+* \param	rGType			Grey type of the return object.
 */
-static WlzErrorNum WlzScalarMulAddSet2D(WlzObject *rObj, WlzObject *iObj,
-				     double m, double a)
+static WlzErrorNum WlzScalarMulAddSet(WlzObject *rObj, WlzObject *iObj,
+				      WlzPixelV m, WlzPixelV a,
+				      WlzGreyType rGType)
+{
+  WlzScalarMulAddScanData scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(rGType)
+  {
+    case WLZ_GREY_INT:   /* FALLTHROUGH */
+    case WLZ_GREY_SHORT: /* FALLTHROUGH */
+    case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+    case WLZ_GREY_RGBA:  /* FALLTHROUGH */
+    case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+    case WLZ_GREY_DOUBLE:
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueConvertPixel(&m, m, WLZ_GREY_DOUBLE);
+    WlzValueConvertPixel(&a, a, WLZ_GREY_DOUBLE);
+    scan.rObj = rObj;
+    scan.m = m.v.dbv;
+    scan.a = a.v.dbv;
+    errNum = WlzScanPar(iObj, NULL, 0, 1, WlzScalarMulAddScanFn, &scan);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Parallel scan callback for WlzScalarMulAddSet() which sets
+* 		the values of the return object for the current piece of
+* 		the input object.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzScalarMulAddScanFn(WlzScanParWSpace *pWSp, void *data)
 {
   int		bufLen;
-  WlzGreyWSpace iGWSp,
+  double	m,
+  		a;
+  double	*buf = NULL;
+  WlzValues	rVal;
+  WlzObject	*rObj2D = NULL;
+  WlzGreyWSpace	*iGWSp,
   		rGWSp;
-  WlzIntervalWSpace iIWSp = {0},
-  		    rIWSp = {0};
+  WlzIntervalWSpace *iIWSp,
+  		rIWSp = {0};
+  WlzScalarMulAddScanData *scan;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  bufLen = iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1;
-  if((bufLen != iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1) ||
-     (bufLen < 0))
+  scan = (WlzScalarMulAddScanData *)data;
+  m = scan->m;
+  a = scan->a;
+  iIWSp = &(pWSp->iWSp);
+  iGWSp = &(pWSp->gWSp);
+  if(scan->rObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    rVal = scan->rObj->values;
+  }
+  else
+  {
+    WlzVoxelValues *rVox;
+
+    rVox = scan->rObj->values.vox;
+    rVal = rVox->values[pWSp->plane - rVox->plane1];
+  }
+  bufLen = pWSp->obj2D->domain.i->lastkl - pWSp->obj2D->domain.i->kol1 + 1;
+  if(bufLen < 0)
   {
     errNum = WLZ_ERR_DOMAIN_DATA;
   }
-  else if(bufLen > 0)
+  else if((buf = AlcMalloc(sizeof(double) * (bufLen + 1))) == NULL)
   {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* The return object has the same domain as the input object so
+     * its intervals are visited in step with those of the input. */
+    rObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, pWSp->obj2D->domain, rVal,
+			 NULL, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(rObj2D, &rIWSp, &rGWSp);
     if(errNum == WLZ_ERR_NONE)
     {
-      errNum = WlzInitGreyScan(iObj, &iIWSp, &iGWSp);
-    }
-    if(errNum == WLZ_ERR_NONE)
-    {
-      errNum = WlzInitGreyScan(rObj, &rIWSp, &rGWSp);
-    }
-    if(errNum == WLZ_ERR_NONE)
-    {
-      double	*buf = NULL;
-
-      if((buf = AlcMalloc(sizeof(double) * bufLen)) == NULL)
+      while((errNum = WlzNextGreyInterval(iIWSp)) == WLZ_ERR_NONE)
       {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-      else
-      {
-	while((errNum = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE)
-	{
-	  int	t,
-	  	idN,
-	  	itvLen;
-	  double f;
+	int	t,
+		idN,
+		itvLen;
+	double f;
 
 
-	  itvLen = iIWSp.colrmn;
-	  (void )WlzNextGreyInterval(&rIWSp);
-	  switch(iGWSp.pixeltype)
-	  {
-	    case WLZ_GREY_INT:
-	      WlzValueCopyIntToDouble(buf, iGWSp.u_grintptr.inp, itvLen);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      WlzValueCopyShortToDouble(buf, iGWSp.u_grintptr.shp, itvLen);
-	      break;
-	    case WLZ_GREY_UBYTE:
-	      WlzValueCopyUByteToDouble(buf, iGWSp.u_grintptr.ubp, itvLen);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      WlzValueCopyFloatToDouble(buf, iGWSp.u_grintptr.flp, itvLen);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      WlzValueCopyDoubleToDouble(buf, iGWSp.u_grintptr.dbp, itvLen);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      WlzValueCopyRGBAToDouble(buf, iGWSp.u_grintptr.rgbp, itvLen);
-	      break;
-	    default:
-	      break;
-	  }
-	  switch(rGWSp.pixeltype)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		rGWSp.u_grintptr.ubp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_SHORT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, SHRT_MIN, SHRT_MAX);
-		rGWSp.u_grintptr.shp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_INT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, INT_MIN, INT_MAX);
-		rGWSp.u_grintptr.inp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_RGBA:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		WlzUInt	u;
-
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		t = WLZ_NINT(f);
-                WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
-		rGWSp.u_grintptr.inp[idN] = u;
-	      }
-	    case WLZ_GREY_FLOAT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		double	t;
-
-		t = (buf[idN] * m) + a;
-		rGWSp.u_grintptr.flp[idN] = WLZ_CLAMP(t, -(FLT_MAX), FLT_MAX);
-	      }
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		rGWSp.u_grintptr.dbp[idN] = (buf[idN] * m) + a;
-	      }
-	      break;
-	    default:
-	      break;
-	  }
+	itvLen = iIWSp->colrmn;
+	(void )WlzNextGreyInterval(&rIWSp);
+	switch(iGWSp->pixeltype)
+	{
+	  case WLZ_GREY_INT:
+	    WlzValueCopyIntToDouble(buf, iGWSp->u_grintptr.inp, itvLen);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    WlzValueCopyShortToDouble(buf, iGWSp->u_grintptr.shp, itvLen);
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    WlzValueCopyUByteToDouble(buf, iGWSp->u_grintptr.ubp, itvLen);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    WlzValueCopyFloatToDouble(buf, iGWSp->u_grintptr.flp, itvLen);
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    WlzValueCopyDoubleToDouble(buf, iGWSp->u_grintptr.dbp, itvLen);
+	    break;
+	  case WLZ_GREY_RGBA:
+	    WlzValueCopyRGBAToDouble(buf, iGWSp->u_grintptr.rgbp, itvLen);
+	    break;
+	  default:
+	    break;
 	}
-	if(errNum == WLZ_ERR_EOO)
+	switch(rGWSp.pixeltype)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  case WLZ_GREY_UBYTE:
+	    WlzValueKrnMulAddDouble(buf, buf, m, a, itvLen);
+	    WlzValueKrnClampDoubleToUByte(rGWSp.u_grintptr.ubp, buf, itvLen);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    WlzValueKrnMulAddDouble(buf, buf, m, a, itvLen);
+	    WlzValueKrnClampDoubleToShort(rGWSp.u_grintptr.shp, buf, itvLen);
+	    break;
+	  case WLZ_GREY_INT:
+	    WlzValueKrnMulAddDouble(buf, buf, m, a, itvLen);
+	    WlzValueKrnClampDoubleToInt(rGWSp.u_grintptr.inp, buf, itvLen);
+	    break;
+	  case WLZ_GREY_RGBA:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      WlzUInt	u;
+
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, 0, 255);
+	      t = WLZ_NINT(f);
+	      WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
+	      rGWSp.u_grintptr.inp[idN] = u;
+	    }
+	  case WLZ_GREY_FLOAT:
+	    WlzValueKrnMulAddDouble(buf, buf, m, a, itvLen);
+	    WlzValueKrnClampDoubleToFloat(rGWSp.u_grintptr.flp, buf, itvLen);
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    WlzValueKrnMulAddDouble(rGWSp.u_grintptr.dbp, buf, m, a, itvLen);
+	    break;
+	  default:
+	    break;
 	}
       }
-      AlcFree(buf);
+      (void )WlzEndGreyScan(&rIWSp, &rGWSp);
     }
-    (void )WlzEndGreyScan(&iIWSp, &iGWSp);
-    (void )WlzEndGreyScan(&rIWSp, &rGWSp);
   }
+  (void )WlzFreeObj(rObj2D);
+  AlcFree(buf);
   return(errNum);
 }
@@ -43,10 +43,22 @@ static char _WlzScalarBinaryOp_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
-static WlzErrorNum WlzScalarBinaryOp3d(WlzObject	*o1,
-				       WlzPixelV	pval,
-				       WlzObject	*o3,
-				       WlzBinaryOperatorType op);
+/*!
+* \struct	_WlzScalarBinaryOpScanData
+* \ingroup	WlzArithmetic
+* \brief	Data passed to the parallel scan callback used by
+* 		WlzScalarBinaryOp().
+*/
+typedef struct _WlzScalarBinaryOpScanData
+{
+  WlzObject		*o3;		/*!< Object for the return values. */
+  WlzPixelV		pval;		/*!< Operand value, either int or
+  					     double. */
+  WlzBinaryOperatorType	op;		/*!< Operator to be applied. */
+} WlzScalarBinaryOpScanData;
+
+static WlzErrorNum WlzScalarBinaryOpScanFn(WlzScanParWSpace *pWSp,
+					   void *data);
 
 static WlzErrorNum WlzBufIntIntScalarBinaryOp(
   int		*inbuf1,
@@ -1077,7 +1089,15 @@ WlzErrorNum WlzScalarBinaryOp(
 	errNum = WLZ_ERR_VALUES_TYPE;
 	break;
       }
-      errNum = WlzScalarBinaryOp3d(o1, pval, o3, op);
+      if( (o1->domain.p->type != WLZ_PLANEDOMAIN_DOMAIN) ){
+	errNum = WLZ_ERR_PLANEDOMAIN_TYPE;
+	break;
+      }
+      if( (o1->values.vox->type != WLZ_VOXELVALUETABLE_GREY) ||
+	  (o3->values.vox->type != WLZ_VOXELVALUETABLE_GREY) ){
+	errNum = WLZ_ERR_VOXELVALUES_TYPE;
+	break;
+      }
       break;
       
     case WLZ_TRANS_OBJ:
@@ -1097,49 +1117,13 @@ WlzErrorNum WlzScalarBinaryOp(
     }
   }
 
-  /* scan each object */
-  if( (errNum == WLZ_ERR_NONE) && (o1->type == WLZ_2D_DOMAINOBJ) ){
-    WlzIntervalWSpace	iwsp1, iwsp3;
-    WlzGreyWSpace	gwsp1, gwsp3;
-    WlzPixelP		o1PP, o3PP;
-    int			*o1Buf=NULL;
-    int			i, ival;
-    double		dval;
-
-    o1PP.p.v = o3PP.p.v = NULL;
-    o1PP.type = o3PP.type = WLZ_GREY_ERROR;
-    /* initialise the workspaces */
-    if( (errNum = WlzInitGreyScan(o1,&iwsp1,&gwsp1)) ){
-      return errNum;
-    }
-    if( (errNum = WlzInitGreyScan(o3,&iwsp3,&gwsp3)) ){
-      return errNum;
-    }
-
-    /* initialise the buffers */
-    switch( gwsp1.pixeltype ){
-    case WLZ_GREY_INT:
-    case WLZ_GREY_DOUBLE:
-      o1PP.type = gwsp1.pixeltype;
-      break;
-
-    case WLZ_GREY_SHORT:
-    case WLZ_GREY_UBYTE:
-      o1PP.type = WLZ_GREY_INT;
-      o1Buf = (int *) AlcMalloc(sizeof(int) *
-				(iwsp1.intdmn->lastkl-iwsp1.intdmn->kol1+1));
-      o1PP.p.inp = o1Buf;
-      break;
-
-    case WLZ_GREY_FLOAT:
-      o1PP.type = WLZ_GREY_DOUBLE;
-      o1Buf = (int *) AlcMalloc(sizeof(double) *
-				(iwsp1.intdmn->lastkl-iwsp1.intdmn->kol1+1));
-      o1PP.p.inp = o1Buf;
-      break;
-    default:
-      break;
-    }
+  /* scan the object in parallel, for 3D objects the planes and for 2D
+     objects ranges of lines are independent */
+  if( (errNum == WLZ_ERR_NONE) &&
+      ((o1->type == WLZ_2D_DOMAINOBJ) || (o1->type == WLZ_3D_DOMAINOBJ)) ){
+    WlzScalarBinaryOpScanData	scan;
+    int				ival;
+    double			dval;
 
     switch( pval.type ){
     case WLZ_GREY_INT:
@@ -1166,195 +1150,198 @@ WlzErrorNum WlzScalarBinaryOp(
     default:
       break;
     }
+    scan.o3 = o3;
+    scan.pval = pval;
+    scan.op = op;
+    errNum = WlzScanPar(o1, NULL, 0, 1, WlzScalarBinaryOpScanFn, &scan);
+  }
 
-    o3PP.type = gwsp3.pixeltype;
-
-    while ((errNum = WlzNextGreyInterval(&iwsp1)) == WLZ_ERR_NONE) {
-      WlzNextGreyInterval(&iwsp3);
-
-      /* copy values to buffers */
-      switch(  gwsp1.pixeltype ){
-      case WLZ_GREY_INT:
-	o1PP.p.inp = gwsp1.u_grintptr.inp;
-	break;
+  return errNum;
+}
 
-      case WLZ_GREY_SHORT:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.inp[i] = *gwsp1.u_grintptr.shp++;
-	}
-	break;
 
-      case WLZ_GREY_UBYTE:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.inp[i] = (int) (*gwsp1.u_grintptr.ubp++);
-	}
-	break;
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Parallel scan callback for WlzScalarBinaryOp() which
+* 		applies the operator to the current piece of the first
+* 		object putting the result in the matching piece of the
+* 		return object. The return object has the same domain so
+* 		its intervals are scanned in step with those of the first.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzScalarBinaryOpScanFn(
+  WlzScanParWSpace	*pWSp,
+  void			*data)
+{
+  WlzScalarBinaryOpScanData	*scan;
+  WlzObject		*o3Obj2D=NULL;
+  WlzValues		o3Val;
+  WlzIntervalWSpace	*iwsp1, iwsp3;
+  WlzGreyWSpace		*gwsp1, gwsp3;
+  WlzPixelP		o1PP, o3PP;
+  WlzPixelV		pval;
+  int			*o1Buf=NULL;
+  int			i, bufLen;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
 
-      case WLZ_GREY_FLOAT:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.dbp[i] = *gwsp1.u_grintptr.flp++;
-	}
-	break;
+  scan = (WlzScalarBinaryOpScanData *)data;
+  pval = scan->pval;
+  iwsp1 = &(pWSp->iWSp);
+  gwsp1 = &(pWSp->gWSp);
+  o1PP.p.v = o3PP.p.v = NULL;
+  o1PP.type = o3PP.type = WLZ_GREY_ERROR;
 
-      case WLZ_GREY_DOUBLE:
-	o1PP.p.dbp = gwsp1.u_grintptr.dbp;
-	break;
+  /* make an object for the matching piece of the return object */
+  if( scan->o3->type == WLZ_2D_DOMAINOBJ ){
+    o3Val = scan->o3->values;
+  }
+  else {
+    o3Val = scan->o3->values.vox->values[pWSp->plane -
+					 scan->o3->values.vox->plane1];
+  }
+  if((o3Obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, pWSp->obj2D->domain, o3Val,
+			    NULL, NULL, &errNum)) == NULL){
+    return errNum;
+  }
+  if( (errNum = WlzInitGreyScan(o3Obj2D,&iwsp3,&gwsp3)) ){
+    WlzFreeObj( o3Obj2D );
+    return errNum;
+  }
 
-      default:
-	break;
-      }
+  /* initialise the buffers */
+  bufLen = iwsp1->intdmn->lastkl - iwsp1->intdmn->kol1 + 1;
+  switch( gwsp1->pixeltype ){
+  case WLZ_GREY_INT:
+  case WLZ_GREY_DOUBLE:
+    o1PP.type = gwsp1->pixeltype;
+    break;
 
-      switch(  gwsp3.pixeltype ){
-      case WLZ_GREY_INT:
-	o3PP.p.inp = gwsp3.u_grintptr.inp;
-	break;
+  case WLZ_GREY_SHORT:
+  case WLZ_GREY_UBYTE:
+    o1PP.type = WLZ_GREY_INT;
+    if((o1Buf = (int *) AlcMalloc(sizeof(int) * bufLen)) == NULL){
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    o1PP.p.inp = o1Buf;
+    break;
 
-      case WLZ_GREY_SHORT:
-	o3PP.p.shp = gwsp3.u_grintptr.shp;
-	break;
+  case WLZ_GREY_FLOAT:
+    o1PP.type = WLZ_GREY_DOUBLE;
+    if((o1Buf = (int *) AlcMalloc(sizeof(double) * bufLen)) == NULL){
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    o1PP.p.inp = o1Buf;
+    break;
+  default:
+    break;
+  }
 
-      case WLZ_GREY_UBYTE:
-	o3PP.p.ubp = gwsp3.u_grintptr.ubp;
-	break;
+  o3PP.type = gwsp3.pixeltype;
 
-      case WLZ_GREY_FLOAT:
-	o3PP.p.flp = gwsp3.u_grintptr.flp;
-	break;
+  while ((errNum == WLZ_ERR_NONE) &&
+	 ((errNum = WlzNextGreyInterval(iwsp1)) == WLZ_ERR_NONE)) {
+    WlzNextGreyInterval(&iwsp3);
 
-      case WLZ_GREY_DOUBLE:
-	o3PP.p.dbp = gwsp3.u_grintptr.dbp;
-	break;
+    /* copy values to buffers */
+    switch(  gwsp1->pixeltype ){
+    case WLZ_GREY_INT:
+      o1PP.p.inp = gwsp1->u_grintptr.inp;
+      break;
 
-      default:
-	break;
+    case WLZ_GREY_SHORT:
+      for(i=0; i<iwsp1->colrmn; i++){
+	o1PP.p.inp[i] = *gwsp1->u_grintptr.shp++;
       }
+      break;
 
-      /* apply binary operation */
-      switch( o1PP.type ){
-      case WLZ_GREY_INT:
-	switch( pval.type ){
-	case WLZ_GREY_INT:
-	  errNum = WlzBufIntIntScalarBinaryOp(o1PP.p.inp, pval.v.inv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  errNum = WlzBufIntDblScalarBinaryOp(o1PP.p.inp, pval.v.dbv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	default:
-	  break;
-	}
-	break;
-      case WLZ_GREY_DOUBLE:
-	switch( pval.type ){
-	case WLZ_GREY_INT:
-	  errNum = WlzBufDblIntScalarBinaryOp(o1PP.p.dbp, pval.v.inv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  errNum = WlzBufDblDblScalarBinaryOp(o1PP.p.dbp, pval.v.dbv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	default:
-	  break;
-	}
-	break;
-      default:
-	break;
+    case WLZ_GREY_UBYTE:
+      for(i=0; i<iwsp1->colrmn; i++){
+	o1PP.p.inp[i] = (int) (*gwsp1->u_grintptr.ubp++);
       }
+      break;
 
-      if( errNum != WLZ_ERR_NONE ){
-	break;
+    case WLZ_GREY_FLOAT:
+      for(i=0; i<iwsp1->colrmn; i++){
+	o1PP.p.dbp[i] = *gwsp1->u_grintptr.flp++;
       }
-    }
-    if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
-    {
-      errNum = WLZ_ERR_NONE;
-    }
-
-    /* free space */
-    if( o1Buf ){
-      AlcFree( o1Buf );
-    }
-
-  }
-
-  return errNum;
-}
-
-
-static WlzErrorNum WlzScalarBinaryOp3d(
-  WlzObject	*o1,
-  WlzPixelV	pval,
-  WlzObject	*o3,
-  WlzBinaryOperatorType op)
-{
-  WlzObject		*temp1, *temp3;
-  WlzPlaneDomain	*pdom;
-  WlzDomain		*domains;
-  WlzValues		*values1, *values3;
-  int			i, nplanes;
-  WlzErrorNum		errNum = WLZ_ERR_NONE;
+      break;
 
-  /* no need to check the object pointer or type because this procedure
-     can only be accessed via WlzImageAdd. The domain and valuetable
-     types must be checked however */
+    case WLZ_GREY_DOUBLE:
+      o1PP.p.dbp = gwsp1->u_grintptr.dbp;
+      break;
 
-  /* check planedomain type */
-  switch( o1->domain.p->type ){
-  case WLZ_PLANEDOMAIN_DOMAIN:
-    break;
-  default:
-    errNum = WLZ_ERR_PLANEDOMAIN_TYPE;
-    break;
-  }
+    default:
+      break;
+    }
 
-  /* check voxeltable type */
-  switch( o1->values.vox->type ){
-  case WLZ_VOXELVALUETABLE_GREY:
-    break;
-  default:
-    errNum = WLZ_ERR_VOXELVALUES_TYPE;
-    break;
-  }
+    switch(  gwsp3.pixeltype ){
+    case WLZ_GREY_INT:
+      o3PP.p.inp = gwsp3.u_grintptr.inp;
+      break;
 
-  switch( o3->values.vox->type ){
-  case WLZ_VOXELVALUETABLE_GREY:
-    break;
-  default:
-    errNum = WLZ_ERR_VOXELVALUES_TYPE;
-    break;
-  }
+    case WLZ_GREY_SHORT:
+      o3PP.p.shp = gwsp3.u_grintptr.shp;
+      break;
 
-  /* apply the binary operation to each plane */
+    case WLZ_GREY_UBYTE:
+      o3PP.p.ubp = gwsp3.u_grintptr.ubp;
+      break;
 
-  /* note a NULL domain is currently legal (to be WLZ_EMPTY_DOMAIN) and
-   corresponds to a WLZ_EMPTY_OBJ */
+    case WLZ_GREY_FLOAT:
+      o3PP.p.flp = gwsp3.u_grintptr.flp;
+      break;
 
-  pdom = o1->domain.p;
-  domains = pdom->domains;
-  values1 = o1->values.vox->values;
-  values3 = o3->values.vox->values;
-  nplanes = pdom->lastpl - pdom->plane1 + 1;
+    case WLZ_GREY_DOUBLE:
+      o3PP.p.dbp = gwsp3.u_grintptr.dbp;
+      break;
 
-  for(i=0; i < nplanes; i++, domains++, values1++, values3++){
-    if( (*domains).core == NULL ){
-      continue;
+    default:
+      break;
     }
 
-    if((temp1 = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values1,
-			    NULL, NULL, &errNum)) != NULL){
-      if((temp3 = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values3,
-			     NULL, NULL, &errNum)) != NULL){
-	errNum = WlzScalarBinaryOp(temp1, pval, temp3, op);
-	WlzFreeObj( temp3 );
+    /* apply binary operation */
+    switch( o1PP.type ){
+    case WLZ_GREY_INT:
+      switch( pval.type ){
+      case WLZ_GREY_INT:
+	errNum = WlzBufIntIntScalarBinaryOp(o1PP.p.inp, pval.v.inv,
+					      o3PP, iwsp1->colrmn, scan->op);
+	break;
+      case WLZ_GREY_DOUBLE:
+	errNum = WlzBufIntDblScalarBinaryOp(o1PP.p.inp, pval.v.dbv,
+					      o3PP, iwsp1->colrmn, scan->op);
+	break;
+      default:
+	break;
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      switch( pval.type ){
+      case WLZ_GREY_INT:
+	errNum = WlzBufDblIntScalarBinaryOp(o1PP.p.dbp, pval.v.inv,
+					      o3PP, iwsp1->colrmn, scan->op);
+	break;
+      case WLZ_GREY_DOUBLE:
+	errNum = WlzBufDblDblScalarBinaryOp(o1PP.p.dbp, pval.v.dbv,
+					      o3PP, iwsp1->colrmn, scan->op);
+	break;
+      default:
+	break;
       }
-      WlzFreeObj( temp1 );
-    }
-    if( errNum != WLZ_ERR_NONE ){
+      break;
+    default:
       break;
     }
   }
 
+  /* free space */
+  (void )WlzEndGreyScan(&iwsp3, &gwsp3);
+  WlzFreeObj( o3Obj2D );
+  if( o1Buf ){
+    AlcFree( o1Buf );
+  }
+
   return errNum;
 }
@@ -0,0 +1,551 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzScanPar_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzScanPar.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Partitioned scanning of 2D and 3D domain objects so that
+* 		operators may process the intervals of an object in
+* 		parallel. An object is split into chunks of planes (3D)
+* 		or lines (2D) which are balanced using interval counts,
+* 		each chunk is then scanned by a single thread using
+* 		its own interval and grey workspaces.
+* 		Operators which build new domains while scanning, such
+* 		as WlzThreshold(), build a domain for each piece and then
+* 		combine these. Operators which scan objects with different
+* 		domains in step, such as WlzImageArithmetic(), keep their
+* 		own per-plane loops since their work does not split into
+* 		independent pieces of a single object.
+* \ingroup	WlzAccess
+*/
+
+#include <string.h>
+#include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static WlzErrorNum		WlzScanParCheckObj(
+				  WlzObject *obj,
+				  int grey);
+static WlzErrorNum		WlzScanParRunChunk(
+				  WlzObject *obj,
+				  WlzScanParChunk *chk,
+				  int grey,
+				  WlzScanParFn fn,
+				  void *data);
+static WlzErrorNum		WlzScanParRunPiece(
+				  WlzScanParWSpace *pWSp,
+				  WlzScanParFn fn,
+				  void *data);
+static WlzObject		*WlzScanParMakeLineObj(
+				  WlzObject *obj,
+				  int line1,
+				  int lastln,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	New array of chunks or NULL on error.
+* \ingroup	WlzAccess
+* \brief	Partitions the given 2D or 3D domain object into at most
+* 		the requested number of chunks for use by WlzScanPar().
+* 		A 3D object is partitioned into contiguous ranges of
+* 		planes and a 2D object into contiguous ranges of lines.
+* 		The partition uses a prefix sum of the interval counts
+* 		(plus one for each line to account for the per line
+* 		overhead) so that each chunk has roughly the same amount
+* 		of work. Callers which need deterministic reductions
+* 		should keep one accumulator per chunk and combine these
+* 		in chunk order. The array should be freed using AlcFree().
+* \param	obj			Given 2D or 3D domain object.
+* \param	nChk			Maximum number of chunks, if less
+* 					than one then the number of
+* 					available threads is used.
+* \param	dstNChk			Destination pointer for the number
+* 					of chunks, must not be NULL.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzScanParChunk	*WlzScanParChunks(WlzObject *obj, int nChk, int *dstNChk,
+				  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nEnt = 0,
+		nOut = 0,
+		off = 0;
+  WlzLong	wTot = 0;
+  WlzLong	*wgt = NULL,
+  		*cnt = NULL;
+  WlzScanParChunk *chk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dstNChk == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    errNum = WlzScanParCheckObj(obj, 0);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nChk < 1)
+    {
+#ifdef _OPENMP
+      nChk = omp_get_max_threads();
+#else
+      nChk = 1;
+#endif
+    }
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      off = obj->domain.i->line1;
+      nEnt = obj->domain.i->lastln - off + 1;
+    }
+    else
+    {
+      off = obj->domain.p->plane1;
+      nEnt = obj->domain.p->lastpl - off + 1;
+    }
+    if(((wgt = (WlzLong *)AlcMalloc(sizeof(WlzLong) * 2 * nEnt)) == NULL) ||
+       ((chk = (WlzScanParChunk *)
+               AlcCalloc(ALG_MIN(nChk, nEnt), sizeof(WlzScanParChunk)))
+	       == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cnt = wgt + nEnt;
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      WlzIntervalDomain *iDom;
+
+      iDom = obj->domain.i;
+      for(idx = 0; idx < nEnt; ++idx)
+      {
+        cnt[idx] = (iDom->type == WLZ_INTERVALDOMAIN_INTVL)?
+		   iDom->intvlines[idx].nintvs: 1;
+        wgt[idx] = cnt[idx] + 1;
+      }
+    }
+    else
+    {
+      WlzDomain	*doms;
+
+      doms = obj->domain.p->domains;
+      for(idx = 0; idx < nEnt; ++idx)
+      {
+	cnt[idx] = 0;
+	wgt[idx] = 1;
+	if(doms[idx].core != NULL)
+	{
+	  WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	  cnt[idx] = WlzIntervalCount(doms[idx].i, &errNum2);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	    break;
+	  }
+	  wgt[idx] += cnt[idx] +
+	              doms[idx].i->lastln - doms[idx].i->line1 + 1;
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		first = 0;
+    WlzLong	acc = 0;
+
+    for(idx = 0; idx < nEnt; ++idx)
+    {
+      wTot += wgt[idx];
+    }
+    nChk = ALG_MIN(nChk, nEnt);
+    for(idx = 0; idx < nEnt; ++idx)
+    {
+      acc += wgt[idx];
+      chk[nOut].nItv += cnt[idx];
+      if((idx == nEnt - 1) || (acc * nChk >= (nOut + 1) * wTot))
+      {
+	WlzScanParChunk *c;
+
+	c = chk + nOut;
+	c->idx = nOut;
+	if(obj->type == WLZ_2D_DOMAINOBJ)
+	{
+	  c->line1 = first + off;
+	  c->lastln = idx + off;
+	}
+	else
+	{
+	  c->plane1 = first + off;
+	  c->lastpl = idx + off;
+	}
+	first = idx + 1;
+	++nOut;
+      }
+    }
+  }
+  AlcFree(wgt);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    AlcFree(chk);
+    chk = NULL;
+    nOut = 0;
+  }
+  if(dstNChk)
+  {
+    *dstNChk = nOut;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(chk);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Scans the given 2D or 3D domain object in parallel. The
+* 		object is scanned in chunks (see WlzScanParChunks()) with
+* 		the chunks distributed dynamically over the available
+* 		threads. For each plane of a 3D chunk, or for the range
+* 		of lines of a 2D chunk, a per-thread workspace is
+* 		initialised for a raster scan (or grey scan if grey is
+* 		non-zero) in the direction WLZ_RASTERDIR_ILIC and the
+* 		given callback function is called. Planes with no domain
+* 		or, when grey values are required, no values are skipped.
+* 		The callback function must be thread safe and the first
+* 		error returned by it terminates the scan.
+* \param	obj			Given 2D or 3D domain object.
+* \param	chk			Chunks as computed by
+* 					WlzScanParChunks(), if NULL then
+* 					chunks are computed using the
+* 					default number of chunks.
+* \param	nChk			Number of chunks, ignored if chk
+* 					is NULL.
+* \param	grey			Initialise grey scanning if non-zero.
+* \param	fn			Callback function.
+* \param	data			Data passed to the callback function.
+*/
+WlzErrorNum	WlzScanPar(WlzObject *obj, WlzScanParChunk *chk, int nChk,
+			   int grey, WlzScanParFn fn, void *data)
+{
+  int		idx;
+  WlzScanParChunk *newChk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fn == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    errNum = WlzScanParCheckObj(obj, grey);
+  }
+  if((errNum == WLZ_ERR_NONE) && (chk == NULL))
+  {
+    chk = newChk = WlzScanParChunks(obj, 0, &nChk, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < nChk; ++idx)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+        WlzErrorNum errNum2;
+
+	errNum2 = WlzScanParRunChunk(obj, chk + idx, grey, fn, data);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzScanPar)
+	  {
+#endif
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+#ifdef _OPENMP
+	  }
+#endif
+	}
+      }
+    }
+  }
+  AlcFree(newChk);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Checks that the given object can be scanned in parallel.
+* \param	obj			Given object.
+* \param	grey			Check the values too if non-zero.
+*/
+static WlzErrorNum WlzScanParCheckObj(WlzObject *obj, int grey)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(grey && (obj->values.core == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	if((obj->domain.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+	   (obj->domain.core->type != WLZ_INTERVALDOMAIN_RECT))
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if(obj->domain.p->domains == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
+	else if(grey &&
+	        (obj->values.core->type != WLZ_VOXELVALUETABLE_GREY) &&
+	        (WlzGreyTableIsTiled(obj->values.core->type) == 0))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Scans a single chunk of the given object calling the
+* 		callback function for each plane or range of lines.
+* \param	obj			Given object.
+* \param	chk			Chunk to scan.
+* \param	grey			Initialise grey scanning if non-zero.
+* \param	fn			Callback function.
+* \param	data			Data passed to the callback function.
+*/
+static WlzErrorNum WlzScanParRunChunk(WlzObject *obj, WlzScanParChunk *chk,
+				      int grey, WlzScanParFn fn, void *data)
+{
+  WlzScanParWSpace pWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&pWSp, 0, sizeof(WlzScanParWSpace));
+  pWSp.obj = obj;
+  pWSp.grey = grey;
+  pWSp.chkIdx = chk->idx;
+#ifdef _OPENMP
+  pWSp.thrId = omp_get_thread_num();
+#endif
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    pWSp.obj2D = WlzScanParMakeLineObj(obj, chk->line1, chk->lastln,
+    				       &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzScanParRunPiece(&pWSp, fn, data);
+    }
+  }
+  else
+  {
+    int		pln;
+    WlzPlaneDomain *pDom;
+    WlzVoxelValues *vox = NULL;
+
+    pDom = obj->domain.p;
+    if(grey && !WlzGreyTableIsTiled(obj->values.core->type))
+    {
+      vox = obj->values.vox;
+    }
+    for(pln = chk->plane1; (errNum == WLZ_ERR_NONE) && (pln <= chk->lastpl);
+        ++pln)
+    {
+      WlzDomain	dom;
+      WlzValues	val;
+
+      val.core = NULL;
+      dom = pDom->domains[pln - pDom->plane1];
+      if(grey)
+      {
+	if(vox == NULL)
+	{
+	  val = obj->values;
+	}
+	else if((pln >= vox->plane1) && (pln <= vox->lastpl))
+	{
+	  val = vox->values[pln - vox->plane1];
+	}
+      }
+      if((dom.core != NULL) && ((grey == 0) || (val.core != NULL)))
+      {
+	pWSp.plane = pln;
+	pWSp.obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+				 &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzScanParRunPiece(&pWSp, fn, data);
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Initialises the scan of the workspace's 2D object, calls
+* 		the callback function and then frees the 2D object.
+* \param	pWSp			Parallel scan workspace with the
+* 					2D object set.
+* \param	fn			Callback function.
+* \param	data			Data passed to the callback function.
+*/
+static WlzErrorNum WlzScanParRunPiece(WlzScanParWSpace *pWSp,
+				      WlzScanParFn fn, void *data)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pWSp->obj2D = WlzAssignObject(pWSp->obj2D, NULL);
+  if(pWSp->grey)
+  {
+    errNum = WlzInitGreyScan(pWSp->obj2D, &(pWSp->iWSp), &(pWSp->gWSp));
+    if((errNum == WLZ_ERR_NONE) && pWSp->gWSp.tvb)
+    {
+      pWSp->iWSp.plnpos = pWSp->plane;
+    }
+  }
+  else
+  {
+    errNum = WlzInitRasterScan(pWSp->obj2D, &(pWSp->iWSp),
+    			       WLZ_RASTERDIR_ILIC);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = (*fn)(pWSp, data);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    if(pWSp->grey)
+    {
+      (void )WlzEndGreyScan(&(pWSp->iWSp), &(pWSp->gWSp));
+    }
+  }
+  (void )WlzFreeObj(pWSp->obj2D);
+  pWSp->obj2D = NULL;
+  return(errNum);
+}
+
+/*!
+* \return	New 2D domain object or NULL on error.
+* \ingroup	WlzAccess
+* \brief	Makes a 2D domain object which covers the given range of
+* 		lines of the given 2D domain object and shares its values.
+* 		The interval lines of the new domain point to the intervals
+* 		of the given object's domain, so the new object must not
+* 		outlive the given object. If the line range covers the
+* 		whole of the given object then the domain is shared.
+* \param	obj			Given 2D domain object.
+* \param	line1			First line of the range.
+* \param	lastln			Last line of the range.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzScanParMakeLineObj(WlzObject *obj,
+					int line1, int lastln,
+					WlzErrorNum *dstErr)
+{
+  WlzDomain	dom;
+  WlzObject	*nObj = NULL;
+  WlzIntervalDomain *iDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  iDom = obj->domain.i;
+  if((line1 == iDom->line1) && (lastln == iDom->lastln))
+  {
+    nObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, obj->domain, obj->values,
+    		       NULL, NULL, &errNum);
+  }
+  else
+  {
+    dom.i = WlzMakeIntervalDomain(iDom->type, line1, lastln,
+				  iDom->kol1, iDom->lastkl, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+      {
+	(void )memcpy(dom.i->intvlines,
+		      iDom->intvlines + line1 - iDom->line1,
+		      sizeof(WlzIntervalLine) * (lastln - line1 + 1));
+      }
+      nObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, obj->values, NULL, NULL,
+      			 &errNum);
+      if(nObj == NULL)
+      {
+	(void )WlzFreeIntervalDomain(dom.i);
+      }
+    }
+  }
+  *dstErr = errNum;
+  return(nObj);
+}
@@ -41,6 +41,7 @@ static char _WlzSepFilter_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include <float.h>
 #include <Wlz.h>
@@ -50,6 +51,63 @@ static char _WlzSepFilter_c[] = "University of Edinburgh $Id$";
 #endif
 
 
+/*!
+* \struct	_WlzSepFilterWinAxis
+* \ingroup	WlzValuesFilters
+* \brief	Kernel for one axis of the windowed seperable filter.
+*/
+typedef struct _WlzSepFilterWinAxis
+{
+  int		h;		/*!< Kernel half size, negative if there's
+  				     no filtering along the axis. */
+  double	*krn;		/*!< Kernel of size (2 * h) + 1. */
+  double	*sumL;		/*!< Sums of the kernel values before each
+  				     kernel index, used for padding. */
+  double	*sumT;		/*!< Sums of the kernel values from each
+  				     kernel index, used for padding. */
+} WlzSepFilterWinAxis;
+
+/*!
+* \struct	_WlzSepFilterWinWSp
+* \ingroup	WlzValuesFilters
+* \brief	Workspace for the windowed seperable filter.
+*/
+typedef struct _WlzSepFilterWinWSp
+{
+  WlzSepFilterWinAxis ax[3];	/*!< Kernels for the x, y and z axes. */
+  AlgPadType	pad;		/*!< Type of padding. */
+  double	padVal;		/*!< Padding value. */
+  WlzGreyType	iType;		/*!< Intermediate grey type. */
+  WlzIBox3	bBox;		/*!< Bounding box of the object. */
+  int		width;		/*!< Width of the bounding box. */
+  int		height;		/*!< Height of the bounding box. */
+  int		nWin;		/*!< Number of planes in the window. */
+  int		*yS;		/*!< First line of the run through each
+  				     pixel of the current plane. */
+  int		*yE;		/*!< Last line of the run through each
+  				     pixel of the current plane. */
+  int		*zCur;		/*!< Index of the current run through the
+  				     planes for each column. */
+  int		*zRun;		/*!< Runs through the planes, as pairs of
+  				     first and last plane indices. */
+  WlzGreyP	tX;		/*!< Plane buffer for the x filtered
+  				     values. */
+  WlzGreyP	win;		/*!< Window of x and y filtered planes. */
+} WlzSepFilterWinWSp;
+
+/*!
+* \struct	_WlzSepFilterWinItv
+* \ingroup	WlzValuesFilters
+* \brief	An interval of a plane with a pointer to its values.
+*/
+typedef struct _WlzSepFilterWinItv
+{
+  int		ln;		/*!< Line of the interval. */
+  int		kl;		/*!< First column of the interval. */
+  int		len;		/*!< Length of the interval. */
+  WlzGreyP	gP;		/*!< Values of the interval. */
+} WlzSepFilterWinItv;
+
 static WlzObject		*WlzSepFilterX(WlzObject *inObj,
 				  int dim,
 				  int maxThr,
@@ -80,6 +138,67 @@ static WlzObject		*WlzSepFilterZ(WlzObject *inObj,
 				  AlgPadType pad,
 				  double padVal,
 				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzSepFilterWinAxisInit(
+				  WlzSepFilterWinAxis *ax);
+static void			WlzSepFilterWinMask(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzUByte *mask);
+static WlzErrorNum		WlzSepFilterWinZRuns(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain *domains,
+				  int nPln,
+				  WlzUByte **mask,
+				  int *cur,
+				  int *run);
+static WlzErrorNum		WlzSepFilterWinItvs(
+				  WlzDomain dom,
+				  WlzValues val,
+				  WlzSepFilterWinItv **dstItv,
+				  int *dstMaxItv,
+				  int *dstNItv,
+				  WlzGreyType *dstGType);
+static void			WlzSepFilterWinMAdd(
+				  double *acc,
+				  double f,
+				  WlzGreyP row,
+				  WlzGreyType iType,
+				  int add,
+				  int n);
+static void			WlzSepFilterWinSet(
+				  double *acc,
+				  double v,
+				  int n);
+static void			WlzSepFilterWinCnvSeg(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzSepFilterWinAxis *ax,
+				  double *acc,
+				  double *prt,
+				  WlzGreyP *row,
+				  int n,
+				  int s0,
+				  int s1,
+				  int pos);
+static void			WlzSepFilterWinCnv1D(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzSepFilterWinAxis *ax,
+				  double *dst,
+				  double *src,
+				  int len);
+static WlzErrorNum		WlzSepFilterWinXY(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int slot,
+				  WlzUByte *mask,
+				  int nThr);
+static WlzErrorNum		WlzSepFilterWinZ(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int idz,
+				  WlzGreyType gType,
+				  int nThr);
 /*!
 * \return	New Gaussian filtered object with new values or NULL on error.
 * \ingroup	WlzValuesFilters
@@ -401,6 +520,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
 				  WlzErrorNum *dstErr)
 {
   int		dim = 0,
+  		win = 0,
   		vSz = 0,
   		nThr = 1;
   double	**iBuf = NULL,
@@ -470,6 +590,19 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
     }
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    /* Filters applied one after another to non-tiled values don't need
+     * intermediate objects, so use the windowed filter. */
+    win = (sep == 0) &&
+          (direc.vtX || direc.vtY || ((dim == 3) && direc.vtZ)) &&
+	  !WlzGreyTableIsTiled(inObj->values.core->type);
+    if(win)
+    {
+      rnObj = WlzSepFilterWindowed(inObj, cBufSz, cBuf, direc, gType,
+      				   pad, padVal, WLZ_GREY_DOUBLE, &errNum);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (win == 0))
   {
     bBox = WlzBoundingBox3I(inObj, &errNum);
     if(errNum == WLZ_ERR_NONE)
@@ -482,7 +615,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
       }
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && (win == 0))
   {
     vSz = ALG_MAX3(vBufSz.vtX, vBufSz.vtY, vBufSz.vtZ);
     if(((iBuf = (double **)
@@ -504,7 +637,7 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
       }
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && (win == 0))
   {
     WlzObject *tObj[3] = {NULL};
 
@@ -733,7 +866,8 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
       (void )WlzFreeObj(tObj[2]);
     }
   }
-  if((errNum == WLZ_ERR_NONE) && (rnObj != NULL) && (gType != WLZ_GREY_DOUBLE))
+  if((errNum == WLZ_ERR_NONE) && (win == 0) && (rnObj != NULL) &&
+     (gType != WLZ_GREY_DOUBLE))
   {
     /* Convert object values to the required grey type. */
     switch(rnObj->type)
@@ -796,6 +930,318 @@ WlzObject			*WlzSepFilter(WlzObject *inObj,
   return(rnObj);
 }
 
+/*!
+* \return	New filtered object with new values or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a seperable filter to the given object using the
+* 		given convolution kernels, with each directional filter
+* 		applied to the output of the previous one (as
+* 		WlzSepFilter() with sep == 0). Unlike the separate passes
+* 		no intermediate objects are created: planes are filtered
+* 		along x and then y into a sliding window of (2 * sz) + 1
+* 		planes from which the z filter computes the output plane
+* 		by plane. The y and z filters work along whole rows of
+* 		a plane at a time so that their inner loops are over
+* 		consecutive columns and may be vectorised.
+* 		With double intermediate values the results are identical
+* 		to those of the separate passes for domains in which each
+* 		column of a plane and each column through the planes is a
+* 		single run of at least the kernel size. For other domains
+* 		each run is filtered separately with the padding applied
+* 		at its ends.
+* \param	inObj			Input 2 or 3D spatial domain object
+* 					to be filtered which must have scalar
+* 					values.
+* \param	cBufSz			Convolution kernel sizes (sz), each
+* 					kernel buffer is sized (2 * sz) + 1
+* 					with the centre indexed sz into the
+* 					buffer.
+* \param	cBuf			Convolution kernel buffers.
+* \param	direc			Set to non-zero in directions for which
+* 					the filter is to be applied.
+* \param	gType			Required return object grey type.
+* 					Passing in WLZ_GREY_ERROR will
+* 					request the given input object's grey
+* 					type.
+* \param	pad			Type of padding.
+* \param	padVal			Padding value, only used when
+* 					pad == ALG_PAD_VALUE.
+* \param	iType			Grey type for the intermediate values,
+* 					which must be either WLZ_GREY_DOUBLE
+* 					or WLZ_GREY_FLOAT. Float values halve
+* 					the memory used by the window at the
+* 					cost of rounding between passes.
+* \param	dstErr			Destination error pointer may be NULL.
+*/
+WlzObject			*WlzSepFilterWindowed(
+				  WlzObject *inObj,
+				  WlzIVertex3 cBufSz,
+				  double *cBuf[],
+				  WlzIVertex3 direc,
+				  WlzGreyType gType,
+				  AlgPadType pad,
+				  double padVal,
+				  WlzGreyType iType,
+				  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		idp,
+		poff,
+		rpoff,
+		nPln = 1,
+  		nThr = 1;
+  size_t	area = 0;
+  int		*zOff = NULL,
+  		*zCur = NULL,
+		*zRun = NULL;
+  WlzUByte	*mask[2] = {NULL};
+  WlzGreyP	tX,
+  		win;
+  WlzDomain	*domains = NULL;
+  WlzValues	*iVal = NULL,
+  		*rVal = NULL;
+  WlzSepFilterWinWSp wSp;
+  WlzObject	*rnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tX.v = win.v = NULL;
+  (void )memset(&wSp, 0, sizeof(WlzSepFilterWinWSp));
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  if(inObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(inObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(inObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(inObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((iType != WLZ_GREY_DOUBLE) && (iType != WLZ_GREY_FLOAT))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  else
+  {
+    switch(inObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	direc.vtZ = 0;
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(inObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_PLANEDOMAIN_TYPE;
+	}
+	else if(inObj->values.core->type != WLZ_VOXELVALUETABLE_GREY)
+	{
+	  errNum = WLZ_ERR_VOXELVALUES_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (gType == WLZ_GREY_ERROR))
+  {
+    gType = WlzGreyTypeFromObj(inObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+	break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  /* Set up the workspace with the kernels and their partial sums. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.pad = (pad == ALG_PAD_NONE)? ALG_PAD_ZERO: pad;
+    wSp.padVal = padVal;
+    wSp.iType = iType;
+    wSp.ax[0].h = (direc.vtX)? cBufSz.vtX: -1;
+    wSp.ax[1].h = (direc.vtY)? cBufSz.vtY: -1;
+    wSp.ax[2].h = (direc.vtZ)? cBufSz.vtZ: -1;
+    wSp.ax[0].krn = cBuf[0];
+    wSp.ax[1].krn = cBuf[1];
+    wSp.ax[2].krn = (direc.vtZ)? cBuf[2]: NULL;
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 3); ++idx)
+    {
+      errNum = WlzSepFilterWinAxisInit(wSp.ax + idx);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.bBox = WlzBoundingBox3I(inObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzPixelV	bgdV,
+    		zV;
+    WlzObjectType rGTT;
+
+    zV.type = WLZ_GREY_DOUBLE;
+    zV.v.dbv = 0.0;
+    (void )WlzValueConvertPixel(&bgdV, zV, gType);
+    rGTT = WlzGreyValueTableType(0, WLZ_GREY_TAB_RAGR, gType, NULL);
+    rnObj = WlzNewObjectValues(inObj, rGTT, bgdV, 0, bgdV, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.width = wSp.bBox.xMax - wSp.bBox.xMin + 1;
+    wSp.height = wSp.bBox.yMax - wSp.bBox.yMin + 1;
+    area = (size_t )(wSp.width) * wSp.height;
+    if(inObj->type == WLZ_3D_DOMAINOBJ)
+    {
+      WlzPlaneDomain *pDom;
+
+      pDom = inObj->domain.p;
+      nPln = pDom->lastpl - pDom->plane1 + 1;
+      domains = pDom->domains;
+      iVal = inObj->values.vox->values;
+      rVal = rnObj->values.vox->values;
+      poff = pDom->plane1 - inObj->values.vox->plane1;
+      rpoff = pDom->plane1 - rnObj->values.vox->plane1;
+    }
+    else
+    {
+      wSp.bBox.zMin = wSp.bBox.zMax = 0;
+      domains = &(inObj->domain);
+      iVal = &(inObj->values);
+      rVal = &(rnObj->values);
+      poff = rpoff = 0;
+    }
+    wSp.nWin = 2 * WLZ_MAX(wSp.ax[2].h, 0) + 1;
+    if(((tX.v = AlcMalloc(WlzGreySize(iType) * area)) == NULL) ||
+       ((win.v = AlcMalloc(WlzGreySize(iType) * area * wSp.nWin)) == NULL) ||
+       ((wSp.yS = (int *)AlcMalloc(sizeof(int) * 2 * area)) == NULL) ||
+       ((mask[0] = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) * area)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      wSp.yE = wSp.yS + area;
+      wSp.tX = tX;
+      wSp.win = win;
+    }
+  }
+  /* Find the runs through the planes of each column. */
+  if((errNum == WLZ_ERR_NONE) && (wSp.ax[2].h >= 0))
+  {
+    if(((zOff = (int *)AlcCalloc(area + 1, sizeof(int))) == NULL) ||
+       ((zCur = (int *)AlcMalloc(sizeof(int) * area)) == NULL) ||
+       ((mask[1] = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) * area)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      /* Count the runs of each column, compute offsets to the first run
+       * of each column and then fill in the runs. */
+      errNum = WlzSepFilterWinZRuns(&wSp, domains, nPln, mask, zOff, NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      size_t	i;
+      int	nRun = 0;
+
+      for(i = 0; i < area; ++i)
+      {
+	int	n;
+
+	n = zOff[i];
+	zCur[i] = zOff[i] = nRun;
+	nRun += n;
+      }
+      zOff[area] = nRun;
+      if((zRun = (int *)AlcMalloc(sizeof(int) * 2 *
+                                  WLZ_MAX(nRun, 1))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	errNum = WlzSepFilterWinZRuns(&wSp, domains, nPln, mask, zCur, zRun);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )memcpy(zCur, zOff, sizeof(int) * area);
+    }
+    wSp.zCur = zCur;
+    wSp.zRun = zRun;
+  }
+  /* Slide the window through the planes: each plane is filtered along x
+   * and y into the window and then the output plane which lags it by
+   * the z kernel half size is computed from the window. */
+  for(idp = 0; (errNum == WLZ_ERR_NONE) &&
+               (idp < nPln + WLZ_MAX(wSp.ax[2].h, 0)); ++idp)
+  {
+    int		idz;
+
+    if((idp < nPln) && (domains[idp].core != NULL) &&
+       (domains[idp].core->type != WLZ_EMPTY_DOMAIN))
+    {
+      errNum = WlzSepFilterWinXY(&wSp, domains[idp], iVal[idp + poff],
+                                 idp % wSp.nWin, mask[0], nThr);
+    }
+    idz = idp - WLZ_MAX(wSp.ax[2].h, 0);
+    if((errNum == WLZ_ERR_NONE) && (idz >= 0) &&
+       (domains[idz].core != NULL) &&
+       (domains[idz].core->type != WLZ_EMPTY_DOMAIN))
+    {
+      errNum = WlzSepFilterWinZ(&wSp, domains[idz], rVal[idz + rpoff],
+                                idz, gType, nThr);
+    }
+  }
+  for(idx = 0; idx < 3; ++idx)
+  {
+    AlcFree(wSp.ax[idx].sumL);
+  }
+  AlcFree(tX.v);
+  AlcFree(win.v);
+  AlcFree(wSp.yS);
+  AlcFree(mask[0]);
+  AlcFree(mask[1]);
+  AlcFree(zOff);
+  AlcFree(zCur);
+  AlcFree(zRun);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rnObj);
+    rnObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rnObj);
+}
+
 /*!
 * \return	New filtered object with new values or NULL on error.
 * \ingroup	WlzValuesFilters
@@ -1342,3 +1788,898 @@ static WlzObject		*WlzSepFilterZ(WlzObject *inObj,
   }
   return(rnObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Computes the sums of the leading and trailing kernel
+* 		values, in the same order as AlgConvolveD() computes
+* 		them for padding.
+* \param	ax			Axis with the kernel half size and
+* 					kernel set, a negative half size
+* 					means no filtering on the axis.
+*/
+static WlzErrorNum		WlzSepFilterWinAxisInit(
+				  WlzSepFilterWinAxis *ax)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(ax->h >= 0)
+  {
+    int		k,
+    		j,
+		n;
+
+    n = (2 * ax->h) + 1;
+    if((ax->sumL = (double *)AlcMalloc(sizeof(double) * 2 * (n + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      ax->sumT = ax->sumL + n + 1;
+      ax->sumL[0] = 0.0;
+      for(j = 1; j <= n; ++j)
+      {
+	ax->sumL[j] = ax->sumL[j - 1] + ax->krn[j - 1];
+      }
+      for(j = 0; j <= n; ++j)
+      {
+	double	s = 0.0;
+
+	for(k = j; k < n; ++k)
+	{
+	  s += ax->krn[k];
+	}
+	ax->sumT[j] = s;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Sets a mask covering the bounding box of the object with
+* 		non-zero values for the pixels within the given domain.
+* \param	wSp			Filter workspace.
+* \param	dom			Given 2D domain, may be NULL or empty.
+* \param	mask			Mask to set.
+*/
+static void			WlzSepFilterWinMask(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzUByte *mask)
+{
+  (void )memset(mask, 0, (size_t )(wSp->width) * wSp->height);
+  if((dom.core != NULL) &&
+     ((dom.core->type == WLZ_INTERVALDOMAIN_INTVL) ||
+      (dom.core->type == WLZ_INTERVALDOMAIN_RECT)))
+  {
+    int		ln;
+    WlzIntervalDomain *iDom;
+
+    iDom = dom.i;
+    for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+    {
+      WlzUByte	*row;
+
+      row = mask + (size_t )(ln - wSp->bBox.yMin) * wSp->width -
+            wSp->bBox.xMin;
+      if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+      {
+	(void )memset(row + iDom->kol1, 1, iDom->lastkl - iDom->kol1 + 1);
+      }
+      else if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+      {
+	int	idi;
+	WlzIntervalLine *itvLn;
+
+	itvLn = iDom->intvlines + ln - iDom->line1;
+	for(idi = 0; idi < itvLn->nintvs; ++idi)
+	{
+	  WlzInterval *itv;
+
+	  itv = itvLn->intvs + idi;
+	  (void )memset(row + iDom->kol1 + itv->ileft, 1,
+	                itv->iright - itv->ileft + 1);
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Finds the runs through the planes of each column of the
+* 		bounding box. If the run array is NULL the runs of each
+* 		column are counted, otherwise the first and last plane
+* 		indices of each run are set.
+* \param	wSp			Filter workspace.
+* \param	domains			Plane domains.
+* \param	nPln			Number of planes.
+* \param	mask			Two mask buffers.
+* \param	cur			Run counts of each column if the run
+* 					array is NULL, otherwise the index
+* 					of the next run of each column.
+* \param	run			Run array, may be NULL.
+*/
+static WlzErrorNum		WlzSepFilterWinZRuns(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain *domains,
+				  int nPln,
+				  WlzUByte **mask,
+				  int *cur,
+				  int *run)
+{
+  int		idp;
+  size_t	idc,
+  		area;
+  WlzUByte	*cM,
+  		*pM;
+
+  area = (size_t )(wSp->width) * wSp->height;
+  (void )memset(mask[1], 0, area);
+  for(idp = 0; idp < nPln; ++idp)
+  {
+    cM = mask[idp & 1];
+    pM = mask[(idp & 1) ^ 1];
+    WlzSepFilterWinMask(wSp, domains[idp], cM);
+    for(idc = 0; idc < area; ++idc)
+    {
+      if(cM[idc] != pM[idc])
+      {
+	if(cM[idc])
+	{
+	  if(run)
+	  {
+	    run[2 * cur[idc]] = idp;
+	  }
+	  else
+	  {
+	    ++(cur[idc]);
+	  }
+	}
+	else if(run)
+	{
+	  run[(2 * cur[idc]++) + 1] = idp - 1;
+	}
+      }
+    }
+  }
+  if(run)
+  {
+    cM = mask[(nPln - 1) & 1];
+    for(idc = 0; idc < area; ++idc)
+    {
+      if(cM[idc])
+      {
+	run[(2 * cur[idc]++) + 1] = nPln - 1;
+      }
+    }
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Makes an array of the intervals of a 2D object with the
+* 		position, length and grey value pointer of each.
+* \param	dom			Domain of the object.
+* \param	val			Values of the object.
+* \param	dstItv			Destination pointer for the array
+* 					of intervals, which may be
+* 					reallocated.
+* \param	dstMaxItv		Destination pointer for the number of
+* 					intervals allocated.
+* \param	dstNItv			Destination pointer for the number of
+* 					intervals.
+* \param	dstGType		Destination pointer for the grey type.
+*/
+static WlzErrorNum		WlzSepFilterWinItvs(
+				  WlzDomain dom,
+				  WlzValues val,
+				  WlzSepFilterWinItv **dstItv,
+				  int *dstMaxItv,
+				  int *dstNItv,
+				  WlzGreyType *dstGType)
+{
+  int		nItv = 0;
+  WlzObject	*obj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstGType = gWSp.pixeltype;
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      WlzSepFilterWinItv *itv;
+
+      if(nItv >= *dstMaxItv)
+      {
+	int	maxItv;
+
+	maxItv = (2 * *dstMaxItv) + 1024;
+	if((itv = (WlzSepFilterWinItv *)
+		  AlcRealloc(*dstItv,
+			     sizeof(WlzSepFilterWinItv) * maxItv)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+	*dstItv = itv;
+	*dstMaxItv = maxItv;
+      }
+      itv = *dstItv + nItv++;
+      itv->ln = iWSp.linpos;
+      itv->kl = iWSp.lftpos;
+      itv->len = iWSp.rgtpos - iWSp.lftpos + 1;
+      itv->gP = gWSp.u_grintptr;
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  *dstNItv = nItv;
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Sets or adds a scaled vector of intermediate values to
+* 		a double vector, acc[i] = f * row[i] or
+* 		acc[i] += f * row[i].
+* \param	acc			Double vector.
+* \param	f			Scale factor.
+* \param	row			Intermediate values.
+* \param	iType			Intermediate grey type.
+* \param	add			Add if non-zero, otherwise set.
+* \param	n			Number of values.
+*/
+static void			WlzSepFilterWinMAdd(
+				  double *acc,
+				  double f,
+				  WlzGreyP row,
+				  WlzGreyType iType,
+				  int add,
+				  int n)
+{
+  int		i;
+
+  if(iType == WLZ_GREY_DOUBLE)
+  {
+    if(add)
+    {
+      for(i = 0; i < n; ++i)
+      {
+	acc[i] += f * row.dbp[i];
+      }
+    }
+    else
+    {
+      for(i = 0; i < n; ++i)
+      {
+	acc[i] = f * row.dbp[i];
+      }
+    }
+  }
+  else
+  {
+    if(add)
+    {
+      for(i = 0; i < n; ++i)
+      {
+	acc[i] += f * row.flp[i];
+      }
+    }
+    else
+    {
+      for(i = 0; i < n; ++i)
+      {
+	acc[i] = f * row.flp[i];
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Sets a double vector to a value.
+* \param	acc			Double vector.
+* \param	v			Value.
+* \param	n			Number of values.
+*/
+static void			WlzSepFilterWinSet(
+				  double *acc,
+				  double v,
+				  int n)
+{
+  int		i;
+
+  for(i = 0; i < n; ++i)
+  {
+    acc[i] = v;
+  }
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Convolves n adjacent columns, which all lie within the same
+* 		run [s0, s1] along the filter axis, at position pos.
+* 		For runs at least as long as the kernel the kernel and
+* 		padding terms are summed in the same order as by
+* 		AlgConvolveD() so that the results are identical to it.
+* \param	wSp			Filter workspace.
+* \param	ax			Filter axis.
+* \param	acc			Destination for the n results.
+* \param	prt			Workspace for 3 * n partial sums.
+* \param	row			Intermediate values at pos - h + k for
+* 					k in [0, 2h], only those within the
+* 					run are accessed.
+* \param	n			Number of columns.
+* \param	s0			First position of the run.
+* \param	s1			Last position of the run.
+* \param	pos			Position to convolve at.
+*/
+static void			WlzSepFilterWinCnvSeg(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzSepFilterWinAxis *ax,
+				  double *acc,
+				  double *prt,
+				  WlzGreyP *row,
+				  int n,
+				  int s0,
+				  int s1,
+				  int pos)
+{
+  int		i,
+  		k,
+  		h,
+		nK,
+		len,
+		lo,
+		hi;
+  double	*krn;
+  WlzGreyType	iType;
+  int		padded;
+
+  h = ax->h;
+  nK = (2 * h) + 1;
+  krn = ax->krn;
+  iType = wSp->iType;
+  len = s1 - s0 + 1;
+  i = pos - s0;
+  padded = (wSp->pad == ALG_PAD_END) || (wSp->pad == ALG_PAD_VALUE);
+  if((len >= nK) && (i >= h) && (i < len - h))
+  {
+#if defined ALG_FAST_CODE && defined __AVX2__
+    /* Match the summation order of the AVX2 code in AlgConvolveD(). */
+    int		j,
+    		nK4;
+    double	*p[4];
+
+    nK4 = nK - (nK % 4);
+    p[0] = acc;
+    p[1] = prt;
+    p[2] = prt + n;
+    p[3] = prt + (2 * n);
+    for(j = 0; j < 4; ++j)
+    {
+      WlzSepFilterWinSet(p[j], 0.0, n);
+    }
+    for(k = 0; k < nK4; k += 4)
+    {
+      for(j = 0; j < 4; ++j)
+      {
+        WlzSepFilterWinMAdd(p[j], krn[k + j], row[k + j], iType, 1, n);
+      }
+    }
+    for(j = 0; j < n; ++j)
+    {
+      acc[j] = acc[j] + p[1][j] + p[2][j] + p[3][j];
+    }
+    for(k = nK4; k < nK; ++k)
+    {
+      WlzSepFilterWinMAdd(acc, krn[k], row[k], iType, 1, n);
+    }
+#else
+    WlzSepFilterWinSet(acc, 0.0, n);
+    for(k = 0; k < nK; ++k)
+    {
+      WlzSepFilterWinMAdd(acc, krn[k], row[k], iType, 1, n);
+    }
+#endif
+  }
+  else
+  {
+    /* Near the ends of a run, or a run shorter than the kernel: the
+     * kernel values before the run are summed and applied to the first
+     * value (or padding value), then the kernel is applied within the
+     * run and then the kernel values after the run are applied to the
+     * last value. */
+    lo = WLZ_MAX(0, h - i);
+    hi = WLZ_MIN(nK - 1, h + len - 1 - i);
+    if(padded && (lo > 0))
+    {
+      if(wSp->pad == ALG_PAD_END)
+      {
+        WlzSepFilterWinMAdd(acc, ax->sumL[lo], row[lo], iType, 0, n);
+      }
+      else
+      {
+        WlzSepFilterWinSet(acc, ax->sumL[lo] * wSp->padVal, n);
+      }
+    }
+    else
+    {
+      WlzSepFilterWinSet(acc, 0.0, n);
+    }
+    for(k = lo; k <= hi; ++k)
+    {
+      WlzSepFilterWinMAdd(acc, krn[k], row[k], iType, 1, n);
+    }
+    if(padded && (hi < nK - 1))
+    {
+      if(wSp->pad == ALG_PAD_END)
+      {
+        WlzSepFilterWinMAdd(acc, ax->sumT[hi + 1], row[hi], iType, 1, n);
+      }
+      else
+      {
+	double	t;
+
+	t = ax->sumT[hi + 1] * wSp->padVal;
+	for(k = 0; k < n; ++k)
+	{
+	  acc[k] += t;
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Convolves a contiguous run of values. For runs at least
+* 		as long as the kernel this is done by AlgConvolveD(),
+* 		otherwise as for WlzSepFilterWinCnvSeg().
+* \param	wSp			Filter workspace.
+* \param	ax			Filter axis.
+* \param	dst			Destination for the results.
+* \param	src			Run of values.
+* \param	len			Length of the run.
+*/
+static void			WlzSepFilterWinCnv1D(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzSepFilterWinAxis *ax,
+				  double *dst,
+				  double *src,
+				  int len)
+{
+  int		nK;
+
+  nK = (2 * ax->h) + 1;
+  if(len >= nK)
+  {
+    (void )AlgConvolveD(len, dst, nK, ax->krn, len, src,
+                        wSp->pad, wSp->padVal);
+  }
+  else
+  {
+    int		i,
+    		k,
+		lo,
+		hi,
+		padded;
+    double	d0,
+    		d1;
+
+    padded = (wSp->pad == ALG_PAD_END) || (wSp->pad == ALG_PAD_VALUE);
+    d0 = (wSp->pad == ALG_PAD_END)? src[0]: wSp->padVal;
+    d1 = (wSp->pad == ALG_PAD_END)? src[len - 1]: wSp->padVal;
+    for(i = 0; i < len; ++i)
+    {
+      double	a = 0.0;
+
+      lo = WLZ_MAX(0, ax->h - i);
+      hi = WLZ_MIN(nK - 1, ax->h + len - 1 - i);
+      if(padded && (lo > 0))
+      {
+        a = ax->sumL[lo] * d0;
+      }
+      for(k = lo; k <= hi; ++k)
+      {
+	a += ax->krn[k] * src[i - ax->h + k];
+      }
+      if(padded && (hi < nK - 1))
+      {
+	a += ax->sumT[hi + 1] * d1;
+      }
+      dst[i] = a;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Filters a plane along x and then y, putting the result
+* 		into a slot of the window.
+* \param	wSp			Filter workspace.
+* \param	dom			Domain of the plane.
+* \param	val			Values of the plane.
+* \param	slot			Window slot for the plane.
+* \param	mask			Mask buffer for the plane.
+* \param	nThr			Number of threads.
+*/
+static WlzErrorNum		WlzSepFilterWinXY(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int slot,
+				  WlzUByte *mask,
+				  int nThr)
+{
+  int		idi,
+  		nItv = 0,
+		maxItv = 0;
+  size_t	area,
+  		gSz;
+  WlzGreyType	pType = WLZ_GREY_ERROR;
+  WlzGreyP	xP,
+  		wP;
+  WlzSepFilterWinItv *itv = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  area = (size_t )(wSp->width) * wSp->height;
+  gSz = WlzGreySize(wSp->iType);
+  wP.ubp = wSp->win.ubp + (gSz * area * slot);
+  xP = (wSp->ax[1].h >= 0)? wSp->tX: wP;
+  errNum = WlzSepFilterWinItvs(dom, val, &itv, &maxItv, &nItv, &pType);
+  /* Filter along x (or just copy) each interval into either the x buffer
+   * or, if there's no y filter, the window. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThr)
+#endif
+    {
+      double	*buf;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if((buf = (double *)
+                AlcMalloc(sizeof(double) * 2 * wSp->width)) == NULL)
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for(idi = 0; idi < nItv; ++idi)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  size_t  off;
+	  WlzGreyP bGP,
+	  	   dGP;
+	  WlzSepFilterWinItv *it;
+
+	  it = itv + idi;
+	  bGP.dbp = buf;
+	  WlzValueCopyGreyToGrey(bGP, 0, WLZ_GREY_DOUBLE,
+	                         it->gP, 0, pType, it->len);
+	  if(wSp->ax[0].h >= 0)
+	  {
+	    bGP.dbp = buf + wSp->width;
+	    WlzSepFilterWinCnv1D(wSp, wSp->ax + 0, bGP.dbp, buf, it->len);
+	  }
+	  off = (size_t )(it->ln - wSp->bBox.yMin) * wSp->width +
+	        it->kl - wSp->bBox.xMin;
+	  dGP.ubp = xP.ubp + (gSz * off);
+	  WlzValueCopyGreyToGrey(dGP, 0, wSp->iType,
+	                         bGP, 0, WLZ_GREY_DOUBLE, it->len);
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzSepFilterWinXY)
+#endif
+      {
+	if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(buf);
+    }
+  }
+  /* Find the runs along each column of the plane. */
+  if((errNum == WLZ_ERR_NONE) && (wSp->ax[1].h >= 0))
+  {
+    int		idx;
+
+    WlzSepFilterWinMask(wSp, dom, mask);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+    for(idx = 0; idx < wSp->width; ++idx)
+    {
+      int	idy,
+      		y0 = 0;
+
+      for(idy = 0; idy <= wSp->height; ++idy)
+      {
+	int	in;
+	size_t	idc;
+
+	idc = (size_t )idy * wSp->width + idx;
+	in = (idy < wSp->height) && mask[idc];
+	if(in)
+	{
+	  if((idy == 0) || (mask[idc - wSp->width] == 0))
+	  {
+	    y0 = idy;
+	  }
+	}
+	else if((idy > 0) && mask[idc - wSp->width])
+	{
+	  int	idr;
+
+	  for(idr = y0; idr < idy; ++idr)
+	  {
+	    idc = (size_t )idr * wSp->width + idx;
+	    wSp->yS[idc] = y0;
+	    wSp->yE[idc] = idy - 1;
+	  }
+	}
+      }
+    }
+  }
+  /* Filter each interval along y from the x buffer into the window. */
+  if((errNum == WLZ_ERR_NONE) && (wSp->ax[1].h >= 0))
+  {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThr)
+#endif
+    {
+      int	nK;
+      double	*buf = NULL;
+      WlzGreyP	*row = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      nK = (2 * wSp->ax[1].h) + 1;
+      if(((buf = (double *)
+                 AlcMalloc(sizeof(double) * 4 * wSp->width)) == NULL) ||
+         ((row = (WlzGreyP *)AlcMalloc(sizeof(WlzGreyP) * nK)) == NULL))
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idi = 0; idi < nItv; ++idi)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int	  x0,
+		  x1,
+	  	  y;
+	  size_t  off;
+	  WlzSepFilterWinItv *it;
+
+	  it = itv + idi;
+	  y = it->ln - wSp->bBox.yMin;
+	  x0 = it->kl - wSp->bBox.xMin;
+	  off = (size_t )y * wSp->width;
+	  /* Split the interval into segments of columns which share the
+	   * same run. */
+	  while(x0 < it->kl - wSp->bBox.xMin + it->len)
+	  {
+	    int	    k,
+	    	    s0,
+		    s1;
+	    WlzGreyP dGP,
+	    	     aGP;
+
+	    s0 = wSp->yS[off + x0];
+	    s1 = wSp->yE[off + x0];
+	    x1 = x0 + 1;
+	    while((x1 < it->kl - wSp->bBox.xMin + it->len) &&
+	          (wSp->yS[off + x1] == s0) && (wSp->yE[off + x1] == s1))
+	    {
+	      ++x1;
+	    }
+	    for(k = 0; k < nK; ++k)
+	    {
+	      int	p;
+
+	      p = y - wSp->ax[1].h + k;
+	      row[k].ubp = ((p >= s0) && (p <= s1))?
+	                   wSp->tX.ubp +
+			   (gSz * ((size_t )p * wSp->width + x0)): NULL;
+	    }
+	    WlzSepFilterWinCnvSeg(wSp, wSp->ax + 1, buf, buf + wSp->width,
+	                          row, x1 - x0, s0, s1, y);
+	    aGP.dbp = buf;
+	    dGP.ubp = wP.ubp + (gSz * (off + x0));
+	    WlzValueCopyGreyToGrey(dGP, 0, wSp->iType,
+				   aGP, 0, WLZ_GREY_DOUBLE, x1 - x0);
+	    x0 = x1;
+	  }
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzSepFilterWinXY)
+#endif
+      {
+	if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(buf);
+      AlcFree(row);
+    }
+  }
+  AlcFree(itv);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Computes an output plane by filtering along z through
+* 		the planes of the window (or just copying the plane from
+* 		the window if there's no z filter).
+* \param	wSp			Filter workspace.
+* \param	dom			Domain of the plane.
+* \param	val			Output values of the plane.
+* \param	idz			Index of the plane.
+* \param	gType			Output grey type.
+* \param	nThr			Number of threads.
+*/
+static WlzErrorNum		WlzSepFilterWinZ(
+				  WlzSepFilterWinWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int idz,
+				  WlzGreyType gType,
+				  int nThr)
+{
+  int		idi,
+  		nItv = 0,
+		maxItv = 0;
+  size_t	area,
+  		gSz;
+  WlzGreyType	pType = WLZ_GREY_ERROR;
+  WlzSepFilterWinItv *itv = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  area = (size_t )(wSp->width) * wSp->height;
+  gSz = WlzGreySize(wSp->iType);
+  errNum = WlzSepFilterWinItvs(dom, val, &itv, &maxItv, &nItv, &pType);
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThr)
+#endif
+    {
+      int	h,
+      		nK;
+      double	*buf = NULL;
+      WlzGreyP	*row = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      h = wSp->ax[2].h;
+      nK = (2 * WLZ_MAX(h, 0)) + 1;
+      if(((buf = (double *)
+                 AlcMalloc(sizeof(double) * 4 * wSp->width)) == NULL) ||
+         ((row = (WlzGreyP *)AlcMalloc(sizeof(WlzGreyP) * nK)) == NULL))
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idi = 0; idi < nItv; ++idi)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int	  x0,
+	  	  x1,
+		  xE;
+	  size_t  off;
+	  WlzGreyP aGP;
+	  WlzSepFilterWinItv *it;
+
+	  it = itv + idi;
+	  x0 = it->kl - wSp->bBox.xMin;
+	  xE = x0 + it->len;
+	  off = (size_t )(it->ln - wSp->bBox.yMin) * wSp->width;
+	  aGP.dbp = buf;
+	  if(h < 0)
+	  {
+	    WlzGreyP sGP;
+
+	    sGP.ubp = wSp->win.ubp + (gSz * (area * (idz % wSp->nWin) +
+	                                     off + x0));
+	    WlzValueCopyGreyToGrey(aGP, 0, WLZ_GREY_DOUBLE,
+	    			   sGP, 0, wSp->iType, it->len);
+	    WlzValueCopyGreyToGrey(it->gP, 0, gType,
+	    			   aGP, 0, WLZ_GREY_DOUBLE, it->len);
+	  }
+	  else
+	  {
+	    /* Advance the run index of each column to the run which
+	     * contains this plane. */
+	    for(x1 = x0; x1 < xE; ++x1)
+	    {
+	      int	c;
+
+	      c = wSp->zCur[off + x1];
+	      while(wSp->zRun[(2 * c) + 1] < idz)
+	      {
+		++c;
+	      }
+	      wSp->zCur[off + x1] = c;
+	    }
+	    while(x0 < xE)
+	    {
+	      int	k,
+			s0,
+			s1;
+
+	      s0 = wSp->zRun[2 * wSp->zCur[off + x0]];
+	      s1 = wSp->zRun[(2 * wSp->zCur[off + x0]) + 1];
+	      x1 = x0 + 1;
+	      while((x1 < xE) &&
+		    (wSp->zRun[2 * wSp->zCur[off + x1]] == s0) &&
+		    (wSp->zRun[(2 * wSp->zCur[off + x1]) + 1] == s1))
+	      {
+		++x1;
+	      }
+	      for(k = 0; k < nK; ++k)
+	      {
+		int	p;
+
+		p = idz - h + k;
+		row[k].ubp = ((p >= s0) && (p <= s1))?
+			     wSp->win.ubp +
+			     (gSz * (area * (p % wSp->nWin) + off + x0)): NULL;
+	      }
+	      WlzSepFilterWinCnvSeg(wSp, wSp->ax + 2, buf, buf + wSp->width,
+				    row, x1 - x0, s0, s1, idz);
+	      WlzValueCopyGreyToGrey(it->gP, x0 - (it->kl - wSp->bBox.xMin),
+	      			     gType, aGP, 0, WLZ_GREY_DOUBLE, x1 - x0);
+	      x0 = x1;
+	    }
+	  }
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzSepFilterWinZ)
+#endif
+      {
+	if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(buf);
+      AlcFree(row);
+    }
+  }
+  AlcFree(itv);
+  return(errNum);
+}
@@ -183,6 +183,9 @@ const char	*WlzStringFromObjTypeValue(WlzObjectType objType,
     case WLZ_SPLINE:
       oTypeStr = "WLZ_SPLINE";
       break;
+    case WLZ_IDXMESH:
+      oTypeStr = "WLZ_IDXMESH";
+      break;
     default:
       errNum = WLZ_ERR_OBJECT_TYPE;
       break;
@@ -241,6 +244,7 @@ WlzObjectType	WlzStringToObjType(const char *oTypeStr,
 		"WLZ_3D_VIEW_STRUCT", WLZ_3D_VIEW_STRUCT,
 		"WLZ_POINTS", WLZ_POINTS,
 		"WLZ_SPLINE", WLZ_SPLINE,
+		"WLZ_IDXMESH", WLZ_IDXMESH,
 		NULL))
   {
     oType = (WlzObjectType )tI0;
@@ -468,6 +472,20 @@ const char	*WlzStringFromObjDomainType(WlzObject *obj,
 	    break;
 	}
 	break;
+      case WLZ_IDXMESH:
+        switch(obj->domain.core->type)
+        {
+	  case WLZ_IDXMESH_TRI3D:
+	    oDomTypeStr = "WLZ_IDXMESH_TRI3D";
+            break;
+	  case WLZ_IDXMESH_TET3D:
+	    oDomTypeStr = "WLZ_IDXMESH_TET3D";
+            break;
+	  default:
+	    errNum = WLZ_ERR_DOMAIN_TYPE;
+	    break;
+	}
+	break;
       default:
         errNum = WLZ_ERR_OBJECT_TYPE;
         break;
@@ -526,6 +544,8 @@ WlzObjectType	WlzStringToObjDomainType(const char *oDomTypeStr,
 		"WLZ_POINTS_3D", WLZ_POINTS_3D,
 		"WLZ_BSPLINE_C2D", WLZ_BSPLINE_C2D,
 		"WLZ_BSPLINE_C3D", WLZ_BSPLINE_C3D,
+		"WLZ_IDXMESH_TRI3D", WLZ_IDXMESH_TRI3D,
+		"WLZ_IDXMESH_TET3D", WLZ_IDXMESH_TET3D,
 		NULL))
   {
     oDomType = (WlzObjectType )tI0;
@@ -1134,6 +1154,8 @@ WlzFnType	WlzStringToFnType(const char *tStr,
 		       "WLZ_FN_BASIS_3DCONF_POLY", WLZ_FN_BASIS_3DCONF_POLY,
 		       "WLZ_FN_BASIS_3DMOS", WLZ_FN_BASIS_3DMOS,
 		       "WLZ_FN_BASIS_SCALAR_3DMOS", WLZ_FN_BASIS_SCALAR_3DMOS,
+		       "WLZ_FN_BASIS_2DCS", WLZ_FN_BASIS_2DCS,
+		       "WLZ_FN_BASIS_3DCS", WLZ_FN_BASIS_3DCS,
 		       NULL))
   {
     fn = (WlzFnType )tI0;
@@ -1204,6 +1226,12 @@ const char	*WlzStringFromFnType(WlzFnType fn,
     case WLZ_FN_BASIS_SCALAR_3DMOS:
       tStr = "WLZ_FN_BASIS_SCALAR_3DMOS";
       break;
+    case WLZ_FN_BASIS_2DCS:
+      tStr = "WLZ_FN_BASIS_2DCS";
+      break;
+    case WLZ_FN_BASIS_3DCS:
+      tStr = "WLZ_FN_BASIS_3DCS";
+      break;
     default:
       errNum = WLZ_ERR_PARAM_DATA;
       break;
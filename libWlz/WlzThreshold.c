@@ -42,6 +42,34 @@ static char _WlzThreshold_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzThresholdScanData
+* \ingroup	WlzThreshold
+* \brief	Data passed to the parallel scan callbacks used by
+* 		WlzThreshold().
+*/
+typedef struct _WlzThresholdScanData
+{
+  WlzPixelV		threshV;	/*!< Threshold pixel value. */
+  WlzThresholdType	highlow;	/*!< Threshold mode. */
+  WlzObject		**res;		/*!< Thresholded objects, one for
+  					     each chunk of a 2D object. */
+  WlzPlaneDomain	*npdom;		/*!< New plane domain of a thresholded
+  					     3D object. */
+  WlzVoxelValues	*nvoxtab;	/*!< New voxel value table of a
+  					     thresholded 3D object, NULL if
+					     the values are tiled. */
+} WlzThresholdScanData;
+
+static WlzObject 		*WlzThreshold2DPar(
+				  WlzObject *obj,
+				  WlzPixelV threshV,
+				  WlzThresholdType highlow,
+				  WlzErrorNum *dstErr);
+static WlzIntervalDomain	*WlzThresholdJoinLines(
+				  int nObj,
+				  WlzObject **objs,
+				  WlzErrorNum *dstErr);
 static WlzObject 		*WlzThreshold2D(
 				  WlzObject *obj,
 				  WlzPixelV threshV,
@@ -53,6 +81,12 @@ static WlzObject 		*WlzThreshold3D(
 				  WlzPixelV threshV,
 				  WlzThresholdType highlow,
 				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzThreshold2DScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
+static WlzErrorNum		WlzThreshold3DScanFn(
+				  WlzScanParWSpace *pWSp,
+				  void *data);
 
 /*!
 * \ingroup	WlzThreshold
@@ -415,7 +449,7 @@ WlzObject *WlzThreshold(WlzObject	*obj,
     switch(obj->type)
     {
       case WLZ_2D_DOMAINOBJ:
-	nobj = WlzThreshold2D(obj, threshV, highlow, 0, &errNum);
+	nobj = WlzThreshold2DPar(obj, threshV, highlow, &errNum);
 	break;
       case WLZ_3D_DOMAINOBJ:
 	nobj = WlzThreshold3D(obj, threshV, highlow, &errNum);
@@ -446,6 +480,232 @@ WlzObject *WlzThreshold(WlzObject	*obj,
   return(nobj);
 }
 
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzThreshold
+* \brief	Private function used to threshold 2D domain objects in
+* 		parallel. The object is scanned in chunks of lines using
+* 		WlzScanPar() with each chunk thresholded by WlzThreshold2D().
+* 		Because the chunks cover disjoint ranges of lines the
+* 		intervals of the chunk domains are joined line by line
+* 		to give the thresholded domain.
+* \param	obj			Object to be thresholded.
+* \param	threshV			Threshold pixel value.
+* \param	highlow			Mode parameter, see WlzThreshold().
+* \param	dstErr			Destination pointer for error number,
+*					may be NULL.
+*/
+static WlzObject *WlzThreshold2DPar(WlzObject	*obj,
+				    WlzPixelV	threshV,
+				    WlzThresholdType highlow,
+				    WlzErrorNum	*dstErr)
+{
+  int			idx,
+  			nChk = 0,
+			nRes = 0;
+  WlzObject		*nobj = NULL;
+  WlzScanParChunk	*chk = NULL;
+  WlzThresholdScanData	scan;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  scan.res = NULL;
+  if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else
+  {
+    chk = WlzScanParChunks(obj, 0, &nChk, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((scan.res = (WlzObject **)
+                   AlcCalloc(nChk, sizeof(WlzObject *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    scan.threshV = threshV;
+    scan.highlow = highlow;
+    scan.npdom = NULL;
+    scan.nvoxtab = NULL;
+    errNum = WlzScanPar(obj, chk, nChk, 1, WlzThreshold2DScanFn, &scan);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Keep only the non-empty chunk objects. */
+    for(idx = 0; idx < nChk; ++idx)
+    {
+      WlzObject	*rObj;
+
+      rObj = scan.res[idx];
+      scan.res[idx] = NULL;
+      if((rObj != NULL) && (rObj->type == WLZ_2D_DOMAINOBJ))
+      {
+        scan.res[nRes++] = rObj;
+      }
+      else if(rObj != NULL)
+      {
+        (void )WlzFreeObj(rObj);
+      }
+    }
+    if(nRes == 0)
+    {
+      nobj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      WlzDomain	domain;
+
+      if(nRes == 1)
+      {
+        domain = scan.res[0]->domain;
+      }
+      else
+      {
+        domain.i = WlzThresholdJoinLines(nRes, scan.res, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nobj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, obj->values,
+			   obj->plist, obj, &errNum);
+	if((nobj == NULL) && (nRes > 1))
+	{
+	  (void )WlzFreeIntervalDomain(domain.i);
+	}
+      }
+    }
+  }
+  if(scan.res)
+  {
+    for(idx = 0; idx < nChk; ++idx)
+    {
+      if(scan.res[idx] != NULL)
+      {
+	(void )WlzFreeObj(scan.res[idx]);
+      }
+    }
+    AlcFree(scan.res);
+  }
+  AlcFree(chk);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nobj);
+}
+
+/*!
+* \return	New interval domain or NULL on error.
+* \ingroup	WlzThreshold
+* \brief	Joins the domains of the given 2D domain objects into a
+* 		single interval domain. The objects must be in line order
+* 		and cover disjoint ranges of lines, as do the thresholded
+* 		chunks of WlzThreshold2DPar().
+* \param	nObj			Number of objects, must be > 0.
+* \param	objs			Array of 2D domain objects with
+* 					interval domains.
+* \param	dstErr			Destination pointer for error number.
+*/
+static WlzIntervalDomain *WlzThresholdJoinLines(int nObj, WlzObject **objs,
+					        WlzErrorNum *dstErr)
+{
+  int			idx,
+  			kol1,
+  			lastkl;
+  WlzLong		nItv = 0;
+  WlzInterval		*itvl = NULL;
+  WlzIntervalDomain	*iDom,
+  			*nDom = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  kol1 = objs[0]->domain.i->kol1;
+  lastkl = objs[0]->domain.i->lastkl;
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nObj); ++idx)
+  {
+    iDom = objs[idx]->domain.i;
+    kol1 = ALG_MIN(kol1, iDom->kol1);
+    lastkl = ALG_MAX(lastkl, iDom->lastkl);
+    nItv += WlzIntervalCount(iDom, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((nDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+				     objs[0]->domain.i->line1,
+				     objs[nObj - 1]->domain.i->lastln,
+				     kol1, lastkl, &errNum)) != NULL)
+    {
+      if((itvl = (WlzInterval *)
+                 AlcMalloc(nItv * sizeof(WlzInterval))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	nDom->freeptr = AlcFreeStackPush(nDom->freeptr, (void *)itvl, NULL);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nObj; ++idx)
+    {
+      int		ln,
+      		off;
+
+      iDom = objs[idx]->domain.i;
+      off = iDom->kol1 - kol1;
+      for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+      {
+	int		i;
+	WlzIntervalLine	*iLn;
+
+	iLn = iDom->intvlines + ln - iDom->line1;
+	for(i = 0; i < iLn->nintvs; ++i)
+	{
+	  itvl[i].ileft = iLn->intvs[i].ileft + off;
+	  itvl[i].iright = iLn->intvs[i].iright + off;
+	}
+	(void )WlzMakeInterval(ln, nDom, iLn->nintvs, itvl);
+	itvl += iLn->nintvs;
+      }
+    }
+  }
+  else if(nDom)
+  {
+    (void )WlzFreeIntervalDomain(nDom);
+    nDom = NULL;
+  }
+  *dstErr = errNum;
+  return(nDom);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzThreshold
+* \brief	Parallel scan callback for WlzThreshold2DPar() which
+* 		thresholds the current chunk of lines, keeping the
+* 		thresholded object in the chunk's slot of the scan data.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzThreshold2DScanFn(WlzScanParWSpace *pWSp, void *data)
+{
+  WlzThresholdScanData *scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  scan = (WlzThresholdScanData *)data;
+  scan->res[pWSp->chkIdx] = WlzThreshold2D(pWSp->obj2D, scan->threshV,
+  					   scan->highlow, 0, &errNum);
+  return(errNum);
+}
+
 /*!
 * \return	New Woolz object or NULL on error.
 * \ingroup	WlzThreshold
@@ -924,8 +1184,6 @@ static WlzObject *WlzThreshold3D(WlzObject	*obj,
 				 WlzErrorNum	*dstErr)
 {
   int			i,
-  			p,
-			nplanes,
 			tiled = 0;
   WlzObject		*obj1;
   WlzPlaneDomain	*pdom,
@@ -934,6 +1192,7 @@ static WlzObject *WlzThreshold3D(WlzObject	*obj,
   			*nvoxtab = NULL;
   WlzDomain		domain;
   WlzValues		vals;
+  WlzThresholdScanData	scan;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* Object pointer checked by WlzThreshold(). */
@@ -995,76 +1254,12 @@ static WlzObject *WlzThreshold3D(WlzObject	*obj,
       npdom->voxel_size[i] = pdom->voxel_size[i];
     }
     /* Threshold each plane */
-    nplanes = pdom->lastpl - pdom->plane1 + 1;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(p = 0; p < nplanes; ++p)
-    {
-      if(errNum == WLZ_ERR_NONE)
-      {
-	int		pln;
-  	WlzDomain	*domains,
-			*ndomains;
-  	WlzValues	*values,
-			*nvalues = NULL;
-	WlzObject	*gObj2D = NULL,
-			*tObj2D = NULL;
-	WlzErrorNum 	errNum2 = WLZ_ERR_NONE;
-
-	pln = pdom->plane1 + p;
-	domains = pdom->domains + p;
-	ndomains = npdom->domains + p;
-	(*ndomains).core = NULL;
-	if(tiled == 0)
-	{
-	  nvalues = nvoxtab->values + p;
-	  values = voxtab->values + p;
-	  (*nvalues).core = NULL;
-	}
-	if(((*domains).core != NULL) &&
-	   ((tiled != 0) || ((*values).core != NULL)))
-	{
-	  gObj2D = WlzAssignObject(
-	           WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains,
-		               (tiled)? obj->values: *values,
-			       NULL, NULL, &errNum2), NULL);
-	  if(gObj2D)
-	  {
-	    if(gObj2D->domain.i != NULL)
-	    {
-	      tObj2D = WlzThreshold2D(gObj2D, threshV, highlow, pln,
-	                              &errNum2);
-	      if((tObj2D != NULL) && (tObj2D->type == WLZ_2D_DOMAINOBJ))
-	      {
-		*ndomains = WlzAssignDomain(tObj2D->domain, NULL);
-		if(tiled == 0)
-		{
-		  *nvalues = WlzAssignValues(tObj2D->values, NULL);
-		}
-	      }
-	      (void )WlzFreeObj(tObj2D);
-	    }
-	    (void )WlzFreeObj(gObj2D);
-	  }
-        }
-	if(errNum2 != WLZ_ERR_NONE)
-	{
-
-#ifdef _OPENMP
-#pragma omp critical (WlzThreshold3D)
-	  {
-	    if(errNum == WLZ_ERR_NONE)
-	    {
-	      errNum = errNum2;
-	    }
-	  }
-#else
-	  errNum = errNum2;
-#endif
-	}
-      }
-    }
+    scan.threshV = threshV;
+    scan.highlow = highlow;
+    scan.res = NULL;
+    scan.npdom = npdom;
+    scan.nvoxtab = nvoxtab;
+    errNum = WlzScanPar(obj, NULL, 0, 1, WlzThreshold3DScanFn, &scan);
   }
   /* Standardise the plane domain */
   if(errNum == WLZ_ERR_NONE)
@@ -1099,3 +1294,36 @@ static WlzObject *WlzThreshold3D(WlzObject	*obj,
   }
   return(obj1);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzThreshold
+* \brief	Parallel scan callback for WlzThreshold3D() which
+* 		thresholds the current plane, setting the plane's domain
+* 		and values in the new plane domain and voxel value table.
+* 		Planes which have no thresholded values are left empty.
+* \param	pWSp			Parallel scan workspace.
+* \param	data			Pointer to the scan data.
+*/
+static WlzErrorNum WlzThreshold3DScanFn(WlzScanParWSpace *pWSp, void *data)
+{
+  WlzObject	*tObj2D;
+  WlzThresholdScanData *scan;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  scan = (WlzThresholdScanData *)data;
+  tObj2D = WlzThreshold2D(pWSp->obj2D, scan->threshV, scan->highlow,
+  			  pWSp->plane, &errNum);
+  if((tObj2D != NULL) && (tObj2D->type == WLZ_2D_DOMAINOBJ))
+  {
+    scan->npdom->domains[pWSp->plane - scan->npdom->plane1] =
+        WlzAssignDomain(tObj2D->domain, NULL);
+    if(scan->nvoxtab)
+    {
+      scan->nvoxtab->values[pWSp->plane - scan->nvoxtab->plane1] =
+          WlzAssignValues(tObj2D->values, NULL);
+    }
+  }
+  (void )WlzFreeObj(tObj2D);
+  return(errNum);
+}
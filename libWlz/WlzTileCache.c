@@ -0,0 +1,639 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTileCache_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzTileCache.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A shared least recently used cache through which the
+* 		tiles of tiled value tables may be loaded on demand,
+* 		so that any number of large tiled volumes can be served
+* 		within a fixed memory budget.
+*
+* 		The cache is shared by threads using the named OpenMP
+* 		critical section WlzTileCache. Tiles are read from
+* 		their files using pread(2) outside of this critical
+* 		section, so that tiles which are already cached remain
+* 		available while others are being read and reading does
+* 		not disturb the file offset. A tile which is discarded
+* 		from the cache is not freed until all it's users have
+* 		released it.
+* \ingroup	WlzValuesUtils
+*/
+
+#include <Wlz.h>
+#ifdef HAVE_UNISTD_H
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+static unsigned int		WlzTileCacheKey(
+				  unsigned int id,
+				  size_t idx);
+static unsigned int		WlzTileCacheKeyFn(
+				  AlcLRUCache *lru,
+				  void *entry);
+static int			WlzTileCacheCmpFn(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzTileCacheUnlinkFn(
+				  AlcLRUCache *lru,
+				  void *entry);
+static void			WlzTileCacheEntryFree(
+				  WlzTileCacheEntry *ent);
+
+/*!
+* \return	New tile cache or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Makes a new tile cache which may be shared by any number
+* 		of tiled value tables.
+* \param	maxSz			Budget for the total size of the
+* 					cached tiles in bytes.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTileCache			*WlzMakeTileCache(
+				  size_t maxSz,
+				  WlzErrorNum *dstErr)
+{
+  unsigned int	maxItem;
+  WlzTileCache	*cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(maxSz < 1)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((cache = (WlzTileCache *)
+                   AlcCalloc(1, sizeof(WlzTileCache))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* The number of items only sizes the hash table, the size of the
+     * tiles is what limits the cache. Assume the smallest likely tile
+     * (WLZ_TILEDVALUES_TILE_SIZE unsigned bytes) when setting it. */
+    maxItem = ALG_MAX(maxSz / WLZ_TILEDVALUES_TILE_SIZE, 64);
+    maxItem = ALG_MIN(maxItem, UINT_MAX / 4);
+    cache->maxSz = maxSz;
+    if((cache->lru = AlcLRUCacheNew(maxItem, maxSz,
+                                    WlzTileCacheKeyFn, WlzTileCacheCmpFn,
+				    WlzTileCacheUnlinkFn, NULL)) == NULL)
+    {
+      AlcFree(cache);
+      cache = NULL;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cache);
+}
+
+/*!
+* \return	Given tile cache with incremented link count or NULL
+* 		on error.
+* \ingroup	WlzAllocation
+* \brief	Assigns a tile cache by incrementing it's link count.
+* \param	cache			Given tile cache.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTileCache			*WlzAssignTileCache(
+				  WlzTileCache *cache,
+				  WlzErrorNum *dstErr)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      ++(cache->linkcount);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cache);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Decrements the link count of the given tile cache and
+* 		if it is no longer linked frees it, along with all the
+* 		cached tiles which are not in use.
+* \param	cache			Given tile cache.
+*/
+WlzErrorNum			WlzFreeTileCache(
+				  WlzTileCache *cache)
+{
+  int		unlinked = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      unlinked = WlzUnlink(&(cache->linkcount), &errNum);
+      if(unlinked)
+      {
+	AlcLRUCacheFree(cache->lru, 1);
+      }
+    }
+    if(unlinked)
+    {
+      AlcFree(cache);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the given tiled values to load their tiles on demand
+* 		through the given tile cache from the given file
+* 		descriptor. The tiled values take ownership of the file
+* 		descriptor, which will be closed when the tiled values
+* 		are freed, and of a link to the cache. The tiled values
+* 		must not have tiles, the tiles must be at tileOffset bytes
+* 		from the start of the file and the file must support
+* 		pread(2).
+* \param	tv			Given tiled values.
+* \param	cache			Given tile cache.
+* \param	fd			Given file descriptor opened for
+* 					reading.
+*/
+WlzErrorNum			WlzTiledValuesSetTileCache(
+				  WlzTiledValues *tv,
+				  WlzTileCache *cache,
+				  int fd)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tv == NULL) || (cache == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(fd < 0)
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else if(WlzGreyTableIsTiled(tv->type) != WLZ_GREY_TAB_TILED)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((tv->tiles.v != NULL) || (tv->fd >= 0) ||
+          (tv->cache != NULL) || (tv->original_table.core != NULL))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+    tv->cache = WlzAssignTileCache(cache, NULL);
+    tv->cacheFd = fd;
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      tv->cacheId = ++(cache->lastId);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Removes all the tiles of the given tiled values from
+* 		their cache, closes the file from which they were loaded
+* 		and releases the cache. Tiles which are in use are freed
+* 		when they are released. This is called when tiled values
+* 		which use a cache are freed.
+* \param	tv			Given tiled values.
+*/
+void				WlzTiledValuesClearTileCache(
+				  WlzTiledValues *tv)
+{
+  if(tv && tv->cache)
+  {
+    WlzTileCache *cache;
+
+    cache = tv->cache;
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      AlcLRUCItem *item;
+
+      item = cache->lru->rankHead;
+      while(item)
+      {
+	AlcLRUCItem *nxt;
+	WlzTileCacheEntry *ent;
+
+	nxt = item->rankNxt;
+	ent = (WlzTileCacheEntry *)(item->entry);
+	if(ent->id == tv->cacheId)
+	{
+	  AlcLRUCEntryRemoveWithKey(cache->lru, item->key, ent);
+	}
+	item = nxt;
+      }
+    }
+#ifdef HAVE_UNISTD_H
+    if(tv->cacheFd >= 0)
+    {
+      (void )close(tv->cacheFd);
+    }
+#endif
+    tv->cache = NULL;
+    tv->cacheFd = -1;
+    (void )WlzFreeTileCache(cache);
+  }
+}
+
+/*!
+* \return	Tile cache entry or NULL on error.
+* \ingroup	WlzValuesUtils
+* \brief	Acquires the tile with the given index from the given
+* 		tiled values, which load their tiles through a cache.
+* 		The tile is read from file if it is not already in the
+* 		cache. The tile remains valid, even if it is discarded
+* 		from the cache, until it is released using
+* 		WlzTileCacheRelease().
+* \param	tv			Given tiled values.
+* \param	idx			Index of the tile (ie the value
+* 					given by the tile index table).
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTileCacheEntry		*WlzTileCacheAcquire(
+				  WlzTiledValues *tv,
+				  size_t idx,
+				  WlzErrorNum *dstErr)
+{
+  unsigned int	key;
+  size_t	tBytes = 0;
+  WlzTileCacheEntry tst;
+  WlzTileCacheEntry *ent = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tv == NULL) || (tv->cache == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(idx >= tv->numTiles)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    tst.id = tv->cacheId;
+    tst.idx = idx;
+    key = WlzTileCacheKey(tst.id, idx);
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      if((ent = (WlzTileCacheEntry *)
+                AlcLRUCEntryGetWithKey(tv->cache->lru, key, &tst)) != NULL)
+      {
+        ++(ent->linkcount);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (ent == NULL))
+  {
+    WlzGreyType	gType;
+
+    gType = WlzGreyTableTypeToGreyType(tv->type, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      size_t	eBytes;
+
+      /* An extra element follows the tile since WlzGreyValueGetCon()
+       * may access the element following the last one in a tile. */
+      eBytes = tv->vpe * WlzGreySize(gType);
+      tBytes = tv->tileSz * eBytes;
+      if(((ent = (WlzTileCacheEntry *)
+                 AlcCalloc(1, sizeof(WlzTileCacheEntry))) == NULL) ||
+	 ((ent->tile.v = AlcCalloc(1, tBytes + eBytes)) == NULL))
+      {
+	AlcFree(ent);
+	ent = NULL;
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      ent->id = tst.id;
+      ent->idx = idx;
+      /* The tiles are stored using native byte ordering. */
+#ifdef HAVE_UNISTD_H
+      {
+	size_t	done = 0;
+	off_t	off;
+
+	off = (off_t )(tv->tileOffset) + (off_t )(idx * tBytes);
+	while((errNum == WLZ_ERR_NONE) && (done < tBytes))
+	{
+	  ssize_t n;
+
+	  n = pread(tv->cacheFd, ent->tile.ubp + done, tBytes - done,
+	            off + (off_t )done);
+	  if(n > 0)
+	  {
+	    done += n;
+	  }
+	  else if((n == 0) || (errno != EINTR))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	}
+      }
+#else
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzTileCacheEntry *dup = NULL;
+
+      /* Another thread may have loaded the same tile meanwhile. */
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+      {
+	WlzTileCacheEntry *fnd;
+
+	if((fnd = (WlzTileCacheEntry *)
+		  AlcLRUCEntryGetWithKey(tv->cache->lru, key, &tst)) != NULL)
+	{
+	  ++(fnd->linkcount);
+	  dup = ent;
+	  ent = fnd;
+	}
+	else
+	{
+	  ent->linkcount = 1;
+	  if(AlcLRUCEntryAddWithKey(tv->cache->lru, tBytes, ent, key,
+	                            NULL) != NULL)
+	  {
+	    ++(ent->linkcount);
+	  }
+	}
+      }
+      WlzTileCacheEntryFree(dup);
+    }
+    else
+    {
+      WlzTileCacheEntryFree(ent);
+      ent = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ent);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Releases a tile acquired using WlzTileCacheAcquire().
+* \param	ent			Given tile cache entry, may be NULL.
+*/
+void				WlzTileCacheRelease(
+				  WlzTileCacheEntry *ent)
+{
+  if(ent)
+  {
+    int		unlinked;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzTileCache)
+#endif
+    {
+      unlinked = (--(ent->linkcount) <= 0);
+    }
+    if(unlinked)
+    {
+      WlzTileCacheEntryFree(ent);
+    }
+  }
+}
+
+/*!
+* \return	Pointer to the tile's values or NULL on error.
+* \ingroup	WlzValuesUtils
+* \brief	Pins the tile with the given index using a small array of
+* 		tiles which are held by the caller, most recently used
+* 		first. If the tile is already pinned it is just moved to
+* 		the start of the array, otherwise it is acquired and the
+* 		least recently used tile of the array is released.
+* 		This avoids the cost of acquiring and releasing tiles
+* 		for each value when values are accessed coherently.
+* 		All pinned tiles remain valid until the next call, so a
+* 		caller requiring n tiles at once should have an array of
+* 		at least n pins. The pins should be zeroed before first
+* 		use and released using WlzTileCacheUnpin().
+* \param	tv			Given tiled values.
+* \param	pin			Array of pinned tiles.
+* \param	nPin			Number of pins in the array.
+* \param	idx			Index of the tile.
+*/
+WlzGreyP			WlzTileCachePin(
+				  WlzTiledValues *tv,
+				  WlzTileCacheEntry **pin,
+				  int nPin,
+				  size_t idx)
+{
+  int		idP;
+  WlzGreyP	tP;
+  WlzTileCacheEntry *ent = NULL;
+
+  tP.v = NULL;
+  for(idP = 0; idP < nPin; ++idP)
+  {
+    if(pin[idP] && (pin[idP]->idx == idx) && (pin[idP]->id == tv->cacheId))
+    {
+      ent = pin[idP];
+      break;
+    }
+  }
+  if(ent == NULL)
+  {
+    idP = nPin - 1;
+    if((ent = WlzTileCacheAcquire(tv, idx, NULL)) != NULL)
+    {
+      WlzTileCacheRelease(pin[idP]);
+    }
+  }
+  if(ent)
+  {
+    for(; idP > 0; --idP)
+    {
+      pin[idP] = pin[idP - 1];
+    }
+    pin[0] = ent;
+    tP = ent->tile;
+  }
+  return(tP);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Releases all the tiles pinned using WlzTileCachePin().
+* \param	pin			Array of pinned tiles.
+* \param	nPin			Number of pins in the array.
+*/
+void				WlzTileCacheUnpin(
+				  WlzTileCacheEntry **pin,
+				  int nPin)
+{
+  int		idP;
+
+  for(idP = 0; idP < nPin; ++idP)
+  {
+    WlzTileCacheRelease(pin[idP]);
+    pin[idP] = NULL;
+  }
+}
+
+/*!
+* \return	Hash key.
+* \ingroup	WlzValuesUtils
+* \brief	Computes a hash key from a tiled values identifier and
+* 		a tile index.
+* \param	id			Tiled values identifier.
+* \param	idx			Tile index.
+*/
+static unsigned int		WlzTileCacheKey(
+				  unsigned int id,
+				  size_t idx)
+{
+  unsigned int	key;
+
+  key = (id * 2654435761U) ^ (unsigned int )idx;
+  return(key);
+}
+
+/*!
+* \return	Hash key.
+* \ingroup	WlzValuesUtils
+* \brief	Key function for the least recently used cache.
+* \param	lru			The least recently used cache.
+* \param	entry			Tile cache entry.
+*/
+static unsigned int		WlzTileCacheKeyFn(
+				  AlcLRUCache *lru,
+				  void *entry)
+{
+  WlzTileCacheEntry *ent;
+
+  ent = (WlzTileCacheEntry *)entry;
+  return(WlzTileCacheKey(ent->id, ent->idx));
+}
+
+/*!
+* \return	Zero only if the entries are for the same tile.
+* \ingroup	WlzValuesUtils
+* \brief	Comparison function for the least recently used cache.
+* \param	entry0			First tile cache entry.
+* \param	entry1			Second tile cache entry.
+*/
+static int			WlzTileCacheCmpFn(
+				  const void *entry0,
+				  const void *entry1)
+{
+  int		cmp;
+  const WlzTileCacheEntry *ent0,
+  		*ent1;
+
+  ent0 = (const WlzTileCacheEntry *)entry0;
+  ent1 = (const WlzTileCacheEntry *)entry1;
+  cmp = (ent0->id != ent1->id) || (ent0->idx != ent1->idx);
+  return(cmp);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Unlink function for the least recently used cache, which
+* 		is always called from within the WlzTileCache critical
+* 		section. Removes the cache's link to the entry and frees
+* 		it if it's not in use.
+* \param	lru			The least recently used cache.
+* \param	entry			Tile cache entry.
+*/
+static void			WlzTileCacheUnlinkFn(
+				  AlcLRUCache *lru,
+				  void *entry)
+{
+  WlzTileCacheEntry *ent;
+
+  ent = (WlzTileCacheEntry *)entry;
+  if(--(ent->linkcount) <= 0)
+  {
+    WlzTileCacheEntryFree(ent);
+  }
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Frees a tile cache entry and it's tile.
+* \param	ent			Tile cache entry, may be NULL.
+*/
+static void			WlzTileCacheEntryFree(
+				  WlzTileCacheEntry *ent)
+{
+  if(ent)
+  {
+    AlcFree(ent->tile.v);
+    AlcFree(ent);
+  }
+}
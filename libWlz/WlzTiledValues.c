@@ -53,6 +53,17 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 /* The use of Hilbert order for tiles may need some testing before real use. */
 /* #define WLZ_TILES_USE_HILBERT */
 
+static WlzObject		*WlzMakeTiledValuesObj3DFn(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  int allocTiles,
+				  int setTiles,
+				  WlzGreyType gType,
+				  unsigned int vRank,
+				  unsigned int *vDim,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr);
+
 /*!
 * \return	New tiled values.
 * \ingroup	WlzAllocation
@@ -96,6 +107,7 @@ WlzTiledValues			*WlzMakeTiledValues(
   if(errNum == WLZ_ERR_NONE)
   {
     tVal->fd = -1;
+    tVal->cacheFd = -1;
     tVal->type = WLZ_GREY_TABLE_TYPE(vRank, WLZ_GREY_TAB_TILED, WLZ_GREY_INT);
     tVal->dim = dim;
     tVal->vRank = vRank;
@@ -179,6 +191,10 @@ WlzErrorNum			WlzFreeTiledValues(
 	  }
 #endif /* WLZ_USE_MMAP */
 	}
+	if(tVal->cache)
+	{
+	  WlzTiledValuesClearTileCache(tVal);
+	}
       }
       AlcFree(tVal);
     }
@@ -231,6 +247,9 @@ WlzTiledValues			*WlzNewTiledValues(
       rVal->fd         = gVal->fd;
       rVal->tileOffset = gVal->tileOffset;
       rVal->tiles.v    = gVal->tiles.v;
+      rVal->cache      = gVal->cache;
+      rVal->cacheId    = gVal->cacheId;
+      rVal->cacheFd    = gVal->cacheFd;
       rVal->indices    = gVal->indices;
       rVal->bckgrnd    = bgdV;
       rVal->vRank      = gVal->vRank;
@@ -391,7 +410,8 @@ WlzErrorNum			WlzMakeTiledValuesTiles(
 * 		memory fault. The returned value is a bit mask in which
 * 		WLZ_IOFLAGS_READ will be set iff grey values can be read
 * 		and WLZ_IOFLAGS_WRITE will be set iff the grey values can
-* 		be written to (ie modified).
+* 		be written to (ie modified). Tiled values which load
+* 		their tiles through a tile cache can only be read.
 * \param	tv			The given tiled values.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
@@ -410,6 +430,10 @@ int				WlzTiledValuesMode(
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
+  else if(tv->cache != NULL)
+  {
+    flags = WLZ_IOFLAGS_READ;
+  }
   else
   {
 #ifdef WLZ_USE_MMAP
@@ -552,26 +576,26 @@ void				WlzTiledValueBufferFlush(
     while(kol <= tvb->kl[1])
     {
       int	i,
+		ii,
       		io,
-		itc = 0,
+		itc,
 		rmn;
-      size_t	ii;
 
       ti = kol / tv->tileWidth;
       to = kol % tv->tileWidth;
       io = tvb->lo + to;
+      rmn = tvb->kl[1] - kol + 1;
+      itc = (tv->tileWidth - to) * tv->vpe;
+      if(itc > rmn)
+      {
+	itc = rmn;
+      }
       ii = *(tv->indices + tvb->li + ti);
-      if(ii > 0)
+      if(ii >= 0)
       {
 	size_t	off;
 
-	rmn = tvb->kl[1] - kol + 1;
-	itc = (tv->tileWidth - to) * tv->vpe;
-	off = ((ii * tv->tileSz) + io) * tv->vpe;
-	if(itc > rmn)
-	{
-	  itc = rmn;
-	}
+	off = (((size_t )ii * tv->tileSz) + io) * tv->vpe;
 	switch(tvb->gtype)
 	{
 	  case WLZ_GREY_INT:
@@ -674,6 +698,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
   int		kol;
   int		ti[3],
   		to[3];
+  WlzTileCacheEntry *pin[1] = {NULL};
 
   kol = tvb->kl[0];
   ti[1] = tvb->ln / tv->tileWidth;
@@ -699,6 +724,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       		io,
 		itc,
 		rmn;
+      WlzGreyP	tiles;
 
       ti[0] = kol / tv->tileWidth;
       to[0] = kol % tv->tileWidth;
@@ -711,6 +737,20 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       itc *= tv->vpe;
       io = tvb->lo + to[0];
       ii = *(tv->indices + tvb->li + ti[0]);
+      if(ii < 0)
+      {
+        tiles.v = NULL;
+      }
+      else if(tv->cache)
+      {
+	/* Tiles loaded through a cache are held individually. */
+        tiles = WlzTileCachePin(tv, pin, 1, ii);
+	ii = (tiles.v)? 0: -1;
+      }
+      else
+      {
+        tiles = tv->tiles;
+      }
       switch(tvb->gtype)
       {
 	case WLZ_GREY_INT:
@@ -729,7 +769,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      int *tp;
 
-	      tp = tv->tiles.inp + (ii * tv->tileSz) + io;
+	      tp = tiles.inp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -753,7 +793,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      short *tp;
 
-	      tp = tv->tiles.shp + (ii * tv->tileSz) + io;
+	      tp = tiles.shp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -777,7 +817,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUByte *tp;
 
-	      tp = tv->tiles.ubp + (ii * tv->tileSz) + io;
+	      tp = tiles.ubp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -801,7 +841,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      float *tp;
 
-	      tp = tv->tiles.flp + (ii * tv->tileSz) + io;
+	      tp = tiles.flp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -825,7 +865,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      double *tp;
 
-	      tp = tv->tiles.dbp + (ii * tv->tileSz) + io;
+	      tp = tiles.dbp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -849,7 +889,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	    {
 	      WlzUInt *tp;
 
-	      tp = tv->tiles.rgbp + (ii * tv->tileSz) + io;
+	      tp = tiles.rgbp + (ii * tv->tileSz) + io;
 	      for(i = 0; i < itc; ++i)
 	      {
 		*bp++ = *tp++;
@@ -862,6 +902,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       }
       kol += itc;
     }
+    WlzTileCacheUnpin(pin, 1);
   }
   tvb->valid = 1;
 }
@@ -1124,7 +1165,8 @@ WlzObject  			*WlzMakeTiledValuesObj2D(
 * \param	gObj			Given object known to be valid.
 * \param	tileSz			The required tile size.
 * \param	setTiles		Flag which must be set for the tiles
-* 					to be allocated and their values set.
+* 					values to be set from those of the
+* 					given object.
 * \param	gType			Required grey type for values table.
 * \param	vRank			Rank of the individual values,
 * 					zero for scalar values, one for
@@ -1144,6 +1186,85 @@ WlzObject  			*WlzMakeTiledValuesObj3D(
 				  unsigned int *vDim,
 				  WlzPixelV bgdV,
 				  WlzErrorNum *dstErr)
+{
+  return(WlzMakeTiledValuesObj3DFn(gObj, tileSz, 1, setTiles, gType,
+                                   vRank, vDim, bgdV, dstErr));
+}
+
+/*!
+* \return	New tiled object or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Creates a 3D domain object which has the same domain as the
+* 		given 3D domain object and a tiled value table, as
+* 		WlzMakeTiledValuesObj3D() does, but without allocating
+* 		the tiles.
+*
+* 		The object may be written using WlzWriteObj(), which
+* 		reserves space for the tiles in the file, and the file
+* 		then opened with "r+" and read using WlzReadObj() to give
+* 		an object with its tiles memory mapped to the file. This
+* 		allows a tiled object to be created which is larger than
+* 		the available memory.
+* \param	gObj			Given object known to be valid.
+* \param	tileSz			The required tile size.
+* \param	gType			Required grey type for values table.
+* \param	vRank			Rank of the individual values,
+* 					zero for scalar values, one for
+* 					vector values etc....
+* \param	vDim			Array of size vRank with individual
+* 					value dimensions, not used if vRank
+* 					is zero.
+* \param	bgdV			required background value.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject  			*WlzMakeTiledValuesObj3DNoTiles(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  WlzGreyType gType,
+				  unsigned int vRank,
+				  unsigned int *vDim,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr)
+{
+  return(WlzMakeTiledValuesObj3DFn(gObj, tileSz, 0, 0, gType,
+                                   vRank, vDim, bgdV, dstErr));
+}
+
+/*!
+* \return	New tiled object or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Creates a 3D domain object which has the same domain as the
+* 		given 3D domain object but a tiled value table, for
+* 		WlzMakeTiledValuesObj3D() and
+* 		WlzMakeTiledValuesObj3DNoTiles().
+* \param	gObj			Given object known to be valid.
+* \param	tileSz			The required tile size.
+* \param	allocTiles		Flag which must be set for the tiles
+* 					to be allocated.
+* \param	setTiles		Flag which must be set for the tiles
+* 					values to be set from those of the
+* 					given object, only used if the tiles
+* 					are allocated.
+* \param	gType			Required grey type for values table.
+* \param	vRank			Rank of the individual values,
+* 					zero for scalar values, one for
+* 					vector values etc....
+* \param	vDim			Array of size vRank with individual
+* 					value dimensions, not used if vRank
+* 					is zero.
+* \param	bgdV			required background value.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzMakeTiledValuesObj3DFn(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  int allocTiles,
+				  int setTiles,
+				  WlzGreyType gType,
+				  unsigned int vRank,
+				  unsigned int *vDim,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr)
 {
   size_t	width;
   WlzObject	*tObj = NULL;
@@ -1322,10 +1443,18 @@ WlzObject  			*WlzMakeTiledValuesObj3D(
     }
     (void )WlzFreeObj(idx);
   }
-  /* Allocate tiles if the given object has values. */
+  /* Allocate the tiles unless they are to be mapped from a file later. */
   if(errNum == WLZ_ERR_NONE)
   {
-    errNum = WlzMakeTiledValuesTiles(tVal);
+    if(allocTiles)
+    {
+      errNum = WlzMakeTiledValuesTiles(tVal);
+    }
+    else
+    {
+      tVal->fd = -1;
+      tVal->tiles.v = NULL;
+    }
   }
   /* Make the object. */
   if(errNum == WLZ_ERR_NONE)
@@ -1336,7 +1465,7 @@ WlzObject  			*WlzMakeTiledValuesObj3D(
     tObj = WlzMakeMain(gObj->type, gObj->domain, val, NULL, NULL, &errNum);
   }
   /* Copy the values to the object with the tiles values. */
-  if((errNum == WLZ_ERR_NONE) && (setTiles != 0) &&
+  if((errNum == WLZ_ERR_NONE) && allocTiles && (setTiles != 0) &&
      (gObj->values.core != NULL))
   {
     errNum = WlzCopyObjectGreyValues(tObj, gObj);
@@ -1438,7 +1567,7 @@ void				WlzTiledValuesCopyLine(
       ti.vtX = kl / tv->tileWidth;
       io = tyo + to.vtX;
       ii = tyi + ti.vtX;
-      cnt = tv->tileWidth - to.vtX;
+      cnt = ALG_MIN(tv->tileWidth - to.vtX, lkl - kl + 1);
       if((ii >= 0) && (ii < tv->numTiles))
       {
 	size_t	off;
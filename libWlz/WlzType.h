@@ -228,6 +228,9 @@ typedef enum _WlzObjectType
   					     elements in 3D. */
   WLZ_CMESH_2D5			= 18,   /*!< Constrained mesh with triangular
   					     elements in 3D. */
+  WLZ_IDXMESH			= 19,	/*!< Compact indexed mesh with
+  					     triangular or tetrahedral
+					     elements. */
   WLZ_RECTANGLE			= 20,	/*!< Rectangle. */
   WLZ_POINTS			= 21,   /*!< Points. */
   WLZ_SPLINE			= 30,	/*!< Splines. */
@@ -428,6 +431,12 @@ typedef enum _WlzObjectType
   					     value table. */
   WLZ_VOXELVALUETABLE_GREY	= 1,	/*!< Grey value voxel value table. */
   WLZ_VOXELVALUETABLE_CONV_HULL,	/*!< Convex hull voxel value table. */
+  WLZ_VOXELVALUETABLE_CHUNKED,		/*!< Grey value voxel value table
+  					     written as independently
+					     compressed chunks. This is only
+					     used as a file encoding, once
+					     read the table is a
+					     WLZ_VOXELVALUETABLE_GREY. */
   /**********************************************************************
   * Polygon domain types.					
   **********************************************************************/
@@ -495,6 +504,13 @@ typedef enum _WlzObjectType
   WLZ_BSPLINE_C2D              = 30,  /*!< 2D B-spline line curve domains. */
   WLZ_BSPLINE_C3D              = 31,  /*!< 3D B-spline line curve domains. */
   /**********************************************************************
+  * Indexed mesh domain types.
+  **********************************************************************/
+  WLZ_IDXMESH_TRI3D		= 40,	/*!< Indexed mesh with triangular
+  					     elements in 3D. */
+  WLZ_IDXMESH_TET3D		= 41,	/*!< Indexed mesh with tetrahedral
+  					     elements in 3D. */
+  /**********************************************************************
   * WLZ_DUMMY_ENTRY is not an object type.			
   * Keep it the last enumerator!				
   **********************************************************************/
@@ -502,6 +518,20 @@ typedef enum _WlzObjectType
   					     Keep it the last enumerator! */
 } WlzObjectType;
 
+/*!
+* \enum		_WlzChunkCodec
+* \ingroup	WlzIO
+* \brief	Compression used for the chunks of a chunked voxel value
+* 		table (see WLZ_VOXELVALUETABLE_CHUNKED).
+*		Typedef: ::WlzChunkCodec.
+*/
+typedef enum _WlzChunkCodec
+{
+  WLZ_CHUNK_CODEC_NONE		= 0,	/*!< Chunks are not compressed. */
+  WLZ_CHUNK_CODEC_ZLIB		= 1,	/*!< Chunks compressed using zlib. */
+  WLZ_CHUNK_CODEC_BZIP2		= 2	/*!< Chunks compressed using bzip2. */
+} WlzChunkCodec;
+
 
 /*! 
 * \enum		_WlzEMAPPropertyType
@@ -880,6 +910,20 @@ typedef enum _WlzBinaryOperatorType
   WLZ_BO_MAGNITUDE
 } WlzBinaryOperatorType;
 
+/*!
+* \enum		_WlzSIMDType
+* \ingroup	WlzValuesUtils
+* \brief	SIMD instruction sets which may be used by the value
+*		kernels, in order of increasing capability.
+*		Typedef: ::WlzSIMDType.
+*/
+typedef enum _WlzSIMDType
+{
+  WLZ_SIMD_NONE		= 0,		/*!< Scalar code only. */
+  WLZ_SIMD_SSE2,			/*!< SSE2 128 bit vectors. */
+  WLZ_SIMD_AVX2				/*!< AVX2 256 bit vectors. */
+} WlzSIMDType;
+
 /*!
 * \enum 	_WlzCompThreshType
 * \ingroup	WlzThreshold
@@ -940,7 +984,9 @@ typedef enum _WlzInterpolationType
 					     each interpolated value. */
   WLZ_INTERPOLATION_ORDER_2,		/*!< Second order interpolation. */
   WLZ_INTERPOLATION_BARYCENTRIC,	/*!< Barycentric mesh interpolation. */
-  WLZ_INTERPOLATION_KRIG 	        /*!< Kriging mesh interpolation. */
+  WLZ_INTERPOLATION_KRIG, 	        /*!< Kriging mesh interpolation. */
+  WLZ_INTERPOLATION_CUBIC		/*!< Cubic or tri-cubic convolution
+  					     (Catmull-Rom). */
 } WlzInterpolationType;
 
 /*!
@@ -2549,6 +2595,7 @@ typedef union _WlzDomain
   struct _WlzConvHullDomain3 *cvh3;
   struct _WlzThreeDViewStruct *vs3d;
   struct _WlzBSpline          *bs;
+  struct _WlzIdxMesh          *idm;
 } WlzDomain;
 
 /*!
@@ -2925,6 +2972,48 @@ typedef struct _WlzDynItvPool
   					     available interval. */
 } WlzDynItvPool;
 
+/*!
+* \struct	_WlzDomainIndex
+* \ingroup	WlzType
+* \brief	A spatial index over a collection of 2D or 3D spatial
+* 		domains for answering which of the domains intersect, or
+* 		are within some distance of, a given domain. The index
+* 		is a uniform grid of square or cubic cells, each of which
+* 		has the indices of the domains with bounding boxes that
+* 		intersect it. For each domain the area or volume and the
+* 		tight bounding box of each plane are kept so that
+* 		candidate domains can be rejected before their intervals
+* 		are examined.
+* 		See WlzMakeDomainIndex().
+* 		Typedef: ::WlzDomainIndex.
+*/
+typedef struct _WlzDomainIndex
+{
+  int		dim;			/*!< Dimension of the domains, 2 or 3,
+  					     or zero if all are empty. */
+  int		nDom;			/*!< Number of domains. */
+  WlzObject	**dom;			/*!< Array of the nDom domain objects
+  					     with NULL for empty domains. */
+  WlzLong	*vol;			/*!< Area or volume of each domain. */
+  WlzIBox3	*box;			/*!< Tight bounding box of each
+  					     domain, undefined for empty
+					     domains. */
+  int		*plnOff;		/*!< Offset into plnBox of the first
+  					     plane box of each domain. */
+  WlzIBox2	*plnBox;		/*!< Tight bounding box of each plane
+  					     of each domain from box[i].zMin
+					     to box[i].zMax, an empty plane
+					     has xMin > xMax. For 2D domains
+					     there is a single plane. */
+  int		cellSz;			/*!< Side length of the cells. */
+  WlzIVertex3	org;			/*!< Position of the first cell. */
+  WlzIVertex3	nCells;			/*!< Number of cells along each axis. */
+  int		*cellOff;		/*!< Offset into cellDom of the domain
+  					     indices of each cell, with
+					     an additional final offset. */
+  int		*cellDom;		/*!< Domain indices of all cells. */
+} WlzDomainIndex;
+
 /*!
 * \struct       _WlzPartialItv2D
 * \ingroup      DomainOps
@@ -3217,6 +3306,12 @@ typedef struct _WlzIndexedValues
 * 		memory in which case the file descriptor will have a
 * 		non-negative value. This can be used to close the file.
 *
+* 		The tile data may also be neither memory mapped nor read
+* 		into memory but loaded on demand through a (shared) tile
+* 		cache, in which case the tiles pointer is NULL and the
+* 		values are read only. Individual tiles are then accessed
+* 		using WlzTileCacheAcquire() or WlzTileCachePin().
+*
 * 		A memory mapped tiled values object can only have it's
 * 		grey values changed if the file was opened for writing
 * 		attempting to change the grey values of an object only
@@ -3290,8 +3385,56 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+  struct _WlzTileCache *cache;		/*!< Cache through which the tiles
+  					     are loaded on demand, NULL unless
+					     the tiles are neither memory
+					     mapped nor read into memory. */
+  unsigned int	cacheId;		/*!< Identifier for these tiles
+  					     within the cache. */
+  int		cacheFd;		/*!< File descriptor from which the
+  					     tiles are loaded into the cache
+					     else -1. */
 } WlzTiledValues;
 
+/*!
+* \struct	_WlzTileCache
+* \ingroup	WlzType
+* \brief	A least recently used cache of tiles which may be shared
+* 		by any number of tiled value tables and threads. The
+* 		total size of the cached tiles is kept within a budget
+* 		by discarding the least recently used tiles, but a tile
+* 		is not freed until all users have released it.
+* 		Typedef: ::WlzTileCache.
+*/
+typedef struct _WlzTileCache
+{
+  int		linkcount;		/*!< Link count. */
+  unsigned int	lastId;			/*!< Last identifier given to a tiled
+  					     value table using the cache. */
+  size_t	maxSz;			/*!< Budget for the total size of
+  					     the cached tiles in bytes. */
+  struct _AlcLRUCache *lru;		/*!< The least recently used cache
+  					     of tile entries. */
+} WlzTileCache;
+
+/*!
+* \struct	_WlzTileCacheEntry
+* \ingroup	WlzType
+* \brief	A single tile within a ::WlzTileCache.
+* 		Typedef: ::WlzTileCacheEntry.
+*/
+typedef struct _WlzTileCacheEntry
+{
+  int		linkcount;		/*!< Link count, with a link for
+  					     the cache while the entry is in
+					     the cache and one for each user
+					     of the tile. */
+  unsigned int	id;			/*!< Identifier of the tiled values
+  					     within the cache. */
+  size_t	idx;			/*!< Index of the tile. */
+  WlzGreyP	tile;			/*!< The tile's values. */
+} WlzTileCacheEntry;
+
 /*!
 * \def		WLZ_TILEDVALUES_TILE_SIZE
 * \ingroup	WlzType
@@ -3376,6 +3519,42 @@ typedef struct _WlzPoints
   WlzVertexP	points;			/*!< Array of point vertices. */
 } WlzPoints;
 
+/************************************************************************
+* Indexed mesh domains.
+************************************************************************/
+/*!
+* \struct	_WlzIdxMesh
+* \ingroup	WlzMesh
+* \brief	A compact indexed mesh with either triangular or tetrahedral
+*		elements in 3D. Unlike the geometric model (WlzGMModel) or
+*		the constrained meshes there is no topology, just a flat
+*		array of vertex positions and a flat array of element
+*		vertex indices. The vertex positions are stored as
+*		consecutive {x, y, z} triples and the vertices of element
+*		i are at indices [i * nElmVtx, (i + 1) * nElmVtx - 1] of
+*		the element array. Triangle vertices are ordered
+*		counter-clockwise when viewed from the +ve side.
+*		Possible types are: WLZ_IDXMESH_TRI3D and WLZ_IDXMESH_TET3D.
+*		Typedef: ::WlzIdxMesh.
+*/
+typedef struct _WlzIdxMesh
+{
+  WlzObjectType type;			/*!< From WlzCoreDomain. */
+  int		linkcount;		/*!< From WlzCoreDomain. */
+  void		*freeptr;		/*!< From WlzCoreDomain. */
+  int		nElmVtx;		/*!< Number of vertices per element,
+  					     3 for triangles and 4 for
+					     tetrahedra. */
+  int		nVtx;			/*!< Number of vertices. */
+  int		maxVtx;			/*!< Number of vertices for which
+  					     space has been allocated. */
+  int		nElm;			/*!< Number of elements. */
+  int		maxElm;			/*!< Number of elements for which
+  					     space has been allocated. */
+  double	*vtx;			/*!< Vertex positions. */
+  int		*elm;			/*!< Element vertex indices. */
+} WlzIdxMesh;
+
 
 /************************************************************************
 * Spline domains.
@@ -3712,7 +3891,99 @@ typedef struct _WlzRsvFilter
   double		b[2];		/*!< Feed back coefficients. */
   double		c;		/*!< Normalization parameter. */
 } WlzRsvFilter;
- 
+
+/************************************************************************
+* Grey value pipelines.
+************************************************************************/
+/*!
+* \enum		_WlzGreyPipeStageType
+* \ingroup	WlzArithmetic
+* \brief	The types of stage in a grey value pipeline.
+*		Typedef: ::WlzGreyPipeStageType.
+*/
+typedef enum _WlzGreyPipeStageType
+{
+  WLZ_GREYPIPE_STAGE_SCALAR	= 0,	/*!< Scalar binary operator. */
+  WLZ_GREYPIPE_STAGE_LUT,		/*!< Look up table transform. */
+  WLZ_GREYPIPE_STAGE_RANGE,		/*!< Linear grey range mapping. */
+  WLZ_GREYPIPE_STAGE_THRESHOLD,		/*!< Rejects values which fail a
+  					     threshold. */
+  WLZ_GREYPIPE_STAGE_MASK		/*!< Rejects values outside the
+  					     domain of a mask object. */
+} WlzGreyPipeStageType;
+
+/*!
+* \enum		_WlzGreyPipeReduceFlags
+* \ingroup	WlzArithmetic
+* \brief	Reductions which may be computed from the output of a
+* 		grey value pipeline. These values are bit masks which
+* 		may be combined.
+*		Typedef: ::WlzGreyPipeReduceFlags.
+*/
+typedef enum _WlzGreyPipeReduceFlags
+{
+  WLZ_GREYPIPE_REDUCE_NONE	= (0),	/*!< No reduction. */
+  WLZ_GREYPIPE_REDUCE_STATS	= (1<<0), /*!< Grey value statistics. */
+  WLZ_GREYPIPE_REDUCE_HISTOGRAM	= (1<<1)  /*!< Grey value histogram. */
+} WlzGreyPipeReduceFlags;
+
+/*!
+* \struct	_WlzGreyPipeStage
+* \ingroup	WlzArithmetic
+* \brief	A single stage of a grey value pipeline.
+*		Typedef: ::WlzGreyPipeStage.
+*/
+typedef struct _WlzGreyPipeStage
+{
+  WlzGreyPipeStageType type;		/*!< Type of stage. */
+  WlzGreyType	gType;			/*!< Grey type of the values after
+  					     the stage, WLZ_GREY_ERROR if
+					     the grey type is unchanged. */
+  WlzBinaryOperatorType op;		/*!< Operator of a scalar stage. */
+  WlzThresholdType thrType;		/*!< Type of a threshold stage. */
+  double	val[4];			/*!< Scalar operand or threshold
+  					     value in val[0], or the source
+					     and destination ranges
+					     {min, max, newMin, newMax} of
+					     a range stage. */
+  double	outV;			/*!< Value given to values rejected
+  					     by a threshold or mask stage. */
+  WlzObject	*obj;			/*!< LUT object of a LUT stage or
+  					     mask object of a mask stage. */
+} WlzGreyPipeStage;
+
+/*!
+* \struct	_WlzGreyPipe
+* \ingroup	WlzArithmetic
+* \brief	A grey value pipeline, in which a chain of pointwise
+* 		stages is applied to the values of an object in a single
+* 		pass, with an optional reduction of the output values.
+* 		The reduction results are those of the last run of the
+* 		pipeline and only include values not rejected by any
+* 		threshold or mask stage.
+*		Typedef: ::WlzGreyPipe.
+*/
+typedef struct _WlzGreyPipe
+{
+  int		nStages;		/*!< Number of stages. */
+  int		maxStages;		/*!< Number of stages for which
+  					     space has been allocated. */
+  WlzGreyPipeStage *stages;		/*!< Array of stages. */
+  unsigned int	reduce;			/*!< Bitwise or of reduction flags
+  					     (::WlzGreyPipeReduceFlags). */
+  int		histNBins;		/*!< Number of histogram bins. */
+  double	histOrigin;		/*!< Lowest value of the histogram. */
+  double	histBinSize;		/*!< Histogram bin size. */
+  WlzLong	area;			/*!< Number of values not rejected. */
+  double	min;			/*!< Minimum value. */
+  double	max;			/*!< Maximum value. */
+  double	sum;			/*!< Sum of values. */
+  double	sumSq;			/*!< Sum of squared values. */
+  double	mean;			/*!< Mean value. */
+  double	stdDev;			/*!< Standard deviation of values. */
+  WlzObject	*hist;			/*!< Histogram object. */
+} WlzGreyPipe;
+
 /************************************************************************
 * Conforming mesh data structures.
 ************************************************************************/
@@ -4506,6 +4777,10 @@ typedef enum _WlzFnType
   WLZ_FN_SCALAR_SQRT,		        /*!< Square root (x^-1/2). */
   WLZ_FN_SCALAR_INVSQRT,		/*!< Inverse square root (x^-1/2). */
   WLZ_FN_SCALAR_SQR,			/*!< Square (x * x). */
+  WLZ_FN_BASIS_2DCS,			/*!< 2D Compactly supported (Wendland)
+  					     radial basis function. */
+  WLZ_FN_BASIS_3DCS,			/*!< 3D Compactly supported (Wendland)
+  					     radial basis function. */
   WLZ_FN_COUNT				/*!< Not a function but the number
   					     of functions. Keep this the
 					     last of the enums! */
@@ -4610,6 +4885,13 @@ typedef struct _WlzBasisFn
 					     Athough the number of control
 					     points may vary the number of
 					     mesh nodes must remain constant. */
+  double	evalTol;		/*!< Absolute error bound used by the
+  					     batch evaluation functions. If
+					     zero the basis function is
+					     evaluated exactly, otherwise a
+					     hierarchical approximation may
+					     be used for TPS, MQ and IMQ
+					     basis functions. */
 } WlzBasisFn;
 
 /*!
@@ -4908,7 +5190,10 @@ typedef struct _WlzMeshTransform2D5
 * \typedef	WlzRegICPUsrWgtFn
 * \ingroup	WlzTransform
 * \brief	A pointer to a function called for user code weighting
-*		of the matched vertices.
+*		of the matched vertices. The function may be called
+*		concurrently from several threads so it must not modify
+*		shared data and its result should depend only on its
+*		arguments.
 */
 typedef double	(*WlzRegICPUsrWgtFn)(WlzVertexType,
 			     WlzAffineTransform *,
@@ -4916,6 +5201,56 @@ typedef double	(*WlzRegICPUsrWgtFn)(WlzVertexType,
 			     WlzVertexP, WlzVertexP, WlzVertex, WlzVertex,
 			     double, double, void *);
 
+/*!
+* \struct	_WlzRegICPItrStats
+* \ingroup	WlzTransform
+* \brief	Statistics for a single iteration of ICP registration.
+*		Typedef: ::WlzRegICPItrStats.
+*/
+typedef struct _WlzRegICPItrStats
+{
+  int		level;		/*!< Multi-resolution level, with level
+  				     zero using all source vertices. */
+  int		nMatch;		/*!< Number of source vertices matched. */
+  double	metric;		/*!< Registration metric. */
+  double	tCor;		/*!< Time (seconds) for the transformation
+  				     of the source vertices and the
+				     correspondence search. */
+  double	tWgt;		/*!< Time (seconds) for weighting the
+  				     matches and computing the metric. */
+  double	tTr;		/*!< Time (seconds) for computing the
+  				     affine transform update. */
+} WlzRegICPItrStats;
+
+/*!
+* \struct	_WlzRegICPCtl
+* \ingroup	WlzTransform
+* \brief	Optional control parameters and statistics for ICP
+* 		registration.
+*		Typedef: ::WlzRegICPCtl.
+*/
+typedef struct _WlzRegICPCtl
+{
+  int		nLevels;	/*!< Number of multi-resolution levels. If
+  				     greater than one then the initial rigid
+				     body registration starts using every
+				     \f$2^{nLevels - 1}\f$'th source vertex
+				     and halves the step on convergence
+				     until all vertices are used. */
+  int		maxStats;	/*!< Number of entries in stats. */
+  int		nStats;		/*!< Number of iterations, which may be
+  				     greater than maxStats in which case
+				     only the first maxStats have their
+				     statistics set. This is not reset by
+				     the registration functions. */
+  WlzRegICPItrStats *stats;	/*!< Caller supplied array for per
+  				     iteration statistics, may be NULL. */
+  AlcKDTFlatTree *fTree;	/*!< Optional flat kD-tree built from the
+  				     target vertices (in the same order)
+				     which if non-NULL is used for the
+				     correspondence search. */
+} WlzRegICPCtl;
+
 /*!
 * \typedef	WlzMatchICPWeightCbData
 * \ingroup	WlzTransform
@@ -5112,6 +5447,74 @@ typedef struct _WlzIterateWSpace
 					     is WLZ_GREY_ERROR. */
 } WlzIterateWSpace;
 
+/*!
+* \struct	_WlzScanParChunk
+* \ingroup	WlzAccess
+* \brief	A chunk of a 2D or 3D domain object for partitioned (parallel)
+* 		scanning. A chunk of a 3D object is a contiguous range of
+* 		planes, while a chunk of a 2D object is a contiguous range
+* 		of lines. Chunks are balanced using interval counts.
+*		Typedef: ::WlzScanParChunk.
+*/
+typedef struct _WlzScanParChunk
+{
+  int		idx;			/*!< Index of the chunk. */
+  int		plane1;			/*!< First plane of the chunk, zero
+  					     for 2D objects. */
+  int		lastpl;			/*!< Last plane of the chunk, zero
+  					     for 2D objects. */
+  int		line1;			/*!< First line of the chunk, only
+  					     used for 2D objects. */
+  int		lastln;			/*!< Last line of the chunk, only
+  					     used for 2D objects. */
+  WlzLong	nItv;			/*!< Number of intervals in the
+  					     chunk. */
+} WlzScanParChunk;
+
+/*!
+* \struct	_WlzScanParWSpace
+* \ingroup	WlzAccess
+* \brief	Per-thread workspace for partitioned (parallel) scanning
+* 		which is passed to a ::WlzScanParFn callback function.
+* 		The interval (and if required grey) workspace has been
+* 		initialised for the 2D object of the current piece of
+* 		the chunk.
+*		Typedef: ::WlzScanParWSpace.
+*/
+typedef struct _WlzScanParWSpace
+{
+  WlzObject	*obj;			/*!< The object being scanned. */
+  WlzObject	*obj2D;			/*!< 2D object for the current plane
+  					     or range of lines. */
+  WlzIntervalWSpace iWSp;		/*!< Interval workspace for the current
+  					     2D object. */
+  WlzGreyWSpace gWSp;			/*!< Grey workspace for the current
+  					     2D object, only valid if grey
+					     is non-zero. */
+  int		grey;			/*!< Non-zero if initialised for
+  					     grey values. */
+  int		thrId;			/*!< Index of the thread running
+  					     the callback. */
+  int		chkIdx;			/*!< Index of the current chunk. */
+  int		plane;			/*!< Current plane, zero for 2D
+  					     objects. */
+} WlzScanParWSpace;
+
+#ifndef WLZ_EXT_BIND
+/*!
+* \typedef	WlzScanParFn
+* \ingroup	WlzAccess
+* \brief	Callback function for WlzScanPar() which is called once
+* 		for each plane (or for 2D objects once for each chunk) with
+* 		the workspace initialised. The callback should scan the
+* 		intervals using WlzNextInterval() or WlzNextGreyInterval()
+* 		and may return WLZ_ERR_EOO when the end of the intervals is
+* 		reached.
+*		Parameters passed are: workspace, callback data.
+*/
+typedef WlzErrorNum (*WlzScanParFn)(WlzScanParWSpace *, void *);
+#endif
+
 /*!
 * \struct	_WlzGreyValueWSpace
 * \ingroup	WlzAccess
@@ -5153,6 +5556,11 @@ typedef struct _WlzGreyValueWSpace
 					     which values are background.
 					     Value is 0 if there are no
 					     background values. */
+  struct _WlzTileCacheEntry *tPin[8];	/*!< Tiles pinned by the work space
+  					     for the grey pointers when
+					     tiled values are loaded through
+					     a tile cache, most recently used
+					     first. */
 } WlzGreyValueWSpace;
 
 /************************************************************************
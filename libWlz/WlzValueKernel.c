@@ -0,0 +1,2670 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzValueKernel_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzValueKernel.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Vectorised kernels for setting, converting, clamping and
+* 		doing arithmetic on buffers of grey values. The kernels
+* 		are chosen at run time from scalar, SSE2 and AVX2
+* 		versions using the capabilities of the CPU, so a
+* 		library built without any SIMD compiler flags will
+* 		still use AVX2 where it is available. All versions of
+* 		a kernel give identical results. The kernels are
+* 		single threaded since they are called per interval;
+* 		threading is left to the object level code.
+* 		The packed RGBA kernels work on all four channels of
+* 		the values at once, so the RGBA arithmetic operators
+* 		need not split their values into channel objects.
+* \ingroup	WlzValuesUtils
+*/
+
+#include <float.h>
+#include <limits.h>
+#include <Wlz.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WLZ_VALUE_KRN_X86
+#include <immintrin.h>
+#define WLZ_VALUE_KRN_SSE2 __attribute__((target("sse2")))
+#define WLZ_VALUE_KRN_AVX2 __attribute__((target("avx2")))
+#endif
+
+/*!
+* \struct	_WlzValueKrnTab
+* \ingroup	WlzValuesUtils
+* \brief	Table of kernel functions for a SIMD instruction set.
+* 		The binary operator kernels all compute dst = src op dst,
+* 		other than the packed RGBA kernels with a constant operand
+* 		which compute dst = src op c.
+*/
+typedef struct _WlzValueKrnTab
+{
+  WlzSIMDType	simd;
+  void		(*set32)(WlzUInt *, WlzUInt, size_t);
+  void		(*setF)(float *, float, size_t);
+  void		(*setD)(double *, double, size_t);
+  void		(*cpyUToI)(int *, WlzUByte *, size_t);
+  void		(*cpyUToD)(double *, WlzUByte *, size_t);
+  void		(*cpySToI)(int *, short *, size_t);
+  void		(*cpySToD)(double *, short *, size_t);
+  void		(*cpyIToD)(double *, int *, size_t);
+  void		(*cpyFToD)(double *, float *, size_t);
+  void		(*cpyUToRGBA)(WlzUInt *, WlzUByte *, size_t);
+  void		(*clpIToS)(short *, int *, size_t);
+  void		(*clpIToU)(WlzUByte *, int *, size_t);
+  void		(*clpSToU)(WlzUByte *, short *, size_t);
+  void		(*clpIToRGBA)(WlzUInt *, int *, size_t);
+  void		(*clpDToI)(int *, double *, size_t);
+  void		(*clpDToS)(short *, double *, size_t);
+  void		(*clpDToU)(WlzUByte *, double *, size_t);
+  void		(*clpDToF)(float *, double *, size_t);
+  void		(*addI)(int *, int *, size_t);
+  void		(*subI)(int *, int *, size_t);
+  void		(*mulI)(int *, int *, size_t);
+  void		(*divI)(int *, int *, size_t);
+  void		(*minI)(int *, int *, size_t);
+  void		(*maxI)(int *, int *, size_t);
+  void		(*addD)(double *, double *, size_t);
+  void		(*subD)(double *, double *, size_t);
+  void		(*mulD)(double *, double *, size_t);
+  void		(*divD)(double *, double *, size_t);
+  void		(*minD)(double *, double *, size_t);
+  void		(*maxD)(double *, double *, size_t);
+  void		(*mulAddD)(double *, double *, double, double, size_t);
+  void		(*addRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*subRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*mulRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*minRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*maxRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*andRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*orRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*xorRGBA)(WlzUInt *, WlzUInt *, size_t);
+  void		(*addCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+  void		(*subCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+  void		(*mulCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+  void		(*andCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+  void		(*orCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+  void		(*xorCRGBA)(WlzUInt *, WlzUInt *, WlzUByte, size_t);
+} WlzValueKrnTab;
+
+static const WlzValueKrnTab	*WlzValueKrnTabGet(void);
+static WlzSIMDType		WlzValueKrnSIMDAvail(void);
+
+/* Scalar kernels, these define the results which the vector kernels
+ * must reproduce exactly. */
+
+static void	WlzValueKrnSet32Scl(WlzUInt *d, WlzUInt v, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = v;
+  }
+}
+
+static void	WlzValueKrnSetFScl(float *d, float v, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = v;
+  }
+}
+
+static void	WlzValueKrnSetDScl(double *d, double v, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = v;
+  }
+}
+
+static void	WlzValueKrnCpyUToIScl(int *d, WlzUByte *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpyUToDScl(double *d, WlzUByte *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpySToIScl(int *d, short *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpySToDScl(double *d, short *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpyIToDScl(double *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpyFToDScl(double *d, float *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i];
+  }
+}
+
+static void	WlzValueKrnCpyUToRGBAScl(WlzUInt *d, WlzUByte *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    WLZ_RGBA_RGBA_SET(d[i], s[i], s[i], s[i], 255);
+  }
+}
+
+static void	WlzValueKrnClpIToSScl(short *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (short )WLZ_CLAMP(s[i], SHRT_MIN, SHRT_MAX);
+  }
+}
+
+static void	WlzValueKrnClpIToUScl(WlzUByte *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (WlzUByte )WLZ_CLAMP(s[i], 0, UCHAR_MAX);
+  }
+}
+
+static void	WlzValueKrnClpSToUScl(WlzUByte *d, short *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (WlzUByte )WLZ_CLAMP(s[i], 0, UCHAR_MAX);
+  }
+}
+
+static void	WlzValueKrnClpIToRGBAScl(WlzUInt *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    WlzUInt	v;
+
+    v = (WlzUInt )WLZ_CLAMP(s[i], 0, 255);
+    WLZ_RGBA_RGBA_SET(d[i], v, v, v, 255);
+  }
+}
+
+static void	WlzValueKrnClpDToIScl(int *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    double	t;
+
+    t = WLZ_CLAMP(s[i], INT_MIN, INT_MAX);
+    d[i] = WLZ_NINT(t);
+  }
+}
+
+static void	WlzValueKrnClpDToSScl(short *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    double	t;
+
+    t = WLZ_CLAMP(s[i], SHRT_MIN, SHRT_MAX);
+    d[i] = (short )WLZ_NINT(t);
+  }
+}
+
+static void	WlzValueKrnClpDToUScl(WlzUByte *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    double	t;
+
+    t = WLZ_CLAMP(s[i], 0, UCHAR_MAX);
+    d[i] = (WlzUByte )WLZ_NINT(t);
+  }
+}
+
+static void	WlzValueKrnClpDToFScl(float *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (float )WLZ_CLAMP(s[i], -(FLT_MAX), FLT_MAX);
+  }
+}
+
+static void	WlzValueKrnAddIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] + d[i];
+  }
+}
+
+static void	WlzValueKrnSubIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] - d[i];
+  }
+}
+
+static void	WlzValueKrnMulIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] * d[i];
+  }
+}
+
+static void	WlzValueKrnDivIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (d[i])? (s[i] / d[i]): s[i];
+  }
+}
+
+static void	WlzValueKrnMinIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (s[i] < d[i])? s[i]: d[i];
+  }
+}
+
+static void	WlzValueKrnMaxIScl(int *d, int *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (s[i] > d[i])? s[i]: d[i];
+  }
+}
+
+static void	WlzValueKrnAddDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] + d[i];
+  }
+}
+
+static void	WlzValueKrnSubDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] - d[i];
+  }
+}
+
+static void	WlzValueKrnMulDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] * d[i];
+  }
+}
+
+static void	WlzValueKrnDivDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (fabs(d[i]) > DBL_EPSILON)? (s[i] / d[i]): s[i];
+  }
+}
+
+static void	WlzValueKrnMinDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (s[i] < d[i])? s[i]: d[i];
+  }
+}
+
+static void	WlzValueKrnMaxDScl(double *d, double *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (s[i] > d[i])? s[i]: d[i];
+  }
+}
+
+static void	WlzValueKrnMulAddDScl(double *d, double *s,
+				      double m, double a, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = (s[i] * m) + a;
+  }
+}
+
+/* Packed RGBA kernels. The channels are independent bytes so these
+ * kernels work through the bytes of the packed values. The kernels
+ * for a pair of vectors clamp each channel to [0-255], as the image
+ * arithmetic does, while those with a constant operand keep the low
+ * eight bits of each channel, as the scalar arithmetic does. */
+
+static void	WlzValueKrnAddRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    int		t;
+
+    t = sB[i] + dB[i];
+    dB[i] = (WlzUByte )((t > UCHAR_MAX)? UCHAR_MAX: t);
+  }
+}
+
+static void	WlzValueKrnSubRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    int		t;
+
+    t = sB[i] - dB[i];
+    dB[i] = (WlzUByte )((t < 0)? 0: t);
+  }
+}
+
+static void	WlzValueKrnMulRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    int		t;
+
+    t = sB[i] * dB[i];
+    dB[i] = (WlzUByte )((t > UCHAR_MAX)? UCHAR_MAX: t);
+  }
+}
+
+static void	WlzValueKrnMinRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    dB[i] = (sB[i] < dB[i])? sB[i]: dB[i];
+  }
+}
+
+static void	WlzValueKrnMaxRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    dB[i] = (sB[i] > dB[i])? sB[i]: dB[i];
+  }
+}
+
+static void	WlzValueKrnAndRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] & d[i];
+  }
+}
+
+static void	WlzValueKrnOrRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] | d[i];
+  }
+}
+
+static void	WlzValueKrnXorRGBAScl(WlzUInt *d, WlzUInt *s, size_t n)
+{
+  size_t	i;
+
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] ^ d[i];
+  }
+}
+
+static void	WlzValueKrnAddCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				       size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    dB[i] = (WlzUByte )(sB[i] + v);
+  }
+}
+
+static void	WlzValueKrnSubCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				       size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    dB[i] = (WlzUByte )(sB[i] - v);
+  }
+}
+
+static void	WlzValueKrnMulCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				       size_t n)
+{
+  size_t	i;
+  WlzUByte	*dB,
+  		*sB;
+
+  dB = (WlzUByte *)d;
+  sB = (WlzUByte *)s;
+  for(i = 0; i < 4 * n; ++i)
+  {
+    dB[i] = (WlzUByte )(sB[i] * v);
+  }
+}
+
+static void	WlzValueKrnAndCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				       size_t n)
+{
+  size_t	i;
+  WlzUInt	w;
+
+  w = v * 0x01010101u;
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] & w;
+  }
+}
+
+static void	WlzValueKrnOrCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				      size_t n)
+{
+  size_t	i;
+  WlzUInt	w;
+
+  w = v * 0x01010101u;
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] | w;
+  }
+}
+
+static void	WlzValueKrnXorCRGBAScl(WlzUInt *d, WlzUInt *s, WlzUByte v,
+				       size_t n)
+{
+  size_t	i;
+  WlzUInt	w;
+
+  w = v * 0x01010101u;
+  for(i = 0; i < n; ++i)
+  {
+    d[i] = s[i] ^ w;
+  }
+}
+
+#ifdef WLZ_VALUE_KRN_X86
+
+/* SSE2 kernels. Each handles whole vectors and then passes any
+ * remaining elements to the scalar kernel. */
+
+/*!
+* \return	Nearest integers in the low two lanes.
+* \ingroup	WlzValuesUtils
+* \brief	Rounds a pair of doubles to the nearest integers with
+* 		halves rounded away from zero as by WLZ_NINT().
+* \param	x			Given doubles.
+*/
+static WLZ_VALUE_KRN_SSE2 __m128i WlzValueKrnNIntSse2(__m128d x)
+{
+  __m128d	h;
+
+  h = _mm_or_pd(_mm_and_pd(x, _mm_set1_pd(-0.0)), _mm_set1_pd(0.5));
+  return(_mm_cvttpd_epi32(_mm_add_pd(x, h)));
+}
+
+/*!
+* \return	Four integers.
+* \ingroup	WlzValuesUtils
+* \brief	Clamps four doubles to the given limits and then rounds
+* 		them to the nearest integers.
+* \param	s			Pointer to the doubles.
+* \param	lo			Lower limit.
+* \param	hi			Upper limit.
+*/
+static WLZ_VALUE_KRN_SSE2 __m128i WlzValueKrnClpD4Sse2(double *s,
+					__m128d lo, __m128d hi)
+{
+  __m128d	x0,
+  		x1;
+
+  /* Argument order leaves NaN values unchanged as WLZ_CLAMP() does. */
+  x0 = _mm_min_pd(hi, _mm_max_pd(lo, _mm_loadu_pd(s)));
+  x1 = _mm_min_pd(hi, _mm_max_pd(lo, _mm_loadu_pd(s + 2)));
+  return(_mm_unpacklo_epi64(WlzValueKrnNIntSse2(x0),
+			    WlzValueKrnNIntSse2(x1)));
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSet32Sse2(WlzUInt *d, WlzUInt v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128i	x;
+
+  x = _mm_set1_epi32((int )v);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i), x);
+  }
+  WlzValueKrnSet32Scl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSetFSse2(float *d, float v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128	x;
+
+  x = _mm_set1_ps(v);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(d + i, x);
+  }
+  WlzValueKrnSetFScl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSetDSse2(double *d, double v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128d	x;
+
+  x = _mm_set1_pd(v);
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, x);
+  }
+  WlzValueKrnSetDScl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpyUToISse2(int *d, WlzUByte *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128i	z;
+
+  z = _mm_setzero_si128();
+  for(; i + 16 <= n; i += 16)
+  {
+    __m128i	v,
+    		l,
+		h;
+
+    v = _mm_loadu_si128((__m128i *)(s + i));
+    l = _mm_unpacklo_epi8(v, z);
+    h = _mm_unpackhi_epi8(v, z);
+    _mm_storeu_si128((__m128i *)(d + i), _mm_unpacklo_epi16(l, z));
+    _mm_storeu_si128((__m128i *)(d + i + 4), _mm_unpackhi_epi16(l, z));
+    _mm_storeu_si128((__m128i *)(d + i + 8), _mm_unpacklo_epi16(h, z));
+    _mm_storeu_si128((__m128i *)(d + i + 12), _mm_unpackhi_epi16(h, z));
+  }
+  WlzValueKrnCpyUToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpyUToDSse2(double *d,
+						WlzUByte *s, size_t n)
+{
+  size_t	i = 0;
+  __m128i	z;
+
+  z = _mm_setzero_si128();
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v,
+    		l,
+		h;
+
+    v = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)(s + i)), z);
+    l = _mm_unpacklo_epi16(v, z);
+    h = _mm_unpackhi_epi16(v, z);
+    _mm_storeu_pd(d + i, _mm_cvtepi32_pd(l));
+    _mm_storeu_pd(d + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(l, 0xee)));
+    _mm_storeu_pd(d + i + 4, _mm_cvtepi32_pd(h));
+    _mm_storeu_pd(d + i + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(h, 0xee)));
+  }
+  WlzValueKrnCpyUToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpySToISse2(int *d, short *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v;
+
+    v = _mm_loadu_si128((__m128i *)(s + i));
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+    _mm_storeu_si128((__m128i *)(d + i + 4),
+    		     _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+  }
+  WlzValueKrnCpySToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpySToDSse2(double *d, short *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v,
+    		l,
+		h;
+
+    v = _mm_loadu_si128((__m128i *)(s + i));
+    l = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    h = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_pd(d + i, _mm_cvtepi32_pd(l));
+    _mm_storeu_pd(d + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(l, 0xee)));
+    _mm_storeu_pd(d + i + 4, _mm_cvtepi32_pd(h));
+    _mm_storeu_pd(d + i + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(h, 0xee)));
+  }
+  WlzValueKrnCpySToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpyIToDSse2(double *d, int *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128i	v;
+
+    v = _mm_loadu_si128((__m128i *)(s + i));
+    _mm_storeu_pd(d + i, _mm_cvtepi32_pd(v));
+    _mm_storeu_pd(d + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, 0xee)));
+  }
+  WlzValueKrnCpyIToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpyFToDSse2(double *d, float *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128	v;
+
+    v = _mm_loadu_ps(s + i);
+    _mm_storeu_pd(d + i, _mm_cvtps_pd(v));
+    _mm_storeu_pd(d + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+  }
+  WlzValueKrnCpyFToDScl(d + i, s + i, n - i);
+}
+
+/*!
+* \return	Four RGBA values.
+* \ingroup	WlzValuesUtils
+* \brief	Makes grey RGBA values with full alpha from four
+* 		integers which must be in the range [0-255].
+* \param	v			Given integers.
+*/
+static WLZ_VALUE_KRN_SSE2 __m128i WlzValueKrnGreyRGBASse2(__m128i v)
+{
+  v = _mm_or_si128(v, _mm_or_si128(_mm_slli_epi32(v, 8),
+  				   _mm_slli_epi32(v, 16)));
+  return(_mm_or_si128(v, _mm_set1_epi32((int )0xff000000)));
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnCpyUToRGBASse2(WlzUInt *d,
+						WlzUByte *s, size_t n)
+{
+  size_t	i = 0;
+  __m128i	z;
+
+  z = _mm_setzero_si128();
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v;
+
+    v = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i *)(s + i)), z);
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     WlzValueKrnGreyRGBASse2(_mm_unpacklo_epi16(v, z)));
+    _mm_storeu_si128((__m128i *)(d + i + 4),
+    		     WlzValueKrnGreyRGBASse2(_mm_unpackhi_epi16(v, z)));
+  }
+  WlzValueKrnCpyUToRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpIToSSse2(short *d, int *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_packs_epi32(_mm_loadu_si128((__m128i *)(s + i)),
+				     _mm_loadu_si128((__m128i *)(s + i + 4))));
+  }
+  WlzValueKrnClpIToSScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpIToUSse2(WlzUByte *d, int *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 16 <= n; i += 16)
+  {
+    __m128i	l,
+    		h;
+
+    l = _mm_packs_epi32(_mm_loadu_si128((__m128i *)(s + i)),
+			_mm_loadu_si128((__m128i *)(s + i + 4)));
+    h = _mm_packs_epi32(_mm_loadu_si128((__m128i *)(s + i + 8)),
+			_mm_loadu_si128((__m128i *)(s + i + 12)));
+    _mm_storeu_si128((__m128i *)(d + i), _mm_packus_epi16(l, h));
+  }
+  WlzValueKrnClpIToUScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpSToUSse2(WlzUByte *d, short *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 16 <= n; i += 16)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_packus_epi16(_mm_loadu_si128((__m128i *)(s + i)),
+				      _mm_loadu_si128((__m128i *)(s + i + 8))));
+  }
+  WlzValueKrnClpSToUScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpIToRGBASse2(WlzUInt *d, int *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128i	z;
+
+  z = _mm_setzero_si128();
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v;
+
+    v = _mm_packs_epi32(_mm_loadu_si128((__m128i *)(s + i)),
+			_mm_loadu_si128((__m128i *)(s + i + 4)));
+    v = _mm_unpacklo_epi8(_mm_packus_epi16(v, v), z);
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     WlzValueKrnGreyRGBASse2(_mm_unpacklo_epi16(v, z)));
+    _mm_storeu_si128((__m128i *)(d + i + 4),
+    		     WlzValueKrnGreyRGBASse2(_mm_unpackhi_epi16(v, z)));
+  }
+  WlzValueKrnClpIToRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpDToISse2(int *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128d	lo,
+  		hi;
+
+  lo = _mm_set1_pd(INT_MIN);
+  hi = _mm_set1_pd(INT_MAX);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i), WlzValueKrnClpD4Sse2(s + i, lo, hi));
+  }
+  WlzValueKrnClpDToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpDToSSse2(short *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128d	lo,
+  		hi;
+
+  lo = _mm_set1_pd(SHRT_MIN);
+  hi = _mm_set1_pd(SHRT_MAX);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_packs_epi32(WlzValueKrnClpD4Sse2(s + i, lo, hi),
+		     		     WlzValueKrnClpD4Sse2(s + i + 4, lo, hi)));
+  }
+  WlzValueKrnClpDToSScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpDToUSse2(WlzUByte *d,
+						double *s, size_t n)
+{
+  size_t	i = 0;
+  __m128d	lo,
+  		hi;
+
+  lo = _mm_setzero_pd();
+  hi = _mm_set1_pd(UCHAR_MAX);
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v;
+
+    v = _mm_packs_epi32(WlzValueKrnClpD4Sse2(s + i, lo, hi),
+			WlzValueKrnClpD4Sse2(s + i + 4, lo, hi));
+    _mm_storel_epi64((__m128i *)(d + i), _mm_packus_epi16(v, v));
+  }
+  WlzValueKrnClpDToUScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnClpDToFSse2(float *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128d	lo,
+  		hi;
+
+  lo = _mm_set1_pd(-(FLT_MAX));
+  hi = _mm_set1_pd(FLT_MAX);
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128	f0,
+    		f1;
+
+    f0 = _mm_cvtpd_ps(_mm_min_pd(hi, _mm_max_pd(lo, _mm_loadu_pd(s + i))));
+    f1 = _mm_cvtpd_ps(_mm_min_pd(hi, _mm_max_pd(lo,
+    					       _mm_loadu_pd(s + i + 2))));
+    _mm_storeu_ps(d + i, _mm_movelh_ps(f0, f1));
+  }
+  WlzValueKrnClpDToFScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnAddISse2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_add_epi32(_mm_loadu_si128((__m128i *)(s + i)),
+				   _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnAddIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSubISse2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_sub_epi32(_mm_loadu_si128((__m128i *)(s + i)),
+				   _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnSubIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMulISse2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  /* SSE2 has no 32 bit low multiply, so the even and odd lanes are
+   * multiplied separately and the low halves recombined. */
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128i	a,
+    		b,
+		p0,
+		p1;
+
+    a = _mm_loadu_si128((__m128i *)(s + i));
+    b = _mm_loadu_si128((__m128i *)(d + i));
+    p0 = _mm_mul_epu32(a, b);
+    p1 = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_unpacklo_epi32(_mm_shuffle_epi32(p0, 0x08),
+		     			_mm_shuffle_epi32(p1, 0x08)));
+  }
+  WlzValueKrnMulIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMinISse2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128i	a,
+    		b,
+		m;
+
+    a = _mm_loadu_si128((__m128i *)(s + i));
+    b = _mm_loadu_si128((__m128i *)(d + i));
+    m = _mm_cmplt_epi32(a, b);
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)));
+  }
+  WlzValueKrnMinIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMaxISse2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128i	a,
+    		b,
+		m;
+
+    a = _mm_loadu_si128((__m128i *)(s + i));
+    b = _mm_loadu_si128((__m128i *)(d + i));
+    m = _mm_cmpgt_epi32(a, b);
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)));
+  }
+  WlzValueKrnMaxIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnAddDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_add_pd(_mm_loadu_pd(s + i),
+    				    _mm_loadu_pd(d + i)));
+  }
+  WlzValueKrnAddDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSubDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_sub_pd(_mm_loadu_pd(s + i),
+    				    _mm_loadu_pd(d + i)));
+  }
+  WlzValueKrnSubDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMulDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_mul_pd(_mm_loadu_pd(s + i),
+    				    _mm_loadu_pd(d + i)));
+  }
+  WlzValueKrnMulDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnDivDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m128d	e,
+  		z;
+
+  e = _mm_set1_pd(DBL_EPSILON);
+  z = _mm_set1_pd(-0.0);
+  for(; i + 2 <= n; i += 2)
+  {
+    __m128d	a,
+    		b,
+		m;
+
+    a = _mm_loadu_pd(s + i);
+    b = _mm_loadu_pd(d + i);
+    m = _mm_cmpgt_pd(_mm_andnot_pd(z, b), e);
+    _mm_storeu_pd(d + i, _mm_or_pd(_mm_and_pd(m, _mm_div_pd(a, b)),
+    				   _mm_andnot_pd(m, a)));
+  }
+  WlzValueKrnDivDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMinDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_min_pd(_mm_loadu_pd(s + i),
+    				    _mm_loadu_pd(d + i)));
+  }
+  WlzValueKrnMinDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMaxDSse2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_max_pd(_mm_loadu_pd(s + i),
+    				    _mm_loadu_pd(d + i)));
+  }
+  WlzValueKrnMaxDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMulAddDSse2(double *d, double *s,
+					double m, double a, size_t n)
+{
+  size_t	i = 0;
+  __m128d	vM,
+  		vA;
+
+  vM = _mm_set1_pd(m);
+  vA = _mm_set1_pd(a);
+  for(; i + 2 <= n; i += 2)
+  {
+    _mm_storeu_pd(d + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(s + i), vM),
+    				    vA));
+  }
+  WlzValueKrnMulAddDScl(d + i, s + i, m, a, n - i);
+}
+
+/*!
+* \return	Sixteen bytes.
+* \ingroup	WlzValuesUtils
+* \brief	Multiplies sixteen pairs of unsigned bytes clamping
+* 		the products to 255.
+* \param	a			First bytes.
+* \param	b			Second bytes.
+*/
+static WLZ_VALUE_KRN_SSE2 __m128i WlzValueKrnMulU8Sse2(__m128i a, __m128i b)
+{
+  __m128i	z,
+  		m,
+  		l,
+  		h;
+
+  z = _mm_setzero_si128();
+  m = _mm_set1_epi16(UCHAR_MAX);
+  l = _mm_mullo_epi16(_mm_unpacklo_epi8(a, z), _mm_unpacklo_epi8(b, z));
+  h = _mm_mullo_epi16(_mm_unpackhi_epi8(a, z), _mm_unpackhi_epi8(b, z));
+  l = _mm_sub_epi16(l, _mm_subs_epu16(l, m));
+  h = _mm_sub_epi16(h, _mm_subs_epu16(h, m));
+  return(_mm_packus_epi16(l, h));
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnAddRGBASse2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_adds_epu8(_mm_loadu_si128((__m128i *)(s + i)),
+				   _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnAddRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSubRGBASse2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_subs_epu8(_mm_loadu_si128((__m128i *)(s + i)),
+				   _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnSubRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMulRGBASse2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     WlzValueKrnMulU8Sse2(_mm_loadu_si128((__m128i *)(s + i)),
+					  _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnMulRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMinRGBASse2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_min_epu8(_mm_loadu_si128((__m128i *)(s + i)),
+				  _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnMinRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMaxRGBASse2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_max_epu8(_mm_loadu_si128((__m128i *)(s + i)),
+				  _mm_loadu_si128((__m128i *)(d + i))));
+  }
+  WlzValueKrnMaxRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnAddCRGBASse2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m128i	vV;
+
+  vV = _mm_set1_epi8((char )v);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_add_epi8(_mm_loadu_si128((__m128i *)(s + i)), vV));
+  }
+  WlzValueKrnAddCRGBAScl(d + i, s + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnSubCRGBASse2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m128i	vV;
+
+  vV = _mm_set1_epi8((char )v);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_sub_epi8(_mm_loadu_si128((__m128i *)(s + i)), vV));
+  }
+  WlzValueKrnSubCRGBAScl(d + i, s + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_SSE2 void WlzValueKrnMulCRGBASse2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m128i	z,
+  		m,
+		vV;
+
+  z = _mm_setzero_si128();
+  m = _mm_set1_epi16(UCHAR_MAX);
+  vV = _mm_set1_epi16(v);
+  for(; i + 4 <= n; i += 4)
+  {
+    __m128i	x,
+    		l,
+		h;
+
+    x = _mm_loadu_si128((__m128i *)(s + i));
+    l = _mm_and_si128(_mm_mullo_epi16(_mm_unpacklo_epi8(x, z), vV), m);
+    h = _mm_and_si128(_mm_mullo_epi16(_mm_unpackhi_epi8(x, z), vV), m);
+    _mm_storeu_si128((__m128i *)(d + i), _mm_packus_epi16(l, h));
+  }
+  WlzValueKrnMulCRGBAScl(d + i, s + i, v, n - i);
+}
+
+/* AVX2 kernels, only for those operations which gain from the wider
+ * vectors, the SSE2 kernels are used for the rest. */
+
+/*!
+* \return	Four integers.
+* \ingroup	WlzValuesUtils
+* \brief	Clamps four doubles to the given limits and then rounds
+* 		them to the nearest integers as by WLZ_NINT().
+* \param	s			Pointer to the doubles.
+* \param	lo			Lower limit.
+* \param	hi			Upper limit.
+*/
+static WLZ_VALUE_KRN_AVX2 __m128i WlzValueKrnClpD4Avx2(double *s,
+					__m256d lo, __m256d hi)
+{
+  __m256d	x,
+  		h;
+
+  x = _mm256_min_pd(hi, _mm256_max_pd(lo, _mm256_loadu_pd(s)));
+  h = _mm256_or_pd(_mm256_and_pd(x, _mm256_set1_pd(-0.0)),
+  		   _mm256_set1_pd(0.5));
+  return(_mm256_cvttpd_epi32(_mm256_add_pd(x, h)));
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSet32Avx2(WlzUInt *d, WlzUInt v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256i	x;
+
+  x = _mm256_set1_epi32((int )v);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i), x);
+  }
+  WlzValueKrnSet32Scl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSetFAvx2(float *d, float v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256	x;
+
+  x = _mm256_set1_ps(v);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_ps(d + i, x);
+  }
+  WlzValueKrnSetFScl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSetDAvx2(double *d, double v,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256d	x;
+
+  x = _mm256_set1_pd(v);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, x);
+  }
+  WlzValueKrnSetDScl(d + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpyUToIAvx2(int *d, WlzUByte *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 16 <= n; i += 16)
+  {
+    __m128i	v;
+
+    v = _mm_loadu_si128((__m128i *)(s + i));
+    _mm256_storeu_si256((__m256i *)(d + i), _mm256_cvtepu8_epi32(v));
+    _mm256_storeu_si256((__m256i *)(d + i + 8),
+    			_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+  }
+  WlzValueKrnCpyUToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpyUToDAvx2(double *d,
+						WlzUByte *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    __m256i	v;
+
+    v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(s + i)));
+    _mm256_storeu_pd(d + i,
+    		     _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+    _mm256_storeu_pd(d + i + 4,
+    		     _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+  }
+  WlzValueKrnCpyUToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpySToIAvx2(int *d, short *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    			_mm256_cvtepi16_epi32(
+			  _mm_loadu_si128((__m128i *)(s + i))));
+  }
+  WlzValueKrnCpySToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpySToDAvx2(double *d, short *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    __m256i	v;
+
+    v = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(s + i)));
+    _mm256_storeu_pd(d + i,
+    		     _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+    _mm256_storeu_pd(d + i + 4,
+    		     _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+  }
+  WlzValueKrnCpySToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpyIToDAvx2(double *d, int *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i,
+    		     _mm256_cvtepi32_pd(_mm_loadu_si128((__m128i *)(s + i))));
+  }
+  WlzValueKrnCpyIToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnCpyFToDAvx2(double *d, float *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_cvtps_pd(_mm_loadu_ps(s + i)));
+  }
+  WlzValueKrnCpyFToDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnClpDToIAvx2(int *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256d	lo,
+  		hi;
+
+  lo = _mm256_set1_pd(INT_MIN);
+  hi = _mm256_set1_pd(INT_MAX);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128((__m128i *)(d + i), WlzValueKrnClpD4Avx2(s + i, lo, hi));
+  }
+  WlzValueKrnClpDToIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnClpDToSAvx2(short *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256d	lo,
+  		hi;
+
+  lo = _mm256_set1_pd(SHRT_MIN);
+  hi = _mm256_set1_pd(SHRT_MAX);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm_storeu_si128((__m128i *)(d + i),
+    		     _mm_packs_epi32(WlzValueKrnClpD4Avx2(s + i, lo, hi),
+		     		     WlzValueKrnClpD4Avx2(s + i + 4, lo, hi)));
+  }
+  WlzValueKrnClpDToSScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnClpDToUAvx2(WlzUByte *d,
+						double *s, size_t n)
+{
+  size_t	i = 0;
+  __m256d	lo,
+  		hi;
+
+  lo = _mm256_setzero_pd();
+  hi = _mm256_set1_pd(UCHAR_MAX);
+  for(; i + 8 <= n; i += 8)
+  {
+    __m128i	v;
+
+    v = _mm_packs_epi32(WlzValueKrnClpD4Avx2(s + i, lo, hi),
+			WlzValueKrnClpD4Avx2(s + i + 4, lo, hi));
+    _mm_storel_epi64((__m128i *)(d + i), _mm_packus_epi16(v, v));
+  }
+  WlzValueKrnClpDToUScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnClpDToFAvx2(float *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256d	lo,
+  		hi;
+
+  lo = _mm256_set1_pd(-(FLT_MAX));
+  hi = _mm256_set1_pd(FLT_MAX);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(d + i,
+                  _mm256_cvtpd_ps(_mm256_min_pd(hi,
+		  		  _mm256_max_pd(lo, _mm256_loadu_pd(s + i)))));
+  }
+  WlzValueKrnClpDToFScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnAddIAvx2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_add_epi32(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnAddIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSubIAvx2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_sub_epi32(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnSubIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMulIAvx2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_mullo_epi32(_mm256_loadu_si256((__m256i *)(s + i)),
+				   _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMulIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMinIAvx2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_min_epi32(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMinIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMaxIAvx2(int *d, int *s, size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_max_epi32(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMaxIScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnAddDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_add_pd(_mm256_loadu_pd(s + i),
+    					  _mm256_loadu_pd(d + i)));
+  }
+  WlzValueKrnAddDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSubDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_sub_pd(_mm256_loadu_pd(s + i),
+    					  _mm256_loadu_pd(d + i)));
+  }
+  WlzValueKrnSubDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMulDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_mul_pd(_mm256_loadu_pd(s + i),
+    					  _mm256_loadu_pd(d + i)));
+  }
+  WlzValueKrnMulDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnDivDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+  __m256d	e,
+  		z;
+
+  e = _mm256_set1_pd(DBL_EPSILON);
+  z = _mm256_set1_pd(-0.0);
+  for(; i + 4 <= n; i += 4)
+  {
+    __m256d	a,
+    		b,
+		m;
+
+    a = _mm256_loadu_pd(s + i);
+    b = _mm256_loadu_pd(d + i);
+    m = _mm256_cmp_pd(_mm256_andnot_pd(z, b), e, _CMP_GT_OQ);
+    _mm256_storeu_pd(d + i, _mm256_blendv_pd(a, _mm256_div_pd(a, b), m));
+  }
+  WlzValueKrnDivDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMinDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_min_pd(_mm256_loadu_pd(s + i),
+    					  _mm256_loadu_pd(d + i)));
+  }
+  WlzValueKrnMinDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMaxDAvx2(double *d, double *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i, _mm256_max_pd(_mm256_loadu_pd(s + i),
+    					  _mm256_loadu_pd(d + i)));
+  }
+  WlzValueKrnMaxDScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMulAddDAvx2(double *d, double *s,
+					double m, double a, size_t n)
+{
+  size_t	i = 0;
+  __m256d	vM,
+  		vA;
+
+  /* Multiply then add, a fused multiply add would round differently. */
+  vM = _mm256_set1_pd(m);
+  vA = _mm256_set1_pd(a);
+  for(; i + 4 <= n; i += 4)
+  {
+    _mm256_storeu_pd(d + i,
+    		     _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(s + i), vM),
+				   vA));
+  }
+  WlzValueKrnMulAddDScl(d + i, s + i, m, a, n - i);
+}
+
+/*!
+* \return	Thirty two bytes.
+* \ingroup	WlzValuesUtils
+* \brief	Multiplies thirty two pairs of unsigned bytes clamping
+* 		the products to 255.
+* \param	a			First bytes.
+* \param	b			Second bytes.
+*/
+static WLZ_VALUE_KRN_AVX2 __m256i WlzValueKrnMulU8Avx2(__m256i a, __m256i b)
+{
+  __m256i	z,
+  		m,
+  		l,
+  		h;
+
+  z = _mm256_setzero_si256();
+  m = _mm256_set1_epi16(UCHAR_MAX);
+  l = _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, z),
+  			 _mm256_unpacklo_epi8(b, z));
+  h = _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, z),
+  			 _mm256_unpackhi_epi8(b, z));
+  l = _mm256_sub_epi16(l, _mm256_subs_epu16(l, m));
+  h = _mm256_sub_epi16(h, _mm256_subs_epu16(h, m));
+  return(_mm256_packus_epi16(l, h));
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnAddRGBAAvx2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_adds_epu8(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnAddRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSubRGBAAvx2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_subs_epu8(_mm256_loadu_si256((__m256i *)(s + i)),
+				 _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnSubRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMulRGBAAvx2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		WlzValueKrnMulU8Avx2(_mm256_loadu_si256((__m256i *)(s + i)),
+				     _mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMulRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMinRGBAAvx2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_min_epu8(_mm256_loadu_si256((__m256i *)(s + i)),
+				_mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMinRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMaxRGBAAvx2(WlzUInt *d, WlzUInt *s,
+						size_t n)
+{
+  size_t	i = 0;
+
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_max_epu8(_mm256_loadu_si256((__m256i *)(s + i)),
+				_mm256_loadu_si256((__m256i *)(d + i))));
+  }
+  WlzValueKrnMaxRGBAScl(d + i, s + i, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnAddCRGBAAvx2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m256i	vV;
+
+  vV = _mm256_set1_epi8((char )v);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_add_epi8(_mm256_loadu_si256((__m256i *)(s + i)), vV));
+  }
+  WlzValueKrnAddCRGBAScl(d + i, s + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnSubCRGBAAvx2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m256i	vV;
+
+  vV = _mm256_set1_epi8((char )v);
+  for(; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_si256((__m256i *)(d + i),
+    		_mm256_sub_epi8(_mm256_loadu_si256((__m256i *)(s + i)), vV));
+  }
+  WlzValueKrnSubCRGBAScl(d + i, s + i, v, n - i);
+}
+
+static WLZ_VALUE_KRN_AVX2 void WlzValueKrnMulCRGBAAvx2(WlzUInt *d,
+					WlzUInt *s, WlzUByte v, size_t n)
+{
+  size_t	i = 0;
+  __m256i	z,
+  		m,
+		vV;
+
+  z = _mm256_setzero_si256();
+  m = _mm256_set1_epi16(UCHAR_MAX);
+  vV = _mm256_set1_epi16(v);
+  for(; i + 8 <= n; i += 8)
+  {
+    __m256i	x,
+    		l,
+		h;
+
+    x = _mm256_loadu_si256((__m256i *)(s + i));
+    l = _mm256_and_si256(_mm256_mullo_epi16(_mm256_unpacklo_epi8(x, z), vV),
+    			 m);
+    h = _mm256_and_si256(_mm256_mullo_epi16(_mm256_unpackhi_epi8(x, z), vV),
+    			 m);
+    _mm256_storeu_si256((__m256i *)(d + i), _mm256_packus_epi16(l, h));
+  }
+  WlzValueKrnMulCRGBAScl(d + i, s + i, v, n - i);
+}
+
+#endif /* WLZ_VALUE_KRN_X86 */
+
+static const WlzValueKrnTab WlzValueKrnTabScl =
+{
+  WLZ_SIMD_NONE,
+  WlzValueKrnSet32Scl,
+  WlzValueKrnSetFScl,
+  WlzValueKrnSetDScl,
+  WlzValueKrnCpyUToIScl,
+  WlzValueKrnCpyUToDScl,
+  WlzValueKrnCpySToIScl,
+  WlzValueKrnCpySToDScl,
+  WlzValueKrnCpyIToDScl,
+  WlzValueKrnCpyFToDScl,
+  WlzValueKrnCpyUToRGBAScl,
+  WlzValueKrnClpIToSScl,
+  WlzValueKrnClpIToUScl,
+  WlzValueKrnClpSToUScl,
+  WlzValueKrnClpIToRGBAScl,
+  WlzValueKrnClpDToIScl,
+  WlzValueKrnClpDToSScl,
+  WlzValueKrnClpDToUScl,
+  WlzValueKrnClpDToFScl,
+  WlzValueKrnAddIScl,
+  WlzValueKrnSubIScl,
+  WlzValueKrnMulIScl,
+  WlzValueKrnDivIScl,
+  WlzValueKrnMinIScl,
+  WlzValueKrnMaxIScl,
+  WlzValueKrnAddDScl,
+  WlzValueKrnSubDScl,
+  WlzValueKrnMulDScl,
+  WlzValueKrnDivDScl,
+  WlzValueKrnMinDScl,
+  WlzValueKrnMaxDScl,
+  WlzValueKrnMulAddDScl,
+  WlzValueKrnAddRGBAScl,
+  WlzValueKrnSubRGBAScl,
+  WlzValueKrnMulRGBAScl,
+  WlzValueKrnMinRGBAScl,
+  WlzValueKrnMaxRGBAScl,
+  WlzValueKrnAndRGBAScl,
+  WlzValueKrnOrRGBAScl,
+  WlzValueKrnXorRGBAScl,
+  WlzValueKrnAddCRGBAScl,
+  WlzValueKrnSubCRGBAScl,
+  WlzValueKrnMulCRGBAScl,
+  WlzValueKrnAndCRGBAScl,
+  WlzValueKrnOrCRGBAScl,
+  WlzValueKrnXorCRGBAScl
+};
+
+#ifdef WLZ_VALUE_KRN_X86
+static const WlzValueKrnTab WlzValueKrnTabSse2 =
+{
+  WLZ_SIMD_SSE2,
+  WlzValueKrnSet32Sse2,
+  WlzValueKrnSetFSse2,
+  WlzValueKrnSetDSse2,
+  WlzValueKrnCpyUToISse2,
+  WlzValueKrnCpyUToDSse2,
+  WlzValueKrnCpySToISse2,
+  WlzValueKrnCpySToDSse2,
+  WlzValueKrnCpyIToDSse2,
+  WlzValueKrnCpyFToDSse2,
+  WlzValueKrnCpyUToRGBASse2,
+  WlzValueKrnClpIToSSse2,
+  WlzValueKrnClpIToUSse2,
+  WlzValueKrnClpSToUSse2,
+  WlzValueKrnClpIToRGBASse2,
+  WlzValueKrnClpDToISse2,
+  WlzValueKrnClpDToSSse2,
+  WlzValueKrnClpDToUSse2,
+  WlzValueKrnClpDToFSse2,
+  WlzValueKrnAddISse2,
+  WlzValueKrnSubISse2,
+  WlzValueKrnMulISse2,
+  WlzValueKrnDivIScl,
+  WlzValueKrnMinISse2,
+  WlzValueKrnMaxISse2,
+  WlzValueKrnAddDSse2,
+  WlzValueKrnSubDSse2,
+  WlzValueKrnMulDSse2,
+  WlzValueKrnDivDSse2,
+  WlzValueKrnMinDSse2,
+  WlzValueKrnMaxDSse2,
+  WlzValueKrnMulAddDSse2,
+  WlzValueKrnAddRGBASse2,
+  WlzValueKrnSubRGBASse2,
+  WlzValueKrnMulRGBASse2,
+  WlzValueKrnMinRGBASse2,
+  WlzValueKrnMaxRGBASse2,
+  WlzValueKrnAndRGBAScl,
+  WlzValueKrnOrRGBAScl,
+  WlzValueKrnXorRGBAScl,
+  WlzValueKrnAddCRGBASse2,
+  WlzValueKrnSubCRGBASse2,
+  WlzValueKrnMulCRGBASse2,
+  WlzValueKrnAndCRGBAScl,
+  WlzValueKrnOrCRGBAScl,
+  WlzValueKrnXorCRGBAScl
+};
+
+static const WlzValueKrnTab WlzValueKrnTabAvx2 =
+{
+  WLZ_SIMD_AVX2,
+  WlzValueKrnSet32Avx2,
+  WlzValueKrnSetFAvx2,
+  WlzValueKrnSetDAvx2,
+  WlzValueKrnCpyUToIAvx2,
+  WlzValueKrnCpyUToDAvx2,
+  WlzValueKrnCpySToIAvx2,
+  WlzValueKrnCpySToDAvx2,
+  WlzValueKrnCpyIToDAvx2,
+  WlzValueKrnCpyFToDAvx2,
+  WlzValueKrnCpyUToRGBASse2,
+  WlzValueKrnClpIToSSse2,
+  WlzValueKrnClpIToUSse2,
+  WlzValueKrnClpSToUSse2,
+  WlzValueKrnClpIToRGBASse2,
+  WlzValueKrnClpDToIAvx2,
+  WlzValueKrnClpDToSAvx2,
+  WlzValueKrnClpDToUAvx2,
+  WlzValueKrnClpDToFAvx2,
+  WlzValueKrnAddIAvx2,
+  WlzValueKrnSubIAvx2,
+  WlzValueKrnMulIAvx2,
+  WlzValueKrnDivIScl,
+  WlzValueKrnMinIAvx2,
+  WlzValueKrnMaxIAvx2,
+  WlzValueKrnAddDAvx2,
+  WlzValueKrnSubDAvx2,
+  WlzValueKrnMulDAvx2,
+  WlzValueKrnDivDAvx2,
+  WlzValueKrnMinDAvx2,
+  WlzValueKrnMaxDAvx2,
+  WlzValueKrnMulAddDAvx2,
+  WlzValueKrnAddRGBAAvx2,
+  WlzValueKrnSubRGBAAvx2,
+  WlzValueKrnMulRGBAAvx2,
+  WlzValueKrnMinRGBAAvx2,
+  WlzValueKrnMaxRGBAAvx2,
+  WlzValueKrnAndRGBAScl,
+  WlzValueKrnOrRGBAScl,
+  WlzValueKrnXorRGBAScl,
+  WlzValueKrnAddCRGBAAvx2,
+  WlzValueKrnSubCRGBAAvx2,
+  WlzValueKrnMulCRGBAAvx2,
+  WlzValueKrnAndCRGBAScl,
+  WlzValueKrnOrCRGBAScl,
+  WlzValueKrnXorCRGBAScl
+};
+#endif /* WLZ_VALUE_KRN_X86 */
+
+static const WlzValueKrnTab * volatile WlzValueKrnTabCur = NULL;
+
+/*!
+* \return	Most capable SIMD instruction set available.
+* \ingroup	WlzValuesUtils
+* \brief	Finds the most capable SIMD instruction set which is
+* 		supported by both the CPU and this build of the library.
+*/
+static WlzSIMDType WlzValueKrnSIMDAvail(void)
+{
+  WlzSIMDType	simd = WLZ_SIMD_NONE;
+
+#ifdef WLZ_VALUE_KRN_X86
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+  {
+    simd = WLZ_SIMD_AVX2;
+  }
+  else if(__builtin_cpu_supports("sse2"))
+  {
+    simd = WLZ_SIMD_SSE2;
+  }
+#endif
+  return(simd);
+}
+
+/*!
+* \return	Kernel table.
+* \ingroup	WlzValuesUtils
+* \brief	Gets the current kernel table, choosing the table for
+* 		the most capable SIMD instruction set available on
+* 		first use.
+*/
+static const WlzValueKrnTab *WlzValueKrnTabGet(void)
+{
+  if(WlzValueKrnTabCur == NULL)
+  {
+    (void )WlzValueKrnSetSIMDType(WLZ_SIMD_AVX2);
+  }
+  return(WlzValueKrnTabCur);
+}
+
+/*!
+* \return	SIMD instruction set used by the value kernels.
+* \ingroup	WlzValuesUtils
+* \brief	Gets the SIMD instruction set which is used by the
+* 		value kernels.
+*/
+WlzSIMDType	WlzValueKrnSIMDType(void)
+{
+  return(WlzValueKrnTabGet()->simd);
+}
+
+/*!
+* \return	SIMD instruction set now used by the value kernels.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the SIMD instruction set to be used by the value
+* 		kernels. If the requested instruction set is not
+* 		available then the most capable available one below
+* 		it is used. This is mainly useful for testing and
+* 		benchmarking since the results do not depend on the
+* 		instruction set.
+* \param	simd			Requested SIMD instruction set.
+*/
+WlzSIMDType	WlzValueKrnSetSIMDType(WlzSIMDType simd)
+{
+  WlzSIMDType	avail;
+  const WlzValueKrnTab *tab = &WlzValueKrnTabScl;
+
+  avail = WlzValueKrnSIMDAvail();
+  if(simd > avail)
+  {
+    simd = avail;
+  }
+#ifdef WLZ_VALUE_KRN_X86
+  switch(simd)
+  {
+    case WLZ_SIMD_AVX2:
+      tab = &WlzValueKrnTabAvx2;
+      break;
+    case WLZ_SIMD_SSE2:
+      tab = &WlzValueKrnTabSse2;
+      break;
+    default:
+      break;
+  }
+#endif
+#ifdef _OPENMP
+#pragma omp critical (WlzValueKrnTab)
+#endif
+  {
+    WlzValueKrnTabCur = tab;
+  }
+  return(tab->simd);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Sets all elements of an int vector to the given value.
+* \param	dst			Destination vector.
+* \param	value			Given value.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnSetInt(int *dst, int value, size_t count)
+{
+  WlzValueKrnTabGet()->set32((WlzUInt *)dst, (WlzUInt )value, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Sets all elements of a float vector to the given value.
+* \param	dst			Destination vector.
+* \param	value			Given value.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnSetFloat(float *dst, float value, size_t count)
+{
+  WlzValueKrnTabGet()->setF(dst, value, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Sets all elements of a double vector to the given value.
+* \param	dst			Destination vector.
+* \param	value			Given value.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnSetDouble(double *dst, double value, size_t count)
+{
+  WlzValueKrnTabGet()->setD(dst, value, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Sets all elements of an RGBA vector to the given value.
+* \param	dst			Destination vector.
+* \param	value			Given value.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnSetRGBA(WlzUInt *dst, WlzUInt value, size_t count)
+{
+  WlzValueKrnTabGet()->set32(dst, value, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of WlzUByte to a vector of int.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyUByteToInt(int *dst, WlzUByte *src,
+					  size_t count)
+{
+  WlzValueKrnTabGet()->cpyUToI(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of WlzUByte to a vector of double.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyUByteToDouble(double *dst, WlzUByte *src,
+					     size_t count)
+{
+  WlzValueKrnTabGet()->cpyUToD(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of WlzUByte to a vector of grey RGBA
+* 		values with full alpha.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyUByteToRGBA(WlzUInt *dst, WlzUByte *src,
+					   size_t count)
+{
+  WlzValueKrnTabGet()->cpyUToRGBA(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of short to a vector of int.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyShortToInt(int *dst, short *src, size_t count)
+{
+  WlzValueKrnTabGet()->cpySToI(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of short to a vector of double.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyShortToDouble(double *dst, short *src,
+					     size_t count)
+{
+  WlzValueKrnTabGet()->cpySToD(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of int to a vector of double.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyIntToDouble(double *dst, int *src, size_t count)
+{
+  WlzValueKrnTabGet()->cpyIToD(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Copies a vector of float to a vector of double.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnCopyFloatToDouble(double *dst, float *src,
+					     size_t count)
+{
+  WlzValueKrnTabGet()->cpyFToD(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of int values into a vector of short.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampIntToShort(short *dst, int *src, size_t count)
+{
+  WlzValueKrnTabGet()->clpIToS(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of int values into a vector of WlzUByte.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampIntToUByte(WlzUByte *dst, int *src,
+					   size_t count)
+{
+  WlzValueKrnTabGet()->clpIToU(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of short values into a vector of WlzUByte.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampShortToUByte(WlzUByte *dst, short *src,
+					     size_t count)
+{
+  WlzValueKrnTabGet()->clpSToU(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of int values to the range [0-255] and
+* 		sets a vector of grey RGBA values with full alpha from
+* 		them.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampIntToRGBA(WlzUInt *dst, int *src,
+					  size_t count)
+{
+  WlzValueKrnTabGet()->clpIToRGBA(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of double values into a vector of int,
+* 		rounding to the nearest integer.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampDoubleToInt(int *dst, double *src,
+					    size_t count)
+{
+  WlzValueKrnTabGet()->clpDToI(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of double values into a vector of short,
+* 		rounding to the nearest integer.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampDoubleToShort(short *dst, double *src,
+					      size_t count)
+{
+  WlzValueKrnTabGet()->clpDToS(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of double values into a vector of
+* 		WlzUByte, rounding to the nearest integer.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampDoubleToUByte(WlzUByte *dst, double *src,
+					      size_t count)
+{
+  WlzValueKrnTabGet()->clpDToU(dst, src, count);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Clamps a vector of double values into a vector of float.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnClampDoubleToFloat(float *dst, double *src,
+					      size_t count)
+{
+  WlzValueKrnTabGet()->clpDToF(dst, src, count);
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_BINARY_OPERATOR_TYPE if the
+* 		operator has no kernel.
+* \ingroup	WlzValuesUtils
+* \brief	Applies a binary operator to a pair of int vectors with
+* 		dst[i] = src[i] op dst[i]. Division by zero leaves
+* 		the source value. Only the add, subtract, multiply,
+* 		divide, minimum and maximum operators are supported.
+* \param	dst			Second operand and destination
+* 					vector.
+* \param	src			First operand vector.
+* \param	count			Number of vector elements.
+* \param	op			Binary operator.
+*/
+WlzErrorNum	WlzValueKrnBinOpInt(int *dst, int *src, size_t count,
+				    WlzBinaryOperatorType op)
+{
+  const WlzValueKrnTab *tab;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tab = WlzValueKrnTabGet();
+  switch(op)
+  {
+    case WLZ_BO_ADD:
+      tab->addI(dst, src, count);
+      break;
+    case WLZ_BO_SUBTRACT:
+      tab->subI(dst, src, count);
+      break;
+    case WLZ_BO_MULTIPLY:
+      tab->mulI(dst, src, count);
+      break;
+    case WLZ_BO_DIVIDE:
+      tab->divI(dst, src, count);
+      break;
+    case WLZ_BO_MIN:
+      tab->minI(dst, src, count);
+      break;
+    case WLZ_BO_MAX:
+      tab->maxI(dst, src, count);
+      break;
+    default:
+      errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_BINARY_OPERATOR_TYPE if the
+* 		operator has no kernel.
+* \ingroup	WlzValuesUtils
+* \brief	Applies a binary operator to a pair of double vectors
+* 		with dst[i] = src[i] op dst[i]. Division by values with
+* 		a magnitude no greater than DBL_EPSILON leaves the
+* 		source value. Only the add, subtract, multiply, divide,
+* 		minimum and maximum operators are supported.
+* \param	dst			Second operand and destination
+* 					vector.
+* \param	src			First operand vector.
+* \param	count			Number of vector elements.
+* \param	op			Binary operator.
+*/
+WlzErrorNum	WlzValueKrnBinOpDouble(double *dst, double *src, size_t count,
+				       WlzBinaryOperatorType op)
+{
+  const WlzValueKrnTab *tab;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tab = WlzValueKrnTabGet();
+  switch(op)
+  {
+    case WLZ_BO_ADD:
+      tab->addD(dst, src, count);
+      break;
+    case WLZ_BO_SUBTRACT:
+      tab->subD(dst, src, count);
+      break;
+    case WLZ_BO_MULTIPLY:
+      tab->mulD(dst, src, count);
+      break;
+    case WLZ_BO_DIVIDE:
+      tab->divD(dst, src, count);
+      break;
+    case WLZ_BO_MIN:
+      tab->minD(dst, src, count);
+      break;
+    case WLZ_BO_MAX:
+      tab->maxD(dst, src, count);
+      break;
+    default:
+      errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesUtils
+* \brief	Scales and offsets a vector of double values with
+* 		dst[i] = (src[i] * m) + a. The source and destination
+* 		may be the same vector.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	m			Scale.
+* \param	a			Offset.
+* \param	count			Number of vector elements.
+*/
+void		WlzValueKrnMulAddDouble(double *dst, double *src,
+					double m, double a, size_t count)
+{
+  WlzValueKrnTabGet()->mulAddD(dst, src, m, a, count);
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_BINARY_OPERATOR_TYPE if the
+* 		operator has no kernel.
+* \ingroup	WlzValuesUtils
+* \brief	Applies a binary operator to each channel of a pair of
+* 		packed RGBA vectors with dst[i] = src[i] op dst[i].
+* 		The channel values are clamped to the range [0-255].
+* 		Only the add, subtract, multiply, minimum, maximum and
+* 		the bitwise and, or and exclusive or operators are
+* 		supported.
+* \param	dst			Second operand and destination
+* 					vector.
+* \param	src			First operand vector.
+* \param	count			Number of vector elements.
+* \param	op			Binary operator.
+*/
+WlzErrorNum	WlzValueKrnBinOpRGBA(WlzUInt *dst, WlzUInt *src, size_t count,
+				     WlzBinaryOperatorType op)
+{
+  const WlzValueKrnTab *tab;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tab = WlzValueKrnTabGet();
+  switch(op)
+  {
+    case WLZ_BO_ADD:
+      tab->addRGBA(dst, src, count);
+      break;
+    case WLZ_BO_SUBTRACT:
+      tab->subRGBA(dst, src, count);
+      break;
+    case WLZ_BO_MULTIPLY:
+      tab->mulRGBA(dst, src, count);
+      break;
+    case WLZ_BO_MIN:
+      tab->minRGBA(dst, src, count);
+      break;
+    case WLZ_BO_MAX:
+      tab->maxRGBA(dst, src, count);
+      break;
+    case WLZ_BO_AND:
+      tab->andRGBA(dst, src, count);
+      break;
+    case WLZ_BO_OR:
+      tab->orRGBA(dst, src, count);
+      break;
+    case WLZ_BO_XOR:
+      tab->xorRGBA(dst, src, count);
+      break;
+    default:
+      errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_BINARY_OPERATOR_TYPE if the
+* 		operator has no kernel.
+* \ingroup	WlzValuesUtils
+* \brief	Applies a binary operator with a constant operand to
+* 		each channel of a packed RGBA vector with
+* 		dst[i] = src[i] op value. Only the low eight bits of
+* 		each channel result are kept. Only the add, subtract,
+* 		multiply and the bitwise and, or and exclusive or
+* 		operators are supported. The source and destination
+* 		may be the same vector.
+* \param	dst			Destination vector.
+* \param	src			Source vector.
+* \param	value			Constant operand.
+* \param	count			Number of vector elements.
+* \param	op			Binary operator.
+*/
+WlzErrorNum	WlzValueKrnScalarOpRGBA(WlzUInt *dst, WlzUInt *src, int value,
+					size_t count, WlzBinaryOperatorType op)
+{
+  WlzUByte	v;
+  const WlzValueKrnTab *tab;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Only the low eight bits of the operand affect those of the
+   * results. */
+  v = (WlzUByte )(value & 0xff);
+  tab = WlzValueKrnTabGet();
+  switch(op)
+  {
+    case WLZ_BO_ADD:
+      tab->addCRGBA(dst, src, v, count);
+      break;
+    case WLZ_BO_SUBTRACT:
+      tab->subCRGBA(dst, src, v, count);
+      break;
+    case WLZ_BO_MULTIPLY:
+      tab->mulCRGBA(dst, src, v, count);
+      break;
+    case WLZ_BO_AND:
+      tab->andCRGBA(dst, src, v, count);
+      break;
+    case WLZ_BO_OR:
+      tab->orCRGBA(dst, src, v, count);
+      break;
+    case WLZ_BO_XOR:
+      tab->xorCRGBA(dst, src, v, count);
+      break;
+    default:
+      errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      break;
+  }
+  return(errNum);
+}
@@ -63,22 +63,7 @@ static char _WlzValueUtils_c[] = "University of Edinburgh $Id$";
 void		WlzValueSetInt(int *vec, int value,
 			       size_t count)
 {
-  if(value)
-  {
-    int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-    for(idx = 0; idx < count; ++idx)
-    {
-      vec[idx] = value;
-    }
-  }
-  else
-  {
-    (void )memset(vec, 0, count * sizeof(int));
-  }
+  WlzValueKrnSetInt(vec, value, count);
 }
 
 /*!
@@ -98,9 +83,6 @@ void		WlzValueSetShort(short *vec, short value,
   {
     int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
     for(idx = 0; idx < count; ++idx)
     {
       vec[idx] = value;
@@ -141,15 +123,7 @@ void		WlzValueSetUByte(WlzUByte *vec, WlzUByte value,
 void		WlzValueSetFloat(float *vec, float value,
 				 size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    vec[idx] = value;
-  }
+  WlzValueKrnSetFloat(vec, value, count);
 }
 
 /*!
@@ -165,15 +139,7 @@ void		WlzValueSetFloat(float *vec, float value,
 void		WlzValueSetDouble(double *vec, double value,
 				  size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    vec[idx] = value;
-  }
+  WlzValueKrnSetDouble(vec, value, count);
 }
 
 /*!
@@ -189,22 +155,7 @@ void		WlzValueSetDouble(double *vec, double value,
 void		WlzValueSetRGBA(WlzUInt *vec, WlzUInt value,
 			       size_t count)
 {
-  if(value)
-  {
-    int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-    for(idx = 0; idx < count; ++idx)
-    {
-      vec[idx] = value;
-    }
-  }
-  else
-  {
-    (void )memset(vec, 0, count * sizeof(WlzUInt));
-  }
+  WlzValueKrnSetRGBA(vec, value, count);
 }
 
 /*!
@@ -377,9 +328,6 @@ void		 WlzValueClampIntToShort(int *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > SHRT_MAX)
@@ -405,9 +353,6 @@ void		 WlzValueClampIntToUByte(int *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > UCHAR_MAX)
@@ -433,9 +378,6 @@ void		 WlzValueClampShortToUByte(short *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > UCHAR_MAX)
@@ -461,9 +403,6 @@ void		 WlzValueClampDoubleToInt(double *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > INT_MAX)
@@ -489,9 +428,6 @@ void		 WlzValueClampDoubleToShort(double *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > SHRT_MAX)
@@ -517,9 +453,6 @@ void		 WlzValueClampDoubleToUByte(double *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > UCHAR_MAX)
@@ -545,9 +478,6 @@ void		 WlzValueClampDoubleToRGBA(double *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > UCHAR_MAX)
@@ -573,9 +503,6 @@ void		 WlzValueClampDoubleToFloat(double *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > FLT_MAX)
@@ -601,9 +528,6 @@ void		 WlzValueClampFloatToInt(float *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > INT_MAX)
@@ -629,9 +553,6 @@ void		 WlzValueClampFloatToShort(float *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > SHRT_MAX)
@@ -657,9 +578,6 @@ void		 WlzValueClampFloatToUByte(float *vec, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(vec[idx] > UCHAR_MAX)
@@ -684,26 +602,7 @@ void		 WlzValueClampFloatToUByte(float *vec, size_t count)
 */
 void		 WlzValueClampIntIntoShort(short *dst, int *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > SHRT_MAX)
-    {
-      dst[idx] = SHRT_MAX;
-    }
-    else if(src[idx] < SHRT_MIN)
-    {
-      dst[idx] = SHRT_MIN;
-    }
-    else
-    {
-      dst[idx] = (short )src[idx];
-    }
-  }
+  WlzValueKrnClampIntToShort(dst, src, count);
 }
 
 /*!
@@ -718,26 +617,7 @@ void		 WlzValueClampIntIntoShort(short *dst, int *src, size_t count)
 void		 WlzValueClampIntIntoUByte(WlzUByte *dst, int *src,
 					   size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > UCHAR_MAX)
-    {
-      dst[idx] = UCHAR_MAX;
-    }
-    else if(src[idx] < 0)
-    {
-      dst[idx] = 0;
-    }
-    else
-    {
-      dst[idx] = (WlzUByte )src[idx];
-    }
-  }
+  WlzValueKrnClampIntToUByte(dst, src, count);
 }
 
 /*!
@@ -752,26 +632,7 @@ void		 WlzValueClampIntIntoUByte(WlzUByte *dst, int *src,
 void		 WlzValueClampShortIntoUByte(WlzUByte *dst, short *src,
 					     size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > UCHAR_MAX)
-    {
-      dst[idx] = UCHAR_MAX;
-    }
-    else if(src[idx] < 0)
-    {
-      dst[idx] = 0;
-    }
-    else
-    {
-      dst[idx] = (WlzUByte )src[idx];
-    }
-  }
+  WlzValueKrnClampShortToUByte(dst, src, count);
 }
 
 /*!
@@ -787,9 +648,6 @@ void		WlzValueClampFloatIntoInt(int *dst, float *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(src[idx] > INT_MAX)
@@ -821,9 +679,6 @@ void		WlzValueClampFloatIntoShort(short *dst, float *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(src[idx] > SHRT_MAX)
@@ -855,9 +710,6 @@ void		WlzValueClampFloatIntoUByte(WlzUByte *dst, float *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     if(src[idx] > UCHAR_MAX)
@@ -886,26 +738,7 @@ void		WlzValueClampFloatIntoUByte(WlzUByte *dst, float *src,
 */
 void		WlzValueClampDoubleIntoInt(int *dst, double *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > INT_MAX)
-    {
-      dst[idx] = INT_MAX;
-    }
-    else if(src[idx] < INT_MIN)
-    {
-      dst[idx] = INT_MIN;
-    }
-    else
-    {
-      dst[idx] = WLZ_NINT(src[idx]);
-    }
-  }
+  WlzValueKrnClampDoubleToInt(dst, src, count);
 }
 
 /*!
@@ -920,26 +753,7 @@ void		WlzValueClampDoubleIntoInt(int *dst, double *src, size_t count)
 void		WlzValueClampDoubleIntoShort(short *dst, double *src,
 					     size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > SHRT_MAX)
-    {
-      dst[idx] = SHRT_MAX;
-    }
-    else if(src[idx] < SHRT_MIN)
-    {
-      dst[idx] = SHRT_MIN;
-    }
-    else
-    {
-      dst[idx] = (short )WLZ_NINT(src[idx]);
-    }
-  }
+  WlzValueKrnClampDoubleToShort(dst, src, count);
 }
 
 /*!
@@ -954,26 +768,7 @@ void		WlzValueClampDoubleIntoShort(short *dst, double *src,
 void		WlzValueClampDoubleIntoUByte(WlzUByte *dst, double *src,
 					     size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > UCHAR_MAX)
-    {
-      dst[idx] = UCHAR_MAX;
-    }
-    else if(src[idx] < 0.0)
-    {
-      dst[idx] = 0;
-    }
-    else
-    {
-      dst[idx] = (WlzUByte )(src[idx] + 0.5);
-    }
-  }
+  WlzValueKrnClampDoubleToUByte(dst, src, count);
 }
 
 /*!
@@ -988,26 +783,7 @@ void		WlzValueClampDoubleIntoUByte(WlzUByte *dst, double *src,
 void		WlzValueClampDoubleIntoFloat(float *dst, double *src,
 					     size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    if(src[idx] > FLT_MAX)
-    {
-      dst[idx] = FLT_MAX;
-    }
-    else if(src[idx] < -(FLT_MAX))
-    {
-      dst[idx] = -(FLT_MAX);
-    }
-    else
-    {
-      dst[idx] = (float )src[idx];
-    }
-  }
+  WlzValueKrnClampDoubleToFloat(dst, src, count);
 }
 
 /*!
@@ -1021,29 +797,7 @@ void		WlzValueClampDoubleIntoFloat(float *dst, double *src,
 */
 void		WlzValueClampIntIntoRGBA(WlzUInt *dst, int *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    WlzUInt val;
-
-    if(src[idx] > 255)
-    {
-      val = 255;
-    }
-    else if(src[idx] < 0)
-    {
-      val = 0;
-    }
-    else
-    {
-      val = (WlzUInt )src[idx];
-    }
-    WLZ_RGBA_RGBA_SET(dst[idx], val, val, val, 255);
-  }
+  WlzValueKrnClampIntToRGBA(dst, src, count);
 }
 
 /*!
@@ -1060,9 +814,6 @@ void		WlzValueClampShortIntoRGBA(WlzUInt *dst, short *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     WlzUInt val;
@@ -1097,9 +848,6 @@ void		WlzValueClampFloatIntoRGBA(WlzUInt *dst, float *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     WlzUInt val;
@@ -1134,9 +882,6 @@ void		WlzValueClampDoubleIntoRGBA(WlzUInt *dst, double *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     WlzUInt val;
@@ -1394,15 +1139,7 @@ void		WlzValueCopyIntToInt(int *dst, int *src, size_t count)
 */
 void		WlzValueCopyIntToShort(short *dst, int *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = (short )(WLZ_CLAMP(src[idx], SHRT_MIN, SHRT_MAX));
-  }
+  WlzValueKrnClampIntToShort(dst, src, count);
 }
 
 /*!
@@ -1415,15 +1152,7 @@ void		WlzValueCopyIntToShort(short *dst, int *src, size_t count)
 */
 void		WlzValueCopyIntToUByte(WlzUByte *dst, int *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = (WlzUByte )(WLZ_CLAMP(src[idx], 0, 255));
-  }
+  WlzValueKrnClampIntToUByte(dst, src, count);
 }
 
 /*!
@@ -1438,9 +1167,6 @@ void		WlzValueCopyIntToFloat(float *dst, int *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = (float )src[idx];
@@ -1457,15 +1183,7 @@ void		WlzValueCopyIntToFloat(float *dst, int *src, size_t count)
 */
 void		WlzValueCopyIntToDouble(double *dst, int *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyIntToDouble(dst, src, count);
 }
 
 /*!
@@ -1491,15 +1209,7 @@ void		WlzValueCopyIntToRGBA(WlzUInt *dst, int *src, size_t count)
 */
 void		WlzValueCopyShortToInt(int *dst, short *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyShortToInt(dst, src, count);
 }
 
 /*!
@@ -1526,15 +1236,7 @@ void		WlzValueCopyShortToShort(short *dst, short *src, size_t count)
 void		WlzValueCopyShortToUByte(WlzUByte *dst, short *src,
 				         size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = (WlzUByte )(WLZ_CLAMP(src[idx], 0, 255));
-  }
+  WlzValueKrnClampShortToUByte(dst, src, count);
 }
 
 /*!
@@ -1549,9 +1251,6 @@ void		WlzValueCopyShortToFloat(float *dst, short *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = src[idx];
@@ -1569,15 +1268,7 @@ void		WlzValueCopyShortToFloat(float *dst, short *src, size_t count)
 void		WlzValueCopyShortToDouble(double *dst, short *src,
 					        size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyShortToDouble(dst, src, count);
 }
 
 /*!
@@ -1590,15 +1281,7 @@ void		WlzValueCopyShortToDouble(double *dst, short *src,
 */
 void		WlzValueCopyUByteToInt(int *dst, WlzUByte *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyUByteToInt(dst, src, count);
 }
 
 /*!
@@ -1627,9 +1310,6 @@ void		WlzValueCopyUByteToShort(short *dst, WlzUByte *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = src[idx];
@@ -1663,9 +1343,6 @@ void		WlzValueCopyUByteToFloat(float *dst, WlzUByte *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = src[idx];
@@ -1683,15 +1360,7 @@ void		WlzValueCopyUByteToFloat(float *dst, WlzUByte *src,
 void		WlzValueCopyUByteToDouble(double *dst, WlzUByte *src,
 					  size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyUByteToDouble(dst, src, count);
 }
 
 /*!
@@ -1705,15 +1374,7 @@ void		WlzValueCopyUByteToDouble(double *dst, WlzUByte *src,
 void		WlzValueCopyUByteToRGBA(WlzUInt *dst, WlzUByte *src,
 				        size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    WLZ_RGBA_RGBA_SET(dst[idx], src[idx], src[idx], src[idx], 255);
-  }
+  WlzValueKrnCopyUByteToRGBA(dst, src, count);
 }
 
 /*!
@@ -1728,9 +1389,6 @@ void		WlzValueCopyFloatToInt(int *dst, float *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     float tF;
@@ -1752,9 +1410,6 @@ void		WlzValueCopyFloatToShort(short *dst, float *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     float tF;
@@ -1777,9 +1432,6 @@ void		WlzValueCopyFloatToUByte(WlzUByte *dst, float *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     float tF;
@@ -1813,15 +1465,7 @@ void		WlzValueCopyFloatToFloat(float *dst, float *src, size_t count)
 void		WlzValueCopyFloatToDouble(double *dst, float *src,
 				          size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = src[idx];
-  }
+  WlzValueKrnCopyFloatToDouble(dst, src, count);
 }
 
 /*!
@@ -1847,18 +1491,7 @@ void		WlzValueCopyFloatToRGBA(WlzUInt *dst, float *src, size_t count)
 */
 void		WlzValueCopyDoubleToInt(int *dst, double *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    double tD;
-
-    tD = WLZ_CLAMP(src[idx], INT_MIN, INT_MAX);
-    dst[idx] = WLZ_NINT(tD);
-  }
+  WlzValueKrnClampDoubleToInt(dst, src, count);
 }
 
 /*!
@@ -1871,18 +1504,7 @@ void		WlzValueCopyDoubleToInt(int *dst, double *src, size_t count)
 */
 void		WlzValueCopyDoubleToShort(short *dst, double *src, size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    double tD;
-
-    tD = WLZ_CLAMP(src[idx], SHRT_MIN, SHRT_MAX);
-    dst[idx] = (short )WLZ_NINT(tD);
-  }
+  WlzValueKrnClampDoubleToShort(dst, src, count);
 }
 
 /*!
@@ -1896,18 +1518,7 @@ void		WlzValueCopyDoubleToShort(short *dst, double *src, size_t count)
 void		WlzValueCopyDoubleToUByte(WlzUByte *dst, double *src,
 					  size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    double tD;
-
-    tD = WLZ_CLAMP(src[idx], 0, 255);
-    dst[idx] = (WlzUByte )WLZ_NINT(tD);
-  }
+  WlzValueKrnClampDoubleToUByte(dst, src, count);
 }
 
 /*!
@@ -1921,15 +1532,7 @@ void		WlzValueCopyDoubleToUByte(WlzUByte *dst, double *src,
 void		WlzValueCopyDoubleToFloat(float *dst, double *src,
 					  size_t count)
 {
-  int idx;
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
-  for(idx = 0; idx < count; ++idx)
-  {
-    dst[idx] = (float )(WLZ_CLAMP(src[idx], -(FLT_MAX), FLT_MAX));
-  }
+  WlzValueKrnClampDoubleToFloat(dst, src, count);
 }
 
 /*!
@@ -1972,9 +1575,6 @@ void		WlzValueCopyRGBAToInt(int *dst, WlzUInt *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = (int )WLZ_RGBA_MODULUS(src[idx]);
@@ -1993,9 +1593,6 @@ void		WlzValueCopyRGBAToShort(short *dst, WlzUInt *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = (short )WLZ_RGBA_MODULUS(src[idx]);
@@ -2015,9 +1612,6 @@ void		WlzValueCopyRGBAToUByte(WlzUByte *dst, WlzUInt *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     int	ival;
@@ -2039,9 +1633,6 @@ void		WlzValueCopyRGBAToFloat(float *dst, WlzUInt *src, size_t count)
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = (float )WLZ_RGBA_MODULUS(src[idx]);
@@ -2061,9 +1652,6 @@ void		WlzValueCopyRGBAToDouble(double *dst, WlzUInt *src,
 {
   int idx;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static, WLZ_VALUE_OMP_CHUNKSZ)
-#endif
   for(idx = 0; idx < count; ++idx)
   {
     dst[idx] = WLZ_RGBA_MODULUS(src[idx]);
@@ -2221,6 +1809,7 @@ void		WlzValueCopyGreyToGrey(WlzGreyP dst, size_t dstOff,
 	case WLZ_GREY_DOUBLE:
 	  WlzValueCopyDoubleToFloat(dst.flp + dstOff, src.dbp + srcOff,
 	  			    count);
+	  break;
 	case WLZ_GREY_RGBA:
 	  WlzValueCopyRGBAToFloat(dst.flp + dstOff, src.rgbp + srcOff,
 	  			  count);
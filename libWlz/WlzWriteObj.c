@@ -44,9 +44,23 @@ static char _WlzWriteObj_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <string.h>
 #include <Wlz.h>
+#if HAVE_ZLIB != 0
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
+#if HAVE_BZLIB != 0
+#include <bzlib.h>
+#endif /* HAVE_BZLIB */
 
 /* #define WLZ_DEBUG_WRITEOBJ */
 
+/*!
+* \def		WLZ_WRITEOBJ_CHUNK_LN
+* \ingroup	WlzIO
+* \brief	Default number of lines in each chunk of a chunked voxel
+* 		value table.
+*/
+#define WLZ_WRITEOBJ_CHUNK_LN	(64)
+
 #if defined(_WIN32) && !defined(__x86)
 #define __x86
 #endif
@@ -74,6 +88,28 @@ static WlzErrorNum		WlzWriteTiledValueTable(
 				  FILE *fP,
 				  WlzObject *obj,
 				  int writeTiles);
+static WlzErrorNum		WlzWriteChunkedValueTable(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzChunkCodec codec,
+				  int bandLn);
+static WlzErrorNum		WlzWriteChunkPlane(
+				  WlzDomain dom,
+				  WlzValues val,
+				  int line1,
+				  int bandLn,
+				  int nBnd,
+				  WlzGreyType gType,
+				  WlzChunkCodec codec,
+				  size_t *rawSz,
+				  size_t *cmpSz,
+				  WlzUByte **cmpBuf);
+static WlzErrorNum		WlzWriteChunkCompress(
+				  WlzChunkCodec codec,
+				  WlzUByte *src,
+				  size_t srcSz,
+				  WlzUByte **dstBuf,
+				  size_t *dstSz);
 static WlzErrorNum		WlzWritePolygon(
 				  FILE *fP,
 				  WlzPolygonDomain *poly);
@@ -194,6 +230,9 @@ static WlzErrorNum 		WlzWriteConvexHull(
 static WlzErrorNum 		WlzWriteSpline(
 				  FILE *fP,
 				  WlzBSpline *bs);
+static WlzErrorNum 		WlzWriteIdxMesh(
+				  FILE *fP,
+				  WlzIdxMesh *mesh);
 
 #ifdef WLZ_UNUSED_FUNCTIONS
 static WlzErrorNum 		WlzWriteBox2I(
@@ -447,6 +486,12 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
       case WLZ_SPLINE:
         errNum = WlzWriteSpline(fP, obj->domain.bs);
 	break;
+      case WLZ_IDXMESH:
+        if((errNum = WlzWriteIdxMesh(fP, obj->domain.idm)) == WLZ_ERR_NONE)
+	{
+	  errNum = WlzWritePropertyList(fP, obj->plist);
+	}
+	break;
       case WLZ_CMESH_2D:
         if(((errNum = WlzWriteCMesh2D(fP, NULL,
 	                              obj->domain.cm2)) == WLZ_ERR_NONE) &&
@@ -539,6 +584,67 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes an object to the given file stream in the same way
+* 		as WlzWriteObj() except that the voxel values of a 3D
+* 		domain object are written as a WLZ_VOXELVALUETABLE_CHUNKED
+* 		table.
+* 		Each plane is divided into bands of lines and the values
+* 		within each band are compressed independently, with an
+* 		index of the chunk sizes written before the chunks. This
+* 		allows the chunks to be compressed and decompressed in
+* 		parallel and allows a bounding box or range of planes to be
+* 		read by WlzReadObjRegion() without decompressing the rest of
+* 		the object.
+* 		Objects other than 3D domain objects with (untiled) grey
+* 		values are written using WlzWriteObj().
+* \param	fP			File pointer for output.
+* \param	obj			Object to be written.
+* \param	codec			Compression used for the chunks.
+* \param	bandLn			Number of lines in each chunk, if less
+* 					than one a default is used.
+*/
+WlzErrorNum	WlzWriteObjChunked(FILE *fP, WlzObject *obj,
+				   WlzChunkCodec codec, int bandLn)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj == NULL) || (obj->type != WLZ_3D_DOMAINOBJ) ||
+     (obj->domain.core == NULL) || (obj->values.core == NULL) ||
+     (obj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+  {
+    errNum = WlzWriteObj(fP, obj);
+  }
+  else if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+#ifdef _WIN32
+  else if(_setmode(_fileno(fP), 0x8000) == -1)
+  {
+    errNum = WLZ_ERR_READ_EOF;
+  }
+#endif
+  else if(putc((unsigned int )obj->type, fP) == EOF)
+  {
+    errNum = WLZ_ERR_WRITE_EOF;
+  }
+  else if(((errNum = WlzWritePlaneDomain(fP,
+                                obj->domain.p)) == WLZ_ERR_NONE) &&
+          ((errNum = WlzWriteChunkedValueTable(fP, obj, codec,
+	                                       bandLn)) == WLZ_ERR_NONE))
+  {
+    errNum = WlzWritePropertyList(fP, obj->plist);
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -1743,6 +1849,424 @@ static WlzErrorNum WlzWriteVoxelValueTable(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the voxel values of a 3D domain object to the given
+* 		file as a chunked voxel value table. The table is written
+* 		as:
+* 		\verbatim
+ 		type (WLZ_VOXELVALUETABLE_CHUNKED), grey type, codec
+ 		lines per band, background pixel value
+ 		number of planes (nP), number of bands per plane (nB)
+ 		nP x nB x (uncompressed size, compressed size)
+ 		nP x nB x compressed chunk
+ 		\endverbatim
+* 		with chunks ordered by plane and then band. Band b of a
+* 		plane holds the values of the lines
+* 		line1 + b * bandLn to line1 + (b + 1) * bandLn - 1 (line1
+* 		being that of the plane domain) in interval scan order,
+* 		with little endian byte order. A chunk whose compressed
+* 		size equals its uncompressed size is not compressed.
+* \param	fP			Given file.
+* \param	obj			Object with domain and values.
+* \param	codec			Compression used for the chunks.
+* \param	bandLn			Number of lines in each chunk, if less
+* 					than one a default is used.
+*/
+static WlzErrorNum WlzWriteChunkedValueTable(FILE *fP, WlzObject *obj,
+					     WlzChunkCodec codec, int bandLn)
+{
+  int		idx,
+  		nBnd = 0,
+  		nChk = 0,
+		nPln = 0;
+  size_t	*rawSz = NULL,
+  		*cmpSz = NULL;
+  WlzUByte	**cmpBuf = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgd;
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vox;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = obj->domain.p;
+  vox = obj->values.vox;
+  switch(codec)
+  {
+    case WLZ_CHUNK_CODEC_NONE:
+      break;
+    case WLZ_CHUNK_CODEC_ZLIB:
+#if HAVE_ZLIB == 0
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_ZLIB */
+      break;
+    case WLZ_CHUNK_CODEC_BZIP2:
+#if HAVE_BZLIB == 0
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* HAVE_BZLIB */
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_DATA;
+      break;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTypeFromObj(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	errNum = WlzValueConvertPixel(&bgd, vox->bckgrnd, gType);
+        break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(bandLn < 1)
+    {
+      bandLn = WLZ_WRITEOBJ_CHUNK_LN;
+    }
+    nPln = pDom->lastpl - pDom->plane1 + 1;
+    nBnd = (pDom->lastln - pDom->line1 + bandLn) / bandLn;
+    nChk = nPln * nBnd;
+    if(((rawSz = (size_t *)AlcCalloc(nChk, sizeof(size_t))) == NULL) ||
+       ((cmpSz = (size_t *)AlcCalloc(nChk, sizeof(size_t))) == NULL) ||
+       ((cmpBuf = (WlzUByte **)AlcCalloc(nChk, sizeof(WlzUByte *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Pack and compress the bands of each plane in parallel. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < nPln; ++p)
+    {
+      int	pIdx;
+      WlzDomain	dom;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      dom = pDom->domains[p];
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	if(vox->values[p].core == NULL)
+	{
+	  errNum2 = WLZ_ERR_VALUES_NULL;
+	}
+	else
+	{
+	  pIdx = p * nBnd;
+	  errNum2 = WlzWriteChunkPlane(dom, vox->values[p], pDom->line1,
+				       bandLn, nBnd, gType, codec,
+				       rawSz + pIdx, cmpSz + pIdx,
+				       cmpBuf + pIdx);
+	}
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzWriteObjChunked)
+#endif
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((putc((unsigned int )WLZ_VOXELVALUETABLE_CHUNKED, fP) == EOF) ||
+       (putc((unsigned int )gType, fP) == EOF) ||
+       (putc((unsigned int )codec, fP) == EOF) ||
+       !putword(bandLn, fP))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    else if((errNum = WlzWritePixelV(fP, &bgd, 1)) == WLZ_ERR_NONE)
+    {
+      if(!putword(nPln, fP) || !putword(nBnd, fP))
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nChk); ++idx)
+  {
+    if(!putword((int )(rawSz[idx]), fP) || !putword((int )(cmpSz[idx]), fP))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nChk); ++idx)
+  {
+    if((cmpSz[idx] > 0) &&
+       (fwrite(cmpBuf[idx], sizeof(WlzUByte), cmpSz[idx], fP) != cmpSz[idx]))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(cmpBuf)
+  {
+    for(idx = 0; idx < nChk; ++idx)
+    {
+      AlcFree(cmpBuf[idx]);
+    }
+    AlcFree(cmpBuf);
+  }
+  AlcFree(rawSz);
+  AlcFree(cmpSz);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Packs the values of a single plane into bands of lines and
+* 		compresses each band for WlzWriteChunkedValueTable().
+* \param	dom			Domain of the plane.
+* \param	val			Values of the plane.
+* \param	line1			First line of the plane domain.
+* \param	bandLn			Number of lines in each band.
+* \param	nBnd			Number of bands.
+* \param	gType			Grey type of the packed values.
+* \param	codec			Compression used for the chunks.
+* \param	rawSz			Array of nBnd uncompressed band
+* 					sizes to be set.
+* \param	cmpSz			Array of nBnd compressed band
+* 					sizes to be set.
+* \param	cmpBuf			Array of nBnd compressed band
+* 					buffers to be set.
+*/
+static WlzErrorNum WlzWriteChunkPlane(WlzDomain dom, WlzValues val,
+				      int line1, int bandLn, int nBnd,
+				      WlzGreyType gType, WlzChunkCodec codec,
+				      size_t *rawSz, size_t *cmpSz,
+				      WlzUByte **cmpBuf)
+{
+  int		b;
+  size_t	gSz,
+  		tot = 0;
+  size_t	*off = NULL;
+  WlzUByte	*rawBuf = NULL;
+  WlzObject	obj2D;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gSz = WlzGreySize(gType);
+  obj2D.type = WLZ_2D_DOMAINOBJ;
+  obj2D.linkcount = 0;
+  obj2D.domain = dom;
+  obj2D.values = val;
+  obj2D.plist = NULL;
+  obj2D.assoc = NULL;
+  if((dom.i->line1 < line1) || ((dom.i->lastln - line1) / bandLn >= nBnd))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  /* Count the values in each band. */
+  else if((errNum = WlzInitRasterScan(&obj2D, &iWSp,
+                                      WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      rawSz[(iWSp.linpos - line1) / bandLn] += iWSp.colrmn * gSz;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(b = 0; b < nBnd; ++b)
+    {
+      if(rawSz[b] > INT_MAX)
+      {
+        errNum = WLZ_ERR_PARAM_DATA;
+      }
+      tot += rawSz[b];
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (tot > 0))
+  {
+    if(((off = (size_t *)AlcMalloc(nBnd * sizeof(size_t))) == NULL) ||
+       ((rawBuf = (WlzUByte *)AlcMalloc(tot)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Pack the values of each band. */
+  if((errNum == WLZ_ERR_NONE) && (tot > 0))
+  {
+    off[0] = 0;
+    for(b = 1; b < nBnd; ++b)
+    {
+      off[b] = off[b - 1] + rawSz[b - 1];
+    }
+    if((errNum = WlzInitGreyScan(&obj2D, &iWSp, &gWSp)) == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	WlzGreyP dstP;
+
+	b = (iWSp.linpos - line1) / bandLn;
+	dstP.ubp = rawBuf + off[b];
+	WlzValueCopyGreyToGrey(dstP, 0, gType,
+			       gWSp.u_grintptr, 0, gWSp.pixeltype,
+			       iWSp.colrmn);
+	off[b] += iWSp.colrmn * gSz;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+  }
+  /* Compress each band. */
+  if((errNum == WLZ_ERR_NONE) && (tot > 0))
+  {
+    WlzUByte	*bP;
+
+    bP = rawBuf;
+    for(b = 0; (errNum == WLZ_ERR_NONE) && (b < nBnd); ++b)
+    {
+      if(rawSz[b] > 0)
+      {
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+	if(gSz > 1)
+	{
+	  size_t i,
+	  	 j;
+
+	  for(i = 0; i < rawSz[b]; i += gSz)
+	  {
+	    for(j = 0; j < gSz / 2; ++j)
+	    {
+	      WlzUByte t;
+
+	      t = bP[i + j];
+	      bP[i + j] = bP[i + gSz - 1 - j];
+	      bP[i + gSz - 1 - j] = t;
+	    }
+	  }
+	}
+#endif /* __sparc || __mips || __ppc */
+	errNum = WlzWriteChunkCompress(codec, bP, rawSz[b],
+				       cmpBuf + b, cmpSz + b);
+      }
+      bP += rawSz[b];
+    }
+  }
+  AlcFree(off);
+  AlcFree(rawBuf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Compresses a single chunk using the given codec. If the
+* 		chunk can not be made smaller it is copied unchanged, so
+* 		that the compressed size is equal to the uncompressed size.
+* \param	codec			Compression codec.
+* \param	src			Uncompressed data.
+* \param	srcSz			Number of bytes of uncompressed data.
+* \param	dstBuf			Destination pointer for the new
+* 					buffer with the compressed data.
+* \param	dstSz			Destination pointer for the number of
+* 					bytes of compressed data.
+*/
+static WlzErrorNum WlzWriteChunkCompress(WlzChunkCodec codec,
+				         WlzUByte *src, size_t srcSz,
+					 WlzUByte **dstBuf, size_t *dstSz)
+{
+  size_t	bufSz,
+  		cmpSz = 0;
+  WlzUByte	*buf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(codec)
+  {
+#if HAVE_ZLIB != 0
+    case WLZ_CHUNK_CODEC_ZLIB:
+      bufSz = compressBound(srcSz);
+      break;
+#endif /* HAVE_ZLIB */
+#if HAVE_BZLIB != 0
+    case WLZ_CHUNK_CODEC_BZIP2:
+      bufSz = srcSz + (srcSz / 100) + 600;
+      break;
+#endif /* HAVE_BZLIB */
+    default:
+      bufSz = srcSz;
+      break;
+  }
+  if((buf = (WlzUByte *)AlcMalloc(bufSz)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    switch(codec)
+    {
+#if HAVE_ZLIB != 0
+      case WLZ_CHUNK_CODEC_ZLIB:
+	{
+	  uLongf zSz;
+
+	  zSz = bufSz;
+	  if(compress2(buf, &zSz, src, srcSz, Z_DEFAULT_COMPRESSION) == Z_OK)
+	  {
+	    cmpSz = zSz;
+	  }
+	}
+	break;
+#endif /* HAVE_ZLIB */
+#if HAVE_BZLIB != 0
+      case WLZ_CHUNK_CODEC_BZIP2:
+	{
+	  unsigned int bSz;
+
+	  bSz = bufSz;
+	  if(BZ2_bzBuffToBuffCompress((char *)buf, &bSz, (char *)src, srcSz,
+				      9, 0, 0) == BZ_OK)
+	  {
+	    cmpSz = bSz;
+	  }
+	}
+	break;
+#endif /* HAVE_BZLIB */
+      default:
+	break;
+    }
+    if((cmpSz == 0) || (cmpSz >= srcSz))
+    {
+      (void )memcpy(buf, src, srcSz);
+      cmpSz = srcSz;
+    }
+    *dstBuf = buf;
+    *dstSz = cmpSz;
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup 	WlzIO
@@ -1877,6 +2401,61 @@ static WlzErrorNum WlzWriteSpline(FILE *fP, WlzBSpline *bs)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup 	WlzIO
+* \brief	Writes an indexed mesh domain to the given file. The
+* 		vertex positions and element vertex indices are written
+* 		as contiguous blocks.
+* \param	fP			Given file.
+* \param	mesh			Indexed mesh domain.
+*/
+static WlzErrorNum WlzWriteIdxMesh(FILE *fP, WlzIdxMesh *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    if(putc(0,fP) == EOF)
+    {
+      errNum = WLZ_ERR_WRITE_EOF;
+    }
+  }
+  else
+  {
+    switch(mesh->type)
+    {
+      case WLZ_IDXMESH_TRI3D: /* FALLTHROUGH */
+      case WLZ_IDXMESH_TET3D:
+        break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      /* Write the mesh type, version and the numbers of vertices and
+       * elements. */
+      if((putc((unsigned int )mesh->type, fP) == EOF) ||
+	 (putc(1, fP) == EOF) ||
+	 !putword(mesh->nVtx, fP) ||
+	 !putword(mesh->nElm, fP))
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzWriteDouble(fP, mesh->vtx, 3 * mesh->nVtx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzWriteInt(fP, mesh->elm, mesh->nElmVtx * mesh->nElm);
+    }
+  }
+  return(errNum);
+}
+
 
 /*!
 * \return	Woolz error code.
@@ -3496,6 +4075,27 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
       }
     }
+    else if(tVal->cache != NULL)
+    {
+      size_t	idx,
+      		n;
+
+      /* Tiles loaded through a cache are written one at a time. */
+      n = tVal->tileSz * vSz;
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+      {
+        WlzTileCacheEntry *ent;
+
+	if((ent = WlzTileCacheAcquire(tVal, idx, &errNum)) != NULL)
+	{
+	  if(fwrite(ent->tile.v, gSz, n, fP) != n)
+	  {
+	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  }
+	  WlzTileCacheRelease(ent);
+	}
+      }
+    }
     else if(writeTiles != 0)
     {
       /* No tile data so reserve tile space in the file by seeking
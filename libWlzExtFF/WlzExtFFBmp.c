@@ -182,6 +182,8 @@ WlzErrorNum 	WlzEffWriteObjBmp2D(const char *fNameStr, WlzObject *obj,
     iHead.biClrUsed = 256;
     iHead.biClrImportant = 256;
     fHead.bfType = (WLZEFF_BMP_MAGIC_1) | ((WLZEFF_BMP_MAGIC_0) << 8);
+    fHead.bfReserved1 = 0;
+    fHead.bfReserved2 = 0;
     tI0 = sizeof(WLZEFF_BMP_UINT) + sizeof(WLZEFF_BMP_DWORD) +
 	  sizeof(WLZEFF_BMP_UINT) + sizeof(WLZEFF_BMP_UINT) +
 	  sizeof(WLZEFF_BMP_DWORD) + WLZEFF_BMP_WIN_NEW +
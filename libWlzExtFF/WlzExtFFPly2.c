@@ -251,6 +251,9 @@ WlzErrorNum	WlzEffWriteObjPly2(FILE *fP, WlzObject *obj)
       case WLZ_CONTOUR:
         errNum = WlzEffWriteObjCtrPly2(fP, obj);
 	break;
+      case WLZ_IDXMESH:
+        errNum = WlzEffWriteIdxMeshPly2(fP, obj->domain.idm);
+	break;
       default:
         errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
@@ -471,6 +474,77 @@ static WlzErrorNum WlzEffWriteObjCtrPly2(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given triangular indexed mesh to the given file
+* 		stream using the Riken PLY2 triangular mesh file format, see
+* 		WlzEffReadObjPly2(). This allows large surfaces to be
+* 		written without building a geometric model.
+* \param	fP			Output file stream.
+* \param	mesh			Given indexed mesh.
+*/
+WlzErrorNum	WlzEffWriteIdxMeshPly2(FILE *fP, WlzIdxMesh *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_IDXMESH_TRI3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  /* Output the number of vertices and faces. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fprintf(fP, "%d\n%d\n", mesh->nVtx, mesh->nElm) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  /* Output the vertex positions. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idV;
+    double	*v;
+
+    v = mesh->vtx;
+    for(idV = 0; idV < mesh->nVtx; ++idV)
+    {
+      if(fprintf(fP, "%lg\n%lg\n%lg\n", v[0], v[1], v[2]) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      v += 3;
+    }
+  }
+  /* Output the vertex indices for the faces. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE;
+    int		*e;
+
+    e = mesh->elm;
+    for(idE = 0; idE < mesh->nElm; ++idE)
+    {
+      if(fprintf(fP, "3\n%d\n%d\n%d\n", e[0], e[1], e[2]) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      e += 3;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	String with requested number of space seperated fields.
 * \ingroup	WlzExtFF
@@ -213,6 +213,9 @@ extern WlzObject 		*WlzEffReadObjPly2(
 extern WlzErrorNum 		WlzEffWriteObjPly2(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxMeshPly2(
+				  FILE *fP,
+				  WlzIdxMesh *mesh);
 
 /* From WlzExtFFPnm.c */
 extern WlzObject 		*WlzEffReadObjPnm(
@@ -290,6 +293,9 @@ extern WlzErrorNum		WlzEffWritePointsVtkScalarValues(
 extern WlzErrorNum		WlzEffWritePointsVtkFieldValues(
 				  FILE *fP, 
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxMeshVtk(
+				  FILE *fP,
+				  WlzIdxMesh *mesh);
 /* From WlzExtFFSlc.c */
 extern WlzObject 		*WlzEffReadObjSlc(
 				  FILE *fP,
@@ -303,6 +309,12 @@ extern WlzObject 		*WlzEffReadObjStack(
 				  const char *gvnFileName,
 				  WlzEffFormat fFmt,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzEffReadObjStackTiled(
+				  const char *gvnFileName,
+				  WlzEffFormat fFmt,
+				  size_t tileSz,
+				  const char *tlFileName,
+				  WlzErrorNum *dstErr);
 extern WlzErrorNum 		WlzEffWriteObjStack(
 				  const char *gvnFileName,
 				  WlzEffFormat fFmt,
@@ -315,6 +327,9 @@ extern WlzObject       		*WlzEffReadObjStl(
 extern WlzErrorNum     		WlzEffWriteObjStl(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxMeshStl(
+				  FILE *fP,
+				  WlzIdxMesh *mesh);
 /* From WlzExtFFIPL.c */
 extern WlzObject 		*WlzEffReadObjIPL(
 				  FILE *fP,
@@ -331,6 +346,12 @@ extern WlzObject 		*WlzEffReadObjTiff(
 				  const char *tiffFileName,
 				  int	split,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzEffReadObjTiffTiles(
+				  const char *tiffFileName,
+				  int dir,
+				  WlzIBox2 *roi,
+				  size_t tileSz,
+				  WlzErrorNum *dstErr);
 
 /* From WlzExtFFJpeg.c */
 extern WlzObject		*WlzEffReadObjJpeg(
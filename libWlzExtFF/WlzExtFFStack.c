@@ -48,6 +48,12 @@ static char _WlzExtFFStack_c[] = "University of Edinburgh $Id$";
 static WlzObject 		*WlzEffReadObjStack3D(
 				  const char *gvnFileName,
 				  WlzEffFormat fFmt,
+				  size_t tileSz,
+				  const char *tlFileName,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzEffReadObjStackMapTiles(
+				  WlzObject *tObj,
+				  const char *tlFileName,
 				  WlzErrorNum *dstErr);
 static WlzObject 		*WlzEffReadObjStack2D(
 				  FILE *fP,
@@ -97,12 +103,52 @@ static WlzErrorNum 		WlzEffWriteObjStack2D(
 */
 WlzObject	*WlzEffReadObjStack(const char *gvnFileName, WlzEffFormat fFmt,
 				    WlzErrorNum *dstErr)
+{
+  return(WlzEffReadObjStackTiled(gvnFileName, fFmt, 0, NULL, dstErr));
+}
+
+/*!
+* \return	Object read from file.
+* \ingroup	WlzExtFF
+* \brief	Reads a Woolz object from the given file(s) using the given
+* 		(2D) file format, optionally writing the values straight
+* 		into a tiled value table in the given tiled values file.
+*
+* 		The slice files of a stack are decoded concurrently, with
+* 		at most one slice being decoded by each thread at a time.
+* 		Without tiling the slices are read directly into the
+* 		planes of the returned object's value table.
+* 		With tiling the tiled values file is first written with
+* 		space reserved for the tiles and then opened for update,
+* 		so that the tiles of the returned object are memory mapped
+* 		to the file. Each slice is read into a per thread buffer
+* 		and copied into the tiles, so only one slice per thread
+* 		is held in memory, with the tiles being paged to and from
+* 		the file as needed. If the tiles can not be memory mapped
+* 		then they are held in memory and the tiled values file is
+* 		rewritten once all the slices have been read.
+* \param	gvnFileName		Given file name.
+* \param	fFmt			Given file format (must be a 2D
+*					file format).
+* \param	tileSz			Number of values in each tile of a
+* 					tiled value table (see
+* 					WlzMakeTiledValuesObj3D()), or zero
+* 					for a non-tiled value table.
+* \param	tlFileName		Tiled values file name, required
+* 					if the tile size is non-zero.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+WlzObject	*WlzEffReadObjStackTiled(const char *gvnFileName,
+					 WlzEffFormat fFmt, size_t tileSz,
+					 const char *tlFileName,
+					 WlzErrorNum *dstErr)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzObject	*obj = NULL;
   FILE		*fP = NULL;
 
-  if(gvnFileName == NULL)
+  if((gvnFileName == NULL) || (tileSz && (tlFileName == NULL)))
   {
     errNum = WLZ_ERR_PARAM_NULL;
   }
@@ -110,7 +156,8 @@ WlzObject	*WlzEffReadObjStack(const char *gvnFileName, WlzEffFormat fFmt,
   {
     if((fP = fopen(gvnFileName, "r")) == NULL)
     {
-      obj = WlzEffReadObjStack3D(gvnFileName, fFmt, &errNum);
+      obj = WlzEffReadObjStack3D(gvnFileName, fFmt, tileSz, tlFileName,
+				 &errNum);
     }
     else
     {
@@ -124,6 +171,24 @@ WlzObject	*WlzEffReadObjStack(const char *gvnFileName, WlzEffFormat fFmt,
     }
 #endif
       obj = WlzEffReadObjStack2D(fP, fFmt, &errNum);
+      if((errNum == WLZ_ERR_NONE) && tileSz)
+      {
+	WlzObject *tObj;
+
+	/* A single slice is small enough to tile in memory before it
+	 * is written to the tiled values file. */
+	tObj = WlzAssignObject(
+	       WlzMakeTiledValuesFromObj(obj, tileSz, 1, WLZ_GREY_UBYTE,
+					 0, NULL, WlzGetBackground(obj, NULL),
+					 &errNum), NULL);
+	(void )WlzFreeObj(obj);
+	obj = NULL;
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  obj = WlzEffReadObjStackMapTiles(tObj, tlFileName, &errNum);
+	}
+	(void )WlzFreeObj(tObj);
+      }
     }
     if(fP)
     {
@@ -322,13 +387,9 @@ static WlzErrorNum WlzEffWriteObjStack3D(const char *fPathStr,
 		tI1,
 		planeIdx,
   		planeOff;
-  WlzObject	*obj2D = NULL;
   WlzIVertex2	imgSz2D,
   		imgOrg2D;
-  WlzDomain	dom2D;
-  WlzValues	val2D;
   WlzPixelV	bgdV;
-  unsigned char	*data = NULL;
   char		*fNameStr = NULL;
   FILE		*fP = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -339,9 +400,7 @@ static WlzErrorNum WlzEffWriteObjStack3D(const char *fPathStr,
   imgSz2D.vtY = obj->domain.p->lastln - imgOrg2D.vtY + 1;
   tI0 = strlen(fPathStr) + strlen(fBodyStr) + strlen(fExtStr) + 16;
   tI1 = imgSz2D.vtX * imgSz2D.vtY;
-  if(((fNameStr = AlcMalloc(tI0 * sizeof(char))) == NULL) ||
-     ((data = (unsigned char *)AlcMalloc(tI1 *
-     				         sizeof(unsigned char))) == NULL))
+  if((fNameStr = AlcMalloc(tI0 * sizeof(char))) == NULL)
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
@@ -407,51 +466,81 @@ static WlzErrorNum WlzEffWriteObjStack3D(const char *fPathStr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    planeOff = 0;
-    planeIdx = obj->domain.p->plane1;
     bgdV = WlzGetBackground(obj, &errNum);
   }
+  /* Write the slices in parallel, each thread having it's own file name
+   * and image buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
+    int		nPl;
+
     (void )WlzValueConvertPixel(&(bgdV), bgdV, WLZ_GREY_UBYTE);
-    while((planeIdx <= obj->domain.p->lastpl) && (errNum == WLZ_ERR_NONE))
+    nPl = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      dom2D = *(obj->domain.p->domains + planeOff);
-      val2D = *(obj->values.vox->values + planeOff);
-      sprintf(fNameStr, "%s%s%0*d.%s",
-      	      fPathStr, fBodyStr, WLZEFF_STACK_NAMEDIGITS, planeIdx, fExtStr);
-      if(dom2D.core && val2D.core)
-      {
-	obj2D = WlzAssignObject(WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2D, val2D,
-					 NULL, NULL, &errNum), NULL);
-      }
-      else
+      char	*tNameStr = NULL;
+      unsigned char *tData = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(((tNameStr = AlcMalloc(tI0 * sizeof(char))) == NULL) ||
+	 ((tData = (unsigned char *)AlcMalloc(tI1 *
+					      sizeof(unsigned char))) == NULL))
       {
-	obj2D = NULL;
+	errNum2 = WLZ_ERR_MEM_ALLOC;
       }
-      if(errNum == WLZ_ERR_NONE)
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(planeOff = 0; planeOff < nPl; ++planeOff)
       {
-	errNum = WlzEffWriteObjStack2D(fNameStr, fFmt,
-				       obj2D, imgSz2D, imgOrg2D,
-				       data, bgdV.v.ubv);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  WlzDomain	dom2D;
+	  WlzValues	val2D;
+	  WlzObject	*obj2D = NULL;
+
+	  dom2D = *(obj->domain.p->domains + planeOff);
+	  val2D = *(obj->values.vox->values + planeOff);
+	  sprintf(tNameStr, "%s%s%0*d.%s",
+		  fPathStr, fBodyStr, WLZEFF_STACK_NAMEDIGITS,
+		  obj->domain.p->plane1 + planeOff, fExtStr);
+	  if(dom2D.core && val2D.core)
+	  {
+	    obj2D = WlzAssignObject(WlzMakeMain(WLZ_2D_DOMAINOBJ,
+						dom2D, val2D,
+						NULL, NULL, &errNum2), NULL);
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    errNum2 = WlzEffWriteObjStack2D(tNameStr, fFmt,
+					    obj2D, imgSz2D, imgOrg2D,
+					    tData, bgdV.v.ubv);
+	  }
+	  if(obj2D)
+	  {
+	    WlzFreeObj(obj2D);
+	  }
+	}
       }
-      if(obj2D)
+#ifdef _OPENMP
+#pragma omp critical (WlzEffWriteObjStack3D)
+#endif
       {
-	WlzFreeObj(obj2D);
-	obj2D = NULL;
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
       }
-      ++planeOff;
-      ++planeIdx;
+      AlcFree(tNameStr);
+      AlcFree(tData);
     }
   }
   if(fNameStr)
   {
     AlcFree(fNameStr);
   }
-  if(data)
-  {
-    AlcFree(data);
-  }
   return(errNum);
 }
 
@@ -541,15 +630,22 @@ static WlzErrorNum WlzEffReadObjStackData2D(FILE *fP, WlzEffFormat fFmt,
 * \return	Object read from file.
 * \ingroup	WlzExtFF
 * \brief	Reads a 3D Woolz object from the given file(s) using the given
-* 		(2D) file format.
+* 		(2D) file format. The control file is parsed first and then
+*		the slice files are decoded in parallel.
 * \param	gvnFileName		Given file name.
 * \param	fFmt			Given file format (must be a 2D file
 * 					format).
+* \param	tileSz			Tile size for a tiled value table,
+* 					zero for a non-tiled value table.
+* \param	tlFileName		Tiled values file name, only used
+* 					if the tile size is non-zero.
 * \param	dstErr			Destination error number ptr, may be
 * 					NULL.
 */
 static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
 				       WlzEffFormat fFmt,
+				       size_t tileSz,
+				       const char *tlFileName,
 				       WlzErrorNum *dstErr)
 {
   int		tI0,
@@ -562,8 +658,8 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
   		*fBodyStr = NULL,
   		*fExtStr = NULL,
 		*fCtrStr = NULL;
-  FILE		*fP = NULL,
-  		*fP2D = NULL;
+  char		**fNames = NULL;
+  FILE		*fP = NULL;
   WlzIVertex2	imgSz2D;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzObject	*obj = NULL;
@@ -602,13 +698,14 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
       }
     }
   }
+  /* Collect the slice file names from the control file. */
   if(errNum == WLZ_ERR_NONE)
   {
     imgSz2D.vtX = header.volSize.vtX;
     imgSz2D.vtY = header.volSize.vtY;
-    if((AlcUnchar3Malloc(&data, header.volSize.vtZ, header.volSize.vtY,
-			 header.volSize.vtX) != ALC_ER_NONE) ||
-       (data == NULL))
+    tI0 = strlen(fPathStr) + WLZEFF_STACK_CTR_RECORDMAX;
+    if((AlcChar2Malloc(&fNames, header.volSize.vtZ, tI0) != ALC_ER_NONE) ||
+       (fNames == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
@@ -639,32 +736,162 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
 	}
 	else
 	{
-	  sprintf(fNameStr, "%s%s", fPathStr, recTok);
-	  if((fP2D = fopen(fNameStr, "r")) == NULL)
+	  sprintf(*(fNames + planeOff), "%s%s", fPathStr, recTok);
+	}
+      }
+      ++planeOff;
+      ++planeIdx;
+    }
+  }
+  if(fP)
+  {
+    fclose(fP);
+  }
+  /* Create either the destination array or the object with a tiled value
+   * table which has its tiles mapped to the tiled values file. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(tileSz == 0)
+    {
+      if((AlcUnchar3Malloc(&data, header.volSize.vtZ, header.volSize.vtY,
+			   header.volSize.vtX) != ALC_ER_NONE) ||
+	 (data == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    else
+    {
+      WlzObject	*cObj,
+      		*tObj = NULL;
+      WlzPixelV	bgdV;
+
+      bgdV.type = WLZ_GREY_UBYTE;
+      bgdV.v.ubv = 0;
+      cObj = WlzAssignObject(
+	     WlzMakeCuboidObject(WLZ_3D_DOMAINOBJ,
+				 0.5 * (header.volSize.vtX - 1),
+				 0.5 * (header.volSize.vtY - 1),
+				 0.5 * (header.volSize.vtZ - 1),
+				 header.volOrigin.vtX +
+				 (0.5 * (header.volSize.vtX - 1)),
+				 header.volOrigin.vtY +
+				 (0.5 * (header.volSize.vtY - 1)),
+				 header.volOrigin.vtZ +
+				 (0.5 * (header.volSize.vtZ - 1)),
+				 &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	cObj->domain.p->voxel_size[0] = header.voxSize.vtX;
+	cObj->domain.p->voxel_size[1] = header.voxSize.vtY;
+	cObj->domain.p->voxel_size[2] = header.voxSize.vtZ;
+	tObj = WlzAssignObject(
+	       WlzMakeTiledValuesObj3DNoTiles(cObj, tileSz, WLZ_GREY_UBYTE,
+					      0, NULL, bgdV, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	obj = WlzEffReadObjStackMapTiles(tObj, tlFileName, &errNum);
+      }
+      (void )WlzFreeObj(tObj);
+      (void )WlzFreeObj(cObj);
+    }
+  }
+  /* Decode the slices in parallel, either directly into the destination
+   * array or through a per thread buffer into the tiles. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      unsigned char **buf = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(obj &&
+	 ((AlcUnchar2Malloc(&buf, header.volSize.vtY,
+			    header.volSize.vtX) != ALC_ER_NONE) ||
+	  (buf == NULL)))
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(planeOff = 0; planeOff < header.volSize.vtZ; ++planeOff)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int		ln;
+	  FILE		*fP2D;
+	  WlzIVertex2	sz2D;
+
+	  sz2D = imgSz2D;
+	  if((fP2D = fopen(*(fNames + planeOff), "r")) == NULL)
 	  {
-	    errNum = WLZ_ERR_READ_EOF;
+	    errNum2 = WLZ_ERR_READ_EOF;
 	  }
 	  else
 	  {
-		    #ifdef _WIN32
-  if (fP2D != NULL){
-	if(_setmode(_fileno(fP2D), 0x8000) == -1)
-	{
-		errNum = WLZ_ERR_READ_EOF;
-	}
-  }
-  #endif
-	    errNum = WlzEffReadObjStackData2D(fP2D, fFmt, &imgSz2D,
-					      (data + planeOff));
+#ifdef _WIN32
+	    if(_setmode(_fileno(fP2D), 0x8000) == -1)
+	    {
+	      errNum2 = WLZ_ERR_READ_EOF;
+	    }
+#endif
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      errNum2 = WlzEffReadObjStackData2D(fP2D, fFmt, &sz2D,
+						 (obj)? &buf:
+						        (data + planeOff));
+	    }
 	    fclose(fP2D);
 	  }
+	  if((errNum2 == WLZ_ERR_NONE) && obj)
+	  {
+	    for(ln = 0; ln < sz2D.vtY; ++ln)
+	    {
+	      WlzGreyP	gP;
+
+	      gP.ubp = *(buf + ln);
+	      WlzTiledValuesCopyLine(obj->values.t, gP, planeOff, ln,
+				     0, sz2D.vtX - 1);
+	    }
+	  }
 	}
       }
-      ++planeOff;
-      ++planeIdx;
+#ifdef _OPENMP
+#pragma omp critical (WlzEffReadObjStack3D)
+#endif
+      {
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      if(buf)
+      {
+        Alc2Free((void **)buf);
+      }
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  /* Tiles which could not be memory mapped are held in memory, so write
+   * them to the tiled values file now that they have been set. */
+  if((errNum == WLZ_ERR_NONE) && obj && (obj->values.t->fd < 0))
+  {
+    FILE	*tlFP;
+
+    if((tlFP = fopen(tlFileName, "wb")) == NULL)
+    {
+      errNum = WLZ_ERR_WRITE_EOF;
+    }
+    else
+    {
+      errNum = WlzWriteObj(tlFP, obj);
+      (void )fclose(tlFP);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
   {
     obj = WlzFromArray3D((void ***)data, header.volSize, header.volOrigin,
     			 WLZ_GREY_UBYTE, WLZ_GREY_UBYTE,
@@ -676,6 +903,11 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
     obj->domain.p->voxel_size[1] = header.voxSize.vtY;
     obj->domain.p->voxel_size[2] = header.voxSize.vtZ;
   }
+  else if(obj)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
   if(data)
   {
     if(obj)
@@ -686,15 +918,12 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
     }
     else
     {
-      if(data)
-      {
-	Alc3Free((void ***)data);
-      }
+      Alc3Free((void ***)data);
     }
   }
-  if(dstErr)
+  if(fNames)
   {
-    *dstErr = errNum;
+    Alc2Free((void **)fNames);
   }
   if(fNameStr)
   {
@@ -723,6 +952,57 @@ static WlzObject *WlzEffReadObjStack3D(const char *gvnFileName,
   return(obj);
 }
 
+/*!
+* \return	Object with its tiles mapped to the tiled values file,
+* 		NULL on error.
+* \ingroup	WlzExtFF
+* \brief	Writes the given object, which has a tiled value table, to
+* 		the given tiled values file and then reads it back with the
+* 		file opened for update. Where memory mapping is supported
+* 		the tiles of the returned object are then mapped to the
+* 		file, so that values set in the tiles are written to it.
+* \param	tObj			Given object with a tiled value table,
+* 					its tiles need not be allocated.
+* \param	tlFileName		Tiled values file name.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+static WlzObject *WlzEffReadObjStackMapTiles(WlzObject *tObj,
+					     const char *tlFileName,
+					     WlzErrorNum *dstErr)
+{
+  FILE		*fP;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP = fopen(tlFileName, "wb")) == NULL)
+  {
+    errNum = WLZ_ERR_WRITE_EOF;
+  }
+  else
+  {
+    errNum = WlzWriteObj(fP, tObj);
+    (void )fclose(fP);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fP = fopen(tlFileName, "rb+")) == NULL)
+    {
+      errNum = WLZ_ERR_READ_EOF;
+    }
+    else
+    {
+      obj = WlzReadObj(fP, &errNum);
+      (void )fclose(fP);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
@@ -340,6 +340,9 @@ WlzErrorNum	WlzEffWriteObjStl(FILE *fP, WlzObject *obj)
       case WLZ_CONTOUR:
         errNum = WlzEffWriteObjCtrStl(fP, obj);
 	break;
+      case WLZ_IDXMESH:
+        errNum = WlzEffWriteIdxMeshStl(fP, obj->domain.idm);
+	break;
       default:
         errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
@@ -531,6 +534,87 @@ static WlzErrorNum WlzEffWriteObjCtrStl(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given triangular indexed mesh to the given file
+* 		stream using the stereolithography stl file format, see
+* 		WlzEffReadObjStl(). This allows large surfaces to be written
+* 		without building a geometric model.
+* \param	fP			Output file stream.
+* \param	mesh			Given indexed mesh.
+*/
+WlzErrorNum	WlzEffWriteIdxMeshStl(FILE *fP, WlzIdxMesh *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_IDXMESH_TRI3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fprintf(fP, "solid ascii\n") <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE;
+
+    for(idE = 0; idE < mesh->nElm; ++idE)
+    {
+      int	idV;
+      WlzDVertex3 nrm;
+      WlzDVertex3 vBuf[3];
+
+      for(idV = 0; idV < 3; ++idV)
+      {
+        double	*v;
+
+	v = mesh->vtx + 3 * mesh->elm[3 * idE + idV];
+	vBuf[idV].vtX = v[0];
+	vBuf[idV].vtY = v[1];
+	vBuf[idV].vtZ = v[2];
+      }
+      nrm = WlzGeomTriangleNormal(vBuf[0], vBuf[1], vBuf[2]);
+      if(fprintf(fP,
+		 "  facet normal %g %g %g\n"
+		 "    outer loop\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "    endloop\n"
+		 "  endfacet\n",
+		 nrm.vtX, nrm.vtY, nrm.vtZ,
+		 vBuf[0].vtX, vBuf[0].vtY, vBuf[0].vtZ,
+		 vBuf[1].vtX, vBuf[1].vtY, vBuf[1].vtZ,
+		 vBuf[2].vtX, vBuf[2].vtY, vBuf[2].vtZ) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fprintf(fP, "endsolid\n") <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	String with requested number of space seperated fields.
 * \ingroup	WlzExtFF
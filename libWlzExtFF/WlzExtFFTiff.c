@@ -58,8 +58,8 @@ static WlzErrorNum setPixelProperties(
   WlzPixelV	*bckgrndRtn)
 {
   WlzErrorNum	errNum=WLZ_ERR_NONE;
-  int		wlzDepth;
-  WlzGreyType	newpixtype;
+  int		wlzDepth = sizeof(char);
+  WlzGreyType	newpixtype = WLZ_GREY_UBYTE;
   WlzPixelV	bckgrnd;
 
   switch( samplesperpixel ){
@@ -157,6 +157,87 @@ static WlzErrorNum setPixelProperties(
   return errNum;
 }
 
+static WlzErrorNum WlzExtFFTiffDirProperties(
+  TIFF		*tif,
+  short		*bitspersampleRtn,
+  short		*samplesperpixelRtn,
+  short		*photometricRtn,
+  int		*wlzDepthRtn,
+  WlzGreyType	*newpixtypeRtn,
+  WlzPixelV	*bckgrndRtn,
+  unsigned char	red[],
+  unsigned char	green[],
+  unsigned char	blue[])
+{
+  WlzErrorNum	errNum=WLZ_ERR_NONE;
+  short		bitspersample = 1;
+  short		samplesperpixel = 1;
+  short		sampleformat;
+  short		photometric = PHOTOMETRIC_MINISBLACK;
+  unsigned short *redcolormap, *bluecolormap, *greencolormap;
+  int		i, numcolors;
+
+  /* determine depth and pixel type */
+  TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
+  TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
+  if( TIFFGetField(tif, TIFFTAG_SAMPLEFORMAT, &sampleformat) == 0 ){
+    sampleformat = SAMPLEFORMAT_UINT;
+  }
+  errNum = setPixelProperties(bitspersample, samplesperpixel, sampleformat,
+			      wlzDepthRtn, newpixtypeRtn, bckgrndRtn);
+
+  /* determine color mapping */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    numcolors = (1 << bitspersample);
+    TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+    if( numcolors > 2 ){
+      switch (photometric) {
+      case PHOTOMETRIC_MINISBLACK:
+      case PHOTOMETRIC_MINISWHITE:
+      case PHOTOMETRIC_RGB:
+	break;
+
+      case PHOTOMETRIC_PALETTE:
+	/* the color tables only have room for 8 bit indices */
+	if( bitspersample > 8 ){
+	  errNum = WLZ_ERR_IMAGE_TYPE;
+	  break;
+	}
+	memset(red, 0, 256);
+	memset(green, 0, 256);
+	memset(blue, 0, 256);
+	TIFFGetField(tif, TIFFTAG_COLORMAP,
+		     &redcolormap, &greencolormap, &bluecolormap);
+	for (i = 0; i < numcolors; i++) {
+	  red[i] = (unsigned char) CVT(redcolormap[i]);
+	  green[i] = (unsigned char) CVT(greencolormap[i]);
+	  blue[i] = (unsigned char) CVT(bluecolormap[i]);
+	  if( (red[i] != green[i]) || (red[i] != blue[i]) ){
+	    *wlzDepthRtn = sizeof(int);
+	    *newpixtypeRtn = WLZ_GREY_RGBA;
+	    bckgrndRtn->type = WLZ_GREY_RGBA;
+	    bckgrndRtn->v.rgbv = 0x0;
+	  }
+	}
+	break;
+
+      case PHOTOMETRIC_MASK:
+      default:
+	errNum = WLZ_ERR_IMAGE_TYPE;
+	break;
+      }
+    }
+  }
+
+  /* set return values */
+  *bitspersampleRtn = bitspersample;
+  *samplesperpixelRtn = samplesperpixel;
+  *photometricRtn = photometric;
+
+  return errNum;
+}
+
 static unsigned char *WlzEFFTiffToWlzRowData(
   unsigned char	*inp,
   unsigned char	*dstPtr,
@@ -352,17 +433,14 @@ static WlzObject *WlzExtFFReadTiffDirObj(
   WlzErrorNum	errNum=WLZ_ERR_NONE;
   short		bitspersample;
   short		samplesperpixel;
-  short		sampleformat;
   short		photometric;
-  unsigned short *Map=NULL;
-  unsigned short *redcolormap, *bluecolormap, *greencolormap;
   unsigned char red[256], green[256], blue[256];
-  int		width, height, numcolors;
+  int		width, height;
   int		len, tileWidth, tileHeight;
   int		wlzDepth;
   WlzGreyType	newpixtype;
   WlzPixelV	bckgrnd;
-  int		i, row, col, tileIndx = 0;
+  int		row, col, tileIndx = 0;
   WlzLong	y;
   float		xPosition, yPosition;
   int		colMin, rowMin;
@@ -374,64 +452,10 @@ static WlzObject *WlzExtFFReadTiffDirObj(
      but do need to set the directory */
   TIFFSetDirectory(tif, dir);
 
-  /* determine depth and pixel type */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
-    TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
-    if( TIFFGetField(tif, TIFFTAG_SAMPLEFORMAT, &sampleformat) == 0 ){
-      sampleformat = SAMPLEFORMAT_UINT;
-    }
-    errNum = setPixelProperties(bitspersample, samplesperpixel, sampleformat,
-				&wlzDepth, &newpixtype, &bckgrnd);
-  }
-
-  /* determine color mapping */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    numcolors = (1 << bitspersample);
-    TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
-    if( numcolors > 2 ){
-      switch (photometric) {
-      case PHOTOMETRIC_MINISBLACK:
-	Map = (unsigned short *) AlcMalloc(numcolors * sizeof(unsigned short));
-	for (i = 0; i < numcolors; i++)
-	  Map[i] = ((numcolors-1) * i) / numcolors;
-	break;
-
-      case PHOTOMETRIC_MINISWHITE:
-	Map = (unsigned short *) AlcMalloc(numcolors * sizeof(unsigned short));
-	for (i = 0; i < numcolors; i++)
-	  Map[i] = (numcolors-1) - (((numcolors-1) * i) / numcolors);
-	break;
-
-      case PHOTOMETRIC_RGB:
-	break;
-
-      case PHOTOMETRIC_PALETTE:
-	memset(red, 0, sizeof(red));
-	memset(green, 0, sizeof(green));
-	memset(blue, 0, sizeof(blue));
-	TIFFGetField(tif, TIFFTAG_COLORMAP,
-		     &redcolormap, &greencolormap, &bluecolormap);
-	for (i = 0; i < numcolors; i++) {
-	  red[i] = (unsigned char) CVT(redcolormap[i]);
-	  green[i] = (unsigned char) CVT(greencolormap[i]);
-	  blue[i] = (unsigned char) CVT(bluecolormap[i]);
-	  if( (red[i] != green[i]) || (red[i] != blue[i]) ){
-	    wlzDepth = sizeof(int);
-	    newpixtype = WLZ_GREY_RGBA;
-	  }
-	}
-	break;
-
-      case PHOTOMETRIC_MASK:
-      default:
-	errNum = WLZ_ERR_IMAGE_TYPE;
-	break;
-      }
-    }
-  }
+  /* determine depth, pixel type and color mapping */
+  errNum = WlzExtFFTiffDirProperties(tif, &bitspersample, &samplesperpixel,
+				     &photometric, &wlzDepth, &newpixtype,
+				     &bckgrnd, red, green, blue);
 
   /* establish data size */
   if(errNum == WLZ_ERR_NONE){
@@ -578,10 +602,6 @@ static WlzObject *WlzExtFFReadTiffDirObj(
   if( buf ){
     AlcFree(buf);
   }
-  if( Map ){
-    AlcFree( Map );
-  }
-  
   if(dstErr)
   {
     *dstErr = errNum;
@@ -589,6 +609,355 @@ static WlzObject *WlzExtFFReadTiffDirObj(
   return obj;
 }
 
+/*!
+* \return	Object read from file.
+* \ingroup	WlzExtFF
+* \brief	Reads a single directory (image plane) of a TIFF file,
+* 		decoding its tiles, or its strips if the image is not
+* 		tiled, in parallel directly into one preallocated value
+* 		table.
+*
+* 		Each thread opens its own handle on the file and converts
+* 		the rows of the tiles or strips it decodes straight into
+* 		the value table of the returned object, so no per tile
+* 		objects or whole image buffers are created. If a region
+* 		of interest is given then only the tiles or strips which
+* 		intersect it are decoded and the returned object covers
+* 		just the intersection of the region with the image. An
+* 		empty object is returned if they do not intersect.
+*
+* 		If the Woolz tile size is zero the returned object has a
+* 		rectangular value table, otherwise it has a tiled value
+* 		table (see WlzMakeTiledValuesObj2D()). When the TIFF tiles
+* 		are square with a power of two width and the region is
+* 		aligned with them, using a Woolz tile size equal to the
+* 		number of pixels in a TIFF tile maps each TIFF tile onto
+* 		a single Woolz tile.
+* \param	tiffFileName		Given file name.
+* \param	dir			TIFF directory (plane) to read.
+* \param	roi			Region of interest in the same
+* 					coordinates as the object returned
+* 					by WlzEffReadObjTiff(), may be NULL
+* 					to read the whole image.
+* \param	tileSz			Number of values in each Woolz tile,
+* 					zero for a rectangular value table.
+* \param	dstErr			Destination error number ptr, may be
+* 					NULL.
+*/
+WlzObject	*WlzEffReadObjTiffTiles(
+  const char	*tiffFileName,
+  int		dir,
+  WlzIBox2	*roi,
+  size_t	tileSz,
+  WlzErrorNum	*dstErr)
+{
+  TIFF 		*tif = NULL;
+  short		bitspersample,
+		samplesperpixel,
+		photometric,
+		planarconfig = PLANARCONFIG_CONTIG;
+  unsigned char red[256], green[256], blue[256];
+  int		width = 0,
+		height = 0,
+		tiled = 0,
+		wlzDepth,
+		rowsPerStrip;
+  float		xPosition,
+		yPosition;
+  WlzIVertex2	org,
+		chunkSz,
+		bMin,
+		bMax,
+		cMin = {0},
+		cMax = {0};
+  WlzGreyType	newpixtype;
+  WlzPixelV	bckgrnd;
+  WlzUByte	*data = NULL;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tiffFileName == NULL) || (*tiffFileName == '\0'))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((tif = TIFFOpen(tiffFileName, "rb")) == NULL)
+  {
+    errNum = WLZ_ERR_READ_EOF;
+  }
+  else if((dir < 0) || (TIFFSetDirectory(tif, dir) != 1))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  /* Get the image properties, its position and how it is chunked. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzExtFFTiffDirProperties(tif, &bitspersample, &samplesperpixel,
+				       &photometric, &wlzDepth, &newpixtype,
+				       &bckgrnd, red, green, blue);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
+    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
+    TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarconfig);
+    if(TIFFGetField(tif, TIFFTAG_XPOSITION, &xPosition) != 1)
+    {
+      xPosition = 0.0;
+    }
+    if(TIFFGetField(tif, TIFFTAG_YPOSITION, &yPosition) != 1)
+    {
+      yPosition = 0.0;
+    }
+    org.vtX = WLZ_NINT(xPosition);
+    org.vtY = WLZ_NINT(yPosition);
+    if((tiled = TIFFIsTiled(tif)) != 0)
+    {
+      TIFFGetField(tif, TIFFTAG_TILEWIDTH, &(chunkSz.vtX));
+      TIFFGetField(tif, TIFFTAG_TILELENGTH, &(chunkSz.vtY));
+    }
+    else
+    {
+      if((TIFFGetField(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip) != 1) ||
+         (rowsPerStrip > height))
+      {
+        rowsPerStrip = height;
+      }
+      chunkSz.vtX = width;
+      chunkSz.vtY = rowsPerStrip;
+    }
+    if((width <= 0) || (height <= 0) ||
+       (chunkSz.vtX <= 0) || (chunkSz.vtY <= 0))
+    {
+      errNum = WLZ_ERR_FILE_FORMAT;
+    }
+    else if(planarconfig != PLANARCONFIG_CONTIG)
+    {
+      errNum = WLZ_ERR_IMAGE_TYPE;
+    }
+  }
+  /* Find the region to be read, in image coordinates, together with the
+   * range of tiles or strips that it intersects. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bMin.vtX = 0;
+    bMin.vtY = 0;
+    bMax.vtX = width - 1;
+    bMax.vtY = height - 1;
+    if(roi)
+    {
+      bMin.vtX = WLZ_MAX(bMin.vtX, roi->xMin - org.vtX);
+      bMin.vtY = WLZ_MAX(bMin.vtY, roi->yMin - org.vtY);
+      bMax.vtX = WLZ_MIN(bMax.vtX, roi->xMax - org.vtX);
+      bMax.vtY = WLZ_MIN(bMax.vtY, roi->yMax - org.vtY);
+    }
+    if((bMin.vtX > bMax.vtX) || (bMin.vtY > bMax.vtY))
+    {
+      obj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      cMin.vtX = bMin.vtX / chunkSz.vtX;
+      cMin.vtY = bMin.vtY / chunkSz.vtY;
+      cMax.vtX = bMax.vtX / chunkSz.vtX;
+      cMax.vtY = bMax.vtY / chunkSz.vtY;
+    }
+  }
+  /* Make the object with either a rectangular or tiled value table. */
+  if((errNum == WLZ_ERR_NONE) && (obj == NULL))
+  {
+    if(tileSz == 0)
+    {
+      if((data = (WlzUByte *)AlcCalloc((WlzLong )(bMax.vtX - bMin.vtX + 1) *
+				       (WlzLong )(bMax.vtY - bMin.vtY + 1),
+				       wlzDepth)) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else if((obj = WlzMakeRect(bMin.vtY + org.vtY, bMax.vtY + org.vtY,
+			         bMin.vtX + org.vtX, bMax.vtX + org.vtX,
+			         newpixtype, (int *)data, bckgrnd,
+			         NULL, NULL, &errNum)) == NULL)
+      {
+        AlcFree(data);
+      }
+      else
+      {
+	AlcErrno	errAlcNum;
+
+	obj->values.r->freeptr = AlcFreeStackPush(obj->values.r->freeptr,
+						  (void *)data, &errAlcNum);
+	if(errAlcNum != ALC_ER_NONE)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
+    }
+    else
+    {
+      WlzDomain	dom;
+      WlzValues	val;
+      WlzObject	*rObj = NULL;
+
+      val.core = NULL;
+      if((dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+				        bMin.vtY + org.vtY, bMax.vtY + org.vtY,
+				        bMin.vtX + org.vtX, bMax.vtX + org.vtX,
+				        &errNum)) != NULL)
+      {
+        if((rObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val,
+			       NULL, NULL, &errNum)) == NULL)
+	{
+	  (void )WlzFreeDomain(dom);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	rObj = WlzAssignObject(rObj, NULL);
+	obj = WlzMakeTiledValuesObj2D(rObj, tileSz, 0, newpixtype, 0, NULL,
+				      bckgrnd, &errNum);
+      }
+      (void )WlzFreeObj(rObj);
+    }
+  }
+  /* Decode the tiles or strips in parallel, each thread having it's own
+   * TIFF handle and buffers. The tiles and strips are disjoint so each
+   * thread writes to it's own values within the value table. */
+  if((errNum == WLZ_ERR_NONE) && (obj->type == WLZ_2D_DOMAINOBJ))
+  {
+    int		idC,
+		nC,
+		nCX,
+		rowWidth;
+
+    nCX = cMax.vtX - cMin.vtX + 1;
+    nC = nCX * (cMax.vtY - cMin.vtY + 1);
+    rowWidth = bMax.vtX - bMin.vtX + 1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      TIFF	*tTif = NULL;
+      WlzLong	rowSz = 0;
+      unsigned char *buf = NULL,
+		*rowBuf = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(((tTif = TIFFOpen(tiffFileName, "rb")) == NULL) ||
+         (TIFFSetDirectory(tTif, dir) != 1))
+      {
+	errNum2 = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else if(((buf = (unsigned char *)
+		      AlcMalloc((tiled)? TIFFTileSize(tTif):
+					 TIFFStripSize(tTif))) == NULL) ||
+	      ((rowBuf = (unsigned char *)
+			 AlcMalloc(((chunkSz.vtX + 7) & ~7) *
+				   wlzDepth)) == NULL))
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	rowSz = (tiled)? TIFFTileRowSize(tTif): TIFFScanlineSize(tTif);
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for(idC = 0; idC < nC; ++idC)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int		ln,
+			len;
+	  WlzIVertex2	c,
+			k0,
+			k1;
+
+	  /* Decode the tile or strip. */
+	  c.vtX = (cMin.vtX + (idC % nCX)) * chunkSz.vtX;
+	  c.vtY = (cMin.vtY + (idC / nCX)) * chunkSz.vtY;
+	  if(tiled)
+	  {
+	    if(TIFFReadTile(tTif, buf, c.vtX, c.vtY, 0, 0) < 0)
+	    {
+	      errNum2 = WLZ_ERR_FILE_FORMAT;
+	    }
+	  }
+	  else if(TIFFReadEncodedStrip(tTif, c.vtY / chunkSz.vtY,
+				       buf, -1) < 0)
+	  {
+	    errNum2 = WLZ_ERR_FILE_FORMAT;
+	  }
+	  /* Convert each of it's rows which intersect the region directly
+	   * into the value table. */
+	  len = WLZ_MIN(chunkSz.vtX, width - c.vtX);
+	  k0.vtX = WLZ_MAX(c.vtX, bMin.vtX);
+	  k0.vtY = WLZ_MAX(c.vtY, bMin.vtY);
+	  k1.vtX = WLZ_MIN(c.vtX + len - 1, bMax.vtX);
+	  k1.vtY = WLZ_MIN(c.vtY + chunkSz.vtY - 1, bMax.vtY);
+	  for(ln = k0.vtY; (errNum2 == WLZ_ERR_NONE) && (ln <= k1.vtY); ++ln)
+	  {
+	    (void )WlzEFFTiffToWlzRowData(buf + (rowSz * (ln - c.vtY)),
+	    				  rowBuf, len, photometric,
+					  samplesperpixel, bitspersample,
+					  newpixtype, red, green, blue,
+					  &errNum2);
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      unsigned char *src;
+
+	      src = rowBuf + ((k0.vtX - c.vtX) * wlzDepth);
+	      if(tileSz == 0)
+	      {
+	        memcpy(data + ((((WlzLong )(ln - bMin.vtY) * rowWidth) +
+				k0.vtX - bMin.vtX) * wlzDepth),
+		       src, (k1.vtX - k0.vtX + 1) * wlzDepth);
+	      }
+	      else
+	      {
+	        WlzGreyP gP;
+
+		gP.ubp = src;
+		WlzTiledValuesCopyLine(obj->values.t, gP, 0, ln - bMin.vtY,
+				       k0.vtX - bMin.vtX, k1.vtX - bMin.vtX);
+	      }
+	    }
+	  }
+	}
+      }
+#ifdef _OPENMP
+#pragma omp critical (WlzEffReadObjTiffTiles)
+#endif
+      {
+        if((errNum2 != WLZ_ERR_NONE) && (errNum == WLZ_ERR_NONE))
+	{
+	  errNum = errNum2;
+	}
+      }
+      AlcFree(buf);
+      AlcFree(rowBuf);
+      if(tTif)
+      {
+        TIFFClose(tTif);
+      }
+    }
+  }
+  if(tif)
+  {
+    TIFFClose(tif);
+  }
+  if((errNum != WLZ_ERR_NONE) && obj)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
 /*!
 * \return	Object read from file.
 * \ingroup	WlzExtFF
@@ -625,7 +994,7 @@ WlzObject	*WlzEffReadObjTiff(
      This could also of course be a patched object so maybe we should
      allow a compound object return option.
   */
-  numPlanes = TIFFNumberOfDirectories(tif);
+  numPlanes = (tif)? TIFFNumberOfDirectories(tif): 0;
   if( numPlanes > 1 ){
     if( split ){
       /* create a compound object here */
@@ -714,9 +1083,13 @@ WlzObject	*WlzEffReadObjTiff(
       /* should standardise here (if 3D) */
     }
   }
-  else {
+  else if( split ){
     obj = WlzExtFFReadTiffDirObj(tif, 0, split, &errNum);
   }
+  else if( tif ){
+    /* single image, decode the tiles or strips in parallel */
+    obj = WlzEffReadObjTiffTiles(tiffFileName, 0, NULL, 0, &errNum);
+  }
 
   if( tif ){
     TIFFClose( tif );
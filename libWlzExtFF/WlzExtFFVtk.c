@@ -176,6 +176,9 @@ WlzErrorNum	WlzEffWriteObjVtk(FILE *fP, WlzObject *obj)
       case WLZ_CMESH_3D:
         errNum = WlzEffWriteCMesh3DVtk(fP, obj->domain.cm3);
         break;
+      case WLZ_IDXMESH:
+        errNum = WlzEffWriteIdxMeshVtk(fP, obj->domain.idm);
+        break;
       case WLZ_POINTS:
         errNum = WlzEffWritePointsVtk(fP, obj, 0);
 	break;
@@ -1345,6 +1348,123 @@ static WlzErrorNum WlzEffWriteCMesh3DVtk(FILE *fP, WlzCMesh3D *mesh)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed mesh to the given stream using
+*		the Visualization Toolkit file format. Triangular meshes
+*		are written as polydata and tetrahedral meshes as an
+*		unstructured grid. This allows large meshes to be written
+*		without building a geometric model or constrained mesh.
+* \param	fP			Output file stream.
+* \param	mesh			Given indexed mesh.
+*/
+WlzErrorNum	WlzEffWriteIdxMeshVtk(FILE *fP, WlzIdxMesh *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((mesh->type != WLZ_IDXMESH_TRI3D) &&
+          (mesh->type != WLZ_IDXMESH_TET3D))
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the file header. */
+    if(fprintf(fP,
+	       "# vtk DataFile Version 1.0\n"
+	       "Written by WlzEffWriteIdxMeshVtk().\n"
+	       "ASCII\n"
+	       "DATASET %s\n"
+	       "POINTS %d float\n",
+	       (mesh->type == WLZ_IDXMESH_TRI3D)?
+	       "POLYDATA": "UNSTRUCTURED_GRID",
+	       mesh->nVtx) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idV;
+    double	*v;
+
+    /* Output the vertex positions. */
+    v = mesh->vtx;
+    for(idV = 0; idV < mesh->nVtx; ++idV)
+    {
+      if(fprintf(fP, "%g %g %g\n", v[0], v[1], v[2]) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      v += 3;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the element vertex indices. */
+    if(fprintf(fP, "%s %d %d\n",
+               (mesh->type == WLZ_IDXMESH_TRI3D)? "POLYGONS": "CELLS",
+	       mesh->nElm, (mesh->nElmVtx + 1) * mesh->nElm) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idE,
+    		ok;
+    int		*e;
+
+    e = mesh->elm;
+    for(idE = 0; idE < mesh->nElm; ++idE)
+    {
+      if(mesh->type == WLZ_IDXMESH_TRI3D)
+      {
+        ok = fprintf(fP, "3 %d %d %d\n", e[0], e[1], e[2]) > 0;
+      }
+      else
+      {
+	/* Same vertex ordering as for constrained meshes. */
+        ok = fprintf(fP, "4 %d %d %d %d\n", e[0], e[1], e[3], e[2]) > 0;
+      }
+      if(!ok)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      e += mesh->nElmVtx;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (mesh->type == WLZ_IDXMESH_TET3D))
+  {
+    int		idE;
+
+    /* Output the element cell types (all tetrahedra, type 10). */
+    if(fprintf(fP, "CELL_TYPES %d\n", mesh->nElm) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    for(idE = 0; (errNum == WLZ_ERR_NONE) && (idE < mesh->nElm); ++idE)
+    {
+      if(fprintf(fP, "10\n") <= 0)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF